@@ -97,10 +97,21 @@ phys_addr_t map_to_sysmem(const void *ptr)
 	return (u8 *)ptr - gd->arch.ram_buf;
 }
 
+unsigned long virt_to_phys(void *vaddr)
+{
+	unsigned long offset = (u8 *)vaddr - gd->arch.ram_buf;
+
+	return offset < gd->ram_size ? offset : -1UL;
+}
+
 void flush_dcache_range(unsigned long start, unsigned long stop)
 {
 }
 
+void invalidate_dcache_range(unsigned long start, unsigned long stop)
+{
+}
+
 int sandbox_read_fdt_from_file(void)
 {
 	struct sandbox_state *state = state_get_current();
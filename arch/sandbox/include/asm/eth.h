@@ -14,4 +14,28 @@ void sandbox_eth_disable_response(int index, bool disable);
 
 void sandbox_eth_skip_timeout(void);
 
+void sandbox_eth_tftp_setup(ulong size, ulong drop_block);
+
+void sandbox_eth_tftp_data(const void *data);
+
+ulong sandbox_eth_tftp_acks(void);
+
+void sandbox_eth_tftp_fill(void *buf, ulong offset, ulong len);
+
+void sandbox_eth_nfs_setup(ulong size, int vers, ulong drop_read);
+
+ulong sandbox_eth_nfs_reads(void);
+
+void sandbox_eth_http_setup(ulong size, bool wscale, ulong drop_segment);
+
+ulong sandbox_eth_http_acks(void);
+
+ulong sandbox_eth_http_retransmits(void);
+
+void sandbox_eth_rx_batch_setup(int max);
+
+ulong sandbox_eth_rx_frames(void);
+
+ulong sandbox_eth_rx_batches(void);
+
 #endif /* __ETH_H */
@@ -39,6 +39,13 @@ static inline void unmap_sysmem(const void *vaddr)
 /* Map from a pointer to our RAM buffer */
 phys_addr_t map_to_sysmem(const void *ptr);
 
+/*
+ * Get the bus address of a pointer, for use by emulated DMA devices. Only
+ * our RAM buffer is visible to devices, so any other pointer (e.g. to the
+ * stack) gives an address which no 32-bit device can reach.
+ */
+unsigned long virt_to_phys(void *vaddr);
+
 /* Define nops for sandbox I/O access */
 #define readb(addr) 0
 #define readw(addr) 0
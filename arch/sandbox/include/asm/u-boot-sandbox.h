@@ -83,4 +83,14 @@ void sandbox_set_enable_pci_map(int enable);
  */
 int sandbox_read_fdt_from_file(void);
 
+/**
+ * sandbox_sdhci_init() - Set up the emulated SDHCI controller
+ *
+ * This adds an MMC device for an SDHCI controller with a 4MiB SD card
+ * attached, whose contents are kept in memory.
+ *
+ * @return 0 if OK, -ve on error
+ */
+int sandbox_sdhci_init(void);
+
 #endif	/* _U_BOOT_SANDBOX_H_ */
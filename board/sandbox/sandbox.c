@@ -34,11 +34,22 @@ void sandbox_timer_add_offset(unsigned long offset)
 	sandbox_timer_offset += offset;
 }
 
-unsigned long timer_read_counter(void)
+unsigned long notrace timer_read_counter(void)
 {
 	return os_get_nsec() / 1000 + sandbox_timer_offset * 1000;
 }
 
+/* Use the microsecond timer for bootstage, instead of get_timer() */
+ulong timer_get_boot_us(void)
+{
+	static ulong base_time;
+
+	if (!base_time)
+		base_time = timer_get_us();
+
+	return timer_get_us() - base_time;
+}
+
 int dram_init(void)
 {
 	gd->ram_size = CONFIG_SYS_SDRAM_SIZE;
@@ -78,3 +89,10 @@ int board_late_init(void)
 	return 0;
 }
 #endif
+
+#ifdef CONFIG_SANDBOX_SDHCI
+int board_mmc_init(bd_t *bis)
+{
+	return sandbox_sdhci_init();
+}
+#endif
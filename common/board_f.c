@@ -654,6 +654,7 @@ static int setup_dram_config(void)
 
 static int reloc_fdt(void)
 {
+	fdtdec_index_invalidate();
 	if (gd->new_fdt) {
 		memcpy(gd->new_fdt, gd->fdt_blob, gd->fdt_size);
 		gd->fdt_blob = gd->new_fdt;
@@ -717,6 +718,8 @@ static int jump_to_copy(void)
 static int mark_bootstage(void)
 {
 	bootstage_mark_name(BOOTSTAGE_ID_START_UBOOT_F, "board_init_f");
+	/* The following initcalls nest inside this, until board_init_r() */
+	bootstage_span_start("board_init_f", 0, 0);
 
 	return 0;
 }
@@ -745,6 +748,22 @@ __weak int arch_cpu_init_dm(void)
 	return 0;
 }
 
+/* What the generic initcalls need and provide, see INITCALL_INFO() */
+#ifdef CONFIG_SYS_MALLOC_F_LEN
+INITCALL_INFO(initf_malloc, 0, INITCALL_MALLOC, 0);
+#endif
+#if defined(CONFIG_DM) && defined(CONFIG_SYS_MALLOC_F_LEN)
+INITCALL_INFO(initf_dm, INITCALL_MALLOC, INITCALL_DM, 0);
+#endif
+INITCALL_INFO(env_init, 0, INITCALL_ENV, 0);
+INITCALL_INFO(init_baud_rate, INITCALL_ENV, 0, 0);
+INITCALL_INFO(serial_init, 0, INITCALL_SERIAL, 0);
+INITCALL_INFO(console_init_f, INITCALL_SERIAL, INITCALL_CONSOLE, 0);
+INITCALL_INFO(display_options, INITCALL_CONSOLE, 0, 0);
+#if !defined(CONFIG_ARM) && !defined(CONFIG_SANDBOX)
+INITCALL_INFO(jump_to_copy, 0, 0, INITCALLF_SYNC);
+#endif
+
 static init_fnc_t init_sequence_f[] = {
 #ifdef CONFIG_SANDBOX
 	setup_ram_buf,
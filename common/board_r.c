@@ -264,8 +264,9 @@ static int initr_malloc(void)
 	ulong malloc_start;
 
 #ifdef CONFIG_SYS_MALLOC_F_LEN
-	debug("Pre-reloc malloc() used %#lx bytes (%ld KB)\n", gd->malloc_ptr,
-	      gd->malloc_ptr / 1024);
+	debug("Pre-reloc malloc() used %#lx bytes (%ld KB), peak %#lx of %#x\n",
+	      gd->malloc_ptr, gd->malloc_ptr / 1024, gd->malloc_peak,
+	      CONFIG_SYS_MALLOC_F_LEN);
 #endif
 	/* The malloc area is immediately below the monitor copy in DRAM */
 	malloc_start = gd->relocaddr - TOTAL_MALLOC_LEN;
@@ -676,6 +677,59 @@ static int run_main_loop(void)
 	return 0;
 }
 
+#if defined(CONFIG_ENV_IS_IN_MMC) || defined(CONFIG_ENV_IS_IN_FAT)
+#define INITCALL_ENV_DEV	INITCALL_MMC
+#elif defined(CONFIG_ENV_IS_IN_NAND)
+#define INITCALL_ENV_DEV	INITCALL_NAND
+#elif defined(CONFIG_ENV_IS_IN_FLASH)
+#define INITCALL_ENV_DEV	INITCALL_FLASH
+#else
+#define INITCALL_ENV_DEV	0
+#endif
+
+/*
+ * What the generic initcalls need and provide, see INITCALL_INFO(). Storage
+ * and network set-up can be deferred with CONFIG_INITCALL_DEFER.
+ */
+INITCALL_INFO(initr_reloc, 0, INITCALL_RELOC, 0);
+INITCALL_INFO(initr_malloc, INITCALL_RELOC, INITCALL_MALLOC, 0);
+#ifdef CONFIG_DM
+INITCALL_INFO(initr_dm, INITCALL_MALLOC, INITCALL_DM, 0);
+#endif
+INITCALL_INFO(initr_serial, 0, INITCALL_SERIAL, 0);
+#ifdef CONFIG_PCI
+INITCALL_INFO(initr_pci, 0, INITCALL_PCI, 0);
+#endif
+#ifndef CONFIG_SYS_NO_FLASH
+INITCALL_INFO(initr_flash, 0, INITCALL_FLASH, 0);
+#endif
+#ifdef CONFIG_CMD_NAND
+INITCALL_INFO(initr_nand, INITCALL_MALLOC, INITCALL_NAND, INITCALLF_DEFER);
+#endif
+#ifdef CONFIG_GENERIC_MMC
+INITCALL_INFO(initr_mmc, INITCALL_MALLOC, INITCALL_MMC, INITCALLF_DEFER);
+#endif
+INITCALL_INFO(initr_env, INITCALL_MALLOC | INITCALL_ENV_DEV, INITCALL_ENV, 0);
+INITCALL_INFO(stdio_add_devices, INITCALL_MALLOC, INITCALL_STDIO, 0);
+INITCALL_INFO(console_init_r, INITCALL_ENV | INITCALL_STDIO,
+	      INITCALL_CONSOLE, 0);
+INITCALL_INFO(interrupt_init, 0, INITCALL_IRQ, 0);
+#ifdef CONFIG_CMD_NET
+INITCALL_INFO(initr_ethaddr, INITCALL_ENV, 0, 0);
+INITCALL_INFO(initr_net, INITCALL_ENV, INITCALL_NET, INITCALLF_DEFER);
+#endif
+#ifdef CONFIG_CMD_SCSI
+INITCALL_INFO(initr_scsi, INITCALL_MALLOC, 0, INITCALLF_DEFER);
+#endif
+#if defined(CONFIG_CMD_PCMCIA) && !defined(CONFIG_CMD_IDE)
+INITCALL_INFO(initr_pcmcia, 0, 0, INITCALLF_DEFER);
+#endif
+#ifdef CONFIG_CMD_IDE
+INITCALL_INFO(initr_ide, 0, 0, INITCALLF_DEFER);
+#endif
+INITCALL_INFO(run_main_loop, INITCALL_ENV | INITCALL_CONSOLE, 0,
+	      INITCALLF_SYNC);
+
 /*
  * Over time we hope to remove these functions with code fragments and
  * stub funtcions, and instead call the relevant function directly.
@@ -905,6 +959,9 @@ void board_init_r(gd_t *new_gd, ulong dest_addr)
 		init_sequence_r[i] += gd->reloc_off;
 #endif
 
+	/* board_init_f() may have jumped here without returning */
+	bootstage_span_close();
+	bootstage_span_start("board_init_r", 0, 0);
 	if (initcall_run_list(init_sequence_r))
 		hang();
 
@@ -13,6 +13,7 @@
  */
 
 #include <common.h>
+#include <errno.h>
 #include <libfdt.h>
 #include <malloc.h>
 #include <linux/compiler.h>
@@ -30,6 +31,32 @@ struct bootstage_record {
 static struct bootstage_record record[BOOTSTAGE_ID_COUNT] = { {1} };
 static int next_id = BOOTSTAGE_ID_USER;
 
+struct bootstage_span {
+	const char *name;	/* Name, or NULL to use func */
+	ulong func;		/* Function address, before relocation */
+	uint32_t start_us;	/* Start time of the current run */
+	uint32_t time_us;	/* Total time, including child spans */
+	uint32_t child_us;	/* Time spent in child spans */
+	uint16_t count;		/* Number of times the span was run */
+	int16_t parent;		/* Parent span, or -1 if none */
+	int flags;		/* see enum bootstage_span_flags */
+};
+
+/* This is in the data section, since it is used before relocation */
+static struct {
+	int count;		/* Number of spans in span[] */
+	int cur;		/* Innermost open span, or -1 if none */
+	int lost;		/* Number of spans not recorded */
+	bool ready;		/* Timer is usable, so record spans */
+	bool test;		/* Spans are from a test, not from boot */
+	struct bootstage_span span[CONFIG_BOOTSTAGE_SPAN_COUNT];
+} spans = { .cur = -1 };
+
+#ifdef CONFIG_UT_BOOTSTAGE
+/* The spans recorded during boot, while a test has its own */
+static typeof(spans) boot_spans;
+#endif
+
 enum {
 	BOOTSTAGE_VERSION	= 0,
 	BOOTSTAGE_MAGIC		= 0xb00757a3,
@@ -54,6 +81,9 @@ int bootstage_relocate(void)
 	for (i = 0; i < BOOTSTAGE_ID_COUNT; i++)
 		if (record[i].name)
 			record[i].name = strdup(record[i].name);
+	for (i = 0; i < spans.count; i++)
+		if (spans.span[i].name)
+			spans.span[i].name = strdup(spans.span[i].name);
 
 	return 0;
 }
@@ -78,6 +108,9 @@ ulong bootstage_add_record(enum bootstage_id id, const char *name,
 		}
 	}
 
+	/* Marks are only made once the timer works, so spans can start now */
+	spans.ready = true;
+
 	/* Tell the board about this progress */
 	show_boot_progress(flags & BOOTSTAGEF_ERROR ? -id : id);
 	return mark;
@@ -150,6 +183,230 @@ uint32_t bootstage_accum(enum bootstage_id id)
 	return duration;
 }
 
+static bool span_matches(struct bootstage_span *span, const char *name,
+			 ulong func, int flags)
+{
+	if (span->parent != spans.cur || span->func != func ||
+	    span->flags != flags)
+		return false;
+	if (!span->name || !name)
+		return span->name == name;
+
+	return !strcmp(span->name, name);
+}
+
+int bootstage_span_start(const char *name, ulong func, int flags)
+{
+	struct bootstage_span *span;
+	int i;
+
+	if (!spans.ready)
+		return -1;
+
+	/* Accumulate repeated runs of a span in the same place */
+	for (i = spans.count - 1; i >= 0; i--) {
+		if (span_matches(&spans.span[i], name, func, flags))
+			break;
+	}
+	if (i < 0) {
+		if (spans.count == CONFIG_BOOTSTAGE_SPAN_COUNT) {
+			spans.lost++;
+			return -1;
+		}
+		i = spans.count++;
+		span = &spans.span[i];
+		span->name = name;
+		span->func = func;
+		span->flags = flags;
+		span->parent = spans.cur;
+	}
+	span = &spans.span[i];
+	span->count++;
+	spans.cur = i;
+	span->start_us = timer_get_boot_us();
+
+	return i;
+}
+
+static bool span_is_open(int i)
+{
+	int open;
+
+	for (open = spans.cur; open >= 0; open = spans.span[open].parent) {
+		if (open == i)
+			return true;
+	}
+
+	return false;
+}
+
+uint32_t bootstage_span_end(int i)
+{
+	struct bootstage_span *span;
+	uint32_t duration;
+
+	/* The span may have been closed already by bootstage_span_close() */
+	if (i < 0 || !span_is_open(i))
+		return 0;
+	span = &spans.span[i];
+	duration = (uint32_t)timer_get_boot_us() - span->start_us;
+	span->time_us += duration;
+	if (span->parent >= 0)
+		spans.span[span->parent].child_us += duration;
+	spans.cur = span->parent;
+
+	return duration;
+}
+
+void bootstage_span_close(void)
+{
+	while (spans.cur >= 0)
+		bootstage_span_end(spans.cur);
+}
+
+int bootstage_span_info(int i, int *parentp)
+{
+	if (i < 0 || i >= spans.count)
+		return -1;
+	*parentp = spans.span[i].parent;
+
+	return spans.span[i].count;
+}
+
+#ifdef CONFIG_UT_BOOTSTAGE
+void bootstage_span_test_state(bool test)
+{
+	if (test == spans.test)
+		return;
+	if (test) {
+		boot_spans = spans;
+		memset(&spans, '\0', sizeof(spans));
+		spans.cur = -1;
+		spans.ready = true;
+		spans.test = true;
+	} else {
+		spans = boot_spans;
+	}
+}
+#endif
+
+/**
+ * Get the time spent in a span, including any run still in progress
+ *
+ * @param i		Span number
+ * @param self_usp	Returns the time spent in the span but not in its
+ *			children
+ * @return total time spent in the span
+ */
+static uint32_t get_span_time(int i, uint32_t *self_usp)
+{
+	struct bootstage_span *span = &spans.span[i];
+	uint32_t now = timer_get_boot_us();
+	uint32_t time_us = span->time_us;
+	uint32_t child_us = span->child_us;
+	int open, child = -1;
+
+	for (open = spans.cur; open >= 0; open = spans.span[open].parent) {
+		if (open == i) {
+			time_us += now - span->start_us;
+			if (child >= 0)
+				child_us += now - spans.span[child].start_us;
+			break;
+		}
+		child = open;
+	}
+	*self_usp = time_us - child_us;
+
+	return time_us;
+}
+
+/**
+ * Get a span name as a printable string
+ *
+ * @param buf	Buffer to put name if needed
+ * @param len	Length of buffer
+ * @param span	Span to get the name from
+ * @return pointer to name, either from the span or pointing to buf.
+ */
+static const char *get_span_name(char *buf, int len,
+				 struct bootstage_span *span)
+{
+	if (span->flags & BOOTSTAGE_SPANF_PROBE)
+		snprintf(buf, len, "probe %s", span->name);
+	else if (span->name)
+		return span->name;
+	else
+		snprintf(buf, len, "%#lx", span->func);
+
+	return buf;
+}
+
+/**
+ * Get the path to a span, with the span names separated by ';'
+ *
+ * @param buf	Buffer to put the path in
+ * @param len	Length of buffer
+ * @param i	Span number
+ * @return length of path, truncated to fit in the buffer
+ */
+static int get_span_path(char *buf, int len, int i)
+{
+	struct bootstage_span *span = &spans.span[i];
+	char name[40];
+	int pos = 0;
+
+	if (span->parent >= 0) {
+		pos = get_span_path(buf, len, span->parent);
+		if (pos < len - 1)
+			buf[pos++] = ';';
+	}
+	pos += snprintf(buf + pos, len - pos, "%s",
+			get_span_name(name, sizeof(name), span));
+
+	return min(pos, len - 1);
+}
+
+static int get_span_depth(int i)
+{
+	int depth;
+
+	for (depth = 0; spans.span[i].parent >= 0; depth++)
+		i = spans.span[i].parent;
+
+	return depth;
+}
+
+int bootstage_folded(char *buf, int size)
+{
+	char line[256], time[16];
+	int pos = 0;
+	int i, len, time_len;
+
+	for (i = 0; i < spans.count; i++) {
+		uint32_t self_us;
+
+		get_span_time(i, &self_us);
+		if (!self_us)
+			continue;
+
+		/* A long path is truncated, but the time is always there */
+		time_len = snprintf(time, sizeof(time), " %u\n", self_us);
+		len = get_span_path(line, sizeof(line) - time_len, i);
+		strcpy(line + len, time);
+		len += time_len;
+		if (!buf) {
+			puts(line);
+			continue;
+		}
+		if (pos + len > size)
+			return -ENOSPC;
+		memcpy(buf + pos, line, len);
+		pos += len;
+	}
+
+	return pos;
+}
+
 /**
  * Get a record name as a printable string
  *
@@ -205,7 +462,7 @@ static int h_compare_record(const void *r1, const void *r2)
 static int add_bootstages_devicetree(struct fdt_header *blob)
 {
 	int bootstage;
-	char buf[20];
+	char buf[40];
 	int id;
 	int i;
 
@@ -220,6 +477,31 @@ static int add_bootstages_devicetree(struct fdt_header *blob)
 	if (bootstage < 0)
 		return -1;
 
+	/*
+	 * Spans follow the records, numbered from BOOTSTAGE_ID_COUNT, with
+	 * a 'parent' property holding the number of the parent span.
+	 */
+	for (i = spans.count - 1; i >= 0; i--) {
+		struct bootstage_span *span = &spans.span[i];
+		uint32_t self_us;
+		int node;
+
+		node = fdt_add_subnode(blob, bootstage,
+				       simple_itoa(BOOTSTAGE_ID_COUNT + i));
+		if (node < 0)
+			return -1;
+		if (fdt_setprop_string(blob, node, "name",
+				get_span_name(buf, sizeof(buf), span)) ||
+		    fdt_setprop_cell(blob, node, "accum",
+				     get_span_time(i, &self_us)) ||
+		    fdt_setprop_cell(blob, node, "count", span->count))
+			return -1;
+		if (span->parent >= 0 &&
+		    fdt_setprop_cell(blob, node, "parent",
+				     BOOTSTAGE_ID_COUNT + span->parent))
+			return -1;
+	}
+
 	/*
 	 * Insert the timings to the device tree in the reverse order so
 	 * that they can be printed in the Linux kernel in the right order.
@@ -290,6 +572,26 @@ void bootstage_report(void)
 		if (rec->start_us)
 			prev = print_time_record(id, rec, -1);
 	}
+
+	if (!spans.count)
+		return;
+	puts("\nSpans:\n");
+	printf("%11s%11s%7s  %s\n", "Time", "Self", "Count", "Stage");
+	for (id = 0; id < spans.count; id++) {
+		struct bootstage_span *span = &spans.span[id];
+		uint32_t self_us;
+		char buf[40];
+
+		print_grouped_ull(get_span_time(id, &self_us),
+				  BOOTSTAGE_DIGITS);
+		print_grouped_ull(self_us, BOOTSTAGE_DIGITS);
+		printf("%7u  %*s%s\n", span->count, get_span_depth(id) * 2, "",
+		       get_span_name(buf, sizeof(buf), span));
+	}
+	if (spans.lost)
+		printf("(Overflowed span table by %d entries\n"
+			"- please increase CONFIG_BOOTSTAGE_SPAN_COUNT\n",
+		       spans.lost);
 }
 
 ulong __timer_get_boot_us(void)
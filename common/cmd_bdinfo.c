@@ -69,6 +69,17 @@ static void print_mhz(const char *name, unsigned long hz)
 	printf("%-12s= %6s MHz\n", name, strmhz(buf, hz));
 }
 
+/* Show how much of the malloc() pool before relocation was used */
+__maybe_unused
+static void print_malloc_f(void)
+{
+#ifdef CONFIG_SYS_MALLOC_F_LEN
+	print_num("malloc_f", CONFIG_SYS_MALLOC_F_LEN);
+	print_num("-> used", gd->malloc_ptr);
+	print_num("-> peak", gd->malloc_peak);
+#endif
+}
+
 #if defined(CONFIG_PPC)
 void __weak board_detail(void)
 {
@@ -336,6 +347,7 @@ int do_bdinfo(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
 	print_eth(0);
 	printf("ip_addr     = %s\n", getenv("ipaddr"));
 	printf("baudrate    = %u bps\n", gd->baudrate);
+	print_malloc_f();
 
 	return 0;
 }
@@ -388,6 +400,7 @@ static int do_bdinfo(cmd_tbl_t *cmdtp, int flag, int argc,
 	print_num("reloc off", gd->reloc_off);
 	print_num("irq_sp", gd->irq_sp);	/* irq stack pointer */
 	print_num("sp start ", gd->start_addr_sp);
+	print_malloc_f();
 #if defined(CONFIG_LCD) || defined(CONFIG_VIDEO)
 	print_num("FB base  ", gd->fb_base);
 #endif
@@ -456,6 +469,7 @@ int do_bdinfo(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
 	print_mhz("ethspeed",	    bd->bi_ethspeed);
 #endif
 	printf("baudrate    = %u bps\n", gd->baudrate);
+	print_malloc_f();
 
 	return 0;
 }
@@ -482,6 +496,7 @@ int do_bdinfo(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
 #if defined(CONFIG_LCD) || defined(CONFIG_VIDEO)
 	print_num("FB base  ", gd->fb_base);
 #endif
+	print_malloc_f();
 	return 0;
 }
 
@@ -5,6 +5,7 @@
  */
 
 #include <common.h>
+#include <mapmem.h>
 
 static int do_bootstage_report(cmd_tbl_t *cmdtp, int flag, int argc,
 			       char * const argv[])
@@ -14,6 +15,29 @@ static int do_bootstage_report(cmd_tbl_t *cmdtp, int flag, int argc,
 	return 0;
 }
 
+static int do_bootstage_folded(cmd_tbl_t *cmdtp, int flag, int argc,
+			       char * const argv[])
+{
+	ulong base, size;
+	void *buf;
+	int len;
+
+	if (argc < 2)
+		return bootstage_folded(NULL, 0) < 0;
+	base = simple_strtoul(argv[1], NULL, 16);
+	size = argc > 2 ? simple_strtoul(argv[2], NULL, 16) : 0x10000;
+	buf = map_sysmem(base, size);
+	len = bootstage_folded(buf, size);
+	unmap_sysmem(buf);
+	if (len < 0) {
+		printf("Not enough space for bootstage spans\n");
+		return 1;
+	}
+	setenv_hex("filesize", len);
+
+	return 0;
+}
+
 static int get_base_size(int argc, char * const argv[], ulong *basep,
 			 ulong *sizep)
 {
@@ -60,6 +84,7 @@ static int do_bootstage_stash(cmd_tbl_t *cmdtp, int flag, int argc,
 
 static cmd_tbl_t cmd_bootstage_sub[] = {
 	U_BOOT_CMD_MKENT(report, 2, 1, do_bootstage_report, "", ""),
+	U_BOOT_CMD_MKENT(folded, 3, 1, do_bootstage_folded, "", ""),
 	U_BOOT_CMD_MKENT(stash, 4, 0, do_bootstage_stash, "", ""),
 	U_BOOT_CMD_MKENT(unstash, 4, 0, do_bootstage_stash, "", ""),
 };
@@ -90,6 +115,7 @@ U_BOOT_CMD(bootstage, 4, 1, do_boostage,
 	"Boot stage command",
 	" - check boot progress and timing\n"
 	"report                      - Print a report\n"
+	"folded [<start> [<size>]]   - Print or write spans for flamegraph.pl\n"
 	"stash [<start> [<size>]]    - Stash data into memory\n"
 	"unstash [<start> [<size>]]  - Unstash data from memory"
 );
@@ -15,6 +15,7 @@
 #include <asm/global_data.h>
 #include <libfdt.h>
 #include <fdt_support.h>
+#include <fdtdec.h>
 #include <mapmem.h>
 #include <asm/io.h>
 
@@ -126,6 +127,8 @@ static int do_fdt(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
 		else
 			set_working_fdt_addr(addr);
 
+		if (control)
+			fdtdec_index_invalidate();
 		if (argc >= 2) {
 			int  len;
 			int  err;
@@ -159,6 +162,9 @@ static int do_fdt(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
 			"Aborting!\n");
 		return CMD_RET_FAILURE;
 	}
+	/* The control FDT may be about to change */
+	if (working_fdt == gd->fdt_blob)
+		fdtdec_index_invalidate();
 
 	/*
 	 * Move the working_fdt
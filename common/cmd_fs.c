@@ -51,6 +51,46 @@ U_BOOT_CMD(
 	"      If 'pos' is 0 or omitted, the file is read from the start."
 )
 
+#ifdef CONFIG_FS_READ_HASH
+static int do_load_hash_wrapper(cmd_tbl_t *cmdtp, int flag, int argc,
+				char * const argv[])
+{
+	return do_load_hash(cmdtp, flag, argc, argv, FS_TYPE_ANY);
+}
+
+U_BOOT_CMD(
+	loadhash,	7,	0,	do_load_hash_wrapper,
+	"load binary file from a filesystem and hash it in one pass",
+	"<algo> <interface> <dev[:part]> <addr> <filename> [[*]digest]\n"
+	"    - Load binary file 'filename' from partition 'part' on device\n"
+	"       type 'interface' instance 'dev' to address 'addr' in memory,\n"
+	"       computing its 'algo' hash (e.g. sha256) as the data is read.\n"
+	"      If 'digest' is given, check the hash against it: either a hex\n"
+	"       string, an environment variable, or *addr for a digest in\n"
+	"       memory. Otherwise print the hash."
+);
+#endif
+
+#ifdef CONFIG_FS_READ_DECOMP
+static int do_load_decomp_wrapper(cmd_tbl_t *cmdtp, int flag, int argc,
+				  char * const argv[])
+{
+	return do_load_decomp(cmdtp, flag, argc, argv, FS_TYPE_ANY);
+}
+
+U_BOOT_CMD(
+	loadz,	7,	0,	do_load_decomp_wrapper,
+	"load compressed file from a filesystem, decompressing as it is read",
+	"<comp> <interface> <dev[:part]> <addr> <filename> [max_size]\n"
+	"    - Load 'comp' (gzip, lzma, lzo or none) compressed file\n"
+	"       'filename' from partition 'part' on device type 'interface'\n"
+	"       instance 'dev', decompressing it to address 'addr' as it is\n"
+	"       read. 'filesize' is set to the decompressed size.\n"
+	"      'max_size' limits the decompressed size, by default to\n"
+	"       CONFIG_SYS_BOOTM_LEN."
+);
+#endif
+
 static int do_save_wrapper(cmd_tbl_t *cmdtp, int flag, int argc,
 				char * const argv[])
 {
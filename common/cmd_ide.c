@@ -849,6 +849,7 @@ ulong ide_write(int device, lbaint_t blknr, lbaint_t blkcnt, const void *buffer)
 	}
 #endif
 
+	part_dev_changed(&ide_dev_desc[device]);
 	ide_led(DEVICE_LED(device), 1);	/* LED on       */
 
 	/* Select device
@@ -0,0 +1,52 @@
+/*
+ * Show the time taken by initcalls and what they depend on
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <command.h>
+#include <initcall.h>
+
+static int do_initcall_times(cmd_tbl_t *cmdtp, int flag, int argc,
+			     char * const argv[])
+{
+	initcall_show_times();
+
+	return 0;
+}
+
+static int do_initcall_info(cmd_tbl_t *cmdtp, int flag, int argc,
+			    char * const argv[])
+{
+	initcall_show_info();
+
+	return 0;
+}
+
+static cmd_tbl_t cmd_initcall_sub[] = {
+	U_BOOT_CMD_MKENT(times, 1, 1, do_initcall_times, "", ""),
+	U_BOOT_CMD_MKENT(info, 1, 1, do_initcall_info, "", ""),
+};
+
+static int do_initcall(cmd_tbl_t *cmdtp, int flag, int argc,
+		       char * const argv[])
+{
+	cmd_tbl_t *c;
+
+	if (argc < 2)
+		return CMD_RET_USAGE;
+
+	c = find_cmd_tbl(argv[1], cmd_initcall_sub,
+			 ARRAY_SIZE(cmd_initcall_sub));
+	if (!c)
+		return CMD_RET_USAGE;
+
+	return c->cmd(cmdtp, flag, argc - 1, argv + 1);
+}
+
+U_BOOT_CMD(initcall, 2, 1, do_initcall,
+	"Show initcall timing and dependencies",
+	"times - Show the time taken by each initcall\n"
+	"initcall info  - Show what each annotated initcall needs and provides"
+);
@@ -0,0 +1,58 @@
+/*
+ * Show how the malloc() area is used
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <command.h>
+#include <malloc.h>
+#include <slab.h>
+
+static int do_malloc_info(cmd_tbl_t *cmdtp, int flag, int argc,
+			  char * const argv[])
+{
+	struct mallinfo info = mallinfo();
+
+	printf("Malloc area: %08lx-%08lx, %lu bytes\n", mem_malloc_start,
+	       mem_malloc_end, mem_malloc_end - mem_malloc_start);
+	printf("Heap size:   %u bytes, %lu never used\n", info.arena,
+	       mem_malloc_end - mem_malloc_brk);
+	printf("In use:      %u bytes\n", info.uordblks);
+	printf("Free:        %u bytes in %u chunks, %u at the top\n",
+	       info.fordblks, info.ordblks, info.keepcost);
+#if defined(CONFIG_SYS_MALLOC_SLAB)
+	putc('\n');
+	slab_print_stats();
+#endif
+
+	return 0;
+}
+
+static cmd_tbl_t cmd_malloc_sub[] = {
+	U_BOOT_CMD_MKENT(info, 1, 1, do_malloc_info, "", ""),
+};
+
+static int do_malloc(cmd_tbl_t *cmdtp, int flag, int argc,
+		     char * const argv[])
+{
+	cmd_tbl_t *c;
+
+	if (argc < 2)
+		return CMD_RET_USAGE;
+
+	/* Strip off leading 'malloc' command argument */
+	argc--;
+	argv++;
+
+	c = find_cmd_tbl(argv[0], cmd_malloc_sub, ARRAY_SIZE(cmd_malloc_sub));
+	if (c)
+		return c->cmd(cmdtp, flag, argc, argv);
+	else
+		return CMD_RET_USAGE;
+}
+
+U_BOOT_CMD(malloc, 2, 1, do_malloc,
+	"malloc() statistics",
+	"info - show how the malloc() area and slabs are used"
+);
@@ -7,6 +7,7 @@
 
 #include <common.h>
 #include <command.h>
+#include <mapmem.h>
 #include <mmc.h>
 
 static int curr_device = -1;
@@ -339,9 +340,9 @@ static int do_mmc_read(cmd_tbl_t *cmdtp, int flag,
 	if (argc != 4)
 		return CMD_RET_USAGE;
 
-	addr = (void *)simple_strtoul(argv[1], NULL, 16);
 	blk = simple_strtoul(argv[2], NULL, 16);
 	cnt = simple_strtoul(argv[3], NULL, 16);
+	addr = map_sysmem(simple_strtoul(argv[1], NULL, 16), cnt * 512);
 
 	mmc = init_mmc_device(curr_device, false);
 	if (!mmc)
@@ -353,6 +354,7 @@ static int do_mmc_read(cmd_tbl_t *cmdtp, int flag,
 	n = mmc->block_dev.block_read(curr_device, blk, cnt, addr);
 	/* flush cache after read */
 	flush_cache((ulong)addr, cnt * 512); /* FIXME */
+	unmap_sysmem(addr);
 	printf("%d blocks read: %s\n", n, (n == cnt) ? "OK" : "ERROR");
 
 	return (n == cnt) ? CMD_RET_SUCCESS : CMD_RET_FAILURE;
@@ -367,9 +369,9 @@ static int do_mmc_write(cmd_tbl_t *cmdtp, int flag,
 	if (argc != 4)
 		return CMD_RET_USAGE;
 
-	addr = (void *)simple_strtoul(argv[1], NULL, 16);
 	blk = simple_strtoul(argv[2], NULL, 16);
 	cnt = simple_strtoul(argv[3], NULL, 16);
+	addr = map_sysmem(simple_strtoul(argv[1], NULL, 16), cnt * 512);
 
 	mmc = init_mmc_device(curr_device, false);
 	if (!mmc)
@@ -383,6 +385,7 @@ static int do_mmc_write(cmd_tbl_t *cmdtp, int flag,
 		return CMD_RET_FAILURE;
 	}
 	n = mmc->block_dev.block_write(curr_device, blk, cnt, addr);
+	unmap_sysmem(addr);
 	printf("%d blocks written: %s\n", n, (n == cnt) ? "OK" : "ERROR");
 
 	return (n == cnt) ? CMD_RET_SUCCESS : CMD_RET_FAILURE;
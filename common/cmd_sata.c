@@ -18,6 +18,15 @@
 static int sata_curr_device = -1;
 block_dev_desc_t sata_dev_desc[CONFIG_SYS_SATA_MAX_DEVICE];
 
+/* Writes go through here so that anything cached about the disk is dropped */
+static ulong sata_bwrite(int dev, lbaint_t start, lbaint_t blkcnt,
+			 const void *buffer)
+{
+	part_dev_changed(&sata_dev_desc[dev]);
+
+	return sata_write(dev, start, blkcnt, buffer);
+}
+
 int __sata_initialize(void)
 {
 	int rc;
@@ -33,7 +42,7 @@ int __sata_initialize(void)
 		sata_dev_desc[i].blksz = 512;
 		sata_dev_desc[i].log2blksz = LOG2(sata_dev_desc[i].blksz);
 		sata_dev_desc[i].block_read = sata_read;
-		sata_dev_desc[i].block_write = sata_write;
+		sata_dev_desc[i].block_write = sata_bwrite;
 
 		rc = init_sata(i);
 		if (!rc) {
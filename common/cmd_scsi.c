@@ -437,6 +437,7 @@ static ulong scsi_write(int device, lbaint_t blknr,
 	unsigned short smallblks;
 	ccb* pccb = (ccb *)&tempccb;
 	device &= 0xff;
+	part_dev_changed(&scsi_dev_desc[device]);
 	/* Setup  device
 	 */
 	pccb->target = scsi_dev_desc[device].target;
@@ -152,29 +152,75 @@ static int do_spi_flash_probe(int argc, char * const argv[])
 	return 0;
 }
 
+/* Check whether @len bytes at @buf read as erased flash does */
+static bool spi_flash_is_erased(const char *buf, size_t len)
+{
+	while (len--) {
+		if (*buf++ != (char)0xff)
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ * Program an erased area of SPI flash, leaving out the pages which are to
+ * stay erased
+ */
+static int spi_flash_program(struct spi_flash *flash, u32 offset,
+			     size_t len, const char *buf)
+{
+	size_t page = flash->page_size;
+	size_t pos, start;
+
+	for (pos = 0; pos < len; ) {
+		while (pos < len &&
+		       spi_flash_is_erased(buf + pos, min(page, len - pos)))
+			pos += page;
+		for (start = pos; pos < len &&
+		     !spi_flash_is_erased(buf + pos, min(page, len - pos)); )
+			pos += page;
+		if (pos > start && spi_flash_write(flash, offset + start,
+						   min(pos, len) - start,
+						   buf + start))
+			return -EIO;
+	}
+
+	return 0;
+}
+
 /**
  * Write a block of data to SPI flash, first checking if it is different from
  * what is already there.
  *
- * If the data being written is the same, then *skipped is incremented by len.
+ * Only the sectors which change are written. Those which are erased already
+ * are just programmed, the rest are erased first, next to each other where
+ * possible so that a whole block can go in one erase command. Pages which
+ * are to be left erased are not programmed.
+ *
+ * For each sector which is the same, *skipped is incremented by its length.
  *
  * @param flash		flash context pointer
  * @param offset	flash offset to write
- * @param len		number of bytes to write
+ * @param len		number of bytes to write, within one erase block
  * @param buf		buffer to write from
- * @param cmp_buf	read buffer to use to compare data
+ * @param cmp_buf	read buffer to use to compare data, twice the size of
+ *			an erase block
  * @param skipped	Count of skipped data (incremented by this function)
  * @return NULL if OK, else a string containing the stage which failed
  */
 static const char *spi_flash_update_block(struct spi_flash *flash, u32 offset,
 		size_t len, const char *buf, char *cmp_buf, size_t *skipped)
 {
-	char *ptr = (char *)buf;
+	size_t sector = flash->sector_size;
+	size_t size = roundup(len, sector);
+	const char *ptr = buf;
+	size_t pos, start;
 
 	debug("offset=%#x, sector_size=%#x, len=%#zx\n",
 	      offset, flash->sector_size, len);
-	/* Read the entire sector so to allow for rewriting */
-	if (spi_flash_read(flash, offset, flash->sector_size, cmp_buf))
+	/* Read the entire sectors so to allow for rewriting */
+	if (spi_flash_read(flash, offset, size, cmp_buf))
 		return "read";
 	/* Compare only what is meaningful (len) */
 	if (memcmp(cmp_buf, buf, len) == 0) {
@@ -183,17 +229,36 @@ static const char *spi_flash_update_block(struct spi_flash *flash, u32 offset,
 		*skipped += len;
 		return NULL;
 	}
-	/* Erase the entire sector */
-	if (spi_flash_erase(flash, offset, flash->sector_size))
+	/* If it ends in a partial sector, merge the data into a temp-buffer */
+	if (len != size) {
+		memcpy(cmp_buf + size, cmp_buf, size);
+		memcpy(cmp_buf + size, buf, len);
+		ptr = cmp_buf + size;
+	}
+
+	/* Erase each run of sectors which change and are not erased yet */
+	for (pos = 0, start = 0; pos < size; pos += sector) {
+		if (memcmp(cmp_buf + pos, ptr + pos, sector) &&
+		    !spi_flash_is_erased(cmp_buf + pos, sector))
+			continue;
+		if (pos > start &&
+		    spi_flash_erase(flash, offset + start, pos - start))
+			return "erase";
+		start = pos + sector;
+	}
+	if (size > start &&
+	    spi_flash_erase(flash, offset + start, size - start))
 		return "erase";
-	/* If it's a partial sector, copy the data into the temp-buffer */
-	if (len != flash->sector_size) {
-		memcpy(cmp_buf, buf, len);
-		ptr = cmp_buf;
+
+	/* Then program the sectors which change */
+	for (pos = 0; pos < size; pos += sector) {
+		if (!memcmp(cmp_buf + pos, ptr + pos, sector)) {
+			*skipped += min(sector, len - pos);
+			continue;
+		}
+		if (spi_flash_program(flash, offset + pos, sector, ptr + pos))
+			return "write";
 	}
-	/* Write one complete sector */
-	if (spi_flash_write(flash, offset, flash->sector_size, ptr))
-		return "write";
 
 	return NULL;
 }
@@ -219,16 +284,18 @@ static int spi_flash_update(struct spi_flash *flash, u32 offset,
 	const ulong start_time = get_timer(0);
 	size_t scale = 1;
 	const char *start_buf = buf;
+	size_t block = max(flash->block_size, flash->sector_size);
 	ulong delta;
 
 	if (end - buf >= 200)
 		scale = (end - buf) / 100;
-	cmp_buf = malloc(flash->sector_size);
+	cmp_buf = malloc(block * 2);
 	if (cmp_buf) {
 		ulong last_update = get_timer(0);
 
 		for (; buf < end && !err_oper; buf += todo, offset += todo) {
-			todo = min_t(size_t, end - buf, flash->sector_size);
+			todo = min_t(size_t, end - buf,
+				     block - offset % block);
 			if (get_timer(last_update) > 100) {
 				printf("   \rUpdating, %zu%% %lu B/s",
 				       100 - (end - buf) / scale,
@@ -29,7 +29,9 @@ static int get_args(int argc, char * const argv[], char **buff,
 	return 0;
 }
 
-static int create_func_list(int argc, char * const argv[])
+static int create_list(int argc, char * const argv[], const char *what,
+		       int (*list)(void *buff, int buff_size,
+				   unsigned int *needed))
 {
 	size_t buff_size, avail, buff_ptr, used;
 	unsigned int needed;
@@ -40,12 +42,13 @@ static int create_func_list(int argc, char * const argv[])
 		return -1;
 
 	avail = buff_size - buff_ptr;
-	err = trace_list_functions(buff + buff_ptr, avail, &needed);
+	err = list(buff + buff_ptr, avail, &needed);
 	if (err)
 		printf("Error: truncated (%#x bytes needed)\n", needed);
-	used = min(avail, needed);
-	printf("Function trace dumped to %08lx, size %#zx\n",
+	used = min(avail, (size_t)needed);
+	printf("%s dumped to %08lx, size %#zx\n", what,
 	       (ulong)map_to_sysmem(buff + buff_ptr), used);
+
 	setenv_hex("profbase", map_to_sysmem(buff));
 	setenv_hex("profsize", buff_size);
 	setenv_hex("profoffset", buff_ptr + used);
@@ -53,27 +56,25 @@ static int create_func_list(int argc, char * const argv[])
 	return 0;
 }
 
-static int create_call_list(int argc, char * const argv[])
+static int set_mode(int argc, char * const argv[])
 {
-	size_t buff_size, avail, buff_ptr, used;
-	unsigned int needed;
-	char *buff;
-	int err;
-
-	if (get_args(argc, argv, &buff, &buff_ptr, &buff_size))
-		return -1;
-
-	avail = buff_size - buff_ptr;
-	err = trace_list_calls(buff + buff_ptr, avail, &needed);
-	if (err)
-		printf("Error: truncated (%#x bytes needed)\n", needed);
-	used = min(avail, needed);
-	printf("Call list dumped to %08lx, size %#zx\n",
-	       (ulong)map_to_sysmem(buff + buff_ptr), used);
+	uint sample = 1;
+	int ring;
 
-	setenv_hex("profbase", map_to_sysmem(buff));
-	setenv_hex("profsize", buff_size);
-	setenv_hex("profoffset", buff_ptr + used);
+	if (argc < 3)
+		return CMD_RET_USAGE;
+	if (!strcmp(argv[2], "ring"))
+		ring = 1;
+	else if (!strcmp(argv[2], "flat"))
+		ring = 0;
+	else
+		return CMD_RET_USAGE;
+	if (argc > 3)
+		sample = simple_strtoul(argv[3], NULL, 10);
+	if (trace_set_mode(ring, sample)) {
+		puts("Cannot set trace mode\n");
+		return CMD_RET_FAILURE;
+	}
 
 	return 0;
 }
@@ -89,16 +90,27 @@ int do_trace(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
 		trace_set_enabled(0);
 		break;
 	case 'c':
-		if (create_call_list(argc, argv))
+		if (create_list(argc, argv, "Call list", trace_list_calls))
 			return cmd_usage(cmdtp);
 		break;
 	case 'r':
 		trace_set_enabled(1);
 		break;
 	case 'f':
-		if (create_func_list(argc, argv))
+		if (create_list(argc, argv, "Function trace",
+				trace_list_functions))
 			return cmd_usage(cmdtp);
 		break;
+	case 't':
+		if (create_list(argc, argv, "Function times", trace_list_times))
+			return cmd_usage(cmdtp);
+		break;
+	case 'h':
+		trace_print_times(argc > 2 ?
+				  simple_strtoul(argv[2], NULL, 10) : 20);
+		break;
+	case 'm':
+		return set_mode(argc, argv);
 	case 's':
 		trace_print_stats();
 		break;
@@ -117,5 +129,11 @@ U_BOOT_CMD(
 	"trace resume                       - resume tracing\n"
 	"trace funclist [<addr> <size>]     - dump function list into buffer\n"
 	"trace calls  [<addr> <size>]       "
-		"- dump function call trace into buffer"
+		"- dump function call trace into buffer\n"
+	"trace times  [<addr> <size>]       "
+		"- dump time spent in each function into buffer\n"
+	"trace hist [<count>]               "
+		"- show functions taking the most time\n"
+	"trace mode flat|ring [<sample>]    "
+		"- keep first or last calls, recording 1 in <sample>"
 );
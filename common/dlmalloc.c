@@ -934,14 +934,25 @@ struct mallinfo mALLINFo();
 #endif	/* 0 */			/* Moved to malloc.h */
 
 #include <malloc.h>
+#include <slab.h>
 #include <asm/io.h>
 
-#ifdef DEBUG
+/* mallinfo() is needed for debugging and by the 'malloc' command */
+#if defined(DEBUG) || defined(CONFIG_CMD_MALLOC)
+#define MALLOC_INFO
+#endif
+
+#ifdef MALLOC_INFO
 #if __STD_C
 static void malloc_update_mallinfo (void);
-void malloc_stats (void);
 #else
 static void malloc_update_mallinfo ();
+#endif
+#endif	/* MALLOC_INFO */
+#ifdef DEBUG
+#if __STD_C
+void malloc_stats (void);
+#else
 void malloc_stats();
 #endif
 #endif	/* DEBUG */
@@ -1529,6 +1540,13 @@ void *sbrk(ptrdiff_t increment)
 
 void mem_malloc_init(ulong start, ulong size)
 {
+#if defined(CONFIG_SYS_MALLOC_SLAB) && !defined(CONFIG_SPL_BUILD)
+	/* Set aside the top of the area for slabs */
+	if (size > CONFIG_SYS_MALLOC_SLAB_LEN) {
+		size -= CONFIG_SYS_MALLOC_SLAB_LEN;
+		slab_init(start + size, CONFIG_SYS_MALLOC_SLAB_LEN);
+	}
+#endif
 	mem_malloc_start = start;
 	mem_malloc_end = start + size;
 	mem_malloc_brk = start;
@@ -1628,9 +1646,9 @@ static struct mallinfo current_mallinfo = {  0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
 
 /* Tracking mmaps */
 
-#ifdef DEBUG
+#ifdef MALLOC_INFO
 static unsigned int n_mmaps = 0;
-#endif	/* DEBUG */
+#endif	/* MALLOC_INFO */
 static unsigned long mmapped_mem = 0;
 #if HAVE_MMAP
 static unsigned int max_n_mmaps = 0;
@@ -2452,14 +2470,20 @@ void fREe(mem) Void_t* mem;
   int       islr;      /* track whether merging with last_remainder */
 
 #ifdef CONFIG_SYS_MALLOC_F_LEN
-	/* free() is a no-op - all the memory will be freed on relocation */
-	if (!(gd->flags & GD_FLG_FULL_MALLOC_INIT))
+	if (!(gd->flags & GD_FLG_FULL_MALLOC_INIT)) {
+		free_simple(mem);
 		return;
+	}
 #endif
 
   if (mem == NULL)                              /* free(0) has no effect */
     return;
 
+  if (slab_owns(mem)) {
+	slab_free(mem);
+	return;
+  }
+
   p = mem2chunk(mem);
   hd = p->size;
 
@@ -2610,11 +2634,19 @@ Void_t* rEALLOc(oldmem, bytes) Void_t* oldmem; size_t bytes;
 
 #ifdef CONFIG_SYS_MALLOC_F_LEN
 	if (!(gd->flags & GD_FLG_FULL_MALLOC_INIT)) {
-		/* This is harder to support and should not be needed */
-		panic("pre-reloc realloc() is not supported");
+		return realloc_simple(oldmem, bytes);
 	}
 #endif
 
+  if (slab_owns(oldmem)) {
+	newmem = mALLOc(bytes);
+	if (newmem) {
+		memcpy(newmem, oldmem, min(bytes, slab_size(oldmem)));
+		slab_free(oldmem);
+	}
+	return newmem;
+  }
+
   newp    = oldp    = mem2chunk(oldmem);
   newsize = oldsize = chunksize(oldp);
 
@@ -2816,6 +2848,11 @@ Void_t* mEMALIGn(alignment, bytes) size_t alignment; size_t bytes;
 
   if ((long)bytes < 0) return NULL;
 
+#ifdef CONFIG_SYS_MALLOC_F_LEN
+	if (gd && !(gd->flags & GD_FLG_FULL_MALLOC_INIT))
+		return memalign_simple(alignment, bytes);
+#endif
+
   /* If need less alignment than we give anyway, just relay to malloc */
 
   if (alignment <= MALLOC_ALIGNMENT) return mALLOc(bytes);
@@ -3115,6 +3152,8 @@ size_t malloc_usable_size(mem) Void_t* mem;
   mchunkptr p;
   if (mem == NULL)
     return 0;
+  else if (slab_owns(mem))
+    return slab_size(mem);
   else
   {
     p = mem2chunk(mem);
@@ -3133,7 +3172,7 @@ size_t malloc_usable_size(mem) Void_t* mem;
 
 /* Utility to update current_mallinfo for malloc_stats and mallinfo() */
 
-#ifdef DEBUG
+#ifdef MALLOC_INFO
 static void malloc_update_mallinfo()
 {
   int i;
@@ -3169,9 +3208,13 @@ static void malloc_update_mallinfo()
   current_mallinfo.hblks = n_mmaps;
   current_mallinfo.hblkhd = mmapped_mem;
   current_mallinfo.keepcost = chunksize(top);
+#if defined(CONFIG_SYS_MALLOC_SLAB) && !defined(CONFIG_SPL_BUILD)
+  /* Count slab objects too, so that leaks of them show up */
+  current_mallinfo.uordblks += slab_used_bytes();
+#endif
 
 }
-#endif	/* DEBUG */
+#endif	/* MALLOC_INFO */
 
 
 
@@ -3211,13 +3254,13 @@ void malloc_stats()
   mallinfo returns a copy of updated current mallinfo.
 */
 
-#ifdef DEBUG
+#ifdef MALLOC_INFO
 struct mallinfo mALLINFo()
 {
   malloc_update_mallinfo();
   return current_mallinfo;
 }
-#endif	/* DEBUG */
+#endif	/* MALLOC_INFO */
 
 
 
@@ -3267,6 +3310,7 @@ int initf_malloc(void)
 	assert(gd->malloc_base);	/* Set up by crt0.S */
 	gd->malloc_limit = CONFIG_SYS_MALLOC_F_LEN;
 	gd->malloc_ptr = 0;
+	gd->malloc_peak = 0;
 #endif
 
 	return 0;
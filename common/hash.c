@@ -16,6 +16,7 @@
 #include <malloc.h>
 #include <mapmem.h>
 #include <hw_sha.h>
+#include <watchdog.h>
 #include <asm/io.h>
 #include <asm/errno.h>
 #else
@@ -107,15 +108,16 @@ static int hash_finish_crc32(struct hash_algo *algo, void *ctx, void *dest_buf,
 	if (size < algo->digest_size)
 		return -1;
 
-	*((uint32_t *)dest_buf) = *((uint32_t *)ctx);
+	/* Use the same byte order as crc32_wd_buf() */
+	*((uint32_t *)dest_buf) = cpu_to_be32(*((uint32_t *)ctx));
 	free(ctx);
 	return 0;
 }
 
 /*
  * These are the hash algorithms we support. Chips which support accelerated
- * crypto could perhaps add named version of these algorithms here. Note that
- * algorithm names must be in lower case.
+ * crypto can register their own versions with U_BOOT_HASH_ALGO(), which are
+ * found first. Note that algorithm names must be in lower case.
  */
 static struct hash_algo hash_algo[] = {
 	/*
@@ -193,10 +195,40 @@ static struct hash_algo hash_algo[] = {
 #define multi_hash()	0
 #endif
 
+/**
+ * hash_lookup_accel() - Find an accelerated version of an algorithm
+ *
+ * @algo_name:		Hash algorithm to look up
+ * @progressive:	non-zero if progressive hashing support is required
+ * @return entry registered with U_BOOT_HASH_ALGO(), or NULL if none
+ */
+static struct hash_algo *hash_lookup_accel(const char *algo_name,
+					   int progressive)
+{
+#ifndef USE_HOSTCC
+	struct hash_algo *start = ll_entry_start(struct hash_algo, hash_algo);
+	const int n_ents = ll_entry_count(struct hash_algo, hash_algo);
+	struct hash_algo *entry;
+
+	for (entry = start; entry != start + n_ents; entry++) {
+		if (strcmp(algo_name, entry->name))
+			continue;
+		if (!progressive || entry->hash_init)
+			return entry;
+	}
+#endif
+
+	return NULL;
+}
+
 int hash_lookup_algo(const char *algo_name, struct hash_algo **algop)
 {
 	int i;
 
+	*algop = hash_lookup_accel(algo_name, 0);
+	if (*algop)
+		return 0;
+
 	for (i = 0; i < ARRAY_SIZE(hash_algo); i++) {
 		if (!strcmp(algo_name, hash_algo[i].name)) {
 			*algop = &hash_algo[i];
@@ -213,6 +245,10 @@ int hash_progressive_lookup_algo(const char *algo_name,
 {
 	int i;
 
+	*algop = hash_lookup_accel(algo_name, 1);
+	if (*algop)
+		return 0;
+
 	for (i = 0; i < ARRAY_SIZE(hash_algo); i++) {
 		if (!strcmp(algo_name, hash_algo[i].name)) {
 			if (hash_algo[i].hash_init) {
@@ -368,6 +404,88 @@ void hash_show(struct hash_algo *algo, ulong addr, ulong len, uint8_t *output)
 		printf("%02x", output[i]);
 }
 
+int hash_verify(struct hash_algo *algo, ulong addr, ulong len,
+		const uint8_t *output, char *verify_str, int allow_env_vars)
+{
+	uint8_t vsum[HASH_MAX_DIGEST_SIZE];
+	int i;
+
+	if (parse_verify_sum(algo, verify_str, vsum, allow_env_vars)) {
+		printf("ERROR: %s does not contain a valid %s sum\n",
+		       verify_str, algo->name);
+		return -EINVAL;
+	}
+	if (memcmp(output, vsum, algo->digest_size) != 0) {
+		hash_show(algo, addr, len, (uint8_t *)output);
+		printf(" != ");
+		for (i = 0; i < algo->digest_size; i++)
+			printf("%02x", vsum[i]);
+		puts(" ** ERROR **\n");
+		return -EBADMSG;
+	}
+
+	return 0;
+}
+
+int hash_stream_start(struct hash_stream *hs, const char *algo_name)
+{
+	int ret;
+
+	ret = hash_progressive_lookup_algo(algo_name, &hs->algo);
+	if (ret)
+		return ret;
+	if (hs->algo->digest_size > HASH_MAX_DIGEST_SIZE)
+		return -EPROTONOSUPPORT;
+	if (hs->algo->hash_init(hs->algo, &hs->ctx) || !hs->ctx)
+		return -ENOMEM;
+	hs->len = 0;
+
+	return 0;
+}
+
+int hash_stream_update(struct hash_stream *hs, const void *buf, ulong size)
+{
+	struct hash_algo *algo = hs->algo;
+	const uint8_t *curr = buf;
+	ulong chunk;
+
+	while (size) {
+		chunk = min_t(ulong, size, algo->chunk_size);
+		if (algo->hash_update(algo, hs->ctx, curr, chunk, 0)) {
+			/* hash_update() has freed the context */
+			hs->ctx = NULL;
+			return -EIO;
+		}
+		curr += chunk;
+		size -= chunk;
+		hs->len += chunk;
+		WATCHDOG_RESET();
+	}
+
+	return 0;
+}
+
+int hash_stream_finish(struct hash_stream *hs, uint8_t *output, int size)
+{
+	struct hash_algo *algo = hs->algo;
+	int ret;
+
+	if (!hs->ctx)
+		return -EIO;
+	if (size < algo->digest_size) {
+		uint8_t scratch[HASH_MAX_DIGEST_SIZE];
+
+		/* Release the context anyway */
+		algo->hash_finish(algo, hs->ctx, scratch, sizeof(scratch));
+		hs->ctx = NULL;
+		return -ENOSPC;
+	}
+	ret = algo->hash_finish(algo, hs->ctx, output, size);
+	hs->ctx = NULL;
+
+	return ret ? -EIO : 0;
+}
+
 int hash_block(const char *algo_name, const void *data, unsigned int len,
 	       uint8_t *output, int *output_size)
 {
@@ -404,7 +522,6 @@ int hash_command(const char *algo_name, int flags, cmd_tbl_t *cmdtp, int flag,
 	if (multi_hash()) {
 		struct hash_algo *algo;
 		uint8_t output[HASH_MAX_DIGEST_SIZE];
-		uint8_t vsum[HASH_MAX_DIGEST_SIZE];
 		void *buf;
 
 		if (hash_lookup_algo(algo_name, &algo)) {
@@ -428,22 +545,9 @@ int hash_command(const char *algo_name, int flags, cmd_tbl_t *cmdtp, int flag,
 #else
 		if (0) {
 #endif
-			if (parse_verify_sum(algo, *argv, vsum,
-					flags & HASH_FLAG_ENV)) {
-				printf("ERROR: %s does not contain a valid "
-					"%s sum\n", *argv, algo->name);
+			if (hash_verify(algo, addr, len, output, *argv,
+					flags & HASH_FLAG_ENV))
 				return 1;
-			}
-			if (memcmp(output, vsum, algo->digest_size) != 0) {
-				int i;
-
-				hash_show(algo, addr, len, output);
-				printf(" != ");
-				for (i = 0; i < algo->digest_size; i++)
-					printf("%02x", vsum[i]);
-				puts(" ** ERROR **\n");
-				return 1;
-			}
 		} else {
 			hash_show(algo, addr, len, output);
 			printf("\n");
@@ -13,6 +13,146 @@
 
 DECLARE_GLOBAL_DATA_PTR;
 
+static void malloc_simple_peak(void)
+{
+	if (gd->malloc_ptr > gd->malloc_peak)
+		gd->malloc_peak = gd->malloc_ptr;
+}
+
+#ifdef CONFIG_SYS_MALLOC_F_FREE
+/*
+ * Each block starts with a header holding its size, including the header,
+ * with the bottom bit set if the block is free. Blocks follow each other
+ * from malloc_base up to malloc_ptr. free() merges a block with any free
+ * blocks after it, and gives them back if they are at the top. malloc()
+ * takes the first free block which is large enough, merging free blocks
+ * as it looks, and otherwise allocates at the top.
+ */
+#define MF_HDR		sizeof(ulong)
+#define MF_FREE		1UL
+#define MF_NONE		(~0UL)
+
+static inline ulong *mf_block(ulong ofs)
+{
+	return map_sysmem(gd->malloc_base + ofs, MF_HDR);
+}
+
+/* Merge the free block at @ofs, of @len bytes, with free blocks after it */
+static ulong mf_merge(ulong ofs, ulong len)
+{
+	ulong next;
+
+	while (ofs + len < gd->malloc_ptr) {
+		next = *mf_block(ofs + len);
+		if (!(next & MF_FREE))
+			break;
+		len += next & ~MF_FREE;
+	}
+
+	return len;
+}
+
+/* Find a free block of at least @size bytes and mark it in use */
+static ulong mf_find(ulong size)
+{
+	ulong ofs, len, *hdr;
+
+	for (ofs = 0; ofs < gd->malloc_ptr; ofs += len) {
+		hdr = mf_block(ofs);
+		len = *hdr & ~MF_FREE;
+		if (!(*hdr & MF_FREE))
+			continue;
+		len = mf_merge(ofs, len);
+		if (ofs + len == gd->malloc_ptr) {
+			gd->malloc_ptr = ofs;
+			break;
+		}
+		if (len < size) {
+			*hdr = len | MF_FREE;
+			continue;
+		}
+		if (len - size >= MF_HDR) {
+			*mf_block(ofs + size) = (len - size) | MF_FREE;
+			len = size;
+		}
+		*hdr = len;
+
+		return ofs;
+	}
+
+	return MF_NONE;
+}
+
+static void *mf_alloc(size_t bytes, size_t align)
+{
+	ulong size = ALIGN(bytes + MF_HDR, MF_HDR);
+	ulong ofs = MF_NONE, gap;
+
+	if (align <= MF_HDR)
+		ofs = mf_find(size);
+	if (ofs == MF_NONE) {
+		/* Allocate at the top, leaving any gap as a free block */
+		ofs = gd->malloc_ptr;
+		if (align > MF_HDR)
+			ofs = ALIGN(gd->malloc_base + ofs + MF_HDR, align) -
+				MF_HDR - gd->malloc_base;
+		if (ofs + size > gd->malloc_limit)
+			return NULL;
+		gap = ofs - gd->malloc_ptr;
+		if (gap)
+			*mf_block(gd->malloc_ptr) = gap | MF_FREE;
+		*mf_block(ofs) = size;
+		gd->malloc_ptr = ofs + size;
+		malloc_simple_peak();
+	}
+
+	return map_sysmem(gd->malloc_base + ofs + MF_HDR, bytes);
+}
+
+void *malloc_simple(size_t bytes)
+{
+	return mf_alloc(bytes, 0);
+}
+
+void *memalign_simple(size_t align, size_t bytes)
+{
+	return mf_alloc(bytes, align);
+}
+
+void free_simple(void *ptr)
+{
+	ulong ofs, len, *hdr;
+
+	if (!ptr)
+		return;
+	ofs = map_to_sysmem(ptr) - gd->malloc_base - MF_HDR;
+	hdr = mf_block(ofs);
+	assert(!(*hdr & MF_FREE));
+	len = mf_merge(ofs, *hdr);
+	if (ofs + len == gd->malloc_ptr)
+		gd->malloc_ptr = ofs;
+	else
+		*hdr = len | MF_FREE;
+}
+
+void *realloc_simple(void *ptr, size_t bytes)
+{
+	ulong old;
+	void *new;
+
+	if (!ptr)
+		return malloc_simple(bytes);
+	old = *mf_block(map_to_sysmem(ptr) - gd->malloc_base - MF_HDR) -
+		MF_HDR;
+	new = malloc_simple(bytes);
+	if (new) {
+		memcpy(new, ptr, min((ulong)bytes, old));
+		free_simple(ptr);
+	}
+
+	return new;
+}
+#else
 void *malloc_simple(size_t bytes)
 {
 	ulong new_ptr;
@@ -23,6 +163,7 @@ void *malloc_simple(size_t bytes)
 		return NULL;
 	ptr = map_sysmem(gd->malloc_base + gd->malloc_ptr, bytes);
 	gd->malloc_ptr = ALIGN(new_ptr, sizeof(new_ptr));
+	malloc_simple_peak();
 	return ptr;
 }
 
@@ -31,15 +172,37 @@ void *memalign_simple(size_t align, size_t bytes)
 	ulong addr, new_ptr;
 	void *ptr;
 
-	addr = ALIGN(gd->malloc_base + gd->malloc_ptr, bytes);
-	new_ptr = addr + bytes;
+	addr = ALIGN(gd->malloc_base + gd->malloc_ptr, align);
+	new_ptr = addr + bytes - gd->malloc_base;
 	if (new_ptr > gd->malloc_limit)
 		return NULL;
 	ptr = map_sysmem(addr, bytes);
 	gd->malloc_ptr = ALIGN(new_ptr, sizeof(new_ptr));
+	malloc_simple_peak();
 	return ptr;
 }
 
+void free_simple(void *ptr)
+{
+	/* Nothing is freed - all the memory will be freed on relocation */
+}
+
+void *realloc_simple(void *ptr, size_t bytes)
+{
+	void *new;
+
+	/*
+	 * The size of the old block is not known, but the new one is above
+	 * it, so copying @bytes from the old block stays inside the pool
+	 */
+	new = malloc_simple(bytes);
+	if (new && ptr)
+		memmove(new, ptr, bytes);
+
+	return new;
+}
+#endif
+
 #ifdef CONFIG_SYS_MALLOC_SIMPLE
 void *calloc(size_t nmemb, size_t elem_size)
 {
@@ -47,7 +210,8 @@ void *calloc(size_t nmemb, size_t elem_size)
 	void *ptr;
 
 	ptr = malloc(size);
-	memset(ptr, '\0', size);
+	if (ptr)
+		memset(ptr, '\0', size);
 
 	return ptr;
 }
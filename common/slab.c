@@ -0,0 +1,255 @@
+/*
+ * Slabs for small objects, alongside malloc()
+ *
+ * The slab area is split into pages, each holding objects of one size
+ * class after a small header. Each pool keeps a free list per class, so
+ * allocating and freeing is a list operation, and objects of the same
+ * size are packed together instead of being scattered through the
+ * malloc() area. Pages stay with their pool until it is released, which
+ * returns them all to the area at once.
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <errno.h>
+#include <slab.h>
+#include <linux/bitops.h>
+
+DECLARE_GLOBAL_DATA_PTR;
+
+/**
+ * struct slab_page - Header at the start of each page
+ *
+ * @pool:	Pool owning the page
+ * @next:	Next page of the pool, or next free page
+ * @class:	Size class of the objects in the page
+ */
+struct slab_page {
+	struct slab_pool *pool;
+	struct slab_page *next;
+	uint class;
+};
+
+#define SLAB_HDR_SIZE	ALIGN(sizeof(struct slab_page), SLAB_MIN_SIZE)
+
+/**
+ * struct slab_area - The memory set aside for slabs
+ *
+ * @start:	Start of the first page
+ * @end:	End of the last page
+ * @top:	Pages below this have been handed out at some point
+ * @free_pages:	Pages returned by slab_release()
+ * @num_free:	Number of pages in @free_pages
+ * @peak:	Highest number of pages in use at once
+ * @pools:	Pools which have allocated from the area
+ */
+static struct slab_area {
+	ulong start;
+	ulong end;
+	ulong top;
+	struct slab_page *free_pages;
+	uint num_free;
+	uint peak;
+	struct slab_pool *pools;
+} slab;
+
+static inline uint slab_class_size(uint class)
+{
+	return SLAB_MIN_SIZE << class;
+}
+
+static inline uint slab_class_of(size_t size)
+{
+	return size <= SLAB_MIN_SIZE ? 0 : fls(size - 1) - 4;
+}
+
+static inline struct slab_page *slab_page_of(const void *ptr)
+{
+	return (struct slab_page *)((ulong)ptr & ~(ulong)(SLAB_PAGE_SIZE - 1));
+}
+
+static uint slab_pages_used(void)
+{
+	return (slab.top - slab.start) / SLAB_PAGE_SIZE - slab.num_free;
+}
+
+void slab_init(ulong start, ulong size)
+{
+	slab.start = ALIGN(start, SLAB_PAGE_SIZE);
+	slab.end = (start + size) & ~(ulong)(SLAB_PAGE_SIZE - 1);
+	if (slab.end <= slab.start)
+		slab.start = slab.end = 0;
+	slab.top = slab.start;
+	slab.free_pages = NULL;
+	slab.num_free = 0;
+	slab.peak = 0;
+	slab.pools = NULL;
+	debug("using memory %#lx-%#lx for slabs\n", slab.start, slab.end);
+}
+
+/* Add a page of objects to a pool's free list for a class */
+static int slab_add_page(struct slab_pool *pool, uint class)
+{
+	struct slab_class *sc = &pool->class[class];
+	uint size = slab_class_size(class);
+	struct slab_pool *p;
+	struct slab_page *page;
+	uint count, i;
+	char *obj;
+
+	if (slab.free_pages) {
+		page = slab.free_pages;
+		slab.free_pages = page->next;
+		slab.num_free--;
+	} else if (slab.top + SLAB_PAGE_SIZE <= slab.end) {
+		page = (struct slab_page *)slab.top;
+		slab.top += SLAB_PAGE_SIZE;
+	} else {
+		return -ENOMEM;
+	}
+	if (slab_pages_used() > slab.peak)
+		slab.peak = slab_pages_used();
+
+	if (!pool->num_pages) {
+		for (p = slab.pools; p && p != pool; p = p->next)
+			;
+		if (!p) {
+			pool->next = slab.pools;
+			slab.pools = pool;
+		}
+	}
+	page->pool = pool;
+	page->class = class;
+	page->next = pool->pages;
+	pool->pages = page;
+	pool->num_pages++;
+
+	/* Link the objects in address order, ahead of any others */
+	count = (SLAB_PAGE_SIZE - SLAB_HDR_SIZE) / size;
+	obj = (char *)page + SLAB_HDR_SIZE;
+	for (i = 1; i < count; i++, obj += size)
+		*(void **)obj = obj + size;
+	*(void **)obj = sc->free;
+	sc->free = (char *)page + SLAB_HDR_SIZE;
+	sc->total += count;
+
+	return 0;
+}
+
+void *slab_alloc(struct slab_pool *pool, size_t size)
+{
+	struct slab_class *sc;
+	uint class;
+	void *ptr;
+
+	if (!(gd->flags & GD_FLG_FULL_MALLOC_INIT) || !slab.end ||
+	    !size || size > SLAB_MAX_SIZE)
+		return NULL;
+	class = slab_class_of(size);
+	sc = &pool->class[class];
+	if (!sc->free && slab_add_page(pool, class)) {
+		pool->fallback++;
+		return NULL;
+	}
+	ptr = sc->free;
+	sc->free = *(void **)ptr;
+	if (++sc->used > sc->peak)
+		sc->peak = sc->used;
+
+	return ptr;
+}
+
+bool slab_owns(const void *ptr)
+{
+	return (ulong)ptr >= slab.start && (ulong)ptr < slab.end;
+}
+
+void slab_free(void *ptr)
+{
+	struct slab_page *page = slab_page_of(ptr);
+	struct slab_class *sc = &page->pool->class[page->class];
+
+	assert(((ulong)ptr - (ulong)page - SLAB_HDR_SIZE) %
+	       slab_class_size(page->class) == 0);
+	*(void **)ptr = sc->free;
+	sc->free = ptr;
+	sc->used--;
+}
+
+size_t slab_size(const void *ptr)
+{
+	return slab_class_size(slab_page_of(ptr)->class);
+}
+
+void slab_release(struct slab_pool *pool)
+{
+	struct slab_page *page, *next;
+	uint class, lost = 0;
+
+	for (page = pool->pages; page; page = next) {
+		next = page->next;
+		page->next = slab.free_pages;
+		slab.free_pages = page;
+		slab.num_free++;
+	}
+	pool->pages = NULL;
+	pool->num_pages = 0;
+	for (class = 0; class < SLAB_CLASSES; class++) {
+		lost += pool->class[class].used;
+		pool->class[class].free = NULL;
+		pool->class[class].used = 0;
+		pool->class[class].total = 0;
+	}
+	if (lost)
+		debug("slab: %s: released %u objects still in use\n",
+		      pool->name, lost);
+}
+
+ulong slab_used_bytes(void)
+{
+	struct slab_pool *pool;
+	ulong bytes = 0;
+	uint class;
+
+	for (pool = slab.pools; pool; pool = pool->next) {
+		for (class = 0; class < SLAB_CLASSES; class++)
+			bytes += (ulong)pool->class[class].used *
+				slab_class_size(class);
+	}
+
+	return bytes;
+}
+
+void slab_print_stats(void)
+{
+	struct slab_pool *pool;
+	struct slab_class *sc;
+	uint class;
+
+	if (!slab.end) {
+		puts("Slabs not set up\n");
+		return;
+	}
+	printf("Slab area:  %08lx-%08lx, %lu pages of %u bytes\n",
+	       slab.start, slab.end, (slab.end - slab.start) / SLAB_PAGE_SIZE,
+	       SLAB_PAGE_SIZE);
+	printf("Pages:      %u used, peak %u, %u in use bytes\n",
+	       slab_pages_used(), slab.peak, (uint)slab_used_bytes());
+	if (!slab.pools)
+		return;
+	printf("\n%-12s %6s %8s %8s %8s %6s %9s\n", "Pool", "Size", "Used",
+	       "Total", "Peak", "Pages", "Fallback");
+	for (pool = slab.pools; pool; pool = pool->next) {
+		printf("%-12s %33s %6u %9u\n", pool->name, "",
+		       pool->num_pages, pool->fallback);
+		for (class = 0; class < SLAB_CLASSES; class++) {
+			sc = &pool->class[class];
+			if (!sc->total && !sc->peak)
+				continue;
+			printf("%-12s %6u %8u %8u %8u\n", "",
+			       slab_class_size(class), sc->used, sc->total,
+			       sc->peak);
+		}
+	}
+}
@@ -162,6 +162,7 @@ void board_init_r(gd_t *dummy1, ulong dummy2)
 #elif defined(CONFIG_SYS_MALLOC_F_LEN)
 	gd->malloc_limit = CONFIG_SYS_MALLOC_F_LEN;
 	gd->malloc_ptr = 0;
+	gd->malloc_peak = 0;
 #endif
 	if (IS_ENABLED(CONFIG_OF_CONTROL) &&
 			!IS_ENABLED(CONFIG_SPL_DISABLE_OF_CONTROL)) {
@@ -281,8 +282,9 @@ void board_init_r(gd_t *dummy1, ulong dummy2)
 		debug("Unsupported OS image.. Jumping nevertheless..\n");
 	}
 #if defined(CONFIG_SYS_MALLOC_F_LEN) && !defined(CONFIG_SYS_SPL_MALLOC_SIZE)
-	debug("SPL malloc() used %#lx bytes (%ld KB)\n", gd->malloc_ptr,
-	      gd->malloc_ptr / 1024);
+	debug("SPL malloc() used %#lx bytes (%ld KB), peak %#lx of %#x\n",
+	      gd->malloc_ptr, gd->malloc_ptr / 1024, gd->malloc_peak,
+	      CONFIG_SYS_MALLOC_F_LEN);
 #endif
 
 	jump_to_image_no_args(&spl_image);
@@ -1117,6 +1117,7 @@ unsigned long usb_stor_write(int device, lbaint_t blknr,
 	if (!dev)
 		return 0;
 	ss = (struct us_data *)dev->privptr;
+	part_dev_changed(&usb_dev_desc[device]);
 
 	usb_disable_asynch(1); /* asynch transfer not allowed */
 
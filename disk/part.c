@@ -247,10 +247,20 @@ void dev_print (block_dev_desc_t *dev_desc)
 }
 #endif
 
+void part_dev_changed(block_dev_desc_t *dev_desc)
+{
+	static ulong change_count;
+
+	dev_desc->change_id = ++change_count;
+}
+
 #ifdef HAVE_BLOCK_DEVICE
 
 void init_part(block_dev_desc_t *dev_desc)
 {
+	/* The device may have been replaced, or the medium swapped */
+	part_dev_changed(dev_desc);
+
 #ifdef CONFIG_ISO_PARTITION
 	if (test_part_iso(dev_desc) == 0) {
 		dev_desc->part_type = PART_TYPE_ISO;
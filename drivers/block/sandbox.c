@@ -46,6 +46,10 @@ static unsigned long host_block_write(int dev, unsigned long start,
 				      lbaint_t blkcnt, const void *buffer)
 {
 	struct host_block_dev *host_dev = find_host_device(dev);
+
+	if (!host_dev)
+		return -1;
+	part_dev_changed(&host_dev->blk_dev);
 	if (os_lseek(host_dev->fd,
 		     start * host_dev->blk_dev.blksz,
 		     OS_SEEK_SET) == -1) {
@@ -179,6 +179,7 @@ int device_remove(struct udevice *dev)
 
 	device_free(dev);
 
+	uclass_index_del(dev, DM_INDEX_SEQ);
 	dev->seq = -1;
 	dev->flags &= ~DM_FLAG_ACTIVATED;
 
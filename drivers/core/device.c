@@ -12,6 +12,7 @@
 #include <common.h>
 #include <fdtdec.h>
 #include <malloc.h>
+#include <slab.h>
 #include <dm/device.h>
 #include <dm/device-internal.h>
 #include <dm/lists.h>
@@ -40,7 +41,7 @@ int device_bind(struct udevice *parent, const struct driver *drv,
 	if (ret)
 		return ret;
 
-	dev = calloc(1, sizeof(struct udevice));
+	dev = slab_calloc(&dm_slab_pool, sizeof(struct udevice));
 	if (!dev)
 		return -ENOMEM;
 
@@ -75,7 +76,8 @@ int device_bind(struct udevice *parent, const struct driver *drv,
 
 	if (!dev->platdata && drv->platdata_auto_alloc_size) {
 		dev->flags |= DM_FLAG_ALLOC_PDATA;
-		dev->platdata = calloc(1, drv->platdata_auto_alloc_size);
+		dev->platdata = slab_calloc(&dm_slab_pool,
+					    drv->platdata_auto_alloc_size);
 		if (!dev->platdata) {
 			ret = -ENOMEM;
 			goto fail_alloc1;
@@ -85,7 +87,7 @@ int device_bind(struct udevice *parent, const struct driver *drv,
 	size = uc->uc_drv->per_device_platdata_auto_alloc_size;
 	if (size) {
 		dev->flags |= DM_FLAG_ALLOC_UCLASS_PDATA;
-		dev->uclass_platdata = calloc(1, size);
+		dev->uclass_platdata = slab_calloc(&dm_slab_pool, size);
 		if (!dev->uclass_platdata) {
 			ret = -ENOMEM;
 			goto fail_alloc2;
@@ -100,7 +102,8 @@ int device_bind(struct udevice *parent, const struct driver *drv,
 		}
 		if (size) {
 			dev->flags |= DM_FLAG_ALLOC_PARENT_PDATA;
-			dev->parent_platdata = calloc(1, size);
+			dev->parent_platdata = slab_calloc(&dm_slab_pool,
+							    size);
 			if (!dev->parent_platdata) {
 				ret = -ENOMEM;
 				goto fail_alloc3;
@@ -197,7 +200,7 @@ static void *alloc_priv(int size, uint flags)
 		if (priv)
 			memset(priv, '\0', size);
 	} else {
-		priv = calloc(1, size);
+		priv = slab_calloc(&dm_slab_pool, size);
 	}
 
 	return priv;
@@ -207,6 +210,7 @@ int device_probe_child(struct udevice *dev, void *parent_priv)
 {
 	const struct driver *drv;
 	int size = 0;
+	int span;
 	int ret;
 	int seq;
 
@@ -216,6 +220,8 @@ int device_probe_child(struct udevice *dev, void *parent_priv)
 	if (dev->flags & DM_FLAG_ACTIVATED)
 		return 0;
 
+	span = bootstage_span_start(dev->name, 0, BOOTSTAGE_SPANF_PROBE);
+
 	drv = dev->driver;
 	assert(drv);
 
@@ -230,7 +236,7 @@ int device_probe_child(struct udevice *dev, void *parent_priv)
 	/* Allocate private data if requested */
 	size = dev->uclass->uc_drv->per_device_auto_alloc_size;
 	if (size) {
-		dev->uclass_priv = calloc(1, size);
+		dev->uclass_priv = slab_calloc(&dm_slab_pool, size);
 		if (!dev->uclass_priv) {
 			ret = -ENOMEM;
 			goto fail;
@@ -265,6 +271,7 @@ int device_probe_child(struct udevice *dev, void *parent_priv)
 		goto fail;
 	}
 	dev->seq = seq;
+	uclass_index_add(dev, DM_INDEX_SEQ);
 
 	dev->flags |= DM_FLAG_ACTIVATED;
 
@@ -296,6 +303,7 @@ int device_probe_child(struct udevice *dev, void *parent_priv)
 	ret = uclass_post_probe_device(dev);
 	if (ret)
 		goto fail_uclass;
+	bootstage_span_end(span);
 
 	return 0;
 fail_uclass:
@@ -306,8 +314,10 @@ fail_uclass:
 fail:
 	dev->flags &= ~DM_FLAG_ACTIVATED;
 
+	uclass_index_del(dev, DM_INDEX_SEQ);
 	dev->seq = -1;
 	device_free(dev);
+	bootstage_span_end(span);
 
 	return ret;
 }
@@ -367,6 +377,13 @@ void *dev_get_uclass_priv(struct udevice *dev)
 	return dev->uclass_priv;
 }
 
+void dev_set_of_offset(struct udevice *dev, int of_offset)
+{
+	uclass_index_del(dev, DM_INDEX_OF_OFFSET);
+	dev->of_offset = of_offset;
+	uclass_index_add(dev, DM_INDEX_OF_OFFSET);
+}
+
 void *dev_get_parentdata(struct udevice *dev)
 {
 	if (!dev) {
@@ -103,34 +103,25 @@ int device_bind_driver_to_node(struct udevice *parent, const char *drv_name,
 /**
  * driver_check_compatible() - Check if a driver is compatible with this node
  *
- * @param blob:		Device tree pointer
- * @param offset:	Offset of node in device tree
+ * @param compat:	The node's compatible property, a list of strings
+ * @param compat_len:	Length of @compat in bytes
  * @param of_match:	List of compatible strings to match
  * @param of_idp:	Returns the match that was found
- * @return 0 if there is a match, -ENOENT if no match, -ENODEV if the node
- * does not have a compatible string, other error <0 if there is a device
- * tree error
+ * @return 0 if there is a match, -ENOENT if no match
  */
-static int driver_check_compatible(const void *blob, int offset,
+static int driver_check_compatible(const char *compat, int compat_len,
 				   const struct udevice_id *of_match,
 				   const struct udevice_id **of_idp)
 {
-	int ret;
-
 	*of_idp = NULL;
 	if (!of_match)
 		return -ENOENT;
 
 	while (of_match->compatible) {
-		ret = fdt_node_check_compatible(blob, offset,
-						of_match->compatible);
-		if (!ret) {
+		if (fdt_stringlist_contains(compat, compat_len,
+					    of_match->compatible)) {
 			*of_idp = of_match;
 			return 0;
-		} else if (ret == -FDT_ERR_NOTFOUND) {
-			return -ENODEV;
-		} else if (ret < 0) {
-			return -EINVAL;
 		}
 		of_match++;
 	}
@@ -147,27 +138,32 @@ int lists_bind_fdt(struct udevice *parent, const void *blob, int offset,
 	struct driver *entry;
 	struct udevice *dev;
 	bool found = false;
+	const char *compat;
 	const char *name;
-	int result = 0;
+	int compat_len;
 	int ret = 0;
 
-	dm_dbg("bind node %s\n", fdt_get_name(blob, offset, NULL));
+	name = fdt_get_name(blob, offset, NULL);
+	dm_dbg("bind node %s\n", name);
 	if (devp)
 		*devp = NULL;
-	for (entry = driver; entry != driver + n_ents; entry++) {
-		ret = driver_check_compatible(blob, offset, entry->of_match,
-					      &id);
-		name = fdt_get_name(blob, offset, NULL);
-		if (ret == -ENOENT) {
-			continue;
-		} else if (ret == -ENODEV) {
+
+	/* Look up the node's compatible strings once, not for each driver */
+	compat = fdt_getprop(blob, offset, "compatible", &compat_len);
+	if (!compat) {
+		if (compat_len == -FDT_ERR_NOTFOUND) {
 			dm_dbg("Device '%s' has no compatible string\n", name);
-			break;
-		} else if (ret) {
-			dm_warn("Device tree error at offset %d\n", offset);
-			result = ret;
-			break;
+			return 0;
 		}
+		dm_warn("Device tree error at offset %d\n", offset);
+		return -EINVAL;
+	}
+
+	for (entry = driver; entry != driver + n_ents; entry++) {
+		ret = driver_check_compatible(compat, compat_len,
+					      entry->of_match, &id);
+		if (ret == -ENOENT)
+			continue;
 
 		dm_dbg("   - found match at '%s'\n", entry->name);
 		ret = device_bind(parent, entry, name, NULL, offset, &dev);
@@ -183,11 +179,9 @@ int lists_bind_fdt(struct udevice *parent, const void *blob, int offset,
 		break;
 	}
 
-	if (!found && !result && ret != -ENODEV) {
-		dm_dbg("No match for node '%s'\n",
-		       fdt_get_name(blob, offset, NULL));
-	}
+	if (!found)
+		dm_dbg("No match for node '%s'\n", name);
 
-	return result;
+	return 0;
 }
 #endif
@@ -12,17 +12,21 @@
 #include <fdtdec.h>
 #include <malloc.h>
 #include <libfdt.h>
+#include <slab.h>
 #include <dm/device.h>
 #include <dm/device-internal.h>
 #include <dm/lists.h>
 #include <dm/platdata.h>
 #include <dm/root.h>
 #include <dm/uclass.h>
+#include <dm/uclass-internal.h>
 #include <dm/util.h>
 #include <linux/list.h>
 
 DECLARE_GLOBAL_DATA_PTR;
 
+struct slab_pool dm_slab_pool = SLAB_POOL("dm");
+
 static const struct driver_info root_info = {
 	.name		= "root_driver",
 };
@@ -105,6 +109,16 @@ int dm_init(void)
 		return -EINVAL;
 	}
 	INIT_LIST_HEAD(&DM_UCLASS_ROOT_NON_CONST);
+#ifdef CONFIG_DM_INDEX
+	/* Before relocation there are few uclasses, so just use the list */
+	gd->uclass_index = NULL;
+	if (gd->flags & GD_FLG_RELOC) {
+		gd->uclass_index = calloc(UCLASS_COUNT,
+					  sizeof(*gd->uclass_index));
+		if (!gd->uclass_index)
+			return -ENOMEM;
+	}
+#endif
 
 #if defined(CONFIG_NEEDS_MANUAL_RELOC)
 	fix_drivers();
@@ -115,7 +129,7 @@ int dm_init(void)
 	if (ret)
 		return ret;
 #ifdef CONFIG_OF_CONTROL
-	DM_ROOT_NON_CONST->of_offset = 0;
+	dev_set_of_offset(DM_ROOT_NON_CONST, 0);
 #endif
 	ret = device_probe(DM_ROOT_NON_CONST);
 	if (ret)
@@ -126,8 +140,25 @@ int dm_init(void)
 
 int dm_uninit(void)
 {
+#ifdef CONFIG_DM_DEVICE_REMOVE
+	struct uclass *uc, *next;
+#endif
+
 	device_remove(dm_root());
 	device_unbind(dm_root());
+#ifdef CONFIG_DM_DEVICE_REMOVE
+	list_for_each_entry_safe(uc, next, &DM_UCLASS_ROOT_NON_CONST,
+				 sibling_node)
+		uclass_destroy(uc);
+	gd->dm_root = NULL;
+
+	/* Nothing refers to the pool now, so give back its pages */
+	slab_release(&dm_slab_pool);
+#endif
+#ifdef CONFIG_DM_INDEX
+	free(gd->uclass_index);
+	gd->uclass_index = NULL;
+#endif
 
 	return 0;
 }
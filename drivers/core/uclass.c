@@ -10,6 +10,7 @@
 #include <common.h>
 #include <errno.h>
 #include <malloc.h>
+#include <slab.h>
 #include <dm/device.h>
 #include <dm/device-internal.h>
 #include <dm/lists.h>
@@ -19,17 +20,212 @@
 
 DECLARE_GLOBAL_DATA_PTR;
 
+#ifdef CONFIG_DM_INDEX
+/*
+ * Each uclass has a hash table of its devices for each key in enum
+ * dm_index_key. A bucket is a chain through the devices' index_next[] and
+ * a device is added to the end of its chain, so that devices which share a
+ * key are found in the same order as in dev_head. A device with no value
+ * for a key (a seq or of_offset of -1) is left out of that table.
+ *
+ * The tables grow so that there are never more devices than buckets.
+ */
+#define UCLASS_INDEX_MIN_BITS	3
+
+/* Multiplicative hash, taking the top bits which are the best mixed */
+static uint uclass_index_hash(uint val, uint bits)
+{
+	return (val * 0x9e3779b1) >> (32 - bits);
+}
+
+static struct udevice **uclass_index_head(struct uclass *uc,
+					  enum dm_index_key key, int val,
+					  const char *name)
+{
+	uint hash;
+
+	if (key == DM_INDEX_NAME) {
+		for (hash = 0; *name; name++)
+			hash = hash * 31 + *name;
+	} else {
+		hash = val;
+	}
+
+	return &uc->index[(key << uc->index_bits) +
+			  uclass_index_hash(hash, uc->index_bits)];
+}
+
+static int uclass_index_val(struct udevice *dev, enum dm_index_key key)
+{
+	switch (key) {
+	case DM_INDEX_SEQ:
+		return dev->seq;
+	case DM_INDEX_REQ_SEQ:
+		return dev->req_seq;
+	case DM_INDEX_OF_OFFSET:
+		return dev->of_offset;
+	default:
+		return 0;
+	}
+}
+
+/* Get the bucket @dev belongs in for @key, or NULL if it is not indexed */
+static struct udevice **uclass_index_dev_head(struct udevice *dev,
+					      enum dm_index_key key)
+{
+	struct uclass *uc = dev->uclass;
+	int val = uclass_index_val(dev, key);
+
+	if (!uc->index || val < 0)
+		return NULL;
+
+	return uclass_index_head(uc, key, val, dev->name);
+}
+
+static bool uclass_index_match(struct udevice *dev, enum dm_index_key key,
+			       int val, const char *name)
+{
+	if (key == DM_INDEX_NAME)
+		return !strcmp(dev->name, name);
+
+	return uclass_index_val(dev, key) == val;
+}
+
+/*
+ * Find the first device in @uc with the given value for @key: @val, or
+ * @name for DM_INDEX_NAME. The uclass must have an index.
+ */
+static struct udevice *uclass_index_find(struct uclass *uc,
+					 enum dm_index_key key, int val,
+					 const char *name)
+{
+	struct udevice *dev;
+
+	for (dev = *uclass_index_head(uc, key, val, name); dev;
+	     dev = dev->index_next[key]) {
+		if (uclass_index_match(dev, key, val, name))
+			return dev;
+	}
+
+	return NULL;
+}
+
+void uclass_index_add(struct udevice *dev, enum dm_index_key key)
+{
+	struct udevice **linkp = uclass_index_dev_head(dev, key);
+
+	if (!linkp)
+		return;
+	while (*linkp)
+		linkp = &(*linkp)->index_next[key];
+	dev->index_next[key] = NULL;
+	*linkp = dev;
+}
+
+void uclass_index_del(struct udevice *dev, enum dm_index_key key)
+{
+	struct udevice **linkp = uclass_index_dev_head(dev, key);
+
+	if (!linkp)
+		return;
+	for (; *linkp; linkp = &(*linkp)->index_next[key]) {
+		if (*linkp == dev) {
+			*linkp = dev->index_next[key];
+			break;
+		}
+	}
+}
+
+/*
+ * Rebuild the index of @uc with 1 << @bits buckets for each key, adding
+ * every device in dev_head. If there is no memory the old index is kept.
+ */
+static int uclass_index_resize(struct uclass *uc, uint bits)
+{
+	struct udevice **index;
+	struct udevice *dev;
+	int key;
+
+	index = calloc(DM_INDEX_COUNT << bits, sizeof(*index));
+	if (!index)
+		return -ENOMEM;
+	free(uc->index);
+	uc->index = index;
+	uc->index_bits = bits;
+	list_for_each_entry(dev, &uc->dev_head, uclass_node) {
+		for (key = 0; key < DM_INDEX_COUNT; key++)
+			uclass_index_add(dev, key);
+	}
+
+	return 0;
+}
+
+/*
+ * Index a device which has just been added to the end of dev_head. This is
+ * only done after relocation: before that there are few devices and not
+ * much malloc() space.
+ */
+static void uclass_index_bind(struct udevice *dev)
+{
+	struct uclass *uc = dev->uclass;
+	int key;
+
+	uc->dev_count++;
+	if (!uc->index) {
+		if (gd->flags & GD_FLG_RELOC)
+			uclass_index_resize(uc, UCLASS_INDEX_MIN_BITS);
+		return;
+	}
+	if (uc->dev_count > 1U << uc->index_bits &&
+	    !uclass_index_resize(uc, uc->index_bits + 1))
+		return;
+	for (key = 0; key < DM_INDEX_COUNT; key++)
+		uclass_index_add(dev, key);
+}
+
+static void uclass_index_unbind(struct udevice *dev)
+{
+	int key;
+
+	for (key = 0; key < DM_INDEX_COUNT; key++)
+		uclass_index_del(dev, key);
+	dev->uclass->dev_count--;
+}
+
+static bool uclass_indexed(struct uclass *uc)
+{
+	return uc->index;
+}
+
+static void uclass_set_index(enum uclass_id id, struct uclass *uc)
+{
+	if (gd->uclass_index)
+		gd->uclass_index[id] = uc;
+}
+#else
+static inline struct udevice *uclass_index_find(struct uclass *uc,
+						enum dm_index_key key,
+						int val, const char *name)
+{
+	return NULL;
+}
+
+static inline void uclass_index_bind(struct udevice *dev) {}
+static inline void uclass_index_unbind(struct udevice *dev) {}
+static inline bool uclass_indexed(struct uclass *uc) { return false; }
+static inline void uclass_set_index(enum uclass_id id, struct uclass *uc) {}
+#endif
+
 struct uclass *uclass_find(enum uclass_id key)
 {
 	struct uclass *uc;
 
 	if (!gd->dm_root)
 		return NULL;
-	/*
-	 * TODO(sjg@chromium.org): Optimise this, perhaps moving the found
-	 * node to the start of the list, or creating a linear array mapping
-	 * id to node.
-	 */
+#ifdef CONFIG_DM_INDEX
+	if (gd->uclass_index)
+		return gd->uclass_index[key];
+#endif
 	list_for_each_entry(uc, &gd->uclass_root, sibling_node) {
 		if (uc->uc_drv->id == key)
 			return uc;
@@ -60,11 +256,12 @@ static int uclass_add(enum uclass_id id, struct uclass **ucp)
 			id);
 		return -ENOENT;
 	}
-	uc = calloc(1, sizeof(*uc));
+	uc = slab_calloc(&dm_slab_pool, sizeof(*uc));
 	if (!uc)
 		return -ENOMEM;
 	if (uc_drv->priv_auto_alloc_size) {
-		uc->priv = calloc(1, uc_drv->priv_auto_alloc_size);
+		uc->priv = slab_calloc(&dm_slab_pool,
+				       uc_drv->priv_auto_alloc_size);
 		if (!uc->priv) {
 			ret = -ENOMEM;
 			goto fail_mem;
@@ -74,6 +271,7 @@ static int uclass_add(enum uclass_id id, struct uclass **ucp)
 	INIT_LIST_HEAD(&uc->sibling_node);
 	INIT_LIST_HEAD(&uc->dev_head);
 	list_add(&uc->sibling_node, &DM_UCLASS_ROOT_NON_CONST);
+	uclass_set_index(id, uc);
 
 	if (uc_drv->init) {
 		ret = uc_drv->init(uc);
@@ -90,6 +288,7 @@ fail:
 		uc->priv = NULL;
 	}
 	list_del(&uc->sibling_node);
+	uclass_set_index(id, NULL);
 fail_mem:
 	free(uc);
 
@@ -123,8 +322,12 @@ int uclass_destroy(struct uclass *uc)
 	if (uc_drv->destroy)
 		uc_drv->destroy(uc);
 	list_del(&uc->sibling_node);
+	uclass_set_index(uc_drv->id, NULL);
 	if (uc_drv->priv_auto_alloc_size)
 		free(uc->priv);
+#ifdef CONFIG_DM_INDEX
+	free(uc->index);
+#endif
 	free(uc);
 
 	return 0;
@@ -208,6 +411,15 @@ int uclass_find_device_by_name(enum uclass_id id, const char *name,
 	if (ret)
 		return ret;
 
+	/*
+	 * The index finds an exact match. Failing that, take the first device
+	 * whose name starts with @name.
+	 */
+	if (uclass_indexed(uc)) {
+		*devp = uclass_index_find(uc, DM_INDEX_NAME, 0, name);
+		if (*devp)
+			return 0;
+	}
 	list_for_each_entry(dev, &uc->dev_head, uclass_node) {
 		if (!strncmp(dev->name, name, strlen(name))) {
 			*devp = dev;
@@ -233,6 +445,12 @@ int uclass_find_device_by_seq(enum uclass_id id, int seq_or_req_seq,
 	if (ret)
 		return ret;
 
+	if (uclass_indexed(uc)) {
+		*devp = uclass_index_find(uc, find_req_seq ? DM_INDEX_REQ_SEQ :
+					  DM_INDEX_SEQ, seq_or_req_seq, NULL);
+		debug("   - %sfound\n", *devp ? "" : "not ");
+		return *devp ? 0 : -ENODEV;
+	}
 	list_for_each_entry(dev, &uc->dev_head, uclass_node) {
 		debug("   - %d %d\n", dev->req_seq, dev->seq);
 		if ((find_req_seq ? dev->req_seq : dev->seq) ==
@@ -247,8 +465,8 @@ int uclass_find_device_by_seq(enum uclass_id id, int seq_or_req_seq,
 	return -ENODEV;
 }
 
-static int uclass_find_device_by_of_offset(enum uclass_id id, int node,
-					   struct udevice **devp)
+int uclass_find_device_by_of_offset(enum uclass_id id, int node,
+				    struct udevice **devp)
 {
 	struct uclass *uc;
 	struct udevice *dev;
@@ -261,6 +479,10 @@ static int uclass_find_device_by_of_offset(enum uclass_id id, int node,
 	if (ret)
 		return ret;
 
+	if (uclass_indexed(uc)) {
+		*devp = uclass_index_find(uc, DM_INDEX_OF_OFFSET, node, NULL);
+		return *devp ? 0 : -ENODEV;
+	}
 	list_for_each_entry(dev, &uc->dev_head, uclass_node) {
 		if (dev->of_offset == node) {
 			*devp = dev;
@@ -367,6 +589,7 @@ int uclass_bind_device(struct udevice *dev)
 
 	uc = dev->uclass;
 	list_add_tail(&dev->uclass_node, &uc->dev_head);
+	uclass_index_bind(dev);
 
 	if (dev->parent) {
 		struct uclass_driver *uc_drv = dev->parent->uclass->uc_drv;
@@ -386,6 +609,7 @@ int uclass_bind_device(struct udevice *dev)
 	return 0;
 err:
 	/* There is no need to undo the parent's post_bind call */
+	uclass_index_unbind(dev);
 	list_del(&dev->uclass_node);
 
 	return ret;
@@ -404,6 +628,7 @@ int uclass_unbind_device(struct udevice *dev)
 			return ret;
 	}
 
+	uclass_index_unbind(dev);
 	list_del(&dev->uclass_node);
 	return 0;
 }
@@ -489,6 +714,7 @@ int uclass_pre_remove_device(struct udevice *dev)
 		free(dev->uclass_priv);
 		dev->uclass_priv = NULL;
 	}
+	uclass_index_del(dev, DM_INDEX_SEQ);
 	dev->seq = -1;
 
 	return 0;
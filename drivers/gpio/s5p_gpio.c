@@ -353,7 +353,7 @@ static int gpio_exynos_bind(struct udevice *parent)
 					plat->bank_name, plat, -1, &dev);
 		if (ret)
 			return ret;
-		dev->of_offset = node;
+		dev_set_of_offset(dev, node);
 	}
 
 	return 0;
@@ -585,6 +585,7 @@ int mmc_select_hwpart(int dev_num, int hwpart)
 		return ret;
 
 	mmc->part_num = hwpart;
+	part_dev_changed(&mmc->block_dev);
 
 	return 0;
 }
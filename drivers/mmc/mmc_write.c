@@ -75,6 +75,7 @@ unsigned long mmc_berase(int dev_num, lbaint_t start, lbaint_t blkcnt)
 
 	if (!mmc)
 		return -1;
+	part_dev_changed(&mmc->block_dev);
 
 	/*
 	 * We want to see if the requested start or total block count are
@@ -172,6 +173,7 @@ ulong mmc_bwrite(int dev_num, lbaint_t start, lbaint_t blkcnt, const void *src)
 	struct mmc *mmc = find_mmc_device(dev_num);
 	if (!mmc)
 		return 0;
+	part_dev_changed(&mmc->block_dev);
 
 	if (mmc_set_blocklen(mmc, mmc->write_bl_len))
 		return 0;
@@ -0,0 +1,485 @@
+/*
+ * Sandbox SDHCI controller emulation, with an SD card attached
+ *
+ * This models the registers of a generic SDHCI controller well enough for
+ * the sdhci driver to run its PIO, SDMA and ADMA2 paths against a small
+ * RAM-backed SDHC card.
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <errno.h>
+#include <malloc.h>
+#include <mmc.h>
+#include <sdhci.h>
+#include <asm/io.h>
+
+DECLARE_GLOBAL_DATA_PTR;
+
+#define SANDBOX_SDHCI_CARD_SIZE		(4 << 20)
+#define SANDBOX_SDHCI_BLOCK_LEN		512
+#define SANDBOX_SDHCI_REG_SIZE		0x100
+#define SANDBOX_SDHCI_RCA		0x1234
+#define SANDBOX_SDHCI_ADMA_LIMIT	4096	/* descriptors per transfer */
+
+/* Card status: ready for data, in the transfer state */
+#define SANDBOX_SDHCI_STATUS		(MMC_STATUS_RDY_FOR_DATA | (4 << 9))
+
+/* CID and CSD (version 2.0, 4MiB, 25MHz), most significant word first */
+static const u32 sandbox_sdhci_cid[4] = {
+	0x1d414453, 0x616e6462, 0x10000001, 0x0000f1ff,
+};
+
+static const u32 sandbox_sdhci_csd[4] = {
+	0x400e0032, 0x5b590000,
+	((SANDBOX_SDHCI_CARD_SIZE >> 19) - 1) << 16 | 0x7f80, 0x0a4000ff,
+};
+
+/* SCR: SD 1.0 with 1-bit and 4-bit bus widths, big endian */
+static const u8 sandbox_sdhci_scr[8] = {
+	0x00, 0x05, 0x00, 0x00,
+};
+
+struct sandbox_sdhci {
+	struct sdhci_host host;
+	u8 regs[SANDBOX_SDHCI_REG_SIZE];
+	u8 *card;		/* Card contents */
+	int app_cmd;		/* Last command was APP_CMD */
+
+	/* Data transfer in progress */
+	int xfer_active;
+	int xfer_read;		/* 1 if card to host */
+	int sdma_wait;		/* SDMA paused at a buffer boundary */
+	u8 *xfer_data;		/* Card side of the transfer */
+	uint xfer_len;		/* Total length */
+	uint xfer_pos;		/* Bytes done so far */
+	uint xfer_blksz;	/* Block size */
+};
+
+static struct sandbox_sdhci *to_sandbox(struct sdhci_host *host)
+{
+	return container_of(host, struct sandbox_sdhci, host);
+}
+
+static u32 reg_get(struct sandbox_sdhci *priv, int reg, int size)
+{
+	u32 val = 0;
+	int i;
+
+	for (i = size - 1; i >= 0; i--)
+		val = val << 8 | priv->regs[reg + i];
+
+	return val;
+}
+
+static void reg_set(struct sandbox_sdhci *priv, int reg, u32 val, int size)
+{
+	int i;
+
+	for (i = 0; i < size; i++, val >>= 8)
+		priv->regs[reg + i] = val;
+}
+
+static void set_int(struct sandbox_sdhci *priv, u32 mask)
+{
+	if (mask & SDHCI_INT_ERROR_MASK)
+		mask |= SDHCI_INT_ERROR;
+	reg_set(priv, SDHCI_INT_STATUS,
+		reg_get(priv, SDHCI_INT_STATUS, 4) | mask, 4);
+}
+
+static void xfer_done(struct sandbox_sdhci *priv)
+{
+	priv->xfer_active = 0;
+	priv->sdma_wait = 0;
+	set_int(priv, SDHCI_INT_DATA_END);
+}
+
+/* Copy between the card and sandbox RAM, as a DMA engine would */
+static int dma_copy(struct sandbox_sdhci *priv, ulong addr, uint len)
+{
+	u8 *ptr;
+
+	if ((u64)addr + len > gd->ram_size ||
+	    priv->xfer_pos + len > priv->xfer_len)
+		return -1;
+
+	ptr = map_sysmem(addr, len);
+	if (priv->xfer_read)
+		memcpy(ptr, priv->xfer_data + priv->xfer_pos, len);
+	else
+		memcpy(priv->xfer_data + priv->xfer_pos, ptr, len);
+	unmap_sysmem(ptr);
+	priv->xfer_pos += len;
+
+	return 0;
+}
+
+static void adma_error(struct sandbox_sdhci *priv, ulong addr)
+{
+	/* ST_FDS: stopped while fetching the descriptor at @addr */
+	reg_set(priv, SDHCI_ADMA_ERROR, 1, 1);
+	reg_set(priv, SDHCI_ADMA_ADDRESS, addr, 4);
+	priv->xfer_active = 0;
+	set_int(priv, SDHCI_INT_ADMA_ERROR);
+}
+
+static void run_adma(struct sandbox_sdhci *priv)
+{
+	struct sdhci_adma_desc *desc;
+	ulong addr = reg_get(priv, SDHCI_ADMA_ADDRESS, 4);
+	uint attr, len, i;
+	ulong data;
+
+	for (i = 0; i < SANDBOX_SDHCI_ADMA_LIMIT; i++) {
+		if (addr + sizeof(*desc) > gd->ram_size)
+			break;
+		desc = map_sysmem(addr, sizeof(*desc));
+		attr = le16_to_cpu(desc->attr);
+		len = le16_to_cpu(desc->len) ?: SDHCI_ADMA_MAX_LEN;
+		data = le32_to_cpu(desc->addr);
+		unmap_sysmem(desc);
+
+		if (!(attr & SDHCI_ADMA_VALID))
+			break;
+		switch (attr & SDHCI_ADMA_ACT_MASK) {
+		case SDHCI_ADMA_TRAN:
+			if (dma_copy(priv, data, len)) {
+				adma_error(priv, addr);
+				return;
+			}
+			break;
+		case SDHCI_ADMA_LINK:
+			addr = data;
+			continue;
+		}
+		if (attr & SDHCI_ADMA_END) {
+			if (priv->xfer_pos != priv->xfer_len)
+				break;
+			xfer_done(priv);
+			return;
+		}
+		addr += sizeof(*desc);
+	}
+
+	adma_error(priv, addr);
+}
+
+/* Run SDMA up to the next buffer boundary, or the end of the transfer */
+static void run_sdma(struct sandbox_sdhci *priv)
+{
+	ulong addr = reg_get(priv, SDHCI_DMA_ADDRESS, 4);
+	uint boundary = 4096 << (reg_get(priv, SDHCI_BLOCK_SIZE, 2) >> 12 & 7);
+	uint len;
+
+	len = min(priv->xfer_len - priv->xfer_pos,
+		  boundary - (uint)(addr & (boundary - 1)));
+	if (dma_copy(priv, addr, len)) {
+		priv->xfer_active = 0;
+		set_int(priv, SDHCI_INT_DATA_TIMEOUT);
+		return;
+	}
+	if (priv->xfer_pos == priv->xfer_len) {
+		xfer_done(priv);
+		return;
+	}
+
+	priv->sdma_wait = 1;
+	set_int(priv, SDHCI_INT_DMA_END);
+}
+
+static void start_xfer(struct sandbox_sdhci *priv, u8 *data, int read)
+{
+	uint mode = reg_get(priv, SDHCI_TRANSFER_MODE, 2);
+	uint blocks = 1;
+
+	priv->xfer_blksz = reg_get(priv, SDHCI_BLOCK_SIZE, 2) & 0xfff;
+	if (mode & SDHCI_TRNS_MULTI)
+		blocks = reg_get(priv, SDHCI_BLOCK_COUNT, 2);
+	priv->xfer_len = priv->xfer_blksz * blocks;
+	priv->xfer_pos = 0;
+	priv->xfer_read = read;
+	priv->xfer_data = data;
+	priv->xfer_active = 1;
+	priv->sdma_wait = 0;
+
+	if (!(mode & SDHCI_TRNS_DMA)) {
+		set_int(priv, read ? SDHCI_INT_DATA_AVAIL :
+			SDHCI_INT_SPACE_AVAIL);
+		return;
+	}
+
+	switch (reg_get(priv, SDHCI_HOST_CONTROL, 1) & SDHCI_CTRL_DMA_MASK) {
+	case SDHCI_CTRL_SDMA:
+		run_sdma(priv);
+		break;
+	case SDHCI_CTRL_ADMA32:
+		run_adma(priv);
+		break;
+	default:
+		adma_error(priv, 0);
+		break;
+	}
+}
+
+/* Move one 32-bit word through the buffer data port */
+static u32 pio_word(struct sandbox_sdhci *priv, u32 val)
+{
+	u8 *ptr;
+
+	if (!priv->xfer_active || priv->sdma_wait)
+		return 0;
+	ptr = priv->xfer_data + priv->xfer_pos;
+	if (priv->xfer_read)
+		memcpy(&val, ptr, sizeof(val));
+	else
+		memcpy(ptr, &val, sizeof(val));
+	priv->xfer_pos += sizeof(val);
+
+	if (priv->xfer_pos == priv->xfer_len)
+		xfer_done(priv);
+	else if (!(priv->xfer_pos % priv->xfer_blksz))
+		set_int(priv, priv->xfer_read ? SDHCI_INT_DATA_AVAIL :
+			SDHCI_INT_SPACE_AVAIL);
+
+	return val;
+}
+
+/* Put a response into the response registers, with the CRC stripped */
+static void set_response(struct sandbox_sdhci *priv, const u32 *resp,
+			 int long_resp)
+{
+	int i;
+
+	if (!long_resp) {
+		reg_set(priv, SDHCI_RESPONSE, resp[0], 4);
+		return;
+	}
+	for (i = 0; i < 4; i++) {
+		u32 val = resp[3 - i] >> 8;
+
+		if (i < 3)
+			val |= resp[2 - i] << 24;
+		reg_set(priv, SDHCI_RESPONSE + i * 4, val, 4);
+	}
+}
+
+static void exec_command(struct sandbox_sdhci *priv)
+{
+	uint command = reg_get(priv, SDHCI_COMMAND, 2);
+	uint arg = reg_get(priv, SDHCI_ARGUMENT, 4);
+	uint cmd = command >> 8;
+	uint blocks = 1;
+	u32 resp[4] = { SANDBOX_SDHCI_STATUS };
+	const u8 *data = NULL;
+	int app_cmd = priv->app_cmd;
+	int long_resp = 0;
+	int read = 1;
+
+	priv->app_cmd = 0;
+	if (reg_get(priv, SDHCI_TRANSFER_MODE, 2) & SDHCI_TRNS_MULTI)
+		blocks = reg_get(priv, SDHCI_BLOCK_COUNT, 2);
+
+	switch (cmd) {
+	case MMC_CMD_GO_IDLE_STATE:
+	case MMC_CMD_SELECT_CARD:
+	case MMC_CMD_SEND_STATUS:
+	case MMC_CMD_SET_BLOCKLEN:
+	case MMC_CMD_STOP_TRANSMISSION:
+		break;
+	case MMC_CMD_ALL_SEND_CID:
+		memcpy(resp, sandbox_sdhci_cid, sizeof(resp));
+		long_resp = 1;
+		break;
+	case SD_CMD_SEND_RELATIVE_ADDR:
+		resp[0] = SANDBOX_SDHCI_RCA << 16;
+		break;
+	case SD_CMD_SEND_IF_COND:
+		resp[0] = arg & 0xfff;
+		break;
+	case MMC_CMD_SEND_CSD:
+		memcpy(resp, sandbox_sdhci_csd, sizeof(resp));
+		long_resp = 1;
+		break;
+	case MMC_CMD_APP_CMD:
+		priv->app_cmd = 1;
+		resp[0] |= 1 << 5;
+		break;
+	case MMC_CMD_READ_SINGLE_BLOCK:
+	case MMC_CMD_READ_MULTIPLE_BLOCK:
+	case MMC_CMD_WRITE_SINGLE_BLOCK:
+	case MMC_CMD_WRITE_MULTIPLE_BLOCK:
+		if (((u64)arg + blocks) * SANDBOX_SDHCI_BLOCK_LEN >
+		    SANDBOX_SDHCI_CARD_SIZE)
+			goto err;
+		data = priv->card + arg * SANDBOX_SDHCI_BLOCK_LEN;
+		read = cmd == MMC_CMD_READ_SINGLE_BLOCK ||
+			cmd == MMC_CMD_READ_MULTIPLE_BLOCK;
+		break;
+	case SD_CMD_APP_SET_BUS_WIDTH:
+		if (!app_cmd)
+			goto err;
+		break;
+	case SD_CMD_APP_SEND_OP_COND:
+		if (!app_cmd)
+			goto err;
+		resp[0] = OCR_BUSY | OCR_HCS | 0xff8000;
+		break;
+	case SD_CMD_APP_SEND_SCR:
+		if (!app_cmd)
+			goto err;
+		data = sandbox_sdhci_scr;
+		break;
+	default:
+		goto err;
+	}
+
+	set_response(priv, resp, long_resp);
+	set_int(priv, SDHCI_INT_RESPONSE);
+	if (command & SDHCI_CMD_DATA) {
+		if (!data)
+			goto err;
+		start_xfer(priv, (u8 *)data, read);
+	} else if ((command & SDHCI_CMD_RESP_MASK) ==
+		   SDHCI_CMD_RESP_SHORT_BUSY) {
+		set_int(priv, SDHCI_INT_DATA_END);
+	}
+	return;
+err:
+	set_int(priv, SDHCI_INT_TIMEOUT);
+}
+
+static void soft_reset(struct sandbox_sdhci *priv, u8 mask)
+{
+	if (mask & (SDHCI_RESET_ALL | SDHCI_RESET_DATA)) {
+		priv->xfer_active = 0;
+		priv->sdma_wait = 0;
+	}
+	if (mask & SDHCI_RESET_ALL) {
+		memset(priv->regs, '\0', SDHCI_CAPABILITIES);
+		priv->app_cmd = 0;
+	}
+}
+
+static u32 sandbox_sdhci_read(struct sdhci_host *host, int reg, int size)
+{
+	struct sandbox_sdhci *priv = to_sandbox(host);
+	u32 state;
+
+	switch (reg) {
+	case SDHCI_BUFFER:
+		return priv->xfer_read ? pio_word(priv, 0) : 0;
+	case SDHCI_PRESENT_STATE:
+		state = SDHCI_CARD_PRESENT | SDHCI_CARD_STATE_STABLE |
+			SDHCI_CARD_DETECT_PIN_LEVEL;
+		if (priv->xfer_active && !priv->sdma_wait)
+			state |= priv->xfer_read ? SDHCI_DATA_AVAILABLE :
+				SDHCI_SPACE_AVAILABLE;
+		return state;
+	}
+
+	return reg_get(priv, reg, size);
+}
+
+static void sandbox_sdhci_write(struct sdhci_host *host, u32 val, int reg,
+				int size)
+{
+	struct sandbox_sdhci *priv = to_sandbox(host);
+
+	switch (reg) {
+	case SDHCI_BUFFER:
+		if (!priv->xfer_read)
+			pio_word(priv, val);
+		return;
+	case SDHCI_INT_STATUS:
+		/* Write 1 to clear */
+		reg_set(priv, reg, reg_get(priv, reg, size) & ~val, size);
+		if (!(reg_get(priv, reg, 4) & SDHCI_INT_ERROR_MASK))
+			reg_set(priv, reg, reg_get(priv, reg, 4) &
+				~SDHCI_INT_ERROR, 4);
+		return;
+	case SDHCI_SOFTWARE_RESET:
+		soft_reset(priv, val);
+		return;
+	case SDHCI_CLOCK_CONTROL:
+		if (val & SDHCI_CLOCK_INT_EN)
+			val |= SDHCI_CLOCK_INT_STABLE;
+		break;
+	case SDHCI_CAPABILITIES:
+	case SDHCI_HOST_VERSION:
+		return;
+	}
+
+	reg_set(priv, reg, val, size);
+	if (reg == SDHCI_COMMAND)
+		exec_command(priv);
+	else if (reg == SDHCI_DMA_ADDRESS && priv->sdma_wait)
+		run_sdma(priv);
+}
+
+static u32 sandbox_sdhci_read_l(struct sdhci_host *host, int reg)
+{
+	return sandbox_sdhci_read(host, reg, 4);
+}
+
+static u16 sandbox_sdhci_read_w(struct sdhci_host *host, int reg)
+{
+	return sandbox_sdhci_read(host, reg, 2);
+}
+
+static u8 sandbox_sdhci_read_b(struct sdhci_host *host, int reg)
+{
+	return sandbox_sdhci_read(host, reg, 1);
+}
+
+static void sandbox_sdhci_write_l(struct sdhci_host *host, u32 val, int reg)
+{
+	sandbox_sdhci_write(host, val, reg, 4);
+}
+
+static void sandbox_sdhci_write_w(struct sdhci_host *host, u16 val, int reg)
+{
+	sandbox_sdhci_write(host, val, reg, 2);
+}
+
+static void sandbox_sdhci_write_b(struct sdhci_host *host, u8 val, int reg)
+{
+	sandbox_sdhci_write(host, val, reg, 1);
+}
+
+static const struct sdhci_ops sandbox_sdhci_ops = {
+	.read_l		= sandbox_sdhci_read_l,
+	.read_w		= sandbox_sdhci_read_w,
+	.read_b		= sandbox_sdhci_read_b,
+	.write_l	= sandbox_sdhci_write_l,
+	.write_w	= sandbox_sdhci_write_w,
+	.write_b	= sandbox_sdhci_write_b,
+};
+
+int sandbox_sdhci_init(void)
+{
+	struct sandbox_sdhci *priv;
+	struct sdhci_host *host;
+
+	priv = calloc(1, sizeof(*priv));
+	if (!priv)
+		return -ENOMEM;
+	priv->card = calloc(1, SANDBOX_SDHCI_CARD_SIZE);
+	if (!priv->card) {
+		free(priv);
+		return -ENOMEM;
+	}
+
+	/* 50MHz base clock, 3.3V, SDMA and ADMA2 */
+	reg_set(priv, SDHCI_CAPABILITIES, 50 << SDHCI_CLOCK_BASE_SHIFT |
+		SDHCI_CAN_VDD_330 | SDHCI_CAN_DO_SDMA | SDHCI_CAN_DO_ADMA2, 4);
+	reg_set(priv, SDHCI_HOST_VERSION, SDHCI_SPEC_300, 2);
+
+	host = &priv->host;
+	host->name = "sandbox_sdhci";
+	host->ops = &sandbox_sdhci_ops;
+	host->version = sdhci_readw(host, SDHCI_HOST_VERSION);
+
+	return add_sdhci(host, 0, 0);
+}
@@ -9,6 +9,7 @@
  */
 
 #include <common.h>
+#include <errno.h>
 #include <malloc.h>
 #include <mmc.h>
 #include <sdhci.h>
@@ -67,18 +68,15 @@ static void sdhci_transfer_pio(struct sdhci_host *host, struct mmc_data *data)
 	}
 }
 
+/* Maximum time for a data transfer to complete, in ms */
+#define SDHCI_DATA_TIMEOUT	10000
+
 static int sdhci_transfer_data(struct sdhci_host *host, struct mmc_data *data,
 				unsigned int start_addr)
 {
-	unsigned int stat, rdy, mask, timeout, block = 0;
-#ifdef CONFIG_MMC_SDMA
-	unsigned char ctrl;
-	ctrl = sdhci_readb(host, SDHCI_HOST_CONTROL);
-	ctrl &= ~SDHCI_CTRL_DMA_MASK;
-	sdhci_writeb(host, ctrl, SDHCI_HOST_CONTROL);
-#endif
+	unsigned int stat, rdy, mask, block = 0;
+	ulong start = get_timer(0);
 
-	timeout = 1000000;
 	rdy = SDHCI_INT_SPACE_AVAIL | SDHCI_INT_DATA_AVAIL;
 	mask = SDHCI_DATA_AVAILABLE | SDHCI_SPACE_AVAILABLE;
 	do {
@@ -86,6 +84,11 @@ static int sdhci_transfer_data(struct sdhci_host *host, struct mmc_data *data,
 		if (stat & SDHCI_INT_ERROR) {
 			printf("%s: Error detected in status(0x%X)!\n",
 			       __func__, stat);
+			if (stat & SDHCI_INT_ADMA_ERROR)
+				printf("%s: ADMA error 0x%x at 0x%08x\n",
+				       __func__,
+				       sdhci_readb(host, SDHCI_ADMA_ERROR),
+				       sdhci_readl(host, SDHCI_ADMA_ADDRESS));
 			return -1;
 		}
 		if (stat & rdy) {
@@ -105,9 +108,7 @@ static int sdhci_transfer_data(struct sdhci_host *host, struct mmc_data *data,
 			sdhci_writel(host, start_addr, SDHCI_DMA_ADDRESS);
 		}
 #endif
-		if (timeout-- > 0)
-			udelay(10);
-		else {
+		if (get_timer(start) > SDHCI_DATA_TIMEOUT) {
 			printf("%s: Transfer data timeout\n", __func__);
 			return -1;
 		}
@@ -115,6 +116,82 @@ static int sdhci_transfer_data(struct sdhci_host *host, struct mmc_data *data,
 	return 0;
 }
 
+#if defined(CONFIG_MMC_SDMA) || defined(CONFIG_MMC_SDHCI_ADMA)
+static void sdhci_set_dma_select(struct sdhci_host *host, u8 dma)
+{
+	u8 ctrl;
+
+	ctrl = sdhci_readb(host, SDHCI_HOST_CONTROL);
+	ctrl &= ~SDHCI_CTRL_DMA_MASK;
+	ctrl |= dma;
+	sdhci_writeb(host, ctrl, SDHCI_HOST_CONTROL);
+}
+#endif
+
+#ifdef CONFIG_MMC_SDHCI_ADMA
+/*
+ * Describe the whole of @data in the ADMA2 descriptor table, so that the
+ * controller moves it without any help from the CPU. ADMA2 needs a 32-bit
+ * aligned buffer below 4GiB; anything else is refused so that the caller can
+ * fall back to another transfer mode.
+ */
+static int sdhci_adma_setup(struct sdhci_host *host, struct mmc_data *data)
+{
+	struct sdhci_adma_desc *desc = host->adma_desc;
+	void *buf;
+	ulong addr, len, size;
+	uint count;
+
+	if (!desc || (host->quirks & SDHCI_QUIRK_BROKEN_ADMA))
+		return -EINVAL;
+
+	if (data->flags == MMC_DATA_READ)
+		buf = data->dest;
+	else
+		buf = (void *)data->src;
+	addr = virt_to_phys(buf);
+	len = data->blocks * data->blocksize;
+	count = DIV_ROUND_UP(len, SDHCI_ADMA_MAX_LEN);
+	if ((addr & 3) || upper_32_bits((u64)addr) ||
+	    upper_32_bits((u64)addr + len - 1) ||
+	    count > host->adma_desc_count)
+		return -EINVAL;
+
+	for (; len; desc++) {
+		size = min(len, (ulong)SDHCI_ADMA_MAX_LEN);
+		desc->attr = cpu_to_le16(SDHCI_ADMA_TRAN | SDHCI_ADMA_VALID);
+		desc->len = cpu_to_le16(size & 0xffff);
+		desc->addr = cpu_to_le32(addr);
+		addr += size;
+		len -= size;
+	}
+	desc[-1].attr |= cpu_to_le16(SDHCI_ADMA_END);
+
+	flush_cache((ulong)host->adma_desc,
+		    ALIGN(count * sizeof(*desc), ARCH_DMA_MINALIGN));
+	flush_cache((ulong)buf, data->blocks * data->blocksize);
+	sdhci_writel(host, virt_to_phys(host->adma_desc), SDHCI_ADMA_ADDRESS);
+
+	return 0;
+}
+#endif
+
+static void sdhci_update_stats(struct sdhci_host *host, uint bytes, ulong us,
+			       int adma)
+{
+	struct sdhci_stats *stats = &host->stats;
+
+	stats->xfers++;
+	if (adma)
+		stats->adma_xfers++;
+	stats->bytes += bytes;
+	stats->us += us;
+	stats->last_bytes = bytes;
+	stats->last_us = us;
+	debug("%s: %s %u bytes in %lu us\n", host->name,
+	      adma ? "ADMA" : "PIO", bytes, us);
+}
+
 /*
  * No command will be sent by driver if card is busy, so driver must wait
  * for card ready state.
@@ -134,8 +211,9 @@ static int sdhci_send_command(struct mmc *mmc, struct mmc_cmd *cmd,
 	struct sdhci_host *host = mmc->priv;
 	unsigned int stat = 0;
 	int ret = 0;
-	int trans_bytes = 0, is_aligned = 1;
+	int trans_bytes = 0, is_aligned = 1, use_adma = 0;
 	u32 mask, flags, mode;
+	ulong xfer_start = 0;
 	unsigned int time = 0, start_addr = 0;
 	int mmc_dev = mmc->block_dev.dev;
 	unsigned start = get_timer(0);
@@ -196,32 +274,44 @@ static int sdhci_send_command(struct mmc *mmc, struct mmc_cmd *cmd,
 		if (data->flags == MMC_DATA_READ)
 			mode |= SDHCI_TRNS_READ;
 
+#ifdef CONFIG_MMC_SDHCI_ADMA
+		use_adma = !sdhci_adma_setup(host, data);
+		if (use_adma) {
+			sdhci_set_dma_select(host, SDHCI_CTRL_ADMA32);
+			mode |= SDHCI_TRNS_DMA;
+		}
+#endif
 #ifdef CONFIG_MMC_SDMA
-		if (data->flags == MMC_DATA_READ)
-			start_addr = (unsigned long)data->dest;
-		else
-			start_addr = (unsigned long)data->src;
-		if ((host->quirks & SDHCI_QUIRK_32BIT_DMA_ADDR) &&
-				(start_addr & 0x7) != 0x0) {
+		if (!use_adma) {
+			sdhci_set_dma_select(host, SDHCI_CTRL_SDMA);
+			if (data->flags == MMC_DATA_READ)
+				start_addr = (unsigned long)data->dest;
+			else
+				start_addr = (unsigned long)data->src;
+			if ((host->quirks & SDHCI_QUIRK_32BIT_DMA_ADDR) &&
+					(start_addr & 0x7) != 0x0) {
+				is_aligned = 0;
+				start_addr = (unsigned long)aligned_buffer;
+				if (data->flags != MMC_DATA_READ)
+					memcpy(aligned_buffer, data->src,
+					       trans_bytes);
+			}
+
+#if defined(CONFIG_FIXED_SDHCI_ALIGNED_BUFFER)
+			/*
+			 * Always use this bounce-buffer when
+			 * CONFIG_FIXED_SDHCI_ALIGNED_BUFFER is defined
+			 */
 			is_aligned = 0;
 			start_addr = (unsigned long)aligned_buffer;
 			if (data->flags != MMC_DATA_READ)
 				memcpy(aligned_buffer, data->src, trans_bytes);
-		}
-
-#if defined(CONFIG_FIXED_SDHCI_ALIGNED_BUFFER)
-		/*
-		 * Always use this bounce-buffer when
-		 * CONFIG_FIXED_SDHCI_ALIGNED_BUFFER is defined
-		 */
-		is_aligned = 0;
-		start_addr = (unsigned long)aligned_buffer;
-		if (data->flags != MMC_DATA_READ)
-			memcpy(aligned_buffer, data->src, trans_bytes);
 #endif
 
-		sdhci_writel(host, start_addr, SDHCI_DMA_ADDRESS);
-		mode |= SDHCI_TRNS_DMA;
+			sdhci_writel(host, start_addr, SDHCI_DMA_ADDRESS);
+			mode |= SDHCI_TRNS_DMA;
+			flush_cache(start_addr, trans_bytes);
+		}
 #endif
 		sdhci_writew(host, SDHCI_MAKE_BLKSZ(SDHCI_DEFAULT_BOUNDARY_ARG,
 				data->blocksize),
@@ -233,9 +323,8 @@ static int sdhci_send_command(struct mmc *mmc, struct mmc_cmd *cmd,
 	}
 
 	sdhci_writel(host, cmd->cmdarg, SDHCI_ARGUMENT);
-#ifdef CONFIG_MMC_SDMA
-	flush_cache(start_addr, trans_bytes);
-#endif
+	if (data)
+		xfer_start = timer_get_us();
 	sdhci_writew(host, SDHCI_MAKE_CMD(cmd->cmdidx, flags), SDHCI_COMMAND);
 	start = get_timer(0);
 	do {
@@ -260,8 +349,13 @@ static int sdhci_send_command(struct mmc *mmc, struct mmc_cmd *cmd,
 	} else
 		ret = -1;
 
-	if (!ret && data)
+	if (!ret && data) {
 		ret = sdhci_transfer_data(host, data, start_addr);
+		if (!ret)
+			sdhci_update_stats(host, trans_bytes,
+					   timer_get_us() - xfer_start,
+					   use_adma);
+	}
 
 	if (host->quirks & SDHCI_QUIRK_WAIT_SEND_CMD)
 		udelay(1000);
@@ -533,6 +627,21 @@ int add_sdhci(struct sdhci_host *host, u32 max_clk, u32 min_clk)
 
 	host->cfg.b_max = CONFIG_SYS_MMC_MAX_BLK_COUNT;
 
+#ifdef CONFIG_MMC_SDHCI_ADMA
+	if ((caps & SDHCI_CAN_DO_ADMA2) &&
+	    !(host->quirks & SDHCI_QUIRK_BROKEN_ADMA)) {
+		host->adma_desc_count = DIV_ROUND_UP(host->cfg.b_max *
+				MMC_MAX_BLOCK_LEN, SDHCI_ADMA_MAX_LEN);
+		host->adma_desc = memalign(ARCH_DMA_MINALIGN,
+				ALIGN(host->adma_desc_count *
+				      sizeof(struct sdhci_adma_desc),
+				      ARCH_DMA_MINALIGN));
+		if (!host->adma_desc)
+			printf("%s: ADMA table alloc failed, using PIO\n",
+			       __func__);
+	}
+#endif
+
 	sdhci_reset(host, SDHCI_RESET_ALL);
 
 	host->mmc = mmc_create(&host->cfg, host);
@@ -20,6 +20,7 @@
 #include <asm/getopt.h>
 #include <asm/spi.h>
 #include <asm/state.h>
+#include <asm/test.h>
 #include <dm/device-internal.h>
 #include <dm/lists.h>
 #include <dm/uclass-internal.h>
@@ -64,6 +65,37 @@ static const char *sandbox_sf_state_name(enum sandbox_sf_state state)
 /* Used to quickly bulk erase backing store */
 static u8 sandbox_sf_0xff[0x1000];
 
+/*
+ * Typical times taken by a real chip, in microseconds, and the time to
+ * clock in a byte at 50MHz, in nanoseconds
+ */
+#define SF_TIME_ERASE_4K	45000
+#define SF_TIME_ERASE_32K	120000
+#define SF_TIME_ERASE_64K	150000
+#define SF_TIME_ERASE_CHIP_64K	100000	/* per 64KB */
+#define SF_TIME_PROGRAM		700
+#define SF_TIME_BYTE_NS		160
+
+static struct sandbox_sf_stats sandbox_sf_stats;
+static ulong sandbox_sf_busy_ns;	/* not yet added to the timer */
+
+void sandbox_sf_get_stats(struct sandbox_sf_stats *stats, bool reset)
+{
+	*stats = sandbox_sf_stats;
+	if (reset)
+		memset(&sandbox_sf_stats, '\0', sizeof(sandbox_sf_stats));
+}
+
+/* Let time pass as the chip would take, in whole milliseconds */
+static void sandbox_sf_busy(ulong ns)
+{
+	sandbox_sf_busy_ns += ns;
+	if (sandbox_sf_busy_ns >= 1000000) {
+		sandbox_timer_add_offset(sandbox_sf_busy_ns / 1000000);
+		sandbox_sf_busy_ns %= 1000000;
+	}
+}
+
 /* Internal state data for each SPI flash */
 struct sandbox_spi_flash {
 	unsigned int cs;	/* Chip select we are attached to */
@@ -289,13 +321,14 @@ static int sandbox_sf_process_cmd(struct sandbox_spi_flash *sbsf, const u8 *rx,
 		if (sbsf->cmd == CMD_ERASE_CHIP) {
 			sbsf->erase_size = sbsf->data->sector_size *
 				sbsf->data->nr_sectors;
+			sbsf->state = SF_ERASE;
+			break;
 		} else if (sbsf->cmd == CMD_ERASE_4K && (flags & SECT_4K)) {
 			sbsf->erase_size = 4 << 10;
 		} else if (sbsf->cmd == CMD_ERASE_32K && (flags & SECT_32K)) {
 			sbsf->erase_size = 32 << 10;
-		} else if (sbsf->cmd == CMD_ERASE_64K &&
-			   !(flags & (SECT_4K | SECT_32K))) {
-			sbsf->erase_size = 64 << 10;
+		} else if (sbsf->cmd == CMD_ERASE_64K) {
+			sbsf->erase_size = sbsf->data->sector_size;
 		} else {
 			debug(" cmd unknown: %#x\n", sbsf->cmd);
 			return -EIO;
@@ -328,6 +361,57 @@ int sandbox_erase_part(struct sandbox_spi_flash *sbsf, int size)
 	return 0;
 }
 
+static void sandbox_sf_erase(struct sandbox_spi_flash *sbsf)
+{
+	int ret;
+
+	if (!(sbsf->status & STAT_WEL)) {
+		puts("sandbox_sf: write enable not set before erase\n");
+		return;
+	}
+
+	/* verify address is aligned */
+	if (sbsf->off & (sbsf->erase_size - 1)) {
+		debug(" sector erase: cmd:%#x needs align:%#x, but we got %#x\n",
+		      sbsf->cmd, sbsf->erase_size, sbsf->off);
+		sbsf->status &= ~STAT_WEL;
+		return;
+	}
+
+	debug(" sector erase addr: %u, size: %u\n", sbsf->off,
+	      sbsf->erase_size);
+
+	/*
+	 * The erase is done at once, but the timer moves on as far as it
+	 * would while a real chip has WIP set
+	 */
+	ret = sandbox_erase_part(sbsf, sbsf->erase_size);
+	sbsf->status &= ~STAT_WEL;
+	if (ret) {
+		debug("sandbox_sf: Erase failed\n");
+		return;
+	}
+	switch (sbsf->cmd) {
+	case CMD_ERASE_4K:
+		sandbox_sf_stats.erase_4k++;
+		sandbox_sf_busy(SF_TIME_ERASE_4K * 1000UL);
+		break;
+	case CMD_ERASE_32K:
+		sandbox_sf_stats.erase_32k++;
+		sandbox_sf_busy(SF_TIME_ERASE_32K * 1000UL);
+		break;
+	case CMD_ERASE_64K:
+		sandbox_sf_stats.erase_64k++;
+		sandbox_sf_busy(SF_TIME_ERASE_64K * 1000UL);
+		break;
+	case CMD_ERASE_CHIP:
+		sandbox_sf_stats.erase_chip++;
+		sandbox_sf_busy((sbsf->erase_size >> 16) *
+				SF_TIME_ERASE_CHIP_64K * 1000UL);
+		break;
+	}
+}
+
 static int sandbox_sf_xfer(struct udevice *dev, unsigned int bitlen,
 			   const void *rxp, void *txp, unsigned long flags)
 {
@@ -350,6 +434,15 @@ static int sandbox_sf_xfer(struct udevice *dev, unsigned int bitlen,
 		if (ret)
 			return ret;
 		++pos;
+
+		/* A chip erase has no address */
+		if (sbsf->cmd == CMD_ERASE_CHIP) {
+			if (os_lseek(sbsf->fd, 0, OS_SEEK_SET) < 0) {
+				puts("sandbox_sf: os_lseek() failed");
+				return -EIO;
+			}
+			sandbox_sf_erase(sbsf);
+		}
 	}
 
 	/* Process the remaining data */
@@ -424,6 +517,7 @@ static int sandbox_sf_xfer(struct udevice *dev, unsigned int bitlen,
 				return -EIO;
 			}
 			pos += ret;
+			sandbox_sf_busy(ret * SF_TIME_BYTE_NS);
 			break;
 		case SF_READ_STATUS:
 			debug(" read status: %#x\n", sbsf->status);
@@ -464,43 +558,17 @@ static int sandbox_sf_xfer(struct udevice *dev, unsigned int bitlen,
 			}
 			pos += ret;
 			sbsf->status &= ~STAT_WEL;
+			sandbox_sf_stats.programs++;
+			sandbox_sf_busy(SF_TIME_PROGRAM * 1000UL);
 			break;
 		case SF_ERASE:
- case_sf_erase: {
-			if (!(sbsf->status & STAT_WEL)) {
-				puts("sandbox_sf: write enable not set before erase\n");
-				goto done;
-			}
-
-			/* verify address is aligned */
-			if (sbsf->off & (sbsf->erase_size - 1)) {
-				debug(" sector erase: cmd:%#x needs align:%#x, but we got %#x\n",
-				      sbsf->cmd, sbsf->erase_size,
-				      sbsf->off);
-				sbsf->status &= ~STAT_WEL;
-				goto done;
-			}
-
-			debug(" sector erase addr: %u, size: %u\n", sbsf->off,
-			      sbsf->erase_size);
-
+ case_sf_erase:
 			cnt = bytes - pos;
 			if (tx)
 				sandbox_spi_tristate(&tx[pos], cnt);
 			pos += cnt;
-
-			/*
-			 * TODO(vapier@gentoo.org): latch WIP in status, and
-			 * delay before clearing it ?
-			 */
-			ret = sandbox_erase_part(sbsf, sbsf->erase_size);
-			sbsf->status &= ~STAT_WEL;
-			if (ret) {
-				debug("sandbox_sf: Erase failed\n");
-				goto done;
-			}
+			sandbox_sf_erase(sbsf);
 			goto done;
-		}
 		default:
 			debug(" ??? no idea what to do ???\n");
 			goto done;
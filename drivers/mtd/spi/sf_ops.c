@@ -275,10 +275,19 @@ int spi_flash_cmd_erase_ops(struct spi_flash *flash, u32 offset, size_t len)
 		return -1;
 	}
 
-	cmd[0] = flash->erase_cmd;
 	while (len) {
 		erase_addr = offset;
 
+		/* Use the largest erase command which fits */
+		if (flash->block_size > flash->erase_size &&
+		    !(offset % flash->block_size) && len >= flash->block_size) {
+			cmd[0] = CMD_ERASE_64K;
+			erase_size = flash->block_size;
+		} else {
+			cmd[0] = flash->erase_cmd;
+			erase_size = flash->erase_size;
+		}
+
 #ifdef CONFIG_SF_DUAL_FLASH
 		if (flash->dual_flash > SF_SINGLE_FLASH)
 			spi_flash_dual_flash(flash, &erase_addr);
@@ -187,6 +187,9 @@ static int spi_flash_validate_params(struct spi_slave *spi, u8 *idcode,
 		flash->erase_size = flash->sector_size;
 	}
 
+	/* All of them support CMD_ERASE_64K too, see spi_flash_params */
+	flash->block_size = params->sector_size << flash->shift;
+
 	/* Now erase size becomes valid sector size */
 	flash->sector_size = flash->erase_size;
 
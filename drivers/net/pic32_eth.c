@@ -6,6 +6,7 @@
  */
 
 #include <common.h>
+#include <errno.h>
 #include <malloc.h>
 #include <miiphy.h>
 #include <phy.h>
@@ -16,18 +17,22 @@
 /* local definitions */
 #define MAX_RX_BUF_SIZE		1536
 #define MAX_RX_DESCR		CONFIG_SYS_RX_ETH_BUFFER
-#define MAX_TX_DESCR		2
+#define MAX_TX_BUF_SIZE		PKTSIZE_ALIGN
+#define MAX_TX_DESCR		16
+/* allow VLAN tagged frame; each frame must fit in one RX buffer */
+#define MAX_RX_FRAME_SIZE	MAX_RX_BUF_SIZE
 
 struct pic32eth_device {
 	struct eth_device netdev;
-	struct eth_dma_desc rxd_ring[MAX_RX_DESCR];
-	struct eth_dma_desc txd_ring[MAX_TX_DESCR];
+	struct pic32_eth_ring rxring;
+	struct pic32_eth_ring txring;
+	void *rx_bufs[MAX_RX_DESCR];
+	void *tx_bufs[MAX_TX_DESCR];
 	struct pic32_ectl_regs *ectl;
 	struct pic32_emac_regs *emac;
 	struct phy_device *phydev;
 	phy_interface_t phyif;
 	u32 phy_id; /* PHY addr */
-	u32 rxd_idx; /* index of RX desc to read */
 };
 
 __attribute__ ((weak)) void board_netphy_reset(void)
@@ -166,8 +171,8 @@ static void mac_init(struct eth_device *netdev)
 	/* recommended collision window retry limit is 0x370F */
 	writel(0x370f, &emac->clrt.raw);
 
-	/* set maximum frame length: allow VLAN tagged frame */
-	writel(0x600, &emac->maxf.raw);
+	/* set maximum frame length */
+	writel(MAX_RX_FRAME_SIZE, &emac->maxf.raw);
 
 	/* set the mac address */
 	writel(netdev->enetaddr[0]|(netdev->enetaddr[1] << 8), &emac->sa2.raw);
@@ -251,41 +256,41 @@ static void eth_ctrl_reset(struct pic32eth_device *pedev)
 	writel(ETHCON1_ON, &eth->con1.set);
 }
 
-static void eth_desc_init(struct pic32eth_device *pedev)
+static ulong pic32eth_to_phys(void *addr)
+{
+	return __virt_to_phys(addr);
+}
+
+static int eth_desc_init(struct pic32eth_device *pedev)
 {
 	u32 idx, bufsz;
-	struct eth_dma_desc *rxd;
 	struct pic32_ectl_regs *eth = pedev->ectl;
+	int ret;
 
-	pedev->rxd_idx = 0;
-	for (idx = 0; idx < MAX_RX_DESCR; idx++) {
-		rxd = &pedev->rxd_ring[idx];
-
-		/* hw owned */
-		rxd->hdr = EDH_NPV|EDH_EOWN|EDH_STICKY;
+	/* rings from a previous init may still be there */
+	pic32_eth_ring_free(&pedev->rxring);
+	pic32_eth_ring_free(&pedev->txring);
 
-		/* packet buffer address */
-		rxd->data_buff = __virt_to_phys(net_rx_packets[idx]);
-
-		/* link to next desc */
-		rxd->next_ed = __virt_to_phys(rxd + 1);
-
-		/* reset status */
-		rxd->stat1 = 0;
-		rxd->stat2 = 0;
+	for (idx = 0; idx < MAX_RX_DESCR; idx++) {
+		pedev->rx_bufs[idx] = net_rx_packets[idx];
 
 		/* decrement bufcnt */
 		writel(ETHCON1_BUFCDEC, &eth->con1.set);
 	}
 
-	/* link last descr to beginning of list */
-	rxd->next_ed = __virt_to_phys(&pedev->rxd_ring[0]);
-
-	/* flush rx ring */
-	__dcache_flush(pedev->rxd_ring, sizeof(pedev->rxd_ring));
+	ret = pic32_eth_ring_init(&pedev->rxring, MAX_RX_DESCR, pedev->rx_bufs,
+				  MAX_RX_BUF_SIZE, pic32eth_to_phys, true);
+	if (!ret)
+		ret = pic32_eth_ring_init(&pedev->txring, MAX_TX_DESCR,
+					  pedev->tx_bufs, MAX_TX_BUF_SIZE,
+					  pic32eth_to_phys, false);
+	if (ret) {
+		printf("%s: %s: Error, out of memory\n", __FILE__, __func__);
+		return ret;
+	}
 
 	/* set rx desc-ring start address */
-	writel((ulong)__virt_to_phys(&pedev->rxd_ring[0]), &eth->rxst.raw);
+	writel(pic32_eth_ring_phys(&pedev->rxring, 0), &eth->rxst.raw);
 
 	/* RX Buffer size */
 	bufsz = readl(&eth->con2.raw);
@@ -298,6 +303,31 @@ static void eth_desc_init(struct pic32eth_device *pedev)
 	 * to DMA received pkts to the descriptor pointer address.
 	 */
 	writel(ETHCON1_RXEN, &eth->con1.set);
+
+	return 0;
+}
+
+/*
+ * The TX DMA stops at the first descriptor it does not own. If it has
+ * stopped with frames still queued, restart it at the oldest one.
+ */
+static void pic32eth_tx_kick(struct pic32eth_device *pedev)
+{
+	struct pic32_ectl_regs *eth = pedev->ectl;
+	int idx;
+
+	if (readl(&eth->con1.raw) & ETHCON1_TXRTS)
+		return;
+
+	idx = pic32_eth_tx_reap(&pedev->txring);
+	if (idx < 0)
+		return;
+
+	/* pass descriptor table base to h/w */
+	writel(pic32_eth_ring_phys(&pedev->txring, idx), &eth->txst.raw);
+
+	/* ready to send enabled, hardware can now send the packet(s) */
+	writel(ETHCON1_TXRTS|ETHCON1_ON, &eth->con1.set);
 }
 
 static void pic32eth_halt(struct eth_device *netdev)
@@ -305,6 +335,15 @@ static void pic32eth_halt(struct eth_device *netdev)
 	struct pic32eth_device *pedev = netdev->priv;
 	struct pic32_ectl_regs *eth = pedev->ectl;
 	struct pic32_emac_regs *emac = pedev->emac;
+	u64 deadline;
+
+	/* let the frames still queued go out */
+	deadline = get_ticks() + get_tbclk();
+	while (pedev->txring.slot && get_ticks() < deadline) {
+		pic32eth_tx_kick(pedev);
+		if (pic32_eth_tx_reap(&pedev->txring) < 0)
+			break;
+	}
 
 	/* Reset the phy if the controller is enabled */
 	if (readl(&eth->con1.raw) & ETHCON1_ON)
@@ -355,8 +394,9 @@ static int pic32eth_init(struct eth_device *netdev, bd_t *bis)
 	/* initialize MAC */
 	mac_init(netdev);
 
-	/* init RX descriptor; TX descriptor is taken care in xmit */
-	eth_desc_init(pedev);
+	/* init RX and TX descriptor rings */
+	if (eth_desc_init(pedev))
+		return -1;
 
 	/* Start up & update link status of PHY */
 	phy_startup(pedev->phydev);
@@ -374,131 +414,82 @@ static int pic32eth_init(struct eth_device *netdev, bd_t *bis)
 static int pic32eth_xmit(struct eth_device *netdev, void *packet, int length)
 {
 	u64 deadline;
-	struct eth_dma_desc *txd;
+	void *buf;
 	struct pic32eth_device *pedev = netdev->priv;
-	struct pic32_ectl_regs *eth = pedev->ectl;
-
-	txd = &pedev->txd_ring[0];
-
-	/* set proper flags & length in descriptor header */
-	txd->hdr = EDH_SOP|EDH_EOP|EDH_EOWN|EDH_BCOUNT(length);
-
-	/* pass buffer address to hardware */
-	txd->data_buff = __virt_to_phys(packet);
-
-	cond_debug("%s: %d / .hdr %x, .data_buff %x, .stat %x, .nexted %x\n",
-		   __func__, __LINE__, txd->hdr, txd->data_buff, txd->stat2,
-		   txd->next_ed);
-
-	/* cache flush (packet) */
-	__dcache_flush(packet, length);
-
-	/* cache flush (txd) */
-	__dcache_flush(txd, sizeof(*txd));
 
-	/* pass descriptor table base to h/w */
-	writel(__virt_to_phys(txd), &eth->txst.raw);
+	if (length > MAX_TX_BUF_SIZE)
+		return -EINVAL;
 
-	/* ready to send enabled, hardware can now send the packet(s) */
-	writel(ETHCON1_TXRTS|ETHCON1_ON, &eth->con1.set);
+	/* the ring only fills up if frames are queued faster than sent */
+	deadline = get_ticks() + get_tbclk();
+	while (!(buf = pic32_eth_tx_buf(&pedev->txring))) {
+		pic32eth_tx_kick(pedev);
+		if (get_ticks() > deadline || ctrlc())
+			return -ETIMEDOUT;
+	}
 
-	/* wait untill tx has completed and h/w has released ownership
-	 * of the tx descriptor or timeout elapsed.
+	/*
+	 * The caller reuses the packet buffer as soon as we return, so send
+	 * from our own buffer and do not wait for completion.
 	 */
-	deadline = get_ticks() + get_tbclk();
-	for (;;) {
-		/* check timeout */
-		if (get_ticks() > deadline)
-			break;
+	memcpy(buf, packet, length);
+	pic32_eth_tx_queue(&pedev->txring, length);
 
-		/* tx completed? */
-		if (readl(&eth->con1.raw) & ETHCON1_TXRTS)
-			continue;
+	cond_debug("%s: %d / queued %d bytes, %d pending\n", __func__,
+		   __LINE__, length, pedev->txring.pending);
 
-		/* h/w not released ownership yet? */
-		__dcache_invalidate(txd, sizeof(*txd));
-		if (!(txd->hdr & EDH_EOWN))
-			break;
-
-		if (ctrlc())
-			break;
-	}
+	pic32eth_tx_kick(pedev);
 
 	return 0;
 }
 
-static int pic32eth_rx_poll(struct eth_device *netdev)
+/* give RX descriptors back to h/w, decrementing rx pkt count for each */
+static void pic32eth_rx_return(struct pic32eth_device *pedev)
 {
-	int idx, top;
-	u32 rx_stat;
-	int rx_count, bytes_rcvd = 0;
-	struct eth_dma_desc *rxd;
-	struct pic32eth_device *pedev = netdev->priv;
 	struct pic32_ectl_regs *eth = pedev->ectl;
+	uint frames;
 
-	top = (pedev->rxd_idx + MAX_RX_DESCR - 1) % MAX_RX_DESCR;
-
-	/* non-blocking receive loop - receive until nothing left to receive */
-	for (idx = pedev->rxd_idx; idx != top; idx = (idx + 1) % MAX_RX_DESCR) {
-		rxd = &pedev->rxd_ring[idx];
-
-		/* check ownership */
-		__dcache_invalidate(rxd, sizeof(*rxd));
-		if (rxd->hdr & EDH_EOWN)
-			break;
-
-		if (rxd->hdr & EDH_SOP) {
-			if (!(rxd->hdr & EDH_EOP)) {
-				printf("%s: %s, rx pkt across multiple descr\n",
-				       __FILE__, __func__);
-				goto refill_one;
-			}
-
-			rx_stat = rxd->stat2;
-			rx_count = RSV_RX_COUNT(rx_stat);
-
-			cond_debug("%s: %d /rx-idx %i, .hdr=%x, .data_buff %x, .stat %x, .nexted %x\n",
-				   __func__, __LINE__, idx, rxd->hdr,
-				   rxd->data_buff, rxd->stat2, rxd->next_ed);
-
-			/* we can do some basic checks */
-			if ((!RSV_RX_OK(rx_stat)) || RSV_CRC_ERR(rx_stat)) {
-				printf("%s: %s: Error, rx problem detected\n",
-				       __FILE__, __func__);
-				goto refill_one;
-			}
-
-			/* invalidate dcache */
-			__dcache_invalidate(net_rx_packets[idx], rx_count);
-
-			/* Pass the packet to protocol layer */
-			net_process_received_packet(net_rx_packets[idx],
-						    rx_count - 4);
+	frames = pic32_eth_rx_return(&pedev->rxring);
+	while (frames--)
+		writel(ETHCON1_BUFCDEC, &eth->con1.set);
+}
 
-			/* increment number of bytes rcvd (ignore CRC) */
-			bytes_rcvd += (rx_count - 4);
-refill_one:
-			/* prepare for new receive */
-			rxd->hdr = EDH_STICKY|EDH_NPV|EDH_EOWN;
+/*
+ * Collect the frames received so far. The buffers of the previous batch are
+ * handed back first, now that the network stack is done with them, so the
+ * descriptors are refilled and synced once per batch rather than per frame.
+ * A batch takes at most half the ring, so the MAC always has the other half
+ * to receive into while the stack holds on to it.
+ */
+static int pic32eth_rx_batch(struct eth_device *netdev, uchar **packets,
+			     int *lengths, int max)
+{
+	struct pic32eth_device *pedev = netdev->priv;
+	uchar *pkt;
+	int len, n = 0;
 
-			__dcache_flush(rxd, sizeof(*rxd));
+	max = min(max, MAX_RX_DESCR / 2);
+	pic32eth_rx_return(pedev);
 
-			/* decrement rx pkt count */
-			writel(ETHCON1_BUFCDEC, &eth->con1.set);
+	/* keep the transmitter busy while waiting for replies */
+	pic32eth_tx_kick(pedev);
 
-			cond_debug("%s: %d /fill-idx %i, .hdr=%x, .data_buff %x, .stat %x, .nexted %x / rx-idx %i\n",
-				   __func__, __LINE__, idx, rxd->hdr,
-				   rxd->data_buff, rxd->stat2, rxd->next_ed,
-				   pedev->rxd_idx);
+	pic32_eth_rx_sync(&pedev->rxring);
+	while (n < max) {
+		len = pic32_eth_rx_frame(&pedev->rxring, &pkt);
+		if (len == -EAGAIN)
+			break;
 
-			pedev->rxd_idx = (pedev->rxd_idx + 1) % MAX_RX_DESCR;
+		if (len < 0) {
+			printf("%s: %s: Error, rx problem detected (%d)\n",
+			       __FILE__, __func__, len);
+			continue;
 		}
-
-		if (ctrlc())
-			break;
+		packets[n] = pkt;
+		lengths[n++] = len;
 	}
 
-	return bytes_rcvd;
+	return n;
 }
 
 /*
@@ -508,6 +499,7 @@ int pic32eth_initialize(bd_t *bis, ulong ioaddr, int phy_id, int phyif)
 {
 	struct eth_device *netdev;
 	struct pic32eth_device *pedev;
+	int i;
 
 	if (!ioaddr || (phyif == PHY_INTERFACE_MODE_NONE)) {
 		printf("%s: %s: Error, invalid parameter, not initialized!\n",
@@ -526,6 +518,18 @@ int pic32eth_initialize(bd_t *bis, ulong ioaddr, int phy_id, int phyif)
 	memset(pedev, 0, sizeof(*pedev));
 	netdev = &pedev->netdev;
 
+	/* TX bounce buffers */
+	pedev->tx_bufs[0] = memalign(ARCH_DMA_MINALIGN,
+				     MAX_TX_DESCR * MAX_TX_BUF_SIZE);
+	if (!pedev->tx_bufs[0]) {
+		printf("%s: %s: Error, malloc failed, data not initialized!\n",
+		       __FILE__, __func__);
+		free(pedev);
+		return -1;
+	}
+	for (i = 1; i < MAX_TX_DESCR; i++)
+		pedev->tx_bufs[i] = pedev->tx_bufs[0] + i * MAX_TX_BUF_SIZE;
+
 	/* initialize */
 	pedev->phy_id	= phy_id;
 	pedev->phyif	= phyif;
@@ -537,7 +541,7 @@ int pic32eth_initialize(bd_t *bis, ulong ioaddr, int phy_id, int phyif)
 	netdev->priv	= pedev;
 	netdev->init	= pic32eth_init;
 	netdev->send	= pic32eth_xmit;
-	netdev->recv	= pic32eth_rx_poll;
+	netdev->recv_batch = pic32eth_rx_batch;
 	netdev->halt	= pic32eth_halt;
 
 	eth_register(netdev);
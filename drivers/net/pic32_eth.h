@@ -9,6 +9,7 @@
 #define PIC32_ETH_H
 
 #include <stddef.h>   /* for size_t */
+#include <pic32_eth_ring.h>
 #include <asm/arch-pic32/ap.h>
 
 /* Ethernet */
@@ -123,57 +124,6 @@ struct pic32_emac_regs {
 #define MIIMIND_NOTVALID	0x04
 #define MIIMIND_LINKFAIL	0x08
 
-/*
- * Packet Descriptor
- *
- * Descriptor of a packet accepted by the TX/RX Ethernet engine.
- * ref: PIC32 Family Reference Manual Table 35-7
- *
- * A packet handled by the Ethernet TX/RX engine is a list of buffer
- * descriptors. A packet may consist of more than one buffer.
- * Each buffer needs a descriptor.
- *
- */
-
-/* Received Packet Status */
-#define _RSV1_PKT_CSUM	0xffff
-#define _RSV2_RX_OK	(1 << 23)
-#define _RSV2_LEN_ERR	(1 << 21)
-#define _RSV2_CRC_ERR	(1 << 20)
-#define _RSV2_RX_COUNT	0xffff
-
-#define RSV_RX_CSUM(__rsv1)	((__rsv1) & _RSV1_PKT_CSUM)
-#define RSV_RX_COUNT(__rsv2)	((__rsv2) & _RSV2_RX_COUNT)
-#define RSV_RX_OK(__rsv2)	((__rsv2) & _RSV2_RX_OK)
-#define RSV_CRC_ERR(__rsv2)	((__rsv2) & _RSV2_CRC_ERR)
-
-/* Ethernet Hardware Descriptor Header bits */
-#define EDH_EOWN	0x00000080
-#define EDH_NPV		0x00000100
-#define EDH_STICKY	0x00000200
-#define _EDH_BCOUNT	0x07ff0000
-#define EDH_EOP		0x40000000
-#define EDH_SOP		0x80000000
-#define EDH_BCOUNT_SHIFT	16
-#define EDH_BCOUNT(len)	((len) << EDH_BCOUNT_SHIFT)
-
-/*
- * Ethernet Hardware Descriptors
- * ref: PIC32 Family Reference Manual Table 35-7
- *
- * This structure represents the layout of the DMA
- * memory shared between the CPU and the Ethernet
- * controller.
- */
-/* TX/RX DMA descriptor */
-struct eth_dma_desc {
-	u32 hdr;	/* header */
-	u32 data_buff;	/* data buffer address */
-	u32 stat1;	/* transmit/receive packet status */
-	u32 stat2;	/* transmit/receive packet status */
-	u32 next_ed;	/* next descriptor */
-};
-
 /* Delay/Timeout range */
 #define DELAY_10MS	10000UL
 
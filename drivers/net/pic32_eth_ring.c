@@ -0,0 +1,202 @@
+/*
+ * Descriptor rings for the PIC32 Ethernet controller
+ *
+ * This is kept apart from the driver, which does all the register
+ * accesses, so that it can be tested on sandbox.
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <errno.h>
+#include <malloc.h>
+#include <pic32_eth_ring.h>
+
+#define RX_DESC_IDLE	(EDH_NPV | EDH_EOWN | EDH_STICKY)
+
+static struct eth_dma_desc *ring_desc(struct pic32_eth_ring *ring, uint idx)
+{
+	return &ring->slot[idx % ring->count].desc;
+}
+
+/* Flush or invalidate @n descriptors starting at @first, which may wrap */
+static void ring_sync(struct pic32_eth_ring *ring, uint first, uint n,
+		      bool flush)
+{
+	ulong start, end;
+	uint part;
+
+	for (first %= ring->count; n; n -= part, first = 0) {
+		part = min(n, ring->count - first);
+		start = (ulong)&ring->slot[first];
+		end = (ulong)&ring->slot[first + part];
+		if (flush)
+			flush_dcache_range(start, end);
+		else
+			invalidate_dcache_range(start, end);
+	}
+}
+
+static void buf_invalidate(void *buf, uint len)
+{
+	invalidate_dcache_range((ulong)buf,
+				(ulong)buf + roundup(len, ARCH_DMA_MINALIGN));
+}
+
+int pic32_eth_ring_init(struct pic32_eth_ring *ring, uint count, void **bufs,
+			uint buf_size, ulong (*to_phys)(void *), bool rx)
+{
+	struct eth_dma_desc *desc;
+	uint idx;
+
+	ring->slot = memalign(ARCH_DMA_MINALIGN, count * sizeof(*ring->slot));
+	if (!ring->slot)
+		return -ENOMEM;
+	memset(ring->slot, '\0', count * sizeof(*ring->slot));
+	ring->slot_phys = to_phys(ring->slot);
+	ring->buf = bufs;
+	ring->buf_size = buf_size;
+	ring->count = count;
+	ring->head = 0;
+	ring->done = 0;
+	ring->frames = 0;
+	ring->pending = 0;
+
+	for (idx = 0; idx < count; idx++) {
+		desc = ring_desc(ring, idx);
+		desc->hdr = rx ? RX_DESC_IDLE : EDH_NPV;
+		desc->data_buff = to_phys(bufs[idx]);
+		desc->next_ed = pic32_eth_ring_phys(ring, idx + 1);
+		if (rx)
+			buf_invalidate(bufs[idx], buf_size);
+	}
+	ring_sync(ring, 0, count, true);
+
+	return 0;
+}
+
+void pic32_eth_ring_free(struct pic32_eth_ring *ring)
+{
+	free(ring->slot);
+	ring->slot = NULL;
+}
+
+int pic32_eth_tx_reap(struct pic32_eth_ring *ring)
+{
+	uint first = ring->head + ring->count - ring->pending;
+
+	ring_sync(ring, first, ring->pending, false);
+	for (; ring->pending; ring->pending--, first++) {
+		if (ring_desc(ring, first)->hdr & EDH_EOWN)
+			return first % ring->count;
+	}
+
+	return -ENOENT;
+}
+
+void *pic32_eth_tx_buf(struct pic32_eth_ring *ring)
+{
+	if (ring->pending == ring->count)
+		pic32_eth_tx_reap(ring);
+
+	return ring->pending < ring->count ? ring->buf[ring->head] : NULL;
+}
+
+void pic32_eth_tx_queue(struct pic32_eth_ring *ring, uint len)
+{
+	struct eth_dma_desc *desc = ring_desc(ring, ring->head);
+	void *buf = ring->buf[ring->head];
+
+	flush_dcache_range((ulong)buf,
+			   (ulong)buf + roundup(len, ARCH_DMA_MINALIGN));
+	desc->hdr = EDH_NPV | EDH_SOP | EDH_EOP | EDH_EOWN | EDH_BCOUNT(len);
+	desc->stat1 = 0;
+	desc->stat2 = 0;
+	ring_sync(ring, ring->head, 1, true);
+
+	ring->head = (ring->head + 1) % ring->count;
+	ring->pending++;
+}
+
+void pic32_eth_rx_sync(struct pic32_eth_ring *ring)
+{
+	ring_sync(ring, ring->head, ring->count - ring->done, false);
+}
+
+/* Consume @n descriptors from the head of the ring */
+static void rx_consume(struct pic32_eth_ring *ring, uint n)
+{
+	ring->head = (ring->head + n) % ring->count;
+	ring->done += n;
+}
+
+int pic32_eth_rx_frame(struct pic32_eth_ring *ring, uchar **pktp)
+{
+	uint avail = ring->count - ring->done;
+	struct eth_dma_desc *desc;
+	uint n, idx, count;
+	u32 stat;
+
+	/* Find the descriptor which ends the frame at the head */
+	for (n = 0; n < avail; n++) {
+		desc = ring_desc(ring, ring->head + n);
+		if (desc->hdr & EDH_EOWN)
+			return -EAGAIN;
+		/* Only the first descriptor of a frame has SOP */
+		if ((n == 0) != !!(desc->hdr & EDH_SOP)) {
+			/* A frame was cut short; drop what there is of it */
+			rx_consume(ring, max(n, 1U));
+			return -EIO;
+		}
+		if (desc->hdr & EDH_EOP)
+			break;
+	}
+	if (n == avail) {
+		/* Wait for descriptors to be returned, unless it is hopeless */
+		if (ring->done)
+			return -EAGAIN;
+		rx_consume(ring, n);
+		return -EMSGSIZE;
+	}
+
+	idx = ring->head;
+	rx_consume(ring, ++n);
+	ring->frames++;
+
+	/* Frames are passed up in place, so each must fit in one buffer */
+	if (n > 1)
+		return -EMSGSIZE;
+
+	stat = desc->stat2;
+	count = RSV_RX_COUNT(stat);
+	if (!RSV_RX_OK(stat) || RSV_CRC_ERR(stat) || count < 4 ||
+	    count > ring->buf_size)
+		return -EIO;
+	buf_invalidate(ring->buf[idx], count);
+	*pktp = ring->buf[idx];
+
+	return count - 4;
+}
+
+uint pic32_eth_rx_return(struct pic32_eth_ring *ring)
+{
+	uint first = ring->head + ring->count - ring->done;
+	uint frames = ring->frames;
+	struct eth_dma_desc *desc;
+	uint n;
+
+	for (n = 0; n < ring->done; n++) {
+		desc = ring_desc(ring, first + n);
+		desc->hdr = RX_DESC_IDLE;
+		desc->stat1 = 0;
+		desc->stat2 = 0;
+		/* Drop anything the network stack wrote into the buffer */
+		buf_invalidate(ring->buf[(first + n) % ring->count],
+			       ring->buf_size);
+	}
+	ring_sync(ring, first, ring->done, true);
+	ring->done = 0;
+	ring->frames = 0;
+
+	return frames;
+}
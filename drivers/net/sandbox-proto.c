@@ -0,0 +1,897 @@
+/*
+ * Mock TFTP, NFS and HTTP servers behind the sandbox Ethernet driver
+ *
+ * Copyright (c) 2015 National Instruments
+ *
+ * (C) Copyright 2015
+ * Joe Hershberger <joe.hershberger@ni.com>
+ *
+ * SPDX-License-Identifier:	GPL-2.0
+ */
+
+#include <common.h>
+#include <net.h>
+#include <asm/eth.h>
+#include <asm/test.h>
+#include <asm/unaligned.h>
+#include "sandbox-proto.h"
+
+/* The mock TFTP server */
+#define SB_TFTP_PORT		69
+#define SB_TFTP_TID		4000	/* server port used for the transfer */
+#define SB_TFTP_MAX_BLKSIZE	1468	/* no fragmentation */
+#define SB_TFTP_MAX_WINDOW	64
+#define SB_TFTP_RTT_MS		1	/* simulated round trip per ACK */
+
+#define SB_TFTP_RRQ		1
+#define SB_TFTP_DATA		3
+#define SB_TFTP_ACK		4
+#define SB_TFTP_OACK		6
+
+/* The mock portmapper, MOUNT and NFS server */
+#define SB_PORTMAP_PORT		111
+#define SB_MOUNT_PORT		635
+#define SB_NFS_PORT		2049
+#define SB_NFS_FRAG_SIZE	1480	/* IP payload of each fragment */
+#define SB_NFS_FH3_LEN		26	/* odd, to check padding; v2 uses 32 */
+#define SB_NFS_RTT_MS		1	/* simulated round trip when idle */
+
+/* The mock HTTP server */
+#define SB_HTTP_PORT		80
+#define SB_HTTP_MSS		1460
+#define SB_HTTP_ISS		0xfffff000	/* wraps during a transfer */
+#define SB_HTTP_RTT_MS		1	/* simulated round trip per window */
+#define SB_HTTP_RTO_MS		200	/* resend after this long idle */
+
+#define SB_PROG_PORTMAP		100000
+#define SB_PROG_NFS		100003
+#define SB_PROG_MOUNT		100005
+#define SB_PORTMAP_GETPORT	3
+#define SB_MOUNT_MNT		1
+#define SB_NFS_LOOKUP		4
+#define SB_NFS3_LOOKUP		3
+#define SB_NFS_READ		6
+#define SB_NFS3_FSINFO		19
+#define SB_NFSERR_STALE		70
+#define SB_RPC_PROC_UNAVAIL	3
+
+/* The file served over TFTP, see sandbox_eth_tftp_setup() */
+static ulong tftp_size;
+static ulong tftp_drop_block;
+static ulong tftp_acks;
+static const u8 *tftp_data;
+
+/* The file served over NFS, see sandbox_eth_nfs_setup() */
+static ulong nfs_size;
+static int nfs_vers;
+static ulong nfs_drop_read;
+static ulong nfs_reads;
+static bool nfs_dropped;
+
+/* The file served over HTTP, see sandbox_eth_http_setup() */
+static ulong http_size;
+static bool http_wscale;
+static ulong http_drop_segment;
+static ulong http_segments;
+static ulong http_acks;
+static ulong http_retransmits;
+
+/*
+ * sandbox_eth_tftp_setup()
+ *
+ * size - Size of the file to serve for any TFTP read request, 0 to ignore
+ *	TFTP requests
+ * drop_block - Block number to drop, once, to simulate a lost packet, or 0
+ */
+void sandbox_eth_tftp_setup(ulong size, ulong drop_block)
+{
+	tftp_size = size;
+	tftp_drop_block = drop_block;
+	tftp_acks = 0;
+	tftp_data = NULL;
+}
+
+/*
+ * sandbox_eth_tftp_data()
+ *
+ * Serve the given contents over TFTP in place of those from
+ * sandbox_eth_tftp_fill(), until the next call to sandbox_eth_tftp_setup()
+ *
+ * data - Contents of the file, of the size given to sandbox_eth_tftp_setup()
+ */
+void sandbox_eth_tftp_data(const void *data)
+{
+	tftp_data = data;
+}
+
+/*
+ * sandbox_eth_tftp_acks()
+ *
+ * Returns the number of ACKs received by the TFTP server since the last
+ * call to sandbox_eth_tftp_setup()
+ */
+ulong sandbox_eth_tftp_acks(void)
+{
+	return tftp_acks;
+}
+
+/*
+ * sandbox_eth_tftp_fill()
+ *
+ * Fill a buffer with the contents of the file served over TFTP
+ *
+ * buf - Buffer to fill
+ * offset - Offset within the file of the first byte to fill
+ * len - Number of bytes to fill
+ */
+void sandbox_eth_tftp_fill(void *buf, ulong offset, ulong len)
+{
+	u8 *ptr = buf;
+
+	for (; len; len--, offset++)
+		*ptr++ = offset * 7 + (offset >> 11);
+}
+
+/*
+ * sandbox_eth_nfs_setup()
+ *
+ * size - Size of the file to serve over NFS for any name, 0 to ignore RPC
+ *	calls. It holds the same data as for TFTP, see sandbox_eth_tftp_fill()
+ * vers - Highest NFS version to offer, 2 or 3
+ * drop_read - Number of a READ call to drop, once, counting from 1, or 0
+ */
+void sandbox_eth_nfs_setup(ulong size, int vers, ulong drop_read)
+{
+	nfs_size = size;
+	nfs_vers = vers;
+	nfs_drop_read = drop_read;
+	nfs_reads = 0;
+	nfs_dropped = false;
+}
+
+/*
+ * sandbox_eth_nfs_reads()
+ *
+ * Returns the number of READ calls received by the NFS server since the last
+ * call to sandbox_eth_nfs_setup()
+ */
+ulong sandbox_eth_nfs_reads(void)
+{
+	return nfs_reads;
+}
+
+/*
+ * sandbox_eth_http_setup()
+ *
+ * size - Size of the file to serve over HTTP for any path except
+ *	"/notfound", 0 to ignore TCP segments. It holds the same data as for
+ *	TFTP, see sandbox_eth_tftp_fill()
+ * wscale - Accept window scaling, if the client offers it
+ * drop_segment - Number of a data segment to drop, once, counting from 1,
+ *	or 0
+ */
+void sandbox_eth_http_setup(ulong size, bool wscale, ulong drop_segment)
+{
+	http_size = size;
+	http_wscale = wscale;
+	http_drop_segment = drop_segment;
+	http_segments = 0;
+	http_acks = 0;
+	http_retransmits = 0;
+}
+
+/*
+ * sandbox_eth_http_acks()
+ *
+ * Returns the number of ACKs without data received by the HTTP server since
+ * the last call to sandbox_eth_http_setup()
+ */
+ulong sandbox_eth_http_acks(void)
+{
+	return http_acks;
+}
+
+/*
+ * sandbox_eth_http_retransmits()
+ *
+ * Returns the number of segments sent again by the HTTP server since the
+ * last call to sandbox_eth_http_setup()
+ */
+ulong sandbox_eth_http_retransmits(void)
+{
+	return http_retransmits;
+}
+
+/* Add the headers to the UDP payload of a mock response */
+static void sb_udp_reply(struct eth_sandbox_priv *priv, const uchar *hwaddr,
+			 struct in_addr dest, struct in_addr src, int sport,
+			 int dport, int payload_len)
+{
+	struct ethernet_hdr *eth = (void *)priv->recv_packet_buffer;
+	struct ip_udp_hdr *ip = (void *)priv->recv_packet_buffer +
+		ETHER_HDR_SIZE;
+
+	memcpy(eth->et_dest, hwaddr, ARP_HLEN);
+	memcpy(eth->et_src, priv->fake_host_hwaddr, ARP_HLEN);
+	eth->et_protlen = htons(PROT_IP);
+
+	net_set_ip_header((uchar *)ip, dest, src);
+	ip->ip_len = htons(IP_UDP_HDR_SIZE + payload_len);
+	ip->ip_p = IPPROTO_UDP;
+	ip->ip_sum = compute_ip_checksum(ip, IP_HDR_SIZE);
+	ip->udp_src = htons(sport);
+	ip->udp_dst = htons(dport);
+	ip->udp_len = htons(UDP_HDR_SIZE + payload_len);
+	ip->udp_xsum = 0;
+
+	priv->recv_packet_length = ETHER_HDR_SIZE + IP_UDP_HDR_SIZE +
+		payload_len;
+}
+
+/* Add the headers to the UDP payload of a mock TFTP response */
+static void sb_tftp_reply(struct eth_sandbox_priv *priv, int payload_len)
+{
+	struct sb_tftp_xfer *xfer = &priv->tftp;
+
+	sb_udp_reply(priv, xfer->client_hwaddr, xfer->client_ipaddr,
+		     xfer->server_ipaddr, SB_TFTP_TID, xfer->client_port,
+		     payload_len);
+}
+
+/* Handle a read request by starting a transfer, with an OACK if needed */
+static void sb_tftp_rrq(struct eth_sandbox_priv *priv, struct ip_udp_hdr *ip,
+			char *req, int len)
+{
+	struct sb_tftp_xfer *xfer = &priv->tftp;
+	char *oack = (char *)priv->recv_packet_buffer + ETHER_HDR_SIZE +
+		IP_UDP_HDR_SIZE;
+	char *end = req + len;
+	char *opt, *val, *p;
+
+	xfer->client_ipaddr = net_read_ip(&ip->ip_src);
+	xfer->server_ipaddr = net_read_ip(&ip->ip_dst);
+	xfer->client_port = ntohs(ip->udp_src);
+	xfer->blksize = 512;
+	xfer->windowsize = 1;
+	xfer->acked_block = 0;
+	xfer->next_block = 1;
+
+	/* Skip the opcode, file name and mode, then look at the options */
+	p = oack;
+	*(__be16 *)p = htons(SB_TFTP_OACK);
+	p += 2;
+	req += 2;
+	req += strnlen(req, end - req) + 1;
+	req += strnlen(req, end - req) + 1;
+	while (req < end) {
+		opt = req;
+		val = opt + strnlen(opt, end - opt) + 1;
+		if (val >= end)
+			break;
+		req = val + strnlen(val, end - val) + 1;
+		if (!strcmp(opt, "blksize")) {
+			xfer->blksize = min(simple_strtoul(val, NULL, 10),
+					    (ulong)SB_TFTP_MAX_BLKSIZE);
+			p += sprintf(p, "blksize%c%u%c", 0, xfer->blksize, 0);
+		} else if (!strcmp(opt, "windowsize")) {
+			xfer->windowsize = min(simple_strtoul(val, NULL, 10),
+					       (ulong)SB_TFTP_MAX_WINDOW);
+			p += sprintf(p, "windowsize%c%u%c", 0,
+				     xfer->windowsize, 0);
+		} else if (!strcmp(opt, "tsize")) {
+			p += sprintf(p, "tsize%c%lu%c", 0, tftp_size, 0);
+		}
+	}
+
+	/* Without options the first block is the reply, else wait for ACK 0 */
+	if (p - oack > 2) {
+		xfer->window_left = 0;
+		sb_tftp_reply(priv, p - oack);
+	} else {
+		xfer->window_left = 1;
+	}
+}
+
+/* Handle an ACK by opening the window after the acknowledged block */
+static void sb_tftp_ack(struct eth_sandbox_priv *priv, void *payload)
+{
+	struct sb_tftp_xfer *xfer = &priv->tftp;
+	ushort block = ntohs(*(__be16 *)(payload + 2));
+	ulong acked;
+
+	/* ACKs never go backwards, so this undoes the 16-bit wrap */
+	acked = xfer->acked_block + (ushort)(block - xfer->acked_block);
+	if (acked >= xfer->next_block)
+		return;
+	tftp_acks++;
+	/* Lock-step TFTP is limited by latency, so charge for each ACK */
+	sandbox_timer_add_offset(SB_TFTP_RTT_MS);
+	xfer->acked_block = acked;
+	xfer->next_block = acked + 1;
+	xfer->window_left = xfer->windowsize;
+
+	/* The file ends with the first block shorter than blksize */
+	if (acked == tftp_size / xfer->blksize + 1)
+		xfer->windowsize = 0;
+}
+
+/* Queue the next block of the current window, if any */
+static void sb_tftp_send_data(struct eth_sandbox_priv *priv)
+{
+	struct sb_tftp_xfer *xfer = &priv->tftp;
+	u8 *data = priv->recv_packet_buffer + ETHER_HDR_SIZE + IP_UDP_HDR_SIZE;
+	ulong last_block = tftp_size / xfer->blksize + 1;
+	ulong offset;
+	uint len;
+
+	if (xfer->window_left && xfer->next_block == tftp_drop_block) {
+		tftp_drop_block = 0;
+		xfer->next_block++;
+		xfer->window_left--;
+	}
+	if (!xfer->window_left || xfer->next_block > last_block)
+		return;
+
+	offset = (xfer->next_block - 1) * xfer->blksize;
+	len = min(tftp_size - offset, (ulong)xfer->blksize);
+	*(__be16 *)data = htons(SB_TFTP_DATA);
+	*(__be16 *)(data + 2) = htons((ushort)xfer->next_block);
+	if (tftp_data)
+		memcpy(data + 4, tftp_data + offset, len);
+	else
+		sandbox_eth_tftp_fill(data + 4, offset, len);
+	sb_tftp_reply(priv, 4 + len);
+	xfer->next_block++;
+	xfer->window_left--;
+}
+
+/* Add the header of an accepted RPC reply */
+static __be32 *sb_rpc_reply(__be32 *p, __be32 xid)
+{
+	*p++ = xid;
+	*p++ = htonl(1);	/* REPLY */
+	*p++ = 0;		/* MSG_ACCEPTED */
+	*p++ = 0;		/* AUTH_NONE verifier */
+	*p++ = 0;
+	*p++ = 0;		/* SUCCESS */
+
+	return p;
+}
+
+/* Add the handle of the root directory ('r') or of the file ('f') */
+static __be32 *sb_nfs_fh(__be32 *p, int vers, char which)
+{
+	int len = vers == 3 ? SB_NFS_FH3_LEN : 32;
+
+	if (vers == 3)
+		*p++ = htonl(len);
+	memset(p, '\0', ALIGN(len, 4));
+	memset(p, which, len);
+
+	return p + ALIGN(len, 4) / 4;
+}
+
+/* Check the file handle at the start of some arguments, and skip it */
+static bool sb_nfs_check_fh(__be32 **argsp, int vers, char which)
+{
+	__be32 *args = *argsp;
+	int len = 32;
+	u8 *fh;
+	int i;
+
+	if (vers == 3)
+		len = ntohl(*args++);
+	if (len != (vers == 3 ? SB_NFS_FH3_LEN : 32))
+		return false;
+	fh = (u8 *)args;
+	*argsp = args + ALIGN(len, 4) / 4;
+	for (i = 0; i < len; i++) {
+		if (fh[i] != which)
+			return false;
+	}
+
+	return true;
+}
+
+/* Add the attributes of the file, as an NFSv3 post_op_attr or NFSv2 fattr */
+static __be32 *sb_nfs_fattr(__be32 *p, int vers)
+{
+	if (vers == 3) {
+		*p++ = htonl(1);		/* attributes follow */
+		memset(p, '\0', 21 * 4);
+		p[0] = htonl(1);		/* NF3REG */
+		p[5] = htonl((u64)nfs_size >> 32);
+		p[6] = htonl(nfs_size);
+		return p + 21;
+	}
+	memset(p, '\0', 17 * 4);
+	p[0] = htonl(1);			/* NFREG */
+	p[5] = htonl(nfs_size);
+
+	return p + 17;
+}
+
+static bool sb_nfs_is_port(int port)
+{
+	return port == SB_PORTMAP_PORT || port == SB_MOUNT_PORT ||
+		port == SB_NFS_PORT;
+}
+
+/* Answer a call to the portmapper, MOUNT or NFS, or queue it if a READ */
+static void sb_nfs_call(struct eth_sandbox_priv *priv, struct ip_udp_hdr *ip)
+{
+	struct sb_nfs_server *srv = &priv->nfs;
+	__be32 *call = (void *)ip + IP_UDP_HDR_SIZE;
+	__be32 *reply = (void *)priv->recv_packet_buffer + ETHER_HDR_SIZE +
+		IP_UDP_HDR_SIZE;
+	int port = ntohs(ip->udp_dst);
+	uint prog, vers, proc, lookup;
+	struct sb_nfs_read *rd;
+	__be32 *args, *p;
+	char which;
+
+	srv->client_ipaddr = net_read_ip(&ip->ip_src);
+	srv->server_ipaddr = net_read_ip(&ip->ip_dst);
+	srv->client_port = ntohs(ip->udp_src);
+	prog = ntohl(call[3]);
+	vers = ntohl(call[4]);
+	proc = ntohl(call[5]);
+
+	/* Skip the credential and verifier */
+	args = call + 6;
+	args += 2 + ALIGN(ntohl(args[1]), 4) / 4;
+	args += 2 + ALIGN(ntohl(args[1]), 4) / 4;
+
+	/* A call to an idle server has to wait for a full round trip */
+	if (!srv->npending && srv->dgram_sent == srv->dgram_len)
+		sandbox_timer_add_offset(SB_NFS_RTT_MS);
+
+	p = sb_rpc_reply(reply, call[0]);
+	if (port == SB_PORTMAP_PORT && prog == SB_PROG_PORTMAP &&
+	    proc == SB_PORTMAP_GETPORT) {
+		prog = ntohl(args[0]);
+		vers = ntohl(args[1]);
+		if (prog == SB_PROG_MOUNT && vers <= nfs_vers)
+			*p++ = htonl(SB_MOUNT_PORT);
+		else if (prog == SB_PROG_NFS && vers >= 2 && vers <= nfs_vers)
+			*p++ = htonl(SB_NFS_PORT);
+		else
+			*p++ = 0;
+	} else if (port == SB_MOUNT_PORT && prog == SB_PROG_MOUNT) {
+		/* UMNTALL has no results */
+		if (proc == SB_MOUNT_MNT) {
+			*p++ = 0;
+			p = sb_nfs_fh(p, vers, 'r');
+			if (vers == 3) {
+				*p++ = htonl(1);
+				*p++ = htonl(1);	/* AUTH_UNIX */
+			}
+		}
+	} else if (port == SB_NFS_PORT && prog == SB_PROG_NFS) {
+		lookup = vers == 3 ? SB_NFS3_LOOKUP : SB_NFS_LOOKUP;
+		if (proc == SB_NFS_READ)
+			which = 'f';
+		else
+			which = 'r';
+		if (!sb_nfs_check_fh(&args, vers, which)) {
+			*p++ = htonl(SB_NFSERR_STALE);
+			if (vers == 3)
+				*p++ = 0;	/* no attributes */
+		} else if (proc == lookup) {
+			*p++ = 0;
+			p = sb_nfs_fh(p, vers, 'f');
+			p = sb_nfs_fattr(p, vers);
+			if (vers == 3)
+				*p++ = 0;	/* no directory attributes */
+		} else if (vers == 3 && proc == SB_NFS3_FSINFO) {
+			*p++ = 0;
+			*p++ = 0;		/* no attributes */
+			*p++ = htonl(SB_NFS_RTMAX);	/* rtmax */
+			*p++ = htonl(SB_NFS_RTMAX);	/* rtpref */
+			memset(p, '\0', 12 * 4);	/* the rest is unused */
+			p += 12;
+		} else if (proc == SB_NFS_READ) {
+			/* READs are answered later, in sb_nfs_send_frag() */
+			if (++nfs_reads == nfs_drop_read) {
+				nfs_dropped = true;
+				return;
+			}
+			if (srv->npending == SB_NFS_MAX_PENDING)
+				return;
+			rd = &srv->pending[srv->npending++];
+			rd->xid = call[0];
+			rd->vers = vers;
+			if (vers == 3) {
+				rd->offset = (u64)ntohl(args[0]) << 32 |
+					ntohl(args[1]);
+				rd->count = ntohl(args[2]);
+			} else {
+				rd->offset = ntohl(args[0]);
+				rd->count = ntohl(args[1]);
+			}
+			rd->count = min(rd->count, (uint)SB_NFS_RTMAX);
+			return;
+		} else {
+			p[-1] = htonl(SB_RPC_PROC_UNAVAIL);
+		}
+	} else {
+		return;
+	}
+
+	sb_udp_reply(priv, srv->client_hwaddr, srv->client_ipaddr,
+		     srv->server_ipaddr, port, srv->client_port,
+		     (void *)p - (void *)reply);
+}
+
+/*
+ * Build the reply to a pending READ. The second oldest is answered first, so
+ * that the replies arrive out of order.
+ */
+static void sb_nfs_read_reply(struct sb_nfs_server *srv)
+{
+	__be16 *udp = (__be16 *)srv->dgram;
+	__be32 *p = (__be32 *)(srv->dgram + UDP_HDR_SIZE);
+	struct sb_nfs_read rd;
+	uint count = 0;
+	bool eof;
+	int i;
+
+	i = srv->npending > 1;
+	rd = srv->pending[i];
+	srv->npending--;
+	memmove(&srv->pending[i], &srv->pending[i + 1],
+		(srv->npending - i) * sizeof(rd));
+
+	if (rd.offset < nfs_size)
+		count = min((u64)rd.count, nfs_size - rd.offset);
+	eof = rd.offset + count >= nfs_size;
+	p = sb_rpc_reply(p, rd.xid);
+	*p++ = 0;
+	p = sb_nfs_fattr(p, rd.vers);
+	if (rd.vers == 3) {
+		*p++ = htonl(count);
+		*p++ = htonl(eof);
+	}
+	*p++ = htonl(count);
+	memset((u8 *)p + count, '\0', 3);
+	sandbox_eth_tftp_fill(p, rd.offset, count);
+
+	srv->dgram_len = (u8 *)p + ALIGN(count, 4) - srv->dgram;
+	srv->dgram_sent = 0;
+	srv->ip_id++;
+	udp[0] = htons(SB_NFS_PORT);
+	udp[1] = htons(srv->client_port);
+	udp[2] = htons(srv->dgram_len);
+	udp[3] = 0;
+}
+
+/* Queue the next IP fragment of a READ reply, if any */
+static void sb_nfs_send_frag(struct eth_sandbox_priv *priv)
+{
+	struct sb_nfs_server *srv = &priv->nfs;
+	struct ethernet_hdr *eth = (void *)priv->recv_packet_buffer;
+	struct ip_udp_hdr *ip = (void *)priv->recv_packet_buffer +
+		ETHER_HDR_SIZE;
+	int off, len, more;
+
+	if (srv->dgram_sent == srv->dgram_len) {
+		if (!srv->npending) {
+			/* Let the client time out a dropped READ quickly */
+			if (nfs_dropped)
+				sandbox_timer_add_offset(100);
+			return;
+		}
+		sb_nfs_read_reply(srv);
+	}
+
+	off = srv->dgram_sent;
+	len = min(srv->dgram_len - off, SB_NFS_FRAG_SIZE);
+	memcpy((void *)ip + IP_HDR_SIZE, srv->dgram + off, len);
+	srv->dgram_sent += len;
+	more = srv->dgram_sent < srv->dgram_len ? IP_FLAGS_MFRAG : 0;
+
+	memcpy(eth->et_dest, srv->client_hwaddr, ARP_HLEN);
+	memcpy(eth->et_src, priv->fake_host_hwaddr, ARP_HLEN);
+	eth->et_protlen = htons(PROT_IP);
+	net_set_ip_header((uchar *)ip, srv->client_ipaddr, srv->server_ipaddr);
+	ip->ip_len = htons(IP_HDR_SIZE + len);
+	ip->ip_id = htons(srv->ip_id);
+	ip->ip_off = htons(off / 8 | more);
+	ip->ip_p = IPPROTO_UDP;
+	ip->ip_sum = compute_ip_checksum(ip, IP_HDR_SIZE);
+
+	priv->recv_packet_length = ETHER_HDR_SIZE + IP_HDR_SIZE + len;
+}
+
+/* Checksum of a TCP segment of @len bytes, with the pseudo-header */
+static unsigned sb_tcp_checksum(struct ip_tcp_hdr *ip, unsigned len)
+{
+	struct {
+		struct in_addr src;
+		struct in_addr dst;
+		u8 zero;
+		u8 proto;
+		__be16 len;
+	} pseudo;
+
+	net_copy_ip(&pseudo.src, &ip->ip_src);
+	net_copy_ip(&pseudo.dst, &ip->ip_dst);
+	pseudo.zero = 0;
+	pseudo.proto = IPPROTO_TCP;
+	pseudo.len = htons(len);
+
+	return add_ip_checksums(sizeof(pseudo),
+				compute_ip_checksum(&pseudo, sizeof(pseudo)),
+				compute_ip_checksum(&ip->tcp_src, len));
+}
+
+/* Build a segment with @len bytes of the response from offset @off */
+static void sb_http_segment(struct eth_sandbox_priv *priv, u8 flags,
+			    ulong off, uint len)
+{
+	struct sb_http_server *srv = &priv->http;
+	struct ethernet_hdr *eth = (void *)priv->recv_packet_buffer;
+	struct ip_tcp_hdr *ip = (void *)priv->recv_packet_buffer +
+		ETHER_HDR_SIZE;
+	u8 *data = (u8 *)ip + IP_TCP_HDR_SIZE;
+	int optlen = 0;
+	uint n = 0;
+
+	if (flags & TCP_SYN) {
+		data[0] = TCPOPT_MSS;
+		data[1] = 4;
+		put_unaligned_be16(SB_HTTP_MSS, data + 2);
+		optlen = 4;
+		if (srv->wscale) {
+			data[4] = TCPOPT_NOP;
+			data[5] = TCPOPT_WSCALE;
+			data[6] = 3;
+			data[7] = 0;
+			optlen = 8;
+		}
+	}
+	data += optlen;
+	if (off < srv->hdr_len) {
+		n = min(len, srv->hdr_len - (uint)off);
+		memcpy(data, srv->hdr + off, n);
+	}
+	if (n < len)
+		sandbox_eth_tftp_fill(data + n, off + n - srv->hdr_len,
+				      len - n);
+
+	memcpy(eth->et_dest, srv->client_hwaddr, ARP_HLEN);
+	memcpy(eth->et_src, priv->fake_host_hwaddr, ARP_HLEN);
+	eth->et_protlen = htons(PROT_IP);
+	net_set_ip_header((uchar *)ip, srv->client_ipaddr, srv->server_ipaddr);
+	ip->ip_len = htons(IP_TCP_HDR_SIZE + optlen + len);
+	ip->ip_p = IPPROTO_TCP;
+	ip->ip_sum = compute_ip_checksum(ip, IP_HDR_SIZE);
+	ip->tcp_src = htons(SB_HTTP_PORT);
+	ip->tcp_dst = htons(srv->client_port);
+	ip->tcp_seq = htonl(SB_HTTP_ISS + (flags & TCP_SYN ? 0 : 1 + off));
+	ip->tcp_ack = htonl(srv->rcv_nxt);
+	ip->tcp_hlen = (TCP_HDR_SIZE + optlen) / 4 << 4;
+	ip->tcp_flags = flags;
+	ip->tcp_win = htons(0xffff);
+	ip->tcp_xsum = 0;
+	ip->tcp_urg = 0;
+	ip->tcp_xsum = sb_tcp_checksum(ip, TCP_HDR_SIZE + optlen + len);
+
+	priv->recv_packet_length = ETHER_HDR_SIZE + IP_TCP_HDR_SIZE + optlen +
+		len;
+}
+
+/* Set up the response to a GET request */
+static void sb_http_request(struct sb_http_server *srv, const char *req,
+			    int len)
+{
+	const char *status = "200 OK";
+	ulong size = http_size;
+
+	if (len < 14 || strncmp(req, "GET /", 5)) {
+		status = "400 Bad Request";
+		size = 0;
+	} else if (!strncmp(req + 4, "/notfound ", 10)) {
+		status = "404 Not Found";
+		size = 0;
+	}
+	srv->hdr_len = sprintf(srv->hdr,
+			       "HTTP/1.1 %s\r\nContent-Length: %lu\r\n"
+			       "Connection: close\r\n\r\n", status, size);
+	srv->resp_len = srv->hdr_len + size;
+}
+
+/* Handle a segment from the client */
+static void sb_http_recv(struct eth_sandbox_priv *priv, struct ip_tcp_hdr *ip)
+{
+	struct sb_http_server *srv = &priv->http;
+	int seglen = ntohs(ip->ip_len) - IP_HDR_SIZE;
+	int hlen = (ip->tcp_hlen >> 4) * 4;
+	u8 *opt = (u8 *)ip + IP_TCP_HDR_SIZE;
+	u32 seq = ntohl(ip->tcp_seq);
+	ulong ack = ntohl(ip->tcp_ack) - SB_HTTP_ISS - 1;
+	int len = seglen - hlen;
+
+	if (sb_tcp_checksum(ip, seglen)) {
+		printf("eth_sandbox: bad TCP checksum\n");
+		return;
+	}
+	if (ip->tcp_flags & TCP_RST) {
+		srv->client_port = 0;
+		return;
+	}
+	if (ip->tcp_flags & TCP_SYN) {
+		srv->client_port = ntohs(ip->tcp_src);
+		net_copy_ip(&srv->client_ipaddr, &ip->ip_src);
+		net_copy_ip(&srv->server_ipaddr, &ip->ip_dst);
+		srv->established = false;
+		srv->syn_pending = true;
+		srv->wscale = 0;
+		for (; opt < (u8 *)ip + IP_HDR_SIZE + hlen; opt += opt[1]) {
+			if (*opt == TCPOPT_END)
+				break;
+			if (*opt == TCPOPT_NOP) {
+				opt++;
+				continue;
+			}
+			if (*opt == TCPOPT_WSCALE && http_wscale)
+				srv->wscale = opt[2];
+		}
+		srv->rcv_nxt = seq + 1;
+		srv->window = ntohs(ip->tcp_win);
+		srv->hdr_len = 0;
+		srv->resp_len = 0;
+		srv->snd_una = 0;
+		srv->snd_nxt = 0;
+		srv->flight = 0;
+		srv->dupacks = 0;
+		srv->retransmit = false;
+		srv->last_ack = get_timer(0);
+		return;
+	}
+	if (!srv->client_port || !(ip->tcp_flags & TCP_ACK) ||
+	    ntohs(ip->tcp_src) != srv->client_port)
+		return;
+	if (!srv->established) {
+		if (ack)
+			return;
+		srv->established = true;
+	}
+	srv->window = ntohs(ip->tcp_win) << srv->wscale;
+
+	if (ack > srv->snd_una && ack <= srv->snd_nxt) {
+		srv->snd_una = ack;
+		srv->dupacks = 0;
+		srv->last_ack = get_timer(0);
+	} else if (ack == srv->snd_una && !len && srv->snd_nxt > ack &&
+		   !(ip->tcp_flags & TCP_FIN) && ++srv->dupacks == 3) {
+		/* Fast retransmit */
+		srv->retransmit = true;
+	}
+	if (!len) {
+		http_acks++;
+	} else if (seq == srv->rcv_nxt) {
+		srv->rcv_nxt += len;
+		if (!srv->hdr_len)
+			sb_http_request(srv, (char *)ip + IP_HDR_SIZE + hlen,
+					len);
+	}
+	if (ip->tcp_flags & TCP_FIN) {
+		/* The client only closes after we do */
+		srv->rcv_nxt++;
+		srv->client_port = 0;
+	}
+}
+
+/* Queue the next segment from the mock HTTP server, if any */
+static void sb_http_send(struct eth_sandbox_priv *priv)
+{
+	struct sb_http_server *srv = &priv->http;
+	ulong off, len;
+
+	if (!srv->client_port)
+		return;
+	if (srv->syn_pending) {
+		srv->syn_pending = false;
+		sb_http_segment(priv, TCP_SYN | TCP_ACK, 0, 0);
+		return;
+	}
+	if (!srv->hdr_len)
+		return;
+
+	if (srv->retransmit) {
+		srv->retransmit = false;
+		off = srv->snd_una;
+		http_retransmits++;
+	} else if (srv->snd_nxt <= srv->resp_len &&
+		   srv->snd_nxt - srv->snd_una < srv->window) {
+		off = srv->snd_nxt;
+	} else {
+		/* Go back to the oldest data the client has not ACKed */
+		if (srv->snd_una < srv->snd_nxt &&
+		    get_timer(srv->last_ack) > SB_HTTP_RTO_MS) {
+			srv->snd_nxt = srv->snd_una;
+			srv->last_ack = get_timer(0);
+			http_retransmits++;
+		}
+		return;
+	}
+
+	if (off == srv->resp_len) {
+		sb_http_segment(priv, TCP_FIN | TCP_ACK, off, 0);
+		len = 1;
+	} else {
+		len = min(srv->resp_len - off, (ulong)SB_HTTP_MSS);
+		if (off == srv->snd_nxt)
+			len = min(len, srv->window - (off - srv->snd_una));
+		sb_http_segment(priv, TCP_ACK | TCP_PSH, off, len);
+		if (++http_segments == http_drop_segment)
+			priv->recv_packet_length = 0;
+	}
+	if (off == srv->snd_nxt)
+		srv->snd_nxt += len;
+
+	/* Each window sent takes a round trip */
+	srv->flight += len;
+	if (srv->flight >= srv->window) {
+		sandbox_timer_add_offset(SB_HTTP_RTT_MS);
+		srv->flight = 0;
+	}
+}
+
+void sb_proto_start(struct eth_sandbox_priv *priv)
+{
+	priv->nfs.npending = 0;
+	priv->nfs.dgram_len = 0;
+	priv->nfs.dgram_sent = 0;
+	priv->http.client_port = 0;
+}
+
+void sb_proto_send(struct eth_sandbox_priv *priv, struct ethernet_hdr *eth,
+		   struct ip_udp_hdr *ip)
+{
+	if (ip->ip_p == IPPROTO_TCP && http_size &&
+	    ntohs(((struct ip_tcp_hdr *)ip)->tcp_dst) == SB_HTTP_PORT) {
+		memcpy(priv->http.client_hwaddr, eth->et_src, ARP_HLEN);
+		sb_http_recv(priv, (struct ip_tcp_hdr *)ip);
+	} else if (ip->ip_p == IPPROTO_UDP && nfs_size &&
+		   sb_nfs_is_port(ntohs(ip->udp_dst))) {
+		memcpy(priv->nfs.client_hwaddr, eth->et_src, ARP_HLEN);
+		sb_nfs_call(priv, ip);
+	} else if (ip->ip_p == IPPROTO_UDP && tftp_size) {
+		void *payload = (void *)ip + IP_UDP_HDR_SIZE;
+		int len = ntohs(ip->udp_len) - UDP_HDR_SIZE;
+
+		if (ntohs(ip->udp_dst) == SB_TFTP_PORT &&
+		    ntohs(*(__be16 *)payload) == SB_TFTP_RRQ) {
+			memcpy(priv->tftp.client_hwaddr, eth->et_src,
+			       ARP_HLEN);
+			sb_tftp_rrq(priv, ip, payload, len);
+		} else if (ntohs(ip->udp_dst) == SB_TFTP_TID &&
+			   priv->tftp.windowsize &&
+			   ntohs(*(__be16 *)payload) == SB_TFTP_ACK) {
+			sb_tftp_ack(priv, payload);
+		}
+	}
+}
+
+void sb_proto_recv(struct eth_sandbox_priv *priv)
+{
+	/* A TFTP window is sent one block per call */
+	if (tftp_size && priv->tftp.windowsize) {
+		sb_tftp_send_data(priv);
+		if (priv->recv_packet_length)
+			return;
+	}
+
+	/* The HTTP response is sent one segment per call */
+	if (http_size) {
+		sb_http_send(priv);
+		if (priv->recv_packet_length)
+			return;
+	}
+
+	/* READ replies are sent one IP fragment per call */
+	if (nfs_size)
+		sb_nfs_send_frag(priv);
+}
@@ -0,0 +1,184 @@
+/*
+ * Shared by the sandbox Ethernet driver and its mock servers
+ *
+ * Copyright (c) 2015 National Instruments
+ *
+ * (C) Copyright 2015
+ * Joe Hershberger <joe.hershberger@ni.com>
+ *
+ * SPDX-License-Identifier:	GPL-2.0
+ */
+
+#ifndef __SANDBOX_ETH_PROTO_H
+#define __SANDBOX_ETH_PROTO_H
+
+#include <net.h>
+
+#define SB_NFS_RTMAX		32768	/* largest READ */
+#define SB_NFS_MAX_PENDING	32	/* READs waiting for their reply */
+
+/**
+ * struct sb_tftp_xfer - state of a transfer from the mock TFTP server
+ *
+ * client_hwaddr: MAC address of the client
+ * client_ipaddr: IP address of the client
+ * server_ipaddr: IP address the client sent its request to
+ * client_port: UDP port of the client
+ * blksize: negotiated block size
+ * windowsize: negotiated number of blocks sent per ACK
+ * next_block: next block to send (counting from 1, does not wrap)
+ * acked_block: last block acknowledged by the client (does not wrap)
+ * window_left: number of blocks still to send before waiting for an ACK
+ */
+struct sb_tftp_xfer {
+	uchar client_hwaddr[ARP_HLEN];
+	struct in_addr client_ipaddr;
+	struct in_addr server_ipaddr;
+	int client_port;
+	uint blksize;
+	uint windowsize;
+	ulong next_block;
+	ulong acked_block;
+	uint window_left;
+};
+
+/**
+ * struct sb_nfs_read - a READ waiting for its reply from the mock NFS server
+ *
+ * xid: RPC transaction ID, as received
+ * vers: NFS version of the call
+ * offset: offset within the file
+ * count: number of bytes asked for
+ */
+struct sb_nfs_read {
+	__be32 xid;
+	int vers;
+	u64 offset;
+	uint count;
+};
+
+/**
+ * struct sb_nfs_server - state of the mock NFS server
+ *
+ * client_hwaddr: MAC address of the client
+ * client_ipaddr: IP address of the client
+ * server_ipaddr: IP address the client sent its calls to
+ * client_port: UDP port of the client
+ * pending: READs not answered yet
+ * npending: number of READs in pending[]
+ * dgram: UDP datagram (with its header) of the READ reply being sent
+ * dgram_len: length of dgram
+ * dgram_sent: number of bytes of dgram sent so far, as IP fragments
+ * ip_id: IP ID of the last datagram
+ */
+struct sb_nfs_server {
+	uchar client_hwaddr[ARP_HLEN];
+	struct in_addr client_ipaddr;
+	struct in_addr server_ipaddr;
+	int client_port;
+	struct sb_nfs_read pending[SB_NFS_MAX_PENDING];
+	int npending;
+	u8 dgram[UDP_HDR_SIZE + 256 + SB_NFS_RTMAX] __aligned(4);
+	int dgram_len;
+	int dgram_sent;
+	ushort ip_id;
+};
+
+/**
+ * struct sb_http_server - state of the mock HTTP server, which serves one
+ * request per connection
+ *
+ * client_hwaddr: MAC address of the client
+ * client_ipaddr: IP address of the client
+ * server_ipaddr: IP address the client connected to
+ * client_port: TCP port of the client
+ * established: the client has acknowledged our SYN
+ * syn_pending: the SYN-ACK is still to be sent
+ * wscale: client window scale, if it and the server both sent the option
+ * rcv_nxt: next sequence number expected from the client
+ * window: client receive window, in bytes
+ * snd_una: oldest offset in the response not acknowledged
+ * snd_nxt: next offset in the response to send, resp_len + 1 after the FIN
+ * flight: bytes sent since the last simulated round trip
+ * dupacks: duplicate ACKs received in a row
+ * retransmit: send the segment at snd_una next
+ * last_ack: time of the last ACK which acknowledged new data
+ * hdr: HTTP response header
+ * hdr_len: length of hdr, 0 until the request is received
+ * resp_len: length of the response, header and file
+ */
+struct sb_http_server {
+	uchar client_hwaddr[ARP_HLEN];
+	struct in_addr client_ipaddr;
+	struct in_addr server_ipaddr;
+	int client_port;
+	bool established;
+	bool syn_pending;
+	int wscale;
+	u32 rcv_nxt;
+	ulong window;
+	ulong snd_una;
+	ulong snd_nxt;
+	ulong flight;
+	int dupacks;
+	bool retransmit;
+	ulong last_ack;
+	char hdr[128];
+	int hdr_len;
+	ulong resp_len;
+};
+
+/**
+ * struct eth_sandbox_priv - memory for sandbox mock driver
+ *
+ * fake_host_hwaddr: MAC address of mocked machine
+ * fake_host_ipaddr: IP address of mocked machine
+ * recv_packet_buffer: buffer of the packet returned as received
+ * recv_packet_length: length of the packet returned as received
+ * recv_slot: index of recv_packet_buffer in net_rx_packets[]
+ * tftp: TFTP transfer in progress, if tftp.windowsize is non-zero
+ * nfs: NFS server, if nfs_size is non-zero
+ * http: HTTP server, if http_size is non-zero
+ */
+struct eth_sandbox_priv {
+	uchar fake_host_hwaddr[ARP_HLEN];
+	struct in_addr fake_host_ipaddr;
+	uchar *recv_packet_buffer;
+	int recv_packet_length;
+	int recv_slot;
+	struct sb_tftp_xfer tftp;
+	struct sb_nfs_server nfs;
+	struct sb_http_server http;
+};
+
+/**
+ * sb_proto_start() - Reset the mock servers when the device is started
+ *
+ * @priv: Private data of the device
+ */
+void sb_proto_start(struct eth_sandbox_priv *priv);
+
+/**
+ * sb_proto_send() - Pass a sent IP packet to the mock servers
+ *
+ * Any reply goes in priv->recv_packet_buffer, with priv->recv_packet_length
+ * set to its length.
+ *
+ * @priv: Private data of the device
+ * @eth: Ethernet header of the packet
+ * @ip: IP header of the packet, which is not ICMP
+ */
+void sb_proto_send(struct eth_sandbox_priv *priv, struct ethernet_hdr *eth,
+		   struct ip_udp_hdr *ip);
+
+/**
+ * sb_proto_recv() - Let the mock servers send the next packet of a transfer
+ *
+ * Any packet goes in priv->recv_packet_buffer, with priv->recv_packet_length
+ * set to its length.
+ *
+ * @priv: Private data of the device, with no packet waiting to be received
+ */
+void sb_proto_recv(struct eth_sandbox_priv *priv);
+
+#endif
@@ -11,28 +11,20 @@
 #include <dm.h>
 #include <malloc.h>
 #include <net.h>
+#include <asm/eth.h>
 #include <asm/test.h>
+#include "sandbox-proto.h"
 
 DECLARE_GLOBAL_DATA_PTR;
 
-/**
- * struct eth_sandbox_priv - memory for sandbox mock driver
- *
- * fake_host_hwaddr: MAC address of mocked machine
- * fake_host_ipaddr: IP address of mocked machine
- * recv_packet_buffer: buffer of the packet returned as received
- * recv_packet_length: length of the packet returned as received
- */
-struct eth_sandbox_priv {
-	uchar fake_host_hwaddr[ARP_HLEN];
-	struct in_addr fake_host_ipaddr;
-	uchar *recv_packet_buffer;
-	int recv_packet_length;
-};
-
 static bool disabled[8] = {false};
 static bool skip_timeout;
 
+/* Receive batching, see sandbox_eth_rx_batch_setup() */
+static int rx_batch_max;
+static ulong rx_frames;
+static ulong rx_batches;
+
 /*
  * sandbox_eth_disable_response()
  *
@@ -54,6 +46,41 @@ void sandbox_eth_skip_timeout(void)
 	skip_timeout = true;
 }
 
+/*
+ * sandbox_eth_rx_batch_setup()
+ *
+ * Limit the packets handed over in each call to recv_batch() to @max, or
+ * lift the limit if it is 0, and clear the counts below
+ */
+void sandbox_eth_rx_batch_setup(int max)
+{
+	rx_batch_max = max;
+	rx_frames = 0;
+	rx_batches = 0;
+}
+
+/*
+ * sandbox_eth_rx_frames()
+ *
+ * Returns the number of packets handed over by recv_batch() since the last
+ * call to sandbox_eth_rx_batch_setup()
+ */
+ulong sandbox_eth_rx_frames(void)
+{
+	return rx_frames;
+}
+
+/*
+ * sandbox_eth_rx_batches()
+ *
+ * Returns the number of calls to recv_batch() which handed over any packets
+ * since the last call to sandbox_eth_rx_batch_setup()
+ */
+ulong sandbox_eth_rx_batches(void)
+{
+	return rx_batches;
+}
+
 static int sb_eth_start(struct udevice *dev)
 {
 	struct eth_sandbox_priv *priv = dev_get_priv(dev);
@@ -62,7 +89,9 @@ static int sb_eth_start(struct udevice *dev)
 
 	fdtdec_get_byte_array(gd->fdt_blob, dev->of_offset, "fake-host-hwaddr",
 			      priv->fake_host_hwaddr, ARP_HLEN);
+	priv->recv_slot = 0;
 	priv->recv_packet_buffer = net_rx_packets[0];
+	sb_proto_start(priv);
 	return 0;
 }
 
@@ -146,6 +175,8 @@ static int sb_eth_send(struct udevice *dev, void *packet, int length)
 
 				priv->recv_packet_length = length;
 			}
+		} else {
+			sb_proto_send(priv, eth, ip);
 		}
 	}
 
@@ -161,6 +192,10 @@ static int sb_eth_recv(struct udevice *dev, uchar **packetp)
 		skip_timeout = false;
 	}
 
+	/* With no reply waiting, a mock server may have more to send */
+	if (!priv->recv_packet_length)
+		sb_proto_recv(priv);
+
 	if (priv->recv_packet_length) {
 		int lcl_recv_packet_length = priv->recv_packet_length;
 
@@ -170,9 +205,41 @@ static int sb_eth_recv(struct udevice *dev, uchar **packetp)
 		*packetp = priv->recv_packet_buffer;
 		return lcl_recv_packet_length;
 	}
+
 	return 0;
 }
 
+/*
+ * Each packet is built in the next of net_rx_packets[], so that a batch
+ * stays intact while U-Boot works through it. Replies made from
+ * sb_eth_send() in the meantime go into the buffer after the batch.
+ */
+static int sb_eth_recv_batch(struct udevice *dev, uchar **packets,
+			     int *lengths, int max)
+{
+	struct eth_sandbox_priv *priv = dev_get_priv(dev);
+	int n, len;
+
+	max = min(max, PKTBUFSRX - 1);
+	if (rx_batch_max)
+		max = min(max, rx_batch_max);
+
+	for (n = 0; n < max; n++) {
+		len = sb_eth_recv(dev, &packets[n]);
+		if (!len)
+			break;
+		lengths[n] = len;
+		priv->recv_slot = (priv->recv_slot + 1) % PKTBUFSRX;
+		priv->recv_packet_buffer = net_rx_packets[priv->recv_slot];
+	}
+	if (n) {
+		rx_frames += n;
+		rx_batches++;
+	}
+
+	return n;
+}
+
 static void sb_eth_stop(struct udevice *dev)
 {
 	debug("eth_sandbox: Stop\n");
@@ -191,6 +258,7 @@ static const struct eth_ops sb_eth_ops = {
 	.start			= sb_eth_start,
 	.send			= sb_eth_send,
 	.recv			= sb_eth_recv,
+	.recv_batch		= sb_eth_recv_batch,
 	.stop			= sb_eth_stop,
 	.write_hwaddr		= sb_eth_write_hwaddr,
 };
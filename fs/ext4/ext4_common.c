@@ -24,6 +24,7 @@
 #include <ext4fs.h>
 #include <inttypes.h>
 #include <malloc.h>
+#include <slab.h>
 #include <stddef.h>
 #include <linux/stat.h>
 #include <linux/time.h>
@@ -39,6 +40,9 @@ uint32_t *ext4fs_indir2_block;
 int ext4fs_indir2_size;
 int ext4fs_indir2_blkno = -1;
 
+/* Directory nodes and symlink targets, released by ext4fs_close() */
+static struct slab_pool ext4fs_slab_pool = SLAB_POOL("ext4");
+
 uint32_t *ext4fs_indir3_block;
 int ext4fs_indir3_size;
 int ext4fs_indir3_blkno = -1;
@@ -1404,14 +1408,69 @@ void ext4fs_allocate_blocks(struct ext2_inode *file_inode,
 
 #endif
 
+/*
+ * Extent tree blocks, kept while the filesystem is open. Mapping a large
+ * file goes through the same index and leaf blocks over and over, so they
+ * are only read once.
+ */
+#define EXT4_EXT_CACHE_BLOCKS	8
+
+static struct {
+	unsigned long long blknr;	/* Filesystem block, 0 if unused */
+	char *buf;
+	ulong used;			/* When it was last used, for LRU */
+} ext4fs_ext_cache[EXT4_EXT_CACHE_BLOCKS];
+static ulong ext4fs_ext_uses;
+
+static void ext4fs_ext_cache_free(void)
+{
+	int i;
+
+	for (i = 0; i < EXT4_EXT_CACHE_BLOCKS; i++)
+		free(ext4fs_ext_cache[i].buf);
+	memset(ext4fs_ext_cache, '\0', sizeof(ext4fs_ext_cache));
+}
+
+static struct ext4_extent_header *ext4fs_read_ext_block
+	(struct ext2_data *data, unsigned long long blknr, int log2_blksz)
+{
+	int blksz = EXT2_BLOCK_SIZE(data);
+	int i, victim = 0;
+
+	for (i = 0; i < EXT4_EXT_CACHE_BLOCKS; i++) {
+		if (ext4fs_ext_cache[i].buf &&
+		    ext4fs_ext_cache[i].blknr == blknr) {
+			ext4fs_ext_cache[i].used = ++ext4fs_ext_uses;
+			return (struct ext4_extent_header *)
+				ext4fs_ext_cache[i].buf;
+		}
+		if (ext4fs_ext_cache[i].used < ext4fs_ext_cache[victim].used)
+			victim = i;
+	}
+
+	if (!ext4fs_ext_cache[victim].buf) {
+		ext4fs_ext_cache[victim].buf = memalign(ARCH_DMA_MINALIGN,
+							blksz);
+		if (!ext4fs_ext_cache[victim].buf)
+			return NULL;
+	}
+	ext4fs_ext_cache[victim].blknr = 0;
+	ext4fs_ext_cache[victim].used = 0;
+	if (!ext4fs_devread((lbaint_t)blknr << log2_blksz, 0, blksz,
+			    ext4fs_ext_cache[victim].buf))
+		return NULL;
+	ext4fs_ext_cache[victim].blknr = blknr;
+	ext4fs_ext_cache[victim].used = ++ext4fs_ext_uses;
+
+	return (struct ext4_extent_header *)ext4fs_ext_cache[victim].buf;
+}
+
 static struct ext4_extent_header *ext4fs_get_extent_block
-	(struct ext2_data *data, char *buf,
-		struct ext4_extent_header *ext_block,
+	(struct ext2_data *data, struct ext4_extent_header *ext_block,
 		uint32_t fileblock, int log2_blksz)
 {
 	struct ext4_extent_idx *index;
 	unsigned long long block;
-	int blksz = EXT2_BLOCK_SIZE(data);
 	int i;
 
 	while (1) {
@@ -1435,14 +1494,97 @@ static struct ext4_extent_header *ext4fs_get_extent_block
 		block = le16_to_cpu(index[i].ei_leaf_hi);
 		block = (block << 32) + le32_to_cpu(index[i].ei_leaf_lo);
 
-		if (ext4fs_devread((lbaint_t)block << log2_blksz, 0, blksz,
-				   buf))
-			ext_block = (struct ext4_extent_header *)buf;
-		else
+		ext_block = ext4fs_read_ext_block(data, block, log2_blksz);
+		if (!ext_block)
 			return 0;
 	}
 }
 
+/*
+ * Look up @fileblock in the extent tree of @inode. See ext4fs_map_blocks().
+ * A hole only runs as far as the next extent in the same leaf, which is
+ * all that is known without reading the next leaf.
+ */
+static long int ext4fs_map_extent(struct ext2_inode *inode, long int fileblock,
+				  long int count, unsigned long long *blknr,
+				  int log2_blksz)
+{
+	struct ext4_extent_header *ext_block;
+	struct ext4_extent *extent;
+	unsigned long long start;
+	long int first, len, end;
+	int i, entries;
+
+	ext_block = ext4fs_get_extent_block(ext4fs_root,
+					    (struct ext4_extent_header *)
+					    inode->b.blocks.dir_blocks,
+					    fileblock, log2_blksz);
+	if (!ext_block) {
+		printf("invalid extent block\n");
+		return -EINVAL;
+	}
+
+	extent = (struct ext4_extent *)(ext_block + 1);
+	entries = le16_to_cpu(ext_block->eh_entries);
+	for (i = 0; i < entries; i++) {
+		if (fileblock < le32_to_cpu(extent[i].ee_block))
+			break;
+	}
+	end = i < entries ? le32_to_cpu(extent[i].ee_block) : fileblock + 1;
+
+	*blknr = 0;
+	if (--i >= 0) {
+		first = le32_to_cpu(extent[i].ee_block);
+		len = le16_to_cpu(extent[i].ee_len);
+		if (len > EXT4_EXT_INIT_MAX_LEN)
+			len -= EXT4_EXT_INIT_MAX_LEN;
+		if (fileblock < first + len) {
+			count = min(count, first + len - fileblock);
+			if (le16_to_cpu(extent[i].ee_len) <=
+			    EXT4_EXT_INIT_MAX_LEN) {
+				start = le16_to_cpu(extent[i].ee_start_hi);
+				start = (start << 32) +
+					le32_to_cpu(extent[i].ee_start_lo);
+				*blknr = start + fileblock - first;
+			}
+			return count;
+		}
+	}
+
+	return min(count, end - fileblock);
+}
+
+/**
+ * ext4fs_map_blocks() - Find where a run of blocks of a file is on disk
+ *
+ * @inode:	Inode of the file
+ * @fileblock:	First block of the file to look up
+ * @count:	Most blocks wanted, at least 1
+ * @blknr:	Returns the filesystem block holding @fileblock, or 0 if it
+ *		is a hole or unwritten, so reads as zeroes
+ * @return number of blocks from @fileblock, at most @count, which follow on
+ * from one another on disk (or are all holes), or -ve on error
+ */
+long int ext4fs_map_blocks(struct ext2_inode *inode, long int fileblock,
+			   long int count, unsigned long long *blknr)
+{
+	int log2_blksz = LOG2_BLOCK_SIZE(ext4fs_root) -
+		get_fs()->dev_desc->log2blksz;
+	long int ret;
+
+	if (le32_to_cpu(inode->flags) & EXT4_EXTENTS_FL)
+		return ext4fs_map_extent(inode, fileblock, count, blknr,
+					 log2_blksz);
+
+	/* The indirect blocks are cached, so look up a block at a time */
+	ret = read_allocated_block(inode, fileblock);
+	if (ret < 0)
+		return ret;
+	*blknr = ret;
+
+	return 1;
+}
+
 static int ext4fs_blockgroup
 	(struct ext2_data *data, int group, struct ext2_block_group *blkgrp)
 {
@@ -1512,47 +1654,12 @@ long int read_allocated_block(struct ext2_inode *inode, int fileblock)
 		- get_fs()->dev_desc->log2blksz;
 
 	if (le32_to_cpu(inode->flags) & EXT4_EXTENTS_FL) {
-		char *buf = zalloc(blksz);
-		if (!buf)
-			return -ENOMEM;
-		struct ext4_extent_header *ext_block;
-		struct ext4_extent *extent;
-		int i = -1;
-		ext_block =
-			ext4fs_get_extent_block(ext4fs_root, buf,
-						(struct ext4_extent_header *)
-						inode->b.blocks.dir_blocks,
-						fileblock, log2_blksz);
-		if (!ext_block) {
-			printf("invalid extent block\n");
-			free(buf);
-			return -EINVAL;
-		}
-
-		extent = (struct ext4_extent *)(ext_block + 1);
-
-		do {
-			i++;
-			if (i >= le16_to_cpu(ext_block->eh_entries))
-				break;
-		} while (fileblock >= le32_to_cpu(extent[i].ee_block));
-		if (--i >= 0) {
-			fileblock -= le32_to_cpu(extent[i].ee_block);
-			if (fileblock >= le16_to_cpu(extent[i].ee_len)) {
-				free(buf);
-				return 0;
-			}
-
-			start = le16_to_cpu(extent[i].ee_start_hi);
-			start = (start << 32) +
-					le32_to_cpu(extent[i].ee_start_lo);
-			free(buf);
-			return fileblock + start;
-		}
+		status = ext4fs_map_extent(inode, fileblock, 1, &start,
+					   log2_blksz);
+		if (status < 0)
+			return status;
 
-		printf("Extent Error\n");
-		free(buf);
-		return -1;
+		return start;
 	}
 
 	/* Direct blocks. */
@@ -1854,6 +1961,7 @@ long int read_allocated_block(struct ext2_inode *inode, int fileblock)
  */
 void ext4fs_reinit_global(void)
 {
+	ext4fs_ext_cache_free();
 	if (ext4fs_indir1_block != NULL) {
 		free(ext4fs_indir1_block);
 		ext4fs_indir1_block = NULL;
@@ -1885,6 +1993,7 @@ void ext4fs_close(void)
 	}
 
 	ext4fs_reinit_global();
+	slab_release(&ext4fs_slab_pool);
 }
 
 int ext4fs_iterate_dir(struct ext2fs_node *dir, char *name,
@@ -1927,7 +2036,8 @@ int ext4fs_iterate_dir(struct ext2fs_node *dir, char *name,
 			if (status < 0)
 				return 0;
 
-			fdiro = zalloc(sizeof(struct ext2fs_node));
+			fdiro = slab_calloc(&ext4fs_slab_pool,
+					    sizeof(struct ext2fs_node));
 			if (!fdiro)
 				return 0;
 
@@ -2029,7 +2139,8 @@ static char *ext4fs_read_symlink(struct ext2fs_node *node)
 		if (status == 0)
 			return 0;
 	}
-	symlink = zalloc(__le32_to_cpu(diro->inode.size) + 1);
+	symlink = slab_calloc(&ext4fs_slab_pool,
+			      __le32_to_cpu(diro->inode.size) + 1);
 	if (!symlink)
 		return 0;
 
@@ -24,6 +24,7 @@
 #include <common.h>
 #include <ext_common.h>
 #include <ext4fs.h>
+#include <fs.h>
 #include "ext4_common.h"
 #include <div64.h>
 
@@ -41,117 +42,80 @@ void ext4fs_free_node(struct ext2fs_node *node, struct ext2fs_node *currroot)
 		free(node);
 }
 
+/* Largest single device read, which must fit ext4fs_devread()'s length */
+#define EXT4_MAX_READ_BYTES	(1 << 30)
+
 /*
- * Taken from openmoko-kernel mailing list: By Andy green
- * Optimized read file API : collects and defers contiguous sector
- * reads into one potentially more efficient larger sequential read action
+ * Read a file as runs of blocks which follow on from one another on disk.
+ * Each run is looked up once, adjacent extents are merged, and the whole
+ * run is read straight into the buffer.
  */
 int ext4fs_read_file(struct ext2fs_node *node, loff_t pos,
 		loff_t len, char *buf, loff_t *actread)
 {
 	struct ext_filesystem *fs = get_fs();
-	int i;
-	lbaint_t blockcnt;
 	int log2blksz = fs->dev_desc->log2blksz;
 	int log2_fs_blocksize = LOG2_BLOCK_SIZE(node->data) - log2blksz;
 	int blocksize = (1 << (log2_fs_blocksize + log2blksz));
 	unsigned int filesize = __le32_to_cpu(node->inode.size);
-	lbaint_t previous_block_number = -1;
-	lbaint_t delayed_start = 0;
-	lbaint_t delayed_extent = 0;
-	lbaint_t delayed_skipfirst = 0;
-	lbaint_t delayed_next = 0;
-	char *delayed_buf = NULL;
-	short status;
+	ulong chunk = fs_read_notify_chunk();
+	long int blockcnt, fileblock, max_run, n, more;
+	unsigned long long blknr, next;
+	int skipfirst, extent;
+
+	*actread = 0;
+	if (pos >= filesize)
+		return 0;
 
 	/* Adjust len so it we can't read past the end of the file. */
-	if (len > filesize)
-		len = filesize;
+	if (len > filesize - pos)
+		len = filesize - pos;
 
 	blockcnt = lldiv(((len + pos) + blocksize - 1), blocksize);
-
-	for (i = lldiv(pos, blocksize); i < blockcnt; i++) {
-		lbaint_t blknr;
-		int blockoff = pos - (blocksize * i);
-		int blockend = blocksize;
-		int skipfirst = 0;
-		blknr = read_allocated_block(&(node->inode), i);
-		if (blknr < 0)
+	fileblock = lldiv(pos, blocksize);
+	skipfirst = pos - (loff_t)fileblock * blocksize;
+
+	/* Stop early if someone is processing data as it lands */
+	max_run = EXT4_MAX_READ_BYTES / blocksize;
+	if (chunk)
+		max_run = min(max_run, (long int)DIV_ROUND_UP(chunk,
+							      blocksize));
+
+	for (; fileblock < blockcnt; fileblock += n) {
+		n = ext4fs_map_blocks(&node->inode, fileblock,
+				      min(blockcnt - fileblock, max_run),
+				      &blknr);
+		if (n < 0)
 			return -1;
 
-		blknr = blknr << log2_fs_blocksize;
-
-		/* Last block.  */
-		if (i == blockcnt - 1) {
-			blockend = (len + pos) - (blocksize * i);
-
-			/* The last portion is exactly blocksize. */
-			if (!blockend)
-				blockend = blocksize;
+		/* Take in the following runs while they carry straight on */
+		while (fileblock + n < blockcnt && n < max_run) {
+			more = ext4fs_map_blocks(&node->inode, fileblock + n,
+						 min(blockcnt - fileblock - n,
+						     max_run - n), &next);
+			if (more < 0)
+				return -1;
+			if (blknr ? next != blknr + n : next != 0)
+				break;
+			n += more;
 		}
 
-		/* First block. */
-		if (i == lldiv(pos, blocksize)) {
-			skipfirst = blockoff;
-			blockend -= skipfirst;
-		}
+		extent = min((loff_t)n * blocksize - skipfirst, len);
 		if (blknr) {
-			int status;
-
-			if (previous_block_number != -1) {
-				if (delayed_next == blknr) {
-					delayed_extent += blockend;
-					delayed_next += blockend >> log2blksz;
-				} else {	/* spill */
-					status = ext4fs_devread(delayed_start,
-							delayed_skipfirst,
-							delayed_extent,
-							delayed_buf);
-					if (status == 0)
-						return -1;
-					previous_block_number = blknr;
-					delayed_start = blknr;
-					delayed_extent = blockend;
-					delayed_skipfirst = skipfirst;
-					delayed_buf = buf;
-					delayed_next = blknr +
-						(blockend >> log2blksz);
-				}
-			} else {
-				previous_block_number = blknr;
-				delayed_start = blknr;
-				delayed_extent = blockend;
-				delayed_skipfirst = skipfirst;
-				delayed_buf = buf;
-				delayed_next = blknr +
-					(blockend >> log2blksz);
-			}
+			if (!ext4fs_devread((lbaint_t)blknr <<
+					    log2_fs_blocksize, skipfirst,
+					    extent, buf))
+				return -1;
 		} else {
-			if (previous_block_number != -1) {
-				/* spill */
-				status = ext4fs_devread(delayed_start,
-							delayed_skipfirst,
-							delayed_extent,
-							delayed_buf);
-				if (status == 0)
-					return -1;
-				previous_block_number = -1;
-			}
-			memset(buf, 0, blocksize - skipfirst);
+			memset(buf, 0, extent);
 		}
-		buf += blocksize - skipfirst;
-	}
-	if (previous_block_number != -1) {
-		/* spill */
-		status = ext4fs_devread(delayed_start,
-					delayed_skipfirst, delayed_extent,
-					delayed_buf);
-		if (status == 0)
-			return -1;
-		previous_block_number = -1;
+		fs_read_notify(buf, extent);
+		buf += extent;
+		len -= extent;
+		*actread += extent;
+		skipfirst = 0;
 	}
 
-	*actread  = len;
 	return 0;
 }
 
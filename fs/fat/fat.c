@@ -13,11 +13,13 @@
 #include <config.h>
 #include <exports.h>
 #include <fat.h>
+#include <fs.h>
 #include <asm/byteorder.h>
 #include <part.h>
 #include <malloc.h>
 #include <linux/compiler.h>
 #include <linux/ctype.h>
+#include <linux/math64.h>
 
 #ifdef CONFIG_SUPPORT_VFAT
 static const int vfat_enabled = 1;
@@ -314,6 +316,162 @@ get_cluster(fsdata *mydata, __u32 clustnum, __u8 *buffer, unsigned long size)
 	return 0;
 }
 
+/*
+ * Cluster chains of recently read files, kept as runs of consecutive
+ * clusters.
+ *
+ * Walking the FAT one entry at a time is the slow part of reading a large
+ * file, and the same file is often read more than once (e.g. a kernel
+ * loaded in pieces). A chain is found again by the volume serial number and
+ * the first cluster, size and modification time of the file, so that a
+ * different card or a rewritten file is not mistaken for a cached one.
+ * Writing raw blocks to the device, or rescanning it, gives it a new
+ * change_id, which drops its chains even if the volume looks the same.
+ */
+struct fat_extent {
+	__u32 clust;		/* First cluster of the run */
+	__u32 count;		/* Number of clusters in the run */
+};
+
+struct fat_extent_file {
+	block_dev_desc_t *dev;	/* Device, NULL if the entry is not valid */
+	ulong change_id;	/* The device's change_id when it was read */
+	lbaint_t part_start;	/* Start of the partition on the device */
+	__u32 vol_id;		/* Volume serial number */
+	__u32 start;		/* First cluster of the file */
+	__u32 size;		/* Size of the file in bytes */
+	__u16 time, date;	/* Modification time of the file */
+	struct fat_extent *ext;	/* Runs of clusters, in file order */
+	int runs;		/* Number of runs in ext */
+	int max_runs;		/* Number of runs ext has room for */
+	ulong used;		/* When the entry was last used */
+};
+
+static struct fat_extent_file fat_extent_cache[CONFIG_FS_FAT_EXTENT_FILES];
+static ulong fat_extent_uses;
+
+void fat_extent_flush(void)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(fat_extent_cache); i++)
+		free(fat_extent_cache[i].ext);
+	memset(fat_extent_cache, '\0', sizeof(fat_extent_cache));
+}
+
+/*
+ * Add a cluster to the end of a file's chain, extending the last run if
+ * it follows on from it.
+ * Return 0 on success, -1 if out of memory.
+ */
+static int fat_extent_add(struct fat_extent_file *file, __u32 clust)
+{
+	struct fat_extent *ext;
+	int max_runs;
+
+	if (file->runs) {
+		ext = &file->ext[file->runs - 1];
+		if (ext->clust + ext->count == clust) {
+			ext->count++;
+			return 0;
+		}
+	}
+
+	if (file->runs == file->max_runs) {
+		max_runs = file->max_runs ? file->max_runs * 2 : 16;
+		ext = realloc(file->ext, max_runs * sizeof(*ext));
+		if (!ext)
+			return -1;
+		file->ext = ext;
+		file->max_runs = max_runs;
+	}
+	ext = &file->ext[file->runs++];
+	ext->clust = clust;
+	ext->count = 1;
+
+	return 0;
+}
+
+/*
+ * Walk the FAT to find the first 'clusters' clusters of a file.
+ * Return 0 on success, 1 if the chain ends early, in which case the clusters
+ * found so far are kept, or -1 if out of memory.
+ */
+static int fat_extent_build(fsdata *mydata, struct fat_extent_file *file,
+			    __u32 clusters)
+{
+	__u32 clust = file->start;
+	__u32 n;
+
+	file->runs = 0;
+	for (n = 0; n < clusters; n++) {
+		if (n)
+			clust = get_fatent(mydata, clust);
+		if (CHECK_CLUST(clust, mydata->fatsize)) {
+			debug("curclust: 0x%x\n", clust);
+			debug("Invalid FAT entry\n");
+			return 1;
+		}
+		if (fat_extent_add(file, clust))
+			return -1;
+	}
+
+	return 0;
+}
+
+/*
+ * Get the runs of clusters holding the file associated with 'dentptr', from
+ * the cache if possible. A chain which ends early is returned but is not
+ * remembered.
+ * Return NULL if out of memory.
+ */
+static struct fat_extent_file *fat_extent_get(fsdata *mydata,
+					      dir_entry *dentptr)
+{
+	unsigned int bytesperclust = mydata->clust_size * mydata->sect_size;
+	struct fat_extent_file *file, *victim = fat_extent_cache;
+	__u32 size = FAT2CPU32(dentptr->size);
+	__u32 start = START(dentptr);
+	int i, ret;
+
+	for (i = 0; i < ARRAY_SIZE(fat_extent_cache); i++) {
+		file = &fat_extent_cache[i];
+		if (file->dev == cur_dev &&
+		    file->change_id == cur_dev->change_id &&
+		    file->part_start == cur_part_info.start &&
+		    file->vol_id == mydata->vol_id && file->start == start &&
+		    file->size == size && file->time == dentptr->time &&
+		    file->date == dentptr->date) {
+			file->used = ++fat_extent_uses;
+			return file;
+		}
+		if (file->used < victim->used)
+			victim = file;
+	}
+
+	file = victim;
+	file->dev = NULL;
+	file->used = 0;
+	file->change_id = cur_dev->change_id;
+	file->part_start = cur_part_info.start;
+	file->vol_id = mydata->vol_id;
+	file->start = start;
+	file->size = size;
+	file->time = dentptr->time;
+	file->date = dentptr->date;
+	ret = fat_extent_build(mydata, file, DIV_ROUND_UP(size, bytesperclust));
+	if (ret < 0) {
+		debug("Error: allocating memory\n");
+		return NULL;
+	}
+	if (!ret) {
+		file->dev = cur_dev;
+		file->used = ++fat_extent_uses;
+	}
+
+	return file;
+}
+
 /*
  * Read at most 'maxsize' bytes from 'pos' in the file associated with 'dentptr'
  * into 'buffer'.
@@ -327,9 +485,12 @@ static int get_contents(fsdata *mydata, dir_entry *dentptr, loff_t pos,
 {
 	loff_t filesize = FAT2CPU32(dentptr->size);
 	unsigned int bytesperclust = mydata->clust_size * mydata->sect_size;
-	__u32 curclust = START(dentptr);
-	__u32 endclust, newclust;
+	ulong chunk = fs_read_notify_chunk();
+	struct fat_extent_file *file;
+	struct fat_extent *ext;
+	__u32 skip, offset, clusters;
 	loff_t actsize;
+	int run;
 
 	*gotsize = 0;
 	debug("Filesize: %llu bytes\n", filesize);
@@ -344,92 +505,62 @@ static int get_contents(fsdata *mydata, dir_entry *dentptr, loff_t pos,
 
 	debug("%llu bytes\n", filesize);
 
-	actsize = bytesperclust;
-
-	/* go to cluster at pos */
-	while (actsize <= pos) {
-		curclust = get_fatent(mydata, curclust);
-		if (CHECK_CLUST(curclust, mydata->fatsize)) {
-			debug("curclust: 0x%x\n", curclust);
-			debug("Invalid FAT entry\n");
-			return 0;
-		}
-		actsize += bytesperclust;
-	}
-
-	/* actsize > pos */
-	actsize -= bytesperclust;
-	filesize -= actsize;
-	pos -= actsize;
-
-	/* align to beginning of next cluster if any */
-	if (pos) {
-		actsize = min(filesize, (loff_t)bytesperclust);
-		if (get_cluster(mydata, curclust, get_contents_vfatname_block,
-				(int)actsize) != 0) {
-			printf("Error reading cluster\n");
-			return -1;
-		}
-		filesize -= actsize;
-		actsize -= pos;
-		memcpy(buffer, get_contents_vfatname_block + pos, actsize);
-		*gotsize += actsize;
-		if (!filesize)
-			return 0;
-		buffer += actsize;
-
-		curclust = get_fatent(mydata, curclust);
-		if (CHECK_CLUST(curclust, mydata->fatsize)) {
-			debug("curclust: 0x%x\n", curclust);
-			debug("Invalid FAT entry\n");
-			return 0;
-		}
-	}
-
-	actsize = bytesperclust;
-	endclust = curclust;
+	file = fat_extent_get(mydata, dentptr);
+	if (!file)
+		return -1;
 
-	do {
-		/* search for consecutive clusters */
-		while (actsize < filesize) {
-			newclust = get_fatent(mydata, endclust);
-			if ((newclust - 1) != endclust)
-				goto getit;
-			if (CHECK_CLUST(newclust, mydata->fatsize)) {
-				debug("curclust: 0x%x\n", newclust);
-				debug("Invalid FAT entry\n");
-				return 0;
+	/* go to the run holding pos */
+	skip = div_u64_rem(pos, bytesperclust, &offset);
+	filesize -= pos;
+	for (run = 0; run < file->runs && skip >= file->ext[run].count; run++)
+		skip -= file->ext[run].count;
+
+	while (filesize && run < file->runs) {
+		ext = &file->ext[run];
+		if (offset) {
+			/* the first cluster is only partly wanted */
+			actsize = min(filesize + offset, (loff_t)bytesperclust);
+			if (get_cluster(mydata, ext->clust + skip,
+					get_contents_vfatname_block,
+					(int)actsize) != 0) {
+				printf("Error reading cluster\n");
+				return -1;
+			}
+			actsize -= offset;
+			memcpy(buffer, get_contents_vfatname_block + offset,
+			       actsize);
+			clusters = 1;
+			offset = 0;
+		} else {
+			/* read as much of the run as we can in one go */
+			actsize = min(filesize,
+				      (loff_t)(ext->count - skip) * bytesperclust);
+			/* Stop early if someone is processing data as it lands */
+			if (chunk && actsize > chunk)
+				actsize = min(actsize,
+					      (loff_t)roundup(chunk, bytesperclust));
+			clusters = DIV_ROUND_UP(actsize, bytesperclust);
+			if (get_cluster(mydata, ext->clust + skip, buffer,
+					(int)actsize) != 0) {
+				printf("Error reading cluster\n");
+				return -1;
 			}
-			endclust = newclust;
-			actsize += bytesperclust;
-		}
-
-		/* get remaining bytes */
-		actsize = filesize;
-		if (get_cluster(mydata, curclust, buffer, (int)actsize) != 0) {
-			printf("Error reading cluster\n");
-			return -1;
 		}
+		fs_read_notify(buffer, actsize);
 		*gotsize += actsize;
-		return 0;
-getit:
-		if (get_cluster(mydata, curclust, buffer, (int)actsize) != 0) {
-			printf("Error reading cluster\n");
-			return -1;
-		}
-		*gotsize += (int)actsize;
 		filesize -= actsize;
 		buffer += actsize;
 
-		curclust = get_fatent(mydata, endclust);
-		if (CHECK_CLUST(curclust, mydata->fatsize)) {
-			debug("curclust: 0x%x\n", curclust);
-			printf("Invalid FAT entry\n");
-			return 0;
+		skip += clusters;
+		if (skip == ext->count) {
+			run++;
+			skip = 0;
 		}
-		actsize = bytesperclust;
-		endclust = curclust;
-	} while (1);
+	}
+	if (filesize)
+		debug("Invalid FAT entry\n");
+
+	return 0;
 }
 
 /*
@@ -833,6 +964,7 @@ int do_fat_read_at(const char *filename, loff_t pos, void *buffer,
 		debug("Error: reading boot sector\n");
 		return -1;
 	}
+	memcpy(&mydata->vol_id, volinfo.volume_id, sizeof(mydata->vol_id));
 
 	if (mydata->fatsize == 32) {
 		root_cluster = bs.root_cluster;
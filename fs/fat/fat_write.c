@@ -944,6 +944,9 @@ static int do_fat_write(const char *filename, void *buffer, loff_t size,
 	*actwrite = size;
 	dir_curclust = 0;
 
+	/* Clusters may be freed and reused, so forget the cached chains */
+	fat_extent_flush();
+
 	if (read_bootsectandvi(&bs, &volinfo, &mydata->fatsize)) {
 		debug("error: reading boot sector\n");
 		return -1;
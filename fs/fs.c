@@ -17,11 +17,15 @@
 #include <config.h>
 #include <errno.h>
 #include <common.h>
+#include <decomp_stream.h>
 #include <mapmem.h>
 #include <part.h>
 #include <ext4fs.h>
 #include <fat.h>
 #include <fs.h>
+#include <hash.h>
+#include <image.h>
+#include <malloc.h>
 #include <sandboxfs.h>
 #include <asm/io.h>
 #include <div64.h>
@@ -310,6 +314,128 @@ int fs_read(const char *filename, ulong addr, loff_t offset, loff_t len,
 	return ret;
 }
 
+#ifdef CONFIG_FS_READ_HASH
+/*
+ * Filesystems report file data in pieces of at most this size, which is
+ * large enough for efficient multi-block device reads but small enough for
+ * the data to still be in the cache when it is hashed.
+ */
+#define FS_READ_HASH_CHUNK	(256 << 10)
+
+static struct hash_stream *fs_read_hs;	/* Stream being fed, or NULL */
+static const uint8_t *fs_read_next;	/* Next byte expected from the fs */
+static int fs_read_hash_err;
+
+void fs_read_notify(const void *buf, ulong len)
+{
+	if (!fs_read_hs || buf != fs_read_next)
+		return;
+	if (hash_stream_update(fs_read_hs, buf, len)) {
+		fs_read_hash_err = -EIO;
+		fs_read_hs = NULL;
+		return;
+	}
+	fs_read_next += len;
+}
+
+ulong fs_read_notify_chunk(void)
+{
+	return fs_read_hs ? FS_READ_HASH_CHUNK : 0;
+}
+
+int fs_read_hash(const char *filename, ulong addr, loff_t offset, loff_t len,
+		 loff_t *actread, struct hash_stream *hs)
+{
+	uint8_t *buf;
+	ulong done;
+	int ret;
+
+	buf = map_sysmem(addr, len);
+	fs_read_hs = hs;
+	fs_read_next = buf;
+	fs_read_hash_err = 0;
+	ret = fs_read(filename, addr, offset, len, actread);
+	fs_read_hs = NULL;
+	done = fs_read_next - buf;
+
+	if (!ret && fs_read_hash_err) {
+		printf("** Unable to hash file %s **\n", filename);
+		ret = -1;
+	}
+
+	/* Hash anything the filesystem did not report as it was read */
+	if (!ret && done < *actread &&
+	    hash_stream_update(hs, buf + done, *actread - done)) {
+		printf("** Unable to hash file %s **\n", filename);
+		ret = -1;
+	}
+	unmap_sysmem(buf);
+
+	return ret;
+}
+#endif
+
+#ifdef CONFIG_FS_READ_DECOMP
+/*
+ * The file is read in pieces of this size through a bounce buffer, each
+ * piece being decompressed while it is still in the cache
+ */
+#define FS_READ_DECOMP_CHUNK	(256 << 10)
+
+int fs_read_decomp(const char *filename, ulong addr, ulong size, int comp,
+		   loff_t *actread)
+{
+	struct fstype_info *info = fs_get_info(fs_type);
+	struct decomp_stream ds;
+	loff_t file_size, pos, got;
+	void *buf, *dst;
+	ulong len;
+	int ret, err;
+
+	ret = info->size(filename, &file_size);
+	if (ret < 0) {
+		printf("** Unable to read file %s **\n", filename);
+		fs_close();
+		return -1;
+	}
+
+	buf = malloc(FS_READ_DECOMP_CHUNK);
+	dst = map_sysmem(addr, size);
+	ret = buf ? decomp_stream_start(&ds, comp, dst, size) : -ENOMEM;
+	if (ret) {
+		printf("** Unable to decompress %s: %d **\n", filename, ret);
+		unmap_sysmem(dst);
+		free(buf);
+		fs_close();
+		return -1;
+	}
+
+	for (pos = 0, err = 0; pos < file_size && !err; pos += got) {
+		got = min_t(loff_t, file_size - pos, FS_READ_DECOMP_CHUNK);
+		ret = info->read(filename, buf, pos, got, &got);
+		if (ret < 0 || !got)
+			break;
+		err = decomp_stream_update(&ds, buf, got);
+	}
+	if (pos < file_size && !err) {
+		printf("** Unable to read file %s **\n", filename);
+		ret = -1;
+	}
+	err = decomp_stream_finish(&ds, &len);
+	if (!ret && err) {
+		printf("** Unable to decompress file %s: %d **\n", filename,
+		       err);
+		ret = -1;
+	}
+	*actread = len;
+	unmap_sysmem(dst);
+	free(buf);
+	fs_close();
+
+	return ret;
+}
+#endif
+
 int fs_write(const char *filename, ulong addr, loff_t offset, loff_t len,
 	     loff_t *actwrite)
 {
@@ -418,6 +544,120 @@ int do_load(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[],
 	return 0;
 }
 
+#ifdef CONFIG_FS_READ_HASH
+int do_load_hash(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[],
+		int fstype)
+{
+	uint8_t output[HASH_MAX_DIGEST_SIZE];
+	struct hash_stream hs;
+	const char *algo_name;
+	unsigned long addr;
+	loff_t len_read;
+	unsigned long time;
+	char *ep;
+	int ret;
+
+	if (argc < 6 || argc > 7)
+		return CMD_RET_USAGE;
+
+	algo_name = argv[1];
+	addr = simple_strtoul(argv[4], &ep, 16);
+	if (ep == argv[4] || *ep != '\0')
+		return CMD_RET_USAGE;
+
+	if (fs_set_blk_dev(argv[2], argv[3], fstype))
+		return 1;
+
+	if (hash_stream_start(&hs, algo_name)) {
+		printf("Unknown hash algorithm '%s'\n", algo_name);
+		fs_close();
+		return CMD_RET_USAGE;
+	}
+
+	time = get_timer(0);
+	ret = fs_read_hash(argv[5], addr, 0, 0, &len_read, &hs);
+	time = get_timer(time);
+	if (ret < 0) {
+		hash_stream_finish(&hs, output, sizeof(output));
+		return 1;
+	}
+	if (hash_stream_finish(&hs, output, sizeof(output))) {
+		printf("** Unable to hash file %s **\n", argv[5]);
+		return 1;
+	}
+
+	printf("%llu bytes read and hashed in %lu ms", len_read, time);
+	if (time > 0) {
+		puts(" (");
+		print_size(div_u64(len_read, time) * 1000, "/s");
+		puts(")");
+	}
+	puts("\n");
+
+	setenv_hex("filesize", len_read);
+
+	if (argc == 7) {
+		if (hash_verify(hs.algo, addr, len_read, output, argv[6], 1))
+			return 1;
+	} else {
+		hash_show(hs.algo, addr, len_read, output);
+		puts("\n");
+	}
+
+	return 0;
+}
+#endif
+
+#ifdef CONFIG_FS_READ_DECOMP
+int do_load_decomp(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[],
+		   int fstype)
+{
+	unsigned long addr, size;
+	loff_t len_read;
+	unsigned long time;
+	char *ep;
+	int comp;
+	int ret;
+
+	if (argc < 6 || argc > 7)
+		return CMD_RET_USAGE;
+
+	comp = genimg_get_comp_id(argv[1]);
+	if (comp < 0) {
+		printf("Unknown compression type '%s'\n", argv[1]);
+		return CMD_RET_USAGE;
+	}
+	addr = simple_strtoul(argv[4], &ep, 16);
+	if (ep == argv[4] || *ep != '\0')
+		return CMD_RET_USAGE;
+	if (argc == 7)
+		size = simple_strtoul(argv[6], NULL, 16);
+	else
+		size = CONFIG_SYS_BOOTM_LEN;
+
+	if (fs_set_blk_dev(argv[2], argv[3], fstype))
+		return 1;
+
+	time = get_timer(0);
+	ret = fs_read_decomp(argv[5], addr, size, comp, &len_read);
+	time = get_timer(time);
+	if (ret < 0)
+		return 1;
+
+	printf("%llu bytes read and decompressed in %lu ms", len_read, time);
+	if (time > 0) {
+		puts(" (");
+		print_size(div_u64(len_read, time) * 1000, "/s");
+		puts(")");
+	}
+	puts("\n");
+
+	setenv_hex("filesize", len_read);
+
+	return 0;
+}
+#endif
+
 int do_ls(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[],
 	int fstype)
 {
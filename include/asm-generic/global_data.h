@@ -68,10 +68,16 @@ typedef struct global_data {
 	struct udevice	*dm_root;	/* Root instance for Driver Model */
 	struct udevice	*dm_root_f;	/* Pre-relocation root instance */
 	struct list_head uclass_root;	/* Head of core tree */
+#ifdef CONFIG_DM_INDEX
+	struct uclass	**uclass_index;	/* Uclass for each uclass_id */
+#endif
 #endif
 
 	const void *fdt_blob;	/* Our device tree, NULL if none */
 	void *new_fdt;		/* Relocated FDT */
+#ifdef CONFIG_OF_INDEX
+	struct fdtdec_index *fdt_index;	/* Lookup tables for fdt_blob */
+#endif
 	unsigned long fdt_size;	/* Space reserved for relocated FDT */
 	struct jt_funcs *jt;		/* jump table */
 	char env_buf[32];	/* buffer for getenv() before reloc. */
@@ -90,6 +96,7 @@ typedef struct global_data {
 	unsigned long malloc_base;	/* base address of early malloc() */
 	unsigned long malloc_limit;	/* limit address */
 	unsigned long malloc_ptr;	/* current address */
+	unsigned long malloc_peak;	/* highest value of malloc_ptr */
 #endif
 #ifdef CONFIG_PCI
 	struct pci_controller *hose;	/* PCI hose for early use */
@@ -16,12 +16,21 @@
 #define CONFIG_BOOTSTAGE_USER_COUNT	20
 #endif
 
+#ifndef CONFIG_BOOTSTAGE_SPAN_COUNT
+#define CONFIG_BOOTSTAGE_SPAN_COUNT	128
+#endif
+
 /* Flags for each bootstage record */
 enum bootstage_flags {
 	BOOTSTAGEF_ERROR	= 1 << 0,	/* Error record */
 	BOOTSTAGEF_ALLOC	= 1 << 1,	/* Allocate an id */
 };
 
+/* Flags for each bootstage span */
+enum bootstage_span_flags {
+	BOOTSTAGE_SPANF_PROBE	= 1 << 0,	/* Probing a device */
+};
+
 /* bootstate sub-IDs used for kernel and ramdisk ranges */
 enum {
 	BOOTSTAGE_SUB_FORMAT,
@@ -329,6 +338,79 @@ int bootstage_stash(void *base, int size);
  */
 int bootstage_unstash(void *base, int size);
 
+/**
+ * Start a nested boot span
+ *
+ * Spans record how long each step of the boot takes, and which step it was
+ * part of. A span started while another one is open becomes its child, so
+ * the spans form a tree such as board_init_r > initr_dm > probe mmc. If a
+ * span with the same name, flags and parent has been run before, the time
+ * is added to that span and its count is incremented.
+ *
+ * Spans are only recorded once the first bootstage mark has been made,
+ * since the timer may not be usable before that.
+ *
+ * @param name	Name of span, or NULL to identify it by @func
+ * @param func	Address of function being run (before relocation), or 0
+ * @param flags	Flags (BOOTSTAGE_SPANF_...)
+ * @return span number to pass to bootstage_span_end(), or -1 if the span is
+ *		not recorded
+ */
+int bootstage_span_start(const char *name, ulong func, int flags);
+
+/**
+ * End a boot span
+ *
+ * Any spans started inside this one and still open are abandoned.
+ *
+ * @param span	Span number returned by bootstage_span_start(), or -1
+ * @return time spent in this run of the span, in microseconds
+ */
+uint32_t bootstage_span_end(int span);
+
+/**
+ * End all open boot spans
+ *
+ * This is used when control passes on without returning, for example on
+ * relocation and on reaching the main loop.
+ */
+void bootstage_span_close(void);
+
+/**
+ * Write the boot spans in folded-stack format
+ *
+ * Each line holds the path to a span, with the names separated by ';',
+ * followed by the time spent in the span itself (not in its children) in
+ * microseconds. This is the input format of flamegraph.pl.
+ *
+ * @param buf	Buffer to write to, or NULL to print to the console
+ * @param size	Size of buffer
+ * @return number of bytes written, or -ENOSPC if the buffer is too small
+ */
+int bootstage_folded(char *buf, int size);
+
+/**
+ * Get the parent and run count of a boot span
+ *
+ * @param span		Span number returned by bootstage_span_start()
+ * @param parentp	Returns the parent span number, or -1 if none
+ * @return number of times the span was started, or -1 if @span is not valid
+ */
+int bootstage_span_info(int span, int *parentp);
+
+#ifdef CONFIG_UT_BOOTSTAGE
+/**
+ * Switch to or from a separate set of boot spans for tests
+ *
+ * Tests call this with true before starting their own spans, which then
+ * start with none recorded. Calling it with false puts back the spans
+ * recorded during boot.
+ *
+ * @param test	true to switch to the test spans, false to switch back
+ */
+void bootstage_span_test_state(bool test);
+#endif
+
 #else
 static inline ulong bootstage_add_record(enum bootstage_id id,
 		const char *name, int flags, ulong mark)
@@ -389,6 +471,21 @@ static inline int bootstage_unstash(void *base, int size)
 {
 	return 0;	/* Pretend to succeed */
 }
+
+static inline int bootstage_span_start(const char *name, ulong func,
+				       int flags)
+{
+	return -1;
+}
+
+static inline uint32_t bootstage_span_end(int span)
+{
+	return 0;
+}
+
+static inline void bootstage_span_close(void)
+{
+}
 #endif /* CONFIG_BOOTSTAGE */
 
 /* Helper macro for adding a bootstage to a line of code */
@@ -33,6 +33,9 @@
 
 #undef CONFIG_DM_WARN
 #undef CONFIG_DM_DEVICE_REMOVE
+#undef CONFIG_DM_INDEX
+#undef CONFIG_OF_INDEX
+#undef CONFIG_DECOMP_STREAM
 #undef CONFIG_DM_SEQ_ALIAS
 #undef CONFIG_DM_STDIO
 
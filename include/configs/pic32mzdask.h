@@ -162,6 +162,7 @@
  */
 #define CONFIG_PIC32_SDHCI
 #define CONFIG_SDHCI
+#define CONFIG_MMC_SDHCI_ADMA
 #define CONFIG_MMC
 #define CONFIG_GENERIC_MMC
 #define CONFIG_CMD_MMC
@@ -90,6 +90,15 @@
 #define CONFIG_SPI_FLASH_STMICRO
 #define CONFIG_SPI_FLASH_WINBOND
 
+/* MMC - an emulated SDHCI controller */
+#define CONFIG_MMC
+#define CONFIG_GENERIC_MMC
+#define CONFIG_CMD_MMC
+#define CONFIG_SDHCI
+#define CONFIG_MMC_SDHCI_IO_ACCESSORS
+#define CONFIG_MMC_SDHCI_ADMA
+#define CONFIG_SANDBOX_SDHCI
+
 #define CONFIG_CMD_I2C
 #define CONFIG_I2C_EDID
 #define CONFIG_I2C_EEPROM
@@ -139,6 +148,8 @@
 #define CONFIG_BOOTP_SEND_HOSTNAME
 #define CONFIG_BOOTP_SERVERIP
 #define CONFIG_IP_DEFRAG
+#define CONFIG_NET_MAXDEFRAG	32768
+#define CONFIG_SYS_RX_ETH_BUFFER	32
 
 /* Can't boot elf images */
 #undef CONFIG_CMD_ELF
@@ -208,6 +219,7 @@
 #define CONFIG_BZIP2
 #define CONFIG_LZO
 #define CONFIG_LZMA
+#define CONFIG_LZ4
 
 #define CONFIG_CMD_LZMADEC
 #define CONFIG_CMD_USB
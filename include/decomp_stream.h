@@ -0,0 +1,74 @@
+/*
+ * Streaming decompression of images as they are loaded
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#ifndef __DECOMP_STREAM_H
+#define __DECOMP_STREAM_H
+
+/**
+ * struct decomp_stream - State for decompressing data which arrives in pieces
+ *
+ * This lets a loader such as the filesystem layer or TFTP decompress an
+ * image into its final place piece by piece, while each piece is still in
+ * the cache, rather than reading the whole compressed image into a staging
+ * buffer and decompressing it in a second pass.
+ *
+ * @comp:	Compression type (IH_COMP_...)
+ * @ctx:	Decompressor state, private to lib/decomp_stream.c
+ * @dst:	Start of the output buffer
+ * @size:	Size of the output buffer in bytes
+ * @len:	Number of bytes written to @dst so far
+ */
+struct decomp_stream {
+	int comp;
+	void *ctx;
+	uchar *dst;
+	ulong size;
+	ulong len;
+};
+
+/**
+ * decomp_stream_start() - Start decompressing a stream of data
+ *
+ * @ds:		Stream state to set up
+ * @comp:	Compression type (IH_COMP_...): none, gzip, lzma or lzo
+ * @dst:	Buffer to decompress into
+ * @size:	Size of @dst in bytes
+ * @return 0 if ok, -EPROTONOSUPPORT if the compression type is not
+ * supported, -ENOMEM if out of memory
+ */
+int decomp_stream_start(struct decomp_stream *ds, int comp, void *dst,
+			ulong size);
+
+/**
+ * decomp_stream_update() - Decompress the next piece of a stream
+ *
+ * The data may be split anywhere, even within the headers. Anything after
+ * the end of the compressed stream is ignored. After an error, later calls
+ * return the same error; decomp_stream_finish() must still be called.
+ *
+ * @ds:		Stream state
+ * @buf:	Compressed data
+ * @size:	Number of bytes at @buf
+ * @return 0 if ok, -ENOSPC if the output does not fit, -EINVAL if the
+ * data is corrupt, -ENOMEM if out of memory
+ */
+int decomp_stream_update(struct decomp_stream *ds, const void *buf,
+			 ulong size);
+
+/**
+ * decomp_stream_finish() - Finish decompressing a stream
+ *
+ * This always releases the decompressor state, even on error.
+ *
+ * @ds:		Stream state
+ * @lenp:	Returns the number of bytes written to the output buffer
+ * @return 0 if ok, -ENOSPC if the stream was cut short with the output
+ * buffer full, -EIO if it was cut short otherwise, or the error from an
+ * earlier decomp_stream_update()
+ */
+int decomp_stream_finish(struct decomp_stream *ds, ulong *lenp);
+
+#endif
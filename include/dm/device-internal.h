@@ -113,6 +113,12 @@ void device_free(struct udevice *dev);
 static inline void device_free(struct udevice *dev) {}
 #endif
 
+/*
+ * Pool for small objects allocated by driver model: devices, uclasses and
+ * their private data. It is released by dm_uninit().
+ */
+extern struct slab_pool dm_slab_pool;
+
 /* Cast away any volatile pointer */
 #define DM_ROOT_NON_CONST		(((gd_t *)gd)->dm_root)
 #define DM_UCLASS_ROOT_NON_CONST	(((gd_t *)gd)->uclass_root)
@@ -36,6 +36,16 @@ struct driver_info;
 /* Allocate driver private data on a DMA boundary */
 #define DM_FLAG_ALLOC_PRIV_DMA	(1 << 5)
 
+/* Keys by which each uclass indexes its devices, with CONFIG_DM_INDEX */
+enum dm_index_key {
+	DM_INDEX_SEQ,
+	DM_INDEX_REQ_SEQ,
+	DM_INDEX_NAME,
+	DM_INDEX_OF_OFFSET,
+
+	DM_INDEX_COUNT,
+};
+
 /**
  * struct udevice - An instance of a driver
  *
@@ -73,6 +83,8 @@ struct driver_info;
  * @req_seq: Requested sequence number for this device (-1 = any)
  * @seq: Allocated sequence number for this device (-1 = none). This is set up
  * when the device is probed and will be unique within the device's uclass.
+ * @index_next: Next device in the same bucket of the uclass's index, for
+ * each key (see enum dm_index_key)
  */
 struct udevice {
 	const struct driver *driver;
@@ -93,6 +105,9 @@ struct udevice {
 	uint32_t flags;
 	int req_seq;
 	int seq;
+#ifdef CONFIG_DM_INDEX
+	struct udevice *index_next[DM_INDEX_COUNT];
+#endif
 };
 
 /* Maximum sequence number supported */
@@ -266,6 +281,17 @@ struct udevice *dev_get_parent(struct udevice *child);
  */
 void *dev_get_uclass_priv(struct udevice *dev);
 
+/**
+ * dev_set_of_offset() - Change the device tree node of a device
+ *
+ * Drivers which bind a device and then give it a node must use this rather
+ * than setting dev->of_offset, so that the device can be found by its node.
+ *
+ * @dev:	Device to update
+ * @of_offset:	Device tree node offset, or -1 for none
+ */
+void dev_set_of_offset(struct udevice *dev, int of_offset);
+
 /**
  * dev_get_driver_data() - get the driver data used to bind a device
  *
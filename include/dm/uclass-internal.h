@@ -98,6 +98,19 @@ int uclass_find_device_by_name(enum uclass_id id, const char *name,
 int uclass_find_device_by_seq(enum uclass_id id, int seq_or_req_seq,
 			      bool find_req_seq, struct udevice **devp);
 
+/**
+ * uclass_find_device_by_of_offset() - Find a uclass device by device tree node
+ *
+ * The device is NOT probed, it is merely returned.
+ *
+ * @id: ID to look up
+ * @node: Device tree offset to search for (if -ve then -ENODEV is returned)
+ * @devp: Returns pointer to device (the first one with the node)
+ * @return 0 if OK, -ve on error
+ */
+int uclass_find_device_by_of_offset(enum uclass_id id, int node,
+				    struct udevice **devp);
+
 /**
  * uclass_bind_device() - Associate device with a uclass
  *
@@ -122,6 +135,38 @@ int uclass_unbind_device(struct udevice *dev);
 static inline int uclass_unbind_device(struct udevice *dev) { return 0; }
 #endif
 
+/**
+ * uclass_index_add() - Add a device to its uclass's index for a key
+ *
+ * This must be called after changing the value of the key (e.g. dev->seq)
+ * for a bound device. Nothing is added if the device has no value for the
+ * key.
+ *
+ * @dev:	Pointer to the device
+ * @key:	Key to index the device by
+ */
+#ifdef CONFIG_DM_INDEX
+void uclass_index_add(struct udevice *dev, enum dm_index_key key);
+#else
+static inline void uclass_index_add(struct udevice *dev,
+				    enum dm_index_key key) {}
+#endif
+
+/**
+ * uclass_index_del() - Remove a device from its uclass's index for a key
+ *
+ * This must be called before changing the value of the key.
+ *
+ * @dev:	Pointer to the device
+ * @key:	Key the device is indexed by
+ */
+#ifdef CONFIG_DM_INDEX
+void uclass_index_del(struct udevice *dev, enum dm_index_key key);
+#else
+static inline void uclass_index_del(struct udevice *dev,
+				    enum dm_index_key key) {}
+#endif
+
 /**
  * uclass_pre_probe_device() - Deal with a device that is about to be probed
  *
@@ -30,12 +30,22 @@
  * @dev_head: List of devices in this uclass (devices are attached to their
  * uclass when their bind method is called)
  * @sibling_node: Next uclass in the linked list of uclasses
+ * @index: Hash table of devices for each key in enum dm_index_key, one
+ * after the other, each with 1 << @index_bits buckets. This is NULL if the
+ * table could not be allocated, in which case lookups walk @dev_head
+ * @index_bits: Log2 of the number of buckets for each key
+ * @dev_count: Number of devices in @dev_head
  */
 struct uclass {
 	void *priv;
 	struct uclass_driver *uc_drv;
 	struct list_head dev_head;
 	struct list_head sibling_node;
+#ifdef CONFIG_DM_INDEX
+	struct udevice **index;
+	uint index_bits;
+	uint dev_count;
+#endif
 };
 
 struct udevice;
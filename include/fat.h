@@ -23,6 +23,11 @@
 #endif
 #define MAX_CLUSTSIZE	CONFIG_FS_FAT_MAX_CLUSTSIZE
 
+/* Number of files whose cluster chains are remembered between reads */
+#ifndef CONFIG_FS_FAT_EXTENT_FILES
+#define CONFIG_FS_FAT_EXTENT_FILES	4
+#endif
+
 #define DIRENTSPERBLOCK	(mydata->sect_size / sizeof(dir_entry))
 #define DIRENTSPERCLUST	((mydata->clust_size * mydata->sect_size) / \
 			 sizeof(dir_entry))
@@ -174,6 +179,7 @@ typedef struct {
 	__u16	clust_size;	/* Size of clusters in sectors */
 	int	data_begin;	/* The sector of the first cluster, can be negative */
 	int	fatbufnum;	/* Used by get_fatent, init to -1 */
+	__u32	vol_id;		/* Volume serial number */
 } fsdata;
 
 typedef int	(file_detectfs_func)(void);
@@ -211,4 +217,15 @@ int file_fat_write(const char *filename, void *buf, loff_t offset, loff_t len,
 int fat_read_file(const char *filename, void *buf, loff_t offset, loff_t len,
 		  loff_t *actread);
 void fat_close(void);
+int do_fat_read_at(const char *filename, loff_t pos, void *buffer,
+		   loff_t maxsize, int dols, int dogetsize, loff_t *size);
+
+/**
+ * fat_extent_flush() - Forget the cluster chains of all files
+ *
+ * Writing a file through the FAT code does this itself. Raw block writes
+ * drop the chains of the device written, through part_dev_changed(), so this
+ * is only needed if the filesystem is changed in some other way.
+ */
+void fat_extent_flush(void);
 #endif /* _FAT_H_ */
@@ -452,6 +452,21 @@ int fdtdec_get_is_enabled(const void *blob, int node);
  */
 int fdtdec_prepare_fdt(void);
 
+/**
+ * Discard the index of the control FDT
+ *
+ * The index is checked against the size of the FDT on each use, so adding
+ * or removing nodes or properties is noticed. This must be called when the
+ * FDT is moved, or changed in some other way, e.g. a property value is
+ * replaced by another of the same length. The index is then built again
+ * when next needed.
+ */
+#ifdef CONFIG_OF_INDEX
+void fdtdec_index_invalidate(void);
+#else
+static inline void fdtdec_index_invalidate(void) {}
+#endif
+
 /**
  * Checks that we have a valid fdt available to control U-Boot.
 
@@ -73,6 +73,80 @@ int fs_size(const char *filename, loff_t *size);
 int fs_read(const char *filename, ulong addr, loff_t offset, loff_t len,
 	    loff_t *actread);
 
+struct hash_stream;
+
+/*
+ * fs_read_hash - Read a file and hash its contents in the same pass
+ *
+ * This works like fs_read(), but also feeds the data to a hash stream as
+ * it arrives from the device, while it is still in the cache, so that
+ * loading and verifying a large image does not need a second pass over
+ * memory. Filesystems which do not report their progress through
+ * fs_read_notify() are hashed once the read completes.
+ *
+ * @filename: Name of file to read from
+ * @addr: The address to read into
+ * @offset: The offset in file to read from
+ * @len: The number of bytes to read. Maybe 0 to read entire file
+ * @actread: Returns the actual number of bytes read
+ * @hs: Hash stream to update, set up by hash_stream_start()
+ * @return 0 if ok with valid *actread, -1 on error conditions
+ */
+int fs_read_hash(const char *filename, ulong addr, loff_t offset, loff_t len,
+		 loff_t *actread, struct hash_stream *hs);
+
+/*
+ * fs_read_decomp - Read a compressed file and decompress it as it is read
+ *
+ * The file is read in pieces through a small bounce buffer and each piece
+ * is decompressed straight to @addr, so the compressed file is never held
+ * in memory as a whole.
+ *
+ * @filename: Name of file to read from
+ * @addr: The address to decompress into
+ * @size: Maximum number of bytes to write at @addr
+ * @comp: Compression type of the file (IH_COMP_...)
+ * @actread: Returns the number of bytes written at @addr
+ * @return 0 if ok with valid *actread, -1 on error conditions
+ */
+int fs_read_decomp(const char *filename, ulong addr, ulong size, int comp,
+		   loff_t *actread);
+
+/*
+ * fs_read_notify - Report that file data has been written to the read buffer
+ *
+ * Filesystem drivers call this as each part of the file lands in the
+ * caller's buffer during a read. Calls must cover the buffer in order from
+ * its start, with no gaps; anything else (such as directory reads during the
+ * lookup) is ignored.
+ *
+ * @buf: Start of the data just read
+ * @len: Number of bytes of file data at @buf
+ */
+#if defined(CONFIG_FS_READ_HASH) && !defined(CONFIG_SPL_BUILD)
+void fs_read_notify(const void *buf, ulong len);
+#else
+static inline void fs_read_notify(const void *buf, ulong len) {}
+#endif
+
+/*
+ * fs_read_notify_chunk - Get the preferred size of each fs_read_notify() call
+ *
+ * Filesystem drivers should split device reads so that no more than this
+ * is read between calls to fs_read_notify(), so that the data is still in
+ * the cache when it is hashed.
+ *
+ * @return maximum number of bytes to read at once, or 0 for no limit
+ */
+#if defined(CONFIG_FS_READ_HASH) && !defined(CONFIG_SPL_BUILD)
+ulong fs_read_notify_chunk(void);
+#else
+static inline ulong fs_read_notify_chunk(void)
+{
+	return 0;
+}
+#endif
+
 /*
  * fs_write - Write file to the partition previously set by fs_set_blk_dev()
  * Note that not all filesystem types support offset!=0.
@@ -95,6 +169,10 @@ int do_size(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[],
 		int fstype);
 int do_load(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[],
 		int fstype);
+int do_load_hash(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[],
+		int fstype);
+int do_load_decomp(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[],
+		   int fstype);
 int do_ls(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[],
 		int fstype);
 int file_exists(const char *dev_type, const char *dev_part, const char *file,
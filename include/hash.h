@@ -77,6 +77,30 @@ struct hash_algo {
 };
 
 #ifndef USE_HOSTCC
+#include <linker_lists.h>
+
+/**
+ * U_BOOT_HASH_ALGO() - Register an accelerated hash algorithm
+ *
+ * SoC drivers with a crypto engine can use this to provide a faster version
+ * of one of the algorithms in the built-in table (e.g. "sha256"). Entries
+ * registered this way are returned by hash_lookup_algo() and
+ * hash_progressive_lookup_algo() in preference to the software versions.
+ *
+ * Example:
+ *
+ * U_BOOT_HASH_ALGO(foo_sha256) = {
+ *	.name		= "sha256",
+ *	.digest_size	= SHA256_SUM_LEN,
+ *	.hash_func_ws	= foo_sha256_csum_wd,
+ *	.chunk_size	= CHUNKSZ_SHA256,
+ * };
+ *
+ * @__name:	Unique name for the entry (a C identifier)
+ */
+#define U_BOOT_HASH_ALGO(__name)					\
+	ll_entry_declare(struct hash_algo, __name, hash_algo)
+
 /**
  * hash_command: Process a hash command for a particular algorithm
  *
@@ -129,6 +153,79 @@ int hash_block(const char *algo_name, const void *data, unsigned int len,
 void hash_show(struct hash_algo *algo, ulong addr, ulong len,
 	       uint8_t *output);
 
+/**
+ * hash_verify() - Check a hash value against an expected value
+ *
+ * If the values differ, a message showing both is printed.
+ *
+ * @algo:		Algorithm used for hash
+ * @addr:		Address of data that was hashed (for the message)
+ * @len:		Length of data that was hashed (for the message)
+ * @output:		Hash value to check
+ * @verify_str:		Expected value, see @allow_env_vars
+ * @allow_env_vars:	non-zero to interpret @verify_str as a hex digest or
+ *			the name of an environment variable holding one,
+ *			unless it starts with *, in which case the binary
+ *			digest is read from the address which follows. If 0
+ *			then @verify_str is always an address, with no *.
+ * @return 0 if the values match, -EINVAL if @verify_str is not valid,
+ * -EBADMSG if the values differ
+ */
+int hash_verify(struct hash_algo *algo, ulong addr, ulong len,
+		const uint8_t *output, char *verify_str, int allow_env_vars);
+
+/**
+ * struct hash_stream - State for hashing data which arrives in pieces
+ *
+ * This wraps the progressive hashing functions of an algorithm so that
+ * callers such as the filesystem layer can hash data as it is read, rather
+ * than in a second pass once it is all in memory.
+ *
+ * @algo:	Algorithm in use
+ * @ctx:	Algorithm context, from its hash_init() method
+ * @len:	Number of bytes hashed so far
+ */
+struct hash_stream {
+	struct hash_algo *algo;
+	void *ctx;
+	ulong len;
+};
+
+/**
+ * hash_stream_start() - Start hashing a stream of data
+ *
+ * @hs:		Stream state to set up
+ * @algo_name:	Hash algorithm to use
+ * @return 0 if ok, -EPROTONOSUPPORT if the algorithm is unknown or has no
+ * progressive hashing support, -ENOMEM if out of memory
+ */
+int hash_stream_start(struct hash_stream *hs, const char *algo_name);
+
+/**
+ * hash_stream_update() - Add data to a stream being hashed
+ *
+ * The watchdog is triggered every algo->chunk_size bytes. On error the
+ * stream is finished and must not be used again.
+ *
+ * @hs:		Stream state
+ * @buf:	Data to add
+ * @size:	Number of bytes to add
+ * @return 0 if ok, -EIO on error
+ */
+int hash_stream_update(struct hash_stream *hs, const void *buf, ulong size);
+
+/**
+ * hash_stream_finish() - Finish hashing a stream and obtain the result
+ *
+ * This always releases the context, even on error.
+ *
+ * @hs:		Stream state
+ * @output:	Place to put the hash value
+ * @size:	Number of bytes available at @output
+ * @return 0 if ok, -ENOSPC if @output is too small, -EIO on other errors
+ */
+int hash_stream_finish(struct hash_stream *hs, uint8_t *output, int size);
+
 #endif /* !USE_HOSTCC */
 
 /**
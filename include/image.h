@@ -45,6 +45,11 @@ struct lmb;
 
 #endif /* USE_HOSTCC */
 
+#ifndef CONFIG_SYS_BOOTM_LEN
+/* Largest image decompressed by bootm, loadz and tftpcomp: 8MB by default */
+#define CONFIG_SYS_BOOTM_LEN	0x800000
+#endif
+
 #if defined(CONFIG_FIT)
 #include <hash.h>
 #include <libfdt.h>
@@ -254,6 +259,7 @@ struct lmb;
 #define IH_COMP_BZIP2		2	/* bzip2 Compression Used	*/
 #define IH_COMP_LZMA		3	/* lzma  Compression Used	*/
 #define IH_COMP_LZO		4	/* lzo   Compression Used	*/
+#define IH_COMP_LZ4		5	/* lz4   Compression Used	*/
 
 #define IH_MAGIC	0x27051956	/* Image Magic Number		*/
 #define IH_NMLEN		32	/* Image Name Length		*/
@@ -4,6 +4,162 @@
  * SPDX-License-Identifier:	GPL-2.0+
  */
 
+#ifndef __INITCALL_H
+#define __INITCALL_H
+
+#include <linker_lists.h>
+
 typedef int (*init_fnc_t)(void);
 
+/* Things which initcalls set up and rely on, see INITCALL_INFO() */
+enum initcall_res {
+	INITCALL_RELOC		= 1 << 0,	/* Running relocated */
+	INITCALL_MALLOC		= 1 << 1,	/* malloc() works */
+	INITCALL_DM		= 1 << 2,	/* Driver model is ready */
+	INITCALL_ENV		= 1 << 3,	/* Environment is ready */
+	INITCALL_SERIAL		= 1 << 4,	/* Serial is ready */
+	INITCALL_STDIO		= 1 << 5,	/* stdio devices added */
+	INITCALL_CONSOLE	= 1 << 6,	/* Console is ready */
+	INITCALL_FLASH		= 1 << 7,	/* NOR flash is probed */
+	INITCALL_NAND		= 1 << 8,	/* NAND flash is probed */
+	INITCALL_MMC		= 1 << 9,	/* MMC is ready */
+	INITCALL_PCI		= 1 << 10,	/* PCI bus is scanned */
+	INITCALL_IRQ		= 1 << 11,	/* Interrupts are ready */
+	INITCALL_NET		= 1 << 12,	/* Network is ready */
+
+	INITCALL_RES_COUNT	= 13,
+};
+
+/* Flags for each initcall */
+enum initcall_flags {
+	INITCALLF_DEFER	= 1 << 0,	/* May run later, when needed */
+	INITCALLF_SYNC	= 1 << 1,	/* Run deferred ones first */
+};
+
+/**
+ * struct initcall_info - What an initcall needs and provides
+ *
+ * Declare these with INITCALL_INFO(). initcall_run_list() checks that
+ * everything an initcall needs has been provided by earlier initcalls in
+ * the same list, and reports it if not.
+ *
+ * With CONFIG_INITCALL_DEFER, initcalls marked INITCALLF_DEFER are put off
+ * until a later initcall needs something they provide, an initcall marked
+ * INITCALLF_SYNC is reached, the end of the list is reached or
+ * initcall_run_deferred() is called. Only mark initcalls whose results
+ * are not used by unannotated initcalls.
+ *
+ * @func:	Initcall function
+ * @name:	Name of function
+ * @needs:	Things which must be set up first (INITCALL_...)
+ * @provides:	Things which this initcall sets up (INITCALL_...)
+ * @flags:	Flags (INITCALLF_...)
+ */
+struct initcall_info {
+	init_fnc_t func;
+	const char *name;
+	ulong needs;
+	ulong provides;
+	int flags;
+};
+
+/* Declare what an initcall needs and provides */
+#define INITCALL_INFO(_func, _needs, _provides, _flags)			\
+	ll_entry_declare(struct initcall_info, _func, initcall) = {	\
+		.func = _func,						\
+		.name = #_func,						\
+		.needs = _needs,					\
+		.provides = _provides,					\
+		.flags = _flags,					\
+	}
+
+/**
+ * struct initcall_time - Time taken by one initcall, see
+ * CONFIG_INITCALL_TIMING
+ *
+ * @func:	Function address, before relocation
+ * @info:	Index of the function's struct initcall_info, or -1 if none
+ * @us:		Wall time in microseconds
+ * @ticks:	Time in timer ticks, which is CPU cycles on many boards
+ */
+struct initcall_time {
+	ulong func;
+	int info;
+	uint32_t us;
+	uint64_t ticks;
+};
+
+/**
+ * initcall_run_list() - Run a list of initcalls
+ *
+ * @init_sequence:	List of initcalls, terminated by NULL
+ * @return 0 if OK, -1 if an initcall failed
+ */
 int initcall_run_list(const init_fnc_t init_sequence[]);
+
+/**
+ * initcall_run_deferred() - Run the initcalls deferred so far
+ *
+ * This can be called while waiting for hardware, to get on with other
+ * work in the meantime.
+ *
+ * @return 0 if OK, -1 if an initcall failed
+ */
+int initcall_run_deferred(void);
+
+/**
+ * initcall_find() - Find the information about an initcall
+ *
+ * @func:	Initcall function
+ * @return information, or NULL if there is none
+ */
+const struct initcall_info *initcall_find(init_fnc_t func);
+
+/**
+ * initcall_check_list() - Check the order of a list of initcalls
+ *
+ * @init_sequence:	List of initcalls, terminated by NULL
+ * @missingp:		Returns what the first failing initcall needs but
+ *			is not provided before it (INITCALL_...)
+ * @return index of the first initcall which is run before something it
+ *	needs is provided, or -1 if there is none
+ */
+int initcall_check_list(const init_fnc_t init_sequence[], ulong *missingp);
+
+/**
+ * initcall_get_errors() - Get the number of initcalls run too early
+ *
+ * @return number of initcalls run so far before something they need was
+ *	provided
+ */
+int initcall_get_errors(void);
+
+/**
+ * initcall_get_times() - Get the times recorded for initcalls run so far
+ *
+ * @timesp:	Returns a pointer to the times, in the order run
+ * @return number of times recorded (0 without CONFIG_INITCALL_TIMING)
+ */
+int initcall_get_times(const struct initcall_time **timesp);
+
+#ifdef CONFIG_UT_INITCALL
+/**
+ * initcall_test_state() - Switch to or from a separate state for tests
+ *
+ * Tests call this with true before running their own lists of initcalls,
+ * which then start with no errors, times or deferred initcalls and add no
+ * bootstage spans. Calling it with false puts back what was recorded
+ * during boot.
+ *
+ * @test:	true to switch to the test state, false to switch back
+ */
+void initcall_test_state(bool test);
+#endif
+
+/* Print the time taken by each initcall, with a total */
+void initcall_show_times(void);
+
+/* Print what each annotated initcall needs and provides */
+void initcall_show_info(void);
+
+#endif /* __INITCALL_H */
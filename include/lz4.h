@@ -0,0 +1,54 @@
+/*
+ * LZ4 decompression
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#ifndef __LZ4_H
+#define __LZ4_H
+
+/*
+ * Extra room needed after the output to decompress in place, with the
+ * compressed data at the very end of the buffer. The decompressed data
+ * then overwrites the compressed data only once it has been read.
+ */
+#define LZ4_INPLACE_MARGIN(src_len)	(((src_len) >> 8) + 32)
+
+/**
+ * lz4_decompress_block() - Decompress one raw LZ4 block
+ *
+ * @src:	Compressed block
+ * @src_len:	Size of the block in bytes
+ * @dst:	Output buffer
+ * @dst_len:	On entry, the size of @dst; on exit, the number of bytes
+ *		decompressed
+ * @return 0 if ok, -ENOSPC if the output does not fit, -EINVAL if the data
+ * is corrupt
+ */
+int lz4_decompress_block(const void *src, size_t src_len, void *dst,
+			 size_t *dst_len);
+
+/**
+ * lz4_decompress() - Decompress an LZ4 file
+ *
+ * This handles the LZ4 frame format written by 'lz4' and the legacy
+ * format written by 'lz4 -l', which is used for Linux kernels. Checksums
+ * are not checked, as the image is normally covered by its own hash.
+ *
+ * The source may overlap the end of the output buffer, for decompressing
+ * in place: it must then end at least LZ4_INPLACE_MARGIN(@src_len) bytes
+ * after the end of the decompressed data.
+ *
+ * @src:	Compressed data
+ * @src_len:	Size of the data in bytes
+ * @dst:	Output buffer
+ * @dst_len:	On entry, the size of @dst; on exit, the number of bytes
+ *		decompressed
+ * @return 0 if ok, -ENOSPC if the output does not fit, -EINVAL if the data
+ * is corrupt, -EPROTONOSUPPORT if it needs a dictionary or is a newer
+ * version of the format
+ */
+int lz4_decompress(const void *src, size_t src_len, void *dst,
+		   size_t *dst_len);
+
+#endif
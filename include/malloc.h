@@ -876,10 +876,15 @@ extern Void_t*     sbrk();
 #define malloc malloc_simple
 #define realloc realloc_simple
 #define memalign memalign_simple
+#ifdef CONFIG_SYS_MALLOC_F_FREE
+#define free free_simple
+#else
 static inline void free(void *ptr) {}
+#endif
 void *calloc(size_t nmemb, size_t size);
 void *memalign_simple(size_t alignment, size_t bytes);
 void *realloc_simple(void *ptr, size_t size);
+void free_simple(void *ptr);
 #else
 
 # ifdef USE_DL_PREFIX
@@ -913,6 +918,9 @@ int initf_malloc(void);
 
 /* Simple versions which can be used when space is tight */
 void *malloc_simple(size_t size);
+void *memalign_simple(size_t alignment, size_t bytes);
+void *realloc_simple(void *ptr, size_t size);
+void free_simple(void *ptr);
 
 # if __STD_C
 
@@ -38,6 +38,9 @@
 
 #define PKTALIGN	ARCH_DMA_MINALIGN
 
+/* Most packets asked of a driver's recv_batch() in one call */
+#define ETH_RX_BATCH	16
+
 /* IPv4 addresses are always 32 bits in size */
 struct in_addr {
 	__be32 s_addr;
@@ -106,6 +109,14 @@ struct eth_pdata {
  * free_pkt: Give the driver an opportunity to manage its packet buffer memory
  *	     when the network stack is finished processing it. This will only be
  *	     called when no error was returned from recv - optional
+ * recv_batch: Collect up to "max" packets the hardware has received, filling
+ *	       in "packets" and "lengths", and return how many there were (0 if
+ *	       none) or an error. The buffers belong to the network stack until
+ *	       the next call to recv_batch() or stop(), so the driver can sync
+ *	       its descriptors once per batch and hand back the buffers of the
+ *	       previous batch on entry. It may return fewer than "max" while
+ *	       more are waiting, and is called again until it returns 0. Used
+ *	       in place of recv() and free_pkt() when supplied - optional
  * stop: Stop the hardware from looking for packets - may be called even if
  *	 state == PASSIVE
  * mcast: Join or leave a multicast group (for TFTP) - optional
@@ -122,6 +133,8 @@ struct eth_ops {
 	int (*send)(struct udevice *dev, void *packet, int length);
 	int (*recv)(struct udevice *dev, uchar **packetp);
 	int (*free_pkt)(struct udevice *dev, uchar *packet, int length);
+	int (*recv_batch)(struct udevice *dev, uchar **packets, int *lengths,
+			  int max);
 	void (*stop)(struct udevice *dev);
 #ifdef CONFIG_MCAST_TFTP
 	int (*mcast)(struct udevice *dev, const u8 *enetaddr, int join);
@@ -154,6 +167,9 @@ struct eth_device {
 	int (*init)(struct eth_device *, bd_t *);
 	int (*send)(struct eth_device *, void *packet, int length);
 	int (*recv)(struct eth_device *);
+	/* As for struct eth_ops, used in place of recv() if supplied */
+	int (*recv_batch)(struct eth_device *, uchar **packets, int *lengths,
+			  int max);
 	void (*halt)(struct eth_device *);
 #ifdef CONFIG_MCAST_TFTP
 	int (*mcast)(struct eth_device *, const u8 *enetaddr, u8 set);
@@ -307,6 +323,7 @@ struct vlan_ethernet_hdr {
 #define PROT_VLAN	0x8100		/* IEEE 802.1q protocol		*/
 
 #define IPPROTO_ICMP	 1	/* Internet Control Message Protocol	*/
+#define IPPROTO_TCP	 6	/* Transmission Control Protocol	*/
 #define IPPROTO_UDP	17	/* User Datagram Protocol		*/
 
 /*
@@ -356,6 +373,45 @@ struct ip_udp_hdr {
 #define IP_UDP_HDR_SIZE		(sizeof(struct ip_udp_hdr))
 #define UDP_HDR_SIZE		(IP_UDP_HDR_SIZE - IP_HDR_SIZE)
 
+/*
+ *	Internet Protocol (IP) + TCP header, without TCP options.
+ */
+struct ip_tcp_hdr {
+	u8		ip_hl_v;	/* header length and version	*/
+	u8		ip_tos;		/* type of service		*/
+	u16		ip_len;		/* total length			*/
+	u16		ip_id;		/* identification		*/
+	u16		ip_off;		/* fragment offset field	*/
+	u8		ip_ttl;		/* time to live			*/
+	u8		ip_p;		/* protocol			*/
+	u16		ip_sum;		/* checksum			*/
+	struct in_addr	ip_src;		/* Source IP address		*/
+	struct in_addr	ip_dst;		/* Destination IP address	*/
+	u16		tcp_src;	/* TCP source port		*/
+	u16		tcp_dst;	/* TCP destination port		*/
+	u32		tcp_seq;	/* Sequence number		*/
+	u32		tcp_ack;	/* Acknowledgment number	*/
+	u8		tcp_hlen;	/* Header length (words) << 4	*/
+	u8		tcp_flags;	/* TCP_...			*/
+	u16		tcp_win;	/* Receive window		*/
+	u16		tcp_xsum;	/* Checksum			*/
+	u16		tcp_urg;	/* Urgent pointer		*/
+};
+
+#define IP_TCP_HDR_SIZE		(sizeof(struct ip_tcp_hdr))
+#define TCP_HDR_SIZE		(IP_TCP_HDR_SIZE - IP_HDR_SIZE)
+
+#define TCP_FIN		0x01
+#define TCP_SYN		0x02
+#define TCP_RST		0x04
+#define TCP_PSH		0x08
+#define TCP_ACK		0x10
+
+#define TCPOPT_END	0	/* End of options			*/
+#define TCPOPT_NOP	1	/* Padding				*/
+#define TCPOPT_MSS	2	/* Maximum segment size			*/
+#define TCPOPT_WSCALE	3	/* Window scale shift			*/
+
 /*
  *	Address Resolution Protocol (ARP) header.
  */
@@ -446,6 +502,21 @@ struct icmp_hdr {
 #define PKTSIZE_ALIGN		1536
 /*#define PKTSIZE		608*/
 
+/* Largest datagram (payload) which CONFIG_IP_DEFRAG can reassemble */
+#ifndef CONFIG_NET_MAXDEFRAG
+#define CONFIG_NET_MAXDEFRAG	16384
+#endif
+
+/* Number of datagrams CONFIG_IP_DEFRAG can reassemble at once */
+#ifndef CONFIG_NET_DEFRAG_SLOTS
+#define CONFIG_NET_DEFRAG_SLOTS	4
+#endif
+
+/* Time in milliseconds after which an incomplete datagram is dropped */
+#ifndef CONFIG_NET_DEFRAG_TIMEOUT
+#define CONFIG_NET_DEFRAG_TIMEOUT	1000
+#endif
+
 /*
  * Maximum receive ring size; that is, the number of packets
  * we can buffer before overflow happens. Basically, this just
@@ -499,7 +570,7 @@ extern int		net_restart_wrap;	/* Tried all network devices */
 
 enum proto_t {
 	BOOTP, RARP, ARP, TFTPGET, DHCP, PING, DNS, NFS, CDP, NETCONS, SNTP,
-	TFTPSRV, TFTPPUT, LINKLOCAL
+	TFTPSRV, TFTPPUT, LINKLOCAL, WGET
 };
 
 extern char	net_boot_file_name[128];/* Boot File name */
@@ -634,9 +705,43 @@ static inline void net_send_packet(uchar *pkt, int len)
 int net_send_udp_packet(uchar *ether, struct in_addr dest, int dport,
 			int sport, int payload_len);
 
+/*
+ * Transmit "net_tx_packet" as IP packet, performing ARP request if needed
+ *  (ether will be populated). The IP packet, with its header set up, must
+ *  be at net_tx_packet + net_eth_hdr_size().
+ *
+ * @param ether Raw packet buffer
+ * @param dest IP address to send the packet to
+ * @param len Length of the IP packet, including its header
+ */
+int net_send_ip_packet(uchar *ether, struct in_addr dest, int len);
+
 /* Processes a received packet */
 void net_process_received_packet(uchar *in_packet, int len);
 
+/**
+ * struct net_defrag_stats - IP fragment reassembly statistics
+ *
+ * @fragments:	Fragments received
+ * @datagrams:	Datagrams reassembled
+ * @dropped:	Fragments dropped, as duplicates or too large
+ * @evicted:	Incomplete datagrams dropped to make room for a new one
+ * @timeouts:	Incomplete datagrams which timed out
+ */
+struct net_defrag_stats {
+	ulong fragments;
+	ulong datagrams;
+	ulong dropped;
+	ulong evicted;
+	ulong timeouts;
+};
+
+/* Get the reassembly statistics, with CONFIG_IP_DEFRAG */
+const struct net_defrag_stats *net_defrag_get_stats(void);
+
+/* Drop all datagrams being reassembled and clear the statistics */
+void net_defrag_reset(void);
+
 #ifdef CONFIG_NETCONSOLE
 void nc_start(void);
 int nc_input_packet(uchar *pkt, struct in_addr src_ip, unsigned dest_port,
@@ -39,6 +39,7 @@ typedef struct block_dev_desc {
 				       lbaint_t start,
 				       lbaint_t blkcnt);
 	void		*priv;		/* driver private struct pointer */
+	unsigned long	change_id;	/* see part_dev_changed() */
 }block_dev_desc_t;
 
 #define BLOCK_CNT(size, block_dev_desc) (PAD_COUNT(size, block_dev_desc->blksz))
@@ -148,6 +149,23 @@ static inline int get_device_and_partition(const char *ifname,
 { *dev_desc = NULL; return -1; }
 #endif
 
+/**
+ * part_dev_changed() - Note that the contents of a device may have changed
+ *
+ * This gives the device a new change_id, unlike any it has had before, so
+ * that anything cached about what was on the device (such as the FAT
+ * cluster chains) is seen to be out of date. Drivers call it when writing
+ * or erasing blocks and when the medium or hardware partition changes.
+ *
+ * @dev_desc:	Device which has changed
+ */
+#if defined(CONFIG_PARTITIONS) && \
+	(!defined(CONFIG_SPL_BUILD) || defined(CONFIG_SPL_LIBDISK_SUPPORT))
+void part_dev_changed(block_dev_desc_t *dev_desc);
+#else
+static inline void part_dev_changed(block_dev_desc_t *dev_desc) {}
+#endif
+
 #ifdef CONFIG_MAC_PARTITION
 /* disk/part_mac.c */
 int get_partition_info_mac (block_dev_desc_t * dev_desc, int part, disk_partition_t *info);
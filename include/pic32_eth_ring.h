@@ -0,0 +1,213 @@
+/*
+ * Descriptor rings for the PIC32 Ethernet controller
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#ifndef __PIC32_ETH_RING_H
+#define __PIC32_ETH_RING_H
+
+#include <asm/cache.h>
+
+/*
+ * Packet Descriptor
+ *
+ * Descriptor of a packet accepted by the TX/RX Ethernet engine.
+ * ref: PIC32 Family Reference Manual Table 35-7
+ *
+ * A packet handled by the Ethernet TX/RX engine is a list of buffer
+ * descriptors. A packet may consist of more than one buffer.
+ * Each buffer needs a descriptor.
+ *
+ */
+
+/* Received Packet Status */
+#define _RSV1_PKT_CSUM	0xffff
+#define _RSV2_RX_OK	(1 << 23)
+#define _RSV2_LEN_ERR	(1 << 21)
+#define _RSV2_CRC_ERR	(1 << 20)
+#define _RSV2_RX_COUNT	0xffff
+
+#define RSV_RX_CSUM(__rsv1)	((__rsv1) & _RSV1_PKT_CSUM)
+#define RSV_RX_COUNT(__rsv2)	((__rsv2) & _RSV2_RX_COUNT)
+#define RSV_RX_OK(__rsv2)	((__rsv2) & _RSV2_RX_OK)
+#define RSV_CRC_ERR(__rsv2)	((__rsv2) & _RSV2_CRC_ERR)
+
+/* Ethernet Hardware Descriptor Header bits */
+#define EDH_EOWN	0x00000080
+#define EDH_NPV		0x00000100
+#define EDH_STICKY	0x00000200
+#define _EDH_BCOUNT	0x07ff0000
+#define EDH_EOP		0x40000000
+#define EDH_SOP		0x80000000
+#define EDH_BCOUNT_SHIFT	16
+#define EDH_BCOUNT(len)	((len) << EDH_BCOUNT_SHIFT)
+#define EDH_GET_BCOUNT(hdr)	(((hdr) & _EDH_BCOUNT) >> EDH_BCOUNT_SHIFT)
+
+/*
+ * Ethernet Hardware Descriptors
+ * ref: PIC32 Family Reference Manual Table 35-7
+ *
+ * This structure represents the layout of the DMA
+ * memory shared between the CPU and the Ethernet
+ * controller.
+ */
+/* TX/RX DMA descriptor */
+struct eth_dma_desc {
+	u32 hdr;	/* header */
+	u32 data_buff;	/* data buffer address */
+	u32 stat1;	/* transmit/receive packet status */
+	u32 stat2;	/* transmit/receive packet status */
+	u32 next_ed;	/* next descriptor */
+};
+
+/*
+ * The descriptors are chained through next_ed, so they need not be packed.
+ * Giving each one its own cache line means that writing back a descriptor
+ * the CPU has filled in can never overwrite a neighbour the DMA has just
+ * updated.
+ */
+struct pic32_eth_desc_slot {
+	struct eth_dma_desc desc;
+} __aligned(ARCH_DMA_MINALIGN);
+
+/**
+ * struct pic32_eth_ring - a ring of PIC32 Ethernet DMA descriptors
+ *
+ * The descriptors are contiguous and linked in a circle with EDH_NPV, so
+ * the controller can work through as many of them as the CPU has handed
+ * over. Cache maintenance is done on runs of descriptors rather than one
+ * at a time. Each descriptor has a fixed buffer.
+ *
+ * For RX, @head is the next descriptor to look at and @done counts the
+ * descriptors read by the CPU but not yet given back to the controller,
+ * which are the @done before @head. @frames counts the frames they hold.
+ *
+ * For TX, @head is the next descriptor to fill and @pending counts the
+ * descriptors owned by the controller, which are the @pending before @head.
+ *
+ * @slot:	Descriptors
+ * @slot_phys:	Bus address of @slot
+ * @buf:	CPU address of the buffer of each descriptor
+ * @buf_size:	Size of each buffer
+ * @count:	Number of descriptors
+ * @head:	See above
+ * @done:	RX: descriptors not yet given back
+ * @frames:	RX: frames not yet given back
+ * @pending:	TX: descriptors owned by the controller
+ */
+struct pic32_eth_ring {
+	struct pic32_eth_desc_slot *slot;
+	ulong slot_phys;
+	void **buf;
+	uint buf_size;
+	uint count;
+	uint head;
+	uint done;
+	uint frames;
+	uint pending;
+};
+
+/**
+ * pic32_eth_ring_init() - Set up a descriptor ring
+ *
+ * RX descriptors are given to the controller straight away. TX
+ * descriptors stay with the CPU until something is queued on them.
+ *
+ * @ring:	Ring to set up
+ * @count:	Number of descriptors
+ * @bufs:	Buffer for each descriptor, @count entries. The array must
+ *		remain valid while the ring is in use
+ * @buf_size:	Size of each buffer
+ * @to_phys:	Function to convert a CPU address to a bus address
+ * @rx:		true for an RX ring, false for TX
+ * @return 0 if OK, -ENOMEM if out of memory
+ */
+int pic32_eth_ring_init(struct pic32_eth_ring *ring, uint count, void **bufs,
+			uint buf_size, ulong (*to_phys)(void *), bool rx);
+
+/**
+ * pic32_eth_ring_free() - Free the descriptors of a ring
+ *
+ * @ring:	Ring to free
+ */
+void pic32_eth_ring_free(struct pic32_eth_ring *ring);
+
+/**
+ * pic32_eth_ring_phys() - Get the bus address of a descriptor
+ *
+ * @ring:	Ring to look in
+ * @idx:	Descriptor index, which may be beyond the end of the ring
+ * @return bus address, suitable for ETHTXST or ETHRXST
+ */
+static inline ulong pic32_eth_ring_phys(struct pic32_eth_ring *ring, uint idx)
+{
+	return ring->slot_phys + (idx % ring->count) * sizeof(*ring->slot);
+}
+
+/**
+ * pic32_eth_tx_reap() - Reclaim TX descriptors the controller has finished
+ *
+ * @ring:	TX ring
+ * @return index of the oldest descriptor still owned by the controller,
+ * which is where the DMA must be restarted if it has stopped, or -ENOENT
+ * if there is none
+ */
+int pic32_eth_tx_reap(struct pic32_eth_ring *ring);
+
+/**
+ * pic32_eth_tx_buf() - Get the buffer for the next frame to send
+ *
+ * @ring:	TX ring
+ * @return buffer to copy the frame into, or NULL if the ring is full
+ */
+void *pic32_eth_tx_buf(struct pic32_eth_ring *ring);
+
+/**
+ * pic32_eth_tx_queue() - Hand the next frame to the controller
+ *
+ * The frame must already be in the buffer from pic32_eth_tx_buf(). This
+ * does not start the DMA.
+ *
+ * @ring:	TX ring
+ * @len:	Length of the frame in bytes
+ */
+void pic32_eth_tx_queue(struct pic32_eth_ring *ring, uint len);
+
+/**
+ * pic32_eth_rx_sync() - Pick up the RX descriptors written by the controller
+ *
+ * This invalidates all the descriptors owned by the controller in one go,
+ * so that pic32_eth_rx_frame() sees their current state.
+ *
+ * @ring:	RX ring
+ */
+void pic32_eth_rx_sync(struct pic32_eth_ring *ring);
+
+/**
+ * pic32_eth_rx_frame() - Get the next frame received
+ *
+ * This looks at the descriptors as they were at the last
+ * pic32_eth_rx_sync(). The descriptors of the frame stay with the CPU, and
+ * its data stays valid, until pic32_eth_rx_return() is called. The frame is
+ * returned in place, so one spread over several descriptors is dropped.
+ *
+ * @ring:	RX ring
+ * @pktp:	Returns a pointer to the frame
+ * @return length of the frame without its CRC, -EAGAIN if there is no
+ * complete frame, -EIO for a frame with errors or -EMSGSIZE for one larger
+ * than a buffer. In the error cases the frame is consumed and can be
+ * returned.
+ */
+int pic32_eth_rx_frame(struct pic32_eth_ring *ring, uchar **pktp);
+
+/**
+ * pic32_eth_rx_return() - Give consumed RX descriptors back to the controller
+ *
+ * @ring:	RX ring
+ * @return number of frames returned, which is how many times the
+ * controller's buffer count must be decremented
+ */
+uint pic32_eth_rx_return(struct pic32_eth_ring *ring);
+
+#endif /* __PIC32_ETH_RING_H */
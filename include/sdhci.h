@@ -214,6 +214,7 @@
 #define SDHCI_QUIRK_WAIT_SEND_CMD	(1 << 6)
 #define SDHCI_QUIRK_NO_SIMULT_VDD_AND_POWER (1 << 7)
 #define SDHCI_QUIRK_USE_WIDE8		(1 << 8)
+#define SDHCI_QUIRK_BROKEN_ADMA		(1 << 9)
 
 /* to make gcc happy */
 struct sdhci_host;
@@ -223,6 +224,44 @@ struct sdhci_host;
  */
 #define SDHCI_DEFAULT_BOUNDARY_SIZE	(512 * 1024)
 #define SDHCI_DEFAULT_BOUNDARY_ARG	(7)
+
+/*
+ * 32-bit ADMA2 descriptor. A length of 0 means 64KiB.
+ */
+struct sdhci_adma_desc {
+	u16 attr;
+	u16 len;
+	u32 addr;
+} __packed;
+
+#define SDHCI_ADMA_VALID	0x01
+#define SDHCI_ADMA_END		0x02
+#define SDHCI_ADMA_INT		0x04
+#define SDHCI_ADMA_ACT_MASK	0x30
+#define  SDHCI_ADMA_NOP		0x00
+#define  SDHCI_ADMA_TRAN	0x20
+#define  SDHCI_ADMA_LINK	0x30
+#define SDHCI_ADMA_MAX_LEN	(64 * 1024)
+
+/**
+ * struct sdhci_stats - Data transfer statistics for a host
+ *
+ * @xfers:	Number of data transfers
+ * @adma_xfers:	Number of those transfers which used ADMA
+ * @bytes:	Total number of bytes transferred
+ * @us:		Total time spent on transfers in microseconds
+ * @last_bytes:	Size of the most recent transfer in bytes
+ * @last_us:	Time taken by the most recent transfer in microseconds
+ */
+struct sdhci_stats {
+	ulong xfers;
+	ulong adma_xfers;
+	u64 bytes;
+	u64 us;
+	uint last_bytes;
+	ulong last_us;
+};
+
 struct sdhci_ops {
 #ifdef CONFIG_MMC_SDHCI_IO_ACCESSORS
 	u32             (*read_l)(struct sdhci_host *host, int reg);
@@ -254,6 +293,11 @@ struct sdhci_host {
 	uint	voltages;
 
 	struct mmc_config cfg;
+#ifdef CONFIG_MMC_SDHCI_ADMA
+	struct sdhci_adma_desc *adma_desc;	/* ADMA2 descriptor table */
+	uint adma_desc_count;		/* Number of entries in adma_desc */
+#endif
+	struct sdhci_stats stats;
 };
 
 #ifdef CONFIG_MMC_SDHCI_IO_ACCESSORS
@@ -39,8 +39,10 @@ typedef struct entry {
 	int flags;
 } ENTRY;
 
-/* Opaque type for internal use.  */
+/* Opaque types for internal use.  */
 struct _ENTRY;
+struct htab_blob;
+struct htab_keys;
 
 /*
  * Family of hash table handling functions.  The functions also
@@ -53,6 +55,18 @@ struct hsearch_data {
 	struct _ENTRY *table;
 	unsigned int size;
 	unsigned int filled;
+/*
+ * Keys are copied into an arena, which is compacted when it fills up with
+ * the keys of deleted entries and is freed with the table.
+ * Imported values stay in a copy of the imported data (a blob) until they
+ * are changed, and the blob is freed when no values use it. The entries
+ * are kept in a list, in the order they were added until it is sorted for
+ * export; "sorted" shows whether it is still in order.
+ */
+	struct htab_keys *keys;
+	struct htab_blob *blobs;
+	struct entry **order;
+	int sorted;
 /*
  * Callback function which will check whether the given change for variable
  * "item" to "newval" may be applied or not, and possibly apply such change.
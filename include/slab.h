@@ -0,0 +1,191 @@
+/*
+ * Slabs for small objects, alongside malloc()
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#ifndef __SLAB_H
+#define __SLAB_H
+
+#include <malloc.h>
+
+#define SLAB_PAGE_SIZE		4096
+#define SLAB_MIN_SIZE		16
+#define SLAB_MAX_SIZE		512
+#define SLAB_CLASSES		6	/* 16, 32, ... 512 bytes */
+
+/**
+ * struct slab_class - Objects of one size in a pool
+ *
+ * @free:	Free objects, each holding a pointer to the next
+ * @used:	Number of objects allocated
+ * @total:	Number of objects in the pool's pages of this size
+ * @peak:	Highest value of @used
+ */
+struct slab_class {
+	void *free;
+	uint used;
+	uint total;
+	uint peak;
+};
+
+/**
+ * struct slab_pool - A set of slab pages which are released together
+ *
+ * Declare one with SLAB_POOL() for each subsystem. A pool is added to the
+ * list shown by 'malloc info' when it first allocates.
+ *
+ * @name:	Name of the pool
+ * @pages:	Pages owned by the pool, linked through their headers
+ * @num_pages:	Number of pages owned by the pool
+ * @fallback:	Number of allocations passed to malloc() as the slab area
+ *		was full
+ * @next:	Next pool in the list
+ * @class:	Objects of each size
+ */
+struct slab_pool {
+	const char *name;
+	struct slab_page *pages;
+	uint num_pages;
+	uint fallback;
+	struct slab_pool *next;
+	struct slab_class class[SLAB_CLASSES];
+};
+
+#define SLAB_POOL(_name)	{ .name = _name }
+
+#if defined(CONFIG_SYS_MALLOC_SLAB) && !defined(CONFIG_SPL_BUILD)
+
+/**
+ * slab_init() - Set up the slab area
+ *
+ * This is called by mem_malloc_init() with memory at the top of the
+ * malloc() area.
+ *
+ * @start:	Start of the area
+ * @size:	Size of the area in bytes
+ */
+void slab_init(ulong start, ulong size);
+
+/**
+ * slab_alloc() - Allocate a small object from a pool
+ *
+ * @pool:	Pool to allocate from
+ * @size:	Size of the object in bytes
+ * @return pointer to the object, or NULL if @size is larger than
+ * SLAB_MAX_SIZE, the slab area is full or not set up yet
+ */
+void *slab_alloc(struct slab_pool *pool, size_t size);
+
+/**
+ * slab_owns() - Check whether a pointer is in the slab area
+ *
+ * @ptr:	Pointer to check
+ * @return true if @ptr was allocated by slab_alloc()
+ */
+bool slab_owns(const void *ptr);
+
+/**
+ * slab_free() - Return an object to its pool
+ *
+ * free() calls this for objects in the slab area, so callers do not need
+ * to.
+ *
+ * @ptr:	Object to free, which must be in the slab area
+ */
+void slab_free(void *ptr);
+
+/**
+ * slab_size() - Get the usable size of an object
+ *
+ * @ptr:	Object, which must be in the slab area
+ * @return the size of the object's class in bytes
+ */
+size_t slab_size(const void *ptr);
+
+/**
+ * slab_release() - Release all pages owned by a pool
+ *
+ * This returns the pool's pages to the slab area in one go, without
+ * walking its objects. Any objects still allocated from the pool are lost
+ * and must not be used or freed afterwards.
+ *
+ * @pool:	Pool to release
+ */
+void slab_release(struct slab_pool *pool);
+
+/**
+ * slab_used_bytes() - Get the number of bytes in allocated objects
+ *
+ * @return total size of the objects allocated from all pools
+ */
+ulong slab_used_bytes(void);
+
+/**
+ * slab_print_stats() - Print the use of the slab area and each pool
+ */
+void slab_print_stats(void);
+
+#else
+
+static inline void *slab_alloc(struct slab_pool *pool, size_t size)
+{
+	return NULL;
+}
+
+static inline bool slab_owns(const void *ptr)
+{
+	return false;
+}
+
+static inline void slab_free(void *ptr)
+{
+}
+
+static inline size_t slab_size(const void *ptr)
+{
+	return 0;
+}
+
+static inline void slab_release(struct slab_pool *pool)
+{
+}
+
+#endif
+
+/**
+ * slab_malloc() - Allocate a small object from a pool, or with malloc()
+ *
+ * @pool:	Pool to allocate from
+ * @size:	Size of the object in bytes
+ * @return pointer to the object, which is freed with free(), or NULL if
+ * out of memory
+ */
+static inline void *slab_malloc(struct slab_pool *pool, size_t size)
+{
+	void *ptr = slab_alloc(pool, size);
+
+	return ptr ? ptr : malloc(size);
+}
+
+/**
+ * slab_calloc() - Allocate a zeroed small object from a pool, or with
+ * calloc()
+ *
+ * @pool:	Pool to allocate from
+ * @size:	Size of the object in bytes
+ * @return pointer to the object, which is freed with free(), or NULL if
+ * out of memory
+ */
+static inline void *slab_calloc(struct slab_pool *pool, size_t size)
+{
+	void *ptr = slab_alloc(pool, size);
+
+	if (!ptr)
+		return calloc(1, size);
+	memset(ptr, '\0', size);
+
+	return ptr;
+}
+
+#endif
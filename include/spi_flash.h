@@ -46,6 +46,7 @@ struct spi_slave;
  * @page_size:		Write (page) size
  * @sector_size:	Sector size
  * @erase_size:		Erase size
+ * @block_size:		Erase size of CMD_ERASE_64K, at least erase_size
  * @bank_read_cmd:	Bank read cmd
  * @bank_write_cmd:	Bank write cmd
  * @bank_curr:		Current flash bank
@@ -60,7 +61,7 @@ struct spi_slave;
  * @write:		Flash write ops: Write len bytes from buf into offset
  *			Supported cmds: Page Program
  * @erase:		Flash erase ops: Erase len bytes from offset
- *			Supported cmds: Sector erase 4K, 32K, 64K
+ *			Supported cmds: Sector erase 4K, 32K, 64K, chip erase
  * return 0 - Success, 1 - Failure
  */
 struct spi_flash {
@@ -77,6 +78,7 @@ struct spi_flash {
 	u32 page_size;
 	u32 sector_size;
 	u32 erase_size;
+	u32 block_size;
 #ifdef CONFIG_SPI_FLASH_BAR
 	u8 bank_read_cmd;
 	u8 bank_write_cmd;
@@ -192,6 +194,34 @@ int sandbox_sf_bind_emul(struct sandbox_state *state, int busnum, int cs,
 
 void sandbox_sf_unbind_emul(struct sandbox_state *state, int busnum, int cs);
 
+/**
+ * struct sandbox_sf_stats - work done by the sandbox SPI flash emulation
+ *
+ * @erase_4k:	Number of 4KB sector erases
+ * @erase_32k:	Number of 32KB block erases
+ * @erase_64k:	Number of 64KB block erases
+ * @erase_chip:	Number of chip erases
+ * @programs:	Number of page programs
+ */
+struct sandbox_sf_stats {
+	ulong erase_4k;
+	ulong erase_32k;
+	ulong erase_64k;
+	ulong erase_chip;
+	ulong programs;
+};
+
+/**
+ * sandbox_sf_get_stats() - Get the work done by SPI flash emulations
+ *
+ * The emulation advances the sandbox timer by the time a real chip would
+ * take, so get_timer() can be used to see how long the work took.
+ *
+ * @stats:	Returns the counts since the last reset
+ * @reset:	true to reset the counts afterwards
+ */
+void sandbox_sf_get_stats(struct sandbox_sf_stats *stats, bool reset);
+
 #else
 struct spi_flash *spi_flash_probe(unsigned int bus, unsigned int cs,
 		unsigned int max_hz, unsigned int spi_mode);
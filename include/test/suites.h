@@ -8,8 +8,26 @@
 #ifndef __TEST_SUITES_H__
 #define __TEST_SUITES_H__
 
+int do_ut_bootstage(cmd_tbl_t *cmdtp, int flag, int argc,
+		    char * const argv[]);
+int do_ut_crc32(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[]);
 int do_ut_dm(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[]);
 int do_ut_env(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[]);
+int do_ut_ext4(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[]);
+int do_ut_fat(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[]);
+int do_ut_fdtdec(cmd_tbl_t *cmdtp, int flag, int argc,
+		 char * const argv[]);
+int do_ut_hash(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[]);
+int do_ut_initcall(cmd_tbl_t *cmdtp, int flag, int argc,
+		   char * const argv[]);
+int do_ut_malloc_f(cmd_tbl_t *cmdtp, int flag, int argc,
+		   char * const argv[]);
+int do_ut_mem(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[]);
+int do_ut_pic32eth(cmd_tbl_t *cmdtp, int flag, int argc,
+		   char * const argv[]);
+int do_ut_slab(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[]);
+int do_ut_sdhci(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[]);
+int do_ut_trace(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[]);
 int do_ut_time(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[]);
 
 #endif /* __TEST_SUITES_H__ */
@@ -24,11 +24,19 @@ enum {
 	 * this value.
 	 */
 	FUNC_SITE_SIZE	= 4,	/* distance between function sites */
+
+	/*
+	 * Each function has a histogram of the inclusive time of its calls.
+	 * Bucket 0 counts calls of less than 1us, and bucket n calls of at
+	 * least 4^(n-1) us, the last bucket holding all the longer calls.
+	 */
+	TRACE_HIST_BUCKETS	= 8,
 };
 
 enum trace_chunk_type {
 	TRACE_CHUNK_FUNCS,
 	TRACE_CHUNK_CALLS,
+	TRACE_CHUNK_TIMES,
 };
 
 /* A trace record for a function, as written to the profile output file */
@@ -37,6 +45,15 @@ struct trace_output_func {
 	uint32_t call_count;		/* Number of times called */
 };
 
+/* A record of the time spent in a function, as written to the output file */
+struct trace_output_time {
+	uint32_t offset;		/* Function offset into code */
+	uint32_t call_count;		/* Number of calls which returned */
+	uint64_t incl_us;		/* Time in function and its callees */
+	uint64_t excl_us;		/* Time in the function itself */
+	uint32_t hist[TRACE_HIST_BUCKETS];	/* Calls by inclusive time */
+};
+
 /* A header at the start of the trace output buffer */
 struct trace_output_hdr {
 	enum trace_chunk_type type;	/* Record type */
@@ -78,8 +95,35 @@ struct trace_call {
 	uint32_t flags;		/* Flags and timestamp */
 };
 
+/**
+ * Dump the list of function calls into a buffer, oldest first
+ *
+ * @param buff		Buffer in which to place data, or NULL to count size
+ * @param buff_size	Size of buffer
+ * @param needed	Returns number of bytes used / needed
+ * @return 0 if ok, -1 on error (buffer exhausted)
+ */
 int trace_list_calls(void *buff, int buff_size, unsigned int *needed);
 
+/**
+ * Dump the time spent in each function into a buffer
+ *
+ * Each record in the buffer is a struct trace_output_time.
+ *
+ * @param buff		Buffer in which to place data, or NULL to count size
+ * @param buff_size	Size of buffer
+ * @param needed	Returns number of bytes used / needed
+ * @return 0 if ok, -1 on error (buffer exhausted)
+ */
+int trace_list_times(void *buff, int buff_size, unsigned int *needed);
+
+/**
+ * Print the functions which took the most time, excluding their callees
+ *
+ * @param count		Number of functions to print
+ */
+void trace_print_times(int count);
+
 /**
  * Turn function tracing on and off
  *
@@ -89,6 +133,32 @@ int trace_list_calls(void *buff, int buff_size, unsigned int *needed);
  */
 void trace_set_enabled(int enabled);
 
+/**
+ * Set how function calls are recorded in the call list
+ *
+ * Changing between ring and flat mode empties the call list. The time spent
+ * in each function is kept for all calls in any mode.
+ *
+ * @param ring		1 to keep the most recent calls when the list is
+ *			full, 0 to stop recording
+ * @param sample	Record one call in this many, 1 to record all
+ * @return 0 if ok, -1 if trace is not initialised or sample is 0
+ */
+int trace_set_mode(int ring, unsigned int sample);
+
+/**
+ * Record calls in a private buffer, for tests
+ *
+ * Tracing is paused and the calls recorded so far are kept aside until the
+ * private buffer is dropped again. The private buffer starts with nothing
+ * recorded and keeps no call counts.
+ *
+ * @param records	Number of calls the private call list can hold, or 0
+ *			to drop it and go back to the calls recorded before
+ * @return 0 if ok, -1 on error
+ */
+int trace_test_state(int records);
+
 int trace_early_init(void);
 
 /**
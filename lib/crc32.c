@@ -26,6 +26,16 @@
 
 #define tole(x) cpu_to_le32(x)
 
+#if defined(CONFIG_CRC32_SLICE_BY_16)
+# define CRC32_SLICES 16
+#elif defined(CONFIG_CRC32_SLICE_BY_8)
+# define CRC32_SLICES 8
+#endif
+
+#if defined(DYNAMIC_CRC_TABLE) && defined(CRC32_SLICES)
+# error "DYNAMIC_CRC_TABLE cannot be used with the slicing-by-N CRC32 engine"
+#endif
+
 #ifdef DYNAMIC_CRC_TABLE
 
 local int crc_table_empty = 1;
@@ -83,6 +93,10 @@ local void make_crc_table()
  * Table of CRC-32's of all single-byte values (made by make_crc_table)
  */
 
+#ifdef CRC32_SLICES
+#include "crc32table.h"
+#define crc_table crc_table_slice[0]
+#else
 local const uint32_t crc_table[256] = {
 tole(0x00000000L), tole(0x77073096L), tole(0xee0e612cL), tole(0x990951baL),
 tole(0x076dc419L), tole(0x706af48fL), tole(0xe963a535L), tole(0x9e6495a3L),
@@ -149,6 +163,7 @@ tole(0xbad03605L), tole(0xcdd70693L), tole(0x54de5729L), tole(0x23d967bfL),
 tole(0xb3667a2eL), tole(0xc4614ab8L), tole(0x5d681b02L), tole(0x2a6f2b94L),
 tole(0xb40bbe37L), tole(0xc30c8ea1L), tole(0x5a05df1bL), tole(0x2d02ef8dL)
 };
+#endif /* CRC32_SLICES */
 #endif
 
 #if 0
@@ -167,10 +182,45 @@ const uint32_t * ZEXPORT get_crc_table()
 /* ========================================================================= */
 # if __BYTE_ORDER == __LITTLE_ENDIAN
 #  define DO_CRC(x) crc = tab[(crc ^ (x)) & 255] ^ (crc >> 8)
+#  define DO_SLICE(t, q) ((t)[3][(q) & 255] ^ (t)[2][((q) >> 8) & 255] ^ \
+			  (t)[1][((q) >> 16) & 255] ^ (t)[0][(q) >> 24])
 # else
 #  define DO_CRC(x) crc = tab[((crc >> 24) ^ (x)) & 255] ^ (crc << 8)
+#  define DO_SLICE(t, q) ((t)[0][(q) & 255] ^ (t)[1][((q) >> 8) & 255] ^ \
+			  (t)[2][((q) >> 16) & 255] ^ (t)[3][(q) >> 24])
 # endif
 
+#ifdef CRC32_SLICES
+/*
+ * Slicing-by-8/16 inner loop: process CRC32_SLICES bytes per iteration with
+ * one table lookup per byte, but with no dependency between the lookups
+ * within a block so that they can be issued in parallel. 'b' must be 32-bit
+ * aligned and 'len' is the number of CRC32_SLICES-byte blocks.
+ */
+static uint32_t crc32_slice(uint32_t crc, const uint32_t *b, size_t len)
+{
+	const uint32_t (*t)[256] = crc_table_slice;
+	uint32_t q;
+
+	for (; len; --len) {
+		q = crc ^ *b++;
+#if CRC32_SLICES > 8
+		crc = DO_SLICE(&t[12], q);
+		q = *b++;
+		crc ^= DO_SLICE(&t[8], q);
+		q = *b++;
+		crc ^= DO_SLICE(&t[4], q);
+#else
+		crc = DO_SLICE(&t[4], q);
+#endif
+		q = *b++;
+		crc ^= DO_SLICE(&t[0], q);
+	}
+
+	return crc;
+}
+#endif
+
 /* ========================================================================= */
 
 /* No ones complement version. JFFS2 (and other things ?)
@@ -195,6 +245,15 @@ uint32_t ZEXPORT crc32_no_comp(uint32_t crc, const Bytef *buf, uInt len)
 	 b = (uint32_t *)p;
     }
 
+#ifdef CRC32_SLICES
+    /* Word-aligned fast path: CRC32_SLICES bytes per iteration */
+    if (len >= CRC32_SLICES) {
+	 crc = crc32_slice(crc, b, len / CRC32_SLICES);
+	 b += (len / CRC32_SLICES) * (CRC32_SLICES / 4);
+	 len &= CRC32_SLICES - 1;
+    }
+#endif
+
     rem_len = len & 3;
     len = len >> 2;
     for (--b; len; --len) {
@@ -216,6 +275,7 @@ uint32_t ZEXPORT crc32_no_comp(uint32_t crc, const Bytef *buf, uInt len)
 
     return le32_to_cpu(crc);
 }
+#undef DO_SLICE
 #undef DO_CRC
 
 uint32_t ZEXPORT crc32 (uint32_t crc, const Bytef *p, uInt len)
@@ -0,0 +1,1080 @@
+/*
+ * Lookup tables for the slicing-by-8/16 CRC32 engine in lib/crc32.c
+ *
+ * Row 0 is the usual byte-wise table. Row k holds the CRC of each byte value
+ * followed by k zero bytes:
+ *
+ *   crc_table_slice[k][n] = (crc_table_slice[k - 1][n] >> 8) ^
+ *			     crc_table_slice[0][crc_table_slice[k - 1][n] & 255]
+ *
+ * The tables are constant so that they can be used before relocation, when
+ * BSS is not yet available.
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#ifndef __CRC32TABLE_H
+#define __CRC32TABLE_H
+
+local const uint32_t crc_table_slice[CRC32_SLICES][256] = {
+{
+tole(0x00000000L), tole(0x77073096L), tole(0xee0e612cL), tole(0x990951baL),
+tole(0x076dc419L), tole(0x706af48fL), tole(0xe963a535L), tole(0x9e6495a3L),
+tole(0x0edb8832L), tole(0x79dcb8a4L), tole(0xe0d5e91eL), tole(0x97d2d988L),
+tole(0x09b64c2bL), tole(0x7eb17cbdL), tole(0xe7b82d07L), tole(0x90bf1d91L),
+tole(0x1db71064L), tole(0x6ab020f2L), tole(0xf3b97148L), tole(0x84be41deL),
+tole(0x1adad47dL), tole(0x6ddde4ebL), tole(0xf4d4b551L), tole(0x83d385c7L),
+tole(0x136c9856L), tole(0x646ba8c0L), tole(0xfd62f97aL), tole(0x8a65c9ecL),
+tole(0x14015c4fL), tole(0x63066cd9L), tole(0xfa0f3d63L), tole(0x8d080df5L),
+tole(0x3b6e20c8L), tole(0x4c69105eL), tole(0xd56041e4L), tole(0xa2677172L),
+tole(0x3c03e4d1L), tole(0x4b04d447L), tole(0xd20d85fdL), tole(0xa50ab56bL),
+tole(0x35b5a8faL), tole(0x42b2986cL), tole(0xdbbbc9d6L), tole(0xacbcf940L),
+tole(0x32d86ce3L), tole(0x45df5c75L), tole(0xdcd60dcfL), tole(0xabd13d59L),
+tole(0x26d930acL), tole(0x51de003aL), tole(0xc8d75180L), tole(0xbfd06116L),
+tole(0x21b4f4b5L), tole(0x56b3c423L), tole(0xcfba9599L), tole(0xb8bda50fL),
+tole(0x2802b89eL), tole(0x5f058808L), tole(0xc60cd9b2L), tole(0xb10be924L),
+tole(0x2f6f7c87L), tole(0x58684c11L), tole(0xc1611dabL), tole(0xb6662d3dL),
+tole(0x76dc4190L), tole(0x01db7106L), tole(0x98d220bcL), tole(0xefd5102aL),
+tole(0x71b18589L), tole(0x06b6b51fL), tole(0x9fbfe4a5L), tole(0xe8b8d433L),
+tole(0x7807c9a2L), tole(0x0f00f934L), tole(0x9609a88eL), tole(0xe10e9818L),
+tole(0x7f6a0dbbL), tole(0x086d3d2dL), tole(0x91646c97L), tole(0xe6635c01L),
+tole(0x6b6b51f4L), tole(0x1c6c6162L), tole(0x856530d8L), tole(0xf262004eL),
+tole(0x6c0695edL), tole(0x1b01a57bL), tole(0x8208f4c1L), tole(0xf50fc457L),
+tole(0x65b0d9c6L), tole(0x12b7e950L), tole(0x8bbeb8eaL), tole(0xfcb9887cL),
+tole(0x62dd1ddfL), tole(0x15da2d49L), tole(0x8cd37cf3L), tole(0xfbd44c65L),
+tole(0x4db26158L), tole(0x3ab551ceL), tole(0xa3bc0074L), tole(0xd4bb30e2L),
+tole(0x4adfa541L), tole(0x3dd895d7L), tole(0xa4d1c46dL), tole(0xd3d6f4fbL),
+tole(0x4369e96aL), tole(0x346ed9fcL), tole(0xad678846L), tole(0xda60b8d0L),
+tole(0x44042d73L), tole(0x33031de5L), tole(0xaa0a4c5fL), tole(0xdd0d7cc9L),
+tole(0x5005713cL), tole(0x270241aaL), tole(0xbe0b1010L), tole(0xc90c2086L),
+tole(0x5768b525L), tole(0x206f85b3L), tole(0xb966d409L), tole(0xce61e49fL),
+tole(0x5edef90eL), tole(0x29d9c998L), tole(0xb0d09822L), tole(0xc7d7a8b4L),
+tole(0x59b33d17L), tole(0x2eb40d81L), tole(0xb7bd5c3bL), tole(0xc0ba6cadL),
+tole(0xedb88320L), tole(0x9abfb3b6L), tole(0x03b6e20cL), tole(0x74b1d29aL),
+tole(0xead54739L), tole(0x9dd277afL), tole(0x04db2615L), tole(0x73dc1683L),
+tole(0xe3630b12L), tole(0x94643b84L), tole(0x0d6d6a3eL), tole(0x7a6a5aa8L),
+tole(0xe40ecf0bL), tole(0x9309ff9dL), tole(0x0a00ae27L), tole(0x7d079eb1L),
+tole(0xf00f9344L), tole(0x8708a3d2L), tole(0x1e01f268L), tole(0x6906c2feL),
+tole(0xf762575dL), tole(0x806567cbL), tole(0x196c3671L), tole(0x6e6b06e7L),
+tole(0xfed41b76L), tole(0x89d32be0L), tole(0x10da7a5aL), tole(0x67dd4accL),
+tole(0xf9b9df6fL), tole(0x8ebeeff9L), tole(0x17b7be43L), tole(0x60b08ed5L),
+tole(0xd6d6a3e8L), tole(0xa1d1937eL), tole(0x38d8c2c4L), tole(0x4fdff252L),
+tole(0xd1bb67f1L), tole(0xa6bc5767L), tole(0x3fb506ddL), tole(0x48b2364bL),
+tole(0xd80d2bdaL), tole(0xaf0a1b4cL), tole(0x36034af6L), tole(0x41047a60L),
+tole(0xdf60efc3L), tole(0xa867df55L), tole(0x316e8eefL), tole(0x4669be79L),
+tole(0xcb61b38cL), tole(0xbc66831aL), tole(0x256fd2a0L), tole(0x5268e236L),
+tole(0xcc0c7795L), tole(0xbb0b4703L), tole(0x220216b9L), tole(0x5505262fL),
+tole(0xc5ba3bbeL), tole(0xb2bd0b28L), tole(0x2bb45a92L), tole(0x5cb36a04L),
+tole(0xc2d7ffa7L), tole(0xb5d0cf31L), tole(0x2cd99e8bL), tole(0x5bdeae1dL),
+tole(0x9b64c2b0L), tole(0xec63f226L), tole(0x756aa39cL), tole(0x026d930aL),
+tole(0x9c0906a9L), tole(0xeb0e363fL), tole(0x72076785L), tole(0x05005713L),
+tole(0x95bf4a82L), tole(0xe2b87a14L), tole(0x7bb12baeL), tole(0x0cb61b38L),
+tole(0x92d28e9bL), tole(0xe5d5be0dL), tole(0x7cdcefb7L), tole(0x0bdbdf21L),
+tole(0x86d3d2d4L), tole(0xf1d4e242L), tole(0x68ddb3f8L), tole(0x1fda836eL),
+tole(0x81be16cdL), tole(0xf6b9265bL), tole(0x6fb077e1L), tole(0x18b74777L),
+tole(0x88085ae6L), tole(0xff0f6a70L), tole(0x66063bcaL), tole(0x11010b5cL),
+tole(0x8f659effL), tole(0xf862ae69L), tole(0x616bffd3L), tole(0x166ccf45L),
+tole(0xa00ae278L), tole(0xd70dd2eeL), tole(0x4e048354L), tole(0x3903b3c2L),
+tole(0xa7672661L), tole(0xd06016f7L), tole(0x4969474dL), tole(0x3e6e77dbL),
+tole(0xaed16a4aL), tole(0xd9d65adcL), tole(0x40df0b66L), tole(0x37d83bf0L),
+tole(0xa9bcae53L), tole(0xdebb9ec5L), tole(0x47b2cf7fL), tole(0x30b5ffe9L),
+tole(0xbdbdf21cL), tole(0xcabac28aL), tole(0x53b39330L), tole(0x24b4a3a6L),
+tole(0xbad03605L), tole(0xcdd70693L), tole(0x54de5729L), tole(0x23d967bfL),
+tole(0xb3667a2eL), tole(0xc4614ab8L), tole(0x5d681b02L), tole(0x2a6f2b94L),
+tole(0xb40bbe37L), tole(0xc30c8ea1L), tole(0x5a05df1bL), tole(0x2d02ef8dL)
+},
+{
+tole(0x00000000L), tole(0x191b3141L), tole(0x32366282L), tole(0x2b2d53c3L),
+tole(0x646cc504L), tole(0x7d77f445L), tole(0x565aa786L), tole(0x4f4196c7L),
+tole(0xc8d98a08L), tole(0xd1c2bb49L), tole(0xfaefe88aL), tole(0xe3f4d9cbL),
+tole(0xacb54f0cL), tole(0xb5ae7e4dL), tole(0x9e832d8eL), tole(0x87981ccfL),
+tole(0x4ac21251L), tole(0x53d92310L), tole(0x78f470d3L), tole(0x61ef4192L),
+tole(0x2eaed755L), tole(0x37b5e614L), tole(0x1c98b5d7L), tole(0x05838496L),
+tole(0x821b9859L), tole(0x9b00a918L), tole(0xb02dfadbL), tole(0xa936cb9aL),
+tole(0xe6775d5dL), tole(0xff6c6c1cL), tole(0xd4413fdfL), tole(0xcd5a0e9eL),
+tole(0x958424a2L), tole(0x8c9f15e3L), tole(0xa7b24620L), tole(0xbea97761L),
+tole(0xf1e8e1a6L), tole(0xe8f3d0e7L), tole(0xc3de8324L), tole(0xdac5b265L),
+tole(0x5d5daeaaL), tole(0x44469febL), tole(0x6f6bcc28L), tole(0x7670fd69L),
+tole(0x39316baeL), tole(0x202a5aefL), tole(0x0b07092cL), tole(0x121c386dL),
+tole(0xdf4636f3L), tole(0xc65d07b2L), tole(0xed705471L), tole(0xf46b6530L),
+tole(0xbb2af3f7L), tole(0xa231c2b6L), tole(0x891c9175L), tole(0x9007a034L),
+tole(0x179fbcfbL), tole(0x0e848dbaL), tole(0x25a9de79L), tole(0x3cb2ef38L),
+tole(0x73f379ffL), tole(0x6ae848beL), tole(0x41c51b7dL), tole(0x58de2a3cL),
+tole(0xf0794f05L), tole(0xe9627e44L), tole(0xc24f2d87L), tole(0xdb541cc6L),
+tole(0x94158a01L), tole(0x8d0ebb40L), tole(0xa623e883L), tole(0xbf38d9c2L),
+tole(0x38a0c50dL), tole(0x21bbf44cL), tole(0x0a96a78fL), tole(0x138d96ceL),
+tole(0x5ccc0009L), tole(0x45d73148L), tole(0x6efa628bL), tole(0x77e153caL),
+tole(0xbabb5d54L), tole(0xa3a06c15L), tole(0x888d3fd6L), tole(0x91960e97L),
+tole(0xded79850L), tole(0xc7cca911L), tole(0xece1fad2L), tole(0xf5facb93L),
+tole(0x7262d75cL), tole(0x6b79e61dL), tole(0x4054b5deL), tole(0x594f849fL),
+tole(0x160e1258L), tole(0x0f152319L), tole(0x243870daL), tole(0x3d23419bL),
+tole(0x65fd6ba7L), tole(0x7ce65ae6L), tole(0x57cb0925L), tole(0x4ed03864L),
+tole(0x0191aea3L), tole(0x188a9fe2L), tole(0x33a7cc21L), tole(0x2abcfd60L),
+tole(0xad24e1afL), tole(0xb43fd0eeL), tole(0x9f12832dL), tole(0x8609b26cL),
+tole(0xc94824abL), tole(0xd05315eaL), tole(0xfb7e4629L), tole(0xe2657768L),
+tole(0x2f3f79f6L), tole(0x362448b7L), tole(0x1d091b74L), tole(0x04122a35L),
+tole(0x4b53bcf2L), tole(0x52488db3L), tole(0x7965de70L), tole(0x607eef31L),
+tole(0xe7e6f3feL), tole(0xfefdc2bfL), tole(0xd5d0917cL), tole(0xcccba03dL),
+tole(0x838a36faL), tole(0x9a9107bbL), tole(0xb1bc5478L), tole(0xa8a76539L),
+tole(0x3b83984bL), tole(0x2298a90aL), tole(0x09b5fac9L), tole(0x10aecb88L),
+tole(0x5fef5d4fL), tole(0x46f46c0eL), tole(0x6dd93fcdL), tole(0x74c20e8cL),
+tole(0xf35a1243L), tole(0xea412302L), tole(0xc16c70c1L), tole(0xd8774180L),
+tole(0x9736d747L), tole(0x8e2de606L), tole(0xa500b5c5L), tole(0xbc1b8484L),
+tole(0x71418a1aL), tole(0x685abb5bL), tole(0x4377e898L), tole(0x5a6cd9d9L),
+tole(0x152d4f1eL), tole(0x0c367e5fL), tole(0x271b2d9cL), tole(0x3e001cddL),
+tole(0xb9980012L), tole(0xa0833153L), tole(0x8bae6290L), tole(0x92b553d1L),
+tole(0xddf4c516L), tole(0xc4eff457L), tole(0xefc2a794L), tole(0xf6d996d5L),
+tole(0xae07bce9L), tole(0xb71c8da8L), tole(0x9c31de6bL), tole(0x852aef2aL),
+tole(0xca6b79edL), tole(0xd37048acL), tole(0xf85d1b6fL), tole(0xe1462a2eL),
+tole(0x66de36e1L), tole(0x7fc507a0L), tole(0x54e85463L), tole(0x4df36522L),
+tole(0x02b2f3e5L), tole(0x1ba9c2a4L), tole(0x30849167L), tole(0x299fa026L),
+tole(0xe4c5aeb8L), tole(0xfdde9ff9L), tole(0xd6f3cc3aL), tole(0xcfe8fd7bL),
+tole(0x80a96bbcL), tole(0x99b25afdL), tole(0xb29f093eL), tole(0xab84387fL),
+tole(0x2c1c24b0L), tole(0x350715f1L), tole(0x1e2a4632L), tole(0x07317773L),
+tole(0x4870e1b4L), tole(0x516bd0f5L), tole(0x7a468336L), tole(0x635db277L),
+tole(0xcbfad74eL), tole(0xd2e1e60fL), tole(0xf9ccb5ccL), tole(0xe0d7848dL),
+tole(0xaf96124aL), tole(0xb68d230bL), tole(0x9da070c8L), tole(0x84bb4189L),
+tole(0x03235d46L), tole(0x1a386c07L), tole(0x31153fc4L), tole(0x280e0e85L),
+tole(0x674f9842L), tole(0x7e54a903L), tole(0x5579fac0L), tole(0x4c62cb81L),
+tole(0x8138c51fL), tole(0x9823f45eL), tole(0xb30ea79dL), tole(0xaa1596dcL),
+tole(0xe554001bL), tole(0xfc4f315aL), tole(0xd7626299L), tole(0xce7953d8L),
+tole(0x49e14f17L), tole(0x50fa7e56L), tole(0x7bd72d95L), tole(0x62cc1cd4L),
+tole(0x2d8d8a13L), tole(0x3496bb52L), tole(0x1fbbe891L), tole(0x06a0d9d0L),
+tole(0x5e7ef3ecL), tole(0x4765c2adL), tole(0x6c48916eL), tole(0x7553a02fL),
+tole(0x3a1236e8L), tole(0x230907a9L), tole(0x0824546aL), tole(0x113f652bL),
+tole(0x96a779e4L), tole(0x8fbc48a5L), tole(0xa4911b66L), tole(0xbd8a2a27L),
+tole(0xf2cbbce0L), tole(0xebd08da1L), tole(0xc0fdde62L), tole(0xd9e6ef23L),
+tole(0x14bce1bdL), tole(0x0da7d0fcL), tole(0x268a833fL), tole(0x3f91b27eL),
+tole(0x70d024b9L), tole(0x69cb15f8L), tole(0x42e6463bL), tole(0x5bfd777aL),
+tole(0xdc656bb5L), tole(0xc57e5af4L), tole(0xee530937L), tole(0xf7483876L),
+tole(0xb809aeb1L), tole(0xa1129ff0L), tole(0x8a3fcc33L), tole(0x9324fd72L)
+},
+{
+tole(0x00000000L), tole(0x01c26a37L), tole(0x0384d46eL), tole(0x0246be59L),
+tole(0x0709a8dcL), tole(0x06cbc2ebL), tole(0x048d7cb2L), tole(0x054f1685L),
+tole(0x0e1351b8L), tole(0x0fd13b8fL), tole(0x0d9785d6L), tole(0x0c55efe1L),
+tole(0x091af964L), tole(0x08d89353L), tole(0x0a9e2d0aL), tole(0x0b5c473dL),
+tole(0x1c26a370L), tole(0x1de4c947L), tole(0x1fa2771eL), tole(0x1e601d29L),
+tole(0x1b2f0bacL), tole(0x1aed619bL), tole(0x18abdfc2L), tole(0x1969b5f5L),
+tole(0x1235f2c8L), tole(0x13f798ffL), tole(0x11b126a6L), tole(0x10734c91L),
+tole(0x153c5a14L), tole(0x14fe3023L), tole(0x16b88e7aL), tole(0x177ae44dL),
+tole(0x384d46e0L), tole(0x398f2cd7L), tole(0x3bc9928eL), tole(0x3a0bf8b9L),
+tole(0x3f44ee3cL), tole(0x3e86840bL), tole(0x3cc03a52L), tole(0x3d025065L),
+tole(0x365e1758L), tole(0x379c7d6fL), tole(0x35dac336L), tole(0x3418a901L),
+tole(0x3157bf84L), tole(0x3095d5b3L), tole(0x32d36beaL), tole(0x331101ddL),
+tole(0x246be590L), tole(0x25a98fa7L), tole(0x27ef31feL), tole(0x262d5bc9L),
+tole(0x23624d4cL), tole(0x22a0277bL), tole(0x20e69922L), tole(0x2124f315L),
+tole(0x2a78b428L), tole(0x2bbade1fL), tole(0x29fc6046L), tole(0x283e0a71L),
+tole(0x2d711cf4L), tole(0x2cb376c3L), tole(0x2ef5c89aL), tole(0x2f37a2adL),
+tole(0x709a8dc0L), tole(0x7158e7f7L), tole(0x731e59aeL), tole(0x72dc3399L),
+tole(0x7793251cL), tole(0x76514f2bL), tole(0x7417f172L), tole(0x75d59b45L),
+tole(0x7e89dc78L), tole(0x7f4bb64fL), tole(0x7d0d0816L), tole(0x7ccf6221L),
+tole(0x798074a4L), tole(0x78421e93L), tole(0x7a04a0caL), tole(0x7bc6cafdL),
+tole(0x6cbc2eb0L), tole(0x6d7e4487L), tole(0x6f38fadeL), tole(0x6efa90e9L),
+tole(0x6bb5866cL), tole(0x6a77ec5bL), tole(0x68315202L), tole(0x69f33835L),
+tole(0x62af7f08L), tole(0x636d153fL), tole(0x612bab66L), tole(0x60e9c151L),
+tole(0x65a6d7d4L), tole(0x6464bde3L), tole(0x662203baL), tole(0x67e0698dL),
+tole(0x48d7cb20L), tole(0x4915a117L), tole(0x4b531f4eL), tole(0x4a917579L),
+tole(0x4fde63fcL), tole(0x4e1c09cbL), tole(0x4c5ab792L), tole(0x4d98dda5L),
+tole(0x46c49a98L), tole(0x4706f0afL), tole(0x45404ef6L), tole(0x448224c1L),
+tole(0x41cd3244L), tole(0x400f5873L), tole(0x4249e62aL), tole(0x438b8c1dL),
+tole(0x54f16850L), tole(0x55330267L), tole(0x5775bc3eL), tole(0x56b7d609L),
+tole(0x53f8c08cL), tole(0x523aaabbL), tole(0x507c14e2L), tole(0x51be7ed5L),
+tole(0x5ae239e8L), tole(0x5b2053dfL), tole(0x5966ed86L), tole(0x58a487b1L),
+tole(0x5deb9134L), tole(0x5c29fb03L), tole(0x5e6f455aL), tole(0x5fad2f6dL),
+tole(0xe1351b80L), tole(0xe0f771b7L), tole(0xe2b1cfeeL), tole(0xe373a5d9L),
+tole(0xe63cb35cL), tole(0xe7fed96bL), tole(0xe5b86732L), tole(0xe47a0d05L),
+tole(0xef264a38L), tole(0xeee4200fL), tole(0xeca29e56L), tole(0xed60f461L),
+tole(0xe82fe2e4L), tole(0xe9ed88d3L), tole(0xebab368aL), tole(0xea695cbdL),
+tole(0xfd13b8f0L), tole(0xfcd1d2c7L), tole(0xfe976c9eL), tole(0xff5506a9L),
+tole(0xfa1a102cL), tole(0xfbd87a1bL), tole(0xf99ec442L), tole(0xf85cae75L),
+tole(0xf300e948L), tole(0xf2c2837fL), tole(0xf0843d26L), tole(0xf1465711L),
+tole(0xf4094194L), tole(0xf5cb2ba3L), tole(0xf78d95faL), tole(0xf64fffcdL),
+tole(0xd9785d60L), tole(0xd8ba3757L), tole(0xdafc890eL), tole(0xdb3ee339L),
+tole(0xde71f5bcL), tole(0xdfb39f8bL), tole(0xddf521d2L), tole(0xdc374be5L),
+tole(0xd76b0cd8L), tole(0xd6a966efL), tole(0xd4efd8b6L), tole(0xd52db281L),
+tole(0xd062a404L), tole(0xd1a0ce33L), tole(0xd3e6706aL), tole(0xd2241a5dL),
+tole(0xc55efe10L), tole(0xc49c9427L), tole(0xc6da2a7eL), tole(0xc7184049L),
+tole(0xc25756ccL), tole(0xc3953cfbL), tole(0xc1d382a2L), tole(0xc011e895L),
+tole(0xcb4dafa8L), tole(0xca8fc59fL), tole(0xc8c97bc6L), tole(0xc90b11f1L),
+tole(0xcc440774L), tole(0xcd866d43L), tole(0xcfc0d31aL), tole(0xce02b92dL),
+tole(0x91af9640L), tole(0x906dfc77L), tole(0x922b422eL), tole(0x93e92819L),
+tole(0x96a63e9cL), tole(0x976454abL), tole(0x9522eaf2L), tole(0x94e080c5L),
+tole(0x9fbcc7f8L), tole(0x9e7eadcfL), tole(0x9c381396L), tole(0x9dfa79a1L),
+tole(0x98b56f24L), tole(0x99770513L), tole(0x9b31bb4aL), tole(0x9af3d17dL),
+tole(0x8d893530L), tole(0x8c4b5f07L), tole(0x8e0de15eL), tole(0x8fcf8b69L),
+tole(0x8a809decL), tole(0x8b42f7dbL), tole(0x89044982L), tole(0x88c623b5L),
+tole(0x839a6488L), tole(0x82580ebfL), tole(0x801eb0e6L), tole(0x81dcdad1L),
+tole(0x8493cc54L), tole(0x8551a663L), tole(0x8717183aL), tole(0x86d5720dL),
+tole(0xa9e2d0a0L), tole(0xa820ba97L), tole(0xaa6604ceL), tole(0xaba46ef9L),
+tole(0xaeeb787cL), tole(0xaf29124bL), tole(0xad6fac12L), tole(0xacadc625L),
+tole(0xa7f18118L), tole(0xa633eb2fL), tole(0xa4755576L), tole(0xa5b73f41L),
+tole(0xa0f829c4L), tole(0xa13a43f3L), tole(0xa37cfdaaL), tole(0xa2be979dL),
+tole(0xb5c473d0L), tole(0xb40619e7L), tole(0xb640a7beL), tole(0xb782cd89L),
+tole(0xb2cddb0cL), tole(0xb30fb13bL), tole(0xb1490f62L), tole(0xb08b6555L),
+tole(0xbbd72268L), tole(0xba15485fL), tole(0xb853f606L), tole(0xb9919c31L),
+tole(0xbcde8ab4L), tole(0xbd1ce083L), tole(0xbf5a5edaL), tole(0xbe9834edL)
+},
+{
+tole(0x00000000L), tole(0xb8bc6765L), tole(0xaa09c88bL), tole(0x12b5afeeL),
+tole(0x8f629757L), tole(0x37def032L), tole(0x256b5fdcL), tole(0x9dd738b9L),
+tole(0xc5b428efL), tole(0x7d084f8aL), tole(0x6fbde064L), tole(0xd7018701L),
+tole(0x4ad6bfb8L), tole(0xf26ad8ddL), tole(0xe0df7733L), tole(0x58631056L),
+tole(0x5019579fL), tole(0xe8a530faL), tole(0xfa109f14L), tole(0x42acf871L),
+tole(0xdf7bc0c8L), tole(0x67c7a7adL), tole(0x75720843L), tole(0xcdce6f26L),
+tole(0x95ad7f70L), tole(0x2d111815L), tole(0x3fa4b7fbL), tole(0x8718d09eL),
+tole(0x1acfe827L), tole(0xa2738f42L), tole(0xb0c620acL), tole(0x087a47c9L),
+tole(0xa032af3eL), tole(0x188ec85bL), tole(0x0a3b67b5L), tole(0xb28700d0L),
+tole(0x2f503869L), tole(0x97ec5f0cL), tole(0x8559f0e2L), tole(0x3de59787L),
+tole(0x658687d1L), tole(0xdd3ae0b4L), tole(0xcf8f4f5aL), tole(0x7733283fL),
+tole(0xeae41086L), tole(0x525877e3L), tole(0x40edd80dL), tole(0xf851bf68L),
+tole(0xf02bf8a1L), tole(0x48979fc4L), tole(0x5a22302aL), tole(0xe29e574fL),
+tole(0x7f496ff6L), tole(0xc7f50893L), tole(0xd540a77dL), tole(0x6dfcc018L),
+tole(0x359fd04eL), tole(0x8d23b72bL), tole(0x9f9618c5L), tole(0x272a7fa0L),
+tole(0xbafd4719L), tole(0x0241207cL), tole(0x10f48f92L), tole(0xa848e8f7L),
+tole(0x9b14583dL), tole(0x23a83f58L), tole(0x311d90b6L), tole(0x89a1f7d3L),
+tole(0x1476cf6aL), tole(0xaccaa80fL), tole(0xbe7f07e1L), tole(0x06c36084L),
+tole(0x5ea070d2L), tole(0xe61c17b7L), tole(0xf4a9b859L), tole(0x4c15df3cL),
+tole(0xd1c2e785L), tole(0x697e80e0L), tole(0x7bcb2f0eL), tole(0xc377486bL),
+tole(0xcb0d0fa2L), tole(0x73b168c7L), tole(0x6104c729L), tole(0xd9b8a04cL),
+tole(0x446f98f5L), tole(0xfcd3ff90L), tole(0xee66507eL), tole(0x56da371bL),
+tole(0x0eb9274dL), tole(0xb6054028L), tole(0xa4b0efc6L), tole(0x1c0c88a3L),
+tole(0x81dbb01aL), tole(0x3967d77fL), tole(0x2bd27891L), tole(0x936e1ff4L),
+tole(0x3b26f703L), tole(0x839a9066L), tole(0x912f3f88L), tole(0x299358edL),
+tole(0xb4446054L), tole(0x0cf80731L), tole(0x1e4da8dfL), tole(0xa6f1cfbaL),
+tole(0xfe92dfecL), tole(0x462eb889L), tole(0x549b1767L), tole(0xec277002L),
+tole(0x71f048bbL), tole(0xc94c2fdeL), tole(0xdbf98030L), tole(0x6345e755L),
+tole(0x6b3fa09cL), tole(0xd383c7f9L), tole(0xc1366817L), tole(0x798a0f72L),
+tole(0xe45d37cbL), tole(0x5ce150aeL), tole(0x4e54ff40L), tole(0xf6e89825L),
+tole(0xae8b8873L), tole(0x1637ef16L), tole(0x048240f8L), tole(0xbc3e279dL),
+tole(0x21e91f24L), tole(0x99557841L), tole(0x8be0d7afL), tole(0x335cb0caL),
+tole(0xed59b63bL), tole(0x55e5d15eL), tole(0x47507eb0L), tole(0xffec19d5L),
+tole(0x623b216cL), tole(0xda874609L), tole(0xc832e9e7L), tole(0x708e8e82L),
+tole(0x28ed9ed4L), tole(0x9051f9b1L), tole(0x82e4565fL), tole(0x3a58313aL),
+tole(0xa78f0983L), tole(0x1f336ee6L), tole(0x0d86c108L), tole(0xb53aa66dL),
+tole(0xbd40e1a4L), tole(0x05fc86c1L), tole(0x1749292fL), tole(0xaff54e4aL),
+tole(0x322276f3L), tole(0x8a9e1196L), tole(0x982bbe78L), tole(0x2097d91dL),
+tole(0x78f4c94bL), tole(0xc048ae2eL), tole(0xd2fd01c0L), tole(0x6a4166a5L),
+tole(0xf7965e1cL), tole(0x4f2a3979L), tole(0x5d9f9697L), tole(0xe523f1f2L),
+tole(0x4d6b1905L), tole(0xf5d77e60L), tole(0xe762d18eL), tole(0x5fdeb6ebL),
+tole(0xc2098e52L), tole(0x7ab5e937L), tole(0x680046d9L), tole(0xd0bc21bcL),
+tole(0x88df31eaL), tole(0x3063568fL), tole(0x22d6f961L), tole(0x9a6a9e04L),
+tole(0x07bda6bdL), tole(0xbf01c1d8L), tole(0xadb46e36L), tole(0x15080953L),
+tole(0x1d724e9aL), tole(0xa5ce29ffL), tole(0xb77b8611L), tole(0x0fc7e174L),
+tole(0x9210d9cdL), tole(0x2aacbea8L), tole(0x38191146L), tole(0x80a57623L),
+tole(0xd8c66675L), tole(0x607a0110L), tole(0x72cfaefeL), tole(0xca73c99bL),
+tole(0x57a4f122L), tole(0xef189647L), tole(0xfdad39a9L), tole(0x45115eccL),
+tole(0x764dee06L), tole(0xcef18963L), tole(0xdc44268dL), tole(0x64f841e8L),
+tole(0xf92f7951L), tole(0x41931e34L), tole(0x5326b1daL), tole(0xeb9ad6bfL),
+tole(0xb3f9c6e9L), tole(0x0b45a18cL), tole(0x19f00e62L), tole(0xa14c6907L),
+tole(0x3c9b51beL), tole(0x842736dbL), tole(0x96929935L), tole(0x2e2efe50L),
+tole(0x2654b999L), tole(0x9ee8defcL), tole(0x8c5d7112L), tole(0x34e11677L),
+tole(0xa9362eceL), tole(0x118a49abL), tole(0x033fe645L), tole(0xbb838120L),
+tole(0xe3e09176L), tole(0x5b5cf613L), tole(0x49e959fdL), tole(0xf1553e98L),
+tole(0x6c820621L), tole(0xd43e6144L), tole(0xc68bceaaL), tole(0x7e37a9cfL),
+tole(0xd67f4138L), tole(0x6ec3265dL), tole(0x7c7689b3L), tole(0xc4caeed6L),
+tole(0x591dd66fL), tole(0xe1a1b10aL), tole(0xf3141ee4L), tole(0x4ba87981L),
+tole(0x13cb69d7L), tole(0xab770eb2L), tole(0xb9c2a15cL), tole(0x017ec639L),
+tole(0x9ca9fe80L), tole(0x241599e5L), tole(0x36a0360bL), tole(0x8e1c516eL),
+tole(0x866616a7L), tole(0x3eda71c2L), tole(0x2c6fde2cL), tole(0x94d3b949L),
+tole(0x090481f0L), tole(0xb1b8e695L), tole(0xa30d497bL), tole(0x1bb12e1eL),
+tole(0x43d23e48L), tole(0xfb6e592dL), tole(0xe9dbf6c3L), tole(0x516791a6L),
+tole(0xccb0a91fL), tole(0x740cce7aL), tole(0x66b96194L), tole(0xde0506f1L)
+},
+{
+tole(0x00000000L), tole(0x3d6029b0L), tole(0x7ac05360L), tole(0x47a07ad0L),
+tole(0xf580a6c0L), tole(0xc8e08f70L), tole(0x8f40f5a0L), tole(0xb220dc10L),
+tole(0x30704bc1L), tole(0x0d106271L), tole(0x4ab018a1L), tole(0x77d03111L),
+tole(0xc5f0ed01L), tole(0xf890c4b1L), tole(0xbf30be61L), tole(0x825097d1L),
+tole(0x60e09782L), tole(0x5d80be32L), tole(0x1a20c4e2L), tole(0x2740ed52L),
+tole(0x95603142L), tole(0xa80018f2L), tole(0xefa06222L), tole(0xd2c04b92L),
+tole(0x5090dc43L), tole(0x6df0f5f3L), tole(0x2a508f23L), tole(0x1730a693L),
+tole(0xa5107a83L), tole(0x98705333L), tole(0xdfd029e3L), tole(0xe2b00053L),
+tole(0xc1c12f04L), tole(0xfca106b4L), tole(0xbb017c64L), tole(0x866155d4L),
+tole(0x344189c4L), tole(0x0921a074L), tole(0x4e81daa4L), tole(0x73e1f314L),
+tole(0xf1b164c5L), tole(0xccd14d75L), tole(0x8b7137a5L), tole(0xb6111e15L),
+tole(0x0431c205L), tole(0x3951ebb5L), tole(0x7ef19165L), tole(0x4391b8d5L),
+tole(0xa121b886L), tole(0x9c419136L), tole(0xdbe1ebe6L), tole(0xe681c256L),
+tole(0x54a11e46L), tole(0x69c137f6L), tole(0x2e614d26L), tole(0x13016496L),
+tole(0x9151f347L), tole(0xac31daf7L), tole(0xeb91a027L), tole(0xd6f18997L),
+tole(0x64d15587L), tole(0x59b17c37L), tole(0x1e1106e7L), tole(0x23712f57L),
+tole(0x58f35849L), tole(0x659371f9L), tole(0x22330b29L), tole(0x1f532299L),
+tole(0xad73fe89L), tole(0x9013d739L), tole(0xd7b3ade9L), tole(0xead38459L),
+tole(0x68831388L), tole(0x55e33a38L), tole(0x124340e8L), tole(0x2f236958L),
+tole(0x9d03b548L), tole(0xa0639cf8L), tole(0xe7c3e628L), tole(0xdaa3cf98L),
+tole(0x3813cfcbL), tole(0x0573e67bL), tole(0x42d39cabL), tole(0x7fb3b51bL),
+tole(0xcd93690bL), tole(0xf0f340bbL), tole(0xb7533a6bL), tole(0x8a3313dbL),
+tole(0x0863840aL), tole(0x3503adbaL), tole(0x72a3d76aL), tole(0x4fc3fedaL),
+tole(0xfde322caL), tole(0xc0830b7aL), tole(0x872371aaL), tole(0xba43581aL),
+tole(0x9932774dL), tole(0xa4525efdL), tole(0xe3f2242dL), tole(0xde920d9dL),
+tole(0x6cb2d18dL), tole(0x51d2f83dL), tole(0x167282edL), tole(0x2b12ab5dL),
+tole(0xa9423c8cL), tole(0x9422153cL), tole(0xd3826fecL), tole(0xeee2465cL),
+tole(0x5cc29a4cL), tole(0x61a2b3fcL), tole(0x2602c92cL), tole(0x1b62e09cL),
+tole(0xf9d2e0cfL), tole(0xc4b2c97fL), tole(0x8312b3afL), tole(0xbe729a1fL),
+tole(0x0c52460fL), tole(0x31326fbfL), tole(0x7692156fL), tole(0x4bf23cdfL),
+tole(0xc9a2ab0eL), tole(0xf4c282beL), tole(0xb362f86eL), tole(0x8e02d1deL),
+tole(0x3c220dceL), tole(0x0142247eL), tole(0x46e25eaeL), tole(0x7b82771eL),
+tole(0xb1e6b092L), tole(0x8c869922L), tole(0xcb26e3f2L), tole(0xf646ca42L),
+tole(0x44661652L), tole(0x79063fe2L), tole(0x3ea64532L), tole(0x03c66c82L),
+tole(0x8196fb53L), tole(0xbcf6d2e3L), tole(0xfb56a833L), tole(0xc6368183L),
+tole(0x74165d93L), tole(0x49767423L), tole(0x0ed60ef3L), tole(0x33b62743L),
+tole(0xd1062710L), tole(0xec660ea0L), tole(0xabc67470L), tole(0x96a65dc0L),
+tole(0x248681d0L), tole(0x19e6a860L), tole(0x5e46d2b0L), tole(0x6326fb00L),
+tole(0xe1766cd1L), tole(0xdc164561L), tole(0x9bb63fb1L), tole(0xa6d61601L),
+tole(0x14f6ca11L), tole(0x2996e3a1L), tole(0x6e369971L), tole(0x5356b0c1L),
+tole(0x70279f96L), tole(0x4d47b626L), tole(0x0ae7ccf6L), tole(0x3787e546L),
+tole(0x85a73956L), tole(0xb8c710e6L), tole(0xff676a36L), tole(0xc2074386L),
+tole(0x4057d457L), tole(0x7d37fde7L), tole(0x3a978737L), tole(0x07f7ae87L),
+tole(0xb5d77297L), tole(0x88b75b27L), tole(0xcf1721f7L), tole(0xf2770847L),
+tole(0x10c70814L), tole(0x2da721a4L), tole(0x6a075b74L), tole(0x576772c4L),
+tole(0xe547aed4L), tole(0xd8278764L), tole(0x9f87fdb4L), tole(0xa2e7d404L),
+tole(0x20b743d5L), tole(0x1dd76a65L), tole(0x5a7710b5L), tole(0x67173905L),
+tole(0xd537e515L), tole(0xe857cca5L), tole(0xaff7b675L), tole(0x92979fc5L),
+tole(0xe915e8dbL), tole(0xd475c16bL), tole(0x93d5bbbbL), tole(0xaeb5920bL),
+tole(0x1c954e1bL), tole(0x21f567abL), tole(0x66551d7bL), tole(0x5b3534cbL),
+tole(0xd965a31aL), tole(0xe4058aaaL), tole(0xa3a5f07aL), tole(0x9ec5d9caL),
+tole(0x2ce505daL), tole(0x11852c6aL), tole(0x562556baL), tole(0x6b457f0aL),
+tole(0x89f57f59L), tole(0xb49556e9L), tole(0xf3352c39L), tole(0xce550589L),
+tole(0x7c75d999L), tole(0x4115f029L), tole(0x06b58af9L), tole(0x3bd5a349L),
+tole(0xb9853498L), tole(0x84e51d28L), tole(0xc34567f8L), tole(0xfe254e48L),
+tole(0x4c059258L), tole(0x7165bbe8L), tole(0x36c5c138L), tole(0x0ba5e888L),
+tole(0x28d4c7dfL), tole(0x15b4ee6fL), tole(0x521494bfL), tole(0x6f74bd0fL),
+tole(0xdd54611fL), tole(0xe03448afL), tole(0xa794327fL), tole(0x9af41bcfL),
+tole(0x18a48c1eL), tole(0x25c4a5aeL), tole(0x6264df7eL), tole(0x5f04f6ceL),
+tole(0xed242adeL), tole(0xd044036eL), tole(0x97e479beL), tole(0xaa84500eL),
+tole(0x4834505dL), tole(0x755479edL), tole(0x32f4033dL), tole(0x0f942a8dL),
+tole(0xbdb4f69dL), tole(0x80d4df2dL), tole(0xc774a5fdL), tole(0xfa148c4dL),
+tole(0x78441b9cL), tole(0x4524322cL), tole(0x028448fcL), tole(0x3fe4614cL),
+tole(0x8dc4bd5cL), tole(0xb0a494ecL), tole(0xf704ee3cL), tole(0xca64c78cL)
+},
+{
+tole(0x00000000L), tole(0xcb5cd3a5L), tole(0x4dc8a10bL), tole(0x869472aeL),
+tole(0x9b914216L), tole(0x50cd91b3L), tole(0xd659e31dL), tole(0x1d0530b8L),
+tole(0xec53826dL), tole(0x270f51c8L), tole(0xa19b2366L), tole(0x6ac7f0c3L),
+tole(0x77c2c07bL), tole(0xbc9e13deL), tole(0x3a0a6170L), tole(0xf156b2d5L),
+tole(0x03d6029bL), tole(0xc88ad13eL), tole(0x4e1ea390L), tole(0x85427035L),
+tole(0x9847408dL), tole(0x531b9328L), tole(0xd58fe186L), tole(0x1ed33223L),
+tole(0xef8580f6L), tole(0x24d95353L), tole(0xa24d21fdL), tole(0x6911f258L),
+tole(0x7414c2e0L), tole(0xbf481145L), tole(0x39dc63ebL), tole(0xf280b04eL),
+tole(0x07ac0536L), tole(0xccf0d693L), tole(0x4a64a43dL), tole(0x81387798L),
+tole(0x9c3d4720L), tole(0x57619485L), tole(0xd1f5e62bL), tole(0x1aa9358eL),
+tole(0xebff875bL), tole(0x20a354feL), tole(0xa6372650L), tole(0x6d6bf5f5L),
+tole(0x706ec54dL), tole(0xbb3216e8L), tole(0x3da66446L), tole(0xf6fab7e3L),
+tole(0x047a07adL), tole(0xcf26d408L), tole(0x49b2a6a6L), tole(0x82ee7503L),
+tole(0x9feb45bbL), tole(0x54b7961eL), tole(0xd223e4b0L), tole(0x197f3715L),
+tole(0xe82985c0L), tole(0x23755665L), tole(0xa5e124cbL), tole(0x6ebdf76eL),
+tole(0x73b8c7d6L), tole(0xb8e41473L), tole(0x3e7066ddL), tole(0xf52cb578L),
+tole(0x0f580a6cL), tole(0xc404d9c9L), tole(0x4290ab67L), tole(0x89cc78c2L),
+tole(0x94c9487aL), tole(0x5f959bdfL), tole(0xd901e971L), tole(0x125d3ad4L),
+tole(0xe30b8801L), tole(0x28575ba4L), tole(0xaec3290aL), tole(0x659ffaafL),
+tole(0x789aca17L), tole(0xb3c619b2L), tole(0x35526b1cL), tole(0xfe0eb8b9L),
+tole(0x0c8e08f7L), tole(0xc7d2db52L), tole(0x4146a9fcL), tole(0x8a1a7a59L),
+tole(0x971f4ae1L), tole(0x5c439944L), tole(0xdad7ebeaL), tole(0x118b384fL),
+tole(0xe0dd8a9aL), tole(0x2b81593fL), tole(0xad152b91L), tole(0x6649f834L),
+tole(0x7b4cc88cL), tole(0xb0101b29L), tole(0x36846987L), tole(0xfdd8ba22L),
+tole(0x08f40f5aL), tole(0xc3a8dcffL), tole(0x453cae51L), tole(0x8e607df4L),
+tole(0x93654d4cL), tole(0x58399ee9L), tole(0xdeadec47L), tole(0x15f13fe2L),
+tole(0xe4a78d37L), tole(0x2ffb5e92L), tole(0xa96f2c3cL), tole(0x6233ff99L),
+tole(0x7f36cf21L), tole(0xb46a1c84L), tole(0x32fe6e2aL), tole(0xf9a2bd8fL),
+tole(0x0b220dc1L), tole(0xc07ede64L), tole(0x46eaaccaL), tole(0x8db67f6fL),
+tole(0x90b34fd7L), tole(0x5bef9c72L), tole(0xdd7beedcL), tole(0x16273d79L),
+tole(0xe7718facL), tole(0x2c2d5c09L), tole(0xaab92ea7L), tole(0x61e5fd02L),
+tole(0x7ce0cdbaL), tole(0xb7bc1e1fL), tole(0x31286cb1L), tole(0xfa74bf14L),
+tole(0x1eb014d8L), tole(0xd5ecc77dL), tole(0x5378b5d3L), tole(0x98246676L),
+tole(0x852156ceL), tole(0x4e7d856bL), tole(0xc8e9f7c5L), tole(0x03b52460L),
+tole(0xf2e396b5L), tole(0x39bf4510L), tole(0xbf2b37beL), tole(0x7477e41bL),
+tole(0x6972d4a3L), tole(0xa22e0706L), tole(0x24ba75a8L), tole(0xefe6a60dL),
+tole(0x1d661643L), tole(0xd63ac5e6L), tole(0x50aeb748L), tole(0x9bf264edL),
+tole(0x86f75455L), tole(0x4dab87f0L), tole(0xcb3ff55eL), tole(0x006326fbL),
+tole(0xf135942eL), tole(0x3a69478bL), tole(0xbcfd3525L), tole(0x77a1e680L),
+tole(0x6aa4d638L), tole(0xa1f8059dL), tole(0x276c7733L), tole(0xec30a496L),
+tole(0x191c11eeL), tole(0xd240c24bL), tole(0x54d4b0e5L), tole(0x9f886340L),
+tole(0x828d53f8L), tole(0x49d1805dL), tole(0xcf45f2f3L), tole(0x04192156L),
+tole(0xf54f9383L), tole(0x3e134026L), tole(0xb8873288L), tole(0x73dbe12dL),
+tole(0x6eded195L), tole(0xa5820230L), tole(0x2316709eL), tole(0xe84aa33bL),
+tole(0x1aca1375L), tole(0xd196c0d0L), tole(0x5702b27eL), tole(0x9c5e61dbL),
+tole(0x815b5163L), tole(0x4a0782c6L), tole(0xcc93f068L), tole(0x07cf23cdL),
+tole(0xf6999118L), tole(0x3dc542bdL), tole(0xbb513013L), tole(0x700de3b6L),
+tole(0x6d08d30eL), tole(0xa65400abL), tole(0x20c07205L), tole(0xeb9ca1a0L),
+tole(0x11e81eb4L), tole(0xdab4cd11L), tole(0x5c20bfbfL), tole(0x977c6c1aL),
+tole(0x8a795ca2L), tole(0x41258f07L), tole(0xc7b1fda9L), tole(0x0ced2e0cL),
+tole(0xfdbb9cd9L), tole(0x36e74f7cL), tole(0xb0733dd2L), tole(0x7b2fee77L),
+tole(0x662adecfL), tole(0xad760d6aL), tole(0x2be27fc4L), tole(0xe0beac61L),
+tole(0x123e1c2fL), tole(0xd962cf8aL), tole(0x5ff6bd24L), tole(0x94aa6e81L),
+tole(0x89af5e39L), tole(0x42f38d9cL), tole(0xc467ff32L), tole(0x0f3b2c97L),
+tole(0xfe6d9e42L), tole(0x35314de7L), tole(0xb3a53f49L), tole(0x78f9ececL),
+tole(0x65fcdc54L), tole(0xaea00ff1L), tole(0x28347d5fL), tole(0xe368aefaL),
+tole(0x16441b82L), tole(0xdd18c827L), tole(0x5b8cba89L), tole(0x90d0692cL),
+tole(0x8dd55994L), tole(0x46898a31L), tole(0xc01df89fL), tole(0x0b412b3aL),
+tole(0xfa1799efL), tole(0x314b4a4aL), tole(0xb7df38e4L), tole(0x7c83eb41L),
+tole(0x6186dbf9L), tole(0xaada085cL), tole(0x2c4e7af2L), tole(0xe712a957L),
+tole(0x15921919L), tole(0xdececabcL), tole(0x585ab812L), tole(0x93066bb7L),
+tole(0x8e035b0fL), tole(0x455f88aaL), tole(0xc3cbfa04L), tole(0x089729a1L),
+tole(0xf9c19b74L), tole(0x329d48d1L), tole(0xb4093a7fL), tole(0x7f55e9daL),
+tole(0x6250d962L), tole(0xa90c0ac7L), tole(0x2f987869L), tole(0xe4c4abccL)
+},
+{
+tole(0x00000000L), tole(0xa6770bb4L), tole(0x979f1129L), tole(0x31e81a9dL),
+tole(0xf44f2413L), tole(0x52382fa7L), tole(0x63d0353aL), tole(0xc5a73e8eL),
+tole(0x33ef4e67L), tole(0x959845d3L), tole(0xa4705f4eL), tole(0x020754faL),
+tole(0xc7a06a74L), tole(0x61d761c0L), tole(0x503f7b5dL), tole(0xf64870e9L),
+tole(0x67de9cceL), tole(0xc1a9977aL), tole(0xf0418de7L), tole(0x56368653L),
+tole(0x9391b8ddL), tole(0x35e6b369L), tole(0x040ea9f4L), tole(0xa279a240L),
+tole(0x5431d2a9L), tole(0xf246d91dL), tole(0xc3aec380L), tole(0x65d9c834L),
+tole(0xa07ef6baL), tole(0x0609fd0eL), tole(0x37e1e793L), tole(0x9196ec27L),
+tole(0xcfbd399cL), tole(0x69ca3228L), tole(0x582228b5L), tole(0xfe552301L),
+tole(0x3bf21d8fL), tole(0x9d85163bL), tole(0xac6d0ca6L), tole(0x0a1a0712L),
+tole(0xfc5277fbL), tole(0x5a257c4fL), tole(0x6bcd66d2L), tole(0xcdba6d66L),
+tole(0x081d53e8L), tole(0xae6a585cL), tole(0x9f8242c1L), tole(0x39f54975L),
+tole(0xa863a552L), tole(0x0e14aee6L), tole(0x3ffcb47bL), tole(0x998bbfcfL),
+tole(0x5c2c8141L), tole(0xfa5b8af5L), tole(0xcbb39068L), tole(0x6dc49bdcL),
+tole(0x9b8ceb35L), tole(0x3dfbe081L), tole(0x0c13fa1cL), tole(0xaa64f1a8L),
+tole(0x6fc3cf26L), tole(0xc9b4c492L), tole(0xf85cde0fL), tole(0x5e2bd5bbL),
+tole(0x440b7579L), tole(0xe27c7ecdL), tole(0xd3946450L), tole(0x75e36fe4L),
+tole(0xb044516aL), tole(0x16335adeL), tole(0x27db4043L), tole(0x81ac4bf7L),
+tole(0x77e43b1eL), tole(0xd19330aaL), tole(0xe07b2a37L), tole(0x460c2183L),
+tole(0x83ab1f0dL), tole(0x25dc14b9L), tole(0x14340e24L), tole(0xb2430590L),
+tole(0x23d5e9b7L), tole(0x85a2e203L), tole(0xb44af89eL), tole(0x123df32aL),
+tole(0xd79acda4L), tole(0x71edc610L), tole(0x4005dc8dL), tole(0xe672d739L),
+tole(0x103aa7d0L), tole(0xb64dac64L), tole(0x87a5b6f9L), tole(0x21d2bd4dL),
+tole(0xe47583c3L), tole(0x42028877L), tole(0x73ea92eaL), tole(0xd59d995eL),
+tole(0x8bb64ce5L), tole(0x2dc14751L), tole(0x1c295dccL), tole(0xba5e5678L),
+tole(0x7ff968f6L), tole(0xd98e6342L), tole(0xe86679dfL), tole(0x4e11726bL),
+tole(0xb8590282L), tole(0x1e2e0936L), tole(0x2fc613abL), tole(0x89b1181fL),
+tole(0x4c162691L), tole(0xea612d25L), tole(0xdb8937b8L), tole(0x7dfe3c0cL),
+tole(0xec68d02bL), tole(0x4a1fdb9fL), tole(0x7bf7c102L), tole(0xdd80cab6L),
+tole(0x1827f438L), tole(0xbe50ff8cL), tole(0x8fb8e511L), tole(0x29cfeea5L),
+tole(0xdf879e4cL), tole(0x79f095f8L), tole(0x48188f65L), tole(0xee6f84d1L),
+tole(0x2bc8ba5fL), tole(0x8dbfb1ebL), tole(0xbc57ab76L), tole(0x1a20a0c2L),
+tole(0x8816eaf2L), tole(0x2e61e146L), tole(0x1f89fbdbL), tole(0xb9fef06fL),
+tole(0x7c59cee1L), tole(0xda2ec555L), tole(0xebc6dfc8L), tole(0x4db1d47cL),
+tole(0xbbf9a495L), tole(0x1d8eaf21L), tole(0x2c66b5bcL), tole(0x8a11be08L),
+tole(0x4fb68086L), tole(0xe9c18b32L), tole(0xd82991afL), tole(0x7e5e9a1bL),
+tole(0xefc8763cL), tole(0x49bf7d88L), tole(0x78576715L), tole(0xde206ca1L),
+tole(0x1b87522fL), tole(0xbdf0599bL), tole(0x8c184306L), tole(0x2a6f48b2L),
+tole(0xdc27385bL), tole(0x7a5033efL), tole(0x4bb82972L), tole(0xedcf22c6L),
+tole(0x28681c48L), tole(0x8e1f17fcL), tole(0xbff70d61L), tole(0x198006d5L),
+tole(0x47abd36eL), tole(0xe1dcd8daL), tole(0xd034c247L), tole(0x7643c9f3L),
+tole(0xb3e4f77dL), tole(0x1593fcc9L), tole(0x247be654L), tole(0x820cede0L),
+tole(0x74449d09L), tole(0xd23396bdL), tole(0xe3db8c20L), tole(0x45ac8794L),
+tole(0x800bb91aL), tole(0x267cb2aeL), tole(0x1794a833L), tole(0xb1e3a387L),
+tole(0x20754fa0L), tole(0x86024414L), tole(0xb7ea5e89L), tole(0x119d553dL),
+tole(0xd43a6bb3L), tole(0x724d6007L), tole(0x43a57a9aL), tole(0xe5d2712eL),
+tole(0x139a01c7L), tole(0xb5ed0a73L), tole(0x840510eeL), tole(0x22721b5aL),
+tole(0xe7d525d4L), tole(0x41a22e60L), tole(0x704a34fdL), tole(0xd63d3f49L),
+tole(0xcc1d9f8bL), tole(0x6a6a943fL), tole(0x5b828ea2L), tole(0xfdf58516L),
+tole(0x3852bb98L), tole(0x9e25b02cL), tole(0xafcdaab1L), tole(0x09baa105L),
+tole(0xfff2d1ecL), tole(0x5985da58L), tole(0x686dc0c5L), tole(0xce1acb71L),
+tole(0x0bbdf5ffL), tole(0xadcafe4bL), tole(0x9c22e4d6L), tole(0x3a55ef62L),
+tole(0xabc30345L), tole(0x0db408f1L), tole(0x3c5c126cL), tole(0x9a2b19d8L),
+tole(0x5f8c2756L), tole(0xf9fb2ce2L), tole(0xc813367fL), tole(0x6e643dcbL),
+tole(0x982c4d22L), tole(0x3e5b4696L), tole(0x0fb35c0bL), tole(0xa9c457bfL),
+tole(0x6c636931L), tole(0xca146285L), tole(0xfbfc7818L), tole(0x5d8b73acL),
+tole(0x03a0a617L), tole(0xa5d7ada3L), tole(0x943fb73eL), tole(0x3248bc8aL),
+tole(0xf7ef8204L), tole(0x519889b0L), tole(0x6070932dL), tole(0xc6079899L),
+tole(0x304fe870L), tole(0x9638e3c4L), tole(0xa7d0f959L), tole(0x01a7f2edL),
+tole(0xc400cc63L), tole(0x6277c7d7L), tole(0x539fdd4aL), tole(0xf5e8d6feL),
+tole(0x647e3ad9L), tole(0xc209316dL), tole(0xf3e12bf0L), tole(0x55962044L),
+tole(0x90311ecaL), tole(0x3646157eL), tole(0x07ae0fe3L), tole(0xa1d90457L),
+tole(0x579174beL), tole(0xf1e67f0aL), tole(0xc00e6597L), tole(0x66796e23L),
+tole(0xa3de50adL), tole(0x05a95b19L), tole(0x34414184L), tole(0x92364a30L)
+},
+{
+tole(0x00000000L), tole(0xccaa009eL), tole(0x4225077dL), tole(0x8e8f07e3L),
+tole(0x844a0efaL), tole(0x48e00e64L), tole(0xc66f0987L), tole(0x0ac50919L),
+tole(0xd3e51bb5L), tole(0x1f4f1b2bL), tole(0x91c01cc8L), tole(0x5d6a1c56L),
+tole(0x57af154fL), tole(0x9b0515d1L), tole(0x158a1232L), tole(0xd92012acL),
+tole(0x7cbb312bL), tole(0xb01131b5L), tole(0x3e9e3656L), tole(0xf23436c8L),
+tole(0xf8f13fd1L), tole(0x345b3f4fL), tole(0xbad438acL), tole(0x767e3832L),
+tole(0xaf5e2a9eL), tole(0x63f42a00L), tole(0xed7b2de3L), tole(0x21d12d7dL),
+tole(0x2b142464L), tole(0xe7be24faL), tole(0x69312319L), tole(0xa59b2387L),
+tole(0xf9766256L), tole(0x35dc62c8L), tole(0xbb53652bL), tole(0x77f965b5L),
+tole(0x7d3c6cacL), tole(0xb1966c32L), tole(0x3f196bd1L), tole(0xf3b36b4fL),
+tole(0x2a9379e3L), tole(0xe639797dL), tole(0x68b67e9eL), tole(0xa41c7e00L),
+tole(0xaed97719L), tole(0x62737787L), tole(0xecfc7064L), tole(0x205670faL),
+tole(0x85cd537dL), tole(0x496753e3L), tole(0xc7e85400L), tole(0x0b42549eL),
+tole(0x01875d87L), tole(0xcd2d5d19L), tole(0x43a25afaL), tole(0x8f085a64L),
+tole(0x562848c8L), tole(0x9a824856L), tole(0x140d4fb5L), tole(0xd8a74f2bL),
+tole(0xd2624632L), tole(0x1ec846acL), tole(0x9047414fL), tole(0x5ced41d1L),
+tole(0x299dc2edL), tole(0xe537c273L), tole(0x6bb8c590L), tole(0xa712c50eL),
+tole(0xadd7cc17L), tole(0x617dcc89L), tole(0xeff2cb6aL), tole(0x2358cbf4L),
+tole(0xfa78d958L), tole(0x36d2d9c6L), tole(0xb85dde25L), tole(0x74f7debbL),
+tole(0x7e32d7a2L), tole(0xb298d73cL), tole(0x3c17d0dfL), tole(0xf0bdd041L),
+tole(0x5526f3c6L), tole(0x998cf358L), tole(0x1703f4bbL), tole(0xdba9f425L),
+tole(0xd16cfd3cL), tole(0x1dc6fda2L), tole(0x9349fa41L), tole(0x5fe3fadfL),
+tole(0x86c3e873L), tole(0x4a69e8edL), tole(0xc4e6ef0eL), tole(0x084cef90L),
+tole(0x0289e689L), tole(0xce23e617L), tole(0x40ace1f4L), tole(0x8c06e16aL),
+tole(0xd0eba0bbL), tole(0x1c41a025L), tole(0x92cea7c6L), tole(0x5e64a758L),
+tole(0x54a1ae41L), tole(0x980baedfL), tole(0x1684a93cL), tole(0xda2ea9a2L),
+tole(0x030ebb0eL), tole(0xcfa4bb90L), tole(0x412bbc73L), tole(0x8d81bcedL),
+tole(0x8744b5f4L), tole(0x4beeb56aL), tole(0xc561b289L), tole(0x09cbb217L),
+tole(0xac509190L), tole(0x60fa910eL), tole(0xee7596edL), tole(0x22df9673L),
+tole(0x281a9f6aL), tole(0xe4b09ff4L), tole(0x6a3f9817L), tole(0xa6959889L),
+tole(0x7fb58a25L), tole(0xb31f8abbL), tole(0x3d908d58L), tole(0xf13a8dc6L),
+tole(0xfbff84dfL), tole(0x37558441L), tole(0xb9da83a2L), tole(0x7570833cL),
+tole(0x533b85daL), tole(0x9f918544L), tole(0x111e82a7L), tole(0xddb48239L),
+tole(0xd7718b20L), tole(0x1bdb8bbeL), tole(0x95548c5dL), tole(0x59fe8cc3L),
+tole(0x80de9e6fL), tole(0x4c749ef1L), tole(0xc2fb9912L), tole(0x0e51998cL),
+tole(0x04949095L), tole(0xc83e900bL), tole(0x46b197e8L), tole(0x8a1b9776L),
+tole(0x2f80b4f1L), tole(0xe32ab46fL), tole(0x6da5b38cL), tole(0xa10fb312L),
+tole(0xabcaba0bL), tole(0x6760ba95L), tole(0xe9efbd76L), tole(0x2545bde8L),
+tole(0xfc65af44L), tole(0x30cfafdaL), tole(0xbe40a839L), tole(0x72eaa8a7L),
+tole(0x782fa1beL), tole(0xb485a120L), tole(0x3a0aa6c3L), tole(0xf6a0a65dL),
+tole(0xaa4de78cL), tole(0x66e7e712L), tole(0xe868e0f1L), tole(0x24c2e06fL),
+tole(0x2e07e976L), tole(0xe2ade9e8L), tole(0x6c22ee0bL), tole(0xa088ee95L),
+tole(0x79a8fc39L), tole(0xb502fca7L), tole(0x3b8dfb44L), tole(0xf727fbdaL),
+tole(0xfde2f2c3L), tole(0x3148f25dL), tole(0xbfc7f5beL), tole(0x736df520L),
+tole(0xd6f6d6a7L), tole(0x1a5cd639L), tole(0x94d3d1daL), tole(0x5879d144L),
+tole(0x52bcd85dL), tole(0x9e16d8c3L), tole(0x1099df20L), tole(0xdc33dfbeL),
+tole(0x0513cd12L), tole(0xc9b9cd8cL), tole(0x4736ca6fL), tole(0x8b9ccaf1L),
+tole(0x8159c3e8L), tole(0x4df3c376L), tole(0xc37cc495L), tole(0x0fd6c40bL),
+tole(0x7aa64737L), tole(0xb60c47a9L), tole(0x3883404aL), tole(0xf42940d4L),
+tole(0xfeec49cdL), tole(0x32464953L), tole(0xbcc94eb0L), tole(0x70634e2eL),
+tole(0xa9435c82L), tole(0x65e95c1cL), tole(0xeb665bffL), tole(0x27cc5b61L),
+tole(0x2d095278L), tole(0xe1a352e6L), tole(0x6f2c5505L), tole(0xa386559bL),
+tole(0x061d761cL), tole(0xcab77682L), tole(0x44387161L), tole(0x889271ffL),
+tole(0x825778e6L), tole(0x4efd7878L), tole(0xc0727f9bL), tole(0x0cd87f05L),
+tole(0xd5f86da9L), tole(0x19526d37L), tole(0x97dd6ad4L), tole(0x5b776a4aL),
+tole(0x51b26353L), tole(0x9d1863cdL), tole(0x1397642eL), tole(0xdf3d64b0L),
+tole(0x83d02561L), tole(0x4f7a25ffL), tole(0xc1f5221cL), tole(0x0d5f2282L),
+tole(0x079a2b9bL), tole(0xcb302b05L), tole(0x45bf2ce6L), tole(0x89152c78L),
+tole(0x50353ed4L), tole(0x9c9f3e4aL), tole(0x121039a9L), tole(0xdeba3937L),
+tole(0xd47f302eL), tole(0x18d530b0L), tole(0x965a3753L), tole(0x5af037cdL),
+tole(0xff6b144aL), tole(0x33c114d4L), tole(0xbd4e1337L), tole(0x71e413a9L),
+tole(0x7b211ab0L), tole(0xb78b1a2eL), tole(0x39041dcdL), tole(0xf5ae1d53L),
+tole(0x2c8e0fffL), tole(0xe0240f61L), tole(0x6eab0882L), tole(0xa201081cL),
+tole(0xa8c40105L), tole(0x646e019bL), tole(0xeae10678L), tole(0x264b06e6L)
+},
+#if CRC32_SLICES > 8
+{
+tole(0x00000000L), tole(0x177b1443L), tole(0x2ef62886L), tole(0x398d3cc5L),
+tole(0x5dec510cL), tole(0x4a97454fL), tole(0x731a798aL), tole(0x64616dc9L),
+tole(0xbbd8a218L), tole(0xaca3b65bL), tole(0x952e8a9eL), tole(0x82559eddL),
+tole(0xe634f314L), tole(0xf14fe757L), tole(0xc8c2db92L), tole(0xdfb9cfd1L),
+tole(0xacc04271L), tole(0xbbbb5632L), tole(0x82366af7L), tole(0x954d7eb4L),
+tole(0xf12c137dL), tole(0xe657073eL), tole(0xdfda3bfbL), tole(0xc8a12fb8L),
+tole(0x1718e069L), tole(0x0063f42aL), tole(0x39eec8efL), tole(0x2e95dcacL),
+tole(0x4af4b165L), tole(0x5d8fa526L), tole(0x640299e3L), tole(0x73798da0L),
+tole(0x82f182a3L), tole(0x958a96e0L), tole(0xac07aa25L), tole(0xbb7cbe66L),
+tole(0xdf1dd3afL), tole(0xc866c7ecL), tole(0xf1ebfb29L), tole(0xe690ef6aL),
+tole(0x392920bbL), tole(0x2e5234f8L), tole(0x17df083dL), tole(0x00a41c7eL),
+tole(0x64c571b7L), tole(0x73be65f4L), tole(0x4a335931L), tole(0x5d484d72L),
+tole(0x2e31c0d2L), tole(0x394ad491L), tole(0x00c7e854L), tole(0x17bcfc17L),
+tole(0x73dd91deL), tole(0x64a6859dL), tole(0x5d2bb958L), tole(0x4a50ad1bL),
+tole(0x95e962caL), tole(0x82927689L), tole(0xbb1f4a4cL), tole(0xac645e0fL),
+tole(0xc80533c6L), tole(0xdf7e2785L), tole(0xe6f31b40L), tole(0xf1880f03L),
+tole(0xde920307L), tole(0xc9e91744L), tole(0xf0642b81L), tole(0xe71f3fc2L),
+tole(0x837e520bL), tole(0x94054648L), tole(0xad887a8dL), tole(0xbaf36eceL),
+tole(0x654aa11fL), tole(0x7231b55cL), tole(0x4bbc8999L), tole(0x5cc79ddaL),
+tole(0x38a6f013L), tole(0x2fdde450L), tole(0x1650d895L), tole(0x012bccd6L),
+tole(0x72524176L), tole(0x65295535L), tole(0x5ca469f0L), tole(0x4bdf7db3L),
+tole(0x2fbe107aL), tole(0x38c50439L), tole(0x014838fcL), tole(0x16332cbfL),
+tole(0xc98ae36eL), tole(0xdef1f72dL), tole(0xe77ccbe8L), tole(0xf007dfabL),
+tole(0x9466b262L), tole(0x831da621L), tole(0xba909ae4L), tole(0xadeb8ea7L),
+tole(0x5c6381a4L), tole(0x4b1895e7L), tole(0x7295a922L), tole(0x65eebd61L),
+tole(0x018fd0a8L), tole(0x16f4c4ebL), tole(0x2f79f82eL), tole(0x3802ec6dL),
+tole(0xe7bb23bcL), tole(0xf0c037ffL), tole(0xc94d0b3aL), tole(0xde361f79L),
+tole(0xba5772b0L), tole(0xad2c66f3L), tole(0x94a15a36L), tole(0x83da4e75L),
+tole(0xf0a3c3d5L), tole(0xe7d8d796L), tole(0xde55eb53L), tole(0xc92eff10L),
+tole(0xad4f92d9L), tole(0xba34869aL), tole(0x83b9ba5fL), tole(0x94c2ae1cL),
+tole(0x4b7b61cdL), tole(0x5c00758eL), tole(0x658d494bL), tole(0x72f65d08L),
+tole(0x169730c1L), tole(0x01ec2482L), tole(0x38611847L), tole(0x2f1a0c04L),
+tole(0x6655004fL), tole(0x712e140cL), tole(0x48a328c9L), tole(0x5fd83c8aL),
+tole(0x3bb95143L), tole(0x2cc24500L), tole(0x154f79c5L), tole(0x02346d86L),
+tole(0xdd8da257L), tole(0xcaf6b614L), tole(0xf37b8ad1L), tole(0xe4009e92L),
+tole(0x8061f35bL), tole(0x971ae718L), tole(0xae97dbddL), tole(0xb9eccf9eL),
+tole(0xca95423eL), tole(0xddee567dL), tole(0xe4636ab8L), tole(0xf3187efbL),
+tole(0x97791332L), tole(0x80020771L), tole(0xb98f3bb4L), tole(0xaef42ff7L),
+tole(0x714de026L), tole(0x6636f465L), tole(0x5fbbc8a0L), tole(0x48c0dce3L),
+tole(0x2ca1b12aL), tole(0x3bdaa569L), tole(0x025799acL), tole(0x152c8defL),
+tole(0xe4a482ecL), tole(0xf3df96afL), tole(0xca52aa6aL), tole(0xdd29be29L),
+tole(0xb948d3e0L), tole(0xae33c7a3L), tole(0x97befb66L), tole(0x80c5ef25L),
+tole(0x5f7c20f4L), tole(0x480734b7L), tole(0x718a0872L), tole(0x66f11c31L),
+tole(0x029071f8L), tole(0x15eb65bbL), tole(0x2c66597eL), tole(0x3b1d4d3dL),
+tole(0x4864c09dL), tole(0x5f1fd4deL), tole(0x6692e81bL), tole(0x71e9fc58L),
+tole(0x15889191L), tole(0x02f385d2L), tole(0x3b7eb917L), tole(0x2c05ad54L),
+tole(0xf3bc6285L), tole(0xe4c776c6L), tole(0xdd4a4a03L), tole(0xca315e40L),
+tole(0xae503389L), tole(0xb92b27caL), tole(0x80a61b0fL), tole(0x97dd0f4cL),
+tole(0xb8c70348L), tole(0xafbc170bL), tole(0x96312bceL), tole(0x814a3f8dL),
+tole(0xe52b5244L), tole(0xf2504607L), tole(0xcbdd7ac2L), tole(0xdca66e81L),
+tole(0x031fa150L), tole(0x1464b513L), tole(0x2de989d6L), tole(0x3a929d95L),
+tole(0x5ef3f05cL), tole(0x4988e41fL), tole(0x7005d8daL), tole(0x677ecc99L),
+tole(0x14074139L), tole(0x037c557aL), tole(0x3af169bfL), tole(0x2d8a7dfcL),
+tole(0x49eb1035L), tole(0x5e900476L), tole(0x671d38b3L), tole(0x70662cf0L),
+tole(0xafdfe321L), tole(0xb8a4f762L), tole(0x8129cba7L), tole(0x9652dfe4L),
+tole(0xf233b22dL), tole(0xe548a66eL), tole(0xdcc59aabL), tole(0xcbbe8ee8L),
+tole(0x3a3681ebL), tole(0x2d4d95a8L), tole(0x14c0a96dL), tole(0x03bbbd2eL),
+tole(0x67dad0e7L), tole(0x70a1c4a4L), tole(0x492cf861L), tole(0x5e57ec22L),
+tole(0x81ee23f3L), tole(0x969537b0L), tole(0xaf180b75L), tole(0xb8631f36L),
+tole(0xdc0272ffL), tole(0xcb7966bcL), tole(0xf2f45a79L), tole(0xe58f4e3aL),
+tole(0x96f6c39aL), tole(0x818dd7d9L), tole(0xb800eb1cL), tole(0xaf7bff5fL),
+tole(0xcb1a9296L), tole(0xdc6186d5L), tole(0xe5ecba10L), tole(0xf297ae53L),
+tole(0x2d2e6182L), tole(0x3a5575c1L), tole(0x03d84904L), tole(0x14a35d47L),
+tole(0x70c2308eL), tole(0x67b924cdL), tole(0x5e341808L), tole(0x494f0c4bL)
+},
+{
+tole(0x00000000L), tole(0xefc26b3eL), tole(0x04f5d03dL), tole(0xeb37bb03L),
+tole(0x09eba07aL), tole(0xe629cb44L), tole(0x0d1e7047L), tole(0xe2dc1b79L),
+tole(0x13d740f4L), tole(0xfc152bcaL), tole(0x172290c9L), tole(0xf8e0fbf7L),
+tole(0x1a3ce08eL), tole(0xf5fe8bb0L), tole(0x1ec930b3L), tole(0xf10b5b8dL),
+tole(0x27ae81e8L), tole(0xc86cead6L), tole(0x235b51d5L), tole(0xcc993aebL),
+tole(0x2e452192L), tole(0xc1874aacL), tole(0x2ab0f1afL), tole(0xc5729a91L),
+tole(0x3479c11cL), tole(0xdbbbaa22L), tole(0x308c1121L), tole(0xdf4e7a1fL),
+tole(0x3d926166L), tole(0xd2500a58L), tole(0x3967b15bL), tole(0xd6a5da65L),
+tole(0x4f5d03d0L), tole(0xa09f68eeL), tole(0x4ba8d3edL), tole(0xa46ab8d3L),
+tole(0x46b6a3aaL), tole(0xa974c894L), tole(0x42437397L), tole(0xad8118a9L),
+tole(0x5c8a4324L), tole(0xb348281aL), tole(0x587f9319L), tole(0xb7bdf827L),
+tole(0x5561e35eL), tole(0xbaa38860L), tole(0x51943363L), tole(0xbe56585dL),
+tole(0x68f38238L), tole(0x8731e906L), tole(0x6c065205L), tole(0x83c4393bL),
+tole(0x61182242L), tole(0x8eda497cL), tole(0x65edf27fL), tole(0x8a2f9941L),
+tole(0x7b24c2ccL), tole(0x94e6a9f2L), tole(0x7fd112f1L), tole(0x901379cfL),
+tole(0x72cf62b6L), tole(0x9d0d0988L), tole(0x763ab28bL), tole(0x99f8d9b5L),
+tole(0x9eba07a0L), tole(0x71786c9eL), tole(0x9a4fd79dL), tole(0x758dbca3L),
+tole(0x9751a7daL), tole(0x7893cce4L), tole(0x93a477e7L), tole(0x7c661cd9L),
+tole(0x8d6d4754L), tole(0x62af2c6aL), tole(0x89989769L), tole(0x665afc57L),
+tole(0x8486e72eL), tole(0x6b448c10L), tole(0x80733713L), tole(0x6fb15c2dL),
+tole(0xb9148648L), tole(0x56d6ed76L), tole(0xbde15675L), tole(0x52233d4bL),
+tole(0xb0ff2632L), tole(0x5f3d4d0cL), tole(0xb40af60fL), tole(0x5bc89d31L),
+tole(0xaac3c6bcL), tole(0x4501ad82L), tole(0xae361681L), tole(0x41f47dbfL),
+tole(0xa32866c6L), tole(0x4cea0df8L), tole(0xa7ddb6fbL), tole(0x481fddc5L),
+tole(0xd1e70470L), tole(0x3e256f4eL), tole(0xd512d44dL), tole(0x3ad0bf73L),
+tole(0xd80ca40aL), tole(0x37cecf34L), tole(0xdcf97437L), tole(0x333b1f09L),
+tole(0xc2304484L), tole(0x2df22fbaL), tole(0xc6c594b9L), tole(0x2907ff87L),
+tole(0xcbdbe4feL), tole(0x24198fc0L), tole(0xcf2e34c3L), tole(0x20ec5ffdL),
+tole(0xf6498598L), tole(0x198beea6L), tole(0xf2bc55a5L), tole(0x1d7e3e9bL),
+tole(0xffa225e2L), tole(0x10604edcL), tole(0xfb57f5dfL), tole(0x14959ee1L),
+tole(0xe59ec56cL), tole(0x0a5cae52L), tole(0xe16b1551L), tole(0x0ea97e6fL),
+tole(0xec756516L), tole(0x03b70e28L), tole(0xe880b52bL), tole(0x0742de15L),
+tole(0xe6050901L), tole(0x09c7623fL), tole(0xe2f0d93cL), tole(0x0d32b202L),
+tole(0xefeea97bL), tole(0x002cc245L), tole(0xeb1b7946L), tole(0x04d91278L),
+tole(0xf5d249f5L), tole(0x1a1022cbL), tole(0xf12799c8L), tole(0x1ee5f2f6L),
+tole(0xfc39e98fL), tole(0x13fb82b1L), tole(0xf8cc39b2L), tole(0x170e528cL),
+tole(0xc1ab88e9L), tole(0x2e69e3d7L), tole(0xc55e58d4L), tole(0x2a9c33eaL),
+tole(0xc8402893L), tole(0x278243adL), tole(0xccb5f8aeL), tole(0x23779390L),
+tole(0xd27cc81dL), tole(0x3dbea323L), tole(0xd6891820L), tole(0x394b731eL),
+tole(0xdb976867L), tole(0x34550359L), tole(0xdf62b85aL), tole(0x30a0d364L),
+tole(0xa9580ad1L), tole(0x469a61efL), tole(0xadaddaecL), tole(0x426fb1d2L),
+tole(0xa0b3aaabL), tole(0x4f71c195L), tole(0xa4467a96L), tole(0x4b8411a8L),
+tole(0xba8f4a25L), tole(0x554d211bL), tole(0xbe7a9a18L), tole(0x51b8f126L),
+tole(0xb364ea5fL), tole(0x5ca68161L), tole(0xb7913a62L), tole(0x5853515cL),
+tole(0x8ef68b39L), tole(0x6134e007L), tole(0x8a035b04L), tole(0x65c1303aL),
+tole(0x871d2b43L), tole(0x68df407dL), tole(0x83e8fb7eL), tole(0x6c2a9040L),
+tole(0x9d21cbcdL), tole(0x72e3a0f3L), tole(0x99d41bf0L), tole(0x761670ceL),
+tole(0x94ca6bb7L), tole(0x7b080089L), tole(0x903fbb8aL), tole(0x7ffdd0b4L),
+tole(0x78bf0ea1L), tole(0x977d659fL), tole(0x7c4ade9cL), tole(0x9388b5a2L),
+tole(0x7154aedbL), tole(0x9e96c5e5L), tole(0x75a17ee6L), tole(0x9a6315d8L),
+tole(0x6b684e55L), tole(0x84aa256bL), tole(0x6f9d9e68L), tole(0x805ff556L),
+tole(0x6283ee2fL), tole(0x8d418511L), tole(0x66763e12L), tole(0x89b4552cL),
+tole(0x5f118f49L), tole(0xb0d3e477L), tole(0x5be45f74L), tole(0xb426344aL),
+tole(0x56fa2f33L), tole(0xb938440dL), tole(0x520fff0eL), tole(0xbdcd9430L),
+tole(0x4cc6cfbdL), tole(0xa304a483L), tole(0x48331f80L), tole(0xa7f174beL),
+tole(0x452d6fc7L), tole(0xaaef04f9L), tole(0x41d8bffaL), tole(0xae1ad4c4L),
+tole(0x37e20d71L), tole(0xd820664fL), tole(0x3317dd4cL), tole(0xdcd5b672L),
+tole(0x3e09ad0bL), tole(0xd1cbc635L), tole(0x3afc7d36L), tole(0xd53e1608L),
+tole(0x24354d85L), tole(0xcbf726bbL), tole(0x20c09db8L), tole(0xcf02f686L),
+tole(0x2ddeedffL), tole(0xc21c86c1L), tole(0x292b3dc2L), tole(0xc6e956fcL),
+tole(0x104c8c99L), tole(0xff8ee7a7L), tole(0x14b95ca4L), tole(0xfb7b379aL),
+tole(0x19a72ce3L), tole(0xf66547ddL), tole(0x1d52fcdeL), tole(0xf29097e0L),
+tole(0x039bcc6dL), tole(0xec59a753L), tole(0x076e1c50L), tole(0xe8ac776eL),
+tole(0x0a706c17L), tole(0xe5b20729L), tole(0x0e85bc2aL), tole(0xe147d714L)
+},
+{
+tole(0x00000000L), tole(0xc18edfc0L), tole(0x586cb9c1L), tole(0x99e26601L),
+tole(0xb0d97382L), tole(0x7157ac42L), tole(0xe8b5ca43L), tole(0x293b1583L),
+tole(0xbac3e145L), tole(0x7b4d3e85L), tole(0xe2af5884L), tole(0x23218744L),
+tole(0x0a1a92c7L), tole(0xcb944d07L), tole(0x52762b06L), tole(0x93f8f4c6L),
+tole(0xaef6c4cbL), tole(0x6f781b0bL), tole(0xf69a7d0aL), tole(0x3714a2caL),
+tole(0x1e2fb749L), tole(0xdfa16889L), tole(0x46430e88L), tole(0x87cdd148L),
+tole(0x1435258eL), tole(0xd5bbfa4eL), tole(0x4c599c4fL), tole(0x8dd7438fL),
+tole(0xa4ec560cL), tole(0x656289ccL), tole(0xfc80efcdL), tole(0x3d0e300dL),
+tole(0x869c8fd7L), tole(0x47125017L), tole(0xdef03616L), tole(0x1f7ee9d6L),
+tole(0x3645fc55L), tole(0xf7cb2395L), tole(0x6e294594L), tole(0xafa79a54L),
+tole(0x3c5f6e92L), tole(0xfdd1b152L), tole(0x6433d753L), tole(0xa5bd0893L),
+tole(0x8c861d10L), tole(0x4d08c2d0L), tole(0xd4eaa4d1L), tole(0x15647b11L),
+tole(0x286a4b1cL), tole(0xe9e494dcL), tole(0x7006f2ddL), tole(0xb1882d1dL),
+tole(0x98b3389eL), tole(0x593de75eL), tole(0xc0df815fL), tole(0x01515e9fL),
+tole(0x92a9aa59L), tole(0x53277599L), tole(0xcac51398L), tole(0x0b4bcc58L),
+tole(0x2270d9dbL), tole(0xe3fe061bL), tole(0x7a1c601aL), tole(0xbb92bfdaL),
+tole(0xd64819efL), tole(0x17c6c62fL), tole(0x8e24a02eL), tole(0x4faa7feeL),
+tole(0x66916a6dL), tole(0xa71fb5adL), tole(0x3efdd3acL), tole(0xff730c6cL),
+tole(0x6c8bf8aaL), tole(0xad05276aL), tole(0x34e7416bL), tole(0xf5699eabL),
+tole(0xdc528b28L), tole(0x1ddc54e8L), tole(0x843e32e9L), tole(0x45b0ed29L),
+tole(0x78bedd24L), tole(0xb93002e4L), tole(0x20d264e5L), tole(0xe15cbb25L),
+tole(0xc867aea6L), tole(0x09e97166L), tole(0x900b1767L), tole(0x5185c8a7L),
+tole(0xc27d3c61L), tole(0x03f3e3a1L), tole(0x9a1185a0L), tole(0x5b9f5a60L),
+tole(0x72a44fe3L), tole(0xb32a9023L), tole(0x2ac8f622L), tole(0xeb4629e2L),
+tole(0x50d49638L), tole(0x915a49f8L), tole(0x08b82ff9L), tole(0xc936f039L),
+tole(0xe00de5baL), tole(0x21833a7aL), tole(0xb8615c7bL), tole(0x79ef83bbL),
+tole(0xea17777dL), tole(0x2b99a8bdL), tole(0xb27bcebcL), tole(0x73f5117cL),
+tole(0x5ace04ffL), tole(0x9b40db3fL), tole(0x02a2bd3eL), tole(0xc32c62feL),
+tole(0xfe2252f3L), tole(0x3fac8d33L), tole(0xa64eeb32L), tole(0x67c034f2L),
+tole(0x4efb2171L), tole(0x8f75feb1L), tole(0x169798b0L), tole(0xd7194770L),
+tole(0x44e1b3b6L), tole(0x856f6c76L), tole(0x1c8d0a77L), tole(0xdd03d5b7L),
+tole(0xf438c034L), tole(0x35b61ff4L), tole(0xac5479f5L), tole(0x6ddaa635L),
+tole(0x77e1359fL), tole(0xb66fea5fL), tole(0x2f8d8c5eL), tole(0xee03539eL),
+tole(0xc738461dL), tole(0x06b699ddL), tole(0x9f54ffdcL), tole(0x5eda201cL),
+tole(0xcd22d4daL), tole(0x0cac0b1aL), tole(0x954e6d1bL), tole(0x54c0b2dbL),
+tole(0x7dfba758L), tole(0xbc757898L), tole(0x25971e99L), tole(0xe419c159L),
+tole(0xd917f154L), tole(0x18992e94L), tole(0x817b4895L), tole(0x40f59755L),
+tole(0x69ce82d6L), tole(0xa8405d16L), tole(0x31a23b17L), tole(0xf02ce4d7L),
+tole(0x63d41011L), tole(0xa25acfd1L), tole(0x3bb8a9d0L), tole(0xfa367610L),
+tole(0xd30d6393L), tole(0x1283bc53L), tole(0x8b61da52L), tole(0x4aef0592L),
+tole(0xf17dba48L), tole(0x30f36588L), tole(0xa9110389L), tole(0x689fdc49L),
+tole(0x41a4c9caL), tole(0x802a160aL), tole(0x19c8700bL), tole(0xd846afcbL),
+tole(0x4bbe5b0dL), tole(0x8a3084cdL), tole(0x13d2e2ccL), tole(0xd25c3d0cL),
+tole(0xfb67288fL), tole(0x3ae9f74fL), tole(0xa30b914eL), tole(0x62854e8eL),
+tole(0x5f8b7e83L), tole(0x9e05a143L), tole(0x07e7c742L), tole(0xc6691882L),
+tole(0xef520d01L), tole(0x2edcd2c1L), tole(0xb73eb4c0L), tole(0x76b06b00L),
+tole(0xe5489fc6L), tole(0x24c64006L), tole(0xbd242607L), tole(0x7caaf9c7L),
+tole(0x5591ec44L), tole(0x941f3384L), tole(0x0dfd5585L), tole(0xcc738a45L),
+tole(0xa1a92c70L), tole(0x6027f3b0L), tole(0xf9c595b1L), tole(0x384b4a71L),
+tole(0x11705ff2L), tole(0xd0fe8032L), tole(0x491ce633L), tole(0x889239f3L),
+tole(0x1b6acd35L), tole(0xdae412f5L), tole(0x430674f4L), tole(0x8288ab34L),
+tole(0xabb3beb7L), tole(0x6a3d6177L), tole(0xf3df0776L), tole(0x3251d8b6L),
+tole(0x0f5fe8bbL), tole(0xced1377bL), tole(0x5733517aL), tole(0x96bd8ebaL),
+tole(0xbf869b39L), tole(0x7e0844f9L), tole(0xe7ea22f8L), tole(0x2664fd38L),
+tole(0xb59c09feL), tole(0x7412d63eL), tole(0xedf0b03fL), tole(0x2c7e6fffL),
+tole(0x05457a7cL), tole(0xc4cba5bcL), tole(0x5d29c3bdL), tole(0x9ca71c7dL),
+tole(0x2735a3a7L), tole(0xe6bb7c67L), tole(0x7f591a66L), tole(0xbed7c5a6L),
+tole(0x97ecd025L), tole(0x56620fe5L), tole(0xcf8069e4L), tole(0x0e0eb624L),
+tole(0x9df642e2L), tole(0x5c789d22L), tole(0xc59afb23L), tole(0x041424e3L),
+tole(0x2d2f3160L), tole(0xeca1eea0L), tole(0x754388a1L), tole(0xb4cd5761L),
+tole(0x89c3676cL), tole(0x484db8acL), tole(0xd1afdeadL), tole(0x1021016dL),
+tole(0x391a14eeL), tole(0xf894cb2eL), tole(0x6176ad2fL), tole(0xa0f872efL),
+tole(0x33008629L), tole(0xf28e59e9L), tole(0x6b6c3fe8L), tole(0xaae2e028L),
+tole(0x83d9f5abL), tole(0x42572a6bL), tole(0xdbb54c6aL), tole(0x1a3b93aaL)
+},
+{
+tole(0x00000000L), tole(0x9ba54c6fL), tole(0xec3b9e9fL), tole(0x779ed2f0L),
+tole(0x03063b7fL), tole(0x98a37710L), tole(0xef3da5e0L), tole(0x7498e98fL),
+tole(0x060c76feL), tole(0x9da93a91L), tole(0xea37e861L), tole(0x7192a40eL),
+tole(0x050a4d81L), tole(0x9eaf01eeL), tole(0xe931d31eL), tole(0x72949f71L),
+tole(0x0c18edfcL), tole(0x97bda193L), tole(0xe0237363L), tole(0x7b863f0cL),
+tole(0x0f1ed683L), tole(0x94bb9aecL), tole(0xe325481cL), tole(0x78800473L),
+tole(0x0a149b02L), tole(0x91b1d76dL), tole(0xe62f059dL), tole(0x7d8a49f2L),
+tole(0x0912a07dL), tole(0x92b7ec12L), tole(0xe5293ee2L), tole(0x7e8c728dL),
+tole(0x1831dbf8L), tole(0x83949797L), tole(0xf40a4567L), tole(0x6faf0908L),
+tole(0x1b37e087L), tole(0x8092ace8L), tole(0xf70c7e18L), tole(0x6ca93277L),
+tole(0x1e3dad06L), tole(0x8598e169L), tole(0xf2063399L), tole(0x69a37ff6L),
+tole(0x1d3b9679L), tole(0x869eda16L), tole(0xf10008e6L), tole(0x6aa54489L),
+tole(0x14293604L), tole(0x8f8c7a6bL), tole(0xf812a89bL), tole(0x63b7e4f4L),
+tole(0x172f0d7bL), tole(0x8c8a4114L), tole(0xfb1493e4L), tole(0x60b1df8bL),
+tole(0x122540faL), tole(0x89800c95L), tole(0xfe1ede65L), tole(0x65bb920aL),
+tole(0x11237b85L), tole(0x8a8637eaL), tole(0xfd18e51aL), tole(0x66bda975L),
+tole(0x3063b7f0L), tole(0xabc6fb9fL), tole(0xdc58296fL), tole(0x47fd6500L),
+tole(0x33658c8fL), tole(0xa8c0c0e0L), tole(0xdf5e1210L), tole(0x44fb5e7fL),
+tole(0x366fc10eL), tole(0xadca8d61L), tole(0xda545f91L), tole(0x41f113feL),
+tole(0x3569fa71L), tole(0xaeccb61eL), tole(0xd95264eeL), tole(0x42f72881L),
+tole(0x3c7b5a0cL), tole(0xa7de1663L), tole(0xd040c493L), tole(0x4be588fcL),
+tole(0x3f7d6173L), tole(0xa4d82d1cL), tole(0xd346ffecL), tole(0x48e3b383L),
+tole(0x3a772cf2L), tole(0xa1d2609dL), tole(0xd64cb26dL), tole(0x4de9fe02L),
+tole(0x3971178dL), tole(0xa2d45be2L), tole(0xd54a8912L), tole(0x4eefc57dL),
+tole(0x28526c08L), tole(0xb3f72067L), tole(0xc469f297L), tole(0x5fccbef8L),
+tole(0x2b545777L), tole(0xb0f11b18L), tole(0xc76fc9e8L), tole(0x5cca8587L),
+tole(0x2e5e1af6L), tole(0xb5fb5699L), tole(0xc2658469L), tole(0x59c0c806L),
+tole(0x2d582189L), tole(0xb6fd6de6L), tole(0xc163bf16L), tole(0x5ac6f379L),
+tole(0x244a81f4L), tole(0xbfefcd9bL), tole(0xc8711f6bL), tole(0x53d45304L),
+tole(0x274cba8bL), tole(0xbce9f6e4L), tole(0xcb772414L), tole(0x50d2687bL),
+tole(0x2246f70aL), tole(0xb9e3bb65L), tole(0xce7d6995L), tole(0x55d825faL),
+tole(0x2140cc75L), tole(0xbae5801aL), tole(0xcd7b52eaL), tole(0x56de1e85L),
+tole(0x60c76fe0L), tole(0xfb62238fL), tole(0x8cfcf17fL), tole(0x1759bd10L),
+tole(0x63c1549fL), tole(0xf86418f0L), tole(0x8ffaca00L), tole(0x145f866fL),
+tole(0x66cb191eL), tole(0xfd6e5571L), tole(0x8af08781L), tole(0x1155cbeeL),
+tole(0x65cd2261L), tole(0xfe686e0eL), tole(0x89f6bcfeL), tole(0x1253f091L),
+tole(0x6cdf821cL), tole(0xf77ace73L), tole(0x80e41c83L), tole(0x1b4150ecL),
+tole(0x6fd9b963L), tole(0xf47cf50cL), tole(0x83e227fcL), tole(0x18476b93L),
+tole(0x6ad3f4e2L), tole(0xf176b88dL), tole(0x86e86a7dL), tole(0x1d4d2612L),
+tole(0x69d5cf9dL), tole(0xf27083f2L), tole(0x85ee5102L), tole(0x1e4b1d6dL),
+tole(0x78f6b418L), tole(0xe353f877L), tole(0x94cd2a87L), tole(0x0f6866e8L),
+tole(0x7bf08f67L), tole(0xe055c308L), tole(0x97cb11f8L), tole(0x0c6e5d97L),
+tole(0x7efac2e6L), tole(0xe55f8e89L), tole(0x92c15c79L), tole(0x09641016L),
+tole(0x7dfcf999L), tole(0xe659b5f6L), tole(0x91c76706L), tole(0x0a622b69L),
+tole(0x74ee59e4L), tole(0xef4b158bL), tole(0x98d5c77bL), tole(0x03708b14L),
+tole(0x77e8629bL), tole(0xec4d2ef4L), tole(0x9bd3fc04L), tole(0x0076b06bL),
+tole(0x72e22f1aL), tole(0xe9476375L), tole(0x9ed9b185L), tole(0x057cfdeaL),
+tole(0x71e41465L), tole(0xea41580aL), tole(0x9ddf8afaL), tole(0x067ac695L),
+tole(0x50a4d810L), tole(0xcb01947fL), tole(0xbc9f468fL), tole(0x273a0ae0L),
+tole(0x53a2e36fL), tole(0xc807af00L), tole(0xbf997df0L), tole(0x243c319fL),
+tole(0x56a8aeeeL), tole(0xcd0de281L), tole(0xba933071L), tole(0x21367c1eL),
+tole(0x55ae9591L), tole(0xce0bd9feL), tole(0xb9950b0eL), tole(0x22304761L),
+tole(0x5cbc35ecL), tole(0xc7197983L), tole(0xb087ab73L), tole(0x2b22e71cL),
+tole(0x5fba0e93L), tole(0xc41f42fcL), tole(0xb381900cL), tole(0x2824dc63L),
+tole(0x5ab04312L), tole(0xc1150f7dL), tole(0xb68bdd8dL), tole(0x2d2e91e2L),
+tole(0x59b6786dL), tole(0xc2133402L), tole(0xb58de6f2L), tole(0x2e28aa9dL),
+tole(0x489503e8L), tole(0xd3304f87L), tole(0xa4ae9d77L), tole(0x3f0bd118L),
+tole(0x4b933897L), tole(0xd03674f8L), tole(0xa7a8a608L), tole(0x3c0dea67L),
+tole(0x4e997516L), tole(0xd53c3979L), tole(0xa2a2eb89L), tole(0x3907a7e6L),
+tole(0x4d9f4e69L), tole(0xd63a0206L), tole(0xa1a4d0f6L), tole(0x3a019c99L),
+tole(0x448dee14L), tole(0xdf28a27bL), tole(0xa8b6708bL), tole(0x33133ce4L),
+tole(0x478bd56bL), tole(0xdc2e9904L), tole(0xabb04bf4L), tole(0x3015079bL),
+tole(0x428198eaL), tole(0xd924d485L), tole(0xaeba0675L), tole(0x351f4a1aL),
+tole(0x4187a395L), tole(0xda22effaL), tole(0xadbc3d0aL), tole(0x36197165L)
+},
+{
+tole(0x00000000L), tole(0xdd96d985L), tole(0x605cb54bL), tole(0xbdca6cceL),
+tole(0xc0b96a96L), tole(0x1d2fb313L), tole(0xa0e5dfddL), tole(0x7d730658L),
+tole(0x5a03d36dL), tole(0x87950ae8L), tole(0x3a5f6626L), tole(0xe7c9bfa3L),
+tole(0x9abab9fbL), tole(0x472c607eL), tole(0xfae60cb0L), tole(0x2770d535L),
+tole(0xb407a6daL), tole(0x69917f5fL), tole(0xd45b1391L), tole(0x09cdca14L),
+tole(0x74becc4cL), tole(0xa92815c9L), tole(0x14e27907L), tole(0xc974a082L),
+tole(0xee0475b7L), tole(0x3392ac32L), tole(0x8e58c0fcL), tole(0x53ce1979L),
+tole(0x2ebd1f21L), tole(0xf32bc6a4L), tole(0x4ee1aa6aL), tole(0x937773efL),
+tole(0xb37e4bf5L), tole(0x6ee89270L), tole(0xd322febeL), tole(0x0eb4273bL),
+tole(0x73c72163L), tole(0xae51f8e6L), tole(0x139b9428L), tole(0xce0d4dadL),
+tole(0xe97d9898L), tole(0x34eb411dL), tole(0x89212dd3L), tole(0x54b7f456L),
+tole(0x29c4f20eL), tole(0xf4522b8bL), tole(0x49984745L), tole(0x940e9ec0L),
+tole(0x0779ed2fL), tole(0xdaef34aaL), tole(0x67255864L), tole(0xbab381e1L),
+tole(0xc7c087b9L), tole(0x1a565e3cL), tole(0xa79c32f2L), tole(0x7a0aeb77L),
+tole(0x5d7a3e42L), tole(0x80ece7c7L), tole(0x3d268b09L), tole(0xe0b0528cL),
+tole(0x9dc354d4L), tole(0x40558d51L), tole(0xfd9fe19fL), tole(0x2009381aL),
+tole(0xbd8d91abL), tole(0x601b482eL), tole(0xddd124e0L), tole(0x0047fd65L),
+tole(0x7d34fb3dL), tole(0xa0a222b8L), tole(0x1d684e76L), tole(0xc0fe97f3L),
+tole(0xe78e42c6L), tole(0x3a189b43L), tole(0x87d2f78dL), tole(0x5a442e08L),
+tole(0x27372850L), tole(0xfaa1f1d5L), tole(0x476b9d1bL), tole(0x9afd449eL),
+tole(0x098a3771L), tole(0xd41ceef4L), tole(0x69d6823aL), tole(0xb4405bbfL),
+tole(0xc9335de7L), tole(0x14a58462L), tole(0xa96fe8acL), tole(0x74f93129L),
+tole(0x5389e41cL), tole(0x8e1f3d99L), tole(0x33d55157L), tole(0xee4388d2L),
+tole(0x93308e8aL), tole(0x4ea6570fL), tole(0xf36c3bc1L), tole(0x2efae244L),
+tole(0x0ef3da5eL), tole(0xd36503dbL), tole(0x6eaf6f15L), tole(0xb339b690L),
+tole(0xce4ab0c8L), tole(0x13dc694dL), tole(0xae160583L), tole(0x7380dc06L),
+tole(0x54f00933L), tole(0x8966d0b6L), tole(0x34acbc78L), tole(0xe93a65fdL),
+tole(0x944963a5L), tole(0x49dfba20L), tole(0xf415d6eeL), tole(0x29830f6bL),
+tole(0xbaf47c84L), tole(0x6762a501L), tole(0xdaa8c9cfL), tole(0x073e104aL),
+tole(0x7a4d1612L), tole(0xa7dbcf97L), tole(0x1a11a359L), tole(0xc7877adcL),
+tole(0xe0f7afe9L), tole(0x3d61766cL), tole(0x80ab1aa2L), tole(0x5d3dc327L),
+tole(0x204ec57fL), tole(0xfdd81cfaL), tole(0x40127034L), tole(0x9d84a9b1L),
+tole(0xa06a2517L), tole(0x7dfcfc92L), tole(0xc036905cL), tole(0x1da049d9L),
+tole(0x60d34f81L), tole(0xbd459604L), tole(0x008ffacaL), tole(0xdd19234fL),
+tole(0xfa69f67aL), tole(0x27ff2fffL), tole(0x9a354331L), tole(0x47a39ab4L),
+tole(0x3ad09cecL), tole(0xe7464569L), tole(0x5a8c29a7L), tole(0x871af022L),
+tole(0x146d83cdL), tole(0xc9fb5a48L), tole(0x74313686L), tole(0xa9a7ef03L),
+tole(0xd4d4e95bL), tole(0x094230deL), tole(0xb4885c10L), tole(0x691e8595L),
+tole(0x4e6e50a0L), tole(0x93f88925L), tole(0x2e32e5ebL), tole(0xf3a43c6eL),
+tole(0x8ed73a36L), tole(0x5341e3b3L), tole(0xee8b8f7dL), tole(0x331d56f8L),
+tole(0x13146ee2L), tole(0xce82b767L), tole(0x7348dba9L), tole(0xaede022cL),
+tole(0xd3ad0474L), tole(0x0e3bddf1L), tole(0xb3f1b13fL), tole(0x6e6768baL),
+tole(0x4917bd8fL), tole(0x9481640aL), tole(0x294b08c4L), tole(0xf4ddd141L),
+tole(0x89aed719L), tole(0x54380e9cL), tole(0xe9f26252L), tole(0x3464bbd7L),
+tole(0xa713c838L), tole(0x7a8511bdL), tole(0xc74f7d73L), tole(0x1ad9a4f6L),
+tole(0x67aaa2aeL), tole(0xba3c7b2bL), tole(0x07f617e5L), tole(0xda60ce60L),
+tole(0xfd101b55L), tole(0x2086c2d0L), tole(0x9d4cae1eL), tole(0x40da779bL),
+tole(0x3da971c3L), tole(0xe03fa846L), tole(0x5df5c488L), tole(0x80631d0dL),
+tole(0x1de7b4bcL), tole(0xc0716d39L), tole(0x7dbb01f7L), tole(0xa02dd872L),
+tole(0xdd5ede2aL), tole(0x00c807afL), tole(0xbd026b61L), tole(0x6094b2e4L),
+tole(0x47e467d1L), tole(0x9a72be54L), tole(0x27b8d29aL), tole(0xfa2e0b1fL),
+tole(0x875d0d47L), tole(0x5acbd4c2L), tole(0xe701b80cL), tole(0x3a976189L),
+tole(0xa9e01266L), tole(0x7476cbe3L), tole(0xc9bca72dL), tole(0x142a7ea8L),
+tole(0x695978f0L), tole(0xb4cfa175L), tole(0x0905cdbbL), tole(0xd493143eL),
+tole(0xf3e3c10bL), tole(0x2e75188eL), tole(0x93bf7440L), tole(0x4e29adc5L),
+tole(0x335aab9dL), tole(0xeecc7218L), tole(0x53061ed6L), tole(0x8e90c753L),
+tole(0xae99ff49L), tole(0x730f26ccL), tole(0xcec54a02L), tole(0x13539387L),
+tole(0x6e2095dfL), tole(0xb3b64c5aL), tole(0x0e7c2094L), tole(0xd3eaf911L),
+tole(0xf49a2c24L), tole(0x290cf5a1L), tole(0x94c6996fL), tole(0x495040eaL),
+tole(0x342346b2L), tole(0xe9b59f37L), tole(0x547ff3f9L), tole(0x89e92a7cL),
+tole(0x1a9e5993L), tole(0xc7088016L), tole(0x7ac2ecd8L), tole(0xa754355dL),
+tole(0xda273305L), tole(0x07b1ea80L), tole(0xba7b864eL), tole(0x67ed5fcbL),
+tole(0x409d8afeL), tole(0x9d0b537bL), tole(0x20c13fb5L), tole(0xfd57e630L),
+tole(0x8024e068L), tole(0x5db239edL), tole(0xe0785523L), tole(0x3dee8ca6L)
+},
+{
+tole(0x00000000L), tole(0x9d0fe176L), tole(0xe16ec4adL), tole(0x7c6125dbL),
+tole(0x19ac8f1bL), tole(0x84a36e6dL), tole(0xf8c24bb6L), tole(0x65cdaac0L),
+tole(0x33591e36L), tole(0xae56ff40L), tole(0xd237da9bL), tole(0x4f383bedL),
+tole(0x2af5912dL), tole(0xb7fa705bL), tole(0xcb9b5580L), tole(0x5694b4f6L),
+tole(0x66b23c6cL), tole(0xfbbddd1aL), tole(0x87dcf8c1L), tole(0x1ad319b7L),
+tole(0x7f1eb377L), tole(0xe2115201L), tole(0x9e7077daL), tole(0x037f96acL),
+tole(0x55eb225aL), tole(0xc8e4c32cL), tole(0xb485e6f7L), tole(0x298a0781L),
+tole(0x4c47ad41L), tole(0xd1484c37L), tole(0xad2969ecL), tole(0x3026889aL),
+tole(0xcd6478d8L), tole(0x506b99aeL), tole(0x2c0abc75L), tole(0xb1055d03L),
+tole(0xd4c8f7c3L), tole(0x49c716b5L), tole(0x35a6336eL), tole(0xa8a9d218L),
+tole(0xfe3d66eeL), tole(0x63328798L), tole(0x1f53a243L), tole(0x825c4335L),
+tole(0xe791e9f5L), tole(0x7a9e0883L), tole(0x06ff2d58L), tole(0x9bf0cc2eL),
+tole(0xabd644b4L), tole(0x36d9a5c2L), tole(0x4ab88019L), tole(0xd7b7616fL),
+tole(0xb27acbafL), tole(0x2f752ad9L), tole(0x53140f02L), tole(0xce1bee74L),
+tole(0x988f5a82L), tole(0x0580bbf4L), tole(0x79e19e2fL), tole(0xe4ee7f59L),
+tole(0x8123d599L), tole(0x1c2c34efL), tole(0x604d1134L), tole(0xfd42f042L),
+tole(0x41b9f7f1L), tole(0xdcb61687L), tole(0xa0d7335cL), tole(0x3dd8d22aL),
+tole(0x581578eaL), tole(0xc51a999cL), tole(0xb97bbc47L), tole(0x24745d31L),
+tole(0x72e0e9c7L), tole(0xefef08b1L), tole(0x938e2d6aL), tole(0x0e81cc1cL),
+tole(0x6b4c66dcL), tole(0xf64387aaL), tole(0x8a22a271L), tole(0x172d4307L),
+tole(0x270bcb9dL), tole(0xba042aebL), tole(0xc6650f30L), tole(0x5b6aee46L),
+tole(0x3ea74486L), tole(0xa3a8a5f0L), tole(0xdfc9802bL), tole(0x42c6615dL),
+tole(0x1452d5abL), tole(0x895d34ddL), tole(0xf53c1106L), tole(0x6833f070L),
+tole(0x0dfe5ab0L), tole(0x90f1bbc6L), tole(0xec909e1dL), tole(0x719f7f6bL),
+tole(0x8cdd8f29L), tole(0x11d26e5fL), tole(0x6db34b84L), tole(0xf0bcaaf2L),
+tole(0x95710032L), tole(0x087ee144L), tole(0x741fc49fL), tole(0xe91025e9L),
+tole(0xbf84911fL), tole(0x228b7069L), tole(0x5eea55b2L), tole(0xc3e5b4c4L),
+tole(0xa6281e04L), tole(0x3b27ff72L), tole(0x4746daa9L), tole(0xda493bdfL),
+tole(0xea6fb345L), tole(0x77605233L), tole(0x0b0177e8L), tole(0x960e969eL),
+tole(0xf3c33c5eL), tole(0x6eccdd28L), tole(0x12adf8f3L), tole(0x8fa21985L),
+tole(0xd936ad73L), tole(0x44394c05L), tole(0x385869deL), tole(0xa55788a8L),
+tole(0xc09a2268L), tole(0x5d95c31eL), tole(0x21f4e6c5L), tole(0xbcfb07b3L),
+tole(0x8373efe2L), tole(0x1e7c0e94L), tole(0x621d2b4fL), tole(0xff12ca39L),
+tole(0x9adf60f9L), tole(0x07d0818fL), tole(0x7bb1a454L), tole(0xe6be4522L),
+tole(0xb02af1d4L), tole(0x2d2510a2L), tole(0x51443579L), tole(0xcc4bd40fL),
+tole(0xa9867ecfL), tole(0x34899fb9L), tole(0x48e8ba62L), tole(0xd5e75b14L),
+tole(0xe5c1d38eL), tole(0x78ce32f8L), tole(0x04af1723L), tole(0x99a0f655L),
+tole(0xfc6d5c95L), tole(0x6162bde3L), tole(0x1d039838L), tole(0x800c794eL),
+tole(0xd698cdb8L), tole(0x4b972cceL), tole(0x37f60915L), tole(0xaaf9e863L),
+tole(0xcf3442a3L), tole(0x523ba3d5L), tole(0x2e5a860eL), tole(0xb3556778L),
+tole(0x4e17973aL), tole(0xd318764cL), tole(0xaf795397L), tole(0x3276b2e1L),
+tole(0x57bb1821L), tole(0xcab4f957L), tole(0xb6d5dc8cL), tole(0x2bda3dfaL),
+tole(0x7d4e890cL), tole(0xe041687aL), tole(0x9c204da1L), tole(0x012facd7L),
+tole(0x64e20617L), tole(0xf9ede761L), tole(0x858cc2baL), tole(0x188323ccL),
+tole(0x28a5ab56L), tole(0xb5aa4a20L), tole(0xc9cb6ffbL), tole(0x54c48e8dL),
+tole(0x3109244dL), tole(0xac06c53bL), tole(0xd067e0e0L), tole(0x4d680196L),
+tole(0x1bfcb560L), tole(0x86f35416L), tole(0xfa9271cdL), tole(0x679d90bbL),
+tole(0x02503a7bL), tole(0x9f5fdb0dL), tole(0xe33efed6L), tole(0x7e311fa0L),
+tole(0xc2ca1813L), tole(0x5fc5f965L), tole(0x23a4dcbeL), tole(0xbeab3dc8L),
+tole(0xdb669708L), tole(0x4669767eL), tole(0x3a0853a5L), tole(0xa707b2d3L),
+tole(0xf1930625L), tole(0x6c9ce753L), tole(0x10fdc288L), tole(0x8df223feL),
+tole(0xe83f893eL), tole(0x75306848L), tole(0x09514d93L), tole(0x945eace5L),
+tole(0xa478247fL), tole(0x3977c509L), tole(0x4516e0d2L), tole(0xd81901a4L),
+tole(0xbdd4ab64L), tole(0x20db4a12L), tole(0x5cba6fc9L), tole(0xc1b58ebfL),
+tole(0x97213a49L), tole(0x0a2edb3fL), tole(0x764ffee4L), tole(0xeb401f92L),
+tole(0x8e8db552L), tole(0x13825424L), tole(0x6fe371ffL), tole(0xf2ec9089L),
+tole(0x0fae60cbL), tole(0x92a181bdL), tole(0xeec0a466L), tole(0x73cf4510L),
+tole(0x1602efd0L), tole(0x8b0d0ea6L), tole(0xf76c2b7dL), tole(0x6a63ca0bL),
+tole(0x3cf77efdL), tole(0xa1f89f8bL), tole(0xdd99ba50L), tole(0x40965b26L),
+tole(0x255bf1e6L), tole(0xb8541090L), tole(0xc435354bL), tole(0x593ad43dL),
+tole(0x691c5ca7L), tole(0xf413bdd1L), tole(0x8872980aL), tole(0x157d797cL),
+tole(0x70b0d3bcL), tole(0xedbf32caL), tole(0x91de1711L), tole(0x0cd1f667L),
+tole(0x5a454291L), tole(0xc74aa3e7L), tole(0xbb2b863cL), tole(0x2624674aL),
+tole(0x43e9cd8aL), tole(0xdee62cfcL), tole(0xa2870927L), tole(0x3f88e851L)
+},
+{
+tole(0x00000000L), tole(0xb9fbdbe8L), tole(0xa886b191L), tole(0x117d6a79L),
+tole(0x8a7c6563L), tole(0x3387be8bL), tole(0x22fad4f2L), tole(0x9b010f1aL),
+tole(0xcf89cc87L), tole(0x7672176fL), tole(0x670f7d16L), tole(0xdef4a6feL),
+tole(0x45f5a9e4L), tole(0xfc0e720cL), tole(0xed731875L), tole(0x5488c39dL),
+tole(0x44629f4fL), tole(0xfd9944a7L), tole(0xece42edeL), tole(0x551ff536L),
+tole(0xce1efa2cL), tole(0x77e521c4L), tole(0x66984bbdL), tole(0xdf639055L),
+tole(0x8beb53c8L), tole(0x32108820L), tole(0x236de259L), tole(0x9a9639b1L),
+tole(0x019736abL), tole(0xb86ced43L), tole(0xa911873aL), tole(0x10ea5cd2L),
+tole(0x88c53e9eL), tole(0x313ee576L), tole(0x20438f0fL), tole(0x99b854e7L),
+tole(0x02b95bfdL), tole(0xbb428015L), tole(0xaa3fea6cL), tole(0x13c43184L),
+tole(0x474cf219L), tole(0xfeb729f1L), tole(0xefca4388L), tole(0x56319860L),
+tole(0xcd30977aL), tole(0x74cb4c92L), tole(0x65b626ebL), tole(0xdc4dfd03L),
+tole(0xcca7a1d1L), tole(0x755c7a39L), tole(0x64211040L), tole(0xdddacba8L),
+tole(0x46dbc4b2L), tole(0xff201f5aL), tole(0xee5d7523L), tole(0x57a6aecbL),
+tole(0x032e6d56L), tole(0xbad5b6beL), tole(0xaba8dcc7L), tole(0x1253072fL),
+tole(0x89520835L), tole(0x30a9d3ddL), tole(0x21d4b9a4L), tole(0x982f624cL),
+tole(0xcafb7b7dL), tole(0x7300a095L), tole(0x627dcaecL), tole(0xdb861104L),
+tole(0x40871e1eL), tole(0xf97cc5f6L), tole(0xe801af8fL), tole(0x51fa7467L),
+tole(0x0572b7faL), tole(0xbc896c12L), tole(0xadf4066bL), tole(0x140fdd83L),
+tole(0x8f0ed299L), tole(0x36f50971L), tole(0x27886308L), tole(0x9e73b8e0L),
+tole(0x8e99e432L), tole(0x37623fdaL), tole(0x261f55a3L), tole(0x9fe48e4bL),
+tole(0x04e58151L), tole(0xbd1e5ab9L), tole(0xac6330c0L), tole(0x1598eb28L),
+tole(0x411028b5L), tole(0xf8ebf35dL), tole(0xe9969924L), tole(0x506d42ccL),
+tole(0xcb6c4dd6L), tole(0x7297963eL), tole(0x63eafc47L), tole(0xda1127afL),
+tole(0x423e45e3L), tole(0xfbc59e0bL), tole(0xeab8f472L), tole(0x53432f9aL),
+tole(0xc8422080L), tole(0x71b9fb68L), tole(0x60c49111L), tole(0xd93f4af9L),
+tole(0x8db78964L), tole(0x344c528cL), tole(0x253138f5L), tole(0x9ccae31dL),
+tole(0x07cbec07L), tole(0xbe3037efL), tole(0xaf4d5d96L), tole(0x16b6867eL),
+tole(0x065cdaacL), tole(0xbfa70144L), tole(0xaeda6b3dL), tole(0x1721b0d5L),
+tole(0x8c20bfcfL), tole(0x35db6427L), tole(0x24a60e5eL), tole(0x9d5dd5b6L),
+tole(0xc9d5162bL), tole(0x702ecdc3L), tole(0x6153a7baL), tole(0xd8a87c52L),
+tole(0x43a97348L), tole(0xfa52a8a0L), tole(0xeb2fc2d9L), tole(0x52d41931L),
+tole(0x4e87f0bbL), tole(0xf77c2b53L), tole(0xe601412aL), tole(0x5ffa9ac2L),
+tole(0xc4fb95d8L), tole(0x7d004e30L), tole(0x6c7d2449L), tole(0xd586ffa1L),
+tole(0x810e3c3cL), tole(0x38f5e7d4L), tole(0x29888dadL), tole(0x90735645L),
+tole(0x0b72595fL), tole(0xb28982b7L), tole(0xa3f4e8ceL), tole(0x1a0f3326L),
+tole(0x0ae56ff4L), tole(0xb31eb41cL), tole(0xa263de65L), tole(0x1b98058dL),
+tole(0x80990a97L), tole(0x3962d17fL), tole(0x281fbb06L), tole(0x91e460eeL),
+tole(0xc56ca373L), tole(0x7c97789bL), tole(0x6dea12e2L), tole(0xd411c90aL),
+tole(0x4f10c610L), tole(0xf6eb1df8L), tole(0xe7967781L), tole(0x5e6dac69L),
+tole(0xc642ce25L), tole(0x7fb915cdL), tole(0x6ec47fb4L), tole(0xd73fa45cL),
+tole(0x4c3eab46L), tole(0xf5c570aeL), tole(0xe4b81ad7L), tole(0x5d43c13fL),
+tole(0x09cb02a2L), tole(0xb030d94aL), tole(0xa14db333L), tole(0x18b668dbL),
+tole(0x83b767c1L), tole(0x3a4cbc29L), tole(0x2b31d650L), tole(0x92ca0db8L),
+tole(0x8220516aL), tole(0x3bdb8a82L), tole(0x2aa6e0fbL), tole(0x935d3b13L),
+tole(0x085c3409L), tole(0xb1a7efe1L), tole(0xa0da8598L), tole(0x19215e70L),
+tole(0x4da99dedL), tole(0xf4524605L), tole(0xe52f2c7cL), tole(0x5cd4f794L),
+tole(0xc7d5f88eL), tole(0x7e2e2366L), tole(0x6f53491fL), tole(0xd6a892f7L),
+tole(0x847c8bc6L), tole(0x3d87502eL), tole(0x2cfa3a57L), tole(0x9501e1bfL),
+tole(0x0e00eea5L), tole(0xb7fb354dL), tole(0xa6865f34L), tole(0x1f7d84dcL),
+tole(0x4bf54741L), tole(0xf20e9ca9L), tole(0xe373f6d0L), tole(0x5a882d38L),
+tole(0xc1892222L), tole(0x7872f9caL), tole(0x690f93b3L), tole(0xd0f4485bL),
+tole(0xc01e1489L), tole(0x79e5cf61L), tole(0x6898a518L), tole(0xd1637ef0L),
+tole(0x4a6271eaL), tole(0xf399aa02L), tole(0xe2e4c07bL), tole(0x5b1f1b93L),
+tole(0x0f97d80eL), tole(0xb66c03e6L), tole(0xa711699fL), tole(0x1eeab277L),
+tole(0x85ebbd6dL), tole(0x3c106685L), tole(0x2d6d0cfcL), tole(0x9496d714L),
+tole(0x0cb9b558L), tole(0xb5426eb0L), tole(0xa43f04c9L), tole(0x1dc4df21L),
+tole(0x86c5d03bL), tole(0x3f3e0bd3L), tole(0x2e4361aaL), tole(0x97b8ba42L),
+tole(0xc33079dfL), tole(0x7acba237L), tole(0x6bb6c84eL), tole(0xd24d13a6L),
+tole(0x494c1cbcL), tole(0xf0b7c754L), tole(0xe1caad2dL), tole(0x583176c5L),
+tole(0x48db2a17L), tole(0xf120f1ffL), tole(0xe05d9b86L), tole(0x59a6406eL),
+tole(0xc2a74f74L), tole(0x7b5c949cL), tole(0x6a21fee5L), tole(0xd3da250dL),
+tole(0x8752e690L), tole(0x3ea93d78L), tole(0x2fd45701L), tole(0x962f8ce9L),
+tole(0x0d2e83f3L), tole(0xb4d5581bL), tole(0xa5a83262L), tole(0x1c53e98aL)
+},
+{
+tole(0x00000000L), tole(0xae689191L), tole(0x87a02563L), tole(0x29c8b4f2L),
+tole(0xd4314c87L), tole(0x7a59dd16L), tole(0x539169e4L), tole(0xfdf9f875L),
+tole(0x73139f4fL), tole(0xdd7b0edeL), tole(0xf4b3ba2cL), tole(0x5adb2bbdL),
+tole(0xa722d3c8L), tole(0x094a4259L), tole(0x2082f6abL), tole(0x8eea673aL),
+tole(0xe6273e9eL), tole(0x484faf0fL), tole(0x61871bfdL), tole(0xcfef8a6cL),
+tole(0x32167219L), tole(0x9c7ee388L), tole(0xb5b6577aL), tole(0x1bdec6ebL),
+tole(0x9534a1d1L), tole(0x3b5c3040L), tole(0x129484b2L), tole(0xbcfc1523L),
+tole(0x4105ed56L), tole(0xef6d7cc7L), tole(0xc6a5c835L), tole(0x68cd59a4L),
+tole(0x173f7b7dL), tole(0xb957eaecL), tole(0x909f5e1eL), tole(0x3ef7cf8fL),
+tole(0xc30e37faL), tole(0x6d66a66bL), tole(0x44ae1299L), tole(0xeac68308L),
+tole(0x642ce432L), tole(0xca4475a3L), tole(0xe38cc151L), tole(0x4de450c0L),
+tole(0xb01da8b5L), tole(0x1e753924L), tole(0x37bd8dd6L), tole(0x99d51c47L),
+tole(0xf11845e3L), tole(0x5f70d472L), tole(0x76b86080L), tole(0xd8d0f111L),
+tole(0x25290964L), tole(0x8b4198f5L), tole(0xa2892c07L), tole(0x0ce1bd96L),
+tole(0x820bdaacL), tole(0x2c634b3dL), tole(0x05abffcfL), tole(0xabc36e5eL),
+tole(0x563a962bL), tole(0xf85207baL), tole(0xd19ab348L), tole(0x7ff222d9L),
+tole(0x2e7ef6faL), tole(0x8016676bL), tole(0xa9ded399L), tole(0x07b64208L),
+tole(0xfa4fba7dL), tole(0x54272becL), tole(0x7def9f1eL), tole(0xd3870e8fL),
+tole(0x5d6d69b5L), tole(0xf305f824L), tole(0xdacd4cd6L), tole(0x74a5dd47L),
+tole(0x895c2532L), tole(0x2734b4a3L), tole(0x0efc0051L), tole(0xa09491c0L),
+tole(0xc859c864L), tole(0x663159f5L), tole(0x4ff9ed07L), tole(0xe1917c96L),
+tole(0x1c6884e3L), tole(0xb2001572L), tole(0x9bc8a180L), tole(0x35a03011L),
+tole(0xbb4a572bL), tole(0x1522c6baL), tole(0x3cea7248L), tole(0x9282e3d9L),
+tole(0x6f7b1bacL), tole(0xc1138a3dL), tole(0xe8db3ecfL), tole(0x46b3af5eL),
+tole(0x39418d87L), tole(0x97291c16L), tole(0xbee1a8e4L), tole(0x10893975L),
+tole(0xed70c100L), tole(0x43185091L), tole(0x6ad0e463L), tole(0xc4b875f2L),
+tole(0x4a5212c8L), tole(0xe43a8359L), tole(0xcdf237abL), tole(0x639aa63aL),
+tole(0x9e635e4fL), tole(0x300bcfdeL), tole(0x19c37b2cL), tole(0xb7abeabdL),
+tole(0xdf66b319L), tole(0x710e2288L), tole(0x58c6967aL), tole(0xf6ae07ebL),
+tole(0x0b57ff9eL), tole(0xa53f6e0fL), tole(0x8cf7dafdL), tole(0x229f4b6cL),
+tole(0xac752c56L), tole(0x021dbdc7L), tole(0x2bd50935L), tole(0x85bd98a4L),
+tole(0x784460d1L), tole(0xd62cf140L), tole(0xffe445b2L), tole(0x518cd423L),
+tole(0x5cfdedf4L), tole(0xf2957c65L), tole(0xdb5dc897L), tole(0x75355906L),
+tole(0x88cca173L), tole(0x26a430e2L), tole(0x0f6c8410L), tole(0xa1041581L),
+tole(0x2fee72bbL), tole(0x8186e32aL), tole(0xa84e57d8L), tole(0x0626c649L),
+tole(0xfbdf3e3cL), tole(0x55b7afadL), tole(0x7c7f1b5fL), tole(0xd2178aceL),
+tole(0xbadad36aL), tole(0x14b242fbL), tole(0x3d7af609L), tole(0x93126798L),
+tole(0x6eeb9fedL), tole(0xc0830e7cL), tole(0xe94bba8eL), tole(0x47232b1fL),
+tole(0xc9c94c25L), tole(0x67a1ddb4L), tole(0x4e696946L), tole(0xe001f8d7L),
+tole(0x1df800a2L), tole(0xb3909133L), tole(0x9a5825c1L), tole(0x3430b450L),
+tole(0x4bc29689L), tole(0xe5aa0718L), tole(0xcc62b3eaL), tole(0x620a227bL),
+tole(0x9ff3da0eL), tole(0x319b4b9fL), tole(0x1853ff6dL), tole(0xb63b6efcL),
+tole(0x38d109c6L), tole(0x96b99857L), tole(0xbf712ca5L), tole(0x1119bd34L),
+tole(0xece04541L), tole(0x4288d4d0L), tole(0x6b406022L), tole(0xc528f1b3L),
+tole(0xade5a817L), tole(0x038d3986L), tole(0x2a458d74L), tole(0x842d1ce5L),
+tole(0x79d4e490L), tole(0xd7bc7501L), tole(0xfe74c1f3L), tole(0x501c5062L),
+tole(0xdef63758L), tole(0x709ea6c9L), tole(0x5956123bL), tole(0xf73e83aaL),
+tole(0x0ac77bdfL), tole(0xa4afea4eL), tole(0x8d675ebcL), tole(0x230fcf2dL),
+tole(0x72831b0eL), tole(0xdceb8a9fL), tole(0xf5233e6dL), tole(0x5b4baffcL),
+tole(0xa6b25789L), tole(0x08dac618L), tole(0x211272eaL), tole(0x8f7ae37bL),
+tole(0x01908441L), tole(0xaff815d0L), tole(0x8630a122L), tole(0x285830b3L),
+tole(0xd5a1c8c6L), tole(0x7bc95957L), tole(0x5201eda5L), tole(0xfc697c34L),
+tole(0x94a42590L), tole(0x3accb401L), tole(0x130400f3L), tole(0xbd6c9162L),
+tole(0x40956917L), tole(0xeefdf886L), tole(0xc7354c74L), tole(0x695ddde5L),
+tole(0xe7b7badfL), tole(0x49df2b4eL), tole(0x60179fbcL), tole(0xce7f0e2dL),
+tole(0x3386f658L), tole(0x9dee67c9L), tole(0xb426d33bL), tole(0x1a4e42aaL),
+tole(0x65bc6073L), tole(0xcbd4f1e2L), tole(0xe21c4510L), tole(0x4c74d481L),
+tole(0xb18d2cf4L), tole(0x1fe5bd65L), tole(0x362d0997L), tole(0x98459806L),
+tole(0x16afff3cL), tole(0xb8c76eadL), tole(0x910fda5fL), tole(0x3f674bceL),
+tole(0xc29eb3bbL), tole(0x6cf6222aL), tole(0x453e96d8L), tole(0xeb560749L),
+tole(0x839b5eedL), tole(0x2df3cf7cL), tole(0x043b7b8eL), tole(0xaa53ea1fL),
+tole(0x57aa126aL), tole(0xf9c283fbL), tole(0xd00a3709L), tole(0x7e62a698L),
+tole(0xf088c1a2L), tole(0x5ee05033L), tole(0x7728e4c1L), tole(0xd9407550L),
+tole(0x24b98d25L), tole(0x8ad11cb4L), tole(0xa319a846L), tole(0x0d7139d7L)
+},
+#endif
+};
+
+#endif /* __CRC32TABLE_H */
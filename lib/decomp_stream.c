@@ -0,0 +1,556 @@
+/*
+ * Streaming decompression of images as they are loaded
+ *
+ * Each decompressor writes straight into the caller's buffer, keeping only
+ * what it must between pieces: the zlib window, the LZMA probabilities, or
+ * an LZO block which was split across pieces. Headers are gathered a few
+ * bytes at a time so that the data may be split anywhere.
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <decomp_stream.h>
+#include <errno.h>
+#include <image.h>
+#include <malloc.h>
+#include <u-boot/zlib.h>
+#include <lzma/LzmaTypes.h>
+#include <lzma/LzmaDec.h>
+#include <linux/lzo.h>
+#include <asm/unaligned.h>
+
+/* Longest header gathered in one piece: an lzop header with its file name */
+#define DECOMP_HDR_MAX		320
+
+/* gzip header flags, as in lib/gunzip.c */
+#define GZ_HEAD_CRC		0x02
+#define GZ_EXTRA_FIELD		0x04
+#define GZ_ORIG_NAME		0x08
+#define GZ_COMMENT		0x10
+#define GZ_RESERVED		0xe0
+#define GZ_DEFLATED		8
+
+#define LZMA_HDR_SIZE		(LZMA_PROPS_SIZE + 8)
+
+#define LZOP_MAGIC_SIZE		9
+#define LZOP_HAS_FILTER		0x00000800
+
+/* Where the decompressor is in the stream */
+enum {
+	DS_HEADER,		/* Fixed part of the header */
+	DS_GZ_EXTRA_LEN,	/* gzip: length of the extra field */
+	DS_GZ_EXTRA,		/* gzip: extra field, skipped */
+	DS_GZ_NAME,		/* gzip: file name, skipped */
+	DS_GZ_COMMENT,		/* gzip: comment, skipped */
+	DS_GZ_HCRC,		/* gzip: header CRC, skipped */
+	DS_LZO_BLOCK_LEN,	/* lzo: uncompressed size of the next block */
+	DS_LZO_BLOCK_HDR,	/* lzo: compressed size and checksum */
+	DS_DATA,		/* Compressed data */
+	DS_END,			/* End of the compressed stream */
+};
+
+struct decomp_ctx {
+	int state;
+	int err;
+	uint pos;			/* Number of bytes gathered in hdr[] */
+	uint need;			/* Number of bytes wanted in hdr[] */
+	uchar hdr[DECOMP_HDR_MAX];
+	union {
+		struct {
+			z_stream zs;
+			bool started;	/* inflateInit2() has been called */
+			int flags;	/* Header flags */
+			uint skip;	/* Bytes of extra field left */
+		} gz;
+		struct {
+			CLzmaDec dec;
+			SizeT limit;	/* Output size, or ds->size */
+			bool known;	/* Output size is in the header */
+		} lzma;
+		struct {
+			u16 version;
+			u32 dlen;	/* Uncompressed size of this block */
+			u32 slen;	/* Compressed size of this block */
+			uchar *blk;	/* Block split across pieces */
+			ulong blk_size;
+			ulong have;	/* Bytes of the block in blk */
+		} lzo;
+	} u;
+};
+
+/*
+ * Gather header bytes from *@bufp into ctx->hdr until there are ctx->need
+ * of them. Returns true once they are all there.
+ */
+static bool ds_gather(struct decomp_ctx *ctx, const uchar **bufp,
+		      const uchar *end)
+{
+	ulong n = min((ulong)(end - *bufp), (ulong)(ctx->need - ctx->pos));
+
+	memcpy(ctx->hdr + ctx->pos, *bufp, n);
+	ctx->pos += n;
+	*bufp += n;
+
+	return ctx->pos == ctx->need;
+}
+
+static void ds_expect(struct decomp_ctx *ctx, int state, uint need)
+{
+	ctx->state = state;
+	ctx->pos = 0;
+	ctx->need = need;
+}
+
+#ifdef CONFIG_GZIP
+/* Move on to the next part of the gzip header which is present */
+static void gz_next_part(struct decomp_ctx *ctx)
+{
+	static const u8 part_flag[] = {
+		[DS_GZ_EXTRA_LEN] = GZ_EXTRA_FIELD,
+		[DS_GZ_EXTRA] = GZ_EXTRA_FIELD,
+		[DS_GZ_NAME] = GZ_ORIG_NAME,
+		[DS_GZ_COMMENT] = GZ_COMMENT,
+		[DS_GZ_HCRC] = GZ_HEAD_CRC,
+	};
+	int state = ctx->state;
+
+	do {
+		state++;
+	} while (state <= DS_GZ_HCRC && !(ctx->u.gz.flags & part_flag[state]));
+
+	if (state > DS_GZ_HCRC)
+		state = DS_DATA;
+	ds_expect(ctx, state,
+		  state == DS_GZ_EXTRA_LEN || state == DS_GZ_HCRC ? 2 : 0);
+}
+
+static int gz_update(struct decomp_stream *ds, struct decomp_ctx *ctx,
+		     const uchar *buf, const uchar *end)
+{
+	z_stream *zs = &ctx->u.gz.zs;
+	ulong n;
+	int r;
+
+	while (buf < end && ctx->state != DS_DATA) {
+		switch (ctx->state) {
+		case DS_HEADER:
+			if (!ds_gather(ctx, &buf, end))
+				return 0;
+			if (ctx->hdr[0] != 0x1f || ctx->hdr[1] != 0x8b ||
+			    ctx->hdr[2] != GZ_DEFLATED ||
+			    (ctx->hdr[3] & GZ_RESERVED))
+				return -EINVAL;
+			ctx->u.gz.flags = ctx->hdr[3];
+			break;
+		case DS_GZ_EXTRA_LEN:
+			if (!ds_gather(ctx, &buf, end))
+				return 0;
+			ctx->u.gz.skip = get_unaligned_le16(ctx->hdr);
+			ctx->state = DS_GZ_EXTRA;
+			continue;
+		case DS_GZ_EXTRA:
+			n = min((ulong)(end - buf), (ulong)ctx->u.gz.skip);
+			buf += n;
+			ctx->u.gz.skip -= n;
+			if (ctx->u.gz.skip)
+				return 0;
+			break;
+		case DS_GZ_NAME:
+		case DS_GZ_COMMENT:
+			if (*buf++)
+				continue;
+			break;
+		case DS_GZ_HCRC:
+			if (!ds_gather(ctx, &buf, end))
+				return 0;
+			break;
+		}
+		gz_next_part(ctx);
+	}
+	if (ctx->state != DS_DATA || buf == end)
+		return 0;
+
+	zs->next_in = (uchar *)buf;
+	zs->avail_in = end - buf;
+	do {
+		r = inflate(zs, Z_NO_FLUSH);
+	} while (r == Z_OK && zs->avail_in);
+	ds->len = zs->next_out - ds->dst;
+
+	if (r == Z_STREAM_END) {
+		/* The CRC and length which follow are not checked */
+		ctx->state = DS_END;
+		return 0;
+	}
+	if (r == Z_BUF_ERROR && !zs->avail_out)
+		return -ENOSPC;
+	if (r != Z_OK) {
+		debug("%s: inflate() returned %d\n", __func__, r);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+#endif
+
+#ifdef CONFIG_LZMA
+static void *lzma_alloc(void *p, size_t size)
+{
+	return malloc(size);
+}
+
+static void lzma_free(void *p, void *address)
+{
+	free(address);
+}
+
+static ISzAlloc lzma_allocator = { lzma_alloc, lzma_free };
+
+static int lzma_start(struct decomp_stream *ds, struct decomp_ctx *ctx)
+{
+	CLzmaDec *dec = &ctx->u.lzma.dec;
+	u32 size_lo, size_hi;
+	SRes res;
+
+	size_lo = get_unaligned_le32(ctx->hdr + LZMA_PROPS_SIZE);
+	size_hi = get_unaligned_le32(ctx->hdr + LZMA_PROPS_SIZE + 4);
+	ctx->u.lzma.known = size_lo != 0xffffffff || size_hi != 0xffffffff;
+	ctx->u.lzma.limit = ds->size;
+	if (ctx->u.lzma.known) {
+		if (size_hi || size_lo > ds->size)
+			return -ENOSPC;
+		ctx->u.lzma.limit = size_lo;
+	}
+
+	LzmaDec_Construct(dec);
+	res = LzmaDec_AllocateProbs(dec, ctx->hdr, LZMA_PROPS_SIZE,
+				    &lzma_allocator);
+	if (res != SZ_OK)
+		return res == SZ_ERROR_MEM ? -ENOMEM : -EINVAL;
+	dec->dic = ds->dst;
+	dec->dicBufSize = ds->size;
+	LzmaDec_Init(dec);
+	ctx->state = DS_DATA;
+
+	return 0;
+}
+
+static int lzma_update(struct decomp_stream *ds, struct decomp_ctx *ctx,
+		       const uchar *buf, const uchar *end)
+{
+	CLzmaDec *dec = &ctx->u.lzma.dec;
+	ELzmaStatus status;
+	SizeT len;
+	SRes res;
+	int ret;
+
+	if (ctx->state == DS_HEADER) {
+		if (!ds_gather(ctx, &buf, end))
+			return 0;
+		ret = lzma_start(ds, ctx);
+		if (ret)
+			return ret;
+	}
+
+	/*
+	 * The stream must end at the limit, so that an end mark there is
+	 * read even though there is no more room for output
+	 */
+	len = end - buf;
+	res = LzmaDec_DecodeToDic(dec, ctx->u.lzma.limit, buf, &len,
+				  LZMA_FINISH_END, &status);
+	ds->len = dec->dicPos;
+	if (res != SZ_OK)
+		return dec->dicPos == ds->size ? -ENOSPC : -EINVAL;
+	if (status == LZMA_STATUS_FINISHED_WITH_MARK ||
+	    (ctx->u.lzma.known && dec->dicPos == ctx->u.lzma.limit))
+		ctx->state = DS_END;
+
+	return 0;
+}
+#endif
+
+#ifdef CONFIG_LZO
+static const uchar lzop_magic[LZOP_MAGIC_SIZE] = {
+	0x89, 0x4c, 0x5a, 0x4f, 0x00, 0x0d, 0x0a, 0x1a, 0x0a
+};
+
+/*
+ * Work out how long the lzop header is from what has been gathered so
+ * far, following the layout used by lzop_decompress(). Returns the total
+ * length, which is ctx->need once the whole header is there.
+ */
+static int lzop_header_len(struct decomp_ctx *ctx)
+{
+	const uchar *hdr = ctx->hdr;
+	bool new_format;
+	uint len;
+
+	/* Magic, version, library version, version needed and method */
+	len = LZOP_MAGIC_SIZE + 7;
+	if (ctx->pos < len)
+		return len;
+	if (memcmp(hdr, lzop_magic, LZOP_MAGIC_SIZE))
+		return -EINVAL;
+	ctx->u.lzo.version = get_unaligned_be16(hdr + LZOP_MAGIC_SIZE);
+	new_format = ctx->u.lzo.version >= 0x0940;
+
+	/* Level, then flags */
+	len += (new_format ? 1 : 0) + 4;
+	if (ctx->pos < len)
+		return len;
+	if (get_unaligned_be32(hdr + len - 4) & LZOP_HAS_FILTER)
+		len += 4;
+
+	/* Mode, modification time and the length of the file name */
+	len += 8 + (new_format ? 4 : 0) + 1;
+	if (ctx->pos < len)
+		return len;
+
+	/* File name and header checksum */
+	return len + hdr[len - 1] + 4;
+}
+
+static int lzo_block(struct decomp_stream *ds, struct decomp_ctx *ctx,
+		     const uchar *src)
+{
+	size_t len = ctx->u.lzo.dlen;
+	int r;
+
+	if (ctx->u.lzo.slen == ctx->u.lzo.dlen) {
+		/* Stored as it is, since it would not compress */
+		memcpy(ds->dst + ds->len, src, len);
+	} else {
+		r = lzo1x_decompress_safe(src, ctx->u.lzo.slen,
+					  ds->dst + ds->len, &len);
+		if (r != LZO_E_OK || len != ctx->u.lzo.dlen)
+			return -EINVAL;
+	}
+	ds->len += len;
+	ds_expect(ctx, DS_LZO_BLOCK_LEN, 4);
+
+	return 0;
+}
+
+static int lzo_update(struct decomp_stream *ds, struct decomp_ctx *ctx,
+		      const uchar *buf, const uchar *end)
+{
+	ulong n;
+	int len;
+
+	while (buf < end && ctx->state != DS_END) {
+		switch (ctx->state) {
+		case DS_HEADER:
+			if (!ds_gather(ctx, &buf, end))
+				return 0;
+			len = lzop_header_len(ctx);
+			if (len < 0)
+				return len;
+			if (len > DECOMP_HDR_MAX)
+				return -EINVAL;
+			if (len != ctx->need)
+				ctx->need = len;
+			else
+				ds_expect(ctx, DS_LZO_BLOCK_LEN, 4);
+			break;
+		case DS_LZO_BLOCK_LEN:
+			if (!ds_gather(ctx, &buf, end))
+				return 0;
+			ctx->u.lzo.dlen = get_unaligned_be32(ctx->hdr);
+			if (!ctx->u.lzo.dlen)
+				ctx->state = DS_END;
+			else
+				ds_expect(ctx, DS_LZO_BLOCK_HDR, 8);
+			break;
+		case DS_LZO_BLOCK_HDR:
+			if (!ds_gather(ctx, &buf, end))
+				return 0;
+			/* The block checksum is not checked */
+			ctx->u.lzo.slen = get_unaligned_be32(ctx->hdr);
+			if (!ctx->u.lzo.slen ||
+			    ctx->u.lzo.slen > ctx->u.lzo.dlen)
+				return -EINVAL;
+			if (ctx->u.lzo.dlen > ds->size - ds->len)
+				return -ENOSPC;
+			ctx->u.lzo.have = 0;
+			ctx->state = DS_DATA;
+			break;
+		case DS_DATA:
+			/* Use the block where it is if it is all here */
+			if (!ctx->u.lzo.have &&
+			    (ulong)(end - buf) >= ctx->u.lzo.slen) {
+				if (lzo_block(ds, ctx, buf))
+					return -EINVAL;
+				buf += ctx->u.lzo.slen;
+				break;
+			}
+			if (ctx->u.lzo.blk_size < ctx->u.lzo.slen) {
+				free(ctx->u.lzo.blk);
+				ctx->u.lzo.blk = malloc(ctx->u.lzo.slen);
+				if (!ctx->u.lzo.blk) {
+					ctx->u.lzo.blk_size = 0;
+					return -ENOMEM;
+				}
+				ctx->u.lzo.blk_size = ctx->u.lzo.slen;
+			}
+			n = min((ulong)(end - buf),
+				ctx->u.lzo.slen - ctx->u.lzo.have);
+			memcpy(ctx->u.lzo.blk + ctx->u.lzo.have, buf, n);
+			buf += n;
+			ctx->u.lzo.have += n;
+			if (ctx->u.lzo.have == ctx->u.lzo.slen &&
+			    lzo_block(ds, ctx, ctx->u.lzo.blk))
+				return -EINVAL;
+			break;
+		}
+	}
+
+	return 0;
+}
+#endif
+
+int decomp_stream_start(struct decomp_stream *ds, int comp, void *dst,
+			ulong size)
+{
+	struct decomp_ctx *ctx;
+
+	switch (comp) {
+	case IH_COMP_NONE:
+#ifdef CONFIG_GZIP
+	case IH_COMP_GZIP:
+#endif
+#ifdef CONFIG_LZMA
+	case IH_COMP_LZMA:
+#endif
+#ifdef CONFIG_LZO
+	case IH_COMP_LZO:
+#endif
+		break;
+	default:
+		return -EPROTONOSUPPORT;
+	}
+
+	ctx = calloc(1, sizeof(*ctx));
+	if (!ctx)
+		return -ENOMEM;
+	ds->comp = comp;
+	ds->ctx = ctx;
+	ds->dst = dst;
+	ds->size = size;
+	ds->len = 0;
+
+	switch (comp) {
+	case IH_COMP_NONE:
+		ctx->state = DS_DATA;
+		break;
+#ifdef CONFIG_GZIP
+	case IH_COMP_GZIP:
+		ds_expect(ctx, DS_HEADER, 10);
+		ctx->u.gz.zs.zalloc = gzalloc;
+		ctx->u.gz.zs.zfree = gzfree;
+		if (inflateInit2(&ctx->u.gz.zs, -MAX_WBITS) != Z_OK) {
+			free(ctx);
+			ds->ctx = NULL;
+			return -ENOMEM;
+		}
+		ctx->u.gz.started = true;
+		ctx->u.gz.zs.next_out = ds->dst;
+		ctx->u.gz.zs.avail_out = size;
+		break;
+#endif
+#ifdef CONFIG_LZMA
+	case IH_COMP_LZMA:
+		ds_expect(ctx, DS_HEADER, LZMA_HDR_SIZE);
+		break;
+#endif
+#ifdef CONFIG_LZO
+	case IH_COMP_LZO:
+		ds_expect(ctx, DS_HEADER, LZOP_MAGIC_SIZE + 7);
+		break;
+#endif
+	}
+
+	return 0;
+}
+
+int decomp_stream_update(struct decomp_stream *ds, const void *buf,
+			 ulong size)
+{
+	struct decomp_ctx *ctx = ds->ctx;
+	const uchar *end = (const uchar *)buf + size;
+	ulong n;
+	int ret = 0;
+
+	if (!ctx)
+		return -EINVAL;
+	if (ctx->err)
+		return ctx->err;
+	if (ctx->state == DS_END || !size)
+		return 0;
+
+	switch (ds->comp) {
+	case IH_COMP_NONE:
+		n = min(size, ds->size - ds->len);
+		memcpy(ds->dst + ds->len, buf, n);
+		ds->len += n;
+		if (n != size)
+			ret = -ENOSPC;
+		break;
+#ifdef CONFIG_GZIP
+	case IH_COMP_GZIP:
+		ret = gz_update(ds, ctx, buf, end);
+		break;
+#endif
+#ifdef CONFIG_LZMA
+	case IH_COMP_LZMA:
+		ret = lzma_update(ds, ctx, buf, end);
+		break;
+#endif
+#ifdef CONFIG_LZO
+	case IH_COMP_LZO:
+		ret = lzo_update(ds, ctx, buf, end);
+		break;
+#endif
+	}
+	ctx->err = ret;
+
+	return ret;
+}
+
+int decomp_stream_finish(struct decomp_stream *ds, ulong *lenp)
+{
+	struct decomp_ctx *ctx = ds->ctx;
+	int ret;
+
+	if (!ctx)
+		return -EINVAL;
+	ret = ctx->err;
+	if (!ret && ds->comp != IH_COMP_NONE && ctx->state != DS_END)
+		ret = ds->len == ds->size ? -ENOSPC : -EIO;
+
+	switch (ds->comp) {
+#ifdef CONFIG_GZIP
+	case IH_COMP_GZIP:
+		if (ctx->u.gz.started)
+			inflateEnd(&ctx->u.gz.zs);
+		break;
+#endif
+#ifdef CONFIG_LZMA
+	case IH_COMP_LZMA:
+		LzmaDec_FreeProbs(&ctx->u.lzma.dec, &lzma_allocator);
+		break;
+#endif
+#ifdef CONFIG_LZO
+	case IH_COMP_LZO:
+		free(ctx->u.lzo.blk);
+		break;
+#endif
+	}
+	free(ctx);
+	ds->ctx = NULL;
+	if (lenp)
+		*lenp = ds->len;
+
+	return ret;
+}
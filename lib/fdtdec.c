@@ -9,8 +9,10 @@
 #include <serial.h>
 #include <libfdt.h>
 #include <fdtdec.h>
+#include <malloc.h>
 #include <asm/sections.h>
 #include <linux/ctype.h>
+#include <linux/err.h>
 
 DECLARE_GLOBAL_DATA_PTR;
 
@@ -78,6 +80,443 @@ static const char * const compat_names[COMPAT_COUNT] = {
 	COMPAT(COMPAT_INTEL_IRQ_ROUTER, "intel,irq-router"),
 };
 
+/* Get the number at the end of an alias name, e.g. 3 for "i2c3" */
+static int fdtdec_alias_number(const char *name, int *seqp)
+{
+	const char *p;
+
+	for (p = name + strlen(name) - 1; p > name; p--) {
+		if (!isdigit(*p)) {
+			*seqp = simple_strtoul(p + 1, NULL, 10);
+			debug("Found seq %d\n", *seqp);
+			return 0;
+		}
+	}
+
+	return -ENOENT;
+}
+
+#ifdef CONFIG_OF_INDEX
+/*
+ * An index of the control FDT, so that finding a node by phandle,
+ * compatible string or alias does not need a scan of the whole tree. It is
+ * built by fdtdec_prepare_fdt(), or on first use, and built again when
+ * nodes or properties have been added or removed.
+ *
+ * @blob:		FDT which this indexes
+ * @size_dt_struct:	Size of the structure block when this was built
+ * @size_dt_strings:	Size of the strings block when this was built
+ * @flags:		GD_FLG_RELOC and GD_FLG_FULL_MALLOC_INIT when this was
+ *			built. It came from the full malloc() if the latter is
+ *			set. An index from before relocation is not used after.
+ * @compats:		Each compatible string of each node, ordered by the
+ *			hash of the string and then by node offset
+ * @aliases:		Each property in /aliases, in order, with the node
+ *			it names or 0 if none
+ * @phandles:		Each node with a phandle, ordered by phandle
+ * @alias_by_node:	Indexes into @aliases of those giving the full path
+ *			of a node, ordered by node offset and then position
+ */
+struct fdtdec_index {
+	const void *blob;
+	uint32_t size_dt_struct;
+	uint32_t size_dt_strings;
+	ulong flags;
+	int compat_count;
+	int alias_count;
+	int phandle_count;
+	int alias_node_count;
+	struct fdtdec_index_compat {
+		uint32_t hash;
+		int node;
+		const char *str;
+	} *compats;
+	struct fdtdec_index_alias {
+		const char *name;
+		const char *path;
+		int node;
+	} *aliases;
+	struct fdtdec_index_phandle {
+		uint32_t phandle;
+		int node;
+	} *phandles;
+	int *alias_by_node;
+};
+
+/* Deepest node and longest path which aliases are matched against */
+#define FDTDEC_INDEX_DEPTH	16
+#define FDTDEC_INDEX_PATH	256
+
+#define FDTDEC_INDEX_FLAGS	(GD_FLG_RELOC | GD_FLG_FULL_MALLOC_INIT)
+
+/* FNV-1a, which is quick and spreads similar strings well */
+static uint32_t fdtdec_index_hash(const char *str)
+{
+	uint32_t hash = 2166136261U;
+
+	while (*str)
+		hash = (hash ^ (uchar)*str++) * 16777619;
+
+	return hash;
+}
+
+static int fdtdec_index_cmp_compat(const void *a, const void *b)
+{
+	const struct fdtdec_index_compat *ca = a, *cb = b;
+
+	if (ca->hash != cb->hash)
+		return ca->hash < cb->hash ? -1 : 1;
+
+	return ca->node - cb->node;
+}
+
+static int fdtdec_index_cmp_phandle(const void *a, const void *b)
+{
+	const struct fdtdec_index_phandle *pa = a, *pb = b;
+
+	if (pa->phandle != pb->phandle)
+		return pa->phandle < pb->phandle ? -1 : 1;
+
+	return pa->node - pb->node;
+}
+
+/* Sorting alias_by_node needs the aliases, which qsort() cannot pass on */
+static struct fdtdec_index_alias *fdtdec_index_sorting;
+
+static int fdtdec_index_cmp_path(const void *a, const void *b)
+{
+	int ia = *(const int *)a, ib = *(const int *)b;
+
+	return strcmp(fdtdec_index_sorting[ia].path,
+		      fdtdec_index_sorting[ib].path);
+}
+
+/*
+ * Set the node for the aliases giving @path. @by_path holds the indexes of
+ * all the aliases, ordered by path.
+ */
+static void fdtdec_index_resolve(struct fdtdec_index *idx, int *by_path,
+				 const char *path, int node)
+{
+	int lo = 0, hi = idx->alias_count;
+	struct fdtdec_index_alias *alias;
+	int mid;
+
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (strcmp(idx->aliases[by_path[mid]].path, path) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	for (; lo < idx->alias_count; lo++) {
+		alias = &idx->aliases[by_path[lo]];
+		if (strcmp(alias->path, path))
+			break;
+		if (!alias->node)
+			alias->node = node;
+	}
+}
+
+static int fdtdec_index_cmp_alias(const void *a, const void *b)
+{
+	int ia = *(const int *)a, ib = *(const int *)b;
+	int na = fdtdec_index_sorting[ia].node;
+	int nb = fdtdec_index_sorting[ib].node;
+
+	return na != nb ? na - nb : ia - ib;
+}
+
+static struct fdtdec_index *fdtdec_index_build(const void *blob)
+{
+	int compats = 0, aliases = 0, phandles = 0;
+	struct fdtdec_index *idx;
+	int alias_node, node, offset, len;
+	int path_end[FDTDEC_INDEX_DEPTH];
+	char path[FDTDEC_INDEX_PATH];
+	const char *str, *end;
+	int depth, pos, i;
+	char *ptr;
+
+	/* Count everything first, so that the index is one allocation */
+	for (node = 0; node >= 0; node = fdt_next_node(blob, node, NULL)) {
+		if (fdt_get_phandle(blob, node))
+			phandles++;
+		str = fdt_getprop(blob, node, "compatible", &len);
+		for (end = str + len; str && str < end; str += strlen(str) + 1)
+			compats++;
+	}
+	alias_node = fdt_path_offset(blob, "/aliases");
+	for (offset = fdt_first_property_offset(blob, alias_node);
+	     offset >= 0;
+	     offset = fdt_next_property_offset(blob, offset))
+		aliases++;
+
+	idx = malloc(sizeof(*idx) + compats * sizeof(*idx->compats) +
+		     aliases * sizeof(*idx->aliases) +
+		     phandles * sizeof(*idx->phandles) +
+		     aliases * sizeof(*idx->alias_by_node));
+	if (!idx)
+		return ERR_PTR(-ENOMEM);
+	idx->blob = blob;
+	idx->size_dt_struct = fdt_size_dt_struct(blob);
+	idx->size_dt_strings = fdt_size_dt_strings(blob);
+	idx->flags = gd->flags & FDTDEC_INDEX_FLAGS;
+	ptr = (char *)(idx + 1);
+	idx->compats = (void *)ptr;
+	ptr += compats * sizeof(*idx->compats);
+	idx->aliases = (void *)ptr;
+	ptr += aliases * sizeof(*idx->aliases);
+	idx->phandles = (void *)ptr;
+	ptr += phandles * sizeof(*idx->phandles);
+	idx->alias_by_node = (void *)ptr;
+
+	/*
+	 * Collect the aliases, with their paths in order, so that they can be
+	 * resolved while walking the tree rather than by a search each
+	 */
+	idx->alias_count = 0;
+	for (offset = fdt_first_property_offset(blob, alias_node);
+	     offset >= 0;
+	     offset = fdt_next_property_offset(blob, offset)) {
+		struct fdtdec_index_alias *alias;
+
+		alias = &idx->aliases[idx->alias_count];
+		str = fdt_getprop_by_offset(blob, offset, &alias->name, &len);
+		alias->path = len > 0 && !str[len - 1] ? str : "";
+		alias->node = 0;
+		idx->alias_by_node[idx->alias_count] = idx->alias_count;
+		idx->alias_count++;
+	}
+	fdtdec_index_sorting = idx->aliases;
+	qsort(idx->alias_by_node, idx->alias_count,
+	      sizeof(*idx->alias_by_node), fdtdec_index_cmp_path);
+
+	idx->compat_count = 0;
+	idx->phandle_count = 0;
+	depth = 0;
+	for (node = 0; node >= 0; node = fdt_next_node(blob, node, &depth)) {
+		struct fdtdec_index_phandle *ph;
+		struct fdtdec_index_compat *compat;
+		uint32_t phandle;
+
+		phandle = fdt_get_phandle(blob, node);
+		if (phandle) {
+			ph = &idx->phandles[idx->phandle_count++];
+			ph->phandle = phandle;
+			ph->node = node;
+		}
+		str = fdt_getprop(blob, node, "compatible", &len);
+		for (end = str + len; str && str < end;
+		     str += strlen(str) + 1) {
+			compat = &idx->compats[idx->compat_count++];
+			compat->hash = fdtdec_index_hash(str);
+			compat->node = node;
+			compat->str = str;
+		}
+
+		/* Track the path of the node, giving up if it is too long */
+		if (!depth || depth >= ARRAY_SIZE(path_end))
+			continue;
+		pos = depth == 1 ? 0 : path_end[depth - 1];
+		str = fdt_get_name(blob, node, &len);
+		if (!str || pos + len + 2 > sizeof(path)) {
+			path_end[depth] = sizeof(path);
+			continue;
+		}
+		path[pos] = '/';
+		memcpy(path + pos + 1, str, len);
+		path_end[depth] = pos + len + 1;
+		path[path_end[depth]] = '\0';
+		if (idx->alias_count)
+			fdtdec_index_resolve(idx, idx->alias_by_node, path,
+					     node);
+	}
+
+	/*
+	 * Anything else, such as a path without unit addresses, is left to
+	 * libfdt. Only aliases which give the full path of a node can provide
+	 * a sequence number, as in fdtdec_get_alias_seq().
+	 */
+	idx->alias_node_count = 0;
+	for (i = 0; i < idx->alias_count; i++) {
+		struct fdtdec_index_alias *alias = &idx->aliases[i];
+
+		if (!alias->node && *alias->path)
+			alias->node = max(fdt_path_offset(blob, alias->path),
+					  0);
+		if (alias->node && *alias->path == '/')
+			idx->alias_by_node[idx->alias_node_count++] = i;
+	}
+
+	qsort(idx->compats, idx->compat_count, sizeof(*idx->compats),
+	      fdtdec_index_cmp_compat);
+	qsort(idx->phandles, idx->phandle_count, sizeof(*idx->phandles),
+	      fdtdec_index_cmp_phandle);
+	qsort(idx->alias_by_node, idx->alias_node_count,
+	      sizeof(*idx->alias_by_node), fdtdec_index_cmp_alias);
+	debug("%s: %d compatible strings, %d aliases, %d phandles\n",
+	      __func__, idx->compat_count, idx->alias_count,
+	      idx->phandle_count);
+
+	return idx;
+}
+
+void fdtdec_index_invalidate(void)
+{
+	struct fdtdec_index *idx = gd->fdt_index;
+
+	if (idx && !IS_ERR(idx) && (idx->flags & GD_FLG_FULL_MALLOC_INIT))
+		free(idx);
+	gd->fdt_index = NULL;
+}
+
+/*
+ * Get the index for @blob, building it if needed. Only the control FDT is
+ * indexed. If the index cannot be built, lookups scan the tree until the
+ * index is invalidated.
+ */
+static struct fdtdec_index *fdtdec_index_get(const void *blob)
+{
+	struct fdtdec_index *idx = gd->fdt_index;
+
+	if (!blob || blob != gd->fdt_blob || IS_ERR(idx))
+		return NULL;
+	if (idx && idx->blob == blob &&
+	    idx->size_dt_struct == fdt_size_dt_struct(blob) &&
+	    idx->size_dt_strings == fdt_size_dt_strings(blob) &&
+	    idx->flags == (gd->flags & FDTDEC_INDEX_FLAGS))
+		return idx;
+
+	fdtdec_index_invalidate();
+	/*
+	 * Use the early malloc() before relocation, if there is one, but not
+	 * between relocation and full malloc() being ready
+	 */
+	if (!(gd->flags & GD_FLG_FULL_MALLOC_INIT)) {
+#ifdef CONFIG_SYS_MALLOC_F_LEN
+		if (gd->flags & GD_FLG_RELOC)
+			return NULL;
+#else
+		return NULL;
+#endif
+	}
+	gd->fdt_index = fdtdec_index_build(blob);
+
+	return IS_ERR(gd->fdt_index) ? NULL : gd->fdt_index;
+}
+
+static int fdtdec_index_next_compatible(struct fdtdec_index *idx, int node,
+					const char *compat)
+{
+	uint32_t hash = fdtdec_index_hash(compat);
+	struct fdtdec_index_compat *entry;
+	int lo = 0, hi = idx->compat_count;
+	int mid;
+
+	/* Find the first entry with this hash for a node after @node */
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		entry = &idx->compats[mid];
+		if (entry->hash < hash ||
+		    (entry->hash == hash && entry->node <= node))
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	for (entry = &idx->compats[lo];
+	     entry < idx->compats + idx->compat_count && entry->hash == hash;
+	     entry++) {
+		if (!strcmp(entry->str, compat))
+			return entry->node;
+	}
+
+	return -FDT_ERR_NOTFOUND;
+}
+
+static int fdtdec_index_phandle(struct fdtdec_index *idx, uint32_t phandle)
+{
+	int lo = 0, hi = idx->phandle_count;
+	int mid;
+
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (idx->phandles[mid].phandle < phandle)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if (lo < idx->phandle_count && idx->phandles[lo].phandle == phandle)
+		return idx->phandles[lo].node;
+
+	return -FDT_ERR_NOTFOUND;
+}
+
+/* Get the position in alias_by_node of the first alias naming @node */
+static int fdtdec_index_alias_by_node(struct fdtdec_index *idx, int node)
+{
+	int lo = 0, hi = idx->alias_node_count;
+	int mid;
+
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (idx->aliases[idx->alias_by_node[mid]].node < node)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+static int fdtdec_index_alias_seq(struct fdtdec_index *idx, const char *base,
+				  int offset, int *seqp)
+{
+	struct fdtdec_index_alias *alias;
+	int base_len = strlen(base);
+	int pos;
+
+	for (pos = fdtdec_index_alias_by_node(idx, offset);
+	     pos < idx->alias_node_count; pos++) {
+		alias = &idx->aliases[idx->alias_by_node[pos]];
+		if (alias->node != offset)
+			break;
+		if (!strncmp(alias->name, base, base_len) &&
+		    !fdtdec_alias_number(alias->name, seqp))
+			return 0;
+	}
+	debug("Not found\n");
+
+	return -ENOENT;
+}
+#else
+struct fdtdec_index;
+
+static inline struct fdtdec_index *fdtdec_index_get(const void *blob)
+{
+	return NULL;
+}
+
+static inline int fdtdec_index_alias_seq(struct fdtdec_index *idx,
+					 const char *base, int offset,
+					 int *seqp)
+{
+	return -ENOSYS;
+}
+#endif
+
+/* Like fdt_node_offset_by_phandle(), but using the index if there is one */
+static int fdtdec_node_offset_by_phandle(const void *blob, uint32_t phandle)
+{
+#ifdef CONFIG_OF_INDEX
+	struct fdtdec_index *idx = fdtdec_index_get(blob);
+
+	if (idx && phandle && phandle != -1)
+		return fdtdec_index_phandle(idx, phandle);
+#endif
+	return fdt_node_offset_by_phandle(blob, phandle);
+}
+
 const char *fdtdec_get_compatible(enum fdt_compat_id id)
 {
 	/* We allow reading of the 'unknown' ID for testing purposes */
@@ -323,6 +762,13 @@ enum fdt_compat_id fdtdec_lookup(const void *blob, int node)
 int fdtdec_next_compatible(const void *blob, int node,
 		enum fdt_compat_id id)
 {
+#ifdef CONFIG_OF_INDEX
+	struct fdtdec_index *idx = fdtdec_index_get(blob);
+
+	if (idx)
+		return fdtdec_index_next_compatible(idx, node,
+						    compat_names[id]);
+#endif
 	return fdt_node_offset_by_compatible(blob, node, compat_names[id]);
 }
 
@@ -371,20 +817,57 @@ int fdtdec_find_aliases_for_id(const void *blob, const char *name,
 	return fdtdec_add_aliases_for_id(blob, name, id, node_list, maxcount);
 }
 
+/*
+ * Step through the aliases whose names start with @name, using the index
+ * if there is one. @posp is -1 to start with. This returns the node which
+ * the next alias names, 0 if it names none, or -FDT_ERR_NOTFOUND at the
+ * end. @pathp returns the name of the alias.
+ */
+static int fdtdec_next_alias_node(const void *blob, struct fdtdec_index *idx,
+				  int alias_node, const char *name,
+				  int name_len, int *posp, const char **pathp)
+{
+	const struct fdt_property *prop;
+
+#ifdef CONFIG_OF_INDEX
+	if (idx) {
+		while (++*posp < idx->alias_count) {
+			*pathp = idx->aliases[*posp].name;
+			if (!strncmp(*pathp, name, name_len))
+				return max(idx->aliases[*posp].node, 0);
+		}
+		return -FDT_ERR_NOTFOUND;
+	}
+#endif
+	for (*posp = *posp < 0 ? fdt_first_property_offset(blob, alias_node) :
+			fdt_next_property_offset(blob, *posp);
+	     *posp > 0;
+	     *posp = fdt_next_property_offset(blob, *posp)) {
+		prop = fdt_get_property_by_offset(blob, *posp, NULL);
+		*pathp = fdt_string(blob, fdt32_to_cpu(prop->nameoff));
+		if (prop->len && 0 == strncmp(*pathp, name, name_len))
+			return max(fdt_path_offset(blob, prop->data), 0);
+	}
+
+	return -FDT_ERR_NOTFOUND;
+}
+
 /* TODO: Can we tighten this code up a little? */
 int fdtdec_add_aliases_for_id(const void *blob, const char *name,
 			enum fdt_compat_id id, int *node_list, int maxcount)
 {
+	struct fdtdec_index *idx = fdtdec_index_get(blob);
 	int name_len = strlen(name);
 	int nodes[maxcount];
 	int num_found = 0;
 	int offset, node;
 	int alias_node;
+	const char *path;
 	int count;
 	int i, j;
 
 	/* find the alias node if present */
-	alias_node = fdt_path_offset(blob, "/aliases");
+	alias_node = idx ? 0 : fdt_path_offset(blob, "/aliases");
 
 	/*
 	 * start with nothing, and we can assume that the root node can't
@@ -403,20 +886,13 @@ int fdtdec_add_aliases_for_id(const void *blob, const char *name,
 		       __func__, name);
 
 	/* Now find all the aliases */
-	for (offset = fdt_first_property_offset(blob, alias_node);
-			offset > 0;
-			offset = fdt_next_property_offset(blob, offset)) {
-		const struct fdt_property *prop;
-		const char *path;
+	for (offset = -1;
+	     (node = fdtdec_next_alias_node(blob, idx, alias_node, name,
+					    name_len, &offset, &path)) >= 0;) {
 		int number;
 		int found;
 
-		node = 0;
-		prop = fdt_get_property_by_offset(blob, offset, NULL);
-		path = fdt_string(blob, fdt32_to_cpu(prop->nameoff));
-		if (prop->len && 0 == strncmp(path, name, name_len))
-			node = fdt_path_offset(blob, prop->data);
-		if (node <= 0)
+		if (!node)
 			continue;
 
 		/* Get the alias number */
@@ -489,6 +965,7 @@ int fdtdec_add_aliases_for_id(const void *blob, const char *name,
 int fdtdec_get_alias_seq(const void *blob, const char *base, int offset,
 			 int *seqp)
 {
+	struct fdtdec_index *idx = fdtdec_index_get(blob);
 	int base_len = strlen(base);
 	const char *find_name;
 	int find_namelen;
@@ -497,6 +974,8 @@ int fdtdec_get_alias_seq(const void *blob, const char *base, int offset,
 
 	find_name = fdt_get_name(blob, offset, &find_namelen);
 	debug("Looking for '%s' at %d, name %s\n", base, offset, find_name);
+	if (idx)
+		return fdtdec_index_alias_seq(idx, base, offset, seqp);
 
 	aliases = fdt_path_offset(blob, "/aliases");
 	for (prop_offset = fdt_first_property_offset(blob, aliases);
@@ -505,7 +984,6 @@ int fdtdec_get_alias_seq(const void *blob, const char *base, int offset,
 		const char *prop;
 		const char *name;
 		const char *slash;
-		const char *p;
 		int len;
 
 		prop = fdt_getprop_by_offset(blob, prop_offset, &name, &len);
@@ -517,13 +995,8 @@ int fdtdec_get_alias_seq(const void *blob, const char *base, int offset,
 		slash = strrchr(prop, '/');
 		if (strcmp(slash + 1, find_name))
 			continue;
-		for (p = name + strlen(name) - 1; p > name; p--) {
-			if (!isdigit(*p)) {
-				*seqp = simple_strtoul(p + 1, NULL, 10);
-				debug("Found seq %d\n", *seqp);
-				return 0;
-			}
-		}
+		if (!fdtdec_alias_number(name, seqp))
+			return 0;
 	}
 
 	debug("Not found\n");
@@ -573,6 +1046,10 @@ int fdtdec_prepare_fdt(void)
 #endif
 		return -1;
 	}
+#ifdef CONFIG_OF_INDEX
+	/* Build the index now, while there are no other demands on malloc() */
+	fdtdec_index_get(gd->fdt_blob);
+#endif
 	return 0;
 }
 
@@ -586,7 +1063,7 @@ int fdtdec_lookup_phandle(const void *blob, int node, const char *prop_name)
 	if (!phandle)
 		return -FDT_ERR_NOTFOUND;
 
-	lookup = fdt_node_offset_by_phandle(blob, fdt32_to_cpu(*phandle));
+	lookup = fdtdec_node_offset_by_phandle(blob, fdt32_to_cpu(*phandle));
 	return lookup;
 }
 
@@ -714,8 +1191,8 @@ int fdtdec_parse_phandle_with_args(const void *blob, int src_node,
 			 * below.
 			 */
 			if (cells_name || cur_index == index) {
-				node = fdt_node_offset_by_phandle(blob,
-								  phandle);
+				node = fdtdec_node_offset_by_phandle(blob,
+								     phandle);
 				if (!node) {
 					debug("%s: could not find phandle\n",
 					      fdt_get_name(blob, src_node,
@@ -62,10 +62,203 @@ typedef struct _ENTRY {
 	ENTRY entry;
 } _ENTRY;
 
+/*
+ * An entry's data either points into a blob, which holds a copy of the
+ * data passed to himport_r(), or was allocated with strdup() when set.
+ * This saves a copy of each value on import, which is most of the size
+ * of the environment.
+ */
+struct htab_blob {
+	struct htab_blob *next;
+	unsigned int refs;	/* entries using the blob, and the importer */
+	size_t size;
+	char data[];
+};
+
+/*
+ * Arena holding the keys. A key stays there after its entry is deleted,
+ * and is used again if the same variable is set again. When the arena is
+ * full and at least half of it is keys of deleted entries, the keys in use
+ * are moved to a new block rather than adding one.
+ */
+#define HTAB_KEYS_SIZE	1024
+
+struct htab_keys {
+	struct htab_keys *next;
+	unsigned int used;
+	unsigned int size;
+	char buf[];
+};
 
 static void _hdelete(const char *key, struct hsearch_data *htab, ENTRY *ep,
 	int idx);
 
+/*
+ * Copy the keys of the entries in use, and then @key, to a new block and
+ * free the old ones, if that reclaims at least half of the arena. Deleted
+ * entries lose their keys. Returns the copy of @key, or NULL if nothing
+ * was done.
+ */
+static const char *_hkeys_compact(struct hsearch_data *htab,
+	const char *key, size_t len)
+{
+	struct htab_keys *keys;
+	size_t live = 0, total = 0, size, n;
+	_ENTRY *ent;
+	char *p;
+	int i;
+
+	for (keys = htab->keys; keys; keys = keys->next)
+		total += keys->used;
+	for (i = 1; i <= htab->size; ++i) {
+		if (htab->table[i].used > 0)
+			live += strlen(htab->table[i].entry.key) + 1;
+	}
+	if (!total || live > total / 2)
+		return NULL;
+
+	size = live + (len > HTAB_KEYS_SIZE ? len : HTAB_KEYS_SIZE);
+	keys = malloc(sizeof(*keys) + size);
+	if (!keys)
+		return NULL;
+	keys->size = size;
+	keys->used = 0;
+	keys->next = NULL;
+	for (i = 1; i <= htab->size; ++i) {
+		ent = &htab->table[i];
+		if (ent->used < 0)
+			ent->entry.key = NULL;
+		if (ent->used <= 0)
+			continue;
+		n = strlen(ent->entry.key) + 1;
+		p = keys->buf + keys->used;
+		memcpy(p, ent->entry.key, n);
+		ent->entry.key = p;
+		keys->used += n;
+	}
+	p = keys->buf + keys->used;
+	memcpy(p, key, len);
+	keys->used += len;
+
+	while (htab->keys) {
+		struct htab_keys *old = htab->keys;
+
+		htab->keys = old->next;
+		free(old);
+	}
+	htab->keys = keys;
+
+	return p;
+}
+
+static const char *_hkey(struct hsearch_data *htab, const char *key)
+{
+	struct htab_keys *keys = htab->keys;
+	size_t len = strlen(key) + 1;
+	const char *new;
+	char *p;
+
+	if (!keys || keys->size - keys->used < len) {
+		size_t size = len > HTAB_KEYS_SIZE ? len : HTAB_KEYS_SIZE;
+
+		new = _hkeys_compact(htab, key, len);
+		if (new)
+			return new;
+
+		keys = malloc(sizeof(*keys) + size);
+		if (!keys)
+			return NULL;
+		keys->size = size;
+		keys->used = 0;
+		keys->next = htab->keys;
+		htab->keys = keys;
+	}
+	p = keys->buf + keys->used;
+	memcpy(p, key, len);
+	keys->used += len;
+
+	return p;
+}
+
+static void _hput_blob(struct hsearch_data *htab, struct htab_blob *blob)
+{
+	struct htab_blob **bp;
+
+	if (--blob->refs)
+		return;
+	for (bp = &htab->blobs; *bp != blob; bp = &(*bp)->next)
+		;
+	*bp = blob->next;
+	free(blob);
+}
+
+/* Release the data of an entry */
+static void _hfree_data(struct hsearch_data *htab, _ENTRY *ent)
+{
+	char *data = ent->entry.data;
+	struct htab_blob *blob;
+
+	for (blob = htab->blobs; blob; blob = blob->next) {
+		if (data >= blob->data && data < blob->data + blob->size)
+			break;
+	}
+	if (blob)
+		_hput_blob(htab, blob);
+	else
+		free(data);
+	ent->entry.data = NULL;
+}
+
+/*
+ * Set the data of an entry: adopt it if it is in @blob, otherwise copy it.
+ * The old data is kept if it is the same.
+ */
+static int _hset_data(struct hsearch_data *htab, _ENTRY *ent,
+	const char *data, struct htab_blob *blob)
+{
+	char *new = (char *)data;
+
+	if (ent->entry.data && !strcmp(ent->entry.data, data))
+		return 0;
+	if (!blob) {
+		new = strdup(data);
+		if (!new)
+			return -ENOMEM;
+	}
+	if (ent->entry.data)
+		_hfree_data(htab, ent);
+	if (blob)
+		blob->refs++;
+	ent->entry.data = new;
+
+	return 0;
+}
+
+/* Remove the entries from the hash table, keeping the table itself */
+static void _hclear(struct hsearch_data *htab)
+{
+	struct htab_keys *keys;
+	int i;
+
+	for (i = 1; i <= htab->size; ++i) {
+		if (htab->table[i].used > 0)
+			_hfree_data(htab, &htab->table[i]);
+	}
+	memset(htab->table, '\0', (htab->size + 1) * sizeof(_ENTRY));
+
+	/* Keep one block of keys for reuse */
+	while (htab->keys && htab->keys->next) {
+		keys = htab->keys->next;
+		htab->keys->next = keys->next;
+		free(keys);
+	}
+	if (htab->keys)
+		htab->keys->used = 0;
+
+	htab->filled = 0;
+	htab->sorted = 1;
+}
+
 /*
  * hcreate()
  */
@@ -88,6 +281,17 @@ static int isprime(unsigned int number)
 	return number % div != 0;
 }
 
+/* Get the size of the table for at least @nel elements */
+static unsigned int htab_size(size_t nel)
+{
+	/* Change nel to the first prime number not smaller as nel. */
+	nel |= 1;		/* make odd */
+	while (!isprime(nel))
+		nel += 2;
+
+	return nel;
+}
+
 /*
  * Before using the hash table we must allocate memory for it.
  * Test for an existing table are done. We allocate one element
@@ -109,18 +313,22 @@ int hcreate_r(size_t nel, struct hsearch_data *htab)
 	if (htab->table != NULL)
 		return 0;
 
-	/* Change nel to the first prime number not smaller as nel. */
-	nel |= 1;		/* make odd */
-	while (!isprime(nel))
-		nel += 2;
-
-	htab->size = nel;
+	htab->size = htab_size(nel);
 	htab->filled = 0;
+	htab->keys = NULL;
+	htab->blobs = NULL;
+	htab->sorted = 1;
 
 	/* allocate memory and zero out */
 	htab->table = (_ENTRY *) calloc(htab->size + 1, sizeof(_ENTRY));
 	if (htab->table == NULL)
 		return 0;
+	htab->order = malloc(htab->size * sizeof(ENTRY *));
+	if (htab->order == NULL) {
+		free(htab->table);
+		htab->table = NULL;
+		return 0;
+	}
 
 	/* everything went alright */
 	return 1;
@@ -148,13 +356,16 @@ void hdestroy_r(struct hsearch_data *htab)
 
 	/* free used memory */
 	for (i = 1; i <= htab->size; ++i) {
-		if (htab->table[i].used > 0) {
-			ENTRY *ep = &htab->table[i].entry;
+		if (htab->table[i].used > 0)
+			_hfree_data(htab, &htab->table[i]);
+	}
+	while (htab->keys) {
+		struct htab_keys *keys = htab->keys;
 
-			free((void *)ep->key);
-			free(ep->data);
-		}
+		htab->keys = keys->next;
+		free(keys);
 	}
+	free(htab->order);
 	free(htab->table);
 
 	/* the sign for an existing table is an value != NULL in htable */
@@ -220,20 +431,20 @@ int hmatch_r(const char *match, int last_idx, ENTRY ** retval,
 
 /*
  * Compare an existing entry with the desired key, and overwrite if the action
- * is ENTER.  This is simply a helper function for hsearch_r().
+ * is ENTER.  This is simply a helper function for _hsearch().
  */
 static inline int _compare_and_overwrite_entry(ENTRY item, ACTION action,
 	ENTRY **retval, struct hsearch_data *htab, int flag,
-	unsigned int hval, unsigned int idx)
+	unsigned int hval, unsigned int idx, struct htab_blob *blob)
 {
-	if (htab->table[idx].used == hval
-	    && strcmp(item.key, htab->table[idx].entry.key) == 0) {
+	_ENTRY *ent = &htab->table[idx];
+
+	if (ent->used == hval && strcmp(item.key, ent->entry.key) == 0) {
 		/* Overwrite existing value? */
 		if ((action == ENTER) && (item.data != NULL)) {
 			/* check for permission */
 			if (htab->change_ok != NULL && htab->change_ok(
-			    &htab->table[idx].entry, item.data,
-			    env_op_overwrite, flag)) {
+			    &ent->entry, item.data, env_op_overwrite, flag)) {
 				debug("change_ok() rejected setting variable "
 					"%s, skipping it!\n", item.key);
 				__set_errno(EPERM);
@@ -242,9 +453,9 @@ static inline int _compare_and_overwrite_entry(ENTRY item, ACTION action,
 			}
 
 			/* If there is a callback, call it */
-			if (htab->table[idx].entry.callback &&
-			    htab->table[idx].entry.callback(item.key,
-			    item.data, env_op_overwrite, flag)) {
+			if (ent->entry.callback &&
+			    ent->entry.callback(item.key, item.data,
+			    env_op_overwrite, flag)) {
 				debug("callback() rejected setting variable "
 					"%s, skipping it!\n", item.key);
 				__set_errno(EINVAL);
@@ -252,30 +463,66 @@ static inline int _compare_and_overwrite_entry(ENTRY item, ACTION action,
 				return 0;
 			}
 
-			free(htab->table[idx].entry.data);
-			htab->table[idx].entry.data = strdup(item.data);
-			if (!htab->table[idx].entry.data) {
+			if (_hset_data(htab, ent, item.data, blob)) {
 				__set_errno(ENOMEM);
 				*retval = NULL;
 				return 0;
 			}
 		}
 		/* return found entry */
-		*retval = &htab->table[idx].entry;
+		*retval = &ent->entry;
 		return idx;
 	}
 	/* keep searching */
 	return -1;
 }
 
-int hsearch_r(ENTRY item, ACTION action, ENTRY ** retval,
-	      struct hsearch_data *htab, int flag)
+/*
+ * Add a new entry to the list used by hexport_r(). The list stays sorted
+ * while entries are added in order, as they are when importing an
+ * environment which was saved by hexport_r().
+ */
+static void _horder_add(struct hsearch_data *htab, ENTRY *ep)
+{
+	unsigned int n = htab->filled;
+
+	if (n && strcmp(htab->order[n - 1]->key, ep->key) > 0)
+		htab->sorted = 0;
+	htab->order[n] = ep;
+	htab->filled = n + 1;
+}
+
+/*
+ * Note a deleted entry found while searching: a new entry can go there,
+ * and its key can be used again if it is the one being searched for.
+ */
+static inline void _hnote_deleted(ENTRY item, struct hsearch_data *htab,
+	unsigned int idx, unsigned int *first_deleted, const char **key)
+{
+	const char *old = htab->table[idx].entry.key;
+
+	if (htab->table[idx].used != -1)
+		return;
+	if (!*first_deleted)
+		*first_deleted = idx;
+	if (!*key && old && strcmp(item.key, old) == 0)
+		*key = old;
+}
+
+/*
+ * Search for or enter an entry. If @blob is not NULL, item.data points into
+ * it and is used as it is, rather than copied.
+ */
+static int _hsearch(ENTRY item, ACTION action, ENTRY **retval,
+	struct hsearch_data *htab, int flag, struct htab_blob *blob)
 {
 	unsigned int hval;
 	unsigned int count;
 	unsigned int len = strlen(item.key);
 	unsigned int idx;
 	unsigned int first_deleted = 0;
+	const char *key = NULL;
+	_ENTRY *ent;
 	int ret;
 
 	/* Compute an value for the given string. Perhaps use a better method. */
@@ -304,12 +551,10 @@ int hsearch_r(ENTRY item, ACTION action, ENTRY ** retval,
 		 */
 		unsigned hval2;
 
-		if (htab->table[idx].used == -1
-		    && !first_deleted)
-			first_deleted = idx;
+		_hnote_deleted(item, htab, idx, &first_deleted, &key);
 
 		ret = _compare_and_overwrite_entry(item, action, retval, htab,
-			flag, hval, idx);
+			flag, hval, idx, blob);
 		if (ret != -1)
 			return ret;
 
@@ -338,9 +583,11 @@ int hsearch_r(ENTRY item, ACTION action, ENTRY ** retval,
 
 			/* If entry is found use it. */
 			ret = _compare_and_overwrite_entry(item, action, retval,
-				htab, flag, hval, idx);
+				htab, flag, hval, idx, blob);
 			if (ret != -1)
 				return ret;
+
+			_hnote_deleted(item, htab, idx, &first_deleted, &key);
 		}
 		while (htab->table[idx].used);
 	}
@@ -358,54 +605,56 @@ int hsearch_r(ENTRY item, ACTION action, ENTRY ** retval,
 		}
 
 		/*
-		 * Create new entry;
-		 * create copies of item.key and item.data
+		 * Create new entry; the key goes in the key arena unless
+		 * a deleted entry left it there
 		 */
 		if (first_deleted)
 			idx = first_deleted;
+		ent = &htab->table[idx];
 
-		htab->table[idx].used = hval;
-		htab->table[idx].entry.key = strdup(item.key);
-		htab->table[idx].entry.data = strdup(item.data);
-		if (!htab->table[idx].entry.key ||
-		    !htab->table[idx].entry.data) {
+		if (!key)
+			key = _hkey(htab, item.key);
+		ent->entry.key = key;
+		ent->entry.data = NULL;
+		if (!key || _hset_data(htab, ent, item.data, blob)) {
 			__set_errno(ENOMEM);
 			*retval = NULL;
 			return 0;
 		}
 
-		++htab->filled;
+		ent->used = hval;
+		_horder_add(htab, &ent->entry);
 
 		/* This is a new entry, so look up a possible callback */
-		env_callback_init(&htab->table[idx].entry);
+		env_callback_init(&ent->entry);
 		/* Also look for flags */
-		env_flags_init(&htab->table[idx].entry);
+		env_flags_init(&ent->entry);
 
 		/* check for permission */
 		if (htab->change_ok != NULL && htab->change_ok(
-		    &htab->table[idx].entry, item.data, env_op_create, flag)) {
+		    &ent->entry, item.data, env_op_create, flag)) {
 			debug("change_ok() rejected setting variable "
 				"%s, skipping it!\n", item.key);
-			_hdelete(item.key, htab, &htab->table[idx].entry, idx);
+			_hdelete(item.key, htab, &ent->entry, idx);
 			__set_errno(EPERM);
 			*retval = NULL;
 			return 0;
 		}
 
 		/* If there is a callback, call it */
-		if (htab->table[idx].entry.callback &&
-		    htab->table[idx].entry.callback(item.key, item.data,
+		if (ent->entry.callback &&
+		    ent->entry.callback(item.key, item.data,
 		    env_op_create, flag)) {
 			debug("callback() rejected setting variable "
 				"%s, skipping it!\n", item.key);
-			_hdelete(item.key, htab, &htab->table[idx].entry, idx);
+			_hdelete(item.key, htab, &ent->entry, idx);
 			__set_errno(EINVAL);
 			*retval = NULL;
 			return 0;
 		}
 
 		/* return new entry */
-		*retval = &htab->table[idx].entry;
+		*retval = &ent->entry;
 		return 1;
 	}
 
@@ -414,6 +663,12 @@ int hsearch_r(ENTRY item, ACTION action, ENTRY ** retval,
 	return 0;
 }
 
+int hsearch_r(ENTRY item, ACTION action, ENTRY ** retval,
+	      struct hsearch_data *htab, int flag)
+{
+	return _hsearch(item, action, retval, htab, flag, NULL);
+}
+
 
 /*
  * hdelete()
@@ -428,14 +683,20 @@ int hsearch_r(ENTRY item, ACTION action, ENTRY ** retval,
 static void _hdelete(const char *key, struct hsearch_data *htab, ENTRY *ep,
 	int idx)
 {
-	/* free used ENTRY */
+	unsigned int i;
+
+	/* free used ENTRY, keeping its key for reuse */
 	debug("hdelete: DELETING key \"%s\"\n", key);
-	free((void *)ep->key);
-	free(ep->data);
+	_hfree_data(htab, &htab->table[idx]);
 	ep->callback = NULL;
 	ep->flags = 0;
 	htab->table[idx].used = -1;
 
+	/* remove it from the list, which leaves the order unchanged */
+	for (i = htab->filled; htab->order[--i] != ep; )
+		;
+	memmove(&htab->order[i], &htab->order[i + 1],
+		(htab->filled - i - 1) * sizeof(ENTRY *));
 	--htab->filled;
 }
 
@@ -604,56 +865,59 @@ ssize_t hexport_r(struct hsearch_data *htab, const char sep, int flag,
 
 	debug("EXPORT  table = %p, htab.size = %d, htab.filled = %d, "
 		"size = %zu\n", htab, htab->size, htab->filled, size);
+	/*
+	 * Sort the entries by key, unless they are still in the order they
+	 * had when they were last sorted or imported
+	 */
+	if (!htab->sorted) {
+		qsort(htab->order, htab->filled, sizeof(ENTRY *), cmpkey);
+		htab->sorted = 1;
+	}
+
 	/*
 	 * Pass 1:
 	 * search used entries,
 	 * save addresses and compute total length
 	 */
-	for (i = 1, n = 0, totlen = 0; i <= htab->size; ++i) {
+	for (i = 0, n = 0, totlen = 0; i < htab->filled; ++i) {
+		ENTRY *ep = htab->order[i];
+		int found = match_entry(ep, flag, argc, argv);
 
-		if (htab->table[i].used > 0) {
-			ENTRY *ep = &htab->table[i].entry;
-			int found = match_entry(ep, flag, argc, argv);
-
-			if ((argc > 0) && (found == 0))
-				continue;
+		if ((argc > 0) && (found == 0))
+			continue;
 
-			if ((flag & H_HIDE_DOT) && ep->key[0] == '.')
-				continue;
+		if ((flag & H_HIDE_DOT) && ep->key[0] == '.')
+			continue;
 
-			list[n++] = ep;
+		list[n++] = ep;
 
-			totlen += strlen(ep->key) + 2;
+		totlen += strlen(ep->key) + 2;
 
-			if (sep == '\0') {
-				totlen += strlen(ep->data);
-			} else {	/* check if escapes are needed */
-				char *s = ep->data;
+		if (sep == '\0') {
+			totlen += strlen(ep->data);
+		} else {	/* check if escapes are needed */
+			char *s = ep->data;
 
-				while (*s) {
+			while (*s) {
+				++totlen;
+				/* add room for needed escape chars */
+				if ((*s == sep) || (*s == '\\'))
 					++totlen;
-					/* add room for needed escape chars */
-					if ((*s == sep) || (*s == '\\'))
-						++totlen;
-					++s;
-				}
+				++s;
 			}
-			totlen += 2;	/* for '=' and 'sep' char */
 		}
+		totlen += 2;	/* for '=' and 'sep' char */
 	}
 
 #ifdef DEBUG
-	/* Pass 1a: print unsorted list */
-	printf("Unsorted: n=%d\n", n);
+	/* Pass 1a: print sorted list */
+	printf("Sorted: n=%d\n", n);
 	for (i = 0; i < n; ++i) {
 		printf("\t%3d: %p ==> %-10s => %s\n",
 		       i, list[i], list[i]->key, list[i]->data);
 	}
 #endif
 
-	/* Sort list by keys */
-	qsort(list, n, sizeof(ENTRY *), cmpkey);
-
 	/* Check if the user supplied buffer size is sufficient */
 	if (size) {
 		if (size < totlen + 1) {	/* provided buffer too small */
@@ -778,8 +1042,11 @@ int himport_r(struct hsearch_data *htab,
 		const char *env, size_t size, const char sep, int flag,
 		int crlf_is_lf, int nvars, char * const vars[])
 {
+	struct htab_blob *blob;
 	char *data, *sp, *dp, *name, *value;
 	char *localvars[nvars];
+	size_t len = size;
+	int nent;
 	int i;
 
 	/* Test for correct arguments.  */
@@ -788,27 +1055,40 @@ int himport_r(struct hsearch_data *htab,
 		return 0;
 	}
 
-	/* we allocate new space to make sure we can write to the array */
-	if ((data = malloc(size)) == NULL) {
-		debug("himport_r: can't malloc %zu bytes\n", size);
+	/*
+	 * Data separated by NUL characters ends with an empty string, and
+	 * is often followed by unused space up to the full environment
+	 * size, which we need not copy
+	 */
+	if (sep == '\0') {
+		for (dp = (char *)env; dp < env + size && *dp;
+		     dp += strnlen(dp, env + size - dp) + 1)
+			;
+		if (dp < env + size)
+			len = dp + 1 - env;
+	}
+
+	/*
+	 * We allocate new space to make sure we can write to the array.
+	 * This becomes a blob which the imported values point into. We
+	 * hold a reference to it until the import is done.
+	 */
+	blob = malloc(sizeof(*blob) + len);
+	if (blob == NULL) {
+		debug("himport_r: can't malloc %zu bytes\n", len);
 		__set_errno(ENOMEM);
 		return 0;
 	}
-	memcpy(data, env, size);
+	blob->refs = 1;
+	blob->size = len;
+	data = blob->data;
+	memcpy(data, env, len);
 	dp = data;
 
 	/* make a local copy of the list of variables */
 	if (nvars)
 		memcpy(localvars, vars, sizeof(vars[0]) * nvars);
 
-	if ((flag & H_NOCLEAR) == 0) {
-		/* Destroy old hash table if one exists */
-		debug("Destroy Hash Table: %p table = %p\n", htab,
-		       htab->table);
-		if (htab->table)
-			hdestroy_r(htab);
-	}
-
 	/*
 	 * Create new hash table (if needed).  The computation of the hash
 	 * table size is based on heuristics: in a sample of some 70+
@@ -826,23 +1106,39 @@ int himport_r(struct hsearch_data *htab,
 	 * space when importing very small buffers. Both boundaries can
 	 * be overwritten in the board config file if needed.
 	 */
+	nent = CONFIG_ENV_MIN_ENTRIES + size / 8;
+	if (nent > CONFIG_ENV_MAX_ENTRIES)
+		nent = CONFIG_ENV_MAX_ENTRIES;
 
-	if (!htab->table) {
-		int nent = CONFIG_ENV_MIN_ENTRIES + size / 8;
-
-		if (nent > CONFIG_ENV_MAX_ENTRIES)
-			nent = CONFIG_ENV_MAX_ENTRIES;
+	if ((flag & H_NOCLEAR) == 0 && htab->table) {
+		/*
+		 * Empty the old hash table, keeping its memory if it has the
+		 * right size, otherwise destroy it
+		 */
+		debug("Clear Hash Table: %p table = %p\n", htab,
+		       htab->table);
+		if (htab_size(nent) == htab->size)
+			_hclear(htab);
+		else
+			hdestroy_r(htab);
+	}
 
+	if (!htab->table) {
 		debug("Create Hash Table: N=%d\n", nent);
 
 		if (hcreate_r(nent, htab) == 0) {
-			free(data);
+			free(blob);
 			return 0;
 		}
 	}
+	blob->next = htab->blobs;
+	htab->blobs = blob;
 
-	if(!size)
+	size = len;
+	if(!size) {
+		_hput_blob(htab, blob);
 		return 1;		/* everything OK */
+	}
 	if(crlf_is_lf) {
 		/* Remove Carriage Returns in front of Line Feeds */
 		unsigned ignored_crs = 0;
@@ -905,6 +1201,7 @@ int himport_r(struct hsearch_data *htab,
 
 		if (*name == 0) {
 			debug("INSERT: unable to use an empty key\n");
+			_hput_blob(htab, blob);
 			__set_errno(EINVAL);
 			return 0;
 		}
@@ -917,7 +1214,7 @@ int himport_r(struct hsearch_data *htab,
 		e.key = name;
 		e.data = value;
 
-		hsearch_r(e, ENTER, &rv, htab, flag);
+		_hsearch(e, ENTER, &rv, htab, flag, blob);
 		if (rv == NULL)
 			printf("himport_r: can't insert \"%s=%s\" into hash table\n",
 				name, value);
@@ -927,8 +1224,8 @@ int himport_r(struct hsearch_data *htab,
 			rv, name, value);
 	} while ((dp < data + size) && *dp);	/* size check needed for text */
 						/* without '\0' termination */
-	debug("INSERT: free(data = %p)\n", data);
-	free(data);
+	debug("INSERT: release(blob = %p)\n", blob);
+	_hput_blob(htab, blob);
 
 	/* process variables which were not considered */
 	for (i = 0; i < nvars; i++) {
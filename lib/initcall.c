@@ -9,28 +9,313 @@
 
 DECLARE_GLOBAL_DATA_PTR;
 
+#define INITCALL_DEFER_MAX	8
+#define INITCALL_TIMES_MAX	200
+
+/* This is in the data section, since it is used before relocation */
+static struct {
+	const init_fnc_t *sequence;	/* List being run */
+	ulong provided;		/* What the list being run has set up */
+	ulong deferred_provides; /* What the deferred initcalls set up */
+	int deferred;		/* Number of deferred initcalls */
+	int next;		/* Next deferred initcall to run */
+	init_fnc_t defer[INITCALL_DEFER_MAX];
+	int errors;		/* Initcalls run before what they need */
+	bool test;		/* Running lists for tests, see below */
+#ifdef CONFIG_INITCALL_TIMING
+	int count;		/* Number of initcalls timed */
+	struct initcall_time time[INITCALL_TIMES_MAX];
+#endif
+} state __attribute__((section(".data")));
+
+#ifdef CONFIG_UT_INITCALL
+/* What was recorded during boot, while tests are run */
+static typeof(state) boot_state;
+#endif
+
+static const char *const res_name[INITCALL_RES_COUNT] = {
+	"reloc", "malloc", "dm", "env", "serial", "stdio", "console", "flash",
+	"nand", "mmc", "pci", "irq", "net",
+};
+
+/* Print the names of the things in @mask, returning the length printed */
+static int initcall_print_res(ulong mask)
+{
+	int len = 0;
+	int i;
+
+	for (i = 0; i < INITCALL_RES_COUNT; i++) {
+		if (mask & (1UL << i))
+			len += printf("%s%s", len ? "," : "", res_name[i]);
+	}
+
+	return len;
+}
+
+const struct initcall_info *initcall_find(init_fnc_t func)
+{
+	const struct initcall_info *info =
+		ll_entry_start(struct initcall_info, initcall);
+	const int count = ll_entry_count(struct initcall_info, initcall);
+	int i;
+
+	for (i = 0; i < count; i++, info++) {
+		if (info->func == func)
+			return info;
+#ifdef CONFIG_NEEDS_MANUAL_RELOC
+		/* The list entries are not relocated */
+		if ((gd->flags & GD_FLG_RELOC) &&
+		    (ulong)info->func == (ulong)func - gd->reloc_off)
+			return info;
+#endif
+	}
+
+	return NULL;
+}
+
+static void initcall_record(ulong func, const struct initcall_info *info,
+			    ulong us, uint64_t ticks)
+{
+#ifdef CONFIG_INITCALL_TIMING
+	struct initcall_time *time;
+
+	if (state.count == INITCALL_TIMES_MAX)
+		return;
+	time = &state.time[state.count++];
+	time->func = func;
+	time->info = info ? info - ll_entry_start(struct initcall_info,
+						  initcall) : -1;
+	time->us = us;
+	time->ticks = ticks;
+#endif
+}
+
+static int initcall_run(init_fnc_t func, const struct initcall_info *info)
+{
+	unsigned long reloc_ofs = 0;
+	__maybe_unused uint64_t ticks;
+	__maybe_unused ulong start;
+	int span;
+	int ret;
+
+	if (gd->flags & GD_FLG_RELOC)
+		reloc_ofs = gd->reloc_off;
+	debug("initcall: %p", (char *)func - reloc_ofs);
+	if (gd->flags & GD_FLG_RELOC)
+		debug(" (relocated to %p)\n", (char *)func);
+	else
+		debug("\n");
+	if (info && info->needs & ~state.provided) {
+		printf("initcall: %s run before ", info->name);
+		initcall_print_res(info->needs & ~state.provided);
+		puts(" is set up\n");
+		state.errors++;
+	}
+
+	span = -1;
+	if (!state.test)
+		span = bootstage_span_start(info ? info->name : NULL,
+					    (ulong)func - reloc_ofs, 0);
+#ifdef CONFIG_INITCALL_TIMING
+	ticks = get_ticks();
+	start = timer_get_us();
+#endif
+	ret = func();
+#ifdef CONFIG_INITCALL_TIMING
+	initcall_record((ulong)func - reloc_ofs, info, timer_get_us() - start,
+			get_ticks() - ticks);
+#endif
+	bootstage_span_end(span);
+	if (ret) {
+		printf("initcall sequence %p failed at call %p (err=%d)\n",
+		       state.sequence, (char *)func - reloc_ofs, ret);
+		return ret;
+	}
+	if (info)
+		state.provided |= info->provides;
+
+	return 0;
+}
+
+int initcall_run_deferred(void)
+{
+	const struct initcall_info *info;
+	init_fnc_t func;
+
+	/* An initcall may call this too, so take each one off first */
+	while (state.next < state.deferred) {
+		func = state.defer[state.next++];
+		info = initcall_find(func);
+		if (initcall_run(func, info))
+			return -1;
+	}
+	state.next = 0;
+	state.deferred = 0;
+	state.deferred_provides = 0;
+
+	return 0;
+}
+
+/* Put off an initcall if it is marked INITCALLF_DEFER, returning true */
+static bool initcall_defer(init_fnc_t func, const struct initcall_info *info)
+{
+#ifdef CONFIG_INITCALL_DEFER
+	if (!info || !(info->flags & INITCALLF_DEFER) ||
+	    state.deferred == INITCALL_DEFER_MAX)
+		return false;
+	debug("initcall: defer %s\n", info->name);
+	state.defer[state.deferred++] = func;
+	state.deferred_provides |= info->provides;
+
+	return true;
+#else
+	return false;
+#endif
+}
+
 int initcall_run_list(const init_fnc_t init_sequence[])
 {
+	const struct initcall_info *info;
 	const init_fnc_t *init_fnc_ptr;
 
+	/* Each list sets up everything it needs, e.g. after relocation */
+	state.sequence = init_sequence;
+	state.provided = 0;
 	for (init_fnc_ptr = init_sequence; *init_fnc_ptr; ++init_fnc_ptr) {
-		unsigned long reloc_ofs = 0;
-		int ret;
-
-		if (gd->flags & GD_FLG_RELOC)
-			reloc_ofs = gd->reloc_off;
-		debug("initcall: %p", (char *)*init_fnc_ptr - reloc_ofs);
-		if (gd->flags & GD_FLG_RELOC)
-			debug(" (relocated to %p)\n", (char *)*init_fnc_ptr);
-		else
-			debug("\n");
-		ret = (*init_fnc_ptr)();
-		if (ret) {
-			printf("initcall sequence %p failed at call %p (err=%d)\n",
-			       init_sequence,
-			       (char *)*init_fnc_ptr - reloc_ofs, ret);
+		info = initcall_find(*init_fnc_ptr);
+		if (info && state.deferred &&
+		    (info->flags & INITCALLF_SYNC ||
+		     info->needs & state.deferred_provides)) {
+			if (initcall_run_deferred())
+				return -1;
+		}
+		if (initcall_defer(*init_fnc_ptr, info))
+			continue;
+		if (initcall_run(*init_fnc_ptr, info))
 			return -1;
+	}
+
+	return initcall_run_deferred();
+}
+
+int initcall_check_list(const init_fnc_t init_sequence[], ulong *missingp)
+{
+	const struct initcall_info *info;
+	ulong provided = 0;
+	int i;
+
+	for (i = 0; init_sequence[i]; i++) {
+		info = initcall_find(init_sequence[i]);
+		if (!info)
+			continue;
+		if (info->needs & ~provided) {
+			*missingp = info->needs & ~provided;
+			return i;
 		}
+		provided |= info->provides;
 	}
+
+	return -1;
+}
+
+int initcall_get_errors(void)
+{
+	return state.errors;
+}
+
+#ifdef CONFIG_UT_INITCALL
+void initcall_test_state(bool test)
+{
+	if (test == state.test)
+		return;
+	if (test) {
+		boot_state = state;
+		memset(&state, '\0', sizeof(state));
+		state.test = true;
+	} else {
+		state = boot_state;
+	}
+}
+#endif
+
+int initcall_get_times(const struct initcall_time **timesp)
+{
+#ifdef CONFIG_INITCALL_TIMING
+	*timesp = state.time;
+
+	return state.count;
+#else
 	return 0;
+#endif
+}
+
+static const struct initcall_info *initcall_get_info(int index)
+{
+	const struct initcall_info *info =
+		ll_entry_start(struct initcall_info, initcall);
+	const int count = ll_entry_count(struct initcall_info, initcall);
+	int i;
+
+	for (i = 0; i < count; i++, info++) {
+		if (i == index)
+			return info;
+	}
+
+	return NULL;
+}
+
+void initcall_show_times(void)
+{
+	const struct initcall_info *info;
+	const struct initcall_time *time;
+	uint64_t total_ticks = 0;
+	ulong total_us = 0;
+	int count, i;
+
+	count = initcall_get_times(&time);
+	if (!count) {
+		puts("No initcall times recorded\n");
+		return;
+	}
+	printf("%15s%11s  %s\n", "Ticks", "us", "Initcall");
+	for (i = 0; i < count; i++, time++) {
+		print_grouped_ull(time->ticks, 12);
+		print_grouped_ull(time->us, 9);
+		info = initcall_get_info(time->info);
+		if (info)
+			printf("  %s\n", info->name);
+		else
+			printf("  %#lx\n", time->func);
+		total_ticks += time->ticks;
+		total_us += time->us;
+	}
+	print_grouped_ull(total_ticks, 12);
+	print_grouped_ull(total_us, 9);
+	printf("  total for %d initcalls\n", count);
+}
+
+static void initcall_show_res(ulong mask)
+{
+	int len = initcall_print_res(mask);
+
+	printf("%*s", max(18 - len, 1), "");
+}
+
+void initcall_show_info(void)
+{
+	const struct initcall_info *info =
+		ll_entry_start(struct initcall_info, initcall);
+	const int count = ll_entry_count(struct initcall_info, initcall);
+	int i;
+
+	printf("%-24s%-18s%-18s%s\n", "Initcall", "Needs", "Provides",
+	       "Flags");
+	for (i = 0; i < count; i++, info++) {
+		printf("%-24s", info->name);
+		initcall_show_res(info->needs);
+		initcall_show_res(info->provides);
+		printf("%s%s\n", info->flags & INITCALLF_DEFER ? "defer " : "",
+		       info->flags & INITCALLF_SYNC ? "sync" : "");
+	}
+	printf("%d initcalls run before what they need\n", state.errors);
 }
@@ -0,0 +1,304 @@
+/*
+ * LZ4 decompression, for the frame format and the legacy format used for
+ * Linux kernels
+ *
+ * The decoder is written for speed on slow cores: literal runs and
+ * matches are copied 8 bytes at a time whenever there is room to write a
+ * little past their end, including short-offset matches, which are first
+ * spread out so that each copy reads what is already there. Copies only
+ * ever write behind the compressed data which is still to be read, so the
+ * data may be decompressed in place.
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <errno.h>
+#include <lz4.h>
+#include <asm/types.h>
+#include <asm/unaligned.h>
+#include <linux/err.h>
+
+#define LZ4_MIN_MATCH		4
+#define LZ4_RUN_MASK		15
+#define LZ4_WILD		8	/* Bytes written by lz4_copy8() */
+
+#define LZ4_FRAME_MAGIC		0x184d2204
+#define LZ4_LEGACY_MAGIC	0x184c2102
+
+/* Frame descriptor flags */
+#define LZ4_FLG_VERSION_MASK	0xc0
+#define LZ4_FLG_VERSION		0x40
+#define LZ4_FLG_BLOCK_INDEP	0x20
+#define LZ4_FLG_BLOCK_CSUM	0x10
+#define LZ4_FLG_CONTENT_SIZE	0x08
+#define LZ4_FLG_DICT_ID		0x01
+
+#define LZ4_BLOCK_UNCOMPRESSED	0x80000000
+
+/*
+ * Copy 8 bytes. Both halves are loaded before either is stored, so @src
+ * may be just after @dst.
+ */
+static inline void lz4_copy8(u8 *dst, const u8 *src)
+{
+#if BITS_PER_LONG == 64
+	put_unaligned(get_unaligned((const u64 *)src), (u64 *)dst);
+#else
+	u32 a = get_unaligned((const u32 *)src);
+	u32 b = get_unaligned((const u32 *)(src + 4));
+
+	put_unaligned(a, (u32 *)dst);
+	put_unaligned(b, (u32 *)(dst + 4));
+#endif
+}
+
+/*
+ * Get a length which continues in the following bytes while they are 255.
+ * Returns the length, or 0 if the input runs out.
+ */
+static inline size_t lz4_length(const u8 **ipp, const u8 *iend, size_t len)
+{
+	const u8 *ip = *ipp;
+	uint b;
+
+	do {
+		if (ip >= iend)
+			return 0;
+		b = *ip++;
+		len += b;
+	} while (b == 255);
+	*ipp = ip;
+
+	return len;
+}
+
+/*
+ * The end of where a copy may write. When decompressing in place, this
+ * stops it overwriting compressed data which has not been read yet.
+ */
+static inline u8 *lz4_write_limit(const u8 *ip, u8 *op, u8 *oend)
+{
+	return (const u8 *)op < ip && ip < (const u8 *)oend ? (u8 *)ip : oend;
+}
+
+/*
+ * Decompress the block at [@ip, @iend) to [@op, @oend). Matches may refer
+ * back as far as @base. Returns the end of the output, or an ERR_PTR().
+ */
+static u8 *lz4_block(const u8 *ip, const u8 *iend, u8 *base, u8 *op,
+		     u8 *oend)
+{
+	const u8 *match;
+	size_t len, offset, dist, i;
+	uint token;
+	u8 *cpy;
+
+	if (ip >= iend)
+		return ERR_PTR(-EINVAL);
+
+	for (;;) {
+		/* Literals */
+		token = *ip++;
+		len = token >> 4;
+		if (len == LZ4_RUN_MASK) {
+			len = lz4_length(&ip, iend, len);
+			if (!len)
+				return ERR_PTR(-EINVAL);
+		}
+		if (len > (size_t)(iend - ip))
+			return ERR_PTR(-EINVAL);
+		if (len > (size_t)(oend - op))
+			return ERR_PTR(-ENOSPC);
+		cpy = op + len;
+		if (cpy + LZ4_WILD <= lz4_write_limit(ip + len, op, oend) &&
+		    ip + len + LZ4_WILD <= iend) {
+			do {
+				lz4_copy8(op, ip);
+				op += LZ4_WILD;
+				ip += LZ4_WILD;
+			} while (op < cpy);
+			ip -= op - cpy;
+		} else {
+			memmove(op, ip, len);
+			ip += len;
+		}
+		op = cpy;
+
+		/* The last sequence has only literals */
+		if (ip == iend)
+			return op;
+
+		/* Match */
+		if (iend - ip < 2)
+			return ERR_PTR(-EINVAL);
+		offset = get_unaligned_le16(ip);
+		ip += 2;
+		if (!offset || offset > (size_t)(op - base))
+			return ERR_PTR(-EINVAL);
+		len = token & LZ4_RUN_MASK;
+		if (len == LZ4_RUN_MASK) {
+			len = lz4_length(&ip, iend, len);
+			if (!len)
+				return ERR_PTR(-EINVAL);
+		}
+		len += LZ4_MIN_MATCH;
+		if (len > (size_t)(oend - op))
+			return ERR_PTR(-ENOSPC);
+		match = op - offset;
+		cpy = op + len;
+		if (cpy + LZ4_WILD <= lz4_write_limit(ip, op, oend)) {
+			if (offset < LZ4_WILD) {
+				/*
+				 * The output repeats every offset bytes, so
+				 * it also repeats every multiple of offset.
+				 * Write enough bytes one at a time that the
+				 * rest can be copied from 8 or more back.
+				 */
+				dist = offset * DIV_ROUND_UP(LZ4_WILD, offset);
+				for (i = 0; i < dist - offset; i++)
+					op[i] = match[i];
+				op += i;
+				match = op - dist;
+			}
+			while (op < cpy) {
+				lz4_copy8(op, match);
+				op += LZ4_WILD;
+				match += LZ4_WILD;
+			}
+		} else {
+			while (op < cpy)
+				*op++ = *match++;
+		}
+		op = cpy;
+	}
+}
+
+int lz4_decompress_block(const void *src, size_t src_len, void *dst,
+			 size_t *dst_len)
+{
+	u8 *op;
+
+	op = lz4_block(src, src + src_len, dst, dst, dst + *dst_len);
+	if (IS_ERR(op))
+		return PTR_ERR(op);
+	*dst_len = op - (u8 *)dst;
+
+	return 0;
+}
+
+/*
+ * Decompress a sequence of independent blocks, each after its compressed
+ * size, until the input runs out
+ */
+static int lz4_legacy(const u8 *ip, const u8 *iend, u8 **opp, u8 *oend)
+{
+	u8 *op = *opp;
+	size_t len;
+	int ret = 0;
+
+	while (iend - ip >= 4) {
+		len = get_unaligned_le32(ip);
+		ip += 4;
+		/* Files may be joined together */
+		if (len == LZ4_LEGACY_MAGIC)
+			continue;
+		if (len > (size_t)(iend - ip)) {
+			ret = -EINVAL;
+			break;
+		}
+		op = lz4_block(ip, ip + len, op, op, oend);
+		if (IS_ERR(op)) {
+			ret = PTR_ERR(op);
+			break;
+		}
+		*opp = op;
+		ip += len;
+	}
+
+	return ret;
+}
+
+static int lz4_frame(const u8 *ip, const u8 *iend, u8 *dst, u8 **opp,
+		     u8 *oend)
+{
+	u8 *op = *opp;
+	uint flags;
+	size_t len;
+	u32 size;
+
+	if (iend - ip < 3)
+		return -EINVAL;
+	flags = ip[0];
+	if ((flags & LZ4_FLG_VERSION_MASK) != LZ4_FLG_VERSION ||
+	    (flags & LZ4_FLG_DICT_ID))
+		return -EPROTONOSUPPORT;
+
+	/* Check the size up front if it is there */
+	if (flags & LZ4_FLG_CONTENT_SIZE) {
+		if (iend - ip < 11)
+			return -EINVAL;
+		if (get_unaligned_le32(ip + 6) ||
+		    get_unaligned_le32(ip + 2) > (size_t)(oend - op))
+			return -ENOSPC;
+		ip += 8;
+	}
+	/* Skip the flags, block size and header checksum */
+	ip += 3;
+
+	for (;;) {
+		if (iend - ip < 4)
+			return -EINVAL;
+		size = get_unaligned_le32(ip);
+		ip += 4;
+		if (!size)
+			break;
+		len = size & ~LZ4_BLOCK_UNCOMPRESSED;
+		if (len > (size_t)(iend - ip))
+			return -EINVAL;
+		if (size & LZ4_BLOCK_UNCOMPRESSED) {
+			if (len > (size_t)(oend - op))
+				return -ENOSPC;
+			memmove(op, ip, len);
+			op += len;
+		} else {
+			op = lz4_block(ip, ip + len,
+				       flags & LZ4_FLG_BLOCK_INDEP ? op : dst,
+				       op, oend);
+			if (IS_ERR(op))
+				return PTR_ERR(op);
+		}
+		*opp = op;
+		ip += len;
+		if (flags & LZ4_FLG_BLOCK_CSUM)
+			ip += 4;
+	}
+
+	/* The content checksum, if any, is not checked */
+	return 0;
+}
+
+int lz4_decompress(const void *src, size_t src_len, void *dst,
+		   size_t *dst_len)
+{
+	const u8 *ip = src;
+	u8 *op = dst;
+	int ret;
+
+	if (src_len < 4)
+		return -EINVAL;
+	switch (get_unaligned_le32(ip)) {
+	case LZ4_FRAME_MAGIC:
+		ret = lz4_frame(ip + 4, ip + src_len, dst, &op, op + *dst_len);
+		break;
+	case LZ4_LEGACY_MAGIC:
+		ret = lz4_legacy(ip + 4, ip + src_len, &op, op + *dst_len);
+		break;
+	default:
+		ret = -EINVAL;
+		break;
+	}
+	*dst_len = op - (u8 *)dst;
+
+	return ret;
+}
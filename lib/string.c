@@ -19,6 +19,12 @@
 #include <linux/string.h>
 #include <linux/ctype.h>
 #include <malloc.h>
+#include <asm/byteorder.h>
+
+/* For copying and filling a word at a time */
+#define LONG_BYTES	sizeof(unsigned long)
+#define LONG_MASK	(LONG_BYTES - 1)
+#define LONG_BITS	(LONG_BYTES * 8)
 
 
 /**
@@ -436,24 +442,34 @@ char *strswab(const char *s)
  */
 void * memset(void * s,int c,size_t count)
 {
-	unsigned long *sl = (unsigned long *) s;
-	unsigned long cl = 0;
-	char *s8;
-	int i;
-
-	/* do it one word at a time (32 bits or 64 bits) while possible */
-	if ( ((ulong)s & (sizeof(*sl) - 1)) == 0) {
-		for (i = 0; i < sizeof(*sl); i++) {
-			cl <<= 8;
-			cl |= c & 0xff;
+	unsigned long *sl;
+	unsigned long cl;
+	char *s8 = s;
+
+	/* fill bytes until the start is aligned, then a word at a time */
+	if (count >= 2 * LONG_BYTES) {
+		while ((ulong)s8 & LONG_MASK) {
+			*s8++ = c;
+			count--;
 		}
-		while (count >= sizeof(*sl)) {
-			*sl++ = cl;
-			count -= sizeof(*sl);
+		cl = (unsigned char)c;
+		cl |= cl << 8;
+		cl |= cl << 16;
+		if (LONG_BYTES > 4)
+			cl |= cl << 16 << 16;
+		sl = (unsigned long *)s8;
+		for (; count >= 4 * LONG_BYTES; count -= 4 * LONG_BYTES) {
+			sl[0] = cl;
+			sl[1] = cl;
+			sl[2] = cl;
+			sl[3] = cl;
+			sl += 4;
 		}
+		for (; count >= LONG_BYTES; count -= LONG_BYTES)
+			*sl++ = cl;
+		s8 = (char *)sl;
 	}
 	/* fill 8 bits at a time */
-	s8 = (char *)sl;
 	while (count--)
 		*s8++ = c;
 
@@ -485,6 +501,90 @@ char * bcopy(const char * src, char * dest, int count)
 }
 #endif
 
+#if !defined(__HAVE_ARCH_MEMCPY) || !defined(__HAVE_ARCH_MEMMOVE)
+/*
+ * Get the word starting @shift bits into @lo, which is followed in memory
+ * by @hi. This lets a misaligned source be read a word at a time.
+ */
+static inline unsigned long merge_words(unsigned long lo, unsigned long hi,
+					uint shift)
+{
+#ifdef __BIG_ENDIAN
+	return lo << shift | hi >> (LONG_BITS - shift);
+#else
+	return lo >> shift | hi << (LONG_BITS - shift);
+#endif
+}
+
+/*
+ * Copy words to aligned @dl from @s8, which is not aligned. Returns the
+ * number of bytes copied.
+ */
+static size_t copy_shifted(unsigned long *dl, const char *s8, size_t count)
+{
+	uint shift = ((ulong)s8 & LONG_MASK) * 8;
+	const unsigned long *sl;
+	unsigned long lo, hi;
+	size_t done;
+
+	sl = (const unsigned long *)((ulong)s8 & ~LONG_MASK);
+	lo = *sl++;
+	for (done = 0; count - done >= LONG_BYTES; done += LONG_BYTES) {
+		hi = *sl++;
+		*dl++ = merge_words(lo, hi, shift);
+		lo = hi;
+	}
+
+	return done;
+}
+
+/*
+ * Copy forwards, which is also safe for overlapping areas with @dest
+ * before @src
+ */
+static void *copy_forward(void *dest, const void *src, size_t count)
+{
+	const unsigned long *sl;
+	unsigned long *dl;
+	const char *s8 = src;
+	char *d8 = dest;
+	size_t done;
+
+	/* copy bytes until the destination is aligned, then words */
+	if (count >= 2 * LONG_BYTES) {
+		while ((ulong)d8 & LONG_MASK) {
+			*d8++ = *s8++;
+			count--;
+		}
+		dl = (unsigned long *)d8;
+		if ((ulong)s8 & LONG_MASK) {
+			done = copy_shifted(dl, s8, count);
+		} else {
+			sl = (const unsigned long *)s8;
+			for (done = 0; count - done >= 4 * LONG_BYTES;
+			     done += 4 * LONG_BYTES) {
+				dl[0] = sl[0];
+				dl[1] = sl[1];
+				dl[2] = sl[2];
+				dl[3] = sl[3];
+				dl += 4;
+				sl += 4;
+			}
+			for (; count - done >= LONG_BYTES; done += LONG_BYTES)
+				*dl++ = *sl++;
+		}
+		d8 += done;
+		s8 += done;
+		count -= done;
+	}
+	/* copy the rest one byte at a time */
+	while (count--)
+		*d8++ = *s8++;
+
+	return dest;
+}
+#endif
+
 #ifndef __HAVE_ARCH_MEMCPY
 /**
  * memcpy - Copy one area of memory to another
@@ -497,30 +597,37 @@ char * bcopy(const char * src, char * dest, int count)
  */
 void * memcpy(void *dest, const void *src, size_t count)
 {
-	unsigned long *dl = (unsigned long *)dest, *sl = (unsigned long *)src;
-	char *d8, *s8;
-
 	if (src == dest)
 		return dest;
 
-	/* while all data is aligned (common case), copy a word at a time */
-	if ( (((ulong)dest | (ulong)src) & (sizeof(*dl) - 1)) == 0) {
-		while (count >= sizeof(*dl)) {
-			*dl++ = *sl++;
-			count -= sizeof(*dl);
-		}
-	}
-	/* copy the reset one byte at a time */
-	d8 = (char *)dl;
-	s8 = (char *)sl;
-	while (count--)
-		*d8++ = *s8++;
-
-	return dest;
+	return copy_forward(dest, src, count);
 }
 #endif
 
 #ifndef __HAVE_ARCH_MEMMOVE
+/*
+ * Like copy_shifted() but working backwards from the ends of the areas,
+ * @dl being aligned
+ */
+static size_t copy_shifted_back(unsigned long *dl, const char *s8,
+				size_t count)
+{
+	uint shift = ((ulong)s8 & LONG_MASK) * 8;
+	const unsigned long *sl;
+	unsigned long lo, hi;
+	size_t done;
+
+	sl = (const unsigned long *)((ulong)s8 & ~LONG_MASK);
+	hi = *sl;
+	for (done = 0; count - done >= LONG_BYTES; done += LONG_BYTES) {
+		lo = *--sl;
+		*--dl = merge_words(lo, hi, shift);
+		hi = lo;
+	}
+
+	return done;
+}
+
 /**
  * memmove - Copy one area of memory to another
  * @dest: Where to copy to
@@ -531,23 +638,41 @@ void * memcpy(void *dest, const void *src, size_t count)
  */
 void * memmove(void * dest,const void *src,size_t count)
 {
-	char *tmp, *s;
+	unsigned long *dl;
+	const unsigned long *sl;
+	char *d8;
+	const char *s8;
+	size_t done;
 
 	if (src == dest)
 		return dest;
 
-	if (dest <= src) {
-		tmp = (char *) dest;
-		s = (char *) src;
-		while (count--)
-			*tmp++ = *s++;
+	if (dest <= src)
+		return copy_forward(dest, src, count);
+
+	/* copy backwards, bytes until the end is aligned, then words */
+	d8 = (char *)dest + count;
+	s8 = (const char *)src + count;
+	if (count >= 2 * LONG_BYTES) {
+		while ((ulong)d8 & LONG_MASK) {
+			*--d8 = *--s8;
+			count--;
 		}
-	else {
-		tmp = (char *) dest + count;
-		s = (char *) src + count;
-		while (count--)
-			*--tmp = *--s;
+		dl = (unsigned long *)d8;
+		if ((ulong)s8 & LONG_MASK) {
+			done = copy_shifted_back(dl, s8, count);
+		} else {
+			sl = (const unsigned long *)s8;
+			for (done = 0; count - done >= LONG_BYTES;
+			     done += LONG_BYTES)
+				*--dl = *--sl;
 		}
+		d8 -= done;
+		s8 -= done;
+		count -= done;
+	}
+	while (count--)
+		*--d8 = *--s8;
 
 	return dest;
 }
@@ -562,10 +687,27 @@ void * memmove(void * dest,const void *src,size_t count)
  */
 int memcmp(const void * cs,const void * ct,size_t count)
 {
-	const unsigned char *su1, *su2;
+	const unsigned char *su1 = cs, *su2 = ct;
 	int res = 0;
 
-	for( su1 = cs, su2 = ct; 0 < count; ++su1, ++su2, count--)
+	/*
+	 * If the areas are aligned alike, skip over equal words. The bytes
+	 * of the first word which differs are compared one by one below.
+	 */
+	if (count >= 2 * LONG_BYTES &&
+	    !(((ulong)su1 ^ (ulong)su2) & LONG_MASK)) {
+		for (; (ulong)su1 & LONG_MASK; ++su1, ++su2, count--)
+			if ((res = *su1 - *su2) != 0)
+				return res;
+		while (count >= LONG_BYTES &&
+		       *(const unsigned long *)su1 ==
+		       *(const unsigned long *)su2) {
+			su1 += LONG_BYTES;
+			su2 += LONG_BYTES;
+			count -= LONG_BYTES;
+		}
+	}
+	for (; 0 < count; ++su1, ++su2, count--)
 		if ((res = *su1 - *su2) != 0)
 			break;
 	return res;
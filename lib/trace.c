@@ -5,6 +5,7 @@
  */
 
 #include <common.h>
+#include <malloc.h>
 #include <mapmem.h>
 #include <trace.h>
 #include <asm/io.h>
@@ -15,6 +16,35 @@ DECLARE_GLOBAL_DATA_PTR;
 static char trace_enabled __attribute__((section(".data")));
 static char trace_inited __attribute__((section(".data")));
 
+#ifndef CONFIG_TRACE_TIMES_SIZE	/* functions with times, a power of 2 */
+#define CONFIG_TRACE_TIMES_SIZE	4096
+#endif
+#ifndef CONFIG_TRACE_SAMPLE	/* record one call in this many */
+#define CONFIG_TRACE_SAMPLE	1
+#endif
+
+enum {
+	TRACE_STACK_DEPTH	= 64,	/* call depth for which we keep times */
+	TRACE_TIMES_PROBES	= 32,	/* slots to try before giving up */
+};
+
+/* The time spent in a function, kept in a hash table indexed by function */
+struct trace_time {
+	uint32_t func;		/* Function number, valid if calls != 0 */
+	uint32_t calls;		/* Number of calls which returned */
+	uint64_t incl_us;	/* Time spent in the function and its callees */
+	uint64_t excl_us;	/* Time spent in the function itself */
+	uint32_t hist[TRACE_HIST_BUCKETS];	/* Calls by inclusive time */
+};
+
+/* A function which has been entered but has not returned yet */
+struct trace_frame {
+	uint32_t func;		/* Function number */
+	uint32_t start;		/* Time it was entered */
+	uint32_t child_us;	/* Time spent in its callees so far */
+	int traced;		/* Its entry is in the call list */
+};
+
 /* The header block at the start of the trace memory area */
 struct trace_hdr {
 	int func_count;		/* Total number of function call sites */
@@ -34,6 +64,20 @@ struct trace_hdr {
 	ulong ftrace_count;	/* Num. of ftrace records written */
 	ulong ftrace_too_deep_count;	/* Functions that were too deep */
 
+	/*
+	 * In ring mode the list keeps the most recent ftrace_size records,
+	 * with the next one written at ftrace_count % ftrace_size
+	 */
+	int ring;
+	uint sample;		/* Record one call in this many */
+	uint sample_left;	/* Calls to skip before recording one */
+	ulong ftrace_sampled_out;	/* Calls not recorded due to sampling */
+
+	/* Time spent in each function, and the calls still running */
+	struct trace_time *times;
+	u64 times_lost;		/* Calls not timed as there was no room */
+	struct trace_frame stack[TRACE_STACK_DEPTH];
+
 	int depth;
 	int depth_limit;
 	int max_depth;
@@ -57,33 +101,83 @@ static inline uintptr_t __attribute__((no_instrument_function))
 	return offset / FUNC_SITE_SIZE;
 }
 
-static void __attribute__((no_instrument_function)) add_ftrace(void *func_ptr,
-				void *caller, ulong flags)
+static void __attribute__((no_instrument_function)) add_record(ulong func,
+				ulong caller, ulong flags)
+{
+	ulong pos = hdr->ftrace_count;
+
+	if (hdr->ring && hdr->ftrace_size)
+		pos %= hdr->ftrace_size;
+	if (pos < hdr->ftrace_size) {
+		struct trace_call *rec = &hdr->ftrace[pos];
+
+		rec->func = func;
+		rec->caller = caller;
+		rec->flags = flags;
+	}
+	hdr->ftrace_count++;
+}
+
+/* Record a call, returning 1 if it was recorded, 0 if too deep */
+static int __attribute__((no_instrument_function)) add_ftrace(void *func_ptr,
+				void *caller, ulong flags, ulong now)
 {
 	if (hdr->depth > hdr->depth_limit) {
 		hdr->ftrace_too_deep_count++;
-		return;
+		return 0;
 	}
-	if (hdr->ftrace_count < hdr->ftrace_size) {
-		struct trace_call *rec = &hdr->ftrace[hdr->ftrace_count];
+	add_record(func_ptr_to_num(func_ptr), func_ptr_to_num(caller),
+		   flags | (now & FUNCF_TIMESTAMP_MASK));
 
-		rec->func = func_ptr_to_num(func_ptr);
-		rec->caller = func_ptr_to_num(caller);
-		rec->flags = flags | (timer_get_us() & FUNCF_TIMESTAMP_MASK);
-	}
-	hdr->ftrace_count++;
+	return 1;
 }
 
 static void __attribute__((no_instrument_function)) add_textbase(void)
 {
-	if (hdr->ftrace_count < hdr->ftrace_size) {
-		struct trace_call *rec = &hdr->ftrace[hdr->ftrace_count];
+	add_record(CONFIG_SYS_TEXT_BASE, 0, FUNCF_TEXTBASE);
+}
 
-		rec->func = CONFIG_SYS_TEXT_BASE;
-		rec->caller = 0;
-		rec->flags = FUNCF_TEXTBASE;
+/* Decide whether to record a call, when sampling */
+static int __attribute__((no_instrument_function)) sample_call(void)
+{
+	if (hdr->sample_left) {
+		hdr->sample_left--;
+		hdr->ftrace_sampled_out++;
+		return 0;
 	}
-	hdr->ftrace_count++;
+	hdr->sample_left = hdr->sample - 1;
+
+	return 1;
+}
+
+/* Add the time taken by a call to its function's times */
+static void __attribute__((no_instrument_function)) add_time(uint32_t func,
+				uint32_t incl_us, uint32_t excl_us)
+{
+	uint mask = CONFIG_TRACE_TIMES_SIZE - 1;
+	uint idx = (func * 0x9e3779b1U) >> 12;
+	struct trace_time *time;
+	int bucket, i;
+
+	for (i = 0; i < TRACE_TIMES_PROBES; i++, idx++) {
+		time = &hdr->times[idx & mask];
+		if (!time->calls || time->func == func)
+			break;
+	}
+	if (i == TRACE_TIMES_PROBES) {
+		hdr->times_lost++;
+		return;
+	}
+
+	/* Bucket n holds calls of at least 4^(n-1) us */
+	for (bucket = 0; incl_us >> (bucket * 2) &&
+	     bucket < TRACE_HIST_BUCKETS - 1; bucket++)
+		;
+	time->func = func;
+	time->calls++;
+	time->incl_us += incl_us;
+	time->excl_us += excl_us;
+	time->hist[bucket]++;
 }
 
 /**
@@ -99,9 +193,18 @@ void __attribute__((no_instrument_function)) __cyg_profile_func_enter(
 		void *func_ptr, void *caller)
 {
 	if (trace_enabled) {
-		int func;
+		ulong now = timer_get_us();
+		struct trace_frame *frame = NULL;
+		int func, traced;
 
-		add_ftrace(func_ptr, caller, FUNCF_ENTRY);
+		/*
+		 * The exit of a call outside our stack cannot tell whether its
+		 * entry was recorded, so only record those when not sampling
+		 */
+		if (hdr->depth >= 0 && hdr->depth < TRACE_STACK_DEPTH)
+			frame = &hdr->stack[hdr->depth];
+		traced = (frame || hdr->sample == 1) && sample_call() &&
+			add_ftrace(func_ptr, caller, FUNCF_ENTRY, now);
 		func = func_ptr_to_num(func_ptr);
 		if (func < hdr->func_count) {
 			hdr->call_accum[func]++;
@@ -109,6 +212,14 @@ void __attribute__((no_instrument_function)) __cyg_profile_func_enter(
 		} else {
 			hdr->untracked_count++;
 		}
+		if (frame) {
+			frame->func = func;
+			frame->start = now;
+			frame->child_us = 0;
+			frame->traced = traced;
+		} else {
+			hdr->times_lost++;
+		}
 		hdr->depth++;
 		if (hdr->depth > hdr->depth_limit)
 			hdr->max_depth = hdr->depth;
@@ -118,7 +229,8 @@ void __attribute__((no_instrument_function)) __cyg_profile_func_enter(
 /**
  * This is called on every function exit
  *
- * We do nothing here.
+ * We record the exit if we recorded the entry, and add the time taken to
+ * the function's times.
  *
  * @param func_ptr	Pointer to function being entered
  * @param caller	Pointer to function which called this function
@@ -127,7 +239,31 @@ void __attribute__((no_instrument_function)) __cyg_profile_func_exit(
 		void *func_ptr, void *caller)
 {
 	if (trace_enabled) {
-		add_ftrace(func_ptr, caller, FUNCF_EXIT);
+		ulong now = timer_get_us();
+		int depth = hdr->depth - 1;
+		struct trace_frame *frame;
+		uint32_t incl_us;
+
+		/*
+		 * Calls which were running when tracing started, or deeper
+		 * than our stack, are not timed. Their entries are only
+		 * recorded when not sampling, so the same goes for the exits.
+		 */
+		if (depth < 0 || depth >= TRACE_STACK_DEPTH ||
+		    hdr->stack[depth].func != func_ptr_to_num(func_ptr)) {
+			if (hdr->sample == 1)
+				add_ftrace(func_ptr, caller, FUNCF_EXIT, now);
+			hdr->depth--;
+			return;
+		}
+		frame = &hdr->stack[depth];
+		if (frame->traced)
+			add_record(frame->func, func_ptr_to_num(caller),
+				   FUNCF_EXIT | (now & FUNCF_TIMESTAMP_MASK));
+		incl_us = now - frame->start;
+		add_time(frame->func, incl_us, incl_us - frame->child_us);
+		if (depth)
+			frame[-1].child_us += incl_us;
 		hdr->depth--;
 	}
 }
@@ -192,8 +328,8 @@ int trace_list_calls(void *buff, int buff_size, unsigned *needed)
 {
 	struct trace_output_hdr *output_hdr = NULL;
 	void *end, *ptr = buff;
+	ulong first, count;
 	int rec, upto;
-	int count;
 
 	end = buff ? buff + buff_size : NULL;
 
@@ -202,15 +338,20 @@ int trace_list_calls(void *buff, int buff_size, unsigned *needed)
 		output_hdr = ptr;
 	ptr += sizeof(struct trace_output_hdr);
 
-	/* Add information about each call */
+	/* Add information about each call, oldest first */
 	count = hdr->ftrace_count;
-	if (count > hdr->ftrace_size)
+	first = 0;
+	if (count > hdr->ftrace_size) {
+		if (hdr->ring && hdr->ftrace_size)
+			first = count % hdr->ftrace_size;
 		count = hdr->ftrace_size;
+	}
 	for (rec = upto = 0; rec < count; rec++) {
 		if (ptr + sizeof(struct trace_call) < end) {
-			struct trace_call *call = &hdr->ftrace[rec];
+			struct trace_call *call;
 			struct trace_call *out = ptr;
 
+			call = &hdr->ftrace[(first + rec) % hdr->ftrace_size];
 			out->func = call->func * FUNC_SITE_SIZE;
 			out->caller = call->caller * FUNC_SITE_SIZE;
 			out->flags = call->flags;
@@ -232,6 +373,88 @@ int trace_list_calls(void *buff, int buff_size, unsigned *needed)
 	return 0;
 }
 
+int trace_list_times(void *buff, int buff_size, unsigned int *needed)
+{
+	struct trace_output_hdr *output_hdr = NULL;
+	void *end, *ptr = buff;
+	int i, upto;
+
+	end = buff ? buff + buff_size : NULL;
+
+	/* Place some header information */
+	if (ptr + sizeof(struct trace_output_hdr) < end)
+		output_hdr = ptr;
+	ptr += sizeof(struct trace_output_hdr);
+
+	/* Add the times of each function which has returned */
+	for (i = upto = 0; i < CONFIG_TRACE_TIMES_SIZE; i++) {
+		struct trace_time *time = &hdr->times[i];
+
+		if (!time->calls)
+			continue;
+		if (ptr + sizeof(struct trace_output_time) < end) {
+			struct trace_output_time *out = ptr;
+
+			out->offset = time->func * FUNC_SITE_SIZE;
+			out->call_count = time->calls;
+			out->incl_us = time->incl_us;
+			out->excl_us = time->excl_us;
+			memcpy(out->hist, time->hist, sizeof(out->hist));
+			upto++;
+		}
+		ptr += sizeof(struct trace_output_time);
+	}
+
+	/* Update the header */
+	if (output_hdr) {
+		output_hdr->rec_count = upto;
+		output_hdr->type = TRACE_CHUNK_TIMES;
+	}
+
+	/* Work out how must of the buffer we used */
+	*needed = ptr - buff;
+	if (ptr > end)
+		return -1;
+	return 0;
+}
+
+void trace_print_times(int count)
+{
+	struct trace_time *time, *prev = NULL;
+	int i;
+
+	if (!trace_inited) {
+		printf("Trace is disabled\n");
+		return;
+	}
+
+	/*
+	 * List the functions in order of the time spent in them. The table
+	 * cannot be sorted while tracing, so find each one in turn.
+	 */
+	puts("  Offset      Calls   Incl. us   Excl. us\n");
+	for (; count > 0; count--) {
+		struct trace_time *best = NULL;
+
+		for (i = 0; i < CONFIG_TRACE_TIMES_SIZE; i++) {
+			time = &hdr->times[i];
+			if (!time->calls)
+				continue;
+			if (prev && (time->excl_us > prev->excl_us ||
+				     (time->excl_us == prev->excl_us &&
+				      time <= prev)))
+				continue;
+			if (!best || time->excl_us > best->excl_us)
+				best = time;
+		}
+		if (!best)
+			break;
+		printf("%08x %10u %10llu %10llu\n", best->func * FUNC_SITE_SIZE,
+		       best->calls, best->incl_us, best->excl_us);
+		prev = best;
+	}
+}
+
 /* Print basic information about tracing */
 void trace_print_stats(void)
 {
@@ -255,10 +478,18 @@ void trace_print_stats(void)
 	print_grouped_ull(count, 10);
 	puts(" traced function calls");
 	if (hdr->ftrace_count > hdr->ftrace_size) {
-		printf(" (%lu dropped due to overflow)",
-		       hdr->ftrace_count - hdr->ftrace_size);
+		printf(" (%lu %s due to overflow)",
+		       hdr->ftrace_count - hdr->ftrace_size,
+		       hdr->ring ? "overwritten" : "dropped");
 	}
 	puts("\n");
+	if (hdr->sample > 1) {
+		print_grouped_ull(hdr->ftrace_sampled_out, 10);
+		printf(" calls not traced due to sampling (1 in %u)\n",
+		       hdr->sample);
+	}
+	print_grouped_ull(hdr->times_lost, 10);
+	puts(" calls not timed\n");
 	printf("%15d maximum observed call depth\n", hdr->max_depth);
 	printf("%15d call depth limit\n", hdr->depth_limit);
 	print_grouped_ull(hdr->ftrace_too_deep_count, 10);
@@ -270,6 +501,126 @@ void __attribute__((no_instrument_function)) trace_set_enabled(int enabled)
 	trace_enabled = enabled != 0;
 }
 
+int __attribute__((no_instrument_function)) trace_set_mode(int ring,
+		uint sample)
+{
+	if (!trace_inited || !sample)
+		return -1;
+
+	/* Start the list again, since the records are in a different order */
+	if (ring != hdr->ring) {
+		hdr->ftrace_count = 0;
+		add_textbase();
+	}
+	hdr->ring = ring;
+	hdr->sample = sample;
+	hdr->sample_left = 0;
+
+	return 0;
+}
+
+/*
+ * Set up the trace buffer, after the header and call counts, which take
+ * @needed bytes. Then come the function times and the function call list.
+ */
+static int __attribute__((no_instrument_function)) trace_setup(
+		size_t buff_size, size_t needed, int clear)
+{
+	size_t times_size;
+
+	times_size = CONFIG_TRACE_TIMES_SIZE * sizeof(struct trace_time);
+	if (needed + times_size > buff_size) {
+		printf("trace: buffer size %zd bytes: at least %zd needed\n",
+		       buff_size, needed + times_size);
+		return -1;
+	}
+	if (clear) {
+		memset(hdr, '\0', needed + times_size);
+#ifdef CONFIG_TRACE_RING
+		hdr->ring = 1;
+#endif
+		hdr->sample = CONFIG_TRACE_SAMPLE;
+	}
+	hdr->call_accum = (uintptr_t *)(hdr + 1);
+	hdr->times = (struct trace_time *)((char *)hdr + needed);
+
+	/* Use any remaining space for the timed function trace */
+	hdr->ftrace = (struct trace_call *)((char *)hdr->times + times_size);
+	hdr->ftrace_size = (buff_size - needed - times_size) /
+			sizeof(*hdr->ftrace);
+
+	return 0;
+}
+
+int __attribute__((no_instrument_function)) trace_test_state(int records)
+{
+	static struct trace_hdr *saved_hdr;
+	static char saved_enabled, saved_inited;
+	static char testing;
+	size_t size;
+	void *buff;
+
+	if (!records) {
+		if (!testing)
+			return -1;
+		trace_enabled = 0;
+		free(hdr);
+		hdr = saved_hdr;
+		trace_inited = saved_inited;
+		trace_enabled = saved_enabled;
+		testing = 0;
+
+		return 0;
+	}
+	if (testing)
+		return -1;
+
+	/* No function counts are kept, so all calls are untracked */
+	size = sizeof(*hdr) + CONFIG_TRACE_TIMES_SIZE *
+		sizeof(struct trace_time) + records * sizeof(struct trace_call);
+	buff = malloc(size);
+	if (!buff)
+		return -1;
+	saved_enabled = trace_enabled;
+	trace_enabled = 0;
+	saved_hdr = hdr;
+	saved_inited = trace_inited;
+	hdr = buff;
+	trace_setup(size, sizeof(*hdr), 1);
+	add_textbase();
+	hdr->depth_limit = 15;
+	trace_inited = 1;
+	testing = 1;
+
+	return 0;
+}
+
+#ifdef CONFIG_TRACE_EARLY
+/*
+ * Put the calls recorded in a ring in order, so that the oldest is first.
+ * This reverses the two parts of the ring and then the whole list.
+ */
+static void __attribute__((no_instrument_function)) trace_unwrap(void)
+{
+	ulong size = hdr->ftrace_size;
+	ulong first = hdr->ftrace_count % size;
+	ulong parts[][2] = { { 0, first }, { first, size }, { 0, size } };
+	struct trace_call tmp;
+	ulong i, j;
+	int part;
+
+	for (part = 0; part < ARRAY_SIZE(parts); part++) {
+		for (i = parts[part][0], j = parts[part][1]; i + 1 < j;
+		     i++, j--) {
+			tmp = hdr->ftrace[i];
+			hdr->ftrace[i] = hdr->ftrace[j - 1];
+			hdr->ftrace[j - 1] = tmp;
+		}
+	}
+	hdr->ftrace_count = size;
+}
+#endif
+
 /**
  * Init the tracing system ready for used, and enable it
  *
@@ -295,7 +646,11 @@ int __attribute__((no_instrument_function)) trace_init(void *buff,
 		trace_enabled = 0;
 		hdr = map_sysmem(CONFIG_TRACE_EARLY_ADDR,
 				 CONFIG_TRACE_EARLY_SIZE);
-		end = (char *)&hdr->ftrace[hdr->ftrace_count];
+		if (hdr->ring && hdr->ftrace_size &&
+		    hdr->ftrace_count > hdr->ftrace_size)
+			trace_unwrap();
+		end = (char *)&hdr->ftrace[min(hdr->ftrace_count,
+					       hdr->ftrace_size)];
 		used = end - (char *)hdr;
 		printf("trace: copying %08lx bytes of early data from %x to %08lx\n",
 		       used, CONFIG_TRACE_EARLY_ADDR,
@@ -308,20 +663,9 @@ int __attribute__((no_instrument_function)) trace_init(void *buff,
 	}
 	hdr = (struct trace_hdr *)buff;
 	needed = sizeof(*hdr) + func_count * sizeof(uintptr_t);
-	if (needed > buff_size) {
-		printf("trace: buffer size %zd bytes: at least %zd needed\n",
-		       buff_size, needed);
+	if (trace_setup(buff_size, needed, was_disabled))
 		return -1;
-	}
-
-	if (was_disabled)
-		memset(hdr, '\0', needed);
 	hdr->func_count = func_count;
-	hdr->call_accum = (uintptr_t *)(hdr + 1);
-
-	/* Use any remaining space for the timed function trace */
-	hdr->ftrace = (struct trace_call *)(buff + needed);
-	hdr->ftrace_size = (buff_size - needed) / sizeof(*hdr->ftrace);
 	add_textbase();
 
 	puts("trace: enabled\n");
@@ -344,19 +688,9 @@ int __attribute__((no_instrument_function)) trace_early_init(void)
 
 	hdr = map_sysmem(CONFIG_TRACE_EARLY_ADDR, CONFIG_TRACE_EARLY_SIZE);
 	needed = sizeof(*hdr) + func_count * sizeof(uintptr_t);
-	if (needed > buff_size) {
-		printf("trace: buffer size is %zd bytes, at least %zd needed\n",
-		       buff_size, needed);
+	if (trace_setup(buff_size, needed, 1))
 		return -1;
-	}
-
-	memset(hdr, '\0', needed);
-	hdr->call_accum = (uintptr_t *)(hdr + 1);
 	hdr->func_count = func_count;
-
-	/* Use any remaining space for the timed function trace */
-	hdr->ftrace = (struct trace_call *)((char *)hdr + needed);
-	hdr->ftrace_size = (buff_size - needed) / sizeof(*hdr->ftrace);
 	add_textbase();
 	hdr->depth_limit = 200;
 	printf("trace: early enable at %08x\n", CONFIG_TRACE_EARLY_ADDR);
@@ -12,25 +12,144 @@
 
 #ifndef ASMINF
 
-/* Allow machine dependent optimization for post-increment or pre-increment.
-   Based on testing to date,
-   Pre-increment preferred for:
-   - PowerPC G3 (Adler)
-   - MIPS R5000 (Randers-Pehrson)
-   Post-increment preferred for:
-   - none
-   No measurable difference:
-   - Pentium III (Anderson)
-   - M68060 (Nikl)
+/*
+   U-Boot: matches are copied a machine word at a time rather than a byte at
+   a time. This matters on slow cores, where inflating the kernel takes
+   longer than loading it. Where the CPU can load and store a word at any
+   address, the bit buffer is also refilled a word at a time while there is
+   enough input left. Elsewhere get_unaligned() itself works a byte at a
+   time, so words are only loaded and stored at aligned addresses.
  */
-#ifdef POSTINC
-#  define OFF 0
-#  define PUP(a) *(a)++
+#define WORD    sizeof(unsigned long)
+
+#ifdef CONFIG_HAVE_EFFICIENT_UNALIGNED_ACCESS
+#if BITS_PER_LONG == 64
+#  define LOADWORD(p) get_unaligned_le64(p)
 #else
-#  define OFF 1
-#  define PUP(a) *++(a)
+#  define LOADWORD(p) get_unaligned_le32(p)
 #endif
 
+/*
+   Copy len bytes from from to out and return the new out. from must be in
+   another buffer, or at least WORD bytes behind out, so that each word is
+   read before it is overwritten. The last word is copied so that it ends
+   exactly at the end, which may write some bytes twice.
+ */
+local inline unsigned char FAR *copy_fwd(unsigned char FAR *out,
+                                         const unsigned char FAR *from,
+                                         unsigned len)
+{
+    unsigned char FAR *end = out + len;
+
+    if (len < WORD) {
+        while (len--)
+            *out++ = *from++;
+        return end;
+    }
+    do {
+        put_unaligned(get_unaligned((const unsigned long *)from),
+                      (unsigned long *)out);
+        out += WORD;
+        from += WORD;
+        len -= WORD;
+    } while (len >= WORD);
+    if (len)
+        put_unaligned(get_unaligned((const unsigned long *)
+                                    (from + len - WORD)),
+                      (unsigned long *)(end - WORD));
+    return end;
+}
+#else
+/* Bytes a and b in memory order, from byte shift / 8 of a onwards */
+#if defined(__BIG_ENDIAN)
+#  define MERGEWORD(a, b, shift) \
+        ((a) << (shift) | (b) >> (BITS_PER_LONG - (shift)))
+#else
+#  define MERGEWORD(a, b, shift) \
+        ((a) >> (shift) | (b) << (BITS_PER_LONG - (shift)))
+#endif
+
+/*
+   Copy len bytes from from to out and return the new out. from must be in
+   another buffer, or at least WORD bytes behind out, so that each word is
+   read before it is overwritten. Bytes are copied until out is aligned,
+   then whole words: loaded directly when from is aligned too, otherwise
+   merged from the two aligned words which hold them. Merging reads one
+   word ahead, so it needs from to be at least two words behind out; if it
+   is not, the rest is copied a byte at a time.
+ */
+local inline unsigned char FAR *copy_fwd(unsigned char FAR *out,
+                                         const unsigned char FAR *from,
+                                         unsigned len)
+{
+    const unsigned long FAR *src;
+    unsigned long FAR *dst;
+    unsigned long w0, w1;
+    unsigned shift;
+
+    if (len >= 2 * WORD) {
+        while ((uintptr_t)out & (WORD - 1)) {
+            *out++ = *from++;
+            len--;
+        }
+        dst = (unsigned long FAR *)out;
+        shift = ((uintptr_t)from & (WORD - 1)) * 8;
+        if (!shift) {
+            src = (const unsigned long FAR *)from;
+            do {
+                *dst++ = *src++;
+                len -= WORD;
+            } while (len >= WORD);
+        }
+        else if ((size_t)(out - from) >= 2 * WORD) {
+            src = (const unsigned long FAR *)(from - shift / 8);
+            w0 = *src++;
+            do {
+                w1 = *src++;
+                *dst++ = MERGEWORD(w0, w1, shift);
+                w0 = w1;
+                len -= WORD;
+            } while (len >= WORD);
+        }
+        from += (unsigned char FAR *)dst - out;
+        out = (unsigned char FAR *)dst;
+    }
+    while (len--)
+        *out++ = *from++;
+    return out;
+}
+#endif /* CONFIG_HAVE_EFFICIENT_UNALIGNED_ACCESS */
+
+/*
+   Copy a match of len bytes from dist bytes back in the output and return
+   the new out. The output repeats every dist bytes, so it also repeats
+   every multiple of dist: when dist is less than a word and len is not,
+   copy bytes one at a time until the rest can be copied from a multiple of
+   dist which is at least a word back. That multiple must still be in the
+   output. Without unaligned access, a multiple which is not a whole number
+   of words is taken at least two words back, so that copy_fwd() can merge
+   words.
+ */
+local inline unsigned char FAR *copy_match(unsigned char FAR *out,
+                                           unsigned dist, unsigned len)
+{
+    const unsigned char FAR *from = out - dist;
+    unsigned step, n;
+
+    if (dist < WORD && len >= WORD) {
+        for (step = dist; step < WORD; step += dist)
+            ;
+#ifndef CONFIG_HAVE_EFFICIENT_UNALIGNED_ACCESS
+        while (step % WORD && step < 2 * WORD)
+            step += dist;
+#endif
+        for (n = step - dist; n && len; n--, len--)
+            *out++ = *from++;
+        from = out - step;
+    }
+    return copy_fwd(out, from, len);
+}
+
 /*
    Decode literal, length, and distance codes and write out the resulting
    literal and match bytes until either not enough input or output is
@@ -65,6 +184,10 @@
       bytes, which is the maximum length that can be coded.  inflate_fast()
       requires strm->avail_out >= 258 for each loop to avoid checking for
       output space.
+
+    - A word refill may load bits beyond those counted in bits, so bits are
+      added to hold with | rather than +. The extra bits are the ones which
+      come next in the input, so loading them again does not change them.
  */
 void inflate_fast(z_streamp strm, unsigned start)
 /* start: inflate()'s starting value for strm->avail_out */
@@ -72,6 +195,9 @@ void inflate_fast(z_streamp strm, unsigned start)
     struct inflate_state FAR *state;
     unsigned char FAR *in;      /* local strm->next_in */
     unsigned char FAR *last;    /* while in < last, enough input available */
+#ifdef CONFIG_HAVE_EFFICIENT_UNALIGNED_ACCESS
+    unsigned char FAR *lastw;   /* while in < lastw, a word can be loaded */
+#endif
     unsigned char FAR *out;     /* local strm->next_out */
     unsigned char FAR *beg;     /* inflate()'s initial strm->next_out */
     unsigned char FAR *end;     /* while out < end, enough space available */
@@ -97,7 +223,7 @@ void inflate_fast(z_streamp strm, unsigned start)
 
     /* copy state to local variables */
     state = (struct inflate_state FAR *)strm->state;
-    in = strm->next_in - OFF;
+    in = strm->next_in;
     last = in + (strm->avail_in - 5);
     if (in > last && strm->avail_in > 5) {
         /*
@@ -107,7 +233,10 @@ void inflate_fast(z_streamp strm, unsigned start)
 	strm->avail_in = 0xffffffff - (uintptr_t)in;
         last = in + (strm->avail_in - 5);
     }
-    out = strm->next_out - OFF;
+#ifdef CONFIG_HAVE_EFFICIENT_UNALIGNED_ACCESS
+    lastw = last - 3;
+#endif
+    out = strm->next_out;
     beg = out - (start - strm->avail_out);
     end = out + (strm->avail_out - 257);
 #ifdef INFLATE_STRICT
@@ -124,15 +253,37 @@ void inflate_fast(z_streamp strm, unsigned start)
     lmask = (1U << state->lenbits) - 1;
     dmask = (1U << state->distbits) - 1;
 
+/* Get at least 15 bits, as many as fit when there is enough input */
+#ifdef CONFIG_HAVE_EFFICIENT_UNALIGNED_ACCESS
+#define REFILL() \
+    do { \
+        if (in < lastw) { \
+            hold |= (unsigned long)LOADWORD(in) << bits; \
+            in += (BITS_PER_LONG - 1 - bits) >> 3; \
+            bits |= BITS_PER_LONG - 8; \
+        } \
+        else { \
+            hold |= (unsigned long)(*in++) << bits; \
+            bits += 8; \
+            hold |= (unsigned long)(*in++) << bits; \
+            bits += 8; \
+        } \
+    } while (0)
+#else
+#define REFILL() \
+    do { \
+        hold += (unsigned long)(*in++) << bits; \
+        bits += 8; \
+        hold += (unsigned long)(*in++) << bits; \
+        bits += 8; \
+    } while (0)
+#endif
+
     /* decode literals and length/distances until end-of-block or not enough
        input data or output space */
     do {
-        if (bits < 15) {
-            hold += (unsigned long)(PUP(in)) << bits;
-            bits += 8;
-            hold += (unsigned long)(PUP(in)) << bits;
-            bits += 8;
-        }
+        if (bits < 15)
+            REFILL();
         this = lcode[hold & lmask];
       dolen:
         op = (unsigned)(this.bits);
@@ -143,14 +294,14 @@ void inflate_fast(z_streamp strm, unsigned start)
             Tracevv((stderr, this.val >= 0x20 && this.val < 0x7f ?
                     "inflate:         literal '%c'\n" :
                     "inflate:         literal 0x%02x\n", this.val));
-            PUP(out) = (unsigned char)(this.val);
+            *out++ = (unsigned char)(this.val);
         }
         else if (op & 16) {                     /* length base */
             len = (unsigned)(this.val);
             op &= 15;                           /* number of extra bits */
             if (op) {
                 if (bits < op) {
-                    hold += (unsigned long)(PUP(in)) << bits;
+                    hold |= (unsigned long)(*in++) << bits;
                     bits += 8;
                 }
                 len += (unsigned)hold & ((1U << op) - 1);
@@ -158,12 +309,8 @@ void inflate_fast(z_streamp strm, unsigned start)
                 bits -= op;
             }
             Tracevv((stderr, "inflate:         length %u\n", len));
-            if (bits < 15) {
-                hold += (unsigned long)(PUP(in)) << bits;
-                bits += 8;
-                hold += (unsigned long)(PUP(in)) << bits;
-                bits += 8;
-            }
+            if (bits < 15)
+                REFILL();
             this = dcode[hold & dmask];
           dodist:
             op = (unsigned)(this.bits);
@@ -174,10 +321,10 @@ void inflate_fast(z_streamp strm, unsigned start)
                 dist = (unsigned)(this.val);
                 op &= 15;                       /* number of extra bits */
                 if (bits < op) {
-                    hold += (unsigned long)(PUP(in)) << bits;
+                    hold |= (unsigned long)(*in++) << bits;
                     bits += 8;
                     if (bits < op) {
-                        hold += (unsigned long)(PUP(in)) << bits;
+                        hold |= (unsigned long)(*in++) << bits;
                         bits += 8;
                     }
                 }
@@ -200,15 +347,13 @@ void inflate_fast(z_streamp strm, unsigned start)
                         state->mode = BAD;
                         break;
                     }
-                    from = window - OFF;
+                    from = window;
                     if (write == 0) {           /* very common case */
                         from += wsize - op;
                         if (op < len) {         /* some from window */
                             len -= op;
-                            do {
-                                PUP(out) = PUP(from);
-                            } while (--op);
-                            from = out - dist;  /* rest from output */
+                            out = copy_fwd(out, from, op);
+                            from = Z_NULL;      /* rest from output */
                         }
                     }
                     else if (write < op) {      /* wrap around window */
@@ -216,17 +361,13 @@ void inflate_fast(z_streamp strm, unsigned start)
                         op -= write;
                         if (op < len) {         /* some from end of window */
                             len -= op;
-                            do {
-                                PUP(out) = PUP(from);
-                            } while (--op);
-                            from = window - OFF;
+                            out = copy_fwd(out, from, op);
+                            from = window;
                             if (write < len) {  /* some from start of window */
                                 op = write;
                                 len -= op;
-                                do {
-                                    PUP(out) = PUP(from);
-                                } while (--op);
-                                from = out - dist;      /* rest from output */
+                                out = copy_fwd(out, from, op);
+                                from = Z_NULL;  /* rest from output */
                             }
                         }
                     }
@@ -234,67 +375,22 @@ void inflate_fast(z_streamp strm, unsigned start)
                         from += write - op;
                         if (op < len) {         /* some from window */
                             len -= op;
-                            do {
-                                PUP(out) = PUP(from);
-                            } while (--op);
-                            from = out - dist;  /* rest from output */
+                            out = copy_fwd(out, from, op);
+                            from = Z_NULL;      /* rest from output */
                         }
                     }
-                    while (len > 2) {
-                        PUP(out) = PUP(from);
-                        PUP(out) = PUP(from);
-                        PUP(out) = PUP(from);
-                        len -= 3;
+                    if (from != Z_NULL)
+                        out = copy_fwd(out, from, len);
+                    else if (dist >= WORD)
+                        out = copy_fwd(out, out - dist, len);
+                    else {                      /* too near the start */
+                        from = out - dist;
+                        while (len--)
+                            *out++ = *from++;
                     }
-                    if (len) {
-                        PUP(out) = PUP(from);
-                        if (len > 1)
-                            PUP(out) = PUP(from);
-                    }
-                }
-                else {
-		    unsigned short *sout;
-		    unsigned long loops;
-
-                    from = out - dist;          /* copy direct from output */
-                    /* minimum length is three */
-		    /* Align out addr */
-		    if (!((long)(out - 1 + OFF) & 1)) {
-			PUP(out) = PUP(from);
-			len--;
-		    }
-		    sout = (unsigned short *)(out - OFF);
-		    if (dist > 2 ) {
-			unsigned short *sfrom;
-
-			sfrom = (unsigned short *)(from - OFF);
-			loops = len >> 1;
-			do
-			    PUP(sout) = get_unaligned(++sfrom);
-			while (--loops);
-			out = (unsigned char *)sout + OFF;
-			from = (unsigned char *)sfrom + OFF;
-		    } else { /* dist == 1 or dist == 2 */
-			unsigned short pat16;
-
-			pat16 = *(sout-2+2*OFF);
-			if (dist == 1)
-#if defined(__BIG_ENDIAN)
-			    pat16 = (pat16 & 0xff) | ((pat16 & 0xff ) << 8);
-#elif defined(__LITTLE_ENDIAN)
-			    pat16 = (pat16 & 0xff00) | ((pat16 & 0xff00 ) >> 8);
-#else
-#error __BIG_ENDIAN nor __LITTLE_ENDIAN is defined
-#endif
-			loops = len >> 1;
-			do
-			    PUP(sout) = pat16;
-			while (--loops);
-			out = (unsigned char *)sout + OFF;
-		    }
-		    if (len & 1)
-			PUP(out) = PUP(from);
                 }
+                else                            /* copy direct from output */
+                    out = copy_match(out, dist, len);
             }
             else if ((op & 64) == 0) {          /* 2nd level distance code */
                 this = dcode[this.val + (hold & ((1U << op) - 1))];
@@ -322,6 +418,8 @@ void inflate_fast(z_streamp strm, unsigned start)
         }
     } while (in < last && out < end);
 
+#undef REFILL
+
     /* return unused bytes (on entry, bits < 8, so in won't go too far back) */
     len = bits >> 3;
     in -= len;
@@ -329,8 +427,8 @@ void inflate_fast(z_streamp strm, unsigned start)
     hold &= (1U << bits) - 1;
 
     /* update state and return */
-    strm->next_in = in + OFF;
-    strm->next_out = out + OFF;
+    strm->next_in = in;
+    strm->next_out = out;
     strm->avail_in = (unsigned)(in < last ? 5 + (last - in) : 5 - (in - last));
     strm->avail_out = (unsigned)(out < end ?
                                  257 + (end - out) : 257 - (out - end));
@@ -111,6 +111,36 @@ static void eth_common_init(void)
 	}
 }
 
+/*
+ * Process up to 32 packets at one time, asking @recv_batch for them in
+ * batches until it has no more. Returns the number of packets processed, or
+ * the error from the first batch which fails.
+ */
+static int eth_rx_batches(void *dev,
+			  int (*recv_batch)(void *dev, uchar **packets,
+					    int *lengths, int max))
+{
+	uchar *packets[ETH_RX_BATCH];
+	int lengths[ETH_RX_BATCH];
+	int total, ret, i;
+
+	for (total = 0; total < 32; total += ret) {
+		ret = recv_batch(dev, packets, lengths, ETH_RX_BATCH);
+		if (ret < 0)
+			return ret;
+		for (i = 0; i < ret; i++)
+			net_process_received_packet(packets[i], lengths[i]);
+		/*
+		 * A driver may hand over a short batch to keep part of its
+		 * ring with the hardware, so only stop when there is nothing
+		 */
+		if (!ret)
+			break;
+	}
+
+	return total;
+}
+
 #ifdef CONFIG_DM_ETH
 /**
  * struct eth_device_priv - private structure for each Ethernet device
@@ -400,6 +430,13 @@ int eth_send(void *packet, int length)
 	return ret;
 }
 
+static int eth_recv_batch(void *dev, uchar **packets, int *lengths, int max)
+{
+	struct udevice *udev = dev;
+
+	return eth_get_ops(udev)->recv_batch(udev, packets, lengths, max);
+}
+
 int eth_rx(void)
 {
 	struct udevice *current;
@@ -414,6 +451,14 @@ int eth_rx(void)
 	if (!device_active(current))
 		return -EINVAL;
 
+	if (eth_get_ops(current)->recv_batch) {
+		ret = eth_rx_batches(current, eth_recv_batch);
+		if (ret < 0)
+			debug("%s: recv_batch() returned error %d\n", __func__,
+			      ret);
+		return ret;
+	}
+
 	/* Process up to 32 packets at one time */
 	for (i = 0; i < 32; i++) {
 		ret = eth_get_ops(current)->recv(current, &packet);
@@ -914,12 +959,22 @@ int eth_send(void *packet, int length)
 	return eth_current->send(eth_current, packet, length);
 }
 
+static int eth_recv_batch(void *dev, uchar **packets, int *lengths, int max)
+{
+	struct eth_device *eth = dev;
+
+	return eth->recv_batch(eth, packets, lengths, max);
+}
+
 int eth_rx(void)
 {
 	if (!eth_current)
 		return -ENODEV;
 
-	return eth_current->recv(eth_current);
+	if (!eth_current->recv_batch)
+		return eth_current->recv(eth_current);
+
+	return eth_rx_batches(eth_current, eth_recv_batch);
 }
 #endif /* ifndef CONFIG_DM_ETH */
 
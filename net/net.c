@@ -78,6 +78,15 @@
  *			- own IP address
  *	We want:	- network time
  *	Next step:	none
+ *
+ * WGET:
+ *
+ *	Prerequisites:	- own ethernet address
+ *			- own IP address
+ *			- HTTP server IP address
+ *			- path of the file on the server
+ *	We want:	- load the file, over TCP
+ *	Next step:	none
  */
 
 
@@ -105,7 +114,13 @@
 #if defined(CONFIG_CMD_SNTP)
 #include "sntp.h"
 #endif
+#if defined(CONFIG_PROT_TCP)
+#include "tcp.h"
+#endif
 #include "tftp.h"
+#if defined(CONFIG_CMD_WGET)
+#include "wget.h"
+#endif
 
 DECLARE_GLOBAL_DATA_PTR;
 
@@ -483,6 +498,11 @@ restart:
 			nfs_start();
 			break;
 #endif
+#if defined(CONFIG_CMD_WGET)
+		case WGET:
+			wget_start();
+			break;
+#endif
 #if defined(CONFIG_CMD_CDP)
 		case CDP:
 			cdp_start();
@@ -775,8 +795,6 @@ int net_send_udp_packet(uchar *ether, struct in_addr dest, int dport, int sport,
 		int payload_len)
 {
 	uchar *pkt;
-	int eth_hdr_size;
-	int pkt_hdr_size;
 
 	/* make sure the net_tx_packet is initialized (net_init() was called) */
 	assert(net_tx_packet != NULL);
@@ -787,16 +805,21 @@ int net_send_udp_packet(uchar *ether, struct in_addr dest, int dport, int sport,
 	if (dest.s_addr == 0)
 		dest.s_addr = 0xFFFFFFFF;
 
+	pkt = (uchar *)net_tx_packet + net_eth_hdr_size();
+	net_set_udp_header(pkt, dest, dport, sport, payload_len);
+
+	return net_send_ip_packet(ether, dest, IP_UDP_HDR_SIZE + payload_len);
+}
+
+int net_send_ip_packet(uchar *ether, struct in_addr dest, int len)
+{
+	int eth_hdr_size;
+
 	/* if broadcast, make the ether address a broadcast and don't do ARP */
 	if (dest.s_addr == 0xFFFFFFFF)
 		ether = (uchar *)net_bcast_ethaddr;
 
-	pkt = (uchar *)net_tx_packet;
-
-	eth_hdr_size = net_set_ether(pkt, ether, PROT_IP);
-	pkt += eth_hdr_size;
-	net_set_udp_header(pkt, dest, dport, sport, payload_len);
-	pkt_hdr_size = eth_hdr_size + IP_UDP_HDR_SIZE;
+	eth_hdr_size = net_set_ether(net_tx_packet, ether, PROT_IP);
 
 	/* if MAC address was not discovered yet, do an ARP request */
 	if (memcmp(ether, net_null_ethaddr, 6) == 0) {
@@ -807,7 +830,7 @@ int net_send_udp_packet(uchar *ether, struct in_addr dest, int dport, int sport,
 		arp_wait_packet_ethaddr = ether;
 
 		/* size of the waiting packet */
-		arp_wait_tx_packet_size = pkt_hdr_size + payload_len;
+		arp_wait_tx_packet_size = eth_hdr_size + len;
 
 		/* and do the ARP request */
 		arp_wait_try = 1;
@@ -815,9 +838,9 @@ int net_send_udp_packet(uchar *ether, struct in_addr dest, int dport, int sport,
 		arp_request();
 		return 1;	/* waiting */
 	} else {
-		debug_cond(DEBUG_DEV_PKT, "sending UDP to %pI4/%pM\n",
+		debug_cond(DEBUG_DEV_PKT, "sending IP to %pI4/%pM\n",
 			   &dest, ether);
-		net_send_packet(net_tx_packet, pkt_hdr_size + payload_len);
+		net_send_packet(net_tx_packet, eth_hdr_size + len);
 		return 0;	/* transmitted */
 	}
 }
@@ -826,20 +849,21 @@ int net_send_udp_packet(uchar *ether, struct in_addr dest, int dport, int sport,
 /*
  * This function collects fragments in a single packet, according
  * to the algorithm in RFC815. It returns NULL or the pointer to
- * a complete packet, in static storage
+ * a complete packet, in static storage. Up to CONFIG_NET_DEFRAG_SLOTS
+ * packets can be collected at once, so fragments of different packets
+ * may be interleaved.
  */
-#ifndef CONFIG_NET_MAXDEFRAG
-#define CONFIG_NET_MAXDEFRAG 16384
-#endif
 /*
- * MAXDEFRAG, above, is chosen in the config file and  is real data
- * so we need to add the NFS overhead, which is more than TFTP.
+ * MAXDEFRAG (see net.h) is chosen in the config file and  is real data
+ * so we need to add the IP and UDP headers and the NFS overhead, which is
+ * more than TFTP.
  * To use sizeof in the internal unnamed structures, we need a real
  * instance (can't do "sizeof(struct rpc_t.u.reply))", unfortunately).
  * The compiler doesn't complain nor allocates the actual structure
  */
 static struct rpc_t rpc_specimen;
-#define IP_PKTSIZE (CONFIG_NET_MAXDEFRAG + sizeof(rpc_specimen.u.reply))
+#define IP_PKTSIZE (CONFIG_NET_MAXDEFRAG + IP_UDP_HDR_SIZE + \
+		    sizeof(rpc_specimen.u.reply))
 
 #define IP_MAXUDP (IP_PKTSIZE - IP_HDR_SIZE)
 
@@ -851,41 +875,120 @@ struct hole {
 	/* first_byte is address of this structure */
 	u16 last_byte;	/* last byte in this hole + 1 (begin of next hole) */
 	u16 next_hole;	/* index of next (in 8-b blocks), 0 == none */
-	u16 prev_hole;	/* index of prev, 0 == none */
+	u16 prev_hole;	/* index of prev, unused in the first hole */
 	u16 unused;
 };
 
+/*
+ * A packet being assembled. Each one takes IP_PKTSIZE bytes, so the memory
+ * used is fixed by CONFIG_NET_MAXDEFRAG and CONFIG_NET_DEFRAG_SLOTS.
+ */
+struct defrag_slot {
+	uchar pkt_buff[IP_PKTSIZE] __aligned(PKTALIGN);
+	ulong start;		/* time the first fragment arrived */
+	u16 first_hole;
+	u16 total_len;		/* 0xffff until known, 0 if slot is free */
+};
+
+static struct defrag_slot defrag_slots[CONFIG_NET_DEFRAG_SLOTS];
+static struct net_defrag_stats defrag_stats;
+
+void net_defrag_reset(void)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_NET_DEFRAG_SLOTS; i++)
+		defrag_slots[i].total_len = 0;
+	memset(&defrag_stats, '\0', sizeof(defrag_stats));
+}
+
+const struct net_defrag_stats *net_defrag_get_stats(void)
+{
+	return &defrag_stats;
+}
+
+/*
+ * Find the slot for the packet a fragment belongs to. If there is none, a
+ * free slot is set up for it, or the oldest one is reused.
+ */
+static struct defrag_slot *net_defrag_slot(struct ip_udp_hdr *ip)
+{
+	struct defrag_slot *slot, *free = NULL, *oldest = NULL;
+	struct ip_udp_hdr *localip;
+	struct hole *payload;
+	ulong now = get_timer(0);
+	int i;
+
+	for (i = 0, slot = defrag_slots; i < CONFIG_NET_DEFRAG_SLOTS;
+	     i++, slot++) {
+		if (slot->total_len &&
+		    now - slot->start > CONFIG_NET_DEFRAG_TIMEOUT) {
+			localip = (struct ip_udp_hdr *)slot->pkt_buff;
+			debug("defrag: packet %#x timed out\n",
+			      ntohs(localip->ip_id));
+			slot->total_len = 0;
+			defrag_stats.timeouts++;
+		}
+		if (!slot->total_len) {
+			if (!free)
+				free = slot;
+			continue;
+		}
+		/* Fragments of a packet have the same ID, source, protocol */
+		localip = (struct ip_udp_hdr *)slot->pkt_buff;
+		if (localip->ip_id == ip->ip_id && localip->ip_p == ip->ip_p &&
+		    !memcmp(&localip->ip_src, &ip->ip_src, sizeof(ip->ip_src)))
+			return slot;
+		if (!oldest || now - slot->start > now - oldest->start)
+			oldest = slot;
+	}
+	if (!free) {
+		free = oldest;
+		defrag_stats.evicted++;
+	}
+
+	/* new packet, reset structs */
+	slot = free;
+	payload = (struct hole *)(slot->pkt_buff + IP_HDR_SIZE);
+	slot->start = now;
+	slot->total_len = 0xffff;
+	payload[0].last_byte = ~0;
+	payload[0].next_hole = 0;
+	payload[0].prev_hole = 0;
+	slot->first_hole = 0;
+	/* any IP header will work, copy the first we received */
+	memcpy(slot->pkt_buff, ip, IP_HDR_SIZE);
+
+	return slot;
+}
+
 static struct ip_udp_hdr *__net_defragment(struct ip_udp_hdr *ip, int *lenp)
 {
-	static uchar pkt_buff[IP_PKTSIZE] __aligned(PKTALIGN);
-	static u16 first_hole, total_len;
+	struct defrag_slot *slot;
 	struct hole *payload, *thisfrag, *h, *newh;
-	struct ip_udp_hdr *localip = (struct ip_udp_hdr *)pkt_buff;
+	struct ip_udp_hdr *localip;
 	uchar *indata = (uchar *)ip;
 	int offset8, start, len, done = 0;
 	u16 ip_off = ntohs(ip->ip_off);
+	bool first;
 
-	/* payload starts after IP header, this fragment is in there */
-	payload = (struct hole *)(pkt_buff + IP_HDR_SIZE);
+	defrag_stats.fragments++;
 	offset8 =  (ip_off & IP_OFFS);
-	thisfrag = payload + offset8;
 	start = offset8 * 8;
 	len = ntohs(ip->ip_len) - IP_HDR_SIZE;
 
-	if (start + len > IP_MAXUDP) /* fragment extends too far */
+	if (start + len > IP_MAXUDP) { /* fragment extends too far */
+		defrag_stats.dropped++;
 		return NULL;
-
-	if (!total_len || localip->ip_id != ip->ip_id) {
-		/* new (or different) packet, reset structs */
-		total_len = 0xffff;
-		payload[0].last_byte = ~0;
-		payload[0].next_hole = 0;
-		payload[0].prev_hole = 0;
-		first_hole = 0;
-		/* any IP header will work, copy the first we received */
-		memcpy(localip, ip, IP_HDR_SIZE);
 	}
 
+	slot = net_defrag_slot(ip);
+	localip = (struct ip_udp_hdr *)slot->pkt_buff;
+
+	/* payload starts after IP header, this fragment is in there */
+	payload = (struct hole *)(slot->pkt_buff + IP_HDR_SIZE);
+	thisfrag = payload + offset8;
+
 	/*
 	 * What follows is the reassembly algorithm. We use the payload
 	 * array as a linked list of hole descriptors, as each hole starts
@@ -893,10 +996,11 @@ static struct ip_udp_hdr *__net_defragment(struct ip_udp_hdr *ip, int *lenp)
 	 * so it is represented as byte count, not as 8-byte blocks.
 	 */
 
-	h = payload + first_hole;
+	h = payload + slot->first_hole;
 	while (h->last_byte < start) {
 		if (!h->next_hole) {
 			/* no hole that far away */
+			defrag_stats.dropped++;
 			return NULL;
 		}
 		h = payload + h->next_hole;
@@ -905,12 +1009,13 @@ static struct ip_udp_hdr *__net_defragment(struct ip_udp_hdr *ip, int *lenp)
 	/* last fragment may be 1..7 bytes, the "+7" forces acceptance */
 	if (offset8 + ((len + 7) / 8) <= h - payload) {
 		/* no overlap with holes (dup fragment?) */
+		defrag_stats.dropped++;
 		return NULL;
 	}
 
 	if (!(ip_off & IP_FLAGS_MFRAG)) {
 		/* no more fragmentss: truncate this (last) hole */
-		total_len = start + len;
+		slot->total_len = start + len;
 		h->last_byte = start + len;
 	}
 
@@ -918,16 +1023,19 @@ static struct ip_udp_hdr *__net_defragment(struct ip_udp_hdr *ip, int *lenp)
 	 * There is some overlap: fix the hole list. This code doesn't
 	 * deal with a fragment that overlaps with two different holes
 	 * (thus being a superset of a previously-received fragment).
+	 * The hole at index 0 may be the previous one of another, so the
+	 * first hole is found by its index rather than by a 0 prev_hole.
 	 */
+	first = h - payload == slot->first_hole;
 
 	if ((h >= thisfrag) && (h->last_byte <= start + len)) {
 		/* complete overlap with hole: remove hole */
-		if (!h->prev_hole && !h->next_hole) {
+		if (first && !h->next_hole) {
 			/* last remaining hole */
 			done = 1;
-		} else if (!h->prev_hole) {
+		} else if (first) {
 			/* first hole */
-			first_hole = h->next_hole;
+			slot->first_hole = h->next_hole;
 			payload[h->next_hole].prev_hole = 0;
 		} else if (!h->next_hole) {
 			/* last hole */
@@ -949,10 +1057,10 @@ static struct ip_udp_hdr *__net_defragment(struct ip_udp_hdr *ip, int *lenp)
 		h = newh;
 		if (h->next_hole)
 			payload[h->next_hole].prev_hole = (h - payload);
-		if (h->prev_hole)
-			payload[h->prev_hole].next_hole = (h - payload);
+		if (first)
+			slot->first_hole = (h - payload);
 		else
-			first_hole = (h - payload);
+			payload[h->prev_hole].next_hole = (h - payload);
 
 	} else {
 		/* fragment sits in the middle: split the hole */
@@ -970,8 +1078,12 @@ static struct ip_udp_hdr *__net_defragment(struct ip_udp_hdr *ip, int *lenp)
 	if (!done)
 		return NULL;
 
-	localip->ip_len = htons(total_len);
-	*lenp = total_len + IP_HDR_SIZE;
+	/* The packet stays in the slot while the caller deals with it */
+	defrag_stats.datagrams++;
+	*lenp = slot->total_len + IP_HDR_SIZE;
+	localip->ip_len = htons(*lenp);
+	localip->ip_off = 0;
+	slot->total_len = 0;
 	return localip;
 }
 
@@ -1142,10 +1254,13 @@ void net_process_received_packet(uchar *in_packet, int len)
 #endif
 	case PROT_IP:
 		debug_cond(DEBUG_NET_PKT, "Got IP\n");
-		/* Before we start poking the header, make sure it is there */
-		if (len < IP_UDP_HDR_SIZE) {
-			debug("len bad %d < %lu\n", len,
-			      (ulong)IP_UDP_HDR_SIZE);
+		/*
+		 * Before we start poking the header, make sure it is there.
+		 * The last fragment of a packet may be shorter than the UDP
+		 * header, so that is checked after reassembly.
+		 */
+		if (len < IP_HDR_SIZE) {
+			debug("len bad %d < %lu\n", len, (ulong)IP_HDR_SIZE);
 			return;
 		}
 		/* Check the packet length */
@@ -1187,6 +1302,11 @@ void net_process_received_packet(uchar *in_packet, int len)
 		ip = net_defragment(ip, &len);
 		if (!ip)
 			return;
+		if (len < IP_UDP_HDR_SIZE) {
+			debug("len bad %d < %lu\n", len,
+			      (ulong)IP_UDP_HDR_SIZE);
+			return;
+		}
 		/*
 		 * watch for ICMP host redirects
 		 *
@@ -1211,6 +1331,11 @@ void net_process_received_packet(uchar *in_packet, int len)
 		if (ip->ip_p == IPPROTO_ICMP) {
 			receive_icmp(ip, len, src_ip, et);
 			return;
+#ifdef CONFIG_PROT_TCP
+		} else if (ip->ip_p == IPPROTO_TCP) {
+			tcp_receive((struct ip_tcp_hdr *)ip, len);
+			return;
+#endif
 		} else if (ip->ip_p != IPPROTO_UDP) {	/* Only UDP packets */
 			return;
 		}
@@ -1312,6 +1437,9 @@ static int net_check_prereq(enum proto_t protocol)
 #endif
 #if defined(CONFIG_CMD_NFS)
 	case NFS:
+#endif
+#if defined(CONFIG_CMD_WGET)
+	case WGET:
 #endif
 		/* Fall through */
 	case TFTPGET:
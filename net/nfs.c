@@ -41,14 +41,47 @@
 #define NFS_RPC_ERR	1
 #define NFS_RPC_DROP	124
 
+/*
+ * Largest READ whose reply we can receive: without CONFIG_IP_DEFRAG the reply
+ * has to fit in a single Ethernet frame, since a fragmented one is dropped.
+ */
+#ifdef CONFIG_IP_DEFRAG
+#define NFS_MAX_RX_READ	CONFIG_NET_MAXDEFRAG
+#else
+#define NFS_MAX_RX_READ	\
+	(1500 - IP_UDP_HDR_SIZE - sizeof(((struct rpc_t *)0)->u.reply))
+#endif
+
+/**
+ * struct nfs_read - A READ request in flight
+ *
+ * @id:		RPC transaction ID, or 0 if this slot is free
+ * @offset:	Offset within the file
+ * @len:	Number of bytes asked for
+ */
+struct nfs_read {
+	ulong id;
+	u64 offset;
+	uint len;
+};
+
 static int fs_mounted;
 static unsigned long rpc_id;
-static int nfs_offset = -1;
-static int nfs_len;
 static ulong nfs_timeout = NFS_TIMEOUT;
 
-static char dirfh[NFS_FHSIZE];	/* file handle of directory */
-static char filefh[NFS_FHSIZE]; /* file handle of kernel image */
+static char dirfh[NFS3_FHSIZE];	/* file handle of directory */
+static int dirfh_len;
+static char filefh[NFS3_FHSIZE]; /* file handle of kernel image */
+static int filefh_len;
+
+static int nfs_version;		/* 3, or 2 if the server does not have v3 */
+static uint nfs_rsize;		/* bytes asked for by each READ */
+static int nfs_window;		/* number of READs to keep in flight */
+static u64 nfs_file_size;	/* size of the file, as far as we know */
+static u64 nfs_read_next;	/* offset of the next READ to send */
+static ulong nfs_received;	/* bytes received so far */
+static int nfs_hashes;
+static struct nfs_read nfs_reads[NFS_MAX_READ_WINDOW];
 
 static enum net_loop_state nfs_download_state;
 static struct in_addr nfs_server_ip;
@@ -64,13 +97,14 @@ static int nfs_state;
 #define STATE_LOOKUP_REQ		5
 #define STATE_READ_REQ			6
 #define STATE_READLINK_REQ		7
+#define STATE_FSINFO_REQ		8
 
 static char default_filename[64];
 static char *nfs_filename;
 static char *nfs_path;
 static char nfs_path_buff[2048];
 
-static inline int store_block(uchar *src, unsigned offset, unsigned len)
+static inline int store_block(uchar *src, ulong offset, unsigned len)
 {
 	ulong newsize = offset + len;
 #ifdef CONFIG_SYS_DIRECT_FLASH_NFS
@@ -132,7 +166,7 @@ static char *dirname(char *path)
 /**************************************************************************
 RPC_ADD_CREDENTIALS - Add RPC authentication/verifier entries
 **************************************************************************/
-static long *rpc_add_credentials(long *p)
+static uint32_t *rpc_add_credentials(uint32_t *p)
 {
 	int hl;
 	int hostnamelen;
@@ -175,7 +209,7 @@ static long *rpc_add_credentials(long *p)
 /**************************************************************************
 RPC_LOOKUP - Lookup RPC Port numbers
 **************************************************************************/
-static void rpc_req(int rpc_prog, int rpc_proc, uint32_t *data, int datalen)
+static ulong rpc_req(int rpc_prog, int rpc_proc, uint32_t *data, int datalen)
 {
 	struct rpc_t pkt;
 	unsigned long id;
@@ -188,7 +222,8 @@ static void rpc_req(int rpc_prog, int rpc_proc, uint32_t *data, int datalen)
 	pkt.u.call.type = htonl(MSG_CALL);
 	pkt.u.call.rpcvers = htonl(2);	/* use RPC version 2 */
 	pkt.u.call.prog = htonl(rpc_prog);
-	pkt.u.call.vers = htonl(2);	/* portmapper is version 2 */
+	/* portmapper is version 2, MOUNT and NFS follow the NFS version */
+	pkt.u.call.vers = htonl(rpc_prog == PROG_PORTMAP ? 2 : nfs_version);
 	pkt.u.call.proc = htonl(rpc_proc);
 	p = (uint32_t *)&(pkt.u.call.data);
 
@@ -209,6 +244,20 @@ static void rpc_req(int rpc_prog, int rpc_proc, uint32_t *data, int datalen)
 
 	net_send_udp_packet(net_server_ethaddr, nfs_server_ip, sport,
 			    nfs_our_port, pktlen);
+
+	return id;
+}
+
+/* Add a file handle to a request, with its length for NFSv3 */
+static uint32_t *nfs_add_fh(uint32_t *p, const char *fh, int len)
+{
+	if (nfs_version == 3)
+		*p++ = htonl(len);
+	if (len & 3)
+		*(p + len / 4) = 0;
+	memcpy(p, fh, len);
+
+	return p + (len + 3) / 4;
 }
 
 /**************************************************************************
@@ -241,7 +290,7 @@ static void nfs_mount_req(char *path)
 	pathlen = strlen(path);
 
 	p = &(data[0]);
-	p = (uint32_t *)rpc_add_credentials((long *)p);
+	p = rpc_add_credentials(p);
 
 	*p++ = htonl(pathlen);
 	if (pathlen & 3)
@@ -268,7 +317,7 @@ static void nfs_umountall_req(void)
 		return;
 
 	p = &(data[0]);
-	p = (uint32_t *)rpc_add_credentials((long *)p);
+	p = rpc_add_credentials(p);
 
 	len = (uint32_t *)p - (uint32_t *)&(data[0]);
 
@@ -289,10 +338,9 @@ static void nfs_readlink_req(void)
 	int len;
 
 	p = &(data[0]);
-	p = (uint32_t *)rpc_add_credentials((long *)p);
+	p = rpc_add_credentials(p);
 
-	memcpy(p, filefh, NFS_FHSIZE);
-	p += (NFS_FHSIZE / 4);
+	p = nfs_add_fh(p, filefh, filefh_len);
 
 	len = (uint32_t *)p - (uint32_t *)&(data[0]);
 
@@ -312,10 +360,9 @@ static void nfs_lookup_req(char *fname)
 	fnamelen = strlen(fname);
 
 	p = &(data[0]);
-	p = (uint32_t *)rpc_add_credentials((long *)p);
+	p = rpc_add_credentials(p);
 
-	memcpy(p, dirfh, NFS_FHSIZE);
-	p += (NFS_FHSIZE / 4);
+	p = nfs_add_fh(p, dirfh, dirfh_len);
 	*p++ = htonl(fnamelen);
 	if (fnamelen & 3)
 		*(p + fnamelen / 4) = 0;
@@ -324,30 +371,86 @@ static void nfs_lookup_req(char *fname)
 
 	len = (uint32_t *)p - (uint32_t *)&(data[0]);
 
-	rpc_req(PROG_NFS, NFS_LOOKUP, data, len);
+	rpc_req(PROG_NFS, nfs_version == 3 ? NFS3PROC_LOOKUP : NFS_LOOKUP,
+		data, len);
+}
+
+/**************************************************************************
+NFS_FSINFO - Ask an NFSv3 server how much it can READ at once
+**************************************************************************/
+static void nfs_fsinfo_req(void)
+{
+	uint32_t data[1024];
+	uint32_t *p;
+	int len;
+
+	p = &(data[0]);
+	p = rpc_add_credentials(p);
+
+	p = nfs_add_fh(p, dirfh, dirfh_len);
+
+	len = (uint32_t *)p - (uint32_t *)&(data[0]);
+
+	rpc_req(PROG_NFS, NFS3PROC_FSINFO, data, len);
 }
 
 /**************************************************************************
 NFS_READ - Read File on NFS Server
 **************************************************************************/
-static void nfs_read_req(int offset, int readlen)
+static ulong nfs_read_req(u64 offset, uint readlen)
 {
 	uint32_t data[1024];
 	uint32_t *p;
 	int len;
 
 	p = &(data[0]);
-	p = (uint32_t *)rpc_add_credentials((long *)p);
+	p = rpc_add_credentials(p);
 
-	memcpy(p, filefh, NFS_FHSIZE);
-	p += (NFS_FHSIZE / 4);
-	*p++ = htonl(offset);
+	p = nfs_add_fh(p, filefh, filefh_len);
+	if (nfs_version == 3)
+		*p++ = htonl((uint32_t)(offset >> 32));
+	*p++ = htonl((uint32_t)offset);
 	*p++ = htonl(readlen);
-	*p++ = 0;
+	if (nfs_version == 2)
+		*p++ = 0;	/* totalcount, unused */
 
 	len = (uint32_t *)p - (uint32_t *)&(data[0]);
 
-	rpc_req(PROG_NFS, NFS_READ, data, len);
+	return rpc_req(PROG_NFS, NFS_READ, data, len);
+}
+
+/* Send READs for the rest of the file until the window is full */
+static int nfs_read_fill(void)
+{
+	struct nfs_read *rd;
+	int busy = 0;
+	int i;
+
+	for (i = 0, rd = nfs_reads; i < nfs_window; i++, rd++) {
+		if (!rd->id && nfs_read_next < nfs_file_size) {
+			rd->offset = nfs_read_next;
+			rd->len = min_t(u64, nfs_rsize,
+					nfs_file_size - nfs_read_next);
+			nfs_read_next += rd->len;
+			rd->id = nfs_read_req(rd->offset, rd->len);
+		}
+		if (rd->id)
+			busy++;
+	}
+
+	return busy;
+}
+
+/* Send the READs which are still in flight again, after a timeout */
+static void nfs_read_resend(void)
+{
+	struct nfs_read *rd;
+	int i;
+
+	for (i = 0, rd = nfs_reads; i < nfs_window; i++, rd++) {
+		if (rd->id)
+			rd->id = nfs_read_req(rd->offset, rd->len);
+	}
 }
 
 /**************************************************************************
@@ -359,10 +462,10 @@ static void nfs_send(void)
 
 	switch (nfs_state) {
 	case STATE_PRCLOOKUP_PROG_MOUNT_REQ:
-		rpc_lookup_req(PROG_MOUNT, 1);
+		rpc_lookup_req(PROG_MOUNT, nfs_version == 3 ? 3 : 1);
 		break;
 	case STATE_PRCLOOKUP_PROG_NFS_REQ:
-		rpc_lookup_req(PROG_NFS, 2);
+		rpc_lookup_req(PROG_NFS, nfs_version);
 		break;
 	case STATE_MOUNT_REQ:
 		nfs_mount_req(nfs_path);
@@ -374,11 +477,15 @@ static void nfs_send(void)
 		nfs_lookup_req(nfs_filename);
 		break;
 	case STATE_READ_REQ:
-		nfs_read_req(nfs_offset, nfs_len);
+		nfs_read_resend();
+		nfs_read_fill();
 		break;
 	case STATE_READLINK_REQ:
 		nfs_readlink_req();
 		break;
+	case STATE_FSINFO_REQ:
+		nfs_fsinfo_req();
+		break;
 	}
 }
 
@@ -386,10 +493,58 @@ static void nfs_send(void)
 Handlers for the reply from server
 **************************************************************************/
 
+/*
+ * Get a file handle from a reply ending at @end, returning the number of
+ * words it used
+ */
+static int nfs_get_fh(uint32_t *data, const void *end, char *fh, int *lenp)
+{
+	uint len = NFS_FHSIZE;
+
+	if (nfs_version == 3) {
+		if ((void *)(data + 1) > end)
+			return -1;
+		len = ntohl(*data++);
+		if (len > NFS3_FHSIZE)
+			return -1;
+	}
+	if ((void *)data + len > end)
+		return -1;
+	memcpy(fh, data, len);
+	*lenp = len;
+
+	return (nfs_version == 3) + (len + 3) / 4;
+}
+
+/* Choose the READ size from what we want, what we can receive and @max */
+static void nfs_set_rsize(ulong max, ulong pref)
+{
+	ulong rsize = NFS_READ_SIZE;
+	char *ep;
+
+	ep = getenv("nfsrsize");
+	if (ep)
+		rsize = simple_strtoul(ep, NULL, 10);
+#if !defined(CONFIG_NFS_READ_SIZE) && defined(CONFIG_IP_DEFRAG)
+	else if (pref)
+		rsize = pref;
+#endif
+	if (!rsize)
+		rsize = NFS_READ_SIZE;
+	rsize = min(rsize, (ulong)NFS_MAX_RX_READ);
+	if (max)
+		rsize = min(rsize, max);
+	nfs_rsize = rsize;
+	debug("NFSv%d: rsize %u, window %d\n", nfs_version, nfs_rsize,
+	      nfs_window);
+}
+
 static int rpc_lookup_reply(int prog, uchar *pkt, unsigned len)
 {
 	struct rpc_t rpc_pkt;
 
+	if (len > sizeof(rpc_pkt))
+		return -NFS_RPC_DROP;
 	memcpy((unsigned char *)&rpc_pkt, pkt, len);
 
 	debug("%s\n", __func__);
@@ -422,6 +577,8 @@ static int nfs_mount_reply(uchar *pkt, unsigned len)
 
 	debug("%s\n", __func__);
 
+	if (len > sizeof(rpc_pkt))
+		return -NFS_RPC_DROP;
 	memcpy((unsigned char *)&rpc_pkt, pkt, len);
 
 	if (ntohl(rpc_pkt.u.reply.id) > rpc_id)
@@ -436,7 +593,9 @@ static int nfs_mount_reply(uchar *pkt, unsigned len)
 		return -1;
 
 	fs_mounted = 1;
-	memcpy(dirfh, rpc_pkt.u.reply.data + 1, NFS_FHSIZE);
+	if (nfs_get_fh(rpc_pkt.u.reply.data + 1, (uchar *)&rpc_pkt + len,
+		       dirfh, &dirfh_len) < 0)
+		return -NFS_RPC_ERR;
 
 	return 0;
 }
@@ -447,6 +606,8 @@ static int nfs_umountall_reply(uchar *pkt, unsigned len)
 
 	debug("%s\n", __func__);
 
+	if (len > sizeof(rpc_pkt))
+		return -NFS_RPC_DROP;
 	memcpy((unsigned char *)&rpc_pkt, pkt, len);
 
 	if (ntohl(rpc_pkt.u.reply.id) > rpc_id)
@@ -468,9 +629,54 @@ static int nfs_umountall_reply(uchar *pkt, unsigned len)
 static int nfs_lookup_reply(uchar *pkt, unsigned len)
 {
 	struct rpc_t rpc_pkt;
+	uint32_t *data;
+	void *end;
+	int words;
+
+	debug("%s\n", __func__);
+
+	if (len > sizeof(rpc_pkt))
+		return -NFS_RPC_DROP;
+	memcpy((unsigned char *)&rpc_pkt, pkt, len);
+
+	if (ntohl(rpc_pkt.u.reply.id) > rpc_id)
+		return -NFS_RPC_ERR;
+	else if (ntohl(rpc_pkt.u.reply.id) < rpc_id)
+		return -NFS_RPC_DROP;
+
+	if (rpc_pkt.u.reply.rstatus  ||
+	    rpc_pkt.u.reply.verifier ||
+	    rpc_pkt.u.reply.astatus  ||
+	    rpc_pkt.u.reply.data[0])
+		return -1;
+
+	data = rpc_pkt.u.reply.data + 1;
+	end = (uchar *)&rpc_pkt + len;
+	words = nfs_get_fh(data, end, filefh, &filefh_len);
+	if (words < 0)
+		return -NFS_RPC_ERR;
+	data += words;
+
+	/* The attributes give the size, so we know how many READs to send */
+	nfs_file_size = ~0ULL;
+	if (nfs_version == 2 && (void *)(data + 6) <= end)
+		nfs_file_size = ntohl(data[5]);
+	else if (nfs_version == 3 && (void *)(data + 8) <= end && data[0])
+		nfs_file_size = (u64)ntohl(data[6]) << 32 | ntohl(data[7]);
+
+	return 0;
+}
+
+static int nfs_fsinfo_reply(uchar *pkt, unsigned len)
+{
+	struct rpc_t rpc_pkt;
+	uint32_t *data;
+	void *end;
 
 	debug("%s\n", __func__);
 
+	if (len > sizeof(rpc_pkt))
+		return -NFS_RPC_DROP;
 	memcpy((unsigned char *)&rpc_pkt, pkt, len);
 
 	if (ntohl(rpc_pkt.u.reply.id) > rpc_id)
@@ -484,7 +690,15 @@ static int nfs_lookup_reply(uchar *pkt, unsigned len)
 	    rpc_pkt.u.reply.data[0])
 		return -1;
 
-	memcpy(filefh, rpc_pkt.u.reply.data + 1, NFS_FHSIZE);
+	/* Skip the attributes, if any, to get rtmax and rtpref */
+	data = rpc_pkt.u.reply.data + 1;
+	end = (uchar *)&rpc_pkt + len;
+	if ((void *)(data + 1) > end)
+		return -NFS_RPC_ERR;
+	data += data[0] ? 22 : 1;
+	if ((void *)(data + 2) > end)
+		return -NFS_RPC_ERR;
+	nfs_set_rsize(ntohl(data[0]), ntohl(data[1]));
 
 	return 0;
 }
@@ -492,10 +706,15 @@ static int nfs_lookup_reply(uchar *pkt, unsigned len)
 static int nfs_readlink_reply(uchar *pkt, unsigned len)
 {
 	struct rpc_t rpc_pkt;
+	uint32_t *data;
+	char *path;
+	void *end;
 	int rlen;
 
 	debug("%s\n", __func__);
 
+	if (len > sizeof(rpc_pkt))
+		return -NFS_RPC_DROP;
 	memcpy((unsigned char *)&rpc_pkt, pkt, len);
 
 	if (ntohl(rpc_pkt.u.reply.id) > rpc_id)
@@ -509,34 +728,66 @@ static int nfs_readlink_reply(uchar *pkt, unsigned len)
 	    rpc_pkt.u.reply.data[0])
 		return -1;
 
-	rlen = ntohl(rpc_pkt.u.reply.data[1]); /* new path length */
+	/* NFSv3 puts the symlink's attributes, if any, before the path */
+	data = rpc_pkt.u.reply.data + 1;
+	end = (uchar *)&rpc_pkt + len;
+	if (nfs_version == 3 && (void *)(data + 1) <= end)
+		data += data[0] ? 22 : 1;
+	if ((void *)(data + 1) > end)
+		return -NFS_RPC_ERR;
+	rlen = ntohl(data[0]); /* new path length */
+	path = (char *)(data + 1);
+	if (rlen < 0 || rlen > (char *)end - path)
+		return -NFS_RPC_ERR;
 
-	if (*((char *)&(rpc_pkt.u.reply.data[2])) != '/') {
+	if (*path != '/') {
 		int pathlen;
 		strcat(nfs_path, "/");
 		pathlen = strlen(nfs_path);
-		memcpy(nfs_path + pathlen, (uchar *)&(rpc_pkt.u.reply.data[2]),
-		       rlen);
+		memcpy(nfs_path + pathlen, path, rlen);
 		nfs_path[pathlen + rlen] = 0;
 	} else {
-		memcpy(nfs_path, (uchar *)&(rpc_pkt.u.reply.data[2]), rlen);
+		memcpy(nfs_path, path, rlen);
 		nfs_path[rlen] = 0;
 	}
 	return 0;
 }
 
+/* Print a hash for every ten full READs received */
+static void nfs_show_progress(uint len)
+{
+	ulong step = nfs_rsize / 2 * 10;
+
+	nfs_received += len;
+	if (nfs_received / step == (nfs_received - len) / step)
+		return;
+	if (nfs_hashes && !(nfs_hashes % HASHES_PER_LINE))
+		puts("\n\t ");
+	putc('#');
+	nfs_hashes++;
+}
+
 static int nfs_read_reply(uchar *pkt, unsigned len)
 {
 	struct rpc_t rpc_pkt;
-	int rlen;
+	struct nfs_read *rd;
+	uint32_t *data;
+	bool eof = false;
+	int rlen, hlen;
+	ulong id;
+	int i;
 
 	debug("%s\n", __func__);
 
 	memcpy((uchar *)&rpc_pkt, pkt, sizeof(rpc_pkt.u.reply));
 
-	if (ntohl(rpc_pkt.u.reply.id) > rpc_id)
-		return -NFS_RPC_ERR;
-	else if (ntohl(rpc_pkt.u.reply.id) < rpc_id)
+	/* Replies come in any order, so find the request this one is for */
+	id = ntohl(rpc_pkt.u.reply.id);
+	for (i = 0, rd = nfs_reads; i < nfs_window; i++, rd++) {
+		if (rd->id == id)
+			break;
+	}
+	if (i == nfs_window)
 		return -NFS_RPC_DROP;
 
 	if (rpc_pkt.u.reply.rstatus  ||
@@ -550,16 +801,35 @@ static int nfs_read_reply(uchar *pkt, unsigned len)
 		return -ntohl(rpc_pkt.u.reply.data[0]);
 	}
 
-	if ((nfs_offset != 0) && !((nfs_offset) %
-			(NFS_READ_SIZE / 2 * 10 * HASHES_PER_LINE)))
-		puts("\n\t ");
-	if (!(nfs_offset % ((NFS_READ_SIZE / 2) * 10)))
-		putc('#');
+	/* Skip the file attributes to get the length of the data */
+	data = rpc_pkt.u.reply.data + 1;
+	if (nfs_version == 3) {
+		data += data[0] ? 22 : 1;
+		eof = data[1] != 0;
+		rlen = ntohl(data[2]);
+		data += 3;
+	} else {
+		rlen = ntohl(data[17]);
+		data += 18;
+	}
+	hlen = (uchar *)data - (uchar *)&rpc_pkt;
+	if (rlen > rd->len || hlen + rlen > len)
+		return -9999;
 
-	rlen = ntohl(rpc_pkt.u.reply.data[18]);
-	if (store_block((uchar *)pkt + sizeof(rpc_pkt.u.reply),
-			nfs_offset, rlen))
+	if (store_block((uchar *)pkt + hlen, rd->offset, rlen))
 		return -9999;
+	nfs_show_progress(rlen);
+
+	if (!rlen || eof)
+		nfs_file_size = min(nfs_file_size, rd->offset + rlen);
+	if (rlen < rd->len && rd->offset + rlen < nfs_file_size) {
+		/* The server sent less than we asked for, so ask again */
+		rd->offset += rlen;
+		rd->len -= rlen;
+		rd->id = nfs_read_req(rd->offset, rd->len);
+	} else {
+		rd->id = 0;
+	}
 
 	return rlen;
 }
@@ -603,7 +873,15 @@ static void nfs_handler(uchar *pkt, unsigned dest, struct in_addr sip,
 	case STATE_PRCLOOKUP_PROG_NFS_REQ:
 		if (rpc_lookup_reply(PROG_NFS, pkt, len) == -NFS_RPC_DROP)
 			break;
-		nfs_state = STATE_MOUNT_REQ;
+		if (nfs_version == 3 &&
+		    (!nfs_server_port || !nfs_server_mount_port)) {
+			/* The server does not have NFSv3, so fall back to v2 */
+			debug("NFSv3 not available, using NFSv2\n");
+			nfs_version = 2;
+			nfs_state = STATE_PRCLOOKUP_PROG_MOUNT_REQ;
+		} else {
+			nfs_state = STATE_MOUNT_REQ;
+		}
 		nfs_send();
 		break;
 
@@ -616,12 +894,27 @@ static void nfs_handler(uchar *pkt, unsigned dest, struct in_addr sip,
 			/* just to be sure... */
 			nfs_state = STATE_UMOUNT_REQ;
 			nfs_send();
+		} else if (nfs_version == 3) {
+			nfs_state = STATE_FSINFO_REQ;
+			nfs_send();
 		} else {
+			nfs_set_rsize(NFS_MAXDATA, 0);
 			nfs_state = STATE_LOOKUP_REQ;
 			nfs_send();
 		}
 		break;
 
+	case STATE_FSINFO_REQ:
+		reply = nfs_fsinfo_reply(pkt, len);
+		if (reply == -NFS_RPC_DROP)
+			break;
+		/* Without FSINFO we just use the READ size we want */
+		if (reply)
+			nfs_set_rsize(0, 0);
+		nfs_state = STATE_LOOKUP_REQ;
+		nfs_send();
+		break;
+
 	case STATE_UMOUNT_REQ:
 		reply = nfs_umountall_reply(pkt, len);
 		if (reply == -NFS_RPC_DROP) {
@@ -645,8 +938,10 @@ static void nfs_handler(uchar *pkt, unsigned dest, struct in_addr sip,
 			nfs_send();
 		} else {
 			nfs_state = STATE_READ_REQ;
-			nfs_offset = 0;
-			nfs_len = NFS_READ_SIZE;
+			nfs_read_next = 0;
+			nfs_received = 0;
+			nfs_hashes = 0;
+			memset(nfs_reads, '\0', sizeof(nfs_reads));
 			nfs_send();
 		}
 		break;
@@ -671,17 +966,21 @@ static void nfs_handler(uchar *pkt, unsigned dest, struct in_addr sip,
 
 	case STATE_READ_REQ:
 		rlen = nfs_read_reply(pkt, len);
+		if (rlen == -NFS_RPC_DROP)
+			break;
 		net_set_timeout_handler(nfs_timeout, nfs_timeout_handler);
-		if (rlen > 0) {
-			nfs_offset += rlen;
+		if (rlen >= 0) {
+			/* Keep the window full until the whole file is here */
+			if (nfs_read_fill())
+				break;
+			nfs_download_state = NETLOOP_SUCCESS;
+			nfs_state = STATE_UMOUNT_REQ;
 			nfs_send();
 		} else if ((rlen == -NFSERR_ISDIR) || (rlen == -NFSERR_INVAL)) {
 			/* symbolic link */
 			nfs_state = STATE_READLINK_REQ;
 			nfs_send();
 		} else {
-			if (!rlen)
-				nfs_download_state = NETLOOP_SUCCESS;
 			nfs_state = STATE_UMOUNT_REQ;
 			nfs_send();
 		}
@@ -692,6 +991,8 @@ static void nfs_handler(uchar *pkt, unsigned dest, struct in_addr sip,
 
 void nfs_start(void)
 {
+	char *ep;
+
 	debug("%s\n", __func__);
 	nfs_download_state = NETLOOP_FAIL;
 
@@ -762,6 +1063,13 @@ void nfs_start(void)
 
 	nfs_timeout_count = 0;
 	nfs_state = STATE_PRCLOOKUP_PROG_MOUNT_REQ;
+	nfs_version = 3;
+
+	nfs_window = NFS_READ_WINDOW;
+	ep = getenv("nfswindow");
+	if (ep)
+		nfs_window = simple_strtoul(ep, NULL, 10);
+	nfs_window = clamp(nfs_window, 1, NFS_MAX_READ_WINDOW);
 
 	/*nfs_our_port = 4096 + (get_ticks() % 3072);*/
 	/*FIX ME !!!*/
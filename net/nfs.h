@@ -25,7 +25,14 @@
 #define NFS_READLINK    5
 #define NFS_READ        6
 
+#define NFS3PROC_LOOKUP		3
+#define NFS3PROC_READLINK	5
+#define NFS3PROC_READ		6
+#define NFS3PROC_FSINFO		19
+
 #define NFS_FHSIZE      32
+#define NFS3_FHSIZE	64	/* largest NFSv3 file handle */
+#define NFS_MAXDATA	8192	/* largest NFSv2 READ */
 
 #define NFSERR_PERM     1
 #define NFSERR_NOENT    2
@@ -37,6 +44,8 @@
  * headers) must fit within a single Ethernet frame to avoid fragmentation.
  * However, if CONFIG_IP_DEFRAG is set, the config file may want to use a
  * bigger value. In any case, most NFS servers are optimized for a power of 2.
+ * With NFSv3 and CONFIG_IP_DEFRAG, the server's preferred size is used
+ * unless this is set. The "nfsrsize" variable overrides both.
  */
 #ifdef CONFIG_NFS_READ_SIZE
 #define NFS_READ_SIZE CONFIG_NFS_READ_SIZE
@@ -44,6 +53,17 @@
 #define NFS_READ_SIZE 1024 /* biggest power of two that fits Ether frame */
 #endif
 
+/*
+ * Number of READ requests kept in flight. The replies may come back in any
+ * order. The "nfswindow" variable overrides this.
+ */
+#ifdef CONFIG_NFS_READ_WINDOW
+#define NFS_READ_WINDOW CONFIG_NFS_READ_WINDOW
+#else
+#define NFS_READ_WINDOW 4
+#endif
+#define NFS_MAX_READ_WINDOW 32
+
 #define NFS_MAXLINKDEPTH 16
 
 struct rpc_t {
@@ -65,7 +85,8 @@ struct rpc_t {
 			uint32_t verifier;
 			uint32_t v2;
 			uint32_t astatus;
-			uint32_t data[19];
+			/* enough for the header of an NFSv3 READ reply */
+			uint32_t data[26];
 		} reply;
 	} u;
 };
@@ -0,0 +1,400 @@
+/*
+ * TCP client, enough for bulk downloads
+ *
+ * There is one connection at a time. The peer is expected to send most of
+ * the data, so this side keeps no send buffer beyond the one segment in
+ * flight. Received data is passed on as soon as it arrives, in or out of
+ * order, so that it can be stored in place without a reassembly buffer.
+ * A gap makes us send a duplicate ACK for every segment after it, which
+ * lets the peer resend the missing segment at once (fast retransmit)
+ * rather than after a timeout.
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <errno.h>
+#include <net.h>
+#include <asm/unaligned.h>
+#include "tcp.h"
+
+#define TCP_TIMEOUT	2000UL	/* ms before resending, longer each time */
+#define TCP_RETRIES	6	/* resends before giving up */
+#define TCP_DELACK	20UL	/* ms to hold back an ACK for one segment */
+#define TCP_RANGES	8	/* gaps tracked in data received */
+
+/*
+ * The receive window, scaled by 1 << TCP_WSCALE if the peer agrees. Data
+ * goes straight to memory, so this only limits how far ahead of a lost
+ * segment the peer may get.
+ */
+#define TCP_WSCALE	5
+
+#define TCP_PORT_BASE	49152	/* first of the ephemeral ports */
+
+/* Compare sequence numbers, which wrap */
+#define SEQ_LT(a, b)	((s32)((a) - (b)) < 0)
+#define SEQ_LEQ(a, b)	((s32)((a) - (b)) <= 0)
+
+enum tcp_state {
+	TCP_STATE_CLOSED,
+	TCP_STATE_SYN_SENT,
+	TCP_STATE_ESTABLISHED,
+};
+
+/* Data received beyond a gap, from @start up to @end */
+struct tcp_range {
+	u32 start;
+	u32 end;
+};
+
+static struct {
+	enum tcp_state state;
+	struct in_addr ip;		/* peer */
+	uchar ethaddr[6];		/* peer, or gateway, found by ARP */
+	int sport;
+	int dport;
+	u32 iss;			/* our initial sequence number */
+	u32 snd_una;			/* oldest byte not acknowledged */
+	u32 snd_nxt;			/* next byte to send */
+	u32 irs;			/* peer's initial sequence number */
+	u32 rcv_nxt;			/* next byte expected */
+	int wscale;			/* our window scale, 0 if not agreed */
+	const uchar *tx_data;		/* data in flight */
+	unsigned tx_len;
+	int unacked;			/* segments received, not ACKed yet */
+	int retries;
+	struct tcp_range range[TCP_RANGES];
+	int ranges;
+	tcp_rx_f *rx;
+	tcp_event_f *event;
+} tcp;
+
+/* Checksum of a TCP segment of @len bytes, with the pseudo-header */
+static unsigned tcp_checksum(struct ip_tcp_hdr *ip, unsigned len)
+{
+	struct {
+		struct in_addr src;
+		struct in_addr dst;
+		u8 zero;
+		u8 proto;
+		u16 len;
+	} pseudo;
+	unsigned sum;
+
+	net_copy_ip(&pseudo.src, &ip->ip_src);
+	net_copy_ip(&pseudo.dst, &ip->ip_dst);
+	pseudo.zero = 0;
+	pseudo.proto = IPPROTO_TCP;
+	pseudo.len = htons(len);
+	sum = compute_ip_checksum(&pseudo, sizeof(pseudo));
+
+	return add_ip_checksums(sizeof(pseudo), sum,
+				compute_ip_checksum(&ip->tcp_src, len));
+}
+
+static void tcp_send_segment(u8 flags, u32 seq, const void *data,
+			     unsigned len)
+{
+	uchar *pkt = net_tx_packet + net_eth_hdr_size();
+	struct ip_tcp_hdr *ip = (struct ip_tcp_hdr *)pkt;
+	uchar *opt = pkt + IP_TCP_HDR_SIZE;
+	int optlen = 0;
+	unsigned seglen;
+
+	if (flags & TCP_SYN) {
+		opt[0] = TCPOPT_MSS;
+		opt[1] = 4;
+		put_unaligned_be16(TCP_MSS, opt + 2);
+		opt[4] = TCPOPT_NOP;
+		opt[5] = TCPOPT_WSCALE;
+		opt[6] = 3;
+		opt[7] = TCP_WSCALE;
+		optlen = 8;
+	}
+	memcpy(opt + optlen, data, len);
+	seglen = TCP_HDR_SIZE + optlen + len;
+
+	net_set_ip_header(pkt, tcp.ip, net_ip);
+	ip->ip_len = htons(IP_HDR_SIZE + seglen);
+	ip->ip_p = IPPROTO_TCP;
+	ip->ip_sum = compute_ip_checksum(ip, IP_HDR_SIZE);
+
+	ip->tcp_src = htons(tcp.sport);
+	ip->tcp_dst = htons(tcp.dport);
+	ip->tcp_seq = htonl(seq);
+	ip->tcp_ack = flags & TCP_ACK ? htonl(tcp.rcv_nxt) : 0;
+	ip->tcp_hlen = (TCP_HDR_SIZE + optlen) / 4 << 4;
+	ip->tcp_flags = flags;
+	/* The window in a SYN is not scaled */
+	/* The largest window, scaled by tcp.wscale after the SYN */
+	ip->tcp_win = htons(0xffff);
+	ip->tcp_xsum = 0;
+	ip->tcp_urg = 0;
+	ip->tcp_xsum = tcp_checksum(ip, seglen);
+
+	net_send_ip_packet(tcp.ethaddr, tcp.ip, IP_HDR_SIZE + seglen);
+}
+
+static void tcp_timeout_handler(void);
+
+static void tcp_send_ack(void)
+{
+	tcp.unacked = 0;
+	tcp_send_segment(TCP_ACK, tcp.snd_nxt, NULL, 0);
+	net_set_timeout_handler(TCP_TIMEOUT, tcp_timeout_handler);
+}
+
+static void tcp_close(enum tcp_event event)
+{
+	tcp.state = TCP_STATE_CLOSED;
+	net_set_timeout_handler(0, NULL);
+	tcp.event(event);
+}
+
+static void tcp_timeout_handler(void)
+{
+	/* An ACK was held back for a second segment which did not come */
+	if (tcp.unacked) {
+		tcp_send_ack();
+		return;
+	}
+	if (++tcp.retries > TCP_RETRIES) {
+		puts("\nTCP: peer not responding\n");
+		tcp_close(TCP_TIMEOUT);
+		return;
+	}
+	debug("TCP: timeout %d\n", tcp.retries);
+	if (tcp.state == TCP_STATE_SYN_SENT)
+		tcp_send_segment(TCP_SYN, tcp.iss, NULL, 0);
+	else if (tcp.tx_len)
+		tcp_send_segment(TCP_ACK | TCP_PSH, tcp.snd_una, tcp.tx_data,
+				 tcp.tx_len);
+	else
+		/* Repeat our ACK, in case it was lost with the peer waiting */
+		tcp_send_segment(TCP_ACK, tcp.snd_nxt, NULL, 0);
+	net_set_timeout_handler(TCP_TIMEOUT * (tcp.retries + 1),
+				tcp_timeout_handler);
+}
+
+void tcp_connect(struct in_addr dest, int port, tcp_rx_f *rx,
+		 tcp_event_f *event)
+{
+	memset(&tcp, '\0', sizeof(tcp));
+	tcp.ip = dest;
+	tcp.dport = port;
+	tcp.sport = TCP_PORT_BASE + (get_timer(0) % 8192);
+	tcp.iss = get_ticks();
+	tcp.snd_una = tcp.iss;
+	tcp.snd_nxt = tcp.iss + 1;
+	tcp.rx = rx;
+	tcp.event = event;
+	tcp.state = TCP_STATE_SYN_SENT;
+
+	tcp_send_segment(TCP_SYN, tcp.iss, NULL, 0);
+	net_set_timeout_handler(TCP_TIMEOUT, tcp_timeout_handler);
+}
+
+int tcp_send(const void *data, unsigned len)
+{
+	if (tcp.state != TCP_STATE_ESTABLISHED || tcp.tx_len || len > TCP_MSS)
+		return -EINVAL;
+	tcp.tx_data = data;
+	tcp.tx_len = len;
+	tcp.unacked = 0;
+	tcp_send_segment(TCP_ACK | TCP_PSH, tcp.snd_nxt, data, len);
+	tcp.snd_nxt += len;
+
+	return 0;
+}
+
+void tcp_reset(void)
+{
+	if (tcp.state == TCP_STATE_CLOSED)
+		return;
+	tcp_send_segment(TCP_RST | TCP_ACK, tcp.snd_nxt, NULL, 0);
+	tcp.state = TCP_STATE_CLOSED;
+	net_set_timeout_handler(0, NULL);
+}
+
+/* Note data received beyond a gap, returning -ENOSPC if out of room */
+static int tcp_add_range(u32 start, u32 end)
+{
+	struct tcp_range *r;
+	int i;
+
+	for (i = 0, r = tcp.range; i < tcp.ranges; i++, r++) {
+		if (SEQ_LT(end, r->start) || SEQ_LT(r->end, start))
+			continue;
+		if (SEQ_LT(start, r->start))
+			r->start = start;
+		if (SEQ_LT(r->end, end))
+			r->end = end;
+		return 0;
+	}
+	if (tcp.ranges == TCP_RANGES)
+		return -ENOSPC;
+	r->start = start;
+	r->end = end;
+	tcp.ranges++;
+
+	return 0;
+}
+
+/* Move rcv_nxt past the data received beyond a gap which is now filled */
+static void tcp_fill_ranges(void)
+{
+	struct tcp_range *r;
+	int i;
+
+	for (i = 0, r = tcp.range; i < tcp.ranges;) {
+		if (SEQ_LT(tcp.rcv_nxt, r->start)) {
+			i++;
+			r++;
+			continue;
+		}
+		if (SEQ_LT(tcp.rcv_nxt, r->end))
+			tcp.rcv_nxt = r->end;
+		/* Drop this range and look again from the start */
+		*r = tcp.range[--tcp.ranges];
+		i = 0;
+		r = tcp.range;
+	}
+}
+
+static void tcp_receive_data(u32 seq, const uchar *data, unsigned len)
+{
+	u32 end = seq + len;
+
+	if (SEQ_LEQ(end, tcp.rcv_nxt)) {
+		/* Sent again, so the peer missed our ACK */
+		tcp_send_ack();
+		return;
+	}
+	if (SEQ_LT(seq, tcp.rcv_nxt)) {
+		data += tcp.rcv_nxt - seq;
+		seq = tcp.rcv_nxt;
+		len = end - seq;
+	}
+	if (SEQ_LT(tcp.rcv_nxt + (0xffffU << tcp.wscale), end) ||
+	    tcp.rx(data, seq - tcp.irs - 1, len)) {
+		tcp_send_ack();
+		return;
+	}
+	/* The handler may have given up on the connection */
+	if (tcp.state == TCP_STATE_CLOSED)
+		return;
+
+	if (seq != tcp.rcv_nxt) {
+		/* Duplicate ACK, so the peer resends the missing data */
+		tcp_add_range(seq, end);
+		tcp_send_ack();
+		return;
+	}
+	tcp.rcv_nxt = end;
+	if (tcp.ranges) {
+		/* Tell the peer at once that the gap is filled */
+		tcp_fill_ranges();
+		tcp_send_ack();
+		return;
+	}
+
+	/* ACK every second segment, as RFC 1122 suggests */
+	if (++tcp.unacked >= 2)
+		tcp_send_ack();
+	else
+		net_set_timeout_handler(TCP_DELACK, tcp_timeout_handler);
+}
+
+/* Handle the SYN-ACK which answers our SYN */
+static void tcp_receive_syn(struct ip_tcp_hdr *ip, unsigned hlen, u8 flags,
+			    u32 seq, u32 ack)
+{
+	uchar *opt = (uchar *)&ip->tcp_src + TCP_HDR_SIZE;
+	uchar *end = (uchar *)&ip->tcp_src + hlen;
+
+	if ((flags & (TCP_SYN | TCP_ACK)) != (TCP_SYN | TCP_ACK) ||
+	    ack != tcp.iss + 1)
+		return;
+
+	/* Our window is only scaled if the peer sends the option too */
+	while (opt < end && *opt != TCPOPT_END) {
+		if (*opt == TCPOPT_NOP) {
+			opt++;
+			continue;
+		}
+		if (opt + 1 >= end || opt[1] < 2)
+			break;
+		if (*opt == TCPOPT_WSCALE)
+			tcp.wscale = TCP_WSCALE;
+		opt += opt[1];
+	}
+	tcp.irs = seq;
+	tcp.rcv_nxt = seq + 1;
+	tcp.snd_una = ack;
+	tcp.state = TCP_STATE_ESTABLISHED;
+	tcp.retries = 0;
+
+	tcp.event(TCP_CONNECTED);
+	/* If nothing was sent with it, ACK the SYN on its own */
+	if (tcp.state == TCP_STATE_ESTABLISHED && !tcp.tx_len)
+		tcp_send_ack();
+	else
+		net_set_timeout_handler(TCP_TIMEOUT, tcp_timeout_handler);
+}
+
+void tcp_receive(struct ip_tcp_hdr *ip, unsigned len)
+{
+	unsigned hlen, dlen;
+	u32 seq, ack;
+	u8 flags;
+
+	if (tcp.state == TCP_STATE_CLOSED || len < IP_TCP_HDR_SIZE)
+		return;
+	if (ntohs(ip->tcp_dst) != tcp.sport ||
+	    ntohs(ip->tcp_src) != tcp.dport ||
+	    net_read_ip(&ip->ip_src).s_addr != tcp.ip.s_addr)
+		return;
+	len -= IP_HDR_SIZE;
+	hlen = (ip->tcp_hlen >> 4) * 4;
+	if (hlen < TCP_HDR_SIZE || hlen > len)
+		return;
+	if (tcp_checksum(ip, len)) {
+		debug("TCP: bad checksum\n");
+		return;
+	}
+
+	flags = ip->tcp_flags;
+	seq = ntohl(ip->tcp_seq);
+	ack = ntohl(ip->tcp_ack);
+	dlen = len - hlen;
+
+	if (flags & TCP_RST) {
+		puts("\nTCP: connection reset\n");
+		tcp_close(TCP_RESET);
+		return;
+	}
+	if (tcp.state == TCP_STATE_SYN_SENT) {
+		tcp_receive_syn(ip, hlen, flags, seq, ack);
+		return;
+	}
+	if (!(flags & TCP_ACK))
+		return;
+
+	tcp.retries = 0;
+	if (SEQ_LT(tcp.snd_una, ack) && SEQ_LEQ(ack, tcp.snd_nxt)) {
+		tcp.snd_una = ack;
+		if (ack == tcp.snd_nxt)
+			tcp.tx_len = 0;
+	}
+	if (dlen)
+		tcp_receive_data(seq, (uchar *)&ip->tcp_src + hlen, dlen);
+
+	/* A FIN counts once all the data before it is here */
+	if ((flags & TCP_FIN) && seq + dlen == tcp.rcv_nxt) {
+		tcp.rcv_nxt++;
+		tcp_send_segment(TCP_FIN | TCP_ACK, tcp.snd_nxt, NULL, 0);
+		tcp.snd_nxt++;
+		tcp_close(TCP_CLOSED);
+	}
+}
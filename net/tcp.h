@@ -0,0 +1,69 @@
+/*
+ * TCP client, enough for bulk downloads
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#ifndef __TCP_H__
+#define __TCP_H__
+
+#define TCP_MSS		1460	/* Ethernet MTU less IP and TCP headers */
+
+/* Events passed to the tcp_event_f handler */
+enum tcp_event {
+	TCP_CONNECTED,		/* Connection is up, data may be sent */
+	TCP_CLOSED,		/* Peer closed after sending all its data */
+	TCP_RESET,		/* Connection refused or reset by the peer */
+	TCP_TIMEOUT,		/* Peer stopped responding */
+};
+
+/**
+ * tcp_rx_f - Handler for data received
+ *
+ * Data may be passed out of order, when earlier data was lost. Such data
+ * is only acknowledged once the gap before it is filled.
+ *
+ * @data:	Data received
+ * @offset:	Offset of the data in the stream, from 0
+ * @len:	Number of bytes
+ * @return 0 if the data was taken, -ve to drop it, so the peer sends it
+ *	again later
+ */
+typedef int tcp_rx_f(const uchar *data, u32 offset, unsigned len);
+
+/* Handler for connection events */
+typedef void tcp_event_f(enum tcp_event event);
+
+/**
+ * tcp_connect() - Open a connection
+ *
+ * This takes over the net_loop() timeout handler until the connection
+ * is closed.
+ *
+ * @dest:	IP address of the peer
+ * @port:	TCP port of the peer
+ * @rx:		Handler for data received
+ * @event:	Handler for connection events
+ */
+void tcp_connect(struct in_addr dest, int port, tcp_rx_f *rx,
+		 tcp_event_f *event);
+
+/**
+ * tcp_send() - Send data on the connection
+ *
+ * Only one segment can be in flight, and the data must stay valid until
+ * it is acknowledged.
+ *
+ * @data:	Data to send
+ * @len:	Number of bytes, at most TCP_MSS
+ * @return 0 if OK, -ve on error
+ */
+int tcp_send(const void *data, unsigned len);
+
+/* Close the connection without waiting for the peer */
+void tcp_reset(void);
+
+/* Process a TCP segment received, with its IP header */
+void tcp_receive(struct ip_tcp_hdr *ip, unsigned len);
+
+#endif /* __TCP_H__ */
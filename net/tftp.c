@@ -15,6 +15,10 @@
 #ifdef CONFIG_SYS_DIRECT_FLASH_TFTP
 #include <flash.h>
 #endif
+#ifdef CONFIG_DECOMP_STREAM
+#include <decomp_stream.h>
+#include <image.h>
+#endif
 
 /* Well known TFTP port # */
 #define WELL_KNOWN_PORT	69
@@ -75,6 +79,10 @@ static int	timeout_count;
 static ulong	tftp_cur_block;
 /* last packet sequence number received */
 static ulong	tftp_prev_block;
+/* sequence number of the block which ends the current window */
+static ulong	tftp_next_ack;
+/* block we last sent an ACK for because the next one went missing */
+static ulong	tftp_last_nack;
 /* count of sequence number wraparounds */
 static ulong	tftp_block_wrap;
 /* memory offset due to wrapping */
@@ -95,6 +103,15 @@ static int	tftp_put_final_block_sent;
 #define tftp_put_active	0
 #endif
 
+#ifdef CONFIG_DECOMP_STREAM
+/* Compression type from 'tftpcomp', or -1 to store the file as it is */
+static int	tftp_decomp_comp = -1;
+/* Decompresses the file to load_addr as it arrives, if ctx is set */
+static struct decomp_stream tftp_decomp;
+/* Number of bytes of the file fed to tftp_decomp */
+static ulong	tftp_decomp_pos;
+#endif
+
 #define STATE_SEND_RRQ	1
 #define STATE_DATA	2
 #define STATE_TOO_LARGE	3
@@ -130,9 +147,37 @@ static char tftp_filename[MAX_LEN];
 #define TFTP_MTU_BLOCKSIZE 1468
 #endif
 
+/* RFC 2348 limits */
+#define TFTP_MIN_BLOCKSIZE	8
+#define TFTP_MAX_BLOCKSIZE	65464
+
+/*
+ * Largest block we can receive: without IP_DEFRAG the block has to fit in a
+ * single Ethernet frame, since a fragmented datagram is simply dropped.
+ */
+#ifdef CONFIG_IP_DEFRAG
+#define TFTP_MAX_RX_BLOCKSIZE	min(CONFIG_NET_MAXDEFRAG, TFTP_MAX_BLOCKSIZE)
+#else
+#define TFTP_MAX_RX_BLOCKSIZE	(1500 - IP_UDP_HDR_SIZE - 4)
+#endif
+
 static unsigned short tftp_block_size = TFTP_BLOCK_SIZE;
 static unsigned short tftp_block_size_option = TFTP_MTU_BLOCKSIZE;
 
+/*
+ * Number of blocks the server may send before waiting for an ACK (RFC 7440).
+ * A window of 1 is plain lock-step TFTP and does not send the option at all.
+ */
+#ifdef CONFIG_TFTP_WINDOWSIZE
+#define TFTP_WINDOWSIZE		CONFIG_TFTP_WINDOWSIZE
+#else
+#define TFTP_WINDOWSIZE		1
+#endif
+#define TFTP_MAX_WINDOWSIZE	65535
+
+static unsigned short tftp_windowsize = 1;
+static unsigned short tftp_windowsize_option = TFTP_WINDOWSIZE;
+
 #ifdef CONFIG_MCAST_TFTP
 #include <malloc.h>
 #define MTFTP_BITMAPSIZE	0x1000
@@ -163,6 +208,97 @@ static void mcast_cleanup(void)
 
 #endif	/* CONFIG_MCAST_TFTP */
 
+#ifdef CONFIG_DECOMP_STREAM
+static void tftp_decomp_stop(void)
+{
+	decomp_stream_finish(&tftp_decomp, NULL);
+	unmap_sysmem(tftp_decomp.dst);
+}
+
+/* Pick up 'tftpcomp', dropping anything left from a failed transfer */
+static void tftp_decomp_setup(void)
+{
+	char *ep;
+
+	if (tftp_decomp.ctx)
+		tftp_decomp_stop();
+	tftp_decomp_comp = -1;
+	ep = getenv("tftpcomp");
+	if (ep) {
+		tftp_decomp_comp = genimg_get_comp_id(ep);
+		if (tftp_decomp_comp < 0)
+			printf("TFTP: unknown tftpcomp '%s'\n", ep);
+	}
+}
+
+/* Start decompressing a new transfer to load_addr if 'tftpcomp' is set */
+static void tftp_decomp_start(void)
+{
+	int ret;
+
+	if (tftp_decomp.ctx)
+		tftp_decomp_stop();
+	tftp_decomp_pos = 0;
+	if (tftp_decomp_comp < 0 || tftp_put_active)
+		return;
+
+	ret = decomp_stream_start(&tftp_decomp, tftp_decomp_comp,
+				  map_sysmem(load_addr, CONFIG_SYS_BOOTM_LEN),
+				  CONFIG_SYS_BOOTM_LEN);
+	if (ret) {
+		printf("\nTFTP: cannot decompress (%d)\n", ret);
+		net_set_state(NETLOOP_FAIL);
+	}
+}
+
+/*
+ * Decompress a block, which must follow on from the last one. After an
+ * error the stream is kept, so that later blocks are not stored as they
+ * are, until the next transfer starts.
+ */
+static void tftp_decomp_block(ulong offset, uchar *src, unsigned len)
+{
+	int ret;
+
+	if (net_state == NETLOOP_FAIL || offset + len <= tftp_decomp_pos)
+		return;
+	if (offset != tftp_decomp_pos) {
+		printf("\nTFTP: block at 0x%lx out of order\n", offset);
+		net_set_state(NETLOOP_FAIL);
+		return;
+	}
+	ret = decomp_stream_update(&tftp_decomp, src, len);
+	tftp_decomp_pos += len;
+	if (ret) {
+		printf("\nTFTP: decompression failed at 0x%lx (%d)\n",
+		       offset, ret);
+		net_set_state(NETLOOP_FAIL);
+	}
+}
+
+/*
+ * Finish decompressing and make the decompressed size the size of the
+ * file. Returns 0 if ok, else sets the net loop to fail.
+ */
+static int tftp_decomp_finish(void)
+{
+	ulong len;
+	int ret;
+
+	ret = decomp_stream_finish(&tftp_decomp, &len);
+	unmap_sysmem(tftp_decomp.dst);
+	if (ret) {
+		printf("TFTP: decompression failed (%d)\n", ret);
+		net_set_state(NETLOOP_FAIL);
+		return ret;
+	}
+	printf("Decompressed to 0x%lx bytes\n", len);
+	net_boot_file_size = len;
+
+	return 0;
+}
+#endif
+
 static inline void store_block(int block, uchar *src, unsigned len)
 {
 	ulong offset = block * tftp_block_size + tftp_block_wrap_offset;
@@ -189,6 +325,11 @@ static inline void store_block(int block, uchar *src, unsigned len)
 		}
 	} else
 #endif /* CONFIG_SYS_DIRECT_FLASH_TFTP */
+#ifdef CONFIG_DECOMP_STREAM
+	if (tftp_decomp.ctx) {
+		tftp_decomp_block(offset, src, len);
+	} else
+#endif
 	{
 		void *ptr = map_sysmem(load_addr + offset, len);
 
@@ -319,6 +460,10 @@ static void tftp_complete(void)
 			time_start * 1000, "/s");
 	}
 	puts("\ndone\n");
+#ifdef CONFIG_DECOMP_STREAM
+	if (tftp_decomp.ctx && tftp_decomp_finish())
+		return;
+#endif
 	net_set_state(NETLOOP_SUCCESS);
 }
 
@@ -369,6 +514,9 @@ static void tftp_send(void)
 		/* try for more effic. blk size */
 		pkt += sprintf((char *)pkt, "blksize%c%d%c",
 				0, tftp_block_size_option, 0);
+		if (tftp_state == STATE_SEND_RRQ && tftp_windowsize_option > 1)
+			pkt += sprintf((char *)pkt, "windowsize%c%d%c",
+					0, tftp_windowsize_option, 0);
 #ifdef CONFIG_MCAST_TFTP
 		/* Check all preconditions before even trying the option */
 		if (!tftp_mcast_disabled) {
@@ -531,11 +679,37 @@ static void tftp_handler(uchar *pkt, unsigned dest, struct in_addr sip,
 		 */
 		for (i = 0; i+8 < len; i++) {
 			if (strcmp((char *)pkt + i, "blksize") == 0) {
-				tftp_block_size = (unsigned short)
-					simple_strtoul((char *)pkt + i + 8,
-						       NULL, 10);
-				debug("Blocksize ack: %s, %d\n",
-				      (char *)pkt + i + 8, tftp_block_size);
+				ulong blksize = simple_strtoul((char *)pkt +
+							       i + 8, NULL, 10);
+
+				debug("Blocksize ack: %s, %lu\n",
+				      (char *)pkt + i + 8, blksize);
+				/* The server may only reduce it (RFC 2348) */
+				if (blksize < TFTP_MIN_BLOCKSIZE ||
+				    blksize > tftp_block_size_option) {
+					printf("\nTFTP error: bad blksize %lu\n",
+					       blksize);
+					net_set_state(NETLOOP_FAIL);
+					return;
+				}
+				tftp_block_size = blksize;
+			}
+			if (strcmp((char *)pkt + i, "windowsize") == 0) {
+				ulong windowsize = simple_strtoul((char *)pkt +
+								  i + 11, NULL,
+								  10);
+
+				debug("Windowsize ack: %s, %lu\n",
+				      (char *)pkt + i + 11, windowsize);
+				/* Likewise the server may only reduce this */
+				if (windowsize < 1 ||
+				    windowsize > tftp_windowsize_option) {
+					printf("\nTFTP error: bad windowsize %lu\n",
+					       windowsize);
+					net_set_state(NETLOOP_FAIL);
+					return;
+				}
+				tftp_windowsize = windowsize;
 			}
 #ifdef CONFIG_TFTP_TSIZE
 			if (strcmp((char *)pkt+i, "tsize") == 0) {
@@ -548,6 +722,9 @@ static void tftp_handler(uchar *pkt, unsigned dest, struct in_addr sip,
 		}
 #ifdef CONFIG_MCAST_TFTP
 		parse_multicast_oack((char *)pkt, len - 1);
+		/* Only the master client ACKs, so it cannot use a window */
+		if (tftp_mcast_active)
+			tftp_windowsize = 1;
 		if ((tftp_mcast_active) && (!tftp_mcast_master_client))
 			tftp_state = STATE_DATA;	/* passive.. */
 		else
@@ -559,6 +736,9 @@ static void tftp_handler(uchar *pkt, unsigned dest, struct in_addr sip,
 			tftp_cur_block++;
 		}
 #endif
+		/* ACK 0 opens the first window, which ends at block N */
+		tftp_prev_block = 0;
+		tftp_next_ack = tftp_windowsize;
 		tftp_send(); /* Send ACK or first data block */
 		break;
 	case TFTP_DATA:
@@ -567,6 +747,28 @@ static void tftp_handler(uchar *pkt, unsigned dest, struct in_addr sip,
 		len -= 2;
 		tftp_cur_block = ntohs(*(__be16 *)pkt);
 
+		/*
+		 * With a window the server does not wait for us, so a lost
+		 * block shows up as a gap. Ask for the rest of the window
+		 * again by ACKing the last block we have, once per gap, and
+		 * drop everything up to the retransmission.
+		 */
+		if (tftp_windowsize > 1 &&
+		    (tftp_state == STATE_OACK || tftp_state == STATE_DATA) &&
+		    tftp_cur_block != (unsigned short)(tftp_prev_block + 1)) {
+			debug("TFTP: got block %lu, expected %lu\n",
+			      tftp_cur_block,
+			      (ulong)(unsigned short)(tftp_prev_block + 1));
+			tftp_cur_block = tftp_prev_block;
+			if (tftp_last_nack != tftp_prev_block) {
+				tftp_last_nack = tftp_prev_block;
+				tftp_next_ack = (unsigned short)
+					(tftp_prev_block + tftp_windowsize);
+				tftp_send();
+			}
+			break;
+		}
+
 		update_block_number();
 
 		if (tftp_state == STATE_SEND_RRQ)
@@ -578,6 +780,10 @@ static void tftp_handler(uchar *pkt, unsigned dest, struct in_addr sip,
 			tftp_state = STATE_DATA;
 			tftp_remote_port = src;
 			new_transfer();
+#ifdef CONFIG_DECOMP_STREAM
+			tftp_decomp_start();
+#endif
+			tftp_next_ack = tftp_windowsize;
 
 #ifdef CONFIG_MCAST_TFTP
 			if (tftp_mcast_active) { /* start!=1 common if mcast */
@@ -605,6 +811,16 @@ static void tftp_handler(uchar *pkt, unsigned dest, struct in_addr sip,
 
 		store_block(tftp_cur_block - 1, pkt + 2, len);
 
+		/*
+		 * Within a window only the last block is acknowledged, along
+		 * with the short block which ends the file.
+		 */
+		if (tftp_windowsize > 1 && len == tftp_block_size &&
+		    tftp_cur_block != tftp_next_ack)
+			break;
+		tftp_next_ack = (unsigned short)(tftp_cur_block +
+						 tftp_windowsize);
+
 		/*
 		 *	Acknowledge the block just received, which will prompt
 		 *	the remote for the next one.
@@ -687,6 +903,9 @@ static void tftp_timeout_handler(void)
 	} else {
 		puts("T ");
 		net_set_timeout_handler(timeout_ms, tftp_timeout_handler);
+		/* The ACK restarts the window after the last block we have */
+		tftp_next_ack = (unsigned short)(tftp_cur_block +
+						 tftp_windowsize);
 		if (tftp_state != STATE_RECV_WRQ)
 			tftp_send();
 	}
@@ -696,14 +915,30 @@ static void tftp_timeout_handler(void)
 void tftp_start(enum proto_t protocol)
 {
 	char *ep;             /* Environment pointer */
+	ulong blksize;
 
 	/*
-	 * Allow the user to choose TFTP blocksize and timeout.
+	 * Allow the user to choose TFTP blocksize, windowsize and timeout.
 	 * TFTP protocol has a minimal timeout of 1 second.
 	 */
+	blksize = TFTP_MTU_BLOCKSIZE;
 	ep = getenv("tftpblocksize");
 	if (ep != NULL)
-		tftp_block_size_option = simple_strtol(ep, NULL, 10);
+		blksize = simple_strtoul(ep, NULL, 10);
+	if (blksize > TFTP_MAX_RX_BLOCKSIZE) {
+		printf("TFTP blocksize (%lu) too large, using %d\n",
+		       blksize, TFTP_MAX_RX_BLOCKSIZE);
+		blksize = TFTP_MAX_RX_BLOCKSIZE;
+	} else if (blksize < TFTP_MIN_BLOCKSIZE) {
+		blksize = TFTP_BLOCK_SIZE;
+	}
+	tftp_block_size_option = blksize;
+
+	tftp_windowsize_option = TFTP_WINDOWSIZE;
+	ep = getenv("tftpwindowsize");
+	if (ep != NULL)
+		tftp_windowsize_option = clamp(simple_strtoul(ep, NULL, 10),
+					       1UL, (ulong)TFTP_MAX_WINDOWSIZE);
 
 	ep = getenv("tftptimeout");
 	if (ep != NULL)
@@ -715,8 +950,12 @@ void tftp_start(enum proto_t protocol)
 		timeout_ms = 1000;
 	}
 
-	debug("TFTP blocksize = %i, timeout = %ld ms\n",
-	      tftp_block_size_option, timeout_ms);
+#ifdef CONFIG_DECOMP_STREAM
+	tftp_decomp_setup();
+#endif
+
+	debug("TFTP blocksize = %i, windowsize = %i, timeout = %ld ms\n",
+	      tftp_block_size_option, tftp_windowsize_option, timeout_ms);
 
 	tftp_remote_ip = net_server_ip;
 	if (net_boot_file_name[0] == '\0') {
@@ -818,6 +1057,9 @@ void tftp_start(enum proto_t protocol)
 	memset(net_server_ethaddr, 0, 6);
 	/* Revert tftp_block_size to dflt */
 	tftp_block_size = TFTP_BLOCK_SIZE;
+	/* Lock-step unless the server agrees to a window */
+	tftp_windowsize = 1;
+	tftp_last_nack = -1;
 #ifdef CONFIG_MCAST_TFTP
 	mcast_cleanup();
 #endif
@@ -847,6 +1089,7 @@ void tftp_start_server(void)
 
 	/* Revert tftp_block_size to dflt */
 	tftp_block_size = TFTP_BLOCK_SIZE;
+	tftp_windowsize = 1;
 	tftp_cur_block = 0;
 	tftp_our_port = WELL_KNOWN_PORT;
 
@@ -855,6 +1098,10 @@ void tftp_start_server(void)
 	tftp_tsize_num_hash = 0;
 #endif
 
+#ifdef CONFIG_DECOMP_STREAM
+	tftp_decomp_setup();
+#endif
+
 	tftp_state = STATE_RECV_WRQ;
 	net_set_udp_handler(tftp_handler);
 
@@ -0,0 +1,192 @@
+/*
+ * HTTP download over TCP
+ *
+ * The file is fetched with a single HTTP/1.0 GET and the body is stored at
+ * load_addr as it arrives. Body data received after a lost segment is
+ * stored straight away too, so a loss does not stall the transfer.
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <command.h>
+#include <errno.h>
+#include <mapmem.h>
+#include <net.h>
+#include "tcp.h"
+#include "wget.h"
+
+#define HASHES_PER_LINE	65	/* Number of "loading" hashes per line	*/
+#define WGET_HASH_STEP	(TCP_MSS * 10)	/* Bytes per hash		*/
+#define WGET_HDR_MAX	1024	/* Longest response header		*/
+
+static struct {
+	struct in_addr server_ip;
+	char req[256];			/* HTTP request */
+	char hdr[WGET_HDR_MAX + 1];	/* response header, as received */
+	unsigned hdr_len;
+	ulong body_off;			/* stream offset of the body, or 0 */
+	long content_len;		/* from the header, or -1 */
+	ulong received;
+	int hashes;
+} wget;
+
+static void wget_fail(void)
+{
+	tcp_reset();
+	net_set_state(NETLOOP_FAIL);
+}
+
+static int store_block(const uchar *src, ulong offset, unsigned len)
+{
+	void *ptr;
+
+	if (wget.content_len >= 0 && offset + len > wget.content_len) {
+		puts("\nHTTP: more data than Content-Length\n");
+		return -EFBIG;
+	}
+	ptr = map_sysmem(load_addr + offset, len);
+	memcpy(ptr, src, len);
+	unmap_sysmem(ptr);
+
+	if (net_boot_file_size < offset + len)
+		net_boot_file_size = offset + len;
+
+	/* Print a hash for every ten full segments received */
+	wget.received += len;
+	if (wget.received / WGET_HASH_STEP !=
+	    (wget.received - len) / WGET_HASH_STEP) {
+		if (wget.hashes && !(wget.hashes % HASHES_PER_LINE))
+			puts("\n\t ");
+		putc('#');
+		wget.hashes++;
+	}
+
+	return 0;
+}
+
+/* Check the status line and pick out the headers we care about */
+static int wget_parse_header(void)
+{
+	char *line;
+	int status;
+
+	if (strncmp(wget.hdr, "HTTP/1.", 7) || strlen(wget.hdr) < 12) {
+		puts("\nHTTP: bad response\n");
+		return -EPROTO;
+	}
+	status = simple_strtoul(wget.hdr + 9, NULL, 10);
+	if (status != 200) {
+		printf("\nHTTP error: %.*s\n",
+		       (int)(strchr(wget.hdr, '\r') - wget.hdr), wget.hdr);
+		return -ENOENT;
+	}
+
+	for (line = wget.hdr; (line = strstr(line, "\r\n")); ) {
+		line += 2;
+		if (strncasecmp(line, "Content-Length:", 15))
+			continue;
+		for (line += 15; *line == ' '; line++)
+			;
+		wget.content_len = simple_strtol(line, NULL, 10);
+	}
+	debug("HTTP: body at %lu, length %ld\n", wget.body_off,
+	      wget.content_len);
+
+	return 0;
+}
+
+static int wget_rx(const uchar *data, u32 offset, unsigned len)
+{
+	unsigned skip;
+	char *end;
+
+	if (!wget.body_off) {
+		/* The header is only taken in order */
+		if (offset != wget.hdr_len)
+			return -EAGAIN;
+		skip = min(len, WGET_HDR_MAX - wget.hdr_len);
+		memcpy(wget.hdr + wget.hdr_len, data, skip);
+		wget.hdr_len += skip;
+		wget.hdr[wget.hdr_len] = '\0';
+		end = strstr(wget.hdr, "\r\n\r\n");
+		if (!end) {
+			if (wget.hdr_len == WGET_HDR_MAX) {
+				puts("\nHTTP: header too long\n");
+				wget_fail();
+			}
+			return 0;
+		}
+		wget.body_off = end + 4 - wget.hdr;
+		end[2] = '\0';
+		if (wget_parse_header()) {
+			wget_fail();
+			return 0;
+		}
+	}
+
+	/* Store whatever is part of the body */
+	if (offset + len <= wget.body_off)
+		return 0;
+	skip = offset < wget.body_off ? wget.body_off - offset : 0;
+	if (store_block(data + skip, offset + skip - wget.body_off,
+			len - skip))
+		wget_fail();
+
+	return 0;
+}
+
+static void wget_event(enum tcp_event event)
+{
+	switch (event) {
+	case TCP_CONNECTED:
+		if (tcp_send(wget.req, strlen(wget.req)))
+			wget_fail();
+		break;
+	case TCP_CLOSED:
+		if (!wget.body_off || (wget.content_len >= 0 &&
+		    net_boot_file_size != wget.content_len)) {
+			puts("\nHTTP: connection closed early\n");
+			net_set_state(NETLOOP_FAIL);
+			break;
+		}
+		puts("\ndone\n");
+		net_set_state(NETLOOP_SUCCESS);
+		break;
+	default:
+		net_set_state(NETLOOP_FAIL);
+		break;
+	}
+}
+
+void wget_start(void)
+{
+	char *path = net_boot_file_name;
+	char *p;
+
+	memset(&wget, '\0', sizeof(wget));
+	wget.content_len = -1;
+	wget.server_ip = net_server_ip;
+	p = strchr(path, ':');
+	if (p) {
+		wget.server_ip = string_to_ip(path);
+		path = p + 1;
+	}
+	if (!*path) {
+		puts("*** ERROR: no file name given\n");
+		net_set_state(NETLOOP_FAIL);
+		return;
+	}
+	snprintf(wget.req, sizeof(wget.req),
+		 "GET %s HTTP/1.0\r\nHost: %pI4\r\nUser-Agent: U-Boot\r\n"
+		 "Connection: close\r\n\r\n", path, &wget.server_ip);
+
+	printf("Using %s device\n", eth_get_name());
+	printf("HTTP from server %pI4; our IP address is %pI4\n",
+	       &wget.server_ip, &net_ip);
+	printf("Filename '%s'.\nLoad address: 0x%lx\nLoading: *\b", path,
+	       load_addr);
+
+	net_boot_file_size = 0;
+	tcp_connect(wget.server_ip, WGET_PORT, wget_rx, wget_event);
+}
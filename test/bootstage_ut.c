@@ -0,0 +1,178 @@
+/*
+ * Tests for nested bootstage spans and their folded-stack output
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <bootstage.h>
+#include <command.h>
+#include <errno.h>
+#include <asm/test.h>
+
+/* Run a span for @ms milliseconds of the sandbox timer */
+static int bs_run(const char *name, ulong func, int flags, ulong ms)
+{
+	int span;
+
+	span = bootstage_span_start(name, func, flags);
+	sandbox_timer_add_offset(ms);
+	bootstage_span_end(span);
+
+	return span;
+}
+
+static int bs_check_info(const char *test, int span, int parent, int count)
+{
+	int actual_parent = -2, actual_count;
+
+	actual_count = bootstage_span_info(span, &actual_parent);
+	if (actual_count != count || actual_parent != parent) {
+		printf("%s: span %d: parent %d, count %d, expected %d, %d\n",
+		       test, span, actual_parent, actual_count, parent, count);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Nested spans form a tree, and repeated spans add up in the same place */
+static int bootstage_test_nest(void)
+{
+	int a, b, b2, probe, top_b;
+
+	a = bootstage_span_start("a", 0, 0);
+	b = bs_run("b", 0, 0, 2);
+	b2 = bs_run("b", 0, 0, 2);
+	bs_run(NULL, 0x1234, 0, 1);
+	probe = bs_run("mmc", 0, BOOTSTAGE_SPANF_PROBE, 1);
+	sandbox_timer_add_offset(1);
+	bootstage_span_end(a);
+	top_b = bs_run("b", 0, 0, 1);
+
+	if (b2 != b || top_b == b || probe < 0) {
+		printf("%s: spans %d, %d, %d\n", __func__, b, b2, top_b);
+		return -EINVAL;
+	}
+	if (bs_check_info(__func__, a, -1, 1) ||
+	    bs_check_info(__func__, b, a, 2) ||
+	    bs_check_info(__func__, probe, a, 1) ||
+	    bs_check_info(__func__, top_b, -1, 1) ||
+	    bootstage_span_info(top_b + 1, &a) != -1)
+		return -EINVAL;
+
+	return 0;
+}
+
+/* Each span has a line with its path and the time spent in it alone */
+static int bootstage_test_folded(void)
+{
+	static const char * const expect[] = {
+		"a", "a;b", "a;0x1234", "a;probe mmc", "b",
+	};
+	static const int expect_ms[] = { 1, 4, 1, 1, 1 };
+	char buf[200], *line, *end, *time;
+	int i, len;
+
+	len = bootstage_folded(buf, sizeof(buf) - 1);
+	if (len < 0) {
+		printf("%s: error %d\n", __func__, len);
+		return -EINVAL;
+	}
+	buf[len] = '\0';
+
+	line = buf;
+	for (i = 0; i < ARRAY_SIZE(expect); i++, line = end + 1) {
+		end = strchr(line, '\n');
+		if (!end)
+			break;
+		*end = '\0';
+		time = strrchr(line, ' ');
+		if (!time || time - line != strlen(expect[i]) ||
+		    strncmp(line, expect[i], time - line) ||
+		    simple_strtoul(time + 1, NULL, 10) < expect_ms[i] * 1000) {
+			printf("%s: line %d: %s\n", __func__, i, line);
+			return -EINVAL;
+		}
+	}
+	if (i < ARRAY_SIZE(expect)) {
+		printf("%s: only %d lines\n", __func__, i);
+		return -EINVAL;
+	}
+	if (*line) {
+		printf("%s: extra line: %s", __func__, line);
+		return -EINVAL;
+	}
+
+	/* The whole output must fit */
+	if (bootstage_folded(buf, len - 1) != -ENOSPC) {
+		printf("%s: no error with a small buffer\n", __func__);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* A path too long for a line is cut short, but keeps its time */
+static int bootstage_test_long(void)
+{
+	static const char name[] = "a_span_with_a_name_much_longer_than_usual";
+	char buf[2048], *line, *end, *last = NULL;
+	int span[8];
+	int i, len;
+
+	for (i = 0; i < ARRAY_SIZE(span); i++)
+		span[i] = bootstage_span_start(name, 0, 0);
+	sandbox_timer_add_offset(1);
+	for (i = ARRAY_SIZE(span) - 1; i >= 0; i--)
+		bootstage_span_end(span[i]);
+
+	len = bootstage_folded(buf, sizeof(buf) - 1);
+	if (len <= 0) {
+		printf("%s: error %d\n", __func__, len);
+		return -EINVAL;
+	}
+	buf[len] = '\0';
+
+	/* Only the innermost span is sure to have a line, and it is last */
+	for (line = buf; *line; line = end + 1) {
+		end = strchr(line, '\n');
+		if (!end || end - line >= 255 ||
+		    strncmp(line, name, sizeof(name) - 1)) {
+			printf("%s: bad line: %s\n", __func__, line);
+			return -EINVAL;
+		}
+		*end = '\0';
+		last = line;
+	}
+	if (!last || strlen(last) < 200 ||
+	    simple_strtoul(strrchr(last, ' ') + 1, NULL, 10) < 1000) {
+		printf("%s: bad last line: %s\n", __func__, last);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int do_ut_bootstage(cmd_tbl_t *cmdtp, int flag, int argc,
+		    char * const argv[])
+{
+	int ret;
+
+	/* Keep these spans apart from the ones recorded during boot */
+	bootstage_span_test_state(true);
+	ret = bootstage_test_nest();
+	if (!ret)
+		ret = bootstage_test_folded();
+	bootstage_span_test_state(false);
+
+	if (!ret) {
+		bootstage_span_test_state(true);
+		ret = bootstage_test_long();
+		bootstage_span_test_state(false);
+	}
+
+	printf("Test %s\n", ret ? "failed" : "passed");
+
+	return ret ? CMD_RET_FAILURE : CMD_RET_SUCCESS;
+}
@@ -13,12 +13,55 @@ static int do_ut_all(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[]);
 
 static cmd_tbl_t cmd_ut_sub[] = {
 	U_BOOT_CMD_MKENT(all, CONFIG_SYS_MAXARGS, 1, do_ut_all, "", ""),
+#ifdef CONFIG_UT_BOOTSTAGE
+	U_BOOT_CMD_MKENT(bootstage, CONFIG_SYS_MAXARGS, 1, do_ut_bootstage, "",
+			 ""),
+#endif
+#ifdef CONFIG_UT_CRC32
+	U_BOOT_CMD_MKENT(crc32, CONFIG_SYS_MAXARGS, 1, do_ut_crc32, "", ""),
+#endif
 #if defined(CONFIG_UT_DM)
 	U_BOOT_CMD_MKENT(dm, CONFIG_SYS_MAXARGS, 1, do_ut_dm, "", ""),
 #endif
 #if defined(CONFIG_UT_ENV)
 	U_BOOT_CMD_MKENT(env, CONFIG_SYS_MAXARGS, 1, do_ut_env, "", ""),
 #endif
+#ifdef CONFIG_UT_EXT4
+	U_BOOT_CMD_MKENT(ext4, CONFIG_SYS_MAXARGS, 1, do_ut_ext4, "", ""),
+#endif
+#ifdef CONFIG_UT_FAT
+	U_BOOT_CMD_MKENT(fat, CONFIG_SYS_MAXARGS, 1, do_ut_fat, "", ""),
+#endif
+#ifdef CONFIG_UT_FDTDEC
+	U_BOOT_CMD_MKENT(fdtdec, CONFIG_SYS_MAXARGS, 1, do_ut_fdtdec, "", ""),
+#endif
+#ifdef CONFIG_UT_HASH
+	U_BOOT_CMD_MKENT(hash, CONFIG_SYS_MAXARGS, 1, do_ut_hash, "", ""),
+#endif
+#ifdef CONFIG_UT_INITCALL
+	U_BOOT_CMD_MKENT(initcall, CONFIG_SYS_MAXARGS, 1, do_ut_initcall, "",
+			 ""),
+#endif
+#ifdef CONFIG_UT_MALLOC_F
+	U_BOOT_CMD_MKENT(mallocf, CONFIG_SYS_MAXARGS, 1, do_ut_malloc_f, "",
+			 ""),
+#endif
+#ifdef CONFIG_UT_MEM
+	U_BOOT_CMD_MKENT(mem, CONFIG_SYS_MAXARGS, 1, do_ut_mem, "", ""),
+#endif
+#ifdef CONFIG_UT_PIC32_ETH
+	U_BOOT_CMD_MKENT(pic32eth, CONFIG_SYS_MAXARGS, 1, do_ut_pic32eth, "",
+			 ""),
+#endif
+#ifdef CONFIG_UT_SLAB
+	U_BOOT_CMD_MKENT(slab, CONFIG_SYS_MAXARGS, 1, do_ut_slab, "", ""),
+#endif
+#ifdef CONFIG_UT_SDHCI
+	U_BOOT_CMD_MKENT(sdhci, CONFIG_SYS_MAXARGS, 1, do_ut_sdhci, "", ""),
+#endif
+#ifdef CONFIG_UT_TRACE
+	U_BOOT_CMD_MKENT(trace, CONFIG_SYS_MAXARGS, 1, do_ut_trace, "", ""),
+#endif
 #ifdef CONFIG_UT_TIME
 	U_BOOT_CMD_MKENT(time, CONFIG_SYS_MAXARGS, 1, do_ut_time, "", ""),
 #endif
@@ -62,12 +105,51 @@ static int do_ut(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
 #ifdef CONFIG_SYS_LONGHELP
 static char ut_help_text[] =
 	"all - execute all enabled tests\n"
+#ifdef CONFIG_UT_BOOTSTAGE
+	"ut bootstage - Test nested bootstage spans and folded output\n"
+#endif
+#ifdef CONFIG_UT_CRC32
+	"ut crc32 - Test and benchmark CRC32\n"
+#endif
 #ifdef CONFIG_UT_DM
 	"ut dm [test-name]\n"
 #endif
 #ifdef CONFIG_UT_ENV
 	"ut env [test-name]\n"
 #endif
+#ifdef CONFIG_UT_EXT4
+	"ut ext4 [image] - Test and benchmark ext4 file reads\n"
+#endif
+#ifdef CONFIG_UT_FAT
+	"ut fat [image] - Test and benchmark FAT file reads\n"
+#endif
+#ifdef CONFIG_UT_FDTDEC
+	"ut fdtdec - Test and benchmark the control FDT index\n"
+#endif
+#ifdef CONFIG_UT_HASH
+	"ut hash - Test and benchmark hash algorithms\n"
+#endif
+#ifdef CONFIG_UT_INITCALL
+	"ut initcall - Test initcall ordering, deferral and timing\n"
+#endif
+#ifdef CONFIG_UT_MALLOC_F
+	"ut mallocf - Test the malloc() pool used before relocation\n"
+#endif
+#ifdef CONFIG_UT_MEM
+	"ut mem [-q] - Test and benchmark memcpy(), memset() and friends\n"
+#endif
+#ifdef CONFIG_UT_PIC32_ETH
+	"ut pic32eth - Test PIC32 Ethernet descriptor rings\n"
+#endif
+#ifdef CONFIG_UT_SLAB
+	"ut slab - Test and benchmark slabs for small objects\n"
+#endif
+#ifdef CONFIG_UT_SDHCI
+	"ut sdhci - Test SDHCI PIO and ADMA transfers, with throughput\n"
+#endif
+#ifdef CONFIG_UT_TRACE
+	"ut trace - Test the function trace call list and times\n"
+#endif
 #ifdef CONFIG_UT_TIME
 	"ut time - Very basic test of time functions\n"
 #endif
@@ -9,6 +9,8 @@
 #include <common.h>
 #include <bootm.h>
 #include <command.h>
+#include <decomp_stream.h>
+#include <errno.h>
 #include <malloc.h>
 #include <mapmem.h>
 #include <asm/io.h>
@@ -21,6 +23,7 @@
 #include <lzma/LzmaTools.h>
 
 #include <linux/lzo.h>
+#include <lz4.h>
 
 static const char plain[] =
 	"I am a highly compressable bit of text.\n"
@@ -95,6 +98,57 @@ static const char lzo_compressed[] =
 	"\x73\x61\x67\x65\x73\x2e\x0a\x11\x00\x00\x00\x00\x00\x00";
 static const unsigned long lzo_compressed_size = 334;
 
+/* lz4 -c /tmp/plain.txt > /tmp/plain.lz4 */
+static const char lz4_compressed[] =
+	"\x04\x22\x4d\x18\x64\x40\xa7\x01\x01\x00\x00\xff\x19\x49\x20\x61"
+	"\x6d\x20\x61\x20\x68\x69\x67\x68\x6c\x79\x20\x63\x6f\x6d\x70\x72"
+	"\x65\x73\x73\x61\x62\x6c\x65\x20\x62\x69\x74\x20\x6f\x66\x20\x74"
+	"\x65\x78\x74\x2e\x0a\x28\x00\x3d\xf1\x25\x54\x68\x65\x72\x65\x20"
+	"\x61\x72\x65\x20\x6d\x61\x6e\x79\x20\x6c\x69\x6b\x65\x20\x6d\x65"
+	"\x2c\x20\x62\x75\x74\x20\x74\x68\x69\x73\x20\x6f\x6e\x65\x20\x69"
+	"\x73\x20\x6d\x69\x6e\x65\x2e\x0a\x49\x66\x20\x49\x20\x77\x32\x00"
+	"\xd1\x6e\x79\x20\x73\x68\x6f\x72\x74\x65\x72\x2c\x20\x74\x45\x00"
+	"\xf4\x0b\x77\x6f\x75\x6c\x64\x6e\x27\x74\x20\x62\x65\x20\x6d\x75"
+	"\x63\x68\x20\x73\x65\x6e\x73\x65\x20\x69\x6e\x0a\xcf\x00\x50\x69"
+	"\x6e\x67\x20\x6d\x12\x00\x00\x32\x00\xf0\x11\x20\x66\x69\x72\x73"
+	"\x74\x20\x70\x6c\x61\x63\x65\x2e\x20\x41\x74\x20\x6c\x65\x61\x73"
+	"\x74\x20\x77\x69\x74\x68\x20\x6c\x7a\x6f\x2c\x63\x00\xf5\x14\x77"
+	"\x61\x79\x2c\x0a\x77\x68\x69\x63\x68\x20\x61\x70\x70\x65\x61\x72"
+	"\x73\x20\x74\x6f\x20\x62\x65\x68\x61\x76\x65\x20\x70\x6f\x6f\x72"
+	"\x6c\x79\x4e\x00\x30\x61\x63\x65\x27\x01\x01\x95\x00\x01\x2d\x01"
+	"\xb0\x0a\x6d\x65\x73\x73\x61\x67\x65\x73\x2e\x0a\x00\x00\x00\x00"
+	"\x9d\x12\x8c\x9d";
+static const unsigned long lz4_compressed_size = 276;
+
+/* lz4 -l -c /tmp/plain.txt > /tmp/plain_l.lz4 */
+static const char lz4_legacy_compressed[] =
+	"\x02\x21\x4c\x18\x01\x01\x00\x00\xff\x19\x49\x20\x61\x6d\x20\x61"
+	"\x20\x68\x69\x67\x68\x6c\x79\x20\x63\x6f\x6d\x70\x72\x65\x73\x73"
+	"\x61\x62\x6c\x65\x20\x62\x69\x74\x20\x6f\x66\x20\x74\x65\x78\x74"
+	"\x2e\x0a\x28\x00\x3d\xf1\x25\x54\x68\x65\x72\x65\x20\x61\x72\x65"
+	"\x20\x6d\x61\x6e\x79\x20\x6c\x69\x6b\x65\x20\x6d\x65\x2c\x20\x62"
+	"\x75\x74\x20\x74\x68\x69\x73\x20\x6f\x6e\x65\x20\x69\x73\x20\x6d"
+	"\x69\x6e\x65\x2e\x0a\x49\x66\x20\x49\x20\x77\x32\x00\xd1\x6e\x79"
+	"\x20\x73\x68\x6f\x72\x74\x65\x72\x2c\x20\x74\x45\x00\xf4\x0b\x77"
+	"\x6f\x75\x6c\x64\x6e\x27\x74\x20\x62\x65\x20\x6d\x75\x63\x68\x20"
+	"\x73\x65\x6e\x73\x65\x20\x69\x6e\x0a\xcf\x00\x50\x69\x6e\x67\x20"
+	"\x6d\x12\x00\x00\x32\x00\xf0\x11\x20\x66\x69\x72\x73\x74\x20\x70"
+	"\x6c\x61\x63\x65\x2e\x20\x41\x74\x20\x6c\x65\x61\x73\x74\x20\x77"
+	"\x69\x74\x68\x20\x6c\x7a\x6f\x2c\x63\x00\xf5\x14\x77\x61\x79\x2c"
+	"\x0a\x77\x68\x69\x63\x68\x20\x61\x70\x70\x65\x61\x72\x73\x20\x74"
+	"\x6f\x20\x62\x65\x68\x61\x76\x65\x20\x70\x6f\x6f\x72\x6c\x79\x4e"
+	"\x00\x30\x61\x63\x65\x27\x01\x01\x95\x00\x01\x2d\x01\xb0\x0a\x6d"
+	"\x65\x73\x73\x61\x67\x65\x73\x2e\x0a";
+static const unsigned long lz4_legacy_compressed_size = 265;
+
+/* lz4 -l -c of what lz4_fill_runs() writes */
+static const char lz4_runs_compressed[] =
+	"\x02\x21\x4c\x18\x36\x00\x00\x00\x1f\x78\x01\x00\x1e\x2f\x61\x62"
+	"\x02\x00\x29\x1f\x63\x03\x00\x26\x5f\x68\x65\x6c\x6c\x6f\x05\x00"
+	"\x33\x7f\x31\x32\x33\x34\x35\x36\x37\x07\x00\x3a\x8f\x61\x62\x63"
+	"\x64\x65\x66\x67\x68\x08\x00\x15\x50\x64\x6f\x6e\x65\x0a";
+static const unsigned long lz4_runs_compressed_size = 62;
+
 
 #define TEST_BUFFER_SIZE	512
 
@@ -227,6 +281,38 @@ static int uncompress_using_lzo(void *in, unsigned long in_size,
 	return (ret != LZO_E_OK);
 }
 
+static int compress_using_lz4(void *in, unsigned long in_size,
+			      void *out, unsigned long out_max,
+			      unsigned long *out_size)
+{
+	/* There is no lz4 compression in u-boot, so fake it. */
+	assert(in_size == strlen(plain));
+	assert(memcmp(plain, in, in_size) == 0);
+
+	if (lz4_compressed_size > out_max)
+		return -1;
+
+	memcpy(out, lz4_compressed, lz4_compressed_size);
+	if (out_size)
+		*out_size = lz4_compressed_size;
+
+	return 0;
+}
+
+static int uncompress_using_lz4(void *in, unsigned long in_size,
+				void *out, unsigned long out_max,
+				unsigned long *out_size)
+{
+	int ret;
+	size_t output_size = out_max;
+
+	ret = lz4_decompress(in, in_size, out, &output_size);
+	if (out_size)
+		*out_size = output_size;
+
+	return ret;
+}
+
 #define errcheck(statement) if (!(statement)) { \
 	fprintf(stderr, "\tFailed: %s\n", #statement); \
 	ret = 1; \
@@ -316,6 +402,119 @@ out:
 	return ret;
 }
 
+/* Repeats with every offset from 1 to 8, which take the short-offset path */
+static ulong lz4_fill_runs(char *out)
+{
+	static const struct {
+		const char *str;
+		int count;
+	} runs[] = {
+		{ "x", 50 }, { "ab", 30 }, { "abc", 20 }, { "hello", 15 },
+		{ "1234567", 12 }, { "abcdefgh", 6 }, { "done\n", 1 },
+	};
+	ulong len = 0;
+	int i, j;
+
+	for (i = 0; i < ARRAY_SIZE(runs); i++) {
+		for (j = 0; j < runs[i].count; j++) {
+			strcpy(out + len, runs[i].str);
+			len += strlen(runs[i].str);
+		}
+	}
+
+	return len;
+}
+
+/**
+ * lz4_inplace() - Decompress with the input at the end of the output buffer
+ *
+ * @buf:	Buffer to use
+ * @in:		Compressed data
+ * @in_size:	Size of @in
+ * @out_size:	Expected size of the decompressed data
+ * @return 0 if OK, -ve on error
+ */
+static int lz4_inplace(char *buf, const char *in, ulong in_size,
+		       ulong out_size)
+{
+	ulong size = out_size + LZ4_INPLACE_MARGIN(in_size);
+	size_t len = size;
+	int ret;
+
+	memset(buf, 'A', size + 1);
+	memcpy(buf + size - in_size, in, in_size);
+	ret = lz4_decompress(buf + size - in_size, in_size, buf, &len);
+	if (ret)
+		return ret;
+	if (len != out_size || buf[size] != 'A')
+		return -EINVAL;
+
+	return 0;
+}
+
+/* Things which the common test does not cover */
+static int run_lz4_test(void)
+{
+	ulong plain_size = strlen(plain);
+	ulong runs_size;
+	char *buf, *runs;
+	size_t len;
+	int ret;
+
+	printf(" testing lz4 formats ...\n");
+	buf = malloc(TEST_BUFFER_SIZE);
+	runs = malloc(TEST_BUFFER_SIZE);
+	errcheck(buf != NULL && runs != NULL);
+
+	/* The legacy format, as used for Linux */
+	len = TEST_BUFFER_SIZE;
+	errcheck(lz4_decompress(lz4_legacy_compressed,
+				lz4_legacy_compressed_size, buf, &len) == 0);
+	errcheck(len == plain_size);
+	errcheck(memcmp(plain, buf, plain_size) == 0);
+
+	/* Short-offset matches */
+	runs_size = lz4_fill_runs(runs);
+	len = TEST_BUFFER_SIZE;
+	errcheck(lz4_decompress(lz4_runs_compressed,
+				lz4_runs_compressed_size, buf, &len) == 0);
+	errcheck(len == runs_size);
+	errcheck(memcmp(runs, buf, runs_size) == 0);
+
+	/* In place, with just the documented margin */
+	errcheck(lz4_inplace(buf, lz4_compressed, lz4_compressed_size,
+			     plain_size) == 0);
+	errcheck(memcmp(plain, buf, plain_size) == 0);
+	errcheck(lz4_inplace(buf, lz4_legacy_compressed,
+			     lz4_legacy_compressed_size, plain_size) == 0);
+	errcheck(memcmp(plain, buf, plain_size) == 0);
+	errcheck(lz4_inplace(buf, lz4_runs_compressed,
+			     lz4_runs_compressed_size, runs_size) == 0);
+	errcheck(memcmp(runs, buf, runs_size) == 0);
+
+	/* A match from before the start of the output is caught */
+	memcpy(buf, lz4_runs_compressed, lz4_runs_compressed_size);
+	buf[10] = 0x02;
+	len = TEST_BUFFER_SIZE;
+	errcheck(lz4_decompress(buf, lz4_runs_compressed_size, runs,
+				&len) == -EINVAL);
+
+	/* Dictionaries are not supported */
+	memcpy(buf, lz4_compressed, lz4_compressed_size);
+	buf[4] |= 0x01;
+	len = TEST_BUFFER_SIZE;
+	errcheck(lz4_decompress(buf, lz4_compressed_size, runs,
+				&len) == -EPROTONOSUPPORT);
+	ret = 0;
+
+out:
+	printf(" lz4 formats: %s\n", ret == 0 ? "ok" : "FAILED");
+	free(runs);
+	free(buf);
+
+	return ret;
+}
+
 static int do_ut_compression(cmd_tbl_t *cmdtp, int flag, int argc,
 			     char *const argv[])
 {
@@ -325,6 +524,8 @@ static int do_ut_compression(cmd_tbl_t *cmdtp, int flag, int argc,
 	err += run_test("bzip2", compress_using_bzip2, uncompress_using_bzip2);
 	err += run_test("lzma", compress_using_lzma, uncompress_using_lzma);
 	err += run_test("lzo", compress_using_lzo, uncompress_using_lzo);
+	err += run_test("lz4", compress_using_lz4, uncompress_using_lz4);
+	err += run_lz4_test();
 
 	printf("ut_compression %s\n", err == 0 ? "ok" : "FAILED");
 
@@ -401,6 +602,7 @@ static int do_ut_image_decomp(cmd_tbl_t *cmdtp, int flag, int argc,
 	err |= run_bootm_test(IH_COMP_BZIP2, compress_using_bzip2);
 	err |= run_bootm_test(IH_COMP_LZMA, compress_using_lzma);
 	err |= run_bootm_test(IH_COMP_LZO, compress_using_lzo);
+	err |= run_bootm_test(IH_COMP_LZ4, compress_using_lz4);
 	err |= run_bootm_test(IH_COMP_NONE, compress_using_none);
 
 	printf("ut_image_decomp %s\n", err == 0 ? "ok" : "FAILED");
@@ -408,12 +610,370 @@ static int do_ut_image_decomp(cmd_tbl_t *cmdtp, int flag, int argc,
 	return 0;
 }
 
+#define DECOMP_BENCH_US		200000	/* Time for each benchmark */
+#define GZIP_BENCH_SIZE		(4 << 20)
+
+/* Decompress the same text with each algorithm, over and over */
+static int decomp_bench_algos(void)
+{
+	static const struct {
+		const char *name;
+		mutate_func compress;
+		mutate_func uncompress;
+	} algos[] = {
+		{ "none", compress_using_none, compress_using_none },
+		{ "gzip", compress_using_gzip, uncompress_using_gzip },
+		{ "bzip2", compress_using_bzip2, uncompress_using_bzip2 },
+		{ "lzma", compress_using_lzma, uncompress_using_lzma },
+		{ "lzo", compress_using_lzo, uncompress_using_lzo },
+		{ "lz4", compress_using_lz4, uncompress_using_lz4 },
+	};
+	ulong plain_size = strlen(plain);
+	ulong in_size, out_size, start, us;
+	char *in, *out;
+	int err = 0;
+	u64 bytes;
+	int i;
+
+	in = malloc(TEST_BUFFER_SIZE);
+	out = malloc(TEST_BUFFER_SIZE);
+	if (!in || !out) {
+		err = -ENOMEM;
+		goto out;
+	}
+
+	printf("%-16s%10s%10s%10s\n", "", "in", "out", "KB/s");
+	for (i = 0; i < ARRAY_SIZE(algos); i++) {
+		in_size = TEST_BUFFER_SIZE;
+		if (algos[i].compress((void *)plain, plain_size, in, in_size,
+				      &in_size)) {
+			err = -EINVAL;
+			break;
+		}
+		bytes = 0;
+		start = timer_get_us();
+		do {
+			if (algos[i].uncompress(in, in_size, out,
+						TEST_BUFFER_SIZE, &out_size) ||
+			    out_size != plain_size) {
+				err = -EINVAL;
+				break;
+			}
+			bytes += out_size;
+			us = timer_get_us() - start;
+		} while (us < DECOMP_BENCH_US);
+		if (err)
+			break;
+		printf("%-16s%10lu%10lu%10lu\n", algos[i].name, in_size,
+		       plain_size, (ulong)(bytes * 1000 / us));
+	}
+	if (err)
+		printf("%s failed\n", algos[i].name);
+
+out:
+	free(out);
+	free(in);
+
+	return err;
+}
+
+/*
+ * Something like a kernel: 32-bit instructions with a few common opcodes,
+ * many of them repeating one seen recently
+ */
+static void fill_code(u32 *buf, ulong size)
+{
+	static const u32 opcodes[] = {
+		0xe5900000, 0xe5800000, 0xe1a00000, 0xe3500000,
+		0xeb000000, 0xe2800000, 0x1a000000, 0xe8bd8000,
+	};
+	uint seed = 1;
+	ulong i, n;
+
+	n = size / sizeof(*buf);
+	for (i = 0; i < n; i++) {
+		seed = seed * 1103515245 + 12345;
+		if (i > 1024 && (seed & 0x30000))
+			buf[i] = buf[i - 1 - ((seed >> 18) & 1023)];
+		else
+			buf[i] = opcodes[(seed >> 28) & 7] |
+				 ((seed >> 8) & 0xfff) << (seed & 0xc);
+	}
+}
+
+/*
+ * Something like an initramfs: text files, padded to 512-byte blocks,
+ * with the odd block of zeroes
+ */
+static void fill_text(char *buf, ulong size)
+{
+	ulong plain_size = strlen(plain);
+	uint seed = 1;
+	ulong i, len;
+
+	for (i = 0; i < size; i += len) {
+		seed = seed * 1103515245 + 12345;
+		len = min(size - i, (ulong)(seed >> 20) + 1);
+		if (!(seed & 0x70000)) {
+			memset(buf + i, '\0', len);
+			continue;
+		}
+		for (; (len & 511) && i + len < size; len++)
+			buf[i + len] = '\0';
+	}
+	for (i = 0, seed = 1; i < size; i++) {
+		/* Runs of text, at random places in the text */
+		if (!(i % 61))
+			seed = seed * 1103515245 + 12345;
+		if (buf[i])
+			buf[i] = plain[((seed >> 16) + i % 61) % plain_size];
+	}
+}
+
+/*
+ * Time gunzip() on a gzip file, reporting the output rate. If @orig is not
+ * NULL, the output must match it.
+ */
+static int decomp_bench_gzip(const char *name, const void *orig, void *gz,
+			     ulong gz_size, void *out, ulong out_max)
+{
+	ulong len, start, us;
+	u64 bytes = 0;
+
+	start = timer_get_us();
+	do {
+		len = gz_size;
+		if (gunzip(out, out_max, gz, &len) ||
+		    (orig && memcmp(orig, out, len))) {
+			printf("%s failed\n", name);
+			return -EINVAL;
+		}
+		bytes += len;
+		us = timer_get_us() - start;
+	} while (us < DECOMP_BENCH_US);
+	printf("%-16s%10lu%10lu%10lu\n", name, gz_size, len,
+	       (ulong)(bytes * 1000 / us));
+
+	return 0;
+}
+
+static int do_ut_decomp_bench(cmd_tbl_t *cmdtp, int flag, int argc,
+			      char *const argv[])
+{
+	ulong size = GZIP_BENCH_SIZE;
+	char *buf, *gz, *out;
+	ulong gz_size;
+	int err;
+
+	buf = malloc(size);
+	gz = malloc(size);
+	out = malloc(size);
+	if (!buf || !gz || !out) {
+		err = -ENOMEM;
+		goto out;
+	}
+
+	/* A gzip file already in memory, such as a real kernel */
+	if (argc > 2) {
+		gz_size = simple_strtoul(argv[2], NULL, 16);
+		err = decomp_bench_gzip("gzip", NULL,
+					map_sysmem(simple_strtoul(argv[1], NULL,
+								  16), gz_size),
+					gz_size, out, size);
+		goto out;
+	}
+
+	err = decomp_bench_algos();
+	if (err)
+		goto out;
+
+	fill_code((u32 *)buf, size);
+	gz_size = size;
+	err = gzip(gz, &gz_size, (uchar *)buf, size) ||
+		decomp_bench_gzip("gzip kernel", buf, gz, gz_size, out, size);
+	if (err)
+		goto out;
+
+	fill_text(buf, size);
+	gz_size = size;
+	err = gzip(gz, &gz_size, (uchar *)buf, size) ||
+		decomp_bench_gzip("gzip initramfs", buf, gz, gz_size, out,
+				  size);
+
+out:
+	free(out);
+	free(gz);
+	free(buf);
+
+	return err ? CMD_RET_FAILURE : CMD_RET_SUCCESS;
+}
+
+#ifdef CONFIG_DECOMP_STREAM
+#define STREAM_TEST_SIZE	(256 << 10)
+
+/* Feed @in to a decompression stream, @chunk bytes at a time */
+static int stream_decomp(int comp, const void *in, ulong in_size, void *out,
+			 ulong out_max, ulong chunk, ulong *out_size)
+{
+	struct decomp_stream ds;
+	ulong pos, n;
+	int ret, err;
+
+	ret = decomp_stream_start(&ds, comp, out, out_max);
+	if (ret)
+		return ret;
+	for (pos = 0; pos < in_size && !ret; pos += n) {
+		n = min(chunk, in_size - pos);
+		ret = decomp_stream_update(&ds, in + pos, n);
+	}
+	err = decomp_stream_finish(&ds, out_size);
+
+	return ret ? ret : err;
+}
+
+/**
+ * run_stream_test() - Decompress data fed in pieces of various sizes
+ *
+ * @name:	Name of the test
+ * @comp:	Compression type
+ * @orig:	Uncompressed data
+ * @orig_size:	Size of @orig
+ * @in:		Compressed data
+ * @in_size:	Size of @in
+ * @return 0 if OK, non-zero on failure
+ */
+static int run_stream_test(const char *name, int comp, const void *orig,
+			   ulong orig_size, const void *in, ulong in_size)
+{
+	static const ulong chunks[] = { 1, 7, 64, 4096, ULONG_MAX };
+	ulong out_size, start;
+	char *out;
+	int i, ret;
+
+	printf(" testing streamed %s ...\n", name);
+	out = malloc(orig_size + 1);
+	errcheck(out != NULL);
+
+	for (i = 0; i < ARRAY_SIZE(chunks); i++) {
+		memset(out, 'A', orig_size + 1);
+		start = timer_get_us();
+		errcheck(stream_decomp(comp, in, in_size, out, orig_size,
+				       chunks[i], &out_size) == 0);
+		printf("\t%lu-byte pieces: %lu us\n", min(chunks[i], in_size),
+		       timer_get_us() - start);
+		errcheck(out_size == orig_size);
+		errcheck(memcmp(orig, out, orig_size) == 0);
+		errcheck(out[orig_size] == 'A');
+	}
+
+	/* Make sure decompression does not over-run. */
+	memset(out, 'A', orig_size + 1);
+	errcheck(stream_decomp(comp, in, in_size, out, orig_size - 1, 64,
+			       NULL) == -ENOSPC);
+	errcheck(out[orig_size - 1] == 'A');
+
+	/* A stream which is cut short is noticed */
+	if (comp != IH_COMP_NONE)
+		errcheck(stream_decomp(comp, in, in_size / 2, out, orig_size,
+				       64, NULL) == -EIO);
+	ret = 0;
+
+out:
+	printf(" %s: %s\n", name, ret == 0 ? "ok" : "FAILED");
+	free(out);
+
+	return ret;
+}
+
+/* Put every optional part into a gzip header, which must all be skipped */
+static ulong gzip_add_header_fields(char *out, const char *in, ulong in_size)
+{
+	static const char fields[] = "\x03\x00xyzplain.txt\0comment\0\x12\x34";
+	ulong len = 10;
+
+	memcpy(out, in, len);
+	out[3] |= 0x02 | 0x04 | 0x08 | 0x10;
+	memcpy(out + len, fields, sizeof(fields) - 1);
+	len += sizeof(fields) - 1;
+	memcpy(out + len, in + 10, in_size - 10);
+
+	return len + in_size - 10;
+}
+
+static int do_ut_decomp_stream(cmd_tbl_t *cmdtp, int flag, int argc,
+			       char *const argv[])
+{
+	ulong plain_size = strlen(plain);
+	ulong big_size, gz_size, hdr_size;
+	char *big, *gz, *hdr;
+	uint seed;
+	int err = 0;
+	ulong i;
+
+	err += run_stream_test("none", IH_COMP_NONE, plain, plain_size, plain,
+			       plain_size);
+	err += run_stream_test("lzma", IH_COMP_LZMA, plain, plain_size,
+			       lzma_compressed, lzma_compressed_size);
+	err += run_stream_test("lzo", IH_COMP_LZO, plain, plain_size,
+			       lzo_compressed, lzo_compressed_size);
+
+	/* Something large enough to span many deflate blocks */
+	big_size = STREAM_TEST_SIZE;
+	gz_size = big_size * 2;
+	big = malloc(big_size);
+	gz = malloc(gz_size);
+	hdr = malloc(gz_size + 64);
+	if (!big || !gz || !hdr) {
+		err++;
+		goto out;
+	}
+	for (i = 0, seed = 1; i < big_size; i++) {
+		/* Runs of text, at random places in the text */
+		if (!(i % 61))
+			seed = seed * 1103515245 + 12345;
+		big[i] = plain[((seed >> 16) + i % 61) % plain_size];
+	}
+	if (gzip(gz, &gz_size, (uchar *)big, big_size)) {
+		err++;
+		goto out;
+	}
+	err += run_stream_test("gzip", IH_COMP_GZIP, big, big_size, gz,
+			       gz_size);
+	hdr_size = gzip_add_header_fields(hdr, gz, gz_size);
+	err += run_stream_test("gzip header fields", IH_COMP_GZIP, big,
+			       big_size, hdr, hdr_size);
+
+out:
+	free(hdr);
+	free(gz);
+	free(big);
+	printf("ut_decomp_stream %s\n", err == 0 ? "ok" : "FAILED");
+
+	return err ? CMD_RET_FAILURE : CMD_RET_SUCCESS;
+}
+#endif
+
 U_BOOT_CMD(
 	ut_compression,	5,	1,	do_ut_compression,
-	"Basic test of compressors: gzip bzip2 lzma lzo", ""
+	"Basic test of compressors: gzip bzip2 lzma lzo lz4", ""
 );
 
 U_BOOT_CMD(
 	ut_image_decomp,	5,	1, do_ut_image_decomp,
 	"Basic test of bootm decompression", ""
 );
+
+U_BOOT_CMD(
+	ut_decomp_bench,	3,	1,	do_ut_decomp_bench,
+	"Compare decompression speed: none gzip bzip2 lzma lzo lz4",
+	"\n    - compare the algorithms, then time gzip on large images\n"
+	"ut_decomp_bench <addr> <size>\n"
+	"    - time gzip on a gzip file in memory, up to 4MB uncompressed"
+);
+
+#ifdef CONFIG_DECOMP_STREAM
+U_BOOT_CMD(
+	ut_decomp_stream,	5,	1,	do_ut_decomp_stream,
+	"Test of streaming decompression: none gzip lzma lzo", ""
+);
+#endif
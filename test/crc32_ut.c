@@ -0,0 +1,166 @@
+/*
+ * Tests and throughput benchmark for the CRC32 engine
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <command.h>
+#include <errno.h>
+#include <mapmem.h>
+#include <u-boot/crc.h>
+
+DECLARE_GLOBAL_DATA_PTR;
+
+#define CRC32_BENCH_MIN_SIZE	(4 << 10)
+#define CRC32_BENCH_MAX_SIZE	(64 << 20)
+
+/* Each benchmark size is repeated until at least this much is processed */
+#define CRC32_BENCH_MIN_TOTAL	(16 << 20)
+
+/* Space left below the stack when fitting the benchmark buffer */
+#define CRC32_BENCH_STACK	(1 << 20)
+
+/* Bit-at-a-time reference implementation, used to check the fast engines */
+static uint32_t crc32_ref(uint32_t crc, const uint8_t *buf, uint len)
+{
+	int bit;
+
+	crc = ~crc;
+	while (len--) {
+		crc ^= *buf++;
+		for (bit = 0; bit < 8; bit++)
+			crc = (crc >> 1) ^ (0xedb88320 & -(crc & 1));
+	}
+
+	return ~crc;
+}
+
+static int test_crc32_vector(void)
+{
+	static const char check[] = "123456789";
+	uint32_t crc;
+
+	crc = crc32(0, (const uint8_t *)check, strlen(check));
+	if (crc != 0xcbf43926) {
+		printf("%s: crc32(\"%s\") = %08x, expected cbf43926\n",
+		       __func__, check, crc);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/*
+ * Check every combination of start alignment and a range of lengths, so that
+ * the byte-wise head, the sliced body and the word/byte tail are all covered.
+ */
+static int test_crc32_alignment(void)
+{
+	uint8_t buf[256 + 8];
+	uint32_t crc, expect;
+	int off, len, i;
+
+	for (i = 0; i < sizeof(buf); i++)
+		buf[i] = i * 37 + 11;
+
+	for (off = 0; off < 8; off++) {
+		for (len = 0; len <= 256; len++) {
+			expect = crc32_ref(0x12345678, buf + off, len);
+			crc = crc32(0x12345678, buf + off, len);
+			if (crc != expect) {
+				printf("%s: off=%d, len=%d: got %08x, expected %08x\n",
+				       __func__, off, len, crc, expect);
+				return -EINVAL;
+			}
+		}
+	}
+
+	/* Splitting the input must give the same result */
+	expect = crc32(0, buf, sizeof(buf));
+	for (len = 0; len <= sizeof(buf); len += 13) {
+		crc = crc32(0, buf, len);
+		crc = crc32(crc, buf + len, sizeof(buf) - len);
+		if (crc != expect) {
+			printf("%s: split at %d: got %08x, expected %08x\n",
+			       __func__, len, crc, expect);
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+static int test_crc32_wd(void)
+{
+	uint8_t buf[1000];
+	uint32_t crc, expect;
+	int i;
+
+	for (i = 0; i < sizeof(buf); i++)
+		buf[i] = i ^ (i >> 3);
+
+	expect = crc32(0, buf, sizeof(buf));
+	crc = crc32_wd(0, buf, sizeof(buf), 7);
+	if (crc != expect) {
+		printf("%s: got %08x, expected %08x\n", __func__, crc, expect);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/*
+ * Report the throughput of crc32_wd() for buffer sizes from 4KiB up to
+ * 64MiB. The buffer lives at the load address, so any image there is
+ * overwritten. Sizes which do not fit between the load address and the
+ * stack are skipped.
+ */
+static void bench_crc32(void)
+{
+	ulong size, max_size, total, start, us;
+	uint8_t *buf;
+	uint32_t crc;
+	int i;
+
+	max_size = 0;
+	if (gd->start_addr_sp > CONFIG_SYS_LOAD_ADDR + CRC32_BENCH_STACK)
+		max_size = gd->start_addr_sp - CONFIG_SYS_LOAD_ADDR -
+			CRC32_BENCH_STACK;
+	max_size = min_t(ulong, CRC32_BENCH_MAX_SIZE, max_size);
+	buf = map_sysmem(CONFIG_SYS_LOAD_ADDR, max_size);
+	for (i = 0; i < max_size; i++)
+		buf[i] = i * 7 + (i >> 9);
+
+	printf("%10s %10s %8s\n", "size", "time(us)", "MB/s");
+	for (size = CRC32_BENCH_MIN_SIZE; size <= max_size; size <<= 2) {
+		total = 0;
+		crc = 0;
+		start = timer_get_us();
+		do {
+			crc = crc32_wd(crc, buf, size, CHUNKSZ_CRC32);
+			total += size;
+		} while (total < CRC32_BENCH_MIN_TOTAL);
+		us = max(timer_get_us() - start, 1UL);
+
+		/* One byte per microsecond is one MB/s */
+		printf("%10lu %10lu %8lu\n", size, us, total / us);
+	}
+
+	unmap_sysmem(buf);
+}
+
+int do_ut_crc32(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
+{
+	int ret = 0;
+
+	ret |= test_crc32_vector();
+	ret |= test_crc32_alignment();
+	ret |= test_crc32_wd();
+	if (!ret)
+		bench_crc32();
+
+	printf("Test %s\n", ret ? "failed" : "passed");
+
+	return ret ? CMD_RET_FAILURE : CMD_RET_SUCCESS;
+}
@@ -12,6 +12,7 @@
 #include <fdtdec.h>
 #include <malloc.h>
 #include <dm/device-internal.h>
+#include <dm/lists.h>
 #include <dm/root.h>
 #include <dm/util.h>
 #include <dm/test.h>
@@ -791,3 +792,164 @@ static int dm_test_device_get_uclass_id(struct unit_test_state *uts)
 	return 0;
 }
 DM_TEST(dm_test_device_get_uclass_id, DM_TESTF_SCAN_PDATA);
+
+/*
+ * Number of devices bound by the uclass index tests, and how many of them
+ * are probed, which must be fewer than DM_MAX_SEQ
+ */
+#define DM_TEST_MANY_DEVS	2000
+#define DM_TEST_MANY_PROBED	500
+
+/* Device tree offset given to each, which need not be a real node */
+#define DM_TEST_MANY_OF_OFFSET(i)	(0x100 + (i) * 0x40)
+
+/* The devices keep pointers to their names, so these outlive each test */
+static struct {
+	char name[DM_TEST_MANY_DEVS][12];
+	struct udevice *dev[DM_TEST_MANY_DEVS];
+} dm_test_many;
+
+/* Bind lots of test devices and probe the first few, so device i gets seq i */
+static int dm_test_bind_many(struct unit_test_state *uts)
+{
+	struct dm_test_state *dms = uts->priv;
+	const struct driver *drv;
+	int i;
+
+	drv = lists_driver_lookup_name("test_drv");
+	ut_assert(drv);
+	for (i = 0; i < DM_TEST_MANY_DEVS; i++) {
+		snprintf(dm_test_many.name[i], sizeof(dm_test_many.name[i]),
+			 "many%d", i);
+		ut_assertok(device_bind(dms->root, drv, dm_test_many.name[i],
+					(void *)&test_pdata_manual,
+					DM_TEST_MANY_OF_OFFSET(i),
+					&dm_test_many.dev[i]));
+	}
+	for (i = 0; i < DM_TEST_MANY_PROBED; i++)
+		ut_assertok(device_probe(dm_test_many.dev[i]));
+
+	return 0;
+}
+
+/* Test that lookups stay right as devices are bound, probed and removed */
+static int dm_test_uclass_index(struct unit_test_state *uts)
+{
+	struct udevice **many = dm_test_many.dev;
+	struct udevice *dev;
+	int i, last;
+
+	ut_assertok(dm_test_bind_many(uts));
+	for (i = 0; i < DM_TEST_MANY_DEVS; i++) {
+		if (i < DM_TEST_MANY_PROBED) {
+			ut_assertok(uclass_find_device_by_seq(UCLASS_TEST, i,
+							      false, &dev));
+			ut_asserteq_ptr(many[i], dev);
+		}
+		ut_assertok(uclass_find_device_by_name(UCLASS_TEST,
+						       dm_test_many.name[i],
+						       &dev));
+		ut_asserteq_ptr(many[i], dev);
+		ut_assertok(uclass_find_device_by_of_offset(UCLASS_TEST,
+				DM_TEST_MANY_OF_OFFSET(i), &dev));
+		ut_asserteq_ptr(many[i], dev);
+	}
+	ut_asserteq(-ENODEV, uclass_find_device_by_seq(UCLASS_TEST,
+						       DM_TEST_MANY_PROBED,
+						       false, &dev));
+	ut_asserteq(-ENODEV, uclass_find_device_by_name(UCLASS_TEST, "none",
+							&dev));
+	ut_asserteq(-ENODEV, uclass_find_device_by_of_offset(UCLASS_TEST, 0x10,
+							     &dev));
+
+	/* A name which is only a prefix finds the first device it matches */
+	ut_assertok(uclass_find_device_by_name(UCLASS_TEST, "many", &dev));
+	ut_asserteq_ptr(many[0], dev);
+
+	/* Removing a device frees its sequence number until it is probed */
+	ut_assertok(device_remove(many[5]));
+	ut_asserteq(-ENODEV, uclass_find_device_by_seq(UCLASS_TEST, 5, false,
+						       &dev));
+	ut_assertok(device_probe(many[5]));
+	ut_asserteq(5, many[5]->seq);
+	ut_assertok(uclass_find_device_by_seq(UCLASS_TEST, 5, false, &dev));
+	ut_asserteq_ptr(many[5], dev);
+
+	/* A device can be given a different node */
+	dev_set_of_offset(many[7], 0x10);
+	ut_asserteq(-ENODEV, uclass_find_device_by_of_offset(UCLASS_TEST,
+				DM_TEST_MANY_OF_OFFSET(7), &dev));
+	ut_assertok(uclass_find_device_by_of_offset(UCLASS_TEST, 0x10, &dev));
+	ut_asserteq_ptr(many[7], dev);
+
+	/* An unbound device cannot be found any more */
+	last = DM_TEST_MANY_PROBED - 1;
+	ut_assertok(device_remove(many[last]));
+	ut_assertok(device_unbind(many[last]));
+	ut_asserteq(-ENODEV, uclass_find_device_by_seq(UCLASS_TEST, last,
+						       false, &dev));
+	ut_asserteq(-ENODEV, uclass_find_device_by_name(UCLASS_TEST,
+							dm_test_many.name[last],
+							&dev));
+	ut_asserteq(-ENODEV, uclass_find_device_by_of_offset(UCLASS_TEST,
+				DM_TEST_MANY_OF_OFFSET(last), &dev));
+
+	return 0;
+}
+DM_TEST(dm_test_uclass_index, 0);
+
+/*
+ * Time lookups of each of many devices. For comparison, also time finding
+ * each one by walking the uclass's list of devices.
+ */
+static int dm_test_uclass_lookup_speed(struct unit_test_state *uts)
+{
+	const int count = DM_TEST_MANY_DEVS;
+	const int probed = DM_TEST_MANY_PROBED;
+	ulong seq_us, name_us, node_us, uc_us, walk_us, start;
+	struct udevice *dev;
+	struct uclass *uc;
+	int i;
+
+	ut_assertok(dm_test_bind_many(uts));
+	ut_assertok(uclass_get(UCLASS_TEST, &uc));
+
+	start = timer_get_us();
+	for (i = 0; i < probed; i++)
+		uclass_find_device_by_seq(UCLASS_TEST, i, false, &dev);
+	seq_us = timer_get_us() - start;
+
+	start = timer_get_us();
+	for (i = 0; i < count; i++)
+		uclass_find_device_by_name(UCLASS_TEST, dm_test_many.name[i],
+					   &dev);
+	name_us = timer_get_us() - start;
+
+	start = timer_get_us();
+	for (i = 0; i < count; i++)
+		uclass_find_device_by_of_offset(UCLASS_TEST,
+						DM_TEST_MANY_OF_OFFSET(i), &dev);
+	node_us = timer_get_us() - start;
+
+	start = timer_get_us();
+	for (i = 0; i < count; i++)
+		ut_asserteq_ptr(uc, uclass_find(UCLASS_TEST));
+	uc_us = timer_get_us() - start;
+
+	start = timer_get_us();
+	for (i = 0; i < count; i++) {
+		list_for_each_entry(dev, &uc->dev_head, uclass_node) {
+			if (dev->of_offset == DM_TEST_MANY_OF_OFFSET(i))
+				break;
+		}
+	}
+	walk_us = timer_get_us() - start;
+
+	printf("%d devices, ns per lookup: seq %lu, name %lu, of_offset %lu, uclass %lu, list walk %lu\n",
+	       count, seq_us * 1000 / probed, name_us * 1000 / count,
+	       node_us * 1000 / count, uc_us * 1000 / count,
+	       walk_us * 1000 / count);
+
+	return 0;
+}
+DM_TEST(dm_test_uclass_lookup_speed, 0);
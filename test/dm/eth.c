@@ -11,9 +11,11 @@
 #include <dm.h>
 #include <fdtdec.h>
 #include <malloc.h>
+#include <mapmem.h>
 #include <net.h>
 #include <dm/test.h>
 #include <asm/eth.h>
+#include <asm/test.h>
 #include <test/ut.h>
 
 DECLARE_GLOBAL_DATA_PTR;
@@ -190,3 +192,527 @@ static int dm_test_net_retry(struct unit_test_state *uts)
 	return retval;
 }
 DM_TEST(dm_test_net_retry, DM_TESTF_SCAN_FDT);
+
+#define TFTP_TEST_ADDR		0x100000
+
+/*
+ * Fetch a file of @size bytes from the mock TFTP server and check it. The
+ * throughput is shown, since this is mostly about the window size.
+ */
+static int _dm_test_eth_tftp(struct unit_test_state *uts, ulong size,
+			     int blksize, int windowsize, ulong drop_block)
+{
+	ulong start, us, acks, blocks;
+	u8 *buf, *expect;
+	char str[12];
+
+	sprintf(str, "%d", blksize);
+	setenv("tftpblocksize", str);
+	sprintf(str, "%d", windowsize);
+	setenv("tftpwindowsize", str);
+	sandbox_eth_tftp_setup(size, drop_block);
+
+	buf = map_sysmem(TFTP_TEST_ADDR, size);
+	memset(buf, '\0', size);
+	start = timer_get_us();
+	ut_asserteq(size, net_loop(TFTPGET));
+	us = max(timer_get_us() - start, 1UL);
+
+	expect = malloc(size);
+	ut_assert(expect);
+	sandbox_eth_tftp_fill(expect, 0, size);
+	ut_assertok(memcmp(buf, expect, size));
+	free(expect);
+	unmap_sysmem(buf);
+
+	/* One ACK per window, plus the OACK and a resend for a lost block */
+	acks = sandbox_eth_tftp_acks();
+	blocks = size / blksize + 1;
+	ut_assert(acks <= DIV_ROUND_UP(blocks, windowsize) + 1 + !!drop_block);
+
+	printf("blksize %5d windowsize %2d: %8lu KiB/s, %lu ACKs\n", blksize,
+	       windowsize, (ulong)((u64)size * 1000000 / us >> 10), acks);
+
+	return 0;
+}
+
+static int dm_test_eth_tftp(struct unit_test_state *uts)
+{
+	ulong old_load_addr = load_addr;
+	int retval;
+
+	net_server_ip = string_to_ip("1.1.2.2");
+	strcpy(net_boot_file_name, "test.bin");
+	load_addr = TFTP_TEST_ADDR;
+	setenv("ethact", "eth@10002000");
+
+	retval = _dm_test_eth_tftp(uts, 1 << 20, 1468, 1, 0);
+	if (!retval)
+		retval = _dm_test_eth_tftp(uts, 1 << 20, 1468, 4, 0);
+	if (!retval)
+		retval = _dm_test_eth_tftp(uts, 1 << 20, 1468, 16, 0);
+	if (!retval)
+		retval = _dm_test_eth_tftp(uts, 1 << 20, 1468, 64, 0);
+	/* A lost block must be recovered without waiting for a timeout */
+	if (!retval)
+		retval = _dm_test_eth_tftp(uts, 100000, 1024, 8, 20);
+	/* The block number wraps after 64K blocks */
+	if (!retval)
+		retval = _dm_test_eth_tftp(uts, 65536 * 8 + 3, 8, 16, 0);
+
+	/* Restore the env */
+	sandbox_eth_tftp_setup(0, 0);
+	setenv("tftpblocksize", NULL);
+	setenv("tftpwindowsize", NULL);
+	net_boot_file_name[0] = '\0';
+	load_addr = old_load_addr;
+
+	return retval;
+}
+DM_TEST(dm_test_eth_tftp, DM_TESTF_SCAN_FDT);
+
+#ifdef CONFIG_DECOMP_STREAM
+/* The asserts include a return on fail; cleanup in the caller */
+static int _dm_test_eth_tftpcomp(struct unit_test_state *uts, u8 *expect,
+				 u8 *gz, ulong size)
+{
+	unsigned long gz_size = size;
+	u8 *buf;
+
+	sandbox_eth_tftp_fill(expect, 0, size);
+	ut_assertok(gzip(gz, &gz_size, expect, size));
+	setenv("tftpcomp", "gzip");
+
+	/* The file is decompressed as it arrives, in blocks of any size */
+	sandbox_eth_tftp_setup(gz_size, 0);
+	sandbox_eth_tftp_data(gz);
+	setenv("tftpblocksize", "1468");
+	buf = map_sysmem(TFTP_TEST_ADDR, size);
+	memset(buf, '\0', size);
+	ut_asserteq(size, net_loop(TFTPGET));
+	ut_asserteq(size, getenv_hex("filesize", 0));
+	ut_assertok(memcmp(buf, expect, size));
+
+	/* A lost block is resent before it is decompressed */
+	sandbox_eth_tftp_setup(gz_size, 3);
+	sandbox_eth_tftp_data(gz);
+	setenv("tftpblocksize", "512");
+	setenv("tftpwindowsize", "8");
+	memset(buf, '\0', size);
+	ut_asserteq(size, net_loop(TFTPGET));
+	ut_assertok(memcmp(buf, expect, size));
+	unmap_sysmem(buf);
+
+	/* A truncated file fails */
+	sandbox_eth_tftp_setup(gz_size / 2, 0);
+	sandbox_eth_tftp_data(gz);
+	ut_assert(net_loop(TFTPGET) < 0);
+
+	return 0;
+}
+
+static int dm_test_eth_tftpcomp(struct unit_test_state *uts)
+{
+	ulong old_load_addr = load_addr;
+	ulong size = 300000;
+	u8 *expect, *gz;
+	int retval;
+
+	net_server_ip = string_to_ip("1.1.2.2");
+	strcpy(net_boot_file_name, "test.bin.gz");
+	load_addr = TFTP_TEST_ADDR;
+	setenv("ethact", "eth@10002000");
+
+	expect = malloc(size);
+	gz = malloc(size);
+	ut_assert(expect && gz);
+	retval = _dm_test_eth_tftpcomp(uts, expect, gz, size);
+	free(gz);
+	free(expect);
+
+	/* Restore the env */
+	sandbox_eth_tftp_setup(0, 0);
+	setenv("tftpcomp", NULL);
+	setenv("tftpblocksize", NULL);
+	setenv("tftpwindowsize", NULL);
+	net_boot_file_name[0] = '\0';
+	load_addr = old_load_addr;
+
+	return retval;
+}
+DM_TEST(dm_test_eth_tftpcomp, DM_TESTF_SCAN_FDT);
+#endif
+
+/*
+ * Fetch a file of @size bytes from the mock NFS server and check it. The
+ * server answers READs out of order and sends large replies as IP fragments.
+ */
+static int _dm_test_eth_nfs(struct unit_test_state *uts, ulong size,
+			    int vers, int rsize, int window, ulong drop_read)
+{
+	ulong start, us, reads;
+	u8 *buf, *expect;
+	char str[12];
+
+	sprintf(str, "%d", rsize);
+	setenv("nfsrsize", str);
+	sprintf(str, "%d", window);
+	setenv("nfswindow", str);
+	sandbox_eth_nfs_setup(size, vers, drop_read);
+
+	buf = map_sysmem(TFTP_TEST_ADDR, size);
+	memset(buf, '\0', size);
+	start = timer_get_us();
+	ut_asserteq(size, net_loop(NFS));
+	us = max(timer_get_us() - start, 1UL);
+
+	expect = malloc(size);
+	ut_assert(expect);
+	sandbox_eth_tftp_fill(expect, 0, size);
+	ut_assertok(memcmp(buf, expect, size));
+	free(expect);
+	unmap_sysmem(buf);
+
+	/* One READ per block, plus a resend for a lost one */
+	reads = sandbox_eth_nfs_reads();
+	ut_asserteq(DIV_ROUND_UP(size, rsize) + !!drop_read, reads);
+
+	printf("NFSv%d rsize %5d window %2d: %8lu KiB/s, %lu READs\n", vers,
+	       rsize, window, (ulong)((u64)size * 1000000 / us >> 10), reads);
+
+	return 0;
+}
+
+static int dm_test_eth_nfs(struct unit_test_state *uts)
+{
+	ulong old_load_addr = load_addr;
+	int retval;
+
+	net_server_ip = string_to_ip("1.1.2.2");
+	strcpy(net_boot_file_name, "/export/test.bin");
+	load_addr = TFTP_TEST_ADDR;
+	setenv("ethact", "eth@10002000");
+
+	retval = _dm_test_eth_nfs(uts, 1 << 20, 2, 1024, 1, 0);
+	if (!retval)
+		retval = _dm_test_eth_nfs(uts, 1 << 20, 2, 8192, 4, 0);
+	if (!retval)
+		retval = _dm_test_eth_nfs(uts, 1 << 20, 3, 1024, 1, 0);
+	if (!retval)
+		retval = _dm_test_eth_nfs(uts, 1 << 20, 3, 16384, 1, 0);
+	if (!retval)
+		retval = _dm_test_eth_nfs(uts, 1 << 20, 3, 16384, 8, 0);
+	/* Each READ reply is 23 fragments */
+	if (!retval)
+		retval = _dm_test_eth_nfs(uts, 1 << 20, 3, 32768, 8, 0);
+	/* A lost reply is sent again after a timeout, and a short last READ */
+	if (!retval)
+		retval = _dm_test_eth_nfs(uts, 100000, 3, 4096, 8, 5);
+
+	/* Restore the env */
+	sandbox_eth_nfs_setup(0, 0, 0);
+	setenv("nfsrsize", NULL);
+	setenv("nfswindow", NULL);
+	net_boot_file_name[0] = '\0';
+	load_addr = old_load_addr;
+
+	return retval;
+}
+DM_TEST(dm_test_eth_nfs, DM_TESTF_SCAN_FDT);
+
+/*
+ * Fetch a file of @size bytes from the mock HTTP server and check it. The
+ * server sends as much as the client's receive window allows, taking one
+ * simulated round trip per window.
+ */
+static int _dm_test_eth_wget(struct unit_test_state *uts, ulong size,
+			     bool wscale, ulong drop_segment)
+{
+	ulong start, us, acks, segments;
+	u8 *buf, *expect;
+
+	sandbox_eth_http_setup(size, wscale, drop_segment);
+
+	buf = map_sysmem(TFTP_TEST_ADDR, size);
+	memset(buf, '\0', size);
+	start = timer_get_us();
+	ut_asserteq(size, net_loop(WGET));
+	us = max(timer_get_us() - start, 1UL);
+
+	expect = malloc(size);
+	ut_assert(expect);
+	sandbox_eth_tftp_fill(expect, 0, size);
+	ut_assertok(memcmp(buf, expect, size));
+	free(expect);
+	unmap_sysmem(buf);
+
+	/* A lost segment is sent again once, after three duplicate ACKs */
+	ut_asserteq(!!drop_segment, sandbox_eth_http_retransmits());
+
+	/*
+	 * About one ACK per two segments, plus a duplicate for each segment
+	 * after a loss which arrives before the retransmission. Received
+	 * packets come in batches, so that can be a whole batch.
+	 */
+	acks = sandbox_eth_http_acks();
+	segments = DIV_ROUND_UP(size, 1460);
+	ut_assert(acks <= segments / 2 + ETH_RX_BATCH + 8);
+
+	printf("HTTP wscale %d: %8lu KiB/s, %lu ACKs\n", wscale,
+	       (ulong)((u64)size * 1000000 / us >> 10), acks);
+
+	return 0;
+}
+
+static int dm_test_eth_wget(struct unit_test_state *uts)
+{
+	ulong old_load_addr = load_addr;
+	int retval;
+
+	net_server_ip = string_to_ip("1.1.2.2");
+	strcpy(net_boot_file_name, "/test.bin");
+	load_addr = TFTP_TEST_ADDR;
+	setenv("ethact", "eth@10002000");
+
+	retval = _dm_test_eth_wget(uts, 1 << 20, false, 0);
+	if (!retval)
+		retval = _dm_test_eth_wget(uts, 1 << 20, true, 0);
+	if (!retval)
+		retval = _dm_test_eth_wget(uts, 100000, true, 20);
+
+	/* A missing file fails */
+	if (!retval) {
+		strcpy(net_boot_file_name, "/notfound");
+		sandbox_eth_http_setup(100, true, 0);
+		ut_assert(net_loop(WGET) < 0);
+	}
+
+	/* Restore the env */
+	sandbox_eth_http_setup(0, false, 0);
+	net_boot_file_name[0] = '\0';
+	load_addr = old_load_addr;
+
+	return retval;
+}
+DM_TEST(dm_test_eth_wget, DM_TESTF_SCAN_FDT);
+
+/* Count the packets per second through net_loop(), @batch at a time */
+static int _dm_test_eth_rx_batch(struct unit_test_state *uts, int batch)
+{
+	ulong start, us, frames, batches;
+
+	sandbox_eth_rx_batch_setup(batch);
+	start = timer_get_us();
+	ut_assertok(_dm_test_eth_wget(uts, 4 << 20, true, 0));
+	us = max(timer_get_us() - start, 1UL);
+
+	frames = sandbox_eth_rx_frames();
+	batches = sandbox_eth_rx_batches();
+	ut_assert(frames > (4 << 20) / 1460);
+	if (batch == 1) {
+		ut_asserteq(frames, batches);
+	} else {
+		ut_assert(frames >= batches * 4);
+	}
+
+	printf("rx batch %2d: %lu packets, %8lu packets/s, %lu per batch\n",
+	       batch, frames, (ulong)((u64)frames * 1000000 / us),
+	       frames / batches);
+
+	return 0;
+}
+
+static int dm_test_eth_rx_batch(struct unit_test_state *uts)
+{
+	ulong old_load_addr = load_addr;
+	int retval;
+
+	net_server_ip = string_to_ip("1.1.2.2");
+	strcpy(net_boot_file_name, "/test.bin");
+	load_addr = TFTP_TEST_ADDR;
+	setenv("ethact", "eth@10002000");
+
+	retval = _dm_test_eth_rx_batch(uts, 1);
+	if (!retval)
+		retval = _dm_test_eth_rx_batch(uts, ETH_RX_BATCH);
+
+	/* Restore the env */
+	sandbox_eth_rx_batch_setup(0);
+	sandbox_eth_http_setup(0, false, 0);
+	net_boot_file_name[0] = '\0';
+	load_addr = old_load_addr;
+
+	return retval;
+}
+DM_TEST(dm_test_eth_rx_batch, DM_TESTF_SCAN_FDT);
+
+#ifdef CONFIG_IP_DEFRAG
+#define DEFRAG_FRAG_SIZE	1480
+#define DEFRAG_PORT		5000
+
+static uchar defrag_dgram[3 * DEFRAG_FRAG_SIZE] __aligned(4);
+static int defrag_count;	/* Datagrams passed to the UDP handler */
+static int defrag_id;		/* Datagram ID of the last one */
+static int defrag_ok;		/* The contents were right */
+
+static void defrag_handler(uchar *pkt, unsigned dport, struct in_addr sip,
+			   unsigned sport, unsigned len)
+{
+	struct ip_udp_hdr *ip = (void *)pkt - IP_UDP_HDR_SIZE;
+
+	defrag_count++;
+	defrag_id = ntohs(ip->ip_id);
+	defrag_ok = dport == DEFRAG_PORT &&
+		ntohs(ip->ip_len) == IP_HDR_SIZE + UDP_HDR_SIZE + len &&
+		!memcmp(pkt, defrag_dgram + UDP_HDR_SIZE, len);
+}
+
+/* Set up a UDP datagram of @len bytes, including the UDP header */
+static void defrag_setup(int len)
+{
+	__be16 *udp = (__be16 *)defrag_dgram;
+	int i;
+
+	for (i = UDP_HDR_SIZE; i < len; i++)
+		defrag_dgram[i] = i * 7 + (i >> 8);
+	udp[0] = htons(DEFRAG_PORT + 1);
+	udp[1] = htons(DEFRAG_PORT);
+	udp[2] = htons(len);
+	udp[3] = 0;	/* no checksum */
+}
+
+/*
+ * Pass @size bytes at offset @off of the datagram with ID @id from source
+ * @src to net_process_received_packet() as a fragment
+ */
+static void defrag_send_at(int id, int src, int off, int size, bool more)
+{
+	static uchar pkt[PKTSIZE_ALIGN] __aligned(PKTALIGN);
+	struct ethernet_hdr *eth = (void *)pkt;
+	struct ip_udp_hdr *ip = (void *)pkt + ETHER_HDR_SIZE;
+	struct in_addr src_ip = net_ip;
+
+	src_ip.s_addr ^= htonl(src);
+	memset(eth, '\0', ETHER_HDR_SIZE);
+	eth->et_protlen = htons(PROT_IP);
+	net_set_ip_header((uchar *)ip, net_ip, src_ip);
+	ip->ip_len = htons(IP_HDR_SIZE + size);
+	ip->ip_id = htons(id);
+	ip->ip_off = htons(off / 8 | (more ? IP_FLAGS_MFRAG : 0));
+	ip->ip_p = IPPROTO_UDP;
+	ip->ip_sum = compute_ip_checksum(ip, IP_HDR_SIZE);
+	if (off + size <= sizeof(defrag_dgram))
+		memcpy((void *)ip + IP_HDR_SIZE, defrag_dgram + off, size);
+
+	net_process_received_packet(pkt, ETHER_HDR_SIZE + IP_HDR_SIZE + size);
+}
+
+/* Send fragment @frag of the datagram of @len bytes with ID @id */
+static void defrag_send(int id, int src, int len, int frag)
+{
+	int off = frag * DEFRAG_FRAG_SIZE;
+	int size = min(len - off, DEFRAG_FRAG_SIZE);
+
+	defrag_send_at(id, src, off, size, off + size < len);
+}
+
+/* Check that fragments of several datagrams are reassembled correctly */
+static int dm_test_net_defrag(struct unit_test_state *uts)
+{
+	const struct net_defrag_stats *stats = net_defrag_get_stats();
+	const int len = sizeof(defrag_dgram) - 100;
+	struct in_addr old_ip = net_ip;
+	int i;
+
+	net_ip = string_to_ip("1.1.2.1");
+	net_set_udp_handler(defrag_handler);
+	net_defrag_reset();
+	defrag_setup(len);
+
+	/* In order, in reverse order and with the first fragment last */
+	defrag_count = 0;
+	for (i = 0; i < 3; i++)
+		defrag_send(1, 0, len, i);
+	ut_asserteq(1, defrag_count);
+	ut_assert(defrag_ok);
+	for (i = 2; i >= 0; i--)
+		defrag_send(2, 0, len, i);
+	ut_asserteq(2, defrag_count);
+	ut_assert(defrag_ok);
+	for (i = 1; i <= 3; i++)
+		defrag_send(7, 0, len, i % 3);
+	ut_asserteq(3, defrag_count);
+	ut_assert(defrag_ok);
+	ut_asserteq(9, stats->fragments);
+	ut_asserteq(3, stats->datagrams);
+
+	/* Interleaved, with the same ID from different sources */
+	defrag_count = 0;
+	for (i = 0; i < 3; i++) {
+		defrag_send(3, 0, len, i);
+		defrag_send(4, 0, len, 2 - i);
+		defrag_send(3, 1, len, i);
+	}
+	ut_asserteq(3, defrag_count);
+	ut_assert(defrag_ok);
+	ut_asserteq(6, stats->datagrams);
+
+	/* A duplicate fragment is dropped, leaving the datagram intact */
+	defrag_count = 0;
+	defrag_send(5, 0, len, 0);
+	defrag_send(5, 0, len, 0);
+	defrag_send(5, 0, len, 1);
+	defrag_send(5, 0, len, 2);
+	ut_asserteq(1, defrag_count);
+	ut_assert(defrag_ok);
+	ut_asserteq(1, stats->dropped);
+
+	/* The last fragment may be smaller than a UDP header */
+	defrag_count = 0;
+	defrag_setup(DEFRAG_FRAG_SIZE + 4);
+	defrag_send(6, 0, DEFRAG_FRAG_SIZE + 4, 1);
+	defrag_send(6, 0, DEFRAG_FRAG_SIZE + 4, 0);
+	ut_asserteq(1, defrag_count);
+	ut_assert(defrag_ok);
+	defrag_setup(len);
+
+	/* With all slots busy, the oldest datagram is dropped */
+	net_defrag_reset();
+	defrag_count = 0;
+	for (i = 0; i <= CONFIG_NET_DEFRAG_SLOTS; i++)
+		defrag_send(10 + i, 0, len, 0);
+	ut_asserteq(1, stats->evicted);
+	for (i = 1; i <= CONFIG_NET_DEFRAG_SLOTS; i++) {
+		defrag_send(10 + i, 0, len, 1);
+		defrag_send(10 + i, 0, len, 2);
+	}
+	ut_asserteq(CONFIG_NET_DEFRAG_SLOTS, defrag_count);
+	ut_asserteq(10 + CONFIG_NET_DEFRAG_SLOTS, defrag_id);
+	defrag_send(10, 0, len, 1);
+	defrag_send(10, 0, len, 2);
+	ut_asserteq(CONFIG_NET_DEFRAG_SLOTS, defrag_count);
+
+	/* An incomplete datagram times out */
+	net_defrag_reset();
+	defrag_count = 0;
+	defrag_send(20, 0, len, 0);
+	sandbox_timer_add_offset(CONFIG_NET_DEFRAG_TIMEOUT + 1);
+	defrag_send(20, 0, len, 1);
+	defrag_send(20, 0, len, 2);
+	ut_asserteq(0, defrag_count);
+	ut_asserteq(1, stats->timeouts);
+
+	/* A fragment beyond the largest datagram is dropped */
+	net_defrag_reset();
+	defrag_send_at(21, 0, IP_OFFS * 8, DEFRAG_FRAG_SIZE, false);
+	ut_asserteq(1, stats->dropped);
+	ut_asserteq(0, defrag_count);
+
+	net_defrag_reset();
+	net_set_udp_handler(NULL);
+	net_ip = old_ip;
+
+	return 0;
+}
+DM_TEST(dm_test_net_defrag, 0);
+#endif
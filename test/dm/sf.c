@@ -7,9 +7,11 @@
 #include <common.h>
 #include <dm.h>
 #include <fdtdec.h>
+#include <mapmem.h>
 #include <spi.h>
 #include <spi_flash.h>
 #include <asm/state.h>
+#include <dm/root.h>
 #include <dm/test.h>
 #include <dm/util.h>
 #include <test/ut.h>
@@ -41,3 +43,91 @@ static int dm_test_spi_flash(struct unit_test_state *uts)
 	return 0;
 }
 DM_TEST(dm_test_spi_flash, DM_TESTF_SCAN_PDATA | DM_TESTF_SCAN_FDT);
+
+#define SF_UPDATE_ADDR	0x100000
+#define SF_UPDATE_SIZE	0x40000
+
+/* Run sf update on the test data and return the time it took */
+static ulong sf_test_update(struct unit_test_state *uts,
+			    struct sandbox_sf_stats *stats)
+{
+	char cmd[60];
+	ulong start;
+
+	sprintf(cmd, "sf update %x 0 %x", SF_UPDATE_ADDR, SF_UPDATE_SIZE);
+	sandbox_sf_get_stats(stats, true);
+	start = get_timer(0);
+	ut_assertok(run_command(cmd, 0));
+	start = get_timer(start);
+	sandbox_sf_get_stats(stats, true);
+
+	return start;
+}
+
+/*
+ * Test that sf update only erases and programs what it has to, using the
+ * largest erase which fits, on a flash with 4KB sectors
+ */
+static int dm_test_spi_flash_update(struct unit_test_state *uts)
+{
+	struct sandbox_state *state = state_get_current();
+	struct sandbox_sf_stats stats;
+	ulong ms, i;
+	u8 *buf;
+
+	ut_assertok(run_command("sb save hostfs - 0 spi4k.bin 200000", 0));
+	state->spi[0][1].spec = "w25x16:spi4k.bin";
+	ut_assertok(dm_scan_other(false));
+	ut_assertok(run_command("sf probe 0:1", 0));
+
+	/* Erasing it all uses block erases, never a chip erase */
+	sandbox_sf_get_stats(&stats, true);
+	ut_assertok(run_command("sf erase 0 200000", 0));
+	sandbox_sf_get_stats(&stats, true);
+	ut_asserteq(0, stats.erase_chip + stats.erase_4k);
+	ut_asserteq(0x200000 / 0x10000, stats.erase_64k);
+
+	/* The last page of each sector is left erased */
+	buf = map_sysmem(SF_UPDATE_ADDR, SF_UPDATE_SIZE);
+	for (i = 0; i < SF_UPDATE_SIZE; i++)
+		buf[i] = i % 0x1000 >= 0xf00 ? 0xff : i % 251;
+
+	/* Blank sectors are programmed without being erased */
+	sf_test_update(uts, &stats);
+	ut_asserteq(0, stats.erase_4k + stats.erase_64k);
+	ut_asserteq(SF_UPDATE_SIZE / 256 * 15 / 16, stats.programs);
+
+	/* Changing everything erases whole blocks */
+	for (i = 0; i < SF_UPDATE_SIZE; i++)
+		buf[i] = i % 0x1000 >= 0xf00 ? 0xff : i % 241;
+	ms = sf_test_update(uts, &stats);
+	ut_asserteq(0, stats.erase_4k);
+	ut_asserteq(SF_UPDATE_SIZE / 0x10000, stats.erase_64k);
+	ut_asserteq(SF_UPDATE_SIZE / 256 * 15 / 16, stats.programs);
+	printf("sf update %dKiB: %lu 64KB erases, %lu pages, %lu ms\n",
+	       SF_UPDATE_SIZE >> 10, stats.erase_64k, stats.programs, ms);
+
+	/* Nothing changes the second time */
+	sf_test_update(uts, &stats);
+	ut_asserteq(0, stats.erase_4k + stats.erase_64k + stats.programs);
+
+	/* Changing one byte erases a single sector */
+	buf[0x5123]++;
+	sf_test_update(uts, &stats);
+	ut_asserteq(1, stats.erase_4k);
+	ut_asserteq(0, stats.erase_64k);
+	ut_asserteq(15, stats.programs);
+	unmap_sysmem(buf);
+
+	/* Check what ended up in the flash */
+	ut_assertok(run_command("sf read 200000 0 40000", 0));
+	ut_assertok(memcmp(map_sysmem(0x200000, SF_UPDATE_SIZE),
+			   map_sysmem(SF_UPDATE_ADDR, SF_UPDATE_SIZE),
+			   SF_UPDATE_SIZE));
+
+	sandbox_sf_unbind_emul(state, 0, 1);
+	state->spi[0][1].spec = NULL;
+
+	return 0;
+}
+DM_TEST(dm_test_spi_flash_update, DM_TESTF_SCAN_PDATA | DM_TESTF_SCAN_FDT);
@@ -0,0 +1,208 @@
+/*
+ * Tests and benchmark for the hash table holding the environment
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <command.h>
+#include <malloc.h>
+#include <search.h>
+#include <test/env.h>
+#include <test/ut.h>
+
+#define HT_TEST_VARS		400	/* About 16 KB of environment */
+#define HT_TEST_ENV_SIZE	0x8000
+#define HT_BENCH_ROUNDS		20
+#define HT_TEST_DELETES		2000	/* About 24 KB of keys */
+
+/* Build an environment blob as saveenv writes it, sorted by name */
+static char *ht_make_env(int nvars, size_t *sizep)
+{
+	char *env, *p;
+	int i;
+
+	env = calloc(1, HT_TEST_ENV_SIZE);
+	if (!env)
+		return NULL;
+	for (i = 0, p = env; i < nvars; i++)
+		p += sprintf(p, "var%04d=value of variable %d, padded out", i,
+			     i) + 1;
+	*sizep = p + 1 - env;
+
+	return env;
+}
+
+static int ht_heap_used(void)
+{
+	return mallinfo().uordblks;
+}
+
+static int env_test_htab_import_export(struct unit_test_state *uts)
+{
+	struct hsearch_data htab = { .change_ok = NULL };
+	ENTRY e, *ep;
+	char *env, *res = NULL;
+	size_t size;
+	int before;
+
+	env = ht_make_env(HT_TEST_VARS, &size);
+	ut_assertnonnull(env);
+	before = ht_heap_used();
+
+	ut_asserteq(1, himport_r(&htab, env, HT_TEST_ENV_SIZE, '\0', 0, 0, 0,
+				 NULL));
+	ut_asserteq(HT_TEST_VARS, htab.filled);
+	e.key = "var0123";
+	ut_assert(hsearch_r(e, FIND, &ep, &htab, 0));
+	ut_asserteq_str("value of variable 123, padded out", ep->data);
+
+	/* An unchanged table must export exactly what was imported */
+	ut_assert(hexport_r(&htab, '\0', 0, &res, 0, 0, NULL) >= size);
+	ut_assertok(memcmp(env, res, size));
+	free(res);
+	res = NULL;
+
+	/* Change, add and delete a variable, and export again */
+	e.key = "var0123";
+	e.data = "new";
+	ut_assert(hsearch_r(e, ENTER, &ep, &htab, 0));
+	ut_asserteq_str("new", ep->data);
+	e.key = "aaa";
+	e.data = "first";
+	ut_assert(hsearch_r(e, ENTER, &ep, &htab, 0));
+	ut_assert(hdelete_r("var0000", &htab, 0));
+	ut_asserteq(HT_TEST_VARS, htab.filled);
+	ut_assert(hexport_r(&htab, '\n', 0, &res, 0, 0, NULL) > 0);
+	ut_assertok(strncmp(res, "aaa=first\nvar0001=", 18));
+	ut_assertnonnull(strstr(res, "\nvar0123=new\nvar0124="));
+	free(res);
+
+	hdestroy_r(&htab);
+	ut_asserteq(before, ht_heap_used());
+	free(env);
+
+	return 0;
+}
+ENV_TEST(env_test_htab_import_export, 0);
+
+/* Re-importing or re-setting variables must not use more memory each time */
+static int env_test_htab_reimport(struct unit_test_state *uts)
+{
+	struct hsearch_data htab = { .change_ok = NULL };
+	ENTRY e, *ep;
+	char *env;
+	size_t size;
+	int before, used = 0;
+	int i;
+
+	env = ht_make_env(HT_TEST_VARS, &size);
+	ut_assertnonnull(env);
+	before = ht_heap_used();
+
+	for (i = 0; i < 4; i++) {
+		ut_asserteq(1, himport_r(&htab, env, HT_TEST_ENV_SIZE, '\0',
+					 i & 1 ? H_NOCLEAR : 0, 0, 0, NULL));
+		e.key = "var0200";
+		e.data = i & 1 ? "odd" : "even";
+		ut_assert(hsearch_r(e, ENTER, &ep, &htab, 0));
+		ut_assert(hdelete_r("var0300", &htab, 0));
+		e.key = "var0300";
+		ut_assert(hsearch_r(e, ENTER, &ep, &htab, 0));
+		if (i == 1)
+			used = ht_heap_used();
+		else if (i > 1)
+			ut_asserteq(used, ht_heap_used());
+	}
+	ut_asserteq(HT_TEST_VARS, htab.filled);
+	hdestroy_r(&htab);
+	ut_asserteq(before, ht_heap_used());
+	free(env);
+
+	return 0;
+}
+ENV_TEST(env_test_htab_reimport, 0);
+
+/* Setting and deleting many different variables must not use up memory */
+static int env_test_htab_delete(struct unit_test_state *uts)
+{
+	struct hsearch_data htab = { .change_ok = NULL };
+	ENTRY e, *ep;
+	char *env, *res = NULL, name[16];
+	size_t size;
+	int before, used;
+	int i;
+
+	env = ht_make_env(HT_TEST_VARS, &size);
+	ut_assertnonnull(env);
+	before = ht_heap_used();
+
+	ut_asserteq(1, himport_r(&htab, env, HT_TEST_ENV_SIZE, '\0', 0, 0, 0,
+				 NULL));
+	used = ht_heap_used();
+	e.data = "temporary";
+	for (i = 0; i < HT_TEST_DELETES; i++) {
+		sprintf(name, "tmpvar%05d", i);
+		e.key = name;
+		ut_assert(hsearch_r(e, ENTER, &ep, &htab, 0));
+		ut_assert(hdelete_r(name, &htab, 0));
+	}
+
+	/* The keys of deleted variables are reclaimed, not kept */
+	ut_assert(ht_heap_used() - used < 8192);
+	ut_asserteq(HT_TEST_VARS, htab.filled);
+
+	/* The other keys are intact after being moved */
+	ut_assert(hexport_r(&htab, '\0', 0, &res, 0, 0, NULL) >= size);
+	ut_assertok(memcmp(env, res, size));
+	free(res);
+	e.key = "var0399";
+	ut_assert(hsearch_r(e, FIND, &ep, &htab, 0));
+
+	hdestroy_r(&htab);
+	ut_asserteq(before, ht_heap_used());
+	free(env);
+
+	return 0;
+}
+ENV_TEST(env_test_htab_delete, 0);
+
+/* Time importing and exporting a large environment, as boot and saveenv do */
+static int env_test_htab_bench(struct unit_test_state *uts)
+{
+	struct hsearch_data htab = { .change_ok = NULL };
+	ulong us_import = 0, us_export = 0, start;
+	char *env, *res;
+	size_t size;
+	int before, heap = 0;
+	int i;
+
+	env = ht_make_env(HT_TEST_VARS, &size);
+	ut_assertnonnull(env);
+	res = malloc(HT_TEST_ENV_SIZE);
+	ut_assertnonnull(res);
+	before = ht_heap_used();
+
+	for (i = 0; i < HT_BENCH_ROUNDS; i++) {
+		start = timer_get_us();
+		ut_asserteq(1, himport_r(&htab, env, HT_TEST_ENV_SIZE, '\0', 0,
+					 0, 0, NULL));
+		us_import += timer_get_us() - start;
+		heap = ht_heap_used() - before;
+
+		start = timer_get_us();
+		ut_assert(hexport_r(&htab, '\0', 0, &res, HT_TEST_ENV_SIZE, 0,
+				    NULL) > 0);
+		us_export += timer_get_us() - start;
+		hdestroy_r(&htab);
+	}
+	printf("%d variables, %zu bytes: import %lu us, export %lu us, %d bytes of heap\n",
+	       HT_TEST_VARS, size, us_import / HT_BENCH_ROUNDS,
+	       us_export / HT_BENCH_ROUNDS, heap);
+	ut_asserteq(before, ht_heap_used());
+	free(res);
+	free(env);
+
+	return 0;
+}
+ENV_TEST(env_test_htab_bench, 0);
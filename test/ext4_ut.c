@@ -0,0 +1,512 @@
+/*
+ * Tests and throughput benchmark for reading files from ext4, using an
+ * image built in a host file with contiguous, fragmented and sparse files
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <command.h>
+#include <errno.h>
+#include <ext4fs.h>
+#include <fs.h>
+#include <malloc.h>
+#include <mapmem.h>
+#include <os.h>
+#include <part.h>
+#include <sandboxblockdev.h>
+
+#define E4_TEST_DEV		(CONFIG_HOST_MAX_DEVICES - 1)
+#define E4_TEST_BLKSZ		4096
+#define E4_TEST_SECTS		(E4_TEST_BLKSZ / 512)
+#define E4_TEST_BLOCKS		8192		/* 32MiB */
+#define E4_TEST_INODES		64
+#define E4_TEST_INODE_SIZE	256
+#define E4_TEST_ITABLE		4
+#define E4_TEST_ROOT_BLK	8
+#define E4_TEST_META		9	/* Extent tree and indirect blocks */
+#define E4_TEST_DATA		32	/* File data */
+#define E4_TEST_FIRST_INO	12
+#define E4_TEST_ADDR		0x1000000
+#define E4_TEST_LEAF_MAX	((E4_TEST_BLKSZ - 12) / 12)
+
+enum {
+	E4_EXTENTS,
+	E4_SPARSE,	/* A hole and an unwritten extent */
+	E4_INDIRECT,	/* Direct and indirect blocks, no extents */
+};
+
+/*
+ * Files in the image. Extent-mapped files are made of runs of data with a
+ * one-block gap between them. Each run is split into extents of at most
+ * @ext_len blocks, which follow on from one another.
+ */
+struct e4_test_file {
+	const char *name;
+	uint size;
+	int type;
+	int run;		/* Blocks in each run */
+	int ext_len;		/* Most blocks in an extent */
+	int per_leaf;		/* Extents in each leaf */
+	int depth;		/* Depth of the extent tree */
+	int runs;		/* Set up when the image is built */
+	int meta;		/* Likewise, tree or indirect blocks */
+};
+
+static struct e4_test_file e4_test_files[] = {
+	{ "contig.bin", 16 << 20, E4_EXTENTS, 4096, 2048, 0, 0 },
+	{ "frag.bin", (8 << 20) - 123, E4_EXTENTS, 8, 8, 128, 1 },
+	{ "deep.bin", (2 << 20) - 4019, E4_EXTENTS, 16, 16, 11, 2 },
+	{ "sparse.bin", 16 * E4_TEST_BLKSZ - 100, E4_SPARSE },
+	{ "indir.bin", 20 * E4_TEST_BLKSZ - 5, E4_INDIRECT },
+};
+
+/* Device reads of file data and of the blocks which map it */
+static struct {
+	ulong (*block_read)(int dev, lbaint_t start, lbaint_t blkcnt,
+			    void *buffer);
+	int data_reads;
+	int meta_reads;
+} e4_test_io;
+
+static ulong e4_test_block_read(int dev, lbaint_t start, lbaint_t blkcnt,
+				void *buffer)
+{
+	if (start >= E4_TEST_DATA * E4_TEST_SECTS)
+		e4_test_io.data_reads++;
+	else if (start >= E4_TEST_META * E4_TEST_SECTS)
+		e4_test_io.meta_reads++;
+
+	return e4_test_io.block_read(dev, start, blkcnt, buffer);
+}
+
+static u8 e4_test_byte(int seed, uint offset)
+{
+	return offset * 13 + (offset >> 12) + seed * 37 + 1;
+}
+
+/* What a file should read as: the sparse file has zeroes in the middle */
+static u8 e4_test_expect(int idx, uint offset)
+{
+	uint blk = offset / E4_TEST_BLKSZ;
+
+	if (e4_test_files[idx].type == E4_SPARSE && blk >= 4 && blk < 12)
+		return 0;
+
+	return e4_test_byte(idx, offset);
+}
+
+static int e4_test_write(int fd, ulong blk, const void *buf, ulong len)
+{
+	if (os_lseek(fd, blk * E4_TEST_BLKSZ, OS_SEEK_SET) == -1 ||
+	    os_write(fd, buf, len) != len)
+		return -EIO;
+
+	return 0;
+}
+
+/* Write @count blocks of file data, starting at block @fileblk */
+static int e4_test_data(int fd, int idx, ulong blk, uint fileblk, uint count)
+{
+	u8 buf[E4_TEST_BLKSZ];
+	uint i, j;
+
+	for (i = 0; i < count; i++) {
+		for (j = 0; j < E4_TEST_BLKSZ; j++)
+			buf[j] = e4_test_byte(idx,
+					      (fileblk + i) * E4_TEST_BLKSZ + j);
+		if (e4_test_write(fd, blk + i, buf, E4_TEST_BLKSZ))
+			return -EIO;
+	}
+
+	return 0;
+}
+
+static void e4_test_header(void *ptr, int entries, int max, int depth)
+{
+	struct ext4_extent_header *eh = ptr;
+
+	eh->eh_magic = cpu_to_le16(EXT4_EXT_MAGIC);
+	eh->eh_entries = cpu_to_le16(entries);
+	eh->eh_max = cpu_to_le16(max);
+	eh->eh_depth = cpu_to_le16(depth);
+}
+
+static void e4_test_index(struct ext4_extent_idx *idx, uint fileblk,
+			  uint blk)
+{
+	idx->ei_block = cpu_to_le32(fileblk);
+	idx->ei_leaf_lo = cpu_to_le32(blk);
+}
+
+static void e4_test_extent(struct ext4_extent *ext, uint fileblk, uint len,
+			   uint blk)
+{
+	ext->ee_block = cpu_to_le32(fileblk);
+	ext->ee_len = cpu_to_le16(len);
+	ext->ee_start_lo = cpu_to_le32(blk);
+}
+
+/*
+ * Lay out an extent-mapped file: write its data and put its extents into
+ * leaves in @meta, then index them from the inode as the depth requires
+ */
+static int e4_test_extents(int fd, int idx, struct ext2_inode *inode,
+			   u8 *meta, uint *next_meta, uint *next)
+{
+	struct e4_test_file *file = &e4_test_files[idx];
+	uint blocks = DIV_ROUND_UP(file->size, E4_TEST_BLKSZ);
+	struct ext4_extent *exts, *leaf;
+	struct ext4_extent_idx *index;
+	uint fileblk, len, n, nexts = 0;
+	uint leaves, leaf_blk, i;
+	void *root = inode->b.blocks.dir_blocks;
+
+	exts = calloc(blocks, sizeof(*exts));
+	if (!exts)
+		return -ENOMEM;
+	file->runs = 0;
+	for (fileblk = 0; fileblk < blocks; fileblk += len) {
+		len = min(blocks - fileblk, (uint)file->run);
+		if (e4_test_data(fd, idx, *next, fileblk, len))
+			goto err;
+		for (i = 0; i < len; i += n) {
+			n = min(len - i, (uint)file->ext_len);
+			e4_test_extent(&exts[nexts++], fileblk + i, n,
+				       *next + i);
+		}
+		file->runs++;
+		*next += len + 1;
+	}
+
+	inode->flags = cpu_to_le32(EXT4_EXTENTS_FL);
+	file->meta = 0;
+	if (!file->depth) {
+		if (nexts > 4)
+			goto err;
+		e4_test_header(root, nexts, 4, 0);
+		memcpy(root + sizeof(struct ext4_extent_header), exts,
+		       nexts * sizeof(*exts));
+		free(exts);
+		return 0;
+	}
+
+	leaves = DIV_ROUND_UP(nexts, file->per_leaf);
+	leaf_blk = *next_meta;
+	for (i = 0; i < leaves; i++) {
+		leaf = (void *)(meta + (leaf_blk + i) * E4_TEST_BLKSZ);
+		n = min(nexts - i * file->per_leaf, (uint)file->per_leaf);
+		e4_test_header(leaf, n, E4_TEST_LEAF_MAX, 0);
+		memcpy((struct ext4_extent_header *)leaf + 1,
+		       &exts[i * file->per_leaf], n * sizeof(*exts));
+	}
+	*next_meta += leaves;
+	file->meta = leaves;
+
+	/* Depth 2 puts one index block between the inode and the leaves */
+	if (file->depth == 2) {
+		index = (void *)(meta + *next_meta * E4_TEST_BLKSZ);
+		e4_test_header(index, leaves, E4_TEST_LEAF_MAX, 1);
+		for (i = 0; i < leaves; i++)
+			e4_test_index((struct ext4_extent_idx *)
+				      ((struct ext4_extent_header *)index + 1) +
+				      i, le32_to_cpu(exts[i * file->per_leaf].
+						     ee_block), leaf_blk + i);
+		e4_test_header(root, 1, 4, 2);
+		e4_test_index((struct ext4_extent_idx *)
+			      ((struct ext4_extent_header *)root + 1), 0,
+			      (*next_meta)++);
+		file->meta++;
+	} else {
+		if (leaves > 4)
+			goto err;
+		e4_test_header(root, leaves, 4, 1);
+		for (i = 0; i < leaves; i++)
+			e4_test_index((struct ext4_extent_idx *)
+				      ((struct ext4_extent_header *)root + 1) +
+				      i, le32_to_cpu(exts[i * file->per_leaf].
+						     ee_block), leaf_blk + i);
+	}
+	free(exts);
+
+	return 0;
+err:
+	free(exts);
+
+	return -EINVAL;
+}
+
+/*
+ * Blocks 0-3 and 12-15 have data. 4-7 are a hole and 8-11 are an unwritten
+ * extent, whose blocks hold data which must not be seen.
+ */
+static int e4_test_sparse(int fd, int idx, struct ext2_inode *inode,
+			  uint *next)
+{
+	struct e4_test_file *file = &e4_test_files[idx];
+	void *root = inode->b.blocks.dir_blocks;
+	struct ext4_extent *ext = (struct ext4_extent *)
+		((struct ext4_extent_header *)root + 1);
+
+	if (e4_test_data(fd, idx, *next, 0, 4) ||
+	    e4_test_data(fd, idx, *next + 4, 8, 4) ||
+	    e4_test_data(fd, idx, *next + 8, 12, 4))
+		return -EIO;
+	inode->flags = cpu_to_le32(EXT4_EXTENTS_FL);
+	e4_test_header(root, 3, 4, 0);
+	e4_test_extent(&ext[0], 0, 4, *next);
+	e4_test_extent(&ext[1], 8, 4 + EXT4_EXT_INIT_MAX_LEN, *next + 4);
+	e4_test_extent(&ext[2], 12, 4, *next + 8);
+	*next += 13;
+	file->runs = 2;
+	file->meta = 0;
+
+	return 0;
+}
+
+/* Twelve direct blocks and eight through the indirect block, all in a row */
+static int e4_test_indirect(int fd, int idx, struct ext2_inode *inode,
+			    u8 *meta, uint *next_meta, uint *next)
+{
+	struct e4_test_file *file = &e4_test_files[idx];
+	uint blocks = DIV_ROUND_UP(file->size, E4_TEST_BLKSZ);
+	__le32 *indir = (__le32 *)(meta + *next_meta * E4_TEST_BLKSZ);
+	uint i;
+
+	if (e4_test_data(fd, idx, *next, 0, blocks))
+		return -EIO;
+	for (i = 0; i < blocks; i++) {
+		if (i < INDIRECT_BLOCKS)
+			inode->b.blocks.dir_blocks[i] = cpu_to_le32(*next + i);
+		else
+			indir[i - INDIRECT_BLOCKS] = cpu_to_le32(*next + i);
+	}
+	inode->b.blocks.indir_block = cpu_to_le32((*next_meta)++);
+	*next += blocks + 1;
+	file->runs = 1;
+	file->meta = 1;
+
+	return 0;
+}
+
+static void e4_test_dirent(u8 *blk, uint *pos, uint ino, const char *name,
+			   int type, int last)
+{
+	struct ext2_dirent *dirent = (struct ext2_dirent *)(blk + *pos);
+	uint len = ALIGN(sizeof(*dirent) + strlen(name), 4);
+
+	if (last)
+		len = E4_TEST_BLKSZ - *pos;
+	dirent->inode = cpu_to_le32(ino);
+	dirent->direntlen = cpu_to_le16(len);
+	dirent->namelen = strlen(name);
+	dirent->filetype = type;
+	memcpy(dirent + 1, name, strlen(name));
+	*pos += len;
+}
+
+static int e4_test_mkfs(const char *fname)
+{
+	struct ext2_sblock *sb;
+	struct ext2_block_group *bg;
+	struct ext2_inode *inode;
+	uint next = E4_TEST_DATA, next_meta = E4_TEST_META, pos = 0;
+	int fd, i, ret;
+	u8 *meta;
+
+	meta = calloc(E4_TEST_DATA, E4_TEST_BLKSZ);
+	if (!meta)
+		return -ENOMEM;
+	os_unlink(fname);
+	fd = os_open(fname, OS_O_RDWR | OS_O_CREAT);
+	if (fd < 0) {
+		free(meta);
+		return -EIO;
+	}
+
+	sb = (struct ext2_sblock *)(meta + 1024);
+	sb->total_inodes = cpu_to_le32(E4_TEST_INODES);
+	sb->total_blocks = cpu_to_le32(E4_TEST_BLOCKS);
+	sb->log2_block_size = cpu_to_le32(2);
+	sb->log2_fragment_size = cpu_to_le32(2);
+	sb->blocks_per_group = cpu_to_le32(32768);
+	sb->fragments_per_group = cpu_to_le32(32768);
+	sb->inodes_per_group = cpu_to_le32(E4_TEST_INODES);
+	sb->magic = cpu_to_le16(EXT2_MAGIC);
+	sb->fs_state = cpu_to_le16(1);
+	sb->revision_level = cpu_to_le32(1);
+	sb->first_inode = cpu_to_le32(11);
+	sb->inode_size = cpu_to_le16(E4_TEST_INODE_SIZE);
+	sb->feature_incompat = cpu_to_le32(0x2 |
+					   EXT4_FEATURE_INCOMPAT_EXTENTS);
+
+	bg = (struct ext2_block_group *)(meta + E4_TEST_BLKSZ);
+	bg->block_id = cpu_to_le32(2);
+	bg->inode_id = cpu_to_le32(3);
+	bg->inode_table_id = cpu_to_le32(E4_TEST_ITABLE);
+
+	inode = (struct ext2_inode *)(meta + E4_TEST_ITABLE * E4_TEST_BLKSZ +
+				      E4_TEST_INODE_SIZE);
+	inode->mode = cpu_to_le16(0x41ed);
+	inode->size = cpu_to_le32(E4_TEST_BLKSZ);
+	inode->nlinks = cpu_to_le16(2);
+	inode->b.blocks.dir_blocks[0] = cpu_to_le32(E4_TEST_ROOT_BLK);
+
+	e4_test_dirent(meta + E4_TEST_ROOT_BLK * E4_TEST_BLKSZ, &pos, 2, ".",
+		       FILETYPE_DIRECTORY, 0);
+	e4_test_dirent(meta + E4_TEST_ROOT_BLK * E4_TEST_BLKSZ, &pos, 2, "..",
+		       FILETYPE_DIRECTORY, 0);
+	for (i = 0; i < ARRAY_SIZE(e4_test_files); i++) {
+		inode = (struct ext2_inode *)(meta + E4_TEST_ITABLE *
+			E4_TEST_BLKSZ + (E4_TEST_FIRST_INO + i - 1) *
+			E4_TEST_INODE_SIZE);
+		inode->mode = cpu_to_le16(0x81a4);
+		inode->size = cpu_to_le32(e4_test_files[i].size);
+		inode->nlinks = cpu_to_le16(1);
+		switch (e4_test_files[i].type) {
+		case E4_EXTENTS:
+			ret = e4_test_extents(fd, i, inode, meta, &next_meta,
+					      &next);
+			break;
+		case E4_SPARSE:
+			ret = e4_test_sparse(fd, i, inode, &next);
+			break;
+		default:
+			ret = e4_test_indirect(fd, i, inode, meta, &next_meta,
+					       &next);
+			break;
+		}
+		if (ret || next_meta > E4_TEST_DATA || next > E4_TEST_BLOCKS)
+			goto err;
+		e4_test_dirent(meta + E4_TEST_ROOT_BLK * E4_TEST_BLKSZ, &pos,
+			       E4_TEST_FIRST_INO + i, e4_test_files[i].name,
+			       FILETYPE_REG, i == ARRAY_SIZE(e4_test_files) - 1);
+	}
+
+	/* The metadata, and the last block so the disk has its full size */
+	ret = -EIO;
+	if (e4_test_write(fd, 0, meta, E4_TEST_DATA * E4_TEST_BLKSZ))
+		goto err;
+	memset(meta, '\0', E4_TEST_BLKSZ);
+	if (e4_test_write(fd, E4_TEST_BLOCKS - 1, meta, E4_TEST_BLKSZ))
+		goto err;
+	ret = 0;
+err:
+	os_close(fd);
+	free(meta);
+
+	return ret ? -EINVAL : 0;
+}
+
+/* Read @len bytes of a file (0 for all of it) and check them */
+static int e4_test_read(int idx, uint len, ulong *us)
+{
+	struct e4_test_file *file = &e4_test_files[idx];
+	uint expect = len ? min(len, file->size) : file->size;
+	char dev[4];
+	loff_t actread;
+	ulong start;
+	u8 *buf;
+	uint i;
+
+	snprintf(dev, sizeof(dev), "%d", E4_TEST_DEV);
+	if (fs_set_blk_dev("host", dev, FS_TYPE_EXT))
+		return -ENODEV;
+	e4_test_io.data_reads = 0;
+	e4_test_io.meta_reads = 0;
+	start = timer_get_us();
+	if (fs_read(file->name, E4_TEST_ADDR, 0, len, &actread)) {
+		printf("%s: cannot read %s\n", __func__, file->name);
+		return -EIO;
+	}
+	*us = timer_get_us() - start;
+	if (actread != expect) {
+		printf("%s: %s: expected %u bytes, got %llu\n", __func__,
+		       file->name, expect, actread);
+		return -EINVAL;
+	}
+
+	buf = map_sysmem(E4_TEST_ADDR, expect);
+	for (i = 0; i < expect; i++) {
+		if (buf[i] != e4_test_expect(idx, i)) {
+			printf("%s: %s: bad data at %u\n", __func__,
+			       file->name, i);
+			return -EBADMSG;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Read each file, checking that each run of blocks takes one device read
+ * (plus one for a partial sector at the end), and that the extent tree or
+ * indirect blocks are read only once
+ */
+static int e4_test_files_read(void)
+{
+	struct e4_test_file *file;
+	int i, ret, reads;
+	ulong us;
+
+	for (i = 0; i < ARRAY_SIZE(e4_test_files); i++) {
+		file = &e4_test_files[i];
+		ret = e4_test_read(i, 0, &us);
+		if (ret)
+			return ret;
+		reads = file->runs + !!(file->size % 512);
+		if (e4_test_io.data_reads != reads ||
+		    e4_test_io.meta_reads != file->meta) {
+			printf("%s: %s: %d + %d reads, expected %d + %d\n",
+			       __func__, file->name, e4_test_io.data_reads,
+			       e4_test_io.meta_reads, reads, file->meta);
+			return -EINVAL;
+		}
+		printf("%10s %8u bytes %4d runs %4d reads %6lu us %6lu MB/s\n",
+		       file->name, file->size, file->runs,
+		       e4_test_io.data_reads + e4_test_io.meta_reads, us,
+		       file->size / max(us, 1UL));
+	}
+
+	/* Reads which stop part-way into a block or extent */
+	ret = e4_test_read(1, 10000, &us);
+	if (!ret)
+		ret = e4_test_read(2, 16 * E4_TEST_BLKSZ + 1, &us);
+	if (!ret)
+		ret = e4_test_read(3, 6 * E4_TEST_BLKSZ, &us);
+
+	return ret;
+}
+
+int do_ut_ext4(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
+{
+	const char *fname = argc > 1 ? argv[1] : "ext4_ut.img";
+	block_dev_desc_t *dev_desc;
+	int ret;
+
+	ret = e4_test_mkfs(fname);
+	if (ret) {
+		printf("Cannot create ext4 image %s\n", fname);
+		goto err;
+	}
+	ret = -ENODEV;
+	if (host_dev_bind(E4_TEST_DEV, (char *)fname))
+		goto err_unlink;
+	dev_desc = host_get_dev(E4_TEST_DEV);
+	if (!dev_desc)
+		goto err_unbind;
+	e4_test_io.block_read = dev_desc->block_read;
+	dev_desc->block_read = e4_test_block_read;
+
+	ret = e4_test_files_read();
+
+	dev_desc->block_read = e4_test_io.block_read;
+err_unbind:
+	host_dev_bind(E4_TEST_DEV, NULL);
+err_unlink:
+	os_unlink(fname);
+err:
+	printf("Test %s\n", ret ? "failed" : "passed");
+
+	return ret ? CMD_RET_FAILURE : CMD_RET_SUCCESS;
+}
@@ -0,0 +1,509 @@
+/*
+ * Tests and throughput benchmark for reading files from FAT, using a FAT32
+ * image built in a host file
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <command.h>
+#include <errno.h>
+#include <fat.h>
+#include <malloc.h>
+#include <os.h>
+#include <part.h>
+#include <sandboxblockdev.h>
+
+#define FAT_TEST_DEV		(CONFIG_HOST_MAX_DEVICES - 1)
+#define FAT_TEST_SECT_SIZE	512
+#define FAT_TEST_CLUST_SECTS	8
+#define FAT_TEST_CLUST_SIZE	(FAT_TEST_SECT_SIZE * FAT_TEST_CLUST_SECTS)
+#define FAT_TEST_RESERVED	32
+#define FAT_TEST_SECTS		(64 << 11)	/* 64MiB */
+#define FAT_TEST_FAT_SECTS	(FAT_TEST_SECTS / FAT_TEST_CLUST_SECTS * 4 / \
+				 FAT_TEST_SECT_SIZE)
+#define FAT_TEST_DATA_SECT	(FAT_TEST_RESERVED + 2 * FAT_TEST_FAT_SECTS)
+#define FAT_TEST_END_CLUST	((FAT_TEST_SECTS - FAT_TEST_DATA_SECT) / \
+				 FAT_TEST_CLUST_SECTS + 2)
+#define FAT_TEST_ROOT_CLUST	2
+#define FAT_TEST_CHUNK		256	/* Clusters written at a time */
+#define FAT_TEST_ITER		10
+
+/*
+ * Files in the image. One is contiguous and the fragmented ones are laid
+ * out in turn, a run of clusters each, so that their chains interleave.
+ */
+struct fat_test_file {
+	const char *name;	/* 8.3 name as it appears in the directory */
+	uint size;
+	int frag;		/* Clusters in each run, 0 for contiguous */
+	__u32 start;		/* Set up when the image is built */
+	int runs;		/* Likewise */
+};
+
+static struct fat_test_file fat_test_files[] = {
+	{ "CONTIG  BIN", 16 << 20, 0 },
+	{ "FRAG0   BIN", (4 << 20) + 1000, 16 },
+	{ "FRAG1   BIN", (4 << 20) + 3000, 24 },
+	{ "FRAG2   BIN", 4 << 20, 32 },
+	{ "FRAG3   BIN", 5000, 1 },
+	{ "SMALL   TXT", 100, 0 },
+};
+
+/* Block reads seen by the filesystem, and how many of them were of the FAT */
+static struct {
+	ulong (*block_read)(int dev, lbaint_t start, lbaint_t blkcnt,
+			    void *buffer);
+	int reads;
+	int fat_reads;
+} fat_test_io;
+
+static ulong fat_test_block_read(int dev, lbaint_t start, lbaint_t blkcnt,
+				 void *buffer)
+{
+	fat_test_io.reads++;
+	if (start < FAT_TEST_DATA_SECT && start + blkcnt > FAT_TEST_RESERVED)
+		fat_test_io.fat_reads++;
+
+	return fat_test_io.block_read(dev, start, blkcnt, buffer);
+}
+
+static u8 fat_test_byte(int seed, uint offset)
+{
+	return offset * 7 + (offset >> 12) + seed * 31;
+}
+
+static void fat_test_fill(u8 *buf, int seed, uint offset, uint len)
+{
+	uint i;
+
+	for (i = 0; i < len; i++)
+		buf[i] = fat_test_byte(seed, offset + i);
+}
+
+static int fat_test_write(int fd, ulong sect, const void *buf, ulong len)
+{
+	if (os_lseek(fd, sect * FAT_TEST_SECT_SIZE, OS_SEEK_SET) == -1 ||
+	    os_write(fd, buf, len) != len)
+		return -EIO;
+
+	return 0;
+}
+
+static void fat_test_dirent(dir_entry *dent, struct fat_test_file *file)
+{
+	memcpy(dent->name, file->name, 11);
+	dent->attr = ATTR_ARCH;
+	dent->start = cpu_to_le16(file->start & 0xffff);
+	dent->starthi = cpu_to_le16(file->start >> 16);
+	dent->time = cpu_to_le16(0x6000);
+	dent->date = cpu_to_le16(0x4721);
+	dent->size = cpu_to_le32(file->size);
+}
+
+static void fat_test_bootsect(u8 *sect)
+{
+	boot_sector *bs = (boot_sector *)sect;
+	volume_info *vi = (volume_info *)(sect + sizeof(*bs));
+
+	memcpy(bs->ignored, "\xeb\x58\x90", 3);
+	memcpy(bs->system_id, "U-BOOT  ", 8);
+	bs->sector_size[0] = FAT_TEST_SECT_SIZE & 0xff;
+	bs->sector_size[1] = FAT_TEST_SECT_SIZE >> 8;
+	bs->cluster_size = FAT_TEST_CLUST_SECTS;
+	bs->reserved = cpu_to_le16(FAT_TEST_RESERVED);
+	bs->fats = 2;
+	bs->media = 0xf8;
+	bs->total_sect = cpu_to_le32(FAT_TEST_SECTS);
+	bs->fat32_length = cpu_to_le32(FAT_TEST_FAT_SECTS);
+	bs->root_cluster = cpu_to_le32(FAT_TEST_ROOT_CLUST);
+	bs->info_sector = cpu_to_le16(1);
+	bs->backup_boot = cpu_to_le16(6);
+	vi->ext_boot_sign = 0x29;
+	memcpy(vi->volume_id, "\x12\x34\x56\x78", 4);
+	memcpy(vi->volume_label, "FAT_UT     ", 11);
+	memcpy(vi->fs_type, FAT32_SIGN, 8);
+	sect[FAT_TEST_SECT_SIZE - 2] = 0x55;
+	sect[FAT_TEST_SECT_SIZE - 1] = 0xaa;
+}
+
+/* Build the image, writing each run of each file as it is allocated */
+static int fat_test_mkfs(const char *fname)
+{
+	int left[ARRAY_SIZE(fat_test_files)];
+	struct fat_test_file *file;
+	__u32 *fat, next = FAT_TEST_ROOT_CLUST + 1, prev[ARRAY_SIZE(left)];
+	uint written[ARRAY_SIZE(left)];
+	u8 *buf;
+	int fd, ret = -ENOMEM;
+	int busy, i, n, c, part;
+
+	fat = calloc(FAT_TEST_FAT_SECTS, FAT_TEST_SECT_SIZE);
+	buf = malloc(FAT_TEST_CHUNK * FAT_TEST_CLUST_SIZE);
+	if (!fat || !buf)
+		goto err_free;
+	os_unlink(fname);
+	fd = os_open(fname, OS_O_RDWR | OS_O_CREAT);
+	ret = -EIO;
+	if (fd < 0)
+		goto err_free;
+
+	fat[0] = cpu_to_le32(0x0ffffff8);
+	fat[1] = cpu_to_le32(0x0fffffff);
+	fat[FAT_TEST_ROOT_CLUST] = cpu_to_le32(0x0fffffff);
+	for (i = 0; i < ARRAY_SIZE(fat_test_files); i++) {
+		file = &fat_test_files[i];
+		left[i] = DIV_ROUND_UP(file->size, FAT_TEST_CLUST_SIZE);
+		written[i] = 0;
+		file->start = 0;
+		file->runs = 0;
+	}
+
+	do {
+		busy = 0;
+		for (i = 0; i < ARRAY_SIZE(fat_test_files); i++) {
+			file = &fat_test_files[i];
+			n = file->frag ? min(left[i], file->frag) : left[i];
+			if (!n)
+				continue;
+			busy = 1;
+			if (next + n > FAT_TEST_END_CLUST)
+				goto err;
+			/* Runs only count if they do not follow on */
+			if (!file->start || prev[i] + 1 != next)
+				file->runs++;
+			if (!file->start)
+				file->start = next;
+			else
+				fat[prev[i]] = cpu_to_le32(next);
+			for (c = 0; c < n - 1; c++)
+				fat[next + c] = cpu_to_le32(next + c + 1);
+			prev[i] = next + n - 1;
+			left[i] -= n;
+			fat[prev[i]] = cpu_to_le32(left[i] ? 0 : 0x0fffffff);
+
+			for (; n; n -= part, next += part) {
+				part = min(n, FAT_TEST_CHUNK);
+				fat_test_fill(buf, i, written[i],
+					      part * FAT_TEST_CLUST_SIZE);
+				if (fat_test_write(fd, FAT_TEST_DATA_SECT +
+						   (next - 2) *
+						   FAT_TEST_CLUST_SECTS, buf,
+						   part * FAT_TEST_CLUST_SIZE))
+					goto err;
+				written[i] += part * FAT_TEST_CLUST_SIZE;
+			}
+		}
+	} while (busy);
+
+	/* The root directory and the end of the disk, so it has a size */
+	memset(buf, '\0', FAT_TEST_CLUST_SIZE);
+	for (i = 0; i < ARRAY_SIZE(fat_test_files); i++)
+		fat_test_dirent((dir_entry *)buf + i, &fat_test_files[i]);
+	if (fat_test_write(fd, FAT_TEST_DATA_SECT, buf, FAT_TEST_CLUST_SIZE))
+		goto err;
+	memset(buf, '\0', FAT_TEST_SECT_SIZE);
+	if (fat_test_write(fd, FAT_TEST_SECTS - 1, buf, FAT_TEST_SECT_SIZE))
+		goto err;
+
+	for (i = 0; i < 2; i++) {
+		if (fat_test_write(fd, FAT_TEST_RESERVED +
+				   i * FAT_TEST_FAT_SECTS, fat,
+				   FAT_TEST_FAT_SECTS * FAT_TEST_SECT_SIZE))
+			goto err;
+	}
+	fat_test_bootsect(buf);
+	if (fat_test_write(fd, 0, buf, FAT_TEST_SECT_SIZE))
+		goto err;
+	ret = 0;
+err:
+	os_close(fd);
+err_free:
+	free(fat);
+	free(buf);
+
+	return ret;
+}
+
+/* Name of a test file as it would be typed */
+static void fat_test_name(struct fat_test_file *file, char *name)
+{
+	char *p = name;
+	int i;
+
+	for (i = 0; i < 8 && file->name[i] != ' '; i++)
+		*p++ = file->name[i];
+	*p++ = '.';
+	memcpy(p, file->name + 8, 3);
+	p[3] = '\0';
+}
+
+/* Read part of a file and check what comes back */
+static int fat_test_read(int idx, u8 *buf, uint pos, uint len)
+{
+	struct fat_test_file *file = &fat_test_files[idx];
+	uint expect = min(file->size - pos, len ? len : file->size);
+	char name[13];
+	loff_t actread;
+	uint i;
+
+	fat_test_name(file, name);
+	if (do_fat_read_at(name, pos, buf, len, LS_NO, 0, &actread)) {
+		printf("%s: cannot read %s\n", __func__, name);
+		return -EIO;
+	}
+	if (actread != expect) {
+		printf("%s: %s at %u: expected %u bytes, got %llu\n", __func__,
+		       name, pos, expect, actread);
+		return -EINVAL;
+	}
+	for (i = 0; i < expect; i++) {
+		if (buf[i] != fat_test_byte(idx, pos + i)) {
+			printf("%s: %s: bad data at %u\n", __func__, name,
+			       pos + i);
+			return -EBADMSG;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Read every file, checking that the data is right and that each run of
+ * clusters takes one read. @cached says whether the chains should already
+ * be known, in which case the FAT must not be read at all.
+ */
+static int fat_test_files_read(u8 *buf, int cached)
+{
+	struct fat_test_file *file;
+	int i, ret, reads, fat_read;
+
+	for (i = 0; i < ARRAY_SIZE(fat_test_files); i++) {
+		file = &fat_test_files[i];
+		/* There are more files than the cache holds, so warm it up */
+		if (cached) {
+			ret = fat_test_read(i, buf, 0, 0);
+			if (ret)
+				return ret;
+		}
+		fat_test_io.reads = 0;
+		fat_test_io.fat_reads = 0;
+		ret = fat_test_read(i, buf, 0, 0);
+		if (ret)
+			return ret;
+		/* The boot sector and the root directory, then the data */
+		reads = fat_test_io.reads - fat_test_io.fat_reads - 2;
+		/* A partial sector at the end is read separately */
+		if (file->size % FAT_TEST_SECT_SIZE)
+			reads--;
+		if (reads != file->runs) {
+			printf("%s: %s: %d runs took %d reads\n", __func__,
+			       file->name, file->runs, reads);
+			return -EINVAL;
+		}
+		/* A file in one cluster has no chain to follow */
+		fat_read = !cached && file->size > FAT_TEST_CLUST_SIZE;
+		if (!!fat_test_io.fat_reads != fat_read) {
+			printf("%s: %s: FAT was %sread\n", __func__, file->name,
+			       fat_read ? "not " : "");
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+/* Reads which start part-way into a cluster, or end in one */
+static int fat_test_offsets(u8 *buf)
+{
+	static const struct {
+		int idx;
+		uint pos;
+		uint len;
+	} reads[] = {
+		{ 1, 1, 10 },
+		{ 1, 100, FAT_TEST_CLUST_SIZE },
+		{ 1, 16 * FAT_TEST_CLUST_SIZE - 1, 2 },
+		{ 1, 16 * FAT_TEST_CLUST_SIZE, 100000 },
+		{ 2, 24 * FAT_TEST_CLUST_SIZE * 5 + 17, 0 },
+		{ 2, (4 << 20) + 2999, 100 },
+		{ 4, 4097, 0 },
+		{ 5, 99, 0 },
+		{ 0, (16 << 20) - 513, 0 },
+	};
+	int i, ret;
+
+	for (i = 0; i < ARRAY_SIZE(reads); i++) {
+		ret = fat_test_read(reads[i].idx, buf, reads[i].pos,
+				    reads[i].len);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/* Sector of the first FAT which holds the entry for @clust */
+#define FAT_TEST_FATENT_SECT(clust) \
+	(FAT_TEST_RESERVED + (clust) * 4 / FAT_TEST_SECT_SIZE)
+#define FAT_TEST_CLUST_SECT(clust) \
+	(FAT_TEST_DATA_SECT + ((clust) - 2) * FAT_TEST_CLUST_SECTS)
+
+/* Get the FAT entry for @clust and, if @next is not 0, change it in both */
+static int fat_test_fatent(block_dev_desc_t *dev_desc, __u32 clust,
+			   __u32 next, __u32 *valp)
+{
+	__u32 sect[FAT_TEST_SECT_SIZE / 4];
+	ulong blk = FAT_TEST_FATENT_SECT(clust);
+	uint idx = clust % ARRAY_SIZE(sect);
+
+	if (dev_desc->block_read(dev_desc->dev, blk, 1, sect) != 1)
+		return -EIO;
+	if (valp)
+		*valp = le32_to_cpu(sect[idx]);
+	if (!next)
+		return 0;
+	sect[idx] = cpu_to_le32(next);
+	if (dev_desc->block_write(dev_desc->dev, blk, 1, sect) != 1 ||
+	    dev_desc->block_write(dev_desc->dev, blk + FAT_TEST_FAT_SECTS, 1,
+				  sect) != 1)
+		return -EIO;
+
+	return 0;
+}
+
+/*
+ * Re-flash part of the image with raw block writes, as 'mmc write' would,
+ * between two reads of a file. The second and third runs of FRAG0 swap
+ * places on the disk and in its chain, so the file reads the same but with
+ * the old chain it would not. The volume and directory entry are unchanged.
+ */
+static int fat_test_rewrite(block_dev_desc_t *dev_desc, u8 *buf)
+{
+	const int idx = 1, frag = 16;
+	uint run_sects = frag * FAT_TEST_CLUST_SECTS;
+	uint run_size = frag * FAT_TEST_CLUST_SIZE;
+	__u32 run[4];
+	int i, ret;
+
+	ret = fat_test_read(idx, buf, 0, 0);
+	if (ret)
+		return ret;
+
+	/* Find where the first runs are */
+	run[0] = fat_test_files[idx].start;
+	for (i = 1; i < ARRAY_SIZE(run); i++) {
+		ret = fat_test_fatent(dev_desc, run[i - 1] + frag - 1, 0,
+				      &run[i]);
+		if (ret)
+			return ret;
+	}
+
+	/* Swap the data of runs 1 and 2, then link them the other way */
+	if (dev_desc->block_read(dev_desc->dev, FAT_TEST_CLUST_SECT(run[1]),
+				 run_sects, buf) != run_sects ||
+	    dev_desc->block_read(dev_desc->dev, FAT_TEST_CLUST_SECT(run[2]),
+				 run_sects, buf + run_size) != run_sects ||
+	    dev_desc->block_write(dev_desc->dev, FAT_TEST_CLUST_SECT(run[1]),
+				  run_sects, buf + run_size) != run_sects ||
+	    dev_desc->block_write(dev_desc->dev, FAT_TEST_CLUST_SECT(run[2]),
+				  run_sects, buf) != run_sects)
+		return -EIO;
+	if (fat_test_fatent(dev_desc, run[0] + frag - 1, run[2], NULL) ||
+	    fat_test_fatent(dev_desc, run[2] + frag - 1, run[1], NULL) ||
+	    fat_test_fatent(dev_desc, run[1] + frag - 1, run[3], NULL))
+		return -EIO;
+
+	/* The chain must be walked again */
+	fat_test_io.fat_reads = 0;
+	ret = fat_test_read(idx, buf, 0, 0);
+	if (ret)
+		return ret;
+	if (!fat_test_io.fat_reads) {
+		printf("%s: FAT was not read after a raw write\n", __func__);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int fat_test_bench(const char *mode, u8 *buf, int cached)
+{
+	ulong start, us;
+	u64 bytes = 0;
+	int files = 0;
+	loff_t actread;
+	char name[13];
+	int iter, i;
+
+	start = timer_get_us();
+	for (iter = 0; iter < FAT_TEST_ITER; iter++) {
+		for (i = 0; i < ARRAY_SIZE(fat_test_files); i++) {
+			if (!cached)
+				fat_extent_flush();
+			fat_test_name(&fat_test_files[i], name);
+			if (do_fat_read_at(name, 0, buf, 0, LS_NO, 0, &actread))
+				return -EIO;
+			bytes += actread;
+			files++;
+		}
+	}
+	us = max(timer_get_us() - start, 1UL);
+	printf("%8s %6d files %8lu us %8lu files/s %6lu MB/s\n", mode, files,
+	       us, (ulong)((u64)files * 1000000 / us),
+	       (ulong)(bytes / us));
+
+	return 0;
+}
+
+int do_ut_fat(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
+{
+	const char *fname = argc > 1 ? argv[1] : "fat_ut.img";
+	block_dev_desc_t *dev_desc;
+	u8 *buf;
+	int ret;
+
+	buf = memalign(ARCH_DMA_MINALIGN, 16 << 20);
+	if (!buf)
+		return CMD_RET_FAILURE;
+	ret = fat_test_mkfs(fname);
+	if (ret) {
+		printf("Cannot create FAT image %s\n", fname);
+		goto err;
+	}
+	ret = -ENODEV;
+	if (host_dev_bind(FAT_TEST_DEV, (char *)fname))
+		goto err_unlink;
+	dev_desc = host_get_dev(FAT_TEST_DEV);
+	if (!dev_desc || fat_register_device(dev_desc, 0))
+		goto err_unbind;
+	fat_test_io.block_read = dev_desc->block_read;
+	dev_desc->block_read = fat_test_block_read;
+
+	/* The first read walks the FAT, after that it is not needed */
+	fat_extent_flush();
+	ret = fat_test_files_read(buf, 0);
+	if (!ret)
+		ret = fat_test_files_read(buf, 1);
+	if (!ret)
+		ret = fat_test_offsets(buf);
+	if (!ret)
+		ret = fat_test_rewrite(dev_desc, buf);
+	if (!ret)
+		ret = fat_test_bench("uncached", buf, 0);
+	if (!ret)
+		ret = fat_test_bench("cached", buf, 1);
+
+	dev_desc->block_read = fat_test_io.block_read;
+	fat_extent_flush();
+err_unbind:
+	host_dev_bind(FAT_TEST_DEV, NULL);
+err_unlink:
+	os_unlink(fname);
+err:
+	free(buf);
+
+	printf("Test %s\n", ret ? "failed" : "passed");
+
+	return ret ? CMD_RET_FAILURE : CMD_RET_SUCCESS;
+}
@@ -0,0 +1,269 @@
+/*
+ * Tests and benchmark for the index of the control FDT, comparing lookups
+ * through the index with the same lookups on an unindexed copy of the tree
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <command.h>
+#include <errno.h>
+#include <fdtdec.h>
+#include <libfdt.h>
+#include <malloc.h>
+#include <linux/err.h>
+
+DECLARE_GLOBAL_DATA_PTR;
+
+#define FT_NODES	2000
+#define FT_ALIASES	(FT_NODES / 4)
+#define FT_SIZE		(512 << 10)
+#define FT_COMPATS	8	/* Compatible IDs given out to the nodes */
+
+/* Compatible ID of node @i, avoiding COMPAT_UNKNOWN */
+static enum fdt_compat_id ft_compat_id(int i)
+{
+	return COMPAT_UNKNOWN + 1 + i % FT_COMPATS;
+}
+
+/* Phandles are given out backwards, so they are not in tree order */
+static uint32_t ft_phandle(int i)
+{
+	return FT_NODES - i;
+}
+
+/*
+ * Build a tree with FT_NODES nodes under the root, each with two
+ * compatible strings, a phandle and a "link" to the next node. Every
+ * fourth node, from the end, has a "serial" alias, and one alias names a
+ * node which does not exist.
+ */
+static int ft_make(void *fdt, int size)
+{
+	char name[32], value[64];
+	int ret, len, i;
+
+	ret = fdt_create(fdt, size);
+	ret |= fdt_finish_reservemap(fdt);
+	ret |= fdt_begin_node(fdt, "");
+	ret |= fdt_begin_node(fdt, "aliases");
+	for (i = 0; i < FT_ALIASES; i++) {
+		snprintf(name, sizeof(name), "serial%d", i);
+		snprintf(value, sizeof(value), "/dev%d", FT_NODES - 1 - i * 4);
+		ret |= fdt_property_string(fdt, name, value);
+	}
+	ret |= fdt_property_string(fdt, "serial9999", "/missing");
+	ret |= fdt_end_node(fdt);
+
+	for (i = 0; i < FT_NODES; i++) {
+		snprintf(name, sizeof(name), "dev%d", i);
+		ret |= fdt_begin_node(fdt, name);
+		len = snprintf(value, sizeof(value), "test,dev%d", i % 13) + 1;
+		strcpy(value + len, fdtdec_get_compatible(ft_compat_id(i)));
+		len += strlen(value + len) + 1;
+		ret |= fdt_property(fdt, "compatible", value, len);
+		ret |= fdt_property_cell(fdt, "phandle", ft_phandle(i));
+		ret |= fdt_property_cell(fdt, "link",
+					 ft_phandle((i + 1) % FT_NODES));
+		ret |= fdt_end_node(fdt);
+	}
+	ret |= fdt_end_node(fdt);
+	ret |= fdt_finish(fdt);
+
+	/* Leave room to add to the tree */
+	ret |= fdt_open_into(fdt, fdt, size);
+
+	return ret ? -EINVAL : 0;
+}
+
+/* The lookups which the index speeds up, run over the whole tree */
+static int ft_links(const void *blob, int *out)
+{
+	int node, n = 0;
+
+	for (node = fdt_first_subnode(blob, 0); node >= 0;
+	     node = fdt_next_subnode(blob, node))
+		out[n++] = fdtdec_lookup_phandle(blob, node, "link");
+
+	return n;
+}
+
+static int ft_compats(const void *blob, int *out)
+{
+	enum fdt_compat_id id;
+	int node, n = 0;
+	int i;
+
+	for (i = 0; i < FT_COMPATS; i++) {
+		id = ft_compat_id(i);
+		for (node = fdtdec_next_compatible(blob, 0, id); node >= 0;
+		     node = fdtdec_next_compatible(blob, node, id))
+			out[n++] = node;
+	}
+
+	return n;
+}
+
+static int ft_alias_seqs(const void *blob, int *out)
+{
+	int node, n = 0;
+
+	for (node = fdt_first_subnode(blob, 0); node >= 0;
+	     node = fdt_next_subnode(blob, node)) {
+		if (fdtdec_get_alias_seq(blob, "serial", node, &out[n]))
+			out[n] = -1;
+		n++;
+	}
+
+	return n;
+}
+
+static int ft_aliases_for_id(const void *blob, int *out)
+{
+	return fdtdec_find_aliases_for_id(blob, "serial", ft_compat_id(3),
+					  out, FT_NODES);
+}
+
+static struct ft_lookup {
+	const char *name;
+	int (*run)(const void *blob, int *out);
+} ft_lookups[] = {
+	{ "phandle", ft_links },
+	{ "compatible", ft_compats },
+	{ "alias seq", ft_alias_seqs },
+	{ "aliases for id", ft_aliases_for_id },
+};
+
+/*
+ * Run each lookup on the control FDT, which is indexed, and on @plain,
+ * which is not, and check the results are the same
+ */
+static int ft_compare(const void *plain, int *a, int *b, bool show)
+{
+	struct ft_lookup *lookup;
+	ulong start, idx_us, plain_us;
+	int count, i;
+
+	for (lookup = ft_lookups; lookup < ft_lookups + ARRAY_SIZE(ft_lookups);
+	     lookup++) {
+		start = timer_get_us();
+		count = lookup->run(gd->fdt_blob, a);
+		idx_us = timer_get_us() - start;
+		if (!gd->fdt_index || IS_ERR(gd->fdt_index)) {
+			printf("%s: %s: control FDT was not indexed\n",
+			       __func__, lookup->name);
+			return -EINVAL;
+		}
+		start = timer_get_us();
+		if (lookup->run(plain, b) != count) {
+			printf("%s: %s: counts differ\n", __func__,
+			       lookup->name);
+			return -EINVAL;
+		}
+		plain_us = timer_get_us() - start;
+		for (i = 0; i < count; i++) {
+			if (a[i] != b[i]) {
+				printf("%s: %s: result %d is %d, expected %d\n",
+				       __func__, lookup->name, i, a[i], b[i]);
+				return -EINVAL;
+			}
+		}
+		if (show)
+			printf("%15s %5d results %8lu us, indexed %6lu us\n",
+			       lookup->name, count, plain_us, idx_us);
+	}
+
+	return 0;
+}
+
+/* Make the same change to both trees */
+static int ft_add_node(void *blob, void *plain)
+{
+	static const char compat[] = "test,added";
+	void *fdt[] = { blob, plain };
+	int i;
+	int node;
+
+	for (i = 0; i < ARRAY_SIZE(fdt); i++) {
+		node = fdt_add_subnode(fdt[i], 0, "added");
+		if (node < 0 ||
+		    fdt_setprop(fdt[i], node, "compatible", compat,
+				sizeof(compat)) ||
+		    fdt_setprop_u32(fdt[i], node, "phandle", FT_NODES + 1) ||
+		    fdt_setprop_u32(fdt[i], 0, "link", FT_NODES + 1))
+			return -EINVAL;
+	}
+
+	return fdt_path_offset(blob, "/added");
+}
+
+static int ft_test(void *blob, void *plain, int *a, int *b)
+{
+	ulong start;
+	int node;
+
+	if (ft_make(blob, FT_SIZE))
+		return -EINVAL;
+	memcpy(plain, blob, FT_SIZE);
+
+	/* The first lookup builds the index */
+	gd->fdt_blob = blob;
+	fdtdec_index_invalidate();
+	start = timer_get_us();
+	fdtdec_next_compatible(blob, 0, ft_compat_id(0));
+	printf("Index of %d nodes built in %lu us\n", FT_NODES,
+	       timer_get_us() - start);
+	if (ft_compare(plain, a, b, true))
+		return -EINVAL;
+
+	/* Adding nodes and properties is noticed without invalidating */
+	node = ft_add_node(blob, plain);
+	if (node < 0 || ft_compare(plain, a, b, false))
+		return -EINVAL;
+	if (fdtdec_lookup_phandle(blob, 0, "link") != node) {
+		printf("%s: new node not found by phandle\n", __func__);
+		return -EINVAL;
+	}
+
+	/* Changing a property in place needs the index to be invalidated */
+	node = fdt_path_offset(blob, "/dev0");
+	if (fdt_setprop_inplace_u32(blob, node, "phandle", FT_NODES + 2) ||
+	    fdt_setprop_inplace_u32(plain, node, "phandle", FT_NODES + 2))
+		return -EINVAL;
+	fdtdec_index_invalidate();
+	if (ft_compare(plain, a, b, false))
+		return -EINVAL;
+	if (fdtdec_lookup_phandle(blob, fdt_path_offset(blob, "/dev1999"),
+				  "link") != -FDT_ERR_NOTFOUND) {
+		printf("%s: old phandle still found\n", __func__);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int do_ut_fdtdec(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
+{
+	const void *old_blob = gd->fdt_blob;
+	void *blob, *plain;
+	int *a, *b;
+	int ret = -ENOMEM;
+
+	blob = malloc(FT_SIZE);
+	plain = malloc(FT_SIZE);
+	a = malloc(FT_NODES * 2 * sizeof(int));
+	b = malloc(FT_NODES * 2 * sizeof(int));
+	if (blob && plain && a && b)
+		ret = ft_test(blob, plain, a, b);
+
+	gd->fdt_blob = old_blob;
+	fdtdec_index_invalidate();
+	free(b);
+	free(a);
+	free(plain);
+	free(blob);
+
+	printf("Test %s\n", ret ? "failed" : "passed");
+
+	return ret ? CMD_RET_FAILURE : CMD_RET_SUCCESS;
+}
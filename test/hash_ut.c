@@ -0,0 +1,158 @@
+/*
+ * Tests and throughput benchmark for the hash algorithms
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <command.h>
+#include <errno.h>
+#include <hash.h>
+#include <malloc.h>
+
+DECLARE_GLOBAL_DATA_PTR;
+
+#define HASH_BENCH_SIZE		(1 << 20)
+#define HASH_BENCH_MIN_TOTAL	(16 << 20)
+
+struct hash_test_vector {
+	const char *algo_name;
+	const char *input;
+	const char *digest;
+};
+
+static const struct hash_test_vector hash_vectors[] = {
+	/* FIPS 180-2 appendix B */
+	{ "sha1", "abc", "a9993e364706816aba3e25717850c26c9cd0d89d" },
+	{ "sha1", "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+		"84983e441c3bd26ebaae4aa1f95129e5e54670f1" },
+	{ "sha256", "abc",
+		"ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" },
+	{ "sha256", "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+		"248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" },
+	{ "sha256", "",
+		"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" },
+	{ "crc32", "123456789", "cbf43926" },
+};
+
+static int test_hash_vectors(void)
+{
+	const struct hash_test_vector *vec;
+	uint8_t expect[HASH_MAX_DIGEST_SIZE];
+	uint8_t output[HASH_MAX_DIGEST_SIZE];
+	struct hash_algo *algo;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(hash_vectors); i++) {
+		vec = &hash_vectors[i];
+		if (hash_lookup_algo(vec->algo_name, &algo))
+			continue;
+		hash_parse_string(vec->algo_name, vec->digest, expect);
+		algo->hash_func_ws((const uchar *)vec->input,
+				   strlen(vec->input), output,
+				   algo->chunk_size);
+		if (memcmp(output, expect, algo->digest_size)) {
+			printf("%s: %s(\"%s\") is wrong\n", __func__,
+			       vec->algo_name, vec->input);
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Check that progressive hashing in odd-sized pieces from an unaligned start
+ * gives the same result as hashing the whole buffer in one go.
+ */
+static int test_hash_progressive(const char *algo_name, const uint8_t *buf,
+				 int size)
+{
+	uint8_t expect[HASH_MAX_DIGEST_SIZE];
+	uint8_t output[HASH_MAX_DIGEST_SIZE];
+	struct hash_stream hs;
+	int ret, pos, len;
+
+	ret = hash_stream_start(&hs, algo_name);
+	if (ret == -EPROTONOSUPPORT)
+		return 0;
+	else if (ret)
+		return ret;
+
+	for (pos = 1, len = 1; pos < size; pos += len, len = len * 3 + 1) {
+		len = min(len, size - pos);
+		if (hash_stream_update(&hs, buf + pos, len))
+			return -EIO;
+	}
+	if (hash_stream_finish(&hs, output, sizeof(output)))
+		return -EIO;
+
+	hs.algo->hash_func_ws(buf + 1, size - 1, expect, hs.algo->chunk_size);
+	if (memcmp(output, expect, hs.algo->digest_size)) {
+		printf("%s: %s progressive result is wrong\n", __func__,
+		       algo_name);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/*
+ * Report the throughput of each algorithm over a 1MiB buffer. If the CPU
+ * clock is known, also show cycles per byte.
+ */
+static void bench_hash(const char *algo_name, const uint8_t *buf)
+{
+	uint8_t output[HASH_MAX_DIGEST_SIZE];
+	struct hash_algo *algo;
+	ulong total, start, us;
+
+	if (hash_lookup_algo(algo_name, &algo))
+		return;
+
+	total = 0;
+	start = timer_get_us();
+	do {
+		algo->hash_func_ws(buf, HASH_BENCH_SIZE, output,
+				   algo->chunk_size);
+		total += HASH_BENCH_SIZE;
+	} while (total < HASH_BENCH_MIN_TOTAL);
+	us = max(timer_get_us() - start, 1UL);
+
+	printf("%8s %8lu MB/s %6lu ns/KiB", algo->name, total / us,
+	       us * 1000 / (total >> 10));
+	if (gd->cpu_clk) {
+		printf(" %6lu cycles/KiB",
+		       (ulong)((u64)us * (gd->cpu_clk / 1000000) /
+			       (total >> 10)));
+	}
+	printf("\n");
+}
+
+int do_ut_hash(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
+{
+	uint8_t *buf;
+	int ret = 0;
+	int i;
+
+	buf = malloc(HASH_BENCH_SIZE);
+	if (!buf)
+		return CMD_RET_FAILURE;
+	for (i = 0; i < HASH_BENCH_SIZE; i++)
+		buf[i] = i * 131 + (i >> 8);
+
+	ret |= test_hash_vectors();
+	ret |= test_hash_progressive("sha1", buf, 5000);
+	ret |= test_hash_progressive("sha256", buf, 5000);
+	ret |= test_hash_progressive("crc32", buf, 5000);
+	if (!ret) {
+		bench_hash("sha1", buf);
+		bench_hash("sha256", buf);
+		bench_hash("crc32", buf);
+	}
+	free(buf);
+
+	printf("Test %s\n", ret ? "failed" : "passed");
+
+	return ret ? CMD_RET_FAILURE : CMD_RET_SUCCESS;
+}
@@ -0,0 +1,208 @@
+/*
+ * Tests for initcall ordering, deferral and timing
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <command.h>
+#include <errno.h>
+#include <initcall.h>
+
+extern init_fnc_t init_sequence_r[];
+
+static char ic_log[16];
+static int ic_len;
+
+static int ic_log_call(char name)
+{
+	if (ic_len < sizeof(ic_log) - 1)
+		ic_log[ic_len++] = name;
+	ic_log[ic_len] = '\0';
+
+	return 0;
+}
+
+static int ic_a(void)
+{
+	return ic_log_call('a');
+}
+
+static int ic_b(void)
+{
+	return ic_log_call('b');
+}
+
+static int ic_c(void)
+{
+	return ic_log_call('c');
+}
+
+static int ic_d(void)
+{
+	return ic_log_call('d');
+}
+
+static int ic_e(void)
+{
+	return ic_log_call('e');
+}
+
+static int ic_f(void)
+{
+	return ic_log_call('f');
+}
+
+static int ic_fail(void)
+{
+	ic_log_call('x');
+
+	return -EIO;
+}
+
+INITCALL_INFO(ic_a, 0, INITCALL_MALLOC, 0);
+INITCALL_INFO(ic_b, INITCALL_MALLOC, INITCALL_DM, 0);
+INITCALL_INFO(ic_c, INITCALL_MALLOC, INITCALL_NET, INITCALLF_DEFER);
+/* ic_d has no information, so it is always run in place */
+INITCALL_INFO(ic_e, INITCALL_NET, 0, 0);
+INITCALL_INFO(ic_f, 0, 0, INITCALLF_DEFER);
+
+/* The board_init_f() and board_init_r() lists must meet their own needs */
+static int initcall_test_board(void)
+{
+	ulong missing = 0;
+	int i;
+
+	i = initcall_check_list(init_sequence_r, &missing);
+	if (i != -1) {
+		printf("%s: init_sequence_r[%d] is run before %#lx is set up\n",
+		       __func__, i, missing);
+		return -EINVAL;
+	}
+	if (initcall_get_errors()) {
+		printf("%s: %d initcalls were run too early during boot\n",
+		       __func__, initcall_get_errors());
+		return -EINVAL;
+	}
+	if (!initcall_find(ic_a) || strcmp(initcall_find(ic_a)->name, "ic_a") ||
+	    initcall_find(ic_d)) {
+		printf("%s: wrong initcall information found\n", __func__);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Lists which break their constraints must be caught */
+static int initcall_test_check(void)
+{
+	const init_fnc_t good[] = { ic_a, ic_b, ic_c, ic_d, ic_e, NULL };
+	const init_fnc_t bad[] = { ic_a, ic_d, ic_e, ic_c, NULL };
+	ulong missing = 0;
+	int errors, ret;
+
+	if (initcall_check_list(good, &missing) != -1) {
+		printf("%s: good list rejected\n", __func__);
+		return -EINVAL;
+	}
+	ret = initcall_check_list(bad, &missing);
+	if (ret != 2 || missing != INITCALL_NET) {
+		printf("%s: bad list gave %d, missing %#lx\n", __func__, ret,
+		       missing);
+		return -EINVAL;
+	}
+
+	/* Running it reports the problem but still runs everything */
+	errors = initcall_get_errors();
+	ic_len = 0;
+	puts("Expect an error about ic_e:\n");
+	if (initcall_run_list(bad) || strcmp(ic_log, "adec") ||
+	    initcall_get_errors() != errors + 1) {
+		printf("%s: ran '%s' with %d errors\n", __func__, ic_log,
+		       initcall_get_errors() - errors);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Deferred initcalls run when needed, keeping their order */
+static int initcall_test_order(void)
+{
+	const init_fnc_t list[] = { ic_a, ic_c, ic_f, ic_d, ic_e, ic_b, NULL };
+	const init_fnc_t fail[] = { ic_a, ic_fail, ic_b, NULL };
+	const char *expect;
+	int errors;
+
+	errors = initcall_get_errors();
+	ic_len = 0;
+	if (initcall_run_list(list)) {
+		printf("%s: list failed\n", __func__);
+		return -EINVAL;
+	}
+#ifdef CONFIG_INITCALL_DEFER
+	/* ic_e needs ic_c, which runs with ic_f since they were deferred */
+	expect = "adcfeb";
+#else
+	expect = "acfdeb";
+#endif
+	if (strcmp(ic_log, expect) || initcall_get_errors() != errors) {
+		printf("%s: ran '%s', expected '%s'\n", __func__, ic_log,
+		       expect);
+		return -EINVAL;
+	}
+
+	/* A failure stops the list */
+	ic_len = 0;
+	puts("Expect a failed initcall:\n");
+	if (initcall_run_list(fail) != -1 || strcmp(ic_log, "ax")) {
+		printf("%s: failing list ran '%s'\n", __func__, ic_log);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Each initcall run has its time recorded, under its name if known */
+static int initcall_test_times(void)
+{
+	const init_fnc_t list[] = { ic_a, ic_d, NULL };
+	const struct initcall_time *time;
+	int before, count;
+
+	before = initcall_get_times(&time);
+	if (initcall_run_list(list))
+		return -EINVAL;
+	count = initcall_get_times(&time);
+	if (!IS_ENABLED(CONFIG_INITCALL_TIMING))
+		return count ? -EINVAL : 0;
+
+	if (count != before + 2 || time[before].info < 0 ||
+	    time[before + 1].info != -1) {
+		printf("%s: %d times recorded\n", __func__, count - before);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int do_ut_initcall(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
+{
+	int ret;
+
+	ret = initcall_test_board();
+
+	/* Keep what these record apart from what was recorded during boot */
+	initcall_test_state(true);
+	if (!ret)
+		ret = initcall_test_check();
+	if (!ret)
+		ret = initcall_test_order();
+	if (!ret)
+		ret = initcall_test_times();
+	initcall_test_state(false);
+
+	printf("Test %s\n", ret ? "failed" : "passed");
+
+	return ret ? CMD_RET_FAILURE : CMD_RET_SUCCESS;
+}
@@ -0,0 +1,180 @@
+/*
+ * Tests for the malloc() pool used before relocation, with free()
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <command.h>
+#include <errno.h>
+#include <malloc.h>
+#include <mapmem.h>
+
+DECLARE_GLOBAL_DATA_PTR;
+
+#define MF_TEST_SIZE	4096
+#define MF_TEST_BLOCKS	16
+#define MF_TEST_CYCLES	100	/* Bind/unbind cycles */
+
+/* Check that [@ptr, @ptr + @len) is in the pool */
+static bool mf_in_pool(void *ptr, ulong len)
+{
+	ulong addr = map_to_sysmem(ptr);
+
+	return ptr && addr >= gd->malloc_base &&
+		addr + len <= gd->malloc_base + gd->malloc_limit;
+}
+
+/* Check that freed blocks are reused and given back at the top */
+static int mf_test_reuse(void)
+{
+	u8 *a, *b, *c, *d;
+	ulong top;
+
+	a = malloc_simple(100);
+	b = malloc_simple(50);
+	c = malloc_simple(200);
+	if (!mf_in_pool(a, 100) || !mf_in_pool(b, 50) || !mf_in_pool(c, 200) ||
+	    b < a + 100 || c < b + 50) {
+		printf("%s: bad blocks\n", __func__);
+		return -EINVAL;
+	}
+	top = gd->malloc_ptr;
+	free_simple(b);
+	d = malloc_simple(40);
+	if (d != b || gd->malloc_ptr != top) {
+		printf("%s: freed block not reused\n", __func__);
+		return -EINVAL;
+	}
+	free_simple(c);
+	if (gd->malloc_ptr >= top || gd->malloc_peak < top) {
+		printf("%s: top block not given back\n", __func__);
+		return -EINVAL;
+	}
+	free_simple(a);
+	free_simple(d);
+	a = malloc_simple(8);
+	if (map_to_sysmem(a) >= gd->malloc_base + 100) {
+		printf("%s: free blocks not merged\n", __func__);
+		return -EINVAL;
+	}
+	free_simple(a);
+
+	return 0;
+}
+
+/* Check alignment and that realloc() keeps the data */
+static int mf_test_align(void)
+{
+	u8 *a, *b, *c;
+	int i;
+
+	a = malloc_simple(3);
+	b = memalign_simple(64, 100);
+	if (!mf_in_pool(b, 100) || map_to_sysmem(b) & 63) {
+		printf("%s: block not aligned\n", __func__);
+		return -EINVAL;
+	}
+	for (i = 0; i < 100; i++)
+		b[i] = i;
+	c = realloc_simple(b, 300);
+	if (!mf_in_pool(c, 300)) {
+		printf("%s: realloc() failed\n", __func__);
+		return -EINVAL;
+	}
+	for (i = 0; i < 100; i++) {
+		if (c[i] != i) {
+			printf("%s: realloc() lost data\n", __func__);
+			return -EINVAL;
+		}
+	}
+	free_simple(c);
+	free_simple(a);
+
+	return 0;
+}
+
+/*
+ * Bind and unbind a few 'devices' many times. The pool must not grow, and
+ * filling it then freeing everything must leave it empty.
+ */
+static int mf_test_cycles(void)
+{
+	void *ptr[MF_TEST_BLOCKS];
+	ulong peak = 0;
+	int i, n, cycle;
+
+	for (cycle = 0; cycle < MF_TEST_CYCLES; cycle++) {
+		for (i = 0; i < 4; i++)
+			ptr[i] = malloc_simple(24 + i * 40);
+		for (i = 3; i >= 0; i -= 2)
+			free_simple(ptr[i]);
+		for (i = 2; i >= 0; i -= 2)
+			free_simple(ptr[i]);
+		if (!cycle)
+			peak = gd->malloc_peak;
+	}
+	if (gd->malloc_peak != peak) {
+		printf("%s: pool grew from %#lx to %#lx\n", __func__, peak,
+		       gd->malloc_peak);
+		return -EINVAL;
+	}
+
+	for (n = 0; n < MF_TEST_BLOCKS; n++) {
+		ptr[n] = malloc_simple(MF_TEST_SIZE / MF_TEST_BLOCKS);
+		if (!ptr[n])
+			break;
+	}
+	if (n == MF_TEST_BLOCKS || malloc_simple(MF_TEST_SIZE)) {
+		printf("%s: pool did not fill\n", __func__);
+		return -EINVAL;
+	}
+	for (i = 0; i < n; i += 2)
+		free_simple(ptr[i]);
+	for (i = 1; i < n; i += 2)
+		free_simple(ptr[i]);
+	free_simple(malloc_simple(1));
+	if (gd->malloc_ptr) {
+		printf("%s: %#lx bytes left in use\n", __func__,
+		       gd->malloc_ptr);
+		return -EINVAL;
+	}
+	printf("%d cycles used a peak of %#lx bytes\n", MF_TEST_CYCLES, peak);
+
+	return 0;
+}
+
+int do_ut_malloc_f(cmd_tbl_t *cmdtp, int flag, int argc,
+		   char * const argv[])
+{
+	ulong base = gd->malloc_base;
+	ulong limit = gd->malloc_limit;
+	ulong ptr = gd->malloc_ptr;
+	ulong peak = gd->malloc_peak;
+	void *buf;
+	int ret;
+
+	buf = memalign(ARCH_DMA_MINALIGN, MF_TEST_SIZE);
+	if (!buf)
+		return CMD_RET_FAILURE;
+
+	/* Point the pool at a buffer of our own */
+	gd->malloc_base = map_to_sysmem(buf);
+	gd->malloc_limit = MF_TEST_SIZE;
+	gd->malloc_ptr = 0;
+	gd->malloc_peak = 0;
+	ret = mf_test_reuse();
+	if (!ret)
+		ret = mf_test_align();
+	if (!ret)
+		ret = mf_test_cycles();
+	gd->malloc_base = base;
+	gd->malloc_limit = limit;
+	gd->malloc_ptr = ptr;
+	gd->malloc_peak = peak;
+	free(buf);
+
+	printf("Test %s\n", ret ? "failed" : "passed");
+
+	return ret ? CMD_RET_FAILURE : CMD_RET_SUCCESS;
+}
@@ -0,0 +1,291 @@
+/*
+ * Tests and benchmark for memcpy(), memmove(), memset() and memcmp(), over
+ * a range of sizes and alignments
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <command.h>
+#include <errno.h>
+#include <malloc.h>
+
+#define MEM_TEST_MAX	300	/* Largest size checked byte by byte */
+#define MEM_TEST_ALIGN	8	/* Offsets 0..7 from an aligned address */
+#define MEM_TEST_GUARD	16
+#define MEM_TEST_BUF	(MEM_TEST_MAX + MEM_TEST_ALIGN + 2 * MEM_TEST_GUARD)
+#define MEM_BENCH_MAX	(1 << 20)
+#define MEM_BENCH_BYTES	(32 << 20)	/* Bytes processed for each result */
+
+static const int mem_test_sizes[] = {
+	0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100,
+	127, 128, 129, 255, 256, MEM_TEST_MAX,
+};
+
+static const int mem_bench_sizes[] = { 16, 64, 256, 4096, 65536, 1 << 20 };
+
+/* Destination and source offsets from an aligned address */
+static const struct {
+	int dst;
+	int src;
+} mem_bench_aligns[] = {
+	{ 0, 0 }, { 3, 3 }, { 0, 1 }, { 2, 7 },
+};
+
+static void mem_fill(u8 *buf, int len, int seed)
+{
+	int i;
+
+	for (i = 0; i < len; i++)
+		buf[i] = seed + i * 7;
+}
+
+/* Check that @buf is @val outside [@start, @start + @len) */
+static int mem_check_guard(const u8 *buf, int start, int len, u8 val)
+{
+	int i;
+
+	for (i = 0; i < MEM_TEST_BUF; i++) {
+		if ((i < start || i >= start + len) && buf[i] != val)
+			return -EFAULT;
+	}
+
+	return 0;
+}
+
+static int mem_test_copy(u8 *dst, u8 *src)
+{
+	int d, s, i, j, len;
+	void *ret;
+
+	for (i = 0; i < ARRAY_SIZE(mem_test_sizes); i++) {
+		len = mem_test_sizes[i];
+		for (d = 0; d < MEM_TEST_ALIGN; d++) {
+			for (s = 0; s < MEM_TEST_ALIGN; s++) {
+				mem_fill(src, MEM_TEST_BUF, len + s);
+				memset(dst, 0xa5, MEM_TEST_BUF);
+				ret = memcpy(dst + MEM_TEST_GUARD + d,
+					     src + MEM_TEST_GUARD + s, len);
+				if (ret != dst + MEM_TEST_GUARD + d ||
+				    mem_check_guard(dst, MEM_TEST_GUARD + d,
+						    len, 0xa5))
+					goto err;
+				for (j = 0; j < len; j++) {
+					if (dst[MEM_TEST_GUARD + d + j] !=
+					    src[MEM_TEST_GUARD + s + j])
+						goto err;
+				}
+			}
+		}
+	}
+
+	return 0;
+err:
+	printf("%s: %d bytes, dst +%d, src +%d\n", __func__, len, d, s);
+	return -EINVAL;
+}
+
+static int mem_test_set(u8 *dst)
+{
+	static const int vals[] = { 0, 0x5a, 0x80, 0xff, 0x1234 };
+	int d, v, i, j, len;
+	void *ret;
+
+	for (i = 0; i < ARRAY_SIZE(mem_test_sizes); i++) {
+		len = mem_test_sizes[i];
+		for (d = 0; d < MEM_TEST_ALIGN; d++) {
+			for (v = 0; v < ARRAY_SIZE(vals); v++) {
+				memset(dst, 0xa5, MEM_TEST_BUF);
+				ret = memset(dst + MEM_TEST_GUARD + d, vals[v],
+					     len);
+				if (ret != dst + MEM_TEST_GUARD + d ||
+				    mem_check_guard(dst, MEM_TEST_GUARD + d,
+						    len, 0xa5))
+					goto err;
+				for (j = 0; j < len; j++) {
+					if (dst[MEM_TEST_GUARD + d + j] !=
+					    (u8)vals[v])
+						goto err;
+				}
+			}
+		}
+	}
+
+	return 0;
+err:
+	printf("%s: %d bytes, dst +%d, value %x\n", __func__, len, d, vals[v]);
+	return -EINVAL;
+}
+
+/* Move within one buffer, in both directions, and compare with @ref */
+static int mem_test_move(u8 *buf, u8 *ref)
+{
+	int i, j, len, from, to;
+	void *ret;
+
+	for (i = 0; i < ARRAY_SIZE(mem_test_sizes); i++) {
+		len = min(mem_test_sizes[i], MEM_TEST_MAX - 2 * MEM_TEST_GUARD);
+		for (from = MEM_TEST_GUARD; from < 3 * MEM_TEST_GUARD;
+		     from++) {
+			to = 2 * MEM_TEST_GUARD + (from * 5) % 23 - 11;
+			mem_fill(buf, MEM_TEST_BUF, from);
+			mem_fill(ref, MEM_TEST_BUF, from);
+			for (j = 0; j < len; j++)
+				ref[MEM_TEST_BUF + j] = ref[from + j];
+			for (j = 0; j < len; j++)
+				ref[to + j] = ref[MEM_TEST_BUF + j];
+			ret = memmove(buf + to, buf + from, len);
+			for (j = 0; j < MEM_TEST_BUF; j++) {
+				if (buf[j] != ref[j])
+					break;
+			}
+			if (ret != buf + to || j != MEM_TEST_BUF) {
+				printf("%s: %d bytes from %d to %d\n",
+				       __func__, len, from, to);
+				return -EINVAL;
+			}
+		}
+	}
+
+	return 0;
+}
+
+static int mem_test_cmp(u8 *a, u8 *b)
+{
+	int d, s, i, len, ret;
+	int pos = 0;
+
+	for (i = 0; i < ARRAY_SIZE(mem_test_sizes); i++) {
+		len = mem_test_sizes[i];
+		for (d = 0; d < MEM_TEST_ALIGN; d += 3) {
+			for (s = 0; s < MEM_TEST_ALIGN; s++) {
+				mem_fill(a + d, len, len);
+				mem_fill(b + s, len, len);
+				if (memcmp(a + d, b + s, len))
+					goto err;
+				/* A difference anywhere, in either direction */
+				for (pos = 0; pos < len; pos++) {
+					a[d + pos] = 0x80;
+					b[s + pos] = 0x7f;
+					ret = memcmp(a + d, b + s, len);
+					if (ret <= 0 ||
+					    memcmp(b + s, a + d, len) >= 0)
+						goto err;
+					/* Later bytes do not matter */
+					if (pos + 1 < len) {
+						a[d + len - 1] ^= 0xff;
+						ret = memcmp(a + d, b + s, len);
+						a[d + len - 1] ^= 0xff;
+						if (ret <= 0)
+							goto err;
+					}
+					a[d + pos] = b[s + pos] = pos;
+				}
+			}
+		}
+	}
+
+	return 0;
+err:
+	printf("%s: %d bytes, +%d, +%d, pos %d\n", __func__, len, d, s, pos);
+	return -EINVAL;
+}
+
+enum {
+	MEM_BENCH_CPY,
+	MEM_BENCH_MOVE,
+	MEM_BENCH_SET,
+	MEM_BENCH_CMP,
+
+	MEM_BENCH_COUNT,
+};
+
+static const char *const mem_bench_names[] = {
+	"memcpy", "memmove", "memset", "memcmp",
+};
+
+static void mem_bench_run(int func, u8 *dst, u8 *src, int len, int loops)
+{
+	int i;
+
+	for (i = 0; i < loops; i++) {
+		switch (func) {
+		case MEM_BENCH_CPY:
+			memcpy(dst, src, len);
+			break;
+		case MEM_BENCH_MOVE:
+			memmove(dst, src, len);
+			break;
+		case MEM_BENCH_SET:
+			memset(dst, i, len);
+			break;
+		case MEM_BENCH_CMP:
+			if (memcmp(dst, src, len))
+				return;
+			break;
+		}
+	}
+}
+
+/* Report MB/s for each size and alignment */
+static void mem_bench(u8 *dst, u8 *src)
+{
+	int func, i, j, len, loops;
+	ulong start, us;
+
+	for (func = 0; func < MEM_BENCH_COUNT; func++) {
+		printf("%-8s", mem_bench_names[func]);
+		for (j = 0; j < ARRAY_SIZE(mem_bench_aligns); j++)
+			printf("  dst+%d src+%d", mem_bench_aligns[j].dst,
+			       mem_bench_aligns[j].src);
+		printf("   (MB/s)\n");
+		for (i = 0; i < ARRAY_SIZE(mem_bench_sizes); i++) {
+			len = mem_bench_sizes[i];
+			loops = MEM_BENCH_BYTES / len;
+			printf("%8d", len);
+			for (j = 0; j < ARRAY_SIZE(mem_bench_aligns); j++) {
+				u8 *d = dst + 16 + mem_bench_aligns[j].dst;
+				u8 *s = src + mem_bench_aligns[j].src;
+
+				/* Move up within one buffer, copying backwards */
+				if (func == MEM_BENCH_MOVE)
+					s = dst + mem_bench_aligns[j].src;
+
+				/* memcmp() must see equal data to the end */
+				if (func == MEM_BENCH_CMP)
+					memcpy(d, s, len);
+				start = timer_get_us();
+				mem_bench_run(func, d, s, len, loops);
+				us = max(timer_get_us() - start, 1UL);
+				printf(" %13lu", (ulong)((u64)len * loops / us));
+			}
+			printf("\n");
+		}
+	}
+}
+
+int do_ut_mem(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
+{
+	u8 *dst, *src;
+	int ret = -ENOMEM;
+
+	dst = memalign(ARCH_DMA_MINALIGN, MEM_BENCH_MAX + 64);
+	src = memalign(ARCH_DMA_MINALIGN, MEM_BENCH_MAX + 64);
+	if (dst && src) {
+		ret = mem_test_copy(dst, src);
+		if (!ret)
+			ret = mem_test_set(dst);
+		if (!ret)
+			ret = mem_test_move(dst, src);
+		if (!ret)
+			ret = mem_test_cmp(dst, src);
+		if (!ret && !(argc > 1 && !strcmp(argv[1], "-q")))
+			mem_bench(dst, src);
+	}
+	free(src);
+	free(dst);
+
+	printf("Test %s\n", ret ? "failed" : "passed");
+
+	return ret ? CMD_RET_FAILURE : CMD_RET_SUCCESS;
+}
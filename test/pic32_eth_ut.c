@@ -0,0 +1,279 @@
+/*
+ * Tests for the PIC32 Ethernet descriptor rings, using a model of how the
+ * controller takes and gives back ownership of descriptors
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <command.h>
+#include <errno.h>
+#include <malloc.h>
+#include <mapmem.h>
+#include <pic32_eth_ring.h>
+#include <asm/io.h>
+
+#define TEST_DESCR		4
+#define TEST_BUF_SIZE		64
+
+/*
+ * Where the model controller has got to in a ring: the descriptor it will
+ * look at next, as a bus address, just as in ETHTXST / ETHRXST
+ */
+struct model_dma {
+	ulong cur;
+};
+
+static struct eth_dma_desc *model_desc(struct model_dma *dma)
+{
+	return map_sysmem(dma->cur, sizeof(struct eth_dma_desc));
+}
+
+static void model_next(struct model_dma *dma, struct eth_dma_desc *desc)
+{
+	if (desc->hdr & EDH_NPV)
+		dma->cur = desc->next_ed;
+	else
+		dma->cur += sizeof(*desc);
+}
+
+/*
+ * Transmit up to @max frames, stopping at the first descriptor the CPU
+ * owns. Each frame is checked against the pattern from test_fill().
+ */
+static int model_tx(struct model_dma *dma, int max, int *lens)
+{
+	struct eth_dma_desc *desc;
+	int sent, len, i;
+	u8 *data;
+
+	for (sent = 0; sent < max; sent++) {
+		desc = model_desc(dma);
+		if (!(desc->hdr & EDH_EOWN))
+			break;
+		if ((desc->hdr & (EDH_SOP | EDH_EOP)) != (EDH_SOP | EDH_EOP))
+			return -EINVAL;
+		len = EDH_GET_BCOUNT(desc->hdr);
+		data = map_sysmem(desc->data_buff, len);
+		for (i = 0; i < len; i++) {
+			if (data[i] != (u8)(len + i))
+				return -EBADMSG;
+		}
+		lens[sent] = len;
+		desc->hdr &= ~EDH_EOWN;
+		desc->stat2 = len;
+		model_next(dma, desc);
+	}
+
+	return sent;
+}
+
+/*
+ * Receive a frame of @len bytes plus a CRC, spreading it over as many
+ * descriptors as needed. Like the controller, the whole frame is dropped if
+ * there are not enough descriptors. @stat is the receive status vector.
+ */
+static int model_rx(struct model_dma *dma, int len, u32 stat)
+{
+	struct model_dma probe = *dma;
+	struct eth_dma_desc *desc;
+	int count = len + 4;
+	int n, pos, part;
+	u8 *data;
+
+	for (n = 0; n < DIV_ROUND_UP(count, TEST_BUF_SIZE); n++) {
+		desc = model_desc(&probe);
+		if (!(desc->hdr & EDH_EOWN))
+			return -ENOSPC;
+		model_next(&probe, desc);
+	}
+
+	for (pos = 0; pos < count; pos += part) {
+		desc = model_desc(dma);
+		part = min(count - pos, TEST_BUF_SIZE);
+		data = map_sysmem(desc->data_buff, part);
+		for (n = 0; n < part; n++)
+			data[n] = (u8)(len + pos + n);
+		desc->hdr &= EDH_NPV | EDH_STICKY;
+		desc->hdr |= EDH_BCOUNT(part);
+		if (!pos)
+			desc->hdr |= EDH_SOP;
+		if (pos + part == count) {
+			desc->hdr |= EDH_EOP;
+			desc->stat2 = stat | count;
+		}
+		model_next(dma, desc);
+	}
+
+	return 0;
+}
+
+static void test_fill(u8 *buf, int len)
+{
+	int i;
+
+	for (i = 0; i < len; i++)
+		buf[i] = len + i;
+}
+
+static int test_tx(void **bufs)
+{
+	struct pic32_eth_ring ring;
+	struct model_dma dma;
+	int lens[TEST_DESCR * 2];
+	int ret, i, frame;
+	void *buf;
+
+	ret = pic32_eth_ring_init(&ring, TEST_DESCR, bufs, TEST_BUF_SIZE,
+				  virt_to_phys, false);
+	if (ret)
+		return ret;
+	dma.cur = pic32_eth_ring_phys(&ring, 0);
+
+	/* Nothing is sent until a frame is queued */
+	ret = -EINVAL;
+	if (model_tx(&dma, 1, lens) != 0 ||
+	    pic32_eth_tx_reap(&ring) != -ENOENT)
+		goto out;
+
+	/*
+	 * Queue three frames and let the controller send two. The third is
+	 * where the DMA restarts.
+	 */
+	for (i = 0; i < 3; i++) {
+		buf = pic32_eth_tx_buf(&ring);
+		test_fill(buf, 20 + i);
+		pic32_eth_tx_queue(&ring, 20 + i);
+	}
+	if (model_tx(&dma, 2, lens) != 2 || lens[0] != 20 || lens[1] != 21) {
+		printf("%s: first frames not sent\n", __func__);
+		goto out;
+	}
+	if (pic32_eth_tx_reap(&ring) != 2 || ring.pending != 1) {
+		printf("%s: completed frames not reaped\n", __func__);
+		goto out;
+	}
+
+	/* Fill the ring, wrapping round, then check that it is full */
+	for (i = 0; i < TEST_DESCR - 1; i++) {
+		buf = pic32_eth_tx_buf(&ring);
+		if (!buf)
+			goto out;
+		test_fill(buf, 30 + i);
+		pic32_eth_tx_queue(&ring, 30 + i);
+	}
+	if (pic32_eth_tx_buf(&ring)) {
+		printf("%s: ring should be full\n", __func__);
+		goto out;
+	}
+
+	/* Everything goes out in order, after which there is room again */
+	frame = model_tx(&dma, ARRAY_SIZE(lens), lens);
+	if (frame != TEST_DESCR || lens[0] != 22 || lens[1] != 30 ||
+	    lens[TEST_DESCR - 1] != 30 + TEST_DESCR - 2) {
+		printf("%s: queued frames not sent (%d)\n", __func__, frame);
+		goto out;
+	}
+	if (!pic32_eth_tx_buf(&ring) || pic32_eth_tx_reap(&ring) != -ENOENT ||
+	    ring.pending)
+		goto out;
+	ret = 0;
+out:
+	pic32_eth_ring_free(&ring);
+
+	return ret;
+}
+
+/* Get the next frame and check it is @len bytes long, from the model */
+static int test_rx_check(struct pic32_eth_ring *ring, int len)
+{
+	uchar *pkt;
+	int ret, i;
+
+	ret = pic32_eth_rx_frame(ring, &pkt);
+	if (ret != len) {
+		printf("%s: expected %d bytes, got %d\n", __func__, len, ret);
+		return -EINVAL;
+	}
+	for (i = 0; i < len; i++) {
+		if (pkt[i] != (u8)(len + i)) {
+			printf("%s: frame of %d bytes is wrong\n", __func__,
+			       len);
+			return -EBADMSG;
+		}
+	}
+
+	return 0;
+}
+
+static int test_rx(void **bufs)
+{
+	struct pic32_eth_ring ring;
+	struct model_dma dma;
+	uchar *pkt;
+	int ret;
+
+	ret = pic32_eth_ring_init(&ring, TEST_DESCR, bufs, TEST_BUF_SIZE,
+				  virt_to_phys, true);
+	if (ret)
+		return ret;
+	dma.cur = pic32_eth_ring_phys(&ring, 0);
+
+	/* A frame in one buffer is passed up, one spanning two is dropped */
+	ret = -EINVAL;
+	pic32_eth_rx_sync(&ring);
+	if (pic32_eth_rx_frame(&ring, &pkt) != -EAGAIN)
+		goto out;
+	if (model_rx(&dma, 40, _RSV2_RX_OK) ||
+	    model_rx(&dma, 100, _RSV2_RX_OK))
+		goto out;
+	pic32_eth_rx_sync(&ring);
+	if (test_rx_check(&ring, 40) ||
+	    pic32_eth_rx_frame(&ring, &pkt) != -EMSGSIZE)
+		goto out;
+
+	/* Until they are given back, only one descriptor is free */
+	if (model_rx(&dma, 100, _RSV2_RX_OK) != -ENOSPC ||
+	    pic32_eth_rx_return(&ring) != 2)
+		goto out;
+
+	/* A bad frame is consumed, and the ring wraps to the next one */
+	if (model_rx(&dma, 50, _RSV2_CRC_ERR) ||
+	    model_rx(&dma, TEST_BUF_SIZE - 4, _RSV2_RX_OK))
+		goto out;
+	pic32_eth_rx_sync(&ring);
+	if (pic32_eth_rx_frame(&ring, &pkt) != -EIO ||
+	    test_rx_check(&ring, TEST_BUF_SIZE - 4) ||
+	    pic32_eth_rx_frame(&ring, &pkt) != -EAGAIN ||
+	    pic32_eth_rx_return(&ring) != 2)
+		goto out;
+
+	ret = 0;
+out:
+	pic32_eth_ring_free(&ring);
+
+	return ret;
+}
+
+int do_ut_pic32eth(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
+{
+	void *bufs[TEST_DESCR];
+	u8 *mem;
+	int ret;
+	int i;
+
+	mem = memalign(ARCH_DMA_MINALIGN, TEST_DESCR * TEST_BUF_SIZE);
+	if (!mem)
+		return CMD_RET_FAILURE;
+	for (i = 0; i < TEST_DESCR; i++)
+		bufs[i] = mem + i * TEST_BUF_SIZE;
+
+	ret = test_tx(bufs);
+	if (!ret)
+		ret = test_rx(bufs);
+	free(mem);
+
+	printf("Test %s\n", ret ? "failed" : "passed");
+
+	return ret ? CMD_RET_FAILURE : CMD_RET_SUCCESS;
+}
@@ -0,0 +1,128 @@
+/*
+ * Tests and throughput benchmark for the SDHCI driver, using the emulated
+ * controller in sandbox
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <command.h>
+#include <errno.h>
+#include <malloc.h>
+#include <mmc.h>
+#include <sdhci.h>
+
+#define SDHCI_TEST_BLOCKS	2048	/* 1MiB, so ADMA needs 16 descriptors */
+#define SDHCI_TEST_START	8
+#define SDHCI_TEST_SIZE		(SDHCI_TEST_BLOCKS * 512)
+
+static struct mmc *sdhci_test_find(void)
+{
+	struct mmc *mmc;
+	int i;
+
+	for (i = 0; i < get_mmc_num(); i++) {
+		mmc = find_mmc_device(i);
+		if (mmc && !strcmp(mmc->cfg->name, "sandbox_sdhci"))
+			return mmc;
+	}
+
+	return NULL;
+}
+
+/*
+ * Read @blocks blocks into @buf and check them against @expect. @adma
+ * says whether the transfer is expected to use ADMA.
+ */
+static int sdhci_test_read(struct mmc *mmc, void *buf, const void *expect,
+			   int blocks, int adma)
+{
+	struct sdhci_host *host = mmc->priv;
+	ulong adma_xfers = host->stats.adma_xfers;
+	int dev = mmc->block_dev.dev;
+
+	memset(buf, '\0', blocks * 512);
+	if (mmc->block_dev.block_read(dev, SDHCI_TEST_START, blocks,
+				      buf) != blocks) {
+		printf("%s: read failed\n", __func__);
+		return -EIO;
+	}
+	if (memcmp(buf, expect, blocks * 512)) {
+		printf("%s: data mismatch (%s)\n", __func__,
+		       adma ? "ADMA" : "PIO");
+		return -EINVAL;
+	}
+	if ((host->stats.adma_xfers != adma_xfers) != adma) {
+		printf("%s: ADMA was %sused\n", __func__, adma ? "not " : "");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static void sdhci_test_show(const char *mode, struct sdhci_host *host)
+{
+	printf("%8s %8u bytes %8lu us %8lu KiB/s\n", mode,
+	       host->stats.last_bytes, host->stats.last_us,
+	       (ulong)((u64)host->stats.last_bytes * 1000000 /
+		       max(host->stats.last_us, 1UL) >> 10));
+}
+
+int do_ut_sdhci(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
+{
+	struct sdhci_host *host;
+	struct mmc *mmc;
+	u8 stack_buf[512];
+	u8 *expect, *buf;
+	int ret = 0;
+	int i;
+
+	mmc = sdhci_test_find();
+	if (!mmc || mmc_init(mmc)) {
+		printf("No sandbox SDHCI device\n");
+		return CMD_RET_FAILURE;
+	}
+	host = mmc->priv;
+
+	expect = malloc(SDHCI_TEST_SIZE);
+	buf = malloc(SDHCI_TEST_SIZE + 4);
+	if (!expect || !buf) {
+		free(expect);
+		free(buf);
+		return CMD_RET_FAILURE;
+	}
+	for (i = 0; i < SDHCI_TEST_SIZE; i++)
+		expect[i] = i * 7 + (i >> 9);
+
+	/* Write with ADMA, then read back with both ADMA and PIO */
+	if (mmc->block_dev.block_write(mmc->block_dev.dev, SDHCI_TEST_START,
+				       SDHCI_TEST_BLOCKS, expect) !=
+	    SDHCI_TEST_BLOCKS || host->stats.last_bytes != SDHCI_TEST_SIZE) {
+		printf("ADMA write failed\n");
+		ret = -EIO;
+	}
+	if (!ret)
+		ret = sdhci_test_read(mmc, buf, expect, SDHCI_TEST_BLOCKS, 1);
+	if (!ret)
+		sdhci_test_show("ADMA", host);
+
+	host->quirks |= SDHCI_QUIRK_BROKEN_ADMA;
+	if (!ret)
+		ret = sdhci_test_read(mmc, buf, expect, SDHCI_TEST_BLOCKS, 0);
+	if (!ret)
+		sdhci_test_show("PIO", host);
+	host->quirks &= ~SDHCI_QUIRK_BROKEN_ADMA;
+
+	/* Buffers which ADMA cannot use must fall back to PIO */
+	if (!ret)
+		ret = sdhci_test_read(mmc, buf + 1, expect, 16, 0);
+	if (!ret)
+		ret = sdhci_test_read(mmc, stack_buf, expect, 1, 0);
+
+	free(expect);
+	free(buf);
+
+	printf("Test %s\n", ret ? "failed" : "passed");
+
+	return ret ? CMD_RET_FAILURE : CMD_RET_SUCCESS;
+}
@@ -0,0 +1,215 @@
+/*
+ * Tests and benchmark for the slabs for small objects
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <command.h>
+#include <errno.h>
+#include <malloc.h>
+#include <slab.h>
+
+#define SLAB_TEST_OBJS		64	/* Objects allocated for each size */
+#define SLAB_BENCH_OBJS		256	/* Objects held at once */
+#define SLAB_BENCH_ROUNDS	200
+
+static struct slab_pool slab_test_pool = SLAB_POOL("test");
+
+static const int slab_test_sizes[] = {
+	1, 8, 16, 17, 24, 32, 33, 64, 65, 100, 128, 200, 256, 257, 500, 512,
+};
+
+/* Check that each size gets an object of the right class, and back */
+static int slab_test_sizes_ok(void)
+{
+	void *ptr[SLAB_TEST_OBJS];
+	struct mallinfo before;
+	int i, j, size, class;
+	size_t expect;
+
+	before = mallinfo();
+	for (i = 0; i < ARRAY_SIZE(slab_test_sizes); i++) {
+		size = slab_test_sizes[i];
+		expect = SLAB_MIN_SIZE;
+		for (class = 0; expect < size; class++)
+			expect <<= 1;
+		for (j = 0; j < SLAB_TEST_OBJS; j++) {
+			ptr[j] = slab_calloc(&slab_test_pool, size);
+			if (!slab_owns(ptr[j]) ||
+			    (ulong)ptr[j] & (SLAB_MIN_SIZE - 1) ||
+			    malloc_usable_size(ptr[j]) != expect)
+				goto err;
+			memset(ptr[j], j, size);
+		}
+		if (slab_test_pool.class[class].used != SLAB_TEST_OBJS ||
+		    mallinfo().uordblks !=
+		    before.uordblks + SLAB_TEST_OBJS * expect)
+			goto err;
+		for (j = 0; j < SLAB_TEST_OBJS; j++) {
+			if (((u8 *)ptr[j])[size - 1] != (u8)j)
+				goto err;
+			free(ptr[j]);
+		}
+		if (slab_test_pool.class[class].used ||
+		    mallinfo().uordblks != before.uordblks)
+			goto err;
+	}
+
+	/* Larger objects must come from malloc() */
+	if (slab_alloc(&slab_test_pool, SLAB_MAX_SIZE + 1) ||
+	    slab_alloc(&slab_test_pool, 0))
+		goto err;
+
+	return 0;
+err:
+	printf("%s: size %d\n", __func__, slab_test_sizes[i]);
+	return -EINVAL;
+}
+
+/* Check that freed objects are reused and realloc() moves them out */
+static int slab_test_reuse(void)
+{
+	u8 *ptr, *again;
+	int i;
+
+	ptr = slab_malloc(&slab_test_pool, 48);
+	free(ptr);
+	again = slab_malloc(&slab_test_pool, 64);
+	if (again != ptr) {
+		printf("%s: freed object not reused\n", __func__);
+		return -EINVAL;
+	}
+	for (i = 0; i < 64; i++)
+		again[i] = i;
+	ptr = realloc(again, 4096);
+	if (!ptr || slab_owns(ptr)) {
+		printf("%s: realloc() failed\n", __func__);
+		return -EINVAL;
+	}
+	for (i = 0; i < 64; i++) {
+		if (ptr[i] != i) {
+			printf("%s: realloc() lost data\n", __func__);
+			return -EINVAL;
+		}
+	}
+	free(ptr);
+	if (slab_test_pool.class[2].used) {
+		printf("%s: object not freed\n", __func__);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/*
+ * Fill the slab area, check that allocation then falls back to malloc(),
+ * and that releasing the pool makes all of its pages available again
+ */
+static int slab_test_release(void)
+{
+	uint fallback = slab_test_pool.fallback;
+	struct mallinfo before;
+	void *ptr, *extra;
+	uint count = 0;
+
+	before = mallinfo();
+	while (slab_alloc(&slab_test_pool, SLAB_MAX_SIZE))
+		count++;
+	if (!count || slab_test_pool.fallback != fallback + 1 ||
+	    mallinfo().uordblks != before.uordblks + count * SLAB_MAX_SIZE) {
+		printf("%s: slab area did not fill\n", __func__);
+		return -EINVAL;
+	}
+	extra = slab_malloc(&slab_test_pool, SLAB_MAX_SIZE);
+	if (!extra || slab_owns(extra)) {
+		printf("%s: no fallback to malloc()\n", __func__);
+		return -EINVAL;
+	}
+	free(extra);
+
+	slab_release(&slab_test_pool);
+	if (slab_test_pool.num_pages ||
+	    mallinfo().uordblks != before.uordblks) {
+		printf("%s: pool not released\n", __func__);
+		return -EINVAL;
+	}
+	ptr = slab_alloc(&slab_test_pool, SLAB_MIN_SIZE);
+	if (!ptr) {
+		printf("%s: pages not reused\n", __func__);
+		return -EINVAL;
+	}
+	free(ptr);
+	slab_release(&slab_test_pool);
+	printf("Slab area held %u objects of %d bytes\n", count, SLAB_MAX_SIZE);
+
+	return 0;
+}
+
+/* Allocate and free objects of mixed sizes, as binding devices does */
+static ulong slab_bench_run(void **ptr, bool use_slab)
+{
+	ulong start;
+	int n = ARRAY_SIZE(slab_test_sizes);
+	int i, r;
+
+	start = timer_get_us();
+	for (r = 0; r < SLAB_BENCH_ROUNDS; r++) {
+		for (i = 0; i < SLAB_BENCH_OBJS; i++) {
+			if (use_slab)
+				ptr[i] = slab_calloc(&slab_test_pool,
+						     slab_test_sizes[i % n]);
+			else
+				ptr[i] = calloc(1, slab_test_sizes[i % n]);
+		}
+		/* Free them in a different order, as a partial unbind would */
+		for (i = 0; i < SLAB_BENCH_OBJS; i += 2)
+			free(ptr[i]);
+		for (i = 1; i < SLAB_BENCH_OBJS; i += 2)
+			free(ptr[i]);
+	}
+
+	return max(timer_get_us() - start, 1UL);
+}
+
+/*
+ * Report the time taken with calloc() and with slabs. Neither is faster in
+ * every case: the figures depend on the host's caches and on how much of
+ * the malloc() area is already in use, so they are not checked.
+ */
+static void slab_bench(void)
+{
+	void *ptr[SLAB_BENCH_OBJS];
+	ulong us_malloc, us_slab;
+
+	/* Untimed runs first, so that neither pays for growing its area */
+	slab_bench_run(ptr, false);
+	slab_bench_run(ptr, true);
+	us_malloc = slab_bench_run(ptr, false);
+	us_slab = slab_bench_run(ptr, true);
+	slab_release(&slab_test_pool);
+	printf("%d allocations and frees of %d to %d bytes, %d held at once:\n",
+	       SLAB_BENCH_OBJS * SLAB_BENCH_ROUNDS, slab_test_sizes[0],
+	       slab_test_sizes[ARRAY_SIZE(slab_test_sizes) - 1],
+	       SLAB_BENCH_OBJS);
+	printf("calloc() %lu us, slab %lu us (for information only)\n",
+	       us_malloc, us_slab);
+}
+
+int do_ut_slab(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
+{
+	int ret;
+
+	ret = slab_test_sizes_ok();
+	if (!ret)
+		ret = slab_test_reuse();
+	if (!ret)
+		ret = slab_test_release();
+	if (!ret)
+		slab_bench();
+	slab_release(&slab_test_pool);
+
+	printf("Test %s\n", ret ? "failed" : "passed");
+
+	return ret ? CMD_RET_FAILURE : CMD_RET_SUCCESS;
+}
@@ -0,0 +1,274 @@
+/*
+ * Tests for the function trace call list and function times
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <command.h>
+#include <errno.h>
+#include <malloc.h>
+#include <trace.h>
+#include <asm/sections.h>
+#include <asm/test.h>
+
+#ifdef CONFIG_TRACE
+
+/* Number of calls the private call list holds, so that a ring wraps */
+#define TU_RECORDS	8
+
+void __cyg_profile_func_enter(void *func_ptr, void *caller);
+void __cyg_profile_func_exit(void *func_ptr, void *caller);
+
+/*
+ * The calls are made by hand, so these stand for the functions called.
+ * Everything run while tracing is notrace so that only they are recorded.
+ */
+static char tu_sites[8][FUNC_SITE_SIZE];
+
+/* The calls recorded, as a string of "+a" for an entry and "-a" for an exit */
+static char tu_log[64];
+
+static void notrace tu_enter(int func)
+{
+	__cyg_profile_func_enter(tu_sites[func], tu_sites[0]);
+}
+
+static void notrace tu_exit(int func)
+{
+	__cyg_profile_func_exit(tu_sites[func], tu_sites[0]);
+}
+
+/* Make a call to each function in turn, with no nesting */
+static void notrace tu_calls(int first, int last)
+{
+	int func;
+
+	for (func = first; func <= last; func++) {
+		tu_enter(func);
+		tu_exit(func);
+	}
+}
+
+/* Get the offset of the function recorded for a site, as lib/trace.c does */
+static uint32_t tu_offset(int func)
+{
+	uintptr_t offset = (uintptr_t)tu_sites[func] - (uintptr_t)&_init;
+
+	return offset / FUNC_SITE_SIZE * FUNC_SITE_SIZE;
+}
+
+/* List the calls recorded, oldest first, into tu_log */
+static int tu_list(const uint32_t *offsets)
+{
+	struct trace_output_hdr *out;
+	struct trace_call *call;
+	unsigned int needed;
+	char *log = tu_log;
+	void *buff;
+	int i, func;
+
+	trace_list_calls(NULL, 0, &needed);
+	buff = calloc(1, needed + sizeof(*call));
+	if (!buff)
+		return -ENOMEM;
+	out = buff;
+	if (trace_list_calls(buff, needed + sizeof(*call), &needed)) {
+		free(buff);
+		return -ENOSPC;
+	}
+
+	*log = '\0';
+	call = buff + sizeof(*out);
+	for (i = 0; i < out->rec_count; i++, call++) {
+		if (TRACE_CALL_TYPE(call) == FUNCF_TEXTBASE)
+			continue;
+		for (func = 0; func < ARRAY_SIZE(tu_sites); func++) {
+			if (offsets[func] == call->func)
+				break;
+		}
+		if (log + 3 > tu_log + sizeof(tu_log))
+			break;
+		*log++ = TRACE_CALL_TYPE(call) == FUNCF_ENTRY ? '+' : '-';
+		*log++ = func < ARRAY_SIZE(tu_sites) ? 'a' + func : '?';
+		*log = '\0';
+	}
+	free(buff);
+
+	return 0;
+}
+
+static int tu_check(const uint32_t *offsets, const char *test,
+		    const char *expect)
+{
+	int ret;
+
+	ret = tu_list(offsets);
+	if (ret)
+		return ret;
+	if (strcmp(tu_log, expect)) {
+		printf("%s: recorded '%s', expected '%s'\n", test, tu_log,
+		       expect);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Nested calls are listed in order, and a ring keeps the latest calls */
+static int trace_test_ring(const uint32_t *offsets)
+{
+	int ret;
+
+	trace_set_mode(0, 1);
+	trace_set_enabled(1);
+	tu_enter(1);
+	tu_enter(2);
+	tu_exit(2);
+	tu_exit(1);
+	trace_set_enabled(0);
+	ret = tu_check(offsets, __func__, "+b+c-c-b");
+	if (ret)
+		return ret;
+
+	/* The text base and 12 records, of which the last 8 are kept */
+	trace_set_mode(1, 1);
+	trace_set_enabled(1);
+	tu_calls(1, 6);
+	trace_set_enabled(0);
+
+	return tu_check(offsets, __func__, "+d-d+e-e+f-f+g-g");
+}
+
+/* When sampling, each call recorded has both its entry and its exit */
+static int trace_test_sample(const uint32_t *offsets)
+{
+	int ret;
+
+	/* b and d are recorded, but the call nested in each is not */
+	trace_set_mode(0, 2);
+	trace_set_enabled(1);
+	tu_enter(1);
+	tu_enter(2);
+	tu_exit(2);
+	tu_exit(1);
+	tu_enter(3);
+	tu_enter(4);
+	tu_exit(4);
+	tu_exit(3);
+
+	/*
+	 * A function which was running when tracing started returns, so
+	 * neither it nor the call it then makes are on the stack
+	 */
+	tu_exit(5);
+	tu_calls(6, 7);
+	tu_enter(5);
+	trace_set_enabled(0);
+	ret = tu_check(offsets, __func__, "+b-b+d-d");
+	if (ret)
+		return ret;
+
+	/* Without sampling, all of those are recorded */
+	trace_set_mode(1, 1);
+	trace_set_mode(0, 1);
+	trace_set_enabled(1);
+	tu_exit(5);
+	tu_calls(6, 7);
+	tu_enter(5);
+	trace_set_enabled(0);
+
+	return tu_check(offsets, __func__, "-f+g-g+h-h+f");
+}
+
+/* Each call's time goes to its function and, less its callees, its caller */
+static int trace_test_times(const uint32_t *offsets)
+{
+	struct trace_output_time *time, *b = NULL, *c = NULL;
+	struct trace_output_hdr *out;
+	unsigned int needed;
+	void *buff;
+	int i, ret;
+
+	trace_set_mode(0, 1);
+	trace_set_enabled(1);
+	tu_enter(1);
+	tu_enter(2);
+	trace_set_enabled(0);
+	sandbox_timer_add_offset(5);
+	trace_set_enabled(1);
+	tu_exit(2);
+	tu_exit(1);
+	trace_set_enabled(0);
+
+	trace_list_times(NULL, 0, &needed);
+	buff = calloc(1, needed + sizeof(*time));
+	if (!buff)
+		return -ENOMEM;
+	out = buff;
+	ret = -EINVAL;
+	if (trace_list_times(buff, needed + sizeof(*time), &needed))
+		goto err;
+	time = buff + sizeof(*out);
+	for (i = 0; i < out->rec_count; i++, time++) {
+		if (time->offset == offsets[1])
+			b = time;
+		else if (time->offset == offsets[2])
+			c = time;
+	}
+	if (out->rec_count != 2 || !b || !c) {
+		printf("%s: %d functions timed\n", __func__, out->rec_count);
+		goto err;
+	}
+
+	/* c took over 5ms, so its call is in the last bucket, from 4^6 us */
+	if (b->call_count != 1 || c->call_count != 1 ||
+	    c->incl_us < 5000 || c->excl_us != c->incl_us ||
+	    b->incl_us < c->incl_us || b->excl_us != b->incl_us - c->incl_us ||
+	    c->hist[TRACE_HIST_BUCKETS - 1] != 1) {
+		printf("%s: b %u calls %llu/%llu us, c %u calls %llu/%llu us\n",
+		       __func__, b->call_count, b->incl_us, b->excl_us,
+		       c->call_count, c->incl_us, c->excl_us);
+		goto err;
+	}
+	ret = 0;
+err:
+	free(buff);
+
+	return ret;
+}
+
+int do_ut_trace(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
+{
+	static int (*const tests[])(const uint32_t *offsets) = {
+		trace_test_ring,
+		trace_test_sample,
+		trace_test_times,
+	};
+	uint32_t offsets[ARRAY_SIZE(tu_sites)];
+	int func, i, ret;
+
+	for (func = 0; func < ARRAY_SIZE(tu_sites); func++)
+		offsets[func] = tu_offset(func);
+
+	/* Keep what each test records apart from everything else traced */
+	for (i = ret = 0; i < ARRAY_SIZE(tests) && !ret; i++) {
+		ret = trace_test_state(TU_RECORDS);
+		if (!ret) {
+			ret = tests[i](offsets);
+			trace_test_state(0);
+		}
+	}
+
+	printf("Test %s\n", ret ? "failed" : "passed");
+
+	return ret ? CMD_RET_FAILURE : CMD_RET_SUCCESS;
+}
+#else
+int do_ut_trace(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
+{
+	puts("Trace is not built in: build with FTRACE=1\n");
+
+	return CMD_RET_SUCCESS;
+}
+#endif
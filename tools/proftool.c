@@ -56,6 +56,8 @@ struct func_info *func_list;
 int func_count;
 struct trace_call *call_list;
 int call_count;
+struct trace_output_time *time_list;
+int time_count;
 int verbose;	/* Verbosity level 0=none, 1=warn, 2=notice, 3=info, 4=debug */
 unsigned long text_offset;		/* text address of first function */
 
@@ -86,6 +88,8 @@ static void usage(void)
 		"\n"
 		"Commands\n"
 		"   dump-ftrace\t\tDump out textual data in ftrace format\n"
+		"   dump-chrome\t\tDump out call data in Chrome trace format\n"
+		"   dump-times\t\tDump out the time spent in each function\n"
 		"\n"
 		"Options:\n"
 		"   -m <map>\tSpecify Systen.map file\n"
@@ -227,6 +231,25 @@ static int read_calls(FILE *fin, int count)
 	return 0;
 }
 
+static int read_times(FILE *fin, int count)
+{
+	int i;
+
+	notice("time count: %d\n", count);
+	time_list = calloc(count, sizeof(*time_list));
+	if (!time_list) {
+		error("Cannot allocate time_list\n");
+		return -1;
+	}
+	time_count = count;
+
+	for (i = 0; i < count; i++) {
+		if (read_data(fin, &time_list[i], sizeof(*time_list)))
+			return 1;
+	}
+	return 0;
+}
+
 static int read_profile(FILE *fin, int *not_found)
 {
 	struct trace_output_hdr hdr;
@@ -250,6 +273,11 @@ static int read_profile(FILE *fin, int *not_found)
 			if (read_calls(fin, hdr.rec_count))
 				return 1;
 			break;
+
+		case TRACE_CHUNK_TIMES:
+			if (read_times(fin, hdr.rec_count))
+				return 1;
+			break;
 		}
 	}
 	return 0;
@@ -532,6 +560,105 @@ static int make_ftrace(void)
 	return 0;
 }
 
+/*
+ * Write the calls as Chrome trace events, which can be loaded into
+ * chrome://tracing or Perfetto:
+ *
+ * {"traceEvents":[
+ * {"name":"board_init_r","ph":"B","ts":1234,"pid":1,"tid":1},
+ * {"name":"board_init_r","ph":"E","ts":1240,"pid":1,"tid":1}
+ * ]}
+ *
+ * Calls recorded in ring mode may start part-way through a function, so
+ * exits without a matching entry are dropped, and functions still running
+ * at the end are closed at the last timestamp.
+ */
+static int make_chrome(void)
+{
+	struct trace_call *call;
+	struct func_info *func;
+	unsigned long time = 0;
+	int depth = 0, skip_count = 0;
+	const char *sep = "";
+	int i;
+
+	printf("{\"traceEvents\":[");
+	for (i = 0, call = call_list; i < call_count; i++, call++) {
+		int entry = TRACE_CALL_TYPE(call) == FUNCF_ENTRY;
+
+		if (!entry && TRACE_CALL_TYPE(call) != FUNCF_EXIT)
+			continue;
+		func = find_func_by_offset(call->func);
+		if (!func || !(func->flags & FUNCF_TRACE)) {
+			skip_count++;
+			continue;
+		}
+		if (!entry && !depth)
+			continue;
+		depth += entry ? 1 : -1;
+		time = call->flags & FUNCF_TIMESTAMP_MASK;
+		printf("%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%lu,"
+		       "\"pid\":1,\"tid\":1}", sep, func->name,
+		       entry ? 'B' : 'E', time);
+		sep = ",";
+	}
+	for (; depth; depth--) {
+		printf("%s\n{\"ph\":\"E\",\"ts\":%lu,\"pid\":1,\"tid\":1}",
+		       sep, time);
+		sep = ",";
+	}
+	printf("\n]}\n");
+	info("chrome: %d calls not found or excluded\n", skip_count);
+
+	return 0;
+}
+
+static int h_cmp_excl(const void *v1, const void *v2)
+{
+	const struct trace_output_time *t1 = v1, *t2 = v2;
+
+	if (t1->excl_us != t2->excl_us)
+		return t1->excl_us < t2->excl_us ? 1 : -1;
+	return 0;
+}
+
+/*
+ * Write the time spent in each function, most first. The histogram shows
+ * the number of calls which took <1us, <4us, <16us and so on.
+ */
+static int make_times(void)
+{
+	static const char *const bucket_name[TRACE_HIST_BUCKETS] = {
+		"<1us", "<4us", "<16us", "<64us", "<256us", "<1ms", "<4ms",
+		">=4ms",
+	};
+	struct trace_output_time *time;
+	struct func_info *func;
+	int i, j;
+
+	qsort(time_list, time_count, sizeof(*time_list), h_cmp_excl);
+	printf("%10s %12s %12s ", "Calls", "Incl. us", "Excl. us");
+	for (j = 0; j < TRACE_HIST_BUCKETS; j++)
+		printf(" %6s", bucket_name[j]);
+	printf("  Function\n");
+	for (i = 0, time = time_list; i < time_count; i++, time++) {
+		func = find_func_by_offset(time->offset);
+		if (func && !(func->flags & FUNCF_TRACE))
+			continue;
+		printf("%10u %12llu %12llu ", time->call_count,
+		       (unsigned long long)time->incl_us,
+		       (unsigned long long)time->excl_us);
+		for (j = 0; j < TRACE_HIST_BUCKETS; j++)
+			printf(" %6u", time->hist[j]);
+		if (func)
+			printf("  %s\n", func->name);
+		else
+			printf("  %x\n", time->offset);
+	}
+
+	return 0;
+}
+
 static int prof_tool(int argc, char * const argv[],
 		     const char *prof_fname, const char *map_fname,
 		     const char *trace_config_fname)
@@ -552,6 +679,10 @@ static int prof_tool(int argc, char * const argv[],
 
 		if (0 == strcmp(cmd, "dump-ftrace"))
 			err = make_ftrace();
+		else if (0 == strcmp(cmd, "dump-chrome"))
+			err = make_chrome();
+		else if (0 == strcmp(cmd, "dump-times"))
+			err = make_times();
 		else
 			warn("Unknown command '%s'\n", cmd);
 	}